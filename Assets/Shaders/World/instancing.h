@@ -9,9 +9,27 @@ struct InstanceData
 	mat4 Transform;
 };
 
+#if defined(INDIRECT_DRAW)
+// Filled by IndirectDrawBuilder, baseInstance of each draw command points to its first instance
+struct IndirectInstanceData
+{
+	mat4 Transform;
+	uint MaterialIndex;
+	uint Padding[3];
+};
+
+layout(std430) readonly buffer IndirectInstances
+{
+	IndirectInstanceData gIndirectInstances[];
+};
+
+#define INST_INDEX (gl_BaseInstanceARB + gl_InstanceID)
+#define INST_TRANSFORM gIndirectInstances[INST_INDEX].Transform
+#else
 uniformbuffer Instances
 {
 	mat4 gInstances[MAX_INSTANCES];
 };
 
 #define INST_TRANSFORM gInstances[gl_InstanceID]
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <chrono>
+
+// Shared by the benchmark executables, each one is a single translation unit
+
+[[maybe_unused]] static double ElapsedMilliseconds(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+[[maybe_unused]] static double ElapsedMicroseconds(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+}
+
+[[maybe_unused]] static double ElapsedNanoseconds(std::chrono::steady_clock::time_point begin)
+{
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// Prints the time of its scope, and the time of one iteration when there is more than one
+class ScopedTimer {
+public:
+	ScopedTimer(const std::string& name, size_t iterations = 1){
+		m_name = name;
+		m_iterations = iterations;
+		m_begin = std::chrono::steady_clock::now();
+	}
+	virtual ~ScopedTimer(){
+		double elapsed = ElapsedMilliseconds(m_begin);
+
+		std::cout << "[" << m_name << "] Elapsed: " << elapsed << "ms";
+		if (m_iterations > 1)
+			std::cout << " (" << elapsed * 1000.0 / (double)m_iterations << "us per iteration)";
+		std::cout << "\n";
+	}
+protected:
+	std::string m_name;
+	size_t m_iterations;
+	std::chrono::steady_clock::time_point m_begin;
+};
\ No newline at end of file
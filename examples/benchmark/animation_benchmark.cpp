@@ -0,0 +1,253 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+
+#include <Aurora/Core/JobSystem.hpp>
+#include <Aurora/Framework/SkeletalMeshComponent.hpp>
+#include <Aurora/Memory/FrameAllocator.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+using namespace Aurora::Animation;
+
+#define COUNT_CHARACTERS 1000
+#define COUNT_BONES 60
+#define COUNT_KEYS 30
+#define COUNT_FRAMES 120
+#define FRAME_DELTA (1.0 / 60.0)
+
+// Previous SkeletalMeshComponent evaluation, channel search per bone, key search from the first key and recursion through the children
+namespace Legacy
+{
+	const AnimationChannel* FindChannel(const FAnimation& animation, const Bone& bone)
+	{
+		for (auto& channel : animation.Channels)
+		{
+			if (channel.Index == bone.Index)
+				return &channel;
+		}
+
+		return nullptr;
+	}
+
+	Vector3 Interpolate(const Vector3& start, const Vector3& end, double factor)
+	{
+		return start + (float)factor * (end - start);
+	}
+
+	Quaternion Interpolate(Quaternion a, Quaternion b, double factor)
+	{
+		return glm::slerp(glm::normalize(a), glm::normalize(b), (float)factor);
+	}
+
+	template<typename T>
+	T InterpolateChannel(double time, const std::vector<AnimationKey<T>>& channelData)
+	{
+		if (channelData.size() == 1)
+			return channelData[0].Value;
+
+		int channelIndex = 0;
+
+		for (int i = 1; i < channelData.size(); ++i)
+		{
+			if (channelData[i].Time > time)
+			{
+				channelIndex = i - 1;
+				break;
+			}
+		}
+
+		int nextChannelIndex = channelIndex + 1;
+		double factor = glm::abs((time - channelData[channelIndex].Time) / (channelData[nextChannelIndex].Time - channelData[channelIndex].Time));
+
+		return Interpolate(channelData[channelIndex].Value, channelData[nextChannelIndex].Value, factor);
+	}
+
+	void TransformBones(const FAnimation& animation, const Matrix4& globalInverseTransform, double time, const Bone& bone, const Matrix4& parentTransform, Matrix4* transforms)
+	{
+		const AnimationChannel* channel = FindChannel(animation, bone);
+
+		Matrix4 boneTransformation(1.0f);
+
+		if (channel)
+		{
+			Vector3 position = InterpolateChannel(time, channel->PositionKeys);
+			Quaternion rotation = InterpolateChannel(time, channel->RotationKeys);
+			Vector3 scale = InterpolateChannel(time, channel->ScaleKeys);
+
+			boneTransformation = glm::translate(position) * Matrix4(rotation) * glm::scale(scale);
+		}
+
+		Matrix4 globalTransformation = parentTransform * boneTransformation;
+		transforms[bone.Index] = globalInverseTransform * globalTransformation * bone.OffsetMatrix;
+
+		for (Bone* child : bone.Children)
+		{
+			TransformBones(animation, globalInverseTransform, time, *child, globalTransformation, transforms);
+		}
+	}
+
+	void TransformBones(const Armature& armature, const FAnimation& animation, double time, Matrix4* transforms)
+	{
+		for (Bone* bone : armature.RootBones)
+		{
+			TransformBones(animation, armature.GlobalInverseTransform, time, *bone, glm::identity<Matrix4>(), transforms);
+		}
+	}
+}
+
+static SkeletalMesh_ptr CreateCharacterMesh(std::mt19937& random)
+{
+	std::uniform_real_distribution<float> offsetDistribution(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> angleDistribution(-0.5f, 0.5f);
+
+	SkeletalMesh_ptr mesh = std::make_shared<SkeletalMesh>();
+	Armature& armature = mesh->Armature;
+	armature.GlobalInverseTransform = glm::identity<Matrix4>();
+
+	// Bones refer to each other by pointer, so the storage must not move
+	armature.Bones.reserve(COUNT_BONES);
+
+	for (int32_t i = 0; i < COUNT_BONES; ++i)
+	{
+		// Mostly chains with some branching, like spine, limbs and fingers
+		int32_t parent = i == 0 ? -1 : std::max(0, i - 1 - (int32_t)(random() % 3));
+
+		armature.Bones.emplace_back(i, parent, "Bone" + std::to_string(i), glm::translate(Vector3(offsetDistribution(random), offsetDistribution(random), offsetDistribution(random))));
+		armature.BoneMapping["Bone" + std::to_string(i)] = i;
+	}
+
+	for (Bone& bone : armature.Bones)
+	{
+		if (bone.Parent < 0)
+			armature.RootBones.push_back(&bone);
+		else
+			armature.Bones[bone.Parent].Children.push_back(&bone);
+	}
+
+	FAnimation animation("Walk", COUNT_KEYS - 1, 30.0);
+	animation.Channels.resize(COUNT_BONES);
+
+	for (int32_t i = 0; i < COUNT_BONES; ++i)
+	{
+		AnimationChannel channel(i, "Bone" + std::to_string(i));
+
+		for (int32_t key = 0; key < COUNT_KEYS; ++key)
+		{
+			channel.PositionKeys.push_back({(double)key, Vector3(offsetDistribution(random), offsetDistribution(random), offsetDistribution(random))});
+			channel.RotationKeys.push_back({(double)key, glm::angleAxis(angleDistribution(random), glm::normalize(Vector3(offsetDistribution(random), 1.0f, offsetDistribution(random))))});
+			channel.ScaleKeys.push_back({(double)key, Vector3(1.0f)});
+		}
+
+		animation.Channels[i] = channel;
+	}
+
+	mesh->Animations.push_back(animation);
+	return mesh;
+}
+
+int main()
+{
+	std::mt19937 random(1337);
+	SkeletalMesh_ptr mesh = CreateCharacterMesh(random);
+	const FAnimation& animation = mesh->Animations[0];
+
+	std::uniform_real_distribution<double> startTimeDistribution(0.0, animation.Duration);
+
+	std::vector<std::unique_ptr<SkeletalMeshComponent>> characters;
+	std::vector<SkeletalMeshComponent*> characterPointers;
+	std::vector<double> startTimes;
+
+	for (uint32_t i = 0; i < COUNT_CHARACTERS; ++i)
+	{
+		auto& character = characters.emplace_back(std::make_unique<SkeletalMeshComponent>());
+		character->SetMesh(mesh);
+		character->Play(0, true);
+
+		startTimes.push_back(startTimeDistribution(random));
+		character->AnimationTime = startTimes.back();
+		characterPointers.push_back(character.get());
+	}
+
+	{ // Compiled poses have to match the old evaluation
+		mesh->EnsureCompiledAnimations();
+
+		std::vector<Matrix4> legacyTransforms(COUNT_BONES);
+		std::vector<Matrix4> compiledTransforms(COUNT_BONES);
+		AnimationCursor cursor;
+		float maxError = 0.0f;
+
+		for (double time : startTimes)
+		{
+			Legacy::TransformBones(mesh->Armature, animation, time, legacyTransforms.data());
+			EvaluatePose(mesh->CompiledSkeleton, mesh->CompiledAnimations[0], time, cursor, compiledTransforms.data());
+
+			for (int32_t bone = 0; bone < COUNT_BONES; ++bone)
+			{
+				for (int column = 0; column < 4; ++column)
+				{
+					Vector4 difference = glm::abs(legacyTransforms[bone][column] - compiledTransforms[bone][column]);
+					maxError = std::max(maxError, std::max(std::max(difference.x, difference.y), std::max(difference.z, difference.w)));
+				}
+			}
+		}
+
+		std::cout << "Max difference to the previous evaluation: " << maxError << "\n";
+	}
+
+	{
+		std::vector<double> times = startTimes;
+		std::vector<Matrix4> transforms(COUNT_BONES);
+
+		auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t frame = 0; frame < COUNT_FRAMES; ++frame)
+		{
+			for (double& time : times)
+			{
+				Legacy::TransformBones(mesh->Armature, animation, time, transforms.data());
+				time = std::fmod(time + FRAME_DELTA * animation.TicksPerSecond, animation.Duration);
+			}
+		}
+
+		std::cout << "[Previous evaluation, " << COUNT_CHARACTERS << " characters x " << COUNT_BONES << " bones] " << ElapsedMilliseconds(begin) / COUNT_FRAMES << "ms per frame\n";
+	}
+
+	uint32_t maxThreads = JobSystem::GetDefaultWorkerCount() + 1;
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	for (uint32_t threads : threadCounts)
+	{
+		// The calling thread executes jobs too
+		JobSystem jobSystem(threads - 1);
+		JobSystem* jobSystemPtr = threads > 1 ? &jobSystem : nullptr;
+
+		for (uint32_t i = 0; i < COUNT_CHARACTERS; ++i)
+		{
+			characters[i]->AnimationTime = startTimes[i];
+		}
+
+		auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t frame = 0; frame < COUNT_FRAMES; ++frame)
+		{
+			FrameAllocator::Get().BeginFrame();
+			SkeletalMeshComponent::UpdateAnimations(characterPointers, FRAME_DELTA, jobSystemPtr);
+		}
+
+		std::cout << "[UpdateAnimations, " << COUNT_CHARACTERS << " characters x " << COUNT_BONES << " bones, " << threads << " threads] " << ElapsedMilliseconds(begin) / COUNT_FRAMES << "ms per frame\n";
+	}
+
+	return 0;
+}
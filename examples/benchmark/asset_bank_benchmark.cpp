@@ -0,0 +1,115 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+
+#include <Aurora/Core/FileSystem.hpp>
+#include <Aurora/Core/JobSystem.hpp>
+#include <Aurora/Resource/AssetBank.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_ITERATIONS 5
+
+static double Megabytes(uint64_t bytes)
+{
+	return (double)bytes / (1024.0 * 1024.0);
+}
+
+int main()
+{
+	// Package names are relative to the working directory, same as when packing a game
+	std::filesystem::current_path(AURORA_PROJECT_DIR);
+
+	Path packagePath = std::filesystem::temp_directory_path() / "asset_bank_benchmark.abank";
+	std::vector<Path> files = FS::ListFiles("Assets", true);
+
+	uint64_t rawSize = 0;
+	for (const Path& file : files)
+		rawSize += std::filesystem::file_size(file);
+
+	std::cout << "Assets: " << files.size() << " files, " << Megabytes(rawSize) << "MB\n";
+
+	{ // Loose files, every read opens the file
+		auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < COUNT_ITERATIONS; ++i)
+		{
+			for (const Path& file : files)
+				FS::LoadFile(file);
+		}
+
+		double time = ElapsedMilliseconds(begin) / COUNT_ITERATIONS;
+		std::cout << "[Read loose files] " << time << "ms, " << Megabytes(rawSize) / (time / 1000.0) << "MB/s\n";
+	}
+
+	uint32_t maxThreads = JobSystem::GetDefaultWorkerCount() + 1;
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	for (uint32_t threads : threadCounts)
+	{
+		// The calling thread executes jobs too
+		JobSystem jobSystem(threads - 1);
+		JobSystem* jobSystemPtr = threads > 1 ? &jobSystem : nullptr;
+
+		auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < COUNT_ITERATIONS; ++i)
+			AssetBank::CreatePackage("Assets", packagePath, jobSystemPtr);
+
+		double time = ElapsedMilliseconds(begin) / COUNT_ITERATIONS;
+		std::cout << "[Pack, " << threads << " threads] " << time << "ms, " << Megabytes(rawSize) / (time / 1000.0) << "MB/s\n";
+	}
+
+	uint64_t packageSize = std::filesystem::file_size(packagePath);
+	std::cout << "Package: " << Megabytes(packageSize) << "MB (" << (double)packageSize / (double)rawSize * 100.0 << "% of the files)\n";
+
+	{
+		AssetPackage package;
+		package.Open(packagePath);
+
+		uint64_t storedSize[3] = {};
+		uint64_t uncompressedSize[3] = {};
+		for (const ABankEntry& entry : package.GetEntries())
+		{
+			storedSize[(uint32_t)entry.Compression] += entry.CompressedSize > 0 ? entry.CompressedSize : entry.Size;
+			uncompressedSize[(uint32_t)entry.Compression] += entry.Size;
+		}
+
+		const char* codecNames[3] = {"None", "LZ4", "Zstd"};
+		for (uint32_t codec = 0; codec < 3; ++codec)
+			std::cout << "  " << codecNames[codec] << ": " << Megabytes(uncompressedSize[codec]) << "MB -> " << Megabytes(storedSize[codec]) << "MB\n";
+	}
+
+	for (uint32_t threads : threadCounts)
+	{
+		JobSystem jobSystem(threads - 1);
+		JobSystem* jobSystemPtr = threads > 1 ? &jobSystem : nullptr;
+
+		auto begin = std::chrono::steady_clock::now();
+
+		size_t fileCount = 0;
+		for (uint32_t i = 0; i < COUNT_ITERATIONS; ++i)
+			fileCount += AssetBank::ReadAllFilesFromPackage(packagePath, jobSystemPtr).size();
+
+		double time = ElapsedMilliseconds(begin) / COUNT_ITERATIONS;
+		std::cout << "[Unpack, " << threads << " threads] " << time << "ms, " << Megabytes(rawSize) / (time / 1000.0) << "MB/s\n";
+
+		if (fileCount != files.size() * COUNT_ITERATIONS)
+		{
+			std::cout << "Error: file count mismatch\n";
+		}
+	}
+
+	std::filesystem::remove(packagePath);
+
+	return 0;
+}
@@ -0,0 +1,177 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <Aurora/Graphics/Null/NullRenderDevice.hpp>
+#include <Aurora/Tools/robin_hood.h>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_DRAWS 1000000
+
+// Resources as they were bound before integer IDs: string keys, hashed on every bind and every lookup
+namespace Legacy
+{
+	struct StateResources
+	{
+		robin_hood::unordered_map<std::string, TextureBinding> BoundTextures{};
+		robin_hood::unordered_map<std::string, Sampler_ptr> BoundSamplers{};
+		robin_hood::unordered_map<std::string, BufferBinding> BoundUniformBuffers{};
+
+		void ResetResources()
+		{
+			BoundTextures.clear();
+			BoundSamplers.clear();
+			BoundUniformBuffers.clear();
+		}
+
+		inline void BindTexture(const std::string& name, const Texture_ptr& texture)
+		{
+			BoundTextures[name] = TextureBinding(texture);
+		}
+
+		inline void BindSampler(const std::string& name, const Sampler_ptr& sampler)
+		{
+			BoundSamplers[name] = sampler;
+		}
+
+		inline void BindUniformBuffer(const std::string& name, const Buffer_ptr& uniformBuffer, uint32_t offset = 0, uint32_t size = 0)
+		{
+			BoundUniformBuffers[name] = {uniformBuffer, offset, size};
+		}
+	};
+}
+
+static const char* s_Source = R"(
+layout(std140) uniform BaseVSData { mat4 ProjectionViewMatrix; };
+layout(std140) uniform GLOB_Data { vec4 CameraPos; };
+layout(std140) uniform Instances { mat4 Transforms[64]; };
+layout(std140) uniform GLOB_BoneData { mat4 Bones[64]; };
+layout(std140) uniform Material { vec4 Color; };
+
+uniform sampler2D Texture;
+uniform sampler2D NormalMap;
+uniform sampler2D g_DecalTexture;
+uniform sampler2DArray ShadowMaps;
+
+void main() {}
+)";
+
+int main()
+{
+	NullRenderDevice device;
+
+	ShaderProgramDesc shaderDesc("Binding");
+	shaderDesc.AddShader(EShaderType::Vertex, s_Source);
+	Shader_ptr shader = device.CreateShaderProgram(shaderDesc);
+	auto* nullShader = static_cast<NullShaderProgram*>(shader.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+
+	Buffer_ptr buffer = device.CreateBuffer(BufferDesc("Uniforms", 256, EBufferType::UniformBuffer));
+	Sampler_ptr sampler = device.CreateSampler(SamplerDesc());
+
+	TextureDesc textureDesc;
+	textureDesc.Width = 1;
+	textureDesc.Height = 1;
+	textureDesc.MipLevels = 1;
+	textureDesc.ImageFormat = GraphicsFormat::RGBA8_UNORM;
+	Texture_ptr texture = device.CreateTexture(textureDesc);
+
+	size_t found = 0;
+
+	// A draw of a material: the pass binds its buffers, the material its textures, the device looks up what the shader uses
+	{
+		Legacy::StateResources state;
+
+		auto begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < COUNT_DRAWS; ++i)
+		{
+			state.ResetResources();
+			state.BindUniformBuffer("BaseVSData", buffer);
+			state.BindUniformBuffer("GLOB_Data", buffer);
+			state.BindUniformBuffer("Instances", buffer);
+			state.BindUniformBuffer("GLOB_BoneData", buffer);
+			state.BindUniformBuffer("Material", buffer, 0, 16);
+			state.BindTexture("Texture", texture);
+			state.BindSampler("Texture", sampler);
+			state.BindTexture("NormalMap", texture);
+			state.BindSampler("NormalMap", sampler);
+
+			for (const ShaderResourceDesc& resource : nullShader->GetUniformBlocks())
+			{
+				found += state.BoundUniformBuffers.find(resource.Name) != state.BoundUniformBuffers.end();
+			}
+
+			for (const ShaderResourceDesc& resource : nullShader->GetSamplers())
+			{
+				found += state.BoundTextures.find(resource.Name) != state.BoundTextures.end();
+				found += state.BoundSamplers.find(resource.Name) != state.BoundSamplers.end();
+			}
+		}
+		double elapsed = ElapsedMilliseconds(begin);
+		std::cout << "[Binding] String keys: " << elapsed << " ms, " << elapsed * 1000000.0 / COUNT_DRAWS << " ns per draw" << std::endl;
+	}
+
+	{
+		DrawCallState state;
+
+		auto begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < COUNT_DRAWS; ++i)
+		{
+			state.ResetResources();
+			state.BindUniformBuffer("BaseVSData"_HASH, buffer);
+			state.BindUniformBuffer("GLOB_Data"_HASH, buffer);
+			state.BindUniformBuffer("Instances"_HASH, buffer);
+			state.BindUniformBuffer("GLOB_BoneData"_HASH, buffer);
+			state.BindUniformBuffer("Material"_HASH, buffer, 0, 16);
+			state.BindTexture("Texture"_HASH, texture);
+			state.BindSampler("Texture"_HASH, sampler);
+			state.BindTexture("NormalMap"_HASH, texture);
+			state.BindSampler("NormalMap"_HASH, sampler);
+
+			for (const ShaderResourceDesc& resource : nullShader->GetUniformBlocks())
+			{
+				found += state.BoundUniformBuffers.Find(resource.NameID) != nullptr;
+			}
+
+			for (const ShaderResourceDesc& resource : nullShader->GetSamplers())
+			{
+				found += state.BoundTextures.Find(resource.NameID) != nullptr;
+				found += state.BoundSamplers.Find(resource.NameID) != nullptr;
+			}
+		}
+		double elapsed = ElapsedMilliseconds(begin);
+		std::cout << "[Binding] Name IDs: " << elapsed << " ms, " << elapsed * 1000000.0 / COUNT_DRAWS << " ns per draw" << std::endl;
+	}
+
+	// The whole BindShaderResources of the null device, with its redundant bind filtering
+	{
+		DrawCallState state;
+		state.Shader = shader;
+		state.BindUniformBuffer("BaseVSData"_HASH, buffer);
+		state.BindUniformBuffer("GLOB_Data"_HASH, buffer);
+		state.BindUniformBuffer("Instances"_HASH, buffer);
+		state.BindUniformBuffer("GLOB_BoneData"_HASH, buffer);
+		state.BindUniformBuffer("Material"_HASH, buffer, 0, 16);
+		state.BindTexture("Texture"_HASH, texture);
+		state.BindSampler("Texture"_HASH, sampler);
+		state.BindTexture("NormalMap"_HASH, texture);
+		state.BindSampler("NormalMap"_HASH, sampler);
+
+		device.SetShader(shader);
+
+		auto begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < COUNT_DRAWS; ++i)
+		{
+			device.BindShaderResources(state);
+		}
+		double elapsed = ElapsedMilliseconds(begin);
+		std::cout << "[Binding] NullRenderDevice::BindShaderResources: " << elapsed * 1000000.0 / COUNT_DRAWS << " ns per call, "
+			<< device.GetDeviceStatistics().BindCalls / COUNT_DRAWS << " lookups per call" << std::endl;
+	}
+
+	std::cout << "[Binding] Found " << found << " resources" << std::endl;
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,292 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+
+#include <Aurora/Physics/AABBTree.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_STATIC_BOXES 10000
+#define COUNT_MOVING_BOXES 1000
+#define COUNT_STEPS 240
+#define UPDATE_RATE (1.0f / 120.0f)
+#define WORLD_SIZE 200.0f
+#define COUNT_RAYS 10000
+#define RAY_PACKET_SIZE 16
+#define RAY_LENGTH 100.0f
+
+struct BenchmarkBox
+{
+	Vector3 Position;
+	Vector3 Extent;
+	Vector3 Velocity;
+	NodeIndex_t Proxy = AABB_NULL_NODE;
+
+	[[nodiscard]] AABB GetBounds() const { return AABB::FromExtent(Position, Extent); }
+};
+
+struct StepStats
+{
+	size_t Overlaps = 0;
+	size_t Reinserts = 0;
+};
+
+static void MoveBoxes(std::vector<BenchmarkBox>& boxes)
+{
+	for (BenchmarkBox& box : boxes)
+	{
+		box.Position += box.Velocity * UPDATE_RATE;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			if (glm::abs(box.Position[axis]) > WORLD_SIZE)
+				box.Velocity[axis] = -box.Velocity[axis];
+		}
+	}
+}
+
+static size_t QueryMovingBoxes(const AABBTree<BenchmarkBox>& tree, std::vector<BenchmarkBox>& movingBoxes)
+{
+	size_t overlaps = 0;
+
+	for (BenchmarkBox& box : movingBoxes)
+	{
+		AABB bounds = box.GetBounds();
+
+		tree.QueryOverlaps(&box, bounds, [&bounds, &overlaps](BenchmarkBox* other)
+		{
+			// Leaves can be fattened, count only real overlaps so both paths report the same number
+			if (other->GetBounds().Overlaps(bounds))
+				overlaps++;
+		});
+	}
+
+	return overlaps;
+}
+
+// Previous behaviour of PhysicsWorld, the tree is built from scratch every step
+static StepStats RebuildStep(std::vector<BenchmarkBox>& staticBoxes, std::vector<BenchmarkBox>& movingBoxes)
+{
+	MoveBoxes(movingBoxes);
+
+	AABBTree<BenchmarkBox> tree((uint32_t)(staticBoxes.size() + movingBoxes.size()) * 2, 0.0f);
+
+	for (BenchmarkBox& box : staticBoxes)
+		tree.InsertObject(&box, box.GetBounds());
+
+	for (BenchmarkBox& box : movingBoxes)
+		tree.InsertObject(&box, box.GetBounds());
+
+	return {QueryMovingBoxes(tree, movingBoxes), movingBoxes.size()};
+}
+
+static StepStats PersistentStep(AABBTree<BenchmarkBox>& tree, std::vector<BenchmarkBox>& movingBoxes)
+{
+	MoveBoxes(movingBoxes);
+
+	StepStats stats;
+
+	for (BenchmarkBox& box : movingBoxes)
+	{
+		if (tree.UpdateProxy(box.Proxy, box.GetBounds(), box.Velocity * UPDATE_RATE))
+			stats.Reinserts++;
+	}
+
+	stats.Overlaps = QueryMovingBoxes(tree, movingBoxes);
+	return stats;
+}
+
+struct RayQuery
+{
+	Vector3 Origin;
+	Vector3 Direction;
+};
+
+// Closest hit distance against the tight bounds, RAY_LENGTH when nothing is hit
+static float RayCastBox(const BenchmarkBox& box, const RayQuery& ray, const Vector3& invDirection, float maxDistance)
+{
+	float distance;
+
+	if (AABBTree<BenchmarkBox>::RayIntersects(box.GetBounds(), Vector3(0.0f), ray.Origin, invDirection, maxDistance, distance))
+		return distance;
+
+	return maxDistance;
+}
+
+static void RunRayCastBenchmark(const AABBTree<BenchmarkBox>& tree, const std::vector<BenchmarkBox>& staticBoxes, const std::vector<RayQuery>& rays)
+{
+	std::vector<float> bruteForceDistances(rays.size(), RAY_LENGTH);
+	std::vector<float> treeDistances(rays.size(), RAY_LENGTH);
+	std::vector<float> packetDistances(rays.size(), RAY_LENGTH);
+
+	{ // Previous PhysicsWorld::RayCast, every collider is tested
+		auto begin = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < rays.size(); ++i)
+		{
+			Vector3 invDirection = AABBTree<BenchmarkBox>::InverseDirection(rays[i].Direction);
+
+			for (const BenchmarkBox& box : staticBoxes)
+				bruteForceDistances[i] = RayCastBox(box, rays[i], invDirection, bruteForceDistances[i]);
+		}
+
+		std::cout << "[RayCast brute force, " << rays.size() << " rays] " << ElapsedMilliseconds(begin) << "ms\n";
+	}
+
+	{
+		auto begin = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < rays.size(); ++i)
+		{
+			Vector3 invDirection = AABBTree<BenchmarkBox>::InverseDirection(rays[i].Direction);
+			float& closest = treeDistances[i];
+
+			tree.RayCast(rays[i].Origin, rays[i].Direction, RAY_LENGTH, Vector3(0.0f), [&](BenchmarkBox* box)
+			{
+				closest = RayCastBox(*box, rays[i], invDirection, closest);
+				return closest;
+			});
+		}
+
+		std::cout << "[RayCast tree, " << rays.size() << " rays] " << ElapsedMilliseconds(begin) << "ms\n";
+	}
+
+	{
+		auto begin = std::chrono::steady_clock::now();
+
+		Vector3 origins[RAY_PACKET_SIZE];
+		Vector3 directions[RAY_PACKET_SIZE];
+		Vector3 invDirections[RAY_PACKET_SIZE];
+		float maxDistances[RAY_PACKET_SIZE];
+
+		for (size_t packetBegin = 0; packetBegin < rays.size(); packetBegin += RAY_PACKET_SIZE)
+		{
+			auto packetSize = (uint32_t)std::min<size_t>(RAY_PACKET_SIZE, rays.size() - packetBegin);
+
+			for (uint32_t i = 0; i < packetSize; ++i)
+			{
+				origins[i] = rays[packetBegin + i].Origin;
+				directions[i] = rays[packetBegin + i].Direction;
+				invDirections[i] = AABBTree<BenchmarkBox>::InverseDirection(directions[i]);
+				maxDistances[i] = RAY_LENGTH;
+			}
+
+			tree.RayCastPacket(origins, directions, maxDistances, packetSize, Vector3(0.0f), [&](uint32_t ray, BenchmarkBox* box)
+			{
+				float& closest = packetDistances[packetBegin + ray];
+				closest = RayCastBox(*box, rays[packetBegin + ray], invDirections[ray], closest);
+				return closest;
+			});
+		}
+
+		std::cout << "[RayCast tree packets of " << RAY_PACKET_SIZE << ", " << rays.size() << " rays] " << ElapsedMilliseconds(begin) << "ms\n";
+	}
+
+	if (bruteForceDistances != treeDistances || bruteForceDistances != packetDistances)
+	{
+		std::cout << "Error: ray hit mismatch\n";
+	}
+}
+
+int main()
+{
+	std::mt19937 random(1337);
+	std::uniform_real_distribution<float> positionDistribution(-WORLD_SIZE, WORLD_SIZE);
+	std::uniform_real_distribution<float> sizeDistribution(0.5f, 4.0f);
+	std::uniform_real_distribution<float> velocityDistribution(-10.0f, 10.0f);
+
+	std::vector<BenchmarkBox> staticBoxes(COUNT_STATIC_BOXES);
+	for (BenchmarkBox& box : staticBoxes)
+	{
+		box.Position = Vector3(positionDistribution(random), positionDistribution(random) * 0.1f, positionDistribution(random));
+		box.Extent = Vector3(sizeDistribution(random), sizeDistribution(random), sizeDistribution(random));
+		box.Velocity = Vector3(0.0f);
+	}
+
+	std::vector<BenchmarkBox> initialMovingBoxes(COUNT_MOVING_BOXES);
+	for (BenchmarkBox& box : initialMovingBoxes)
+	{
+		box.Position = Vector3(positionDistribution(random), positionDistribution(random) * 0.1f, positionDistribution(random));
+		box.Extent = Vector3(0.5f);
+		box.Velocity = Vector3(velocityDistribution(random), velocityDistribution(random), velocityDistribution(random));
+	}
+
+	size_t rebuildOverlaps = 0;
+	size_t persistentOverlaps = 0;
+
+	{
+		std::vector<BenchmarkBox> movingBoxes = initialMovingBoxes;
+		auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t step = 0; step < COUNT_STEPS; ++step)
+		{
+			rebuildOverlaps += RebuildStep(staticBoxes, movingBoxes).Overlaps;
+		}
+
+		std::cout << "[Rebuild every step, " << COUNT_STATIC_BOXES << " static + " << COUNT_MOVING_BOXES << " moving] "
+			<< ElapsedMilliseconds(begin) / COUNT_STEPS << "ms per step, overlaps " << rebuildOverlaps << "\n";
+	}
+
+	{
+		std::vector<BenchmarkBox> movingBoxes = initialMovingBoxes;
+		AABBTree<BenchmarkBox> tree;
+
+		auto buildBegin = std::chrono::steady_clock::now();
+
+		for (BenchmarkBox& box : staticBoxes)
+			box.Proxy = tree.InsertObject(&box, box.GetBounds());
+
+		for (BenchmarkBox& box : movingBoxes)
+			box.Proxy = tree.InsertObject(&box, box.GetBounds());
+
+		double buildTime = ElapsedMilliseconds(buildBegin);
+
+		size_t reinserts = 0;
+		auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t step = 0; step < COUNT_STEPS; ++step)
+		{
+			StepStats stats = PersistentStep(tree, movingBoxes);
+			persistentOverlaps += stats.Overlaps;
+			reinserts += stats.Reinserts;
+		}
+
+		std::cout << "[Persistent tree, " << COUNT_STATIC_BOXES << " static + " << COUNT_MOVING_BOXES << " moving] "
+			<< ElapsedMilliseconds(begin) / COUNT_STEPS << "ms per step (initial build " << buildTime << "ms, height " << tree.GetHeight() << ")"
+			<< ", reinserted " << (double)reinserts / COUNT_STEPS << " per step, overlaps " << persistentOverlaps << "\n";
+	}
+
+	if (rebuildOverlaps != persistentOverlaps)
+	{
+		std::cout << "Error: overlap count mismatch\n";
+	}
+
+	{
+		// Coherent rays, every packet shares an origin and fans out a little, like sight checks or a shotgun
+		std::uniform_real_distribution<float> spreadDistribution(-0.05f, 0.05f);
+		std::vector<RayQuery> rays(COUNT_RAYS);
+
+		for (size_t packetBegin = 0; packetBegin < rays.size(); packetBegin += RAY_PACKET_SIZE)
+		{
+			Vector3 origin(positionDistribution(random), positionDistribution(random) * 0.1f, positionDistribution(random));
+			Vector3 direction = glm::normalize(Vector3(velocityDistribution(random), velocityDistribution(random) * 0.1f, velocityDistribution(random)));
+
+			for (size_t i = packetBegin; i < std::min(rays.size(), packetBegin + RAY_PACKET_SIZE); ++i)
+			{
+				rays[i].Origin = origin;
+				rays[i].Direction = glm::normalize(direction + Vector3(spreadDistribution(random), spreadDistribution(random), spreadDistribution(random)));
+			}
+		}
+
+		AABBTree<BenchmarkBox> staticTree;
+		for (BenchmarkBox& box : staticBoxes)
+			staticTree.InsertObject(&box, box.GetBounds());
+
+		RunRayCastBenchmark(staticTree, staticBoxes, rays);
+	}
+
+	return 0;
+}
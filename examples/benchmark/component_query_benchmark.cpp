@@ -0,0 +1,169 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <Aurora/Core/Object.hpp>
+#include <Aurora/Framework/ComponentStorage.hpp>
+#include <Aurora/Framework/ActorComponent.hpp>
+#include <Aurora/Tools/robin_hood.h>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_QUERIES 100
+
+class BaseComponent : public ActorComponent {
+public:
+	CLASS_OBJ(BaseComponent, ActorComponent);
+	int Value = 0;
+};
+
+class TransformLikeComponent : public BaseComponent {
+public:
+	CLASS_OBJ(TransformLikeComponent, BaseComponent);
+};
+
+class MeshLikeComponent : public TransformLikeComponent {
+public:
+	CLASS_OBJ(MeshLikeComponent, TransformLikeComponent);
+};
+
+class LightLikeComponent : public TransformLikeComponent {
+public:
+	CLASS_OBJ(LightLikeComponent, TransformLikeComponent);
+};
+
+class ColliderLikeComponent : public BaseComponent {
+public:
+	CLASS_OBJ(ColliderLikeComponent, BaseComponent);
+};
+
+// Copy of the previous ComponentStorage::GetComponents, walks every concrete type bucket and copies matching pointers
+struct LegacyComponentIndex
+{
+	robin_hood::unordered_map<TTypeID, std::vector<std::uintptr_t>> ComponentPointers;
+
+	void Add(ActorComponent* component)
+	{
+		ComponentPointers[component->GetTypeID()].push_back((std::uintptr_t)component);
+	}
+
+	template<typename T>
+	std::vector<std::uintptr_t> GetComponents()
+	{
+		std::vector<std::uintptr_t> foundComponents;
+
+		for(auto& it : ComponentPointers)
+		{
+			if(it.second.empty()) continue;
+
+			auto* typeBase = reinterpret_cast<ObjectBase*>(it.second[0]);
+
+			if(typeBase->HasType(T::TypeID()))
+			{
+				foundComponents.insert(foundComponents.end(), it.second.begin(), it.second.end());
+			}
+		}
+
+		return foundComponents;
+	}
+};
+
+template<typename T>
+int64_t LegacyQuery(LegacyComponentIndex& index)
+{
+	int64_t sum = 0;
+	for (std::uintptr_t ptr : index.GetComponents<T>())
+	{
+		sum += reinterpret_cast<T*>(ptr)->Value;
+	}
+	return sum;
+}
+
+template<typename T>
+int64_t ViewQuery(ComponentStorage& storage)
+{
+	int64_t sum = 0;
+	for (T* component : storage.GetComponents<T>())
+	{
+		sum += component->Value;
+	}
+	return sum;
+}
+
+void RunBenchmark(size_t componentCount)
+{
+	std::cout << "--- " << componentCount << " components ---\n";
+
+	ComponentStorage storage;
+	LegacyComponentIndex legacyIndex;
+	std::vector<ActorComponent*> components;
+
+	{
+		ScopedTimer timer("Create", componentCount);
+
+		for (size_t i = 0; i < componentCount; ++i)
+		{
+			ActorComponent* component;
+			switch (i % 3)
+			{
+				case 0: component = storage.CreateComponent<MeshLikeComponent>("Mesh"); break;
+				case 1: component = storage.CreateComponent<LightLikeComponent>("Light"); break;
+				default: component = storage.CreateComponent<ColliderLikeComponent>("Collider"); break;
+			}
+			BaseComponent::Cast(component)->Value = (int)(i % 7);
+			legacyIndex.Add(component);
+			components.push_back(component);
+		}
+	}
+
+	int64_t checksum = 0;
+
+	{
+		ScopedTimer timer("Legacy GetComponents<TransformLikeComponent>", COUNT_QUERIES);
+		for (int i = 0; i < COUNT_QUERIES; ++i)
+			checksum += LegacyQuery<TransformLikeComponent>(legacyIndex);
+	}
+
+	{
+		ScopedTimer timer("View GetComponents<TransformLikeComponent>", COUNT_QUERIES);
+		for (int i = 0; i < COUNT_QUERIES; ++i)
+			checksum -= ViewQuery<TransformLikeComponent>(storage);
+	}
+
+	{
+		ScopedTimer timer("Legacy GetComponents<BaseComponent>", COUNT_QUERIES);
+		for (int i = 0; i < COUNT_QUERIES; ++i)
+			checksum += LegacyQuery<BaseComponent>(legacyIndex);
+	}
+
+	{
+		ScopedTimer timer("View GetComponents<BaseComponent>", COUNT_QUERIES);
+		for (int i = 0; i < COUNT_QUERIES; ++i)
+			checksum -= ViewQuery<BaseComponent>(storage);
+	}
+
+	if (checksum != 0)
+	{
+		std::cout << "Query results do not match !\n";
+	}
+
+	{
+		ScopedTimer timer("Destroy", componentCount);
+
+		for (ActorComponent* component : components)
+		{
+			storage.DestroyComponent(component);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	RunBenchmark(1000);
+	RunBenchmark(10000);
+	RunBenchmark(100000);
+
+	return 0;
+}
@@ -0,0 +1,148 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include <Aurora/Core/Delegate.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_LISTENERS 1000
+#define COUNT_BIND_ROUNDS 1000
+#define COUNT_INVOKES 1000000
+#define COUNT_INVOKE_LISTENERS 4
+
+// Emitter as it was before inline delegates: one heap object per binding, virtual Invoke and the pointer as EventID
+namespace Legacy
+{
+	template<typename... ArgsTypes>
+	class IDelegate
+	{
+	public:
+		virtual ~IDelegate() = default;
+		virtual void Invoke(ArgsTypes&& ...args) = 0;
+	};
+
+	template<class UserClass, typename... ArgsTypes>
+	class MethodDelegate : public IDelegate<ArgsTypes...>
+	{
+	public:
+		typedef void(UserClass::*MethodPtr)(ArgsTypes...);
+	private:
+		UserClass* m_Instance;
+		MethodPtr m_Method;
+	public:
+		MethodDelegate(UserClass* instance, MethodPtr method) : m_Instance(instance), m_Method(method) {}
+
+		void Invoke(ArgsTypes&& ...args) override
+		{
+			(*m_Instance.*m_Method)(std::forward<ArgsTypes&&>(args)...);
+		}
+	};
+
+	template<typename... ArgsTypes>
+	class EventEmitter
+	{
+	public:
+		typedef IDelegate<ArgsTypes...>* Delegate;
+	private:
+		std::vector<Delegate> m_Delegates;
+	public:
+		~EventEmitter()
+		{
+			for (Delegate delegate : m_Delegates)
+				delete delegate;
+		}
+
+		template<class UserClass>
+		EventID Bind(UserClass* instance, typename MethodDelegate<UserClass, ArgsTypes...>::MethodPtr method)
+		{
+			Delegate delegate = new MethodDelegate<UserClass, ArgsTypes...>(instance, method);
+			m_Delegates.push_back(delegate);
+			return reinterpret_cast<EventID>(delegate);
+		}
+
+		bool Unbind(EventID eventId)
+		{
+			auto it = std::find(m_Delegates.begin(), m_Delegates.end(), reinterpret_cast<Delegate>(eventId));
+
+			if (it == m_Delegates.end())
+				return false;
+
+			delete *it;
+			m_Delegates.erase(it);
+			return true;
+		}
+
+		void Invoke(ArgsTypes&& ...args) const
+		{
+			for (const Delegate& delegate : m_Delegates)
+				delegate->Invoke(std::forward<ArgsTypes>(args)...);
+		}
+	};
+}
+
+struct Listener
+{
+	uint64_t Sum = 0;
+
+	void OnEvent(uint32_t pass, const float& value)
+	{
+		Sum += pass + (uint64_t)value;
+	}
+};
+
+template<typename Emitter>
+static void RunBenchmark(const char* name)
+{
+	Listener listener;
+
+	// Bind a batch of listeners, then unbind them oldest first like scoped events going away
+	double bindTime = 0.0;
+	double unbindTime = 0.0;
+	std::vector<EventID> ids(COUNT_LISTENERS);
+
+	for (uint32_t round = 0; round < COUNT_BIND_ROUNDS; ++round)
+	{
+		Emitter emitter;
+
+		auto begin = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < COUNT_LISTENERS; ++i)
+			ids[i] = emitter.Bind(&listener, &Listener::OnEvent);
+		bindTime += ElapsedMilliseconds(begin);
+
+		begin = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < COUNT_LISTENERS; ++i)
+			emitter.Unbind(ids[i]);
+		unbindTime += ElapsedMilliseconds(begin);
+	}
+
+	// A few listeners invoked for every material switch
+	Emitter emitter;
+	Listener invokeListeners[COUNT_INVOKE_LISTENERS];
+	for (Listener& invokeListener : invokeListeners)
+		emitter.Bind(&invokeListener, &Listener::OnEvent);
+
+	float value = 1.0f;
+	auto begin = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < COUNT_INVOKES; ++i)
+		emitter.Invoke(std::forward<uint32_t>(i), value);
+	double invokeTime = ElapsedMilliseconds(begin);
+
+	for (const Listener& invokeListener : invokeListeners)
+		listener.Sum += invokeListener.Sum;
+
+	const double bindCount = (double)COUNT_LISTENERS * COUNT_BIND_ROUNDS;
+	std::cout << "[" << name << "] bind " << bindTime * 1000000.0 / bindCount << "ns, unbind " << unbindTime * 1000000.0 / bindCount
+		<< "ns, invoke with " << COUNT_INVOKE_LISTENERS << " listeners " << invokeTime * 1000000.0 / COUNT_INVOKES << "ns (check " << listener.Sum << ")\n";
+}
+
+int main()
+{
+	RunBenchmark<Legacy::EventEmitter<uint32_t, const float&>>("Heap delegates");
+	RunBenchmark<EventEmitter<uint32_t, const float&>>("Inline delegates");
+
+	return 0;
+}
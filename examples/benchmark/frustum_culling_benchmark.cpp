@@ -0,0 +1,152 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+
+#include <Aurora/Core/JobSystem.hpp>
+#include <Aurora/Physics/Frustum.hpp>
+#include <Aurora/Render/FrustumCuller.hpp>
+#include <Aurora/Memory/FrameAllocator.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_MESHES 100000
+#define COUNT_CULL_RUNS 100
+#define WORLD_SIZE 1000.0f
+
+struct MeshInstance
+{
+	AABB LocalBounds;
+	Matrix4 Transform;
+};
+
+static void GatherBounds(FrustumCuller& culler, const std::vector<MeshInstance>& meshes, JobSystem* jobSystem)
+{
+	culler.Resize((uint32_t)meshes.size());
+
+	auto gather = [&culler, &meshes](uint32_t begin, uint32_t end)
+	{
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			culler.SetBounds(i, meshes[i].LocalBounds.Transform(meshes[i].Transform));
+		}
+	};
+
+	if (jobSystem)
+	{
+		jobSystem->ParallelFor((uint32_t)meshes.size(), 256, gather);
+	}
+	else
+	{
+		gather(0, (uint32_t)meshes.size());
+	}
+}
+
+static double MeasureCulling(const FrustumCuller& culler, const std::vector<FFrustum>& frustums, JobSystem* jobSystem, size_t& visibleCount)
+{
+	auto begin = std::chrono::steady_clock::now();
+
+	for (uint32_t run = 0; run < COUNT_CULL_RUNS; ++run)
+	{
+		FrameAllocator::Get().BeginFrame();
+		visibleCount = 0;
+
+		for (const FFrustum& frustum : frustums)
+		{
+			FrameVector<uint32_t> visibleIndices;
+			culler.Cull(frustum, visibleIndices, jobSystem);
+			visibleCount += visibleIndices.size();
+		}
+	}
+
+	return ElapsedMicroseconds(begin) / COUNT_CULL_RUNS;
+}
+
+int main()
+{
+	std::mt19937 random(1337);
+	std::uniform_real_distribution<float> positionDistribution(-WORLD_SIZE, WORLD_SIZE);
+	std::uniform_real_distribution<float> sizeDistribution(0.5f, 5.0f);
+	std::uniform_real_distribution<float> angleDistribution(0.0f, 6.28f);
+
+	std::vector<MeshInstance> meshes(COUNT_MESHES);
+	for (MeshInstance& mesh : meshes)
+	{
+		float size = sizeDistribution(random);
+		mesh.LocalBounds = AABB(Vector3(-size), Vector3(size));
+		mesh.Transform = glm::translate(Vector3(positionDistribution(random), positionDistribution(random), positionDistribution(random))) * glm::rotate(angleDistribution(random), Vector3(0, 1, 0));
+	}
+
+	Matrix4 view = glm::lookAt(Vector3(0, 0, 0), Vector3(1, 0, 0.3f), Vector3(0, 1, 0));
+	std::vector<FFrustum> cameraFrustum = { FFrustum(glm::perspective(glm::radians(75.0f), 16.0f / 9.0f, 0.1f, WORLD_SIZE) * view) };
+
+	// Four ortho cascades along the camera view, like the directional light shadows
+	std::vector<FFrustum> cascadeFrustums;
+	for (int cascade = 0; cascade < 4; ++cascade)
+	{
+		float extent = 50.0f * (float)(1 << (cascade * 2));
+		cascadeFrustums.emplace_back(glm::ortho(-extent, extent, -extent, extent, -WORLD_SIZE, WORLD_SIZE) * glm::lookAt(Vector3(0, 0, 0), Vector3(-0.3f, -1, 0.2f), Vector3(1, 0, 0)));
+	}
+
+	{ // Previous path, one box at a time with the full test
+		std::vector<AABB> worldBounds;
+		worldBounds.reserve(meshes.size());
+		for (const MeshInstance& mesh : meshes)
+		{
+			worldBounds.push_back(mesh.LocalBounds.Transform(mesh.Transform));
+		}
+
+		size_t visibleCount = 0;
+		auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t run = 0; run < COUNT_CULL_RUNS; ++run)
+		{
+			visibleCount = 0;
+
+			for (const AABB& bounds : worldBounds)
+			{
+				visibleCount += cameraFrustum[0].IsBoxVisible(bounds) ? 1 : 0;
+			}
+		}
+
+		std::cout << "[FFrustum::IsBoxVisible, " << COUNT_MESHES << " boxes] " << ElapsedMicroseconds(begin) / COUNT_CULL_RUNS << "us, visible " << visibleCount << "\n";
+	}
+
+	uint32_t maxThreads = JobSystem::GetDefaultWorkerCount() + 1;
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	for (uint32_t threads : threadCounts)
+	{
+		// The calling thread executes jobs too
+		JobSystem jobSystem(threads - 1);
+		JobSystem* jobSystemPtr = threads > 1 ? &jobSystem : nullptr;
+
+		FrustumCuller culler;
+
+		auto gatherBegin = std::chrono::steady_clock::now();
+		for (uint32_t run = 0; run < COUNT_CULL_RUNS; ++run)
+		{
+			GatherBounds(culler, meshes, jobSystemPtr);
+		}
+		double gatherTime = ElapsedMicroseconds(gatherBegin) / COUNT_CULL_RUNS;
+
+		size_t cameraVisible = 0;
+		double cameraTime = MeasureCulling(culler, cameraFrustum, jobSystemPtr, cameraVisible);
+
+		size_t cascadeVisible = 0;
+		double cascadeTime = MeasureCulling(culler, cascadeFrustums, jobSystemPtr, cascadeVisible);
+
+		std::cout << "[" << threads << " threads] gather " << gatherTime << "us, camera cull " << cameraTime << "us (visible " << cameraVisible << ")"
+			<< ", 4 cascades cull " << cascadeTime << "us (visible " << cascadeVisible << ")\n";
+	}
+
+	return 0;
+}
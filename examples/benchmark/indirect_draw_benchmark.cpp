@@ -0,0 +1,273 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <Aurora/HeadlessEngine.hpp>
+#include <Aurora/Core/Profiler.hpp>
+#include <Aurora/Resource/ResourceManager.hpp>
+#include <Aurora/Graphics/Material/MaterialDefinition.hpp>
+#include <Aurora/Graphics/RenderManager.hpp>
+#include <Aurora/Graphics/Null/NullRenderDevice.hpp>
+#include <Aurora/Framework/Scene.hpp>
+#include <Aurora/Framework/Actor.hpp>
+#include <Aurora/Framework/CameraComponent.hpp>
+#include <Aurora/Framework/StaticMeshComponent.hpp>
+#include <Aurora/Render/SceneRenderer.hpp>
+
+#include <Shaders/vs_common.h>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_GRID 48
+#define COUNT_MESHES 16
+#define COUNT_MATERIALS 4
+#define COUNT_WARMUP_FRAMES 10
+#define COUNT_FRAMES 200
+
+// Flat grid with size * size quads, every size is a different mesh with its own buffers
+static StaticMesh_ptr CreateGridMesh(uint32_t size)
+{
+	StaticMesh_ptr mesh = std::make_shared<StaticMesh>();
+	mesh->Name = "Grid " + std::to_string(size);
+
+	MeshLodResource* lodResource;
+	VertexBuffer<StaticMesh::Vertex>* vertexBuffer = mesh->CreateVertexBuffer<StaticMesh::Vertex>(0, &lodResource);
+	vertexBuffer->Inflate((size + 1) * (size + 1));
+
+	for (uint32_t y = 0; y <= size; ++y)
+	{
+		for (uint32_t x = 0; x <= size; ++x)
+		{
+			StaticMesh::Vertex vertex = {};
+			vertex.Position = Vector3((float)x / size - 0.5f, 0.0f, (float)y / size - 0.5f);
+			vertex.TexCoord = Vector2((float)x / size, (float)y / size);
+			vertex.Normal = Vector3(0, 1, 0);
+			vertex.Tangent = Vector3(1, 0, 0);
+			vertex.BiTangent = Vector3(0, 0, 1);
+			vertexBuffer->Add(vertex);
+		}
+	}
+
+	for (uint32_t y = 0; y < size; ++y)
+	{
+		for (uint32_t x = 0; x < size; ++x)
+		{
+			Index_t i = y * (size + 1) + x;
+			lodResource->Indices.insert(lodResource->Indices.end(), {i, i + size + 1, i + 1, i + 1, i + size + 1, i + size + 2});
+		}
+	}
+
+	FMeshSection section;
+	section.NumTriangles = (Index_t)lodResource->Indices.size();
+	lodResource->Sections.push_back(section);
+
+	mesh->MaterialSlots[0] = MaterialSlot(nullptr, "Default");
+	mesh->ComputeAABB();
+	mesh->UploadToGPU(false);
+	return mesh;
+}
+
+// Depth pre-pass and ambient pass of the forward renderer, drawn directly or with multi draw indirect
+class IndirectSceneRenderer : public SceneRenderer
+{
+private:
+	FViewPort m_ViewPort;
+	Texture_ptr m_ColorTarget;
+	Texture_ptr m_DepthTarget;
+public:
+	size_t ModelContexts = 0;
+
+	IndirectSceneRenderer() : SceneRenderer(), m_ViewPort(1920, 1080)
+	{
+		m_ColorTarget = GEngine->GetRenderManager()->CreateRenderTarget("Color", m_ViewPort.Width, m_ViewPort.Height, GraphicsFormat::RGBA16_FLOAT);
+		m_DepthTarget = GEngine->GetRenderManager()->CreateRenderTarget("Depth", m_ViewPort.Width, m_ViewPort.Height, GraphicsFormat::D32);
+	}
+
+	void Render(Scene* scene, CameraComponent* camera) override
+	{
+		PrepareCulling(scene);
+
+		camera->UpdateFrustum();
+
+		ClearVisibleEntities();
+		PrepareVisibleEntities(scene, camera, camera->GetFrustum());
+
+		RenderSet modelContexts;
+		FillRenderSet(modelContexts, 1, RenderSortType::Opaque);
+		ModelContexts = modelContexts.size();
+
+		BaseVSData baseVsData;
+		baseVsData.ViewMatrix = camera->GetViewMatrix();
+		baseVsData.ProjectionMatrix = camera->GetProjectionMatrix();
+		baseVsData.ProjectionViewMatrix = camera->GetProjectionViewMatrix();
+		GEngine->GetRenderDevice()->WriteBuffer(m_BaseVsDataBuffer, &baseVsData);
+
+		GLOB_Data globData;
+		globData.CameraPos = camera->GetWorldPosition();
+		globData.CameraDir = camera->GetForwardVector();
+		GEngine->GetRenderDevice()->WriteBuffer(m_GlobDataBuffer, &globData);
+
+		GEngine->GetRenderDevice()->InvalidateState();
+
+		{
+			DrawCallState drawCallState;
+			drawCallState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+			drawCallState.BindUniformBuffer("GLOB_Data"_HASH, m_GlobDataBuffer);
+			drawCallState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
+
+			drawCallState.ViewPort = m_ViewPort;
+			drawCallState.BindDepthTarget(m_DepthTarget, 0, 0);
+			drawCallState.ClearColorTarget = false;
+			drawCallState.ClearDepthTarget = true;
+
+			GEngine->GetRenderDevice()->BindRenderTargets(drawCallState);
+			GEngine->GetRenderDevice()->ClearRenderTargets(drawCallState);
+
+			if (IndirectDrawEnabled)
+				RenderPassIndirect(Pass::Depth, drawCallState, camera, modelContexts);
+			else
+				RenderPass(Pass::Depth, drawCallState, camera, modelContexts);
+		}
+
+		{
+			DrawCallState drawCallState;
+			drawCallState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+			drawCallState.BindUniformBuffer("GLOB_Data"_HASH, m_GlobDataBuffer);
+			drawCallState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
+
+			drawCallState.ViewPort = m_ViewPort;
+			drawCallState.BindTarget(0, m_ColorTarget);
+			drawCallState.BindDepthTarget(m_DepthTarget, 0, 0);
+			drawCallState.ClearColorTarget = true;
+			drawCallState.ClearDepthTarget = false;
+
+			GEngine->GetRenderDevice()->BindRenderTargets(drawCallState);
+			GEngine->GetRenderDevice()->ClearRenderTargets(drawCallState);
+
+			if (IndirectDrawEnabled)
+				RenderPassIndirect(Pass::Ambient, drawCallState, camera, modelContexts);
+			else
+				RenderPass(Pass::Ambient, drawCallState, camera, modelContexts);
+		}
+	}
+};
+
+static void RunFrames(HeadlessEngine& engine, IndirectSceneRenderer& sceneRenderer, Scene& scene, CameraComponent* camera, const char* name)
+{
+	NullRenderDevice* renderDevice = engine.GetRenderDevice();
+
+	for (int i = 0; i < COUNT_WARMUP_FRAMES; ++i)
+	{
+		engine.BeginFrame();
+		sceneRenderer.Render(&scene, camera);
+		engine.EndFrame();
+	}
+
+	uint64_t drawCalls = 0;
+	uint64_t vertexCount = 0;
+	uint64_t stateChanges = 0;
+	double renderMs = 0;
+
+	for (int i = 0; i < COUNT_FRAMES; ++i)
+	{
+		engine.BeginFrame();
+		renderDevice->ResetDeviceStatistics();
+
+		auto begin = std::chrono::steady_clock::now();
+		sceneRenderer.Render(&scene, camera);
+		renderMs += ElapsedMilliseconds(begin);
+
+		drawCalls += renderDevice->GetFrameRenderStatistics().DrawCalls;
+		vertexCount += renderDevice->GetFrameRenderStatistics().VertexCount;
+		stateChanges += renderDevice->GetDeviceStatistics().StateChanges;
+
+		engine.EndFrame();
+	}
+
+	std::cout << "[IndirectDraw] " << name << ": " << renderMs / COUNT_FRAMES << " ms per frame, "
+		<< drawCalls / COUNT_FRAMES << " draw calls, "
+		<< vertexCount / COUNT_FRAMES << " vertices, "
+		<< stateChanges / COUNT_FRAMES << " state changes per frame" << std::endl;
+}
+
+int main()
+{
+	HeadlessEngine engine;
+
+	{
+		std::vector<StaticMesh_ptr> meshes;
+		for (int i = 0; i < COUNT_MESHES; ++i)
+		{
+			meshes.push_back(CreateGridMesh(i + 1));
+		}
+
+		Texture_ptr texture = engine.GetResourceManager()->LoadTexture("Assets/Textures/blueprint.png");
+		auto matDef = engine.GetResourceManager()->GetOrLoadMaterialDefinition("Assets/Materials/Base/Textured.matd");
+
+		std::vector<std::shared_ptr<Material>> materials;
+		for (int i = 0; i < COUNT_MATERIALS; ++i)
+		{
+			auto matInstance = matDef->CreateInstance();
+			matInstance->SetTexture("Texture"_HASH, texture);
+			materials.push_back(matInstance);
+		}
+
+		Scene scene;
+
+		for (int x = 0; x < COUNT_GRID; ++x)
+		{
+			for (int z = 0; z < COUNT_GRID; ++z)
+			{
+				Actor* actor = scene.SpawnActor<Actor, StaticMeshComponent>("Grid " + std::to_string(x) + ", " + std::to_string(z), Vector3(x * 1.5f - COUNT_GRID * 0.75f, 0, -z * 1.5f));
+				auto* meshComponent = StaticMeshComponent::Cast(actor->GetRootComponent());
+				meshComponent->SetMesh(meshes[(x * 7 + z) % COUNT_MESHES]);
+				meshComponent->SetMaterial(0, materials[(x + z * 3) % COUNT_MATERIALS]);
+			}
+		}
+
+		// Without a viewport the projection has to be given directly, SetPerspective reads the aspect from it
+		Actor* cameraActor = scene.SpawnActor<Actor, CameraComponent>("Camera", Vector3(0, 20, 10), Vector3(-40, 0, 0));
+		auto* camera = CameraComponent::Cast(cameraActor->GetRootComponent());
+		camera->SetProjectionMatrix(glm::perspective(glm::radians(75.0f), 1920.0f / 1080.0f, 0.1f, 500.0f));
+
+		IndirectSceneRenderer sceneRenderer;
+		sceneRenderer.LoadShaders();
+
+		sceneRenderer.IndirectDrawEnabled = false;
+		RunFrames(engine, sceneRenderer, scene, camera, "Direct");
+
+		sceneRenderer.IndirectDrawEnabled = true;
+		RunFrames(engine, sceneRenderer, scene, camera, "Indirect");
+
+		const IndirectDrawBuilder& builder = sceneRenderer.GetIndirectDrawBuilder();
+
+		// Build cost alone, on the render set of the last frame
+		engine.BeginFrame();
+
+		RenderSet modelContexts;
+		sceneRenderer.FillRenderSet(modelContexts, 1, RenderSortType::Opaque);
+
+		IndirectDrawBuilder benchmarkBuilder(engine.GetRenderDevice());
+		double buildMs = 0;
+		for (int i = 0; i < COUNT_FRAMES; ++i)
+		{
+			RenderSet fallbackSet;
+
+			auto begin = std::chrono::steady_clock::now();
+			benchmarkBuilder.Build(modelContexts, fallbackSet);
+			buildMs += ElapsedMilliseconds(begin);
+		}
+
+		engine.EndFrame();
+
+		std::cout << "[IndirectDraw] " << COUNT_GRID * COUNT_GRID << " objects, " << COUNT_MESHES << " meshes, " << COUNT_MATERIALS << " materials, "
+			<< sceneRenderer.ModelContexts << " model contexts per pass" << std::endl;
+		std::cout << "[IndirectDraw] Last pass: " << builder.GetCommands().size() << " commands, "
+			<< builder.GetInstances().size() << " instances in " << builder.GetBatches().size() << " batches" << std::endl;
+		std::cout << "[IndirectDraw] Build: " << buildMs / COUNT_FRAMES * 1000.0 << " us per pass" << std::endl;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <atomic>
+
+#include <Aurora/Core/JobSystem.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_EMPTY_JOBS 1000000
+#define COUNT_PARALLEL_FOR_ELEMENTS 1000000
+#define PARALLEL_FOR_BATCH_SIZE 1024
+#define COUNT_PARALLEL_FOR_RUNS 20
+
+static void RunSpawnBenchmark(uint32_t workerCount)
+{
+	JobSystem jobSystem(workerCount);
+	std::atomic<uint32_t> executed = 0;
+
+	// Every job comes through the shared queue
+	{
+		JobCounter counter;
+		auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < COUNT_EMPTY_JOBS; ++i)
+		{
+			jobSystem.Schedule([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+		}
+
+		jobSystem.Wait(counter);
+
+		double elapsed = ElapsedMilliseconds(begin);
+		std::cout << "[Spawn from main, " << workerCount << " workers] " << elapsed << "ms (" << elapsed * 1000000.0 / COUNT_EMPTY_JOBS << "ns per job)\n";
+	}
+
+	// Jobs spawned from a worker go to its own deque and the others have to steal them
+	{
+		JobCounter counter;
+		auto begin = std::chrono::steady_clock::now();
+
+		jobSystem.Schedule([&jobSystem, &executed, &counter]()
+		{
+			for (uint32_t i = 0; i < COUNT_EMPTY_JOBS; ++i)
+			{
+				jobSystem.Schedule([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+			}
+		}, &counter);
+
+		jobSystem.Wait(counter);
+
+		double elapsed = ElapsedMilliseconds(begin);
+		std::cout << "[Spawn from worker, " << workerCount << " workers] " << elapsed << "ms (" << elapsed * 1000000.0 / COUNT_EMPTY_JOBS << "ns per job)\n";
+	}
+
+	if (executed != COUNT_EMPTY_JOBS * 2)
+	{
+		std::cout << "Error: executed " << executed << " jobs\n";
+	}
+}
+
+static double RunParallelForBenchmark(JobSystem& jobSystem, std::vector<float>& input, std::vector<float>& output)
+{
+	auto begin = std::chrono::steady_clock::now();
+
+	for (uint32_t run = 0; run < COUNT_PARALLEL_FOR_RUNS; ++run)
+	{
+		jobSystem.ParallelFor((uint32_t)input.size(), PARALLEL_FOR_BATCH_SIZE, [&input, &output](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				output[i] = std::sqrt(input[i]) * std::sin(input[i]) + std::cos(input[i] * 0.5f);
+			}
+		});
+	}
+
+	return ElapsedMilliseconds(begin) / COUNT_PARALLEL_FOR_RUNS;
+}
+
+int main()
+{
+	uint32_t maxThreads = JobSystem::GetDefaultWorkerCount() + 1;
+
+	RunSpawnBenchmark(0);
+
+	if (maxThreads > 1)
+	{
+		RunSpawnBenchmark(maxThreads - 1);
+	}
+
+	std::vector<float> input(COUNT_PARALLEL_FOR_ELEMENTS);
+	std::vector<float> output(COUNT_PARALLEL_FOR_ELEMENTS);
+
+	for (uint32_t i = 0; i < COUNT_PARALLEL_FOR_ELEMENTS; ++i)
+	{
+		input[i] = (float)i * 0.001f;
+	}
+
+	double singleThreaded = 0;
+
+	for (uint32_t threads = 1; threads <= maxThreads; ++threads)
+	{
+		// The calling thread executes jobs too
+		JobSystem jobSystem(threads - 1);
+
+		double elapsed = RunParallelForBenchmark(jobSystem, input, output);
+
+		if (threads == 1)
+			singleThreaded = elapsed;
+
+		std::cout << "[ParallelFor " << COUNT_PARALLEL_FOR_ELEMENTS << " elements, " << threads << " threads] " << elapsed << "ms (speedup " << singleThreaded / elapsed << "x)\n";
+	}
+
+	return 0;
+}
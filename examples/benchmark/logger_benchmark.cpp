@@ -0,0 +1,98 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
+
+#include <Aurora/Core/JobSystem.hpp>
+#include <Aurora/Logger/file_sink.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_BURSTS 20
+#define COUNT_MESSAGES_PER_BURST 1000
+
+// Latencies of single log calls in nanoseconds, the clock itself costs a few tens of nanoseconds
+static void LogBursts(uint32_t threadIndex, std::vector<double>& latencies)
+{
+	for (uint32_t burst = 0; burst < COUNT_BURSTS; ++burst)
+	{
+		for (uint32_t i = 0; i < COUNT_MESSAGES_PER_BURST; ++i)
+		{
+			auto begin = std::chrono::steady_clock::now();
+			AU_LOG_WARNING("Thread ", threadIndex, " message ", i, " of burst ", burst, ", value ", 0.5f * (float)i);
+			latencies.push_back(ElapsedNanoseconds(begin));
+		}
+
+		// About a frame between the bursts
+		std::this_thread::sleep_for(std::chrono::milliseconds(16));
+	}
+}
+
+static void RunBenchmark(const char* name, uint32_t threadCount)
+{
+	std::vector<std::vector<double>> threadLatencies(threadCount);
+	std::vector<std::thread> threads;
+
+	auto begin = std::chrono::steady_clock::now();
+
+	for (uint32_t t = 0; t < threadCount; ++t)
+	{
+		threadLatencies[t].reserve(COUNT_BURSTS * COUNT_MESSAGES_PER_BURST);
+		threads.emplace_back([t, &threadLatencies]() { LogBursts(t, threadLatencies[t]); });
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	Logger::Flush();
+	double elapsed = ElapsedMilliseconds(begin);
+
+	std::vector<double> latencies;
+	for (const std::vector<double>& threadLatency : threadLatencies)
+		latencies.insert(latencies.end(), threadLatency.begin(), threadLatency.end());
+
+	std::sort(latencies.begin(), latencies.end());
+
+	std::cout << "[" << name << ", " << threadCount << " threads] p50 " << latencies[latencies.size() / 2] << "ns, p99 " << latencies[latencies.size() * 99 / 100]
+		<< "ns, max " << latencies.back() / 1000.0 << "us, total with flush " << elapsed << "ms\n";
+}
+
+int main()
+{
+	std::filesystem::path logPath = std::filesystem::temp_directory_path() / "aurora_logger_benchmark.txt";
+	std::shared_ptr<file_sink> sink = Logger::AddSink<file_sink>(logPath);
+
+	uint32_t maxThreads = JobSystem::GetDefaultWorkerCount() + 1;
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	// The sinks are written and flushed by the calling thread, as the logger did before the queue
+	Logger::SetRateLimit(0);
+	Logger::SetAsynchronous(false);
+	for (uint32_t threads : threadCounts)
+		RunBenchmark("Synchronous", threads);
+
+	Logger::SetAsynchronous(true);
+	for (uint32_t threads : threadCounts)
+		RunBenchmark("Asynchronous", threads);
+
+	// Most calls of the single call site are suppressed
+	Logger::SetRateLimit(100);
+	for (uint32_t threads : threadCounts)
+		RunBenchmark("Rate limited", threads);
+
+	Logger::RemoveSink(sink);
+	sink.reset();
+	std::filesystem::remove(logPath);
+
+	return 0;
+}
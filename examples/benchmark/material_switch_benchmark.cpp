@@ -0,0 +1,156 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <utility>
+#include <chrono>
+
+#include <Aurora/HeadlessEngine.hpp>
+#include <Aurora/Resource/ResourceManager.hpp>
+#include <Aurora/Graphics/Material/MaterialDefinition.hpp>
+#include <Aurora/Graphics/Null/NullRenderDevice.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_MATERIALS 64
+#define COUNT_SWITCHES 5000
+#define COUNT_FRAMES 100
+#define COUNT_HASHES 1000000
+
+// How the permutation key was computed on every BeginPass before passes were compiled
+namespace Legacy
+{
+	uint64_t HashShaderMacros(const ShaderMacros& macros)
+	{
+		std::stringstream ss;
+
+		for(const auto& it : macros)
+		{
+			ss << it.first;
+			ss << it.second;
+		}
+
+		return std::hash<String>()(ss.str());
+	}
+}
+
+static void RenderSwitches(const std::vector<std::shared_ptr<Material>>& materials, const Buffer_ptr& buffer)
+{
+	DrawCallState drawCallState;
+	drawCallState.BindUniformBuffer("BaseVSData"_HASH, buffer);
+	drawCallState.BindUniformBuffer("GLOB_Data"_HASH, buffer);
+	drawCallState.BindUniformBuffer("Instances"_HASH, buffer);
+
+	for (int i = 0; i < COUNT_SWITCHES; ++i)
+	{
+		Material* material = materials[i % materials.size()].get();
+		material->BeginPass(Pass::Ambient, drawCallState);
+		material->EndPass(Pass::Ambient, drawCallState);
+	}
+}
+
+int main()
+{
+	HeadlessEngine engine;
+	NullRenderDevice* renderDevice = engine.GetRenderDevice();
+
+	{
+		auto matDef = engine.GetResourceManager()->GetOrLoadMaterialDefinition("Assets/Materials/Base/Textured.matd");
+
+		if (matDef == nullptr)
+		{
+			std::cout << "[MaterialSwitch] Could not load Assets/Materials/Base/Textured.matd" << std::endl;
+			return 1;
+		}
+
+		std::vector<Texture_ptr> textures = {
+			engine.GetResourceManager()->LoadTexture("Assets/Textures/dry-rocky-ground-unity/dry-rocky-ground_albedo.png"),
+			engine.GetResourceManager()->LoadTexture("Assets/Textures/blueprint.png")
+		};
+
+		std::vector<std::shared_ptr<Material>> materials;
+		for (int i = 0; i < COUNT_MATERIALS; ++i)
+		{
+			auto matInstance = matDef->CreateInstance();
+			matInstance->SetTexture("Texture"_HASH, textures[i % textures.size()]);
+			matInstance->SetAlphaThresholdEnabled(i % 4 == 0);
+			materials.push_back(matInstance);
+		}
+
+		Buffer_ptr buffer = renderDevice->CreateBuffer(BufferDesc("PassData", 256, EBufferType::UniformBuffer));
+
+		// First frame compiles every pass, and every shader permutation on the way
+		engine.BeginFrame();
+		auto coldBegin = std::chrono::steady_clock::now();
+		RenderSwitches(materials, buffer);
+		double coldMs = ElapsedMilliseconds(coldBegin);
+		engine.EndFrame();
+
+		double warmMs = 0;
+		NullDeviceStatistics deviceStatistics = {};
+
+		for (int frame = 0; frame < COUNT_FRAMES; ++frame)
+		{
+			engine.BeginFrame();
+			renderDevice->ResetDeviceStatistics();
+
+			auto begin = std::chrono::steady_clock::now();
+			RenderSwitches(materials, buffer);
+			warmMs += ElapsedMilliseconds(begin);
+
+			deviceStatistics = renderDevice->GetDeviceStatistics();
+			engine.EndFrame();
+		}
+
+		// Every material changes a texture once per frame, which recompiles its passes
+		double invalidatedMs = 0;
+
+		for (int frame = 0; frame < COUNT_FRAMES; ++frame)
+		{
+			engine.BeginFrame();
+
+			auto begin = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < materials.size(); ++i)
+			{
+				materials[i]->SetTexture("Texture"_HASH, textures[(i + frame) % textures.size()]);
+			}
+			RenderSwitches(materials, buffer);
+			invalidatedMs += ElapsedMilliseconds(begin);
+
+			engine.EndFrame();
+		}
+
+		std::cout << "[MaterialSwitch] " << COUNT_SWITCHES << " switches between " << COUNT_MATERIALS << " materials" << std::endl;
+		std::cout << "[MaterialSwitch] Cold frame: " << coldMs << " ms" << std::endl;
+		std::cout << "[MaterialSwitch] Cached: " << warmMs / COUNT_FRAMES << " ms per frame, "
+			<< warmMs * 1000000.0 / (COUNT_FRAMES * COUNT_SWITCHES) << " ns per switch" << std::endl;
+		std::cout << "[MaterialSwitch] Texture changed every frame: " << invalidatedMs / COUNT_FRAMES << " ms per frame" << std::endl;
+		std::cout << "[MaterialSwitch] Shader changes: " << deviceStatistics.ShaderChanges
+			<< ", binding changes: " << deviceStatistics.BindingChanges
+			<< ", state changes: " << deviceStatistics.StateChanges << " per frame" << std::endl;
+
+		// Cost of the permutation key alone, which the old BeginPass paid on every switch
+		const ShaderMacros& macros = std::as_const(*materials[0]).GetMacros();
+		uint64_t hashSum = 0;
+
+		auto begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < COUNT_HASHES; ++i)
+		{
+			hashSum += Legacy::HashShaderMacros(macros);
+		}
+		double legacyHashMs = ElapsedMilliseconds(begin);
+
+		begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < COUNT_HASHES; ++i)
+		{
+			hashSum += HashShaderMacros(macros);
+		}
+		double hashMs = ElapsedMilliseconds(begin);
+
+		std::cout << "[MaterialSwitch] HashShaderMacros of " << macros.size() << " macros: stringstream " << legacyHashMs * 1000000.0 / COUNT_HASHES
+			<< " ns, FNV-1a " << hashMs * 1000000.0 / COUNT_HASHES << " ns (" << hashSum % 10 << ")" << std::endl;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include <chrono>
+#include <random>
 
 #include <cstring>
 #include <stdio.h>
@@ -14,6 +15,7 @@
 #include <Aurora/Core/Object.hpp>
 #include <Aurora/Framework/ComponentStorage.hpp>
 #include <Aurora/Framework/ActorComponent.hpp>
+#include "BenchmarkCommon.hpp"
 using namespace Aurora;
 
 //#define CLASSIC_IMPL
@@ -23,22 +25,8 @@ using namespace Aurora;
 
 #define COUNT_TICKS 1000
 
-class ScopedTimer {
-public:
-	ScopedTimer(const std::string& name){
-		m_name = name;
-		m_begin = std::chrono::steady_clock::now();
-	}
-	virtual ~ScopedTimer(){
-		auto end = std::chrono::steady_clock::now();
-
-		auto count =std::chrono::duration_cast<std::chrono::milliseconds>(end - m_begin).count();
-		std::cout << "[" << m_name << "] Elapsed: " << count << "ms\n";
-	}
-protected:
-	std::string m_name;
-	std::chrono::steady_clock::time_point m_begin;
-};
+#define COUNT_CHURN_OPERATIONS 200000
+#define COUNT_CHURN_LIVE       10000
 
 /*===========================================================================//
 //===========================================================================//
@@ -145,6 +133,78 @@ public:
 ComponentStorage Entity::m_ComponentStorage;
 
 
+enum class ChurnPattern
+{
+	Random, // Free a random live allocation
+	Fifo,   // Free the oldest allocation
+	Lifo    // Free the newest allocation
+};
+
+static const char* ChurnPatternName(ChurnPattern pattern)
+{
+	switch (pattern)
+	{
+		case ChurnPattern::Random: return "Random";
+		case ChurnPattern::Fifo: return "FIFO";
+		case ChurnPattern::Lifo: return "LIFO";
+	}
+	return "Unknown";
+}
+
+static void RunChurn(Aum::EMode mode, ChurnPattern pattern)
+{
+	Aum allocator(Aum::DefaultBlockSize, mode);
+	std::mt19937 rng(1337);
+	std::uniform_int_distribution<MemSize> sizeDist(16, 1024);
+
+	std::vector<MemPtr> live;
+	live.reserve(COUNT_CHURN_LIVE);
+	size_t fifoHead = 0;
+
+	std::string name = std::string(mode == Aum::EMode::SizeClass ? "SizeClass" : "FirstFit") + " churn " + ChurnPatternName(pattern);
+
+	{
+		ScopedTimer timer(name);
+
+		for (int i = 0; i < COUNT_CHURN_OPERATIONS; ++i)
+		{
+			if (live.size() - fifoHead < COUNT_CHURN_LIVE)
+			{
+				live.push_back(allocator.Alloc(sizeDist(rng)));
+				continue;
+			}
+
+			switch (pattern)
+			{
+				case ChurnPattern::Random:
+				{
+					size_t index = rng() % live.size();
+					allocator.DeAlloc(live[index]);
+					live[index] = live.back();
+					live.pop_back();
+					break;
+				}
+				case ChurnPattern::Fifo:
+					allocator.DeAlloc(live[fifoHead++]);
+					break;
+				case ChurnPattern::Lifo:
+					allocator.DeAlloc(live.back());
+					live.pop_back();
+					break;
+			}
+		}
+	}
+
+	Aum::Stats stats = allocator.GetStats();
+	std::cout << "  blocks=" << stats.BlockCount << " used=" << FormatBytes(stats.UsedBytes) << " free fragments=" << stats.FreeFragmentCount
+		<< " largest free=" << FormatBytes(stats.LargestFreeFragment) << " fragmentation=" << stats.GetFragmentation() * 100.0 << "%\n";
+
+	for (size_t i = fifoHead; i < live.size(); ++i)
+	{
+		allocator.DeAlloc(live[i]);
+	}
+}
+
 int main(int argc, char** argv){
 #ifdef CLASSIC_IMPL
 	std::cout << "Classic implementation...\n";
@@ -188,5 +248,13 @@ int main(int argc, char** argv){
 		entities.clear();
 	}
 
+	for (Aum::EMode mode : {Aum::EMode::FirstFit, Aum::EMode::SizeClass})
+	{
+		for (ChurnPattern pattern : {ChurnPattern::Random, ChurnPattern::Fifo, ChurnPattern::Lifo})
+		{
+			RunChurn(mode, pattern);
+		}
+	}
+
 	return 0;
 }
\ No newline at end of file
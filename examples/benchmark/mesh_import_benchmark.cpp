@@ -0,0 +1,124 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+
+#include <Aurora/Core/FileSystem.hpp>
+#include <Aurora/Core/JobSystem.hpp>
+#include <Aurora/Resource/AssimpModelLoader.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_ITERATIONS 3
+
+static MeshImportOptions GetImportOptions(bool optimize)
+{
+	// Same as ResourceManager::ImportAsset
+	MeshImportOptions importOptions;
+	importOptions.UploadToGPU = false;
+	importOptions.KeepCPUData = true;
+	importOptions.PreTransform = false;
+	importOptions.SplitMeshes = true;
+	importOptions.OptimizeMeshes = optimize;
+	importOptions.Optimize.GeneratedLODCount = 3;
+	return importOptions;
+}
+
+static double ImportAll(const std::vector<DataBlob>& files, const MeshImportOptions& importOptions, JobSystem* jobSystem)
+{
+	auto begin = std::chrono::steady_clock::now();
+
+	for (uint32_t i = 0; i < COUNT_ITERATIONS; ++i)
+	{
+		for (const DataBlob& data : files)
+		{
+			AssimpModelLoader modelLoader;
+			modelLoader.ImportModel("Benchmark", data, importOptions, jobSystem);
+		}
+	}
+
+	return ElapsedMilliseconds(begin) / COUNT_ITERATIONS;
+}
+
+// Import passes on the FBX files of the project: vertex welding, vertex cache and overdraw order, vertex fetch order and LOD generation
+int main()
+{
+	std::filesystem::current_path(AURORA_PROJECT_DIR);
+
+	std::vector<Path> paths;
+	std::vector<DataBlob> files;
+	for (const Path& file : FS::ListFiles("Assets", true))
+	{
+		if (file.extension() == ".fbx")
+		{
+			paths.push_back(file);
+			files.push_back(FS::LoadFile(file));
+		}
+	}
+
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		AssimpModelLoader modelLoader;
+		MeshImportedData importedData = modelLoader.ImportModel("Benchmark", files[i], GetImportOptions(true));
+
+		if (!importedData)
+		{
+			std::cout << paths[i].string() << ": import failed\n";
+			continue;
+		}
+
+		uint64_t verticesBefore = 0, verticesAfter = 0, trianglesBefore = 0, trianglesAfter = 0;
+		double acmrBefore = 0.0, acmrAfter = 0.0;
+		std::vector<uint64_t> lodTriangles;
+
+		for (const MeshOptimizeStats& stats : importedData.OptimizeStats)
+		{
+			verticesBefore += stats.VerticesBefore;
+			verticesAfter += stats.VerticesAfter;
+			trianglesBefore += stats.TrianglesBefore;
+			trianglesAfter += stats.TrianglesAfter;
+			acmrBefore += stats.ACMRBefore * stats.TrianglesBefore;
+			acmrAfter += stats.ACMRAfter * stats.TrianglesAfter;
+
+			lodTriangles.resize(std::max(lodTriangles.size(), stats.LODTriangles.size()));
+			for (size_t lod = 0; lod < stats.LODTriangles.size(); ++lod)
+				lodTriangles[lod] += stats.LODTriangles[lod];
+		}
+
+		std::cout << paths[i].string() << ": " << importedData.Meshes.size() << " meshes, vertices " << verticesBefore << " -> " << verticesAfter
+			<< ", triangles " << trianglesBefore << " -> " << trianglesAfter
+			<< ", ACMR " << (trianglesBefore ? acmrBefore / (double)trianglesBefore : 0.0) << " -> " << (trianglesAfter ? acmrAfter / (double)trianglesAfter : 0.0)
+			<< ", LOD triangles";
+
+		for (uint64_t triangles : lodTriangles)
+			std::cout << " " << triangles;
+
+		std::cout << "\n";
+	}
+
+	double unoptimizedTime = ImportAll(files, GetImportOptions(false), nullptr);
+	double optimizedTime = ImportAll(files, GetImportOptions(true), nullptr);
+	std::cout << "[Serial] without passes " << unoptimizedTime << "ms, with passes " << optimizedTime << "ms\n";
+
+	uint32_t maxThreads = JobSystem::GetDefaultWorkerCount() + 1;
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threads = 2; threads < maxThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	for (uint32_t threads : threadCounts)
+	{
+		// The calling thread runs jobs too while it waits
+		JobSystem jobSystem(threads - 1);
+
+		double parallelTime = ImportAll(files, GetImportOptions(true), &jobSystem);
+		std::cout << "[Parallel, " << threads << " threads] with passes " << parallelTime << "ms, " << optimizedTime / parallelTime << "x\n";
+	}
+
+	return 0;
+}
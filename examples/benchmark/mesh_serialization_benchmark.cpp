@@ -0,0 +1,273 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+#include <Aurora/Framework/Mesh/Mesh.hpp>
+#include <Aurora/Resource/ResourceManager.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_ITERATIONS 5
+#define GRID_SIZE 1000
+
+// Serialization as it was before bulk copies: one emplace_back per written byte and one Read per vertex
+namespace Legacy
+{
+	class Archive
+	{
+	public:
+		std::vector<uint8_t> Buffer;
+		size_t CurrentRead = 0;
+
+		template<typename T>
+		void Write(T data)
+		{
+			Buffer.reserve(sizeof(T));
+
+			for(std::size_t i = 0; i < sizeof(T); i++)
+				Buffer.emplace_back(*(reinterpret_cast<char*>(&data) + i));
+		}
+
+		template<typename T>
+		T Read()
+		{
+			T var;
+			memcpy(&var, Buffer.data() + CurrentRead, sizeof(T));
+			CurrentRead += sizeof(T);
+			return var;
+		}
+
+		void WriteString(const String& value)
+		{
+			Write((int)value.length());
+
+			for (char i : value)
+				Write((int8_t)i);
+		}
+
+		String ReadString()
+		{
+			int len = Read<int>();
+			String value;
+
+			for (int i = 0; i < len; ++i)
+				value += (char)Read<int8_t>();
+
+			return value;
+		}
+
+		template<typename T>
+		void WriteVector(const std::vector<T>& list)
+		{
+			Write((uint32_t)list.size());
+
+			for (const T& element : list)
+				Write(element);
+		}
+
+		template<typename T>
+		void ReadVector(std::vector<T>& list)
+		{
+			uint32_t count = Read<uint32_t>();
+			list.clear();
+
+			for (uint32_t i = 0; i < count; ++i)
+				list.push_back(Read<T>());
+		}
+	};
+
+	static void Serialize(StaticMesh& mesh, Archive& archive)
+	{
+		archive.WriteString(mesh.Name);
+		archive.Write((uint32_t)mesh.LODResources.size());
+
+		for (const auto& [lod, res] : mesh.LODResources)
+		{
+			archive.Write(lod);
+			VertexBuffer<StaticMesh::Vertex>* vertexBuffer = mesh.GetVertexBuffer<StaticMesh::Vertex>(lod);
+			archive.Write((uint32_t)vertexBuffer->GetCount());
+
+			for (size_t i = 0; i < vertexBuffer->GetCount(); ++i)
+				archive.Write(vertexBuffer->Get(i));
+
+			archive.Write((uint8_t)res.IndexFormat);
+			archive.WriteVector(res.Indices);
+			archive.WriteVector(res.Sections);
+		}
+
+		archive.Write((uint32_t)0);
+		archive.Write(mesh.m_Bounds.GetMin());
+		archive.Write(mesh.m_Bounds.GetMax());
+	}
+
+	static void Deserialize(StaticMesh& mesh, Archive& archive)
+	{
+		mesh.Name = archive.ReadString();
+		uint32_t numLods = archive.Read<uint32_t>();
+
+		for (uint32_t i = 0; i < numLods; ++i)
+		{
+			LOD lod = archive.Read<LOD>();
+			uint32_t vertexCount = archive.Read<uint32_t>();
+
+			MeshLodResource* lodResource;
+			VertexBuffer<StaticMesh::Vertex>* vertexBuffer = mesh.CreateVertexBuffer<StaticMesh::Vertex>(lod, &lodResource);
+
+			for (uint32_t vi = 0; vi < vertexCount; ++vi)
+			{
+				StaticMesh::Vertex vertex = archive.Read<StaticMesh::Vertex>();
+				vertexBuffer->Emplace(vertex);
+			}
+
+			lodResource->IndexFormat = (EIndexBufferFormat)archive.Read<uint8_t>();
+			archive.ReadVector(lodResource->Indices);
+			archive.ReadVector(lodResource->Sections);
+		}
+
+		archive.Read<uint32_t>();
+		Vector3 min = archive.Read<Vector3>();
+		Vector3 max = archive.Read<Vector3>();
+		mesh.m_Bounds.Set(min, max);
+	}
+}
+
+static StaticMesh_ptr CreateGridMesh()
+{
+	StaticMesh_ptr mesh = std::make_shared<StaticMesh>();
+	mesh->Name = "Grid";
+
+	MeshLodResource* lodResource;
+	VertexBuffer<StaticMesh::Vertex>* vertexBuffer = mesh->CreateVertexBuffer<StaticMesh::Vertex>(0, &lodResource);
+	vertexBuffer->Inflate(GRID_SIZE * GRID_SIZE);
+
+	for (uint32_t y = 0; y < GRID_SIZE; ++y)
+	{
+		for (uint32_t x = 0; x < GRID_SIZE; ++x)
+		{
+			StaticMesh::Vertex vertex = {};
+			vertex.Position = Vector3((float)x, 0.0f, (float)y);
+			vertex.TexCoord = Vector2((float)x / GRID_SIZE, (float)y / GRID_SIZE);
+			vertex.Normal = Vector3(0, 1, 0);
+			vertex.Tangent = Vector3(1, 0, 0);
+			vertex.BiTangent = Vector3(0, 0, 1);
+			vertexBuffer->Add(vertex);
+		}
+	}
+
+	for (uint32_t y = 0; y < GRID_SIZE - 1; ++y)
+	{
+		for (uint32_t x = 0; x < GRID_SIZE - 1; ++x)
+		{
+			Index_t i = y * GRID_SIZE + x;
+			lodResource->Indices.insert(lodResource->Indices.end(), {i, i + GRID_SIZE, i + 1, i + 1, i + GRID_SIZE, i + GRID_SIZE + 1});
+		}
+	}
+
+	FMeshSection section;
+	section.NumTriangles = (Index_t)lodResource->Indices.size();
+	lodResource->Sections.push_back(section);
+
+	mesh->ComputeAABB();
+	return mesh;
+}
+
+static bool SameMesh(StaticMesh& a, StaticMesh& b)
+{
+	VertexBuffer<StaticMesh::Vertex>* verticesA = a.GetVertexBuffer<StaticMesh::Vertex>(0);
+	VertexBuffer<StaticMesh::Vertex>* verticesB = b.GetVertexBuffer<StaticMesh::Vertex>(0);
+
+	if (!verticesA || !verticesB || verticesA->GetSize() != verticesB->GetSize())
+		return false;
+
+	return std::memcmp(verticesA->GetData(), verticesB->GetData(), verticesA->GetSize()) == 0 && a.LODResources[0].Indices == b.LODResources[0].Indices;
+}
+
+int main()
+{
+	StaticMesh_ptr mesh = CreateGridMesh();
+	std::cout << "Vertices: " << GRID_SIZE * GRID_SIZE << ", indices: " << mesh->LODResources[0].Indices.size() << "\n";
+
+	double legacyWriteTime = 0.0;
+	double legacyReadTime = 0.0;
+	double writeTime = 0.0;
+	double readTime = 0.0;
+	size_t archiveSize = 0;
+	bool valid = true;
+
+	for (uint32_t i = 0; i < COUNT_ITERATIONS; ++i)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		Legacy::Archive legacyArchive;
+		Legacy::Serialize(*mesh, legacyArchive);
+		legacyWriteTime += ElapsedMilliseconds(begin);
+
+		begin = std::chrono::steady_clock::now();
+		StaticMesh legacyMesh;
+		Legacy::Deserialize(legacyMesh, legacyArchive);
+		legacyReadTime += ElapsedMilliseconds(begin);
+
+		begin = std::chrono::steady_clock::now();
+		Archive archive;
+		mesh->Serialize(archive);
+		writeTime += ElapsedMilliseconds(begin);
+		archiveSize = archive.GetSize();
+
+		begin = std::chrono::steady_clock::now();
+		Archive view(std::span<const uint8_t>(archive.GetData(), archive.GetSize()));
+		StaticMesh readMesh;
+		readMesh.Deserialize(view);
+		readTime += ElapsedMilliseconds(begin);
+
+		valid &= SameMesh(*mesh, legacyMesh) && SameMesh(*mesh, readMesh);
+	}
+
+	legacyWriteTime /= COUNT_ITERATIONS;
+	legacyReadTime /= COUNT_ITERATIONS;
+	writeTime /= COUNT_ITERATIONS;
+	readTime /= COUNT_ITERATIONS;
+
+	std::cout << "Archive size: " << (double)archiveSize / (1024.0 * 1024.0) << "MB\n";
+	std::cout << "[Per element] write " << legacyWriteTime << "ms, read " << legacyReadTime << "ms\n";
+	std::cout << "[Bulk] write " << writeTime << "ms (" << legacyWriteTime / writeTime << "x), read " << readTime << "ms (" << legacyReadTime / readTime << "x)\n";
+
+	{ // Whole load from disk, file read included
+		Path meshPath = std::filesystem::temp_directory_path() / "aurora_mesh_serialization_benchmark.amesh";
+
+		Archive archive;
+		archive << 2; // Mesh version
+		mesh->WriteMeshType(archive);
+		mesh->Serialize(archive);
+
+		std::ofstream outStream(meshPath, std::ios::out | std::ios::binary);
+		outStream << archive;
+		outStream.close();
+
+		ResourceManager resourceManager(nullptr);
+
+		double loadTime = 0.0;
+		for (uint32_t i = 0; i < COUNT_ITERATIONS; ++i)
+		{
+			auto begin = std::chrono::steady_clock::now();
+			Mesh_ptr loadedMesh = resourceManager.ReadMesh(meshPath);
+			loadTime += ElapsedMilliseconds(begin);
+
+			valid &= loadedMesh && SameMesh(*mesh, *std::static_pointer_cast<StaticMesh>(loadedMesh));
+		}
+
+		std::cout << "[ReadMesh] " << loadTime / COUNT_ITERATIONS << "ms\n";
+		std::filesystem::remove(meshPath);
+	}
+
+	if (!valid)
+	{
+		std::cout << "Error: deserialized mesh does not match\n";
+		return 1;
+	}
+
+	return 0;
+}
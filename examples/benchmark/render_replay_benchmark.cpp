@@ -0,0 +1,168 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <Aurora/HeadlessEngine.hpp>
+#include <Aurora/Core/Profiler.hpp>
+#include <Aurora/Resource/ResourceManager.hpp>
+#include <Aurora/Resource/AssimpModelLoader.hpp>
+#include <Aurora/Graphics/Material/MaterialDefinition.hpp>
+#include <Aurora/Graphics/ViewPortManager.hpp>
+#include <Aurora/Graphics/Null/NullRenderDevice.hpp>
+#include <Aurora/Framework/Scene.hpp>
+#include <Aurora/Framework/Actor.hpp>
+#include <Aurora/Framework/CameraComponent.hpp>
+#include <Aurora/Framework/StaticMeshComponent.hpp>
+#include <Aurora/Framework/Lights.hpp>
+#include <Aurora/Render/SceneRendererForward.hpp>
+
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_GRID 32
+#define COUNT_MATERIALS 8
+#define COUNT_WARMUP_FRAMES 10
+#define COUNT_FRAMES 200
+
+int main()
+{
+	HeadlessEngine engine;
+	NullRenderDevice* renderDevice = engine.GetRenderDevice();
+
+	{
+		AssimpModelLoader modelLoader;
+		MeshImportedData importedData = modelLoader.ImportModel("box", engine.GetResourceManager()->LoadFile("Assets/box_cubeUV.fbx"));
+
+		if (!importedData)
+		{
+			std::cout << "[RenderReplay] Could not import Assets/box_cubeUV.fbx" << std::endl;
+			return 1;
+		}
+
+		std::vector<Texture_ptr> textures = {
+			engine.GetResourceManager()->LoadTexture("Assets/Textures/dry-rocky-ground-unity/dry-rocky-ground_albedo.png"),
+			engine.GetResourceManager()->LoadTexture("Assets/Textures/blueprint.png")
+		};
+		Texture_ptr normalMap = engine.GetResourceManager()->LoadTexture("Assets/Textures/dry-rocky-ground-unity/dry-rocky-ground_normal-ogl.png");
+
+		auto matDef = engine.GetResourceManager()->GetOrLoadMaterialDefinition("Assets/Materials/Base/Textured.matd");
+
+		std::vector<std::shared_ptr<Material>> materials;
+		for (int i = 0; i < COUNT_MATERIALS; ++i)
+		{
+			auto matInstance = matDef->CreateInstance();
+			matInstance->SetTexture("Texture"_HASH, textures[i % textures.size()]);
+			matInstance->SetTexture("NormalMap"_HASH, normalMap);
+			materials.push_back(matInstance);
+		}
+
+		// The headless engine has no main viewport, the camera gets one like the asset preview does.
+		// Declared before the scene, the camera unbinds from it when destroyed
+		ViewPortManager viewPortManager;
+		RenderViewPort* viewPort = viewPortManager.Create(0, GraphicsFormat::RGBA8_UNORM);
+		viewPort->Resize({1920, 1080});
+
+		Scene scene;
+
+		for (int x = 0; x < COUNT_GRID; ++x)
+		{
+			for (int z = 0; z < COUNT_GRID; ++z)
+			{
+				Actor* actor = scene.SpawnActor<Actor, StaticMeshComponent>("Box " + std::to_string(x) + ", " + std::to_string(z), Vector3(x * 1.5f - COUNT_GRID * 0.75f, 0, -z * 1.5f), {}, Vector3(0.005f));
+				auto* meshComponent = StaticMeshComponent::Cast(actor->GetRootComponent());
+				meshComponent->SetMesh(importedData.Mesh);
+
+				for (auto& item : meshComponent->GetMaterialSet())
+				{
+					item.second.Material = materials[(x * COUNT_GRID + z) % COUNT_MATERIALS];
+				}
+			}
+		}
+
+		// Shadow cascades are drawn from the same scene
+		auto* dirLight = scene.SpawnActor<DirectionalLight>("DirLight", {})->GetRootComponent<DirectionalLightComponent>();
+		dirLight->GetTransform().SetRotation(-45, -45, 0);
+
+		Actor* cameraActor = scene.SpawnActor<Actor, CameraComponent>("Camera", Vector3(0, 8, 6), Vector3(-20, 0, 0));
+		auto* camera = CameraComponent::Cast(cameraActor->GetRootComponent());
+		camera->SetViewPort(viewPort);
+		camera->SetPerspective(75.0f, 0.1f, 500.0f);
+
+		// Every pass of the forward renderer: shadows, depth pre-pass, ambient, debug shapes and post processing
+		SceneRendererForward sceneRenderer;
+		sceneRenderer.LoadShaders();
+
+		for (int i = 0; i < COUNT_WARMUP_FRAMES; ++i)
+		{
+			engine.BeginFrame();
+			sceneRenderer.Render(&scene, nullptr);
+			engine.EndFrame();
+		}
+
+		FrameRenderStatistics frameTotals = {};
+		NullDeviceStatistics deviceTotals = {};
+		double renderMs = 0;
+
+		for (int i = 0; i < COUNT_FRAMES; ++i)
+		{
+			engine.BeginFrame();
+			renderDevice->ResetDeviceStatistics();
+
+			auto begin = std::chrono::steady_clock::now();
+			sceneRenderer.Render(&scene, nullptr);
+			renderMs += ElapsedMilliseconds(begin);
+
+			const FrameRenderStatistics& frameStatistics = renderDevice->GetFrameRenderStatistics();
+			frameTotals.DrawCalls += frameStatistics.DrawCalls;
+			frameTotals.BufferWrites += frameStatistics.BufferWrites;
+			frameTotals.BufferMaps += frameStatistics.BufferMaps;
+
+			const NullDeviceStatistics& deviceStatistics = renderDevice->GetDeviceStatistics();
+			deviceTotals.StateChanges += deviceStatistics.StateChanges;
+			deviceTotals.ShaderChanges += deviceStatistics.ShaderChanges;
+			deviceTotals.BindingChanges += deviceStatistics.BindingChanges;
+			deviceTotals.BindCalls += deviceStatistics.BindCalls;
+			deviceTotals.BytesUploaded += deviceStatistics.BytesUploaded;
+			deviceTotals.BytesMapped += deviceStatistics.BytesMapped;
+
+			engine.EndFrame();
+		}
+
+		std::cout << "[RenderReplay] SceneRendererForward, " << COUNT_GRID * COUNT_GRID << " boxes, " << COUNT_MATERIALS << " materials, " << COUNT_FRAMES << " frames" << std::endl;
+		std::cout << "[RenderReplay] CPU: " << renderMs / COUNT_FRAMES << " ms per frame" << std::endl;
+		std::cout << "[RenderReplay] Draw calls: " << frameTotals.DrawCalls / COUNT_FRAMES
+			<< ", buffer writes: " << frameTotals.BufferWrites / COUNT_FRAMES
+			<< ", buffer maps: " << frameTotals.BufferMaps / COUNT_FRAMES << " per frame" << std::endl;
+		std::cout << "[RenderReplay] State changes: " << deviceTotals.StateChanges / COUNT_FRAMES
+			<< ", shader changes: " << deviceTotals.ShaderChanges / COUNT_FRAMES
+			<< ", binding changes: " << deviceTotals.BindingChanges / COUNT_FRAMES
+			<< ", bind calls: " << deviceTotals.BindCalls / COUNT_FRAMES << " per frame" << std::endl;
+		std::cout << "[RenderReplay] Uploaded: " << deviceTotals.BytesUploaded / COUNT_FRAMES
+			<< " bytes, mapped: " << deviceTotals.BytesMapped / COUNT_FRAMES << " bytes per frame" << std::endl;
+
+		// One more frame with the recorder attached, to see what reached the device
+		RenderCommandRecorder recorder;
+		renderDevice->SetRecorder(&recorder);
+
+		engine.BeginFrame();
+		sceneRenderer.Render(&scene, nullptr);
+		engine.EndFrame();
+
+		renderDevice->SetRecorder(nullptr);
+
+		std::cout << "[RenderReplay] Recorded " << recorder.GetCommands().size() << " commands:" << std::endl;
+		for (uint32_t i = 0; i < (uint32_t)ERenderCommand::Count; ++i)
+		{
+			auto command = (ERenderCommand)i;
+
+			if (recorder.GetCount(command) == 0)
+				continue;
+
+			std::cout << "[RenderReplay]   " << RenderCommandToString(command) << ": " << recorder.GetCount(command) << std::endl;
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
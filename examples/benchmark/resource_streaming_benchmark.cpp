@@ -0,0 +1,115 @@
+#include <iostream>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+
+#include <Aurora/Core/FileSystem.hpp>
+#include <Aurora/Core/JobSystem.hpp>
+#include <Aurora/Resource/ResourceManager.hpp>
+#include "BenchmarkCommon.hpp"
+using namespace Aurora;
+
+#define COUNT_ITERATIONS 3
+
+// Measures the CPU side of texture streaming: file reads, image decode and mip generation.
+// There is no render device, so the uploads are not part of the measurement.
+int main()
+{
+	std::filesystem::current_path(AURORA_PROJECT_DIR);
+
+	std::vector<Path> textures;
+	for (const Path& file : FS::ListFiles("Assets", true))
+	{
+		if (ResourceManager::IsFileType(file, FT_IMAGE))
+			textures.push_back(file);
+	}
+
+	uint64_t decodedSize = 0;
+	double syncTime;
+
+	{ // Same work as LoadTexture, everything on the calling thread
+		ResourceManager resourceManager(nullptr);
+
+		auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < COUNT_ITERATIONS; ++i)
+		{
+			decodedSize = 0;
+
+			for (const Path& texture : textures)
+			{
+				ResourceManager::DecodedTexture decodedTexture;
+				resourceManager.DecodeTexture(texture, TextureLoadDesc(), decodedTexture);
+				decodedSize += decodedTexture.Pixels.size();
+			}
+		}
+
+		syncTime = ElapsedMilliseconds(begin) / COUNT_ITERATIONS;
+	}
+
+	std::cout << "Textures: " << textures.size() << ", " << (double)decodedSize / (1024.0 * 1024.0) << "MB with mips\n";
+	std::cout << "[Sync decode] " << syncTime << "ms, " << (double)textures.size() / (syncTime / 1000.0) << " textures/s\n";
+
+	uint32_t maxThreads = JobSystem::GetDefaultWorkerCount() + 1;
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	for (uint32_t threads : threadCounts)
+	{
+		// The calling thread decodes too while it waits
+		JobSystem jobSystem(threads - 1);
+		JobSystem* jobSystemPtr = threads > 1 ? &jobSystem : nullptr;
+
+		double submitTime = 0.0;
+		double totalTime = 0.0;
+		uint32_t failedCount = 0;
+
+		for (uint32_t i = 0; i < COUNT_ITERATIONS; ++i)
+		{
+			// New manager every iteration, so nothing is cached or merged with the previous run
+			ResourceManager resourceManager(nullptr, jobSystemPtr);
+
+			auto begin = std::chrono::steady_clock::now();
+
+			std::vector<TextureHandle> handles;
+			handles.reserve(textures.size());
+
+			for (size_t t = 0; t < textures.size(); ++t)
+			{
+				auto priority = (ELoadPriority)(t % LoadPriorityCount);
+				handles.push_back(resourceManager.LoadTextureAsync(textures[t], TextureLoadDesc(), priority));
+			}
+
+			submitTime += ElapsedMilliseconds(begin);
+
+			resourceManager.GetStreamer().WaitForDecodes();
+			totalTime += ElapsedMilliseconds(begin);
+
+			for (const TextureHandle& handle : handles)
+			{
+				if (handle.GetState() != ELoadState::Decoded)
+					failedCount++;
+			}
+		}
+
+		submitTime /= COUNT_ITERATIONS;
+		totalTime /= COUNT_ITERATIONS;
+
+		std::cout << "[Async decode, " << threads << " threads] submit " << submitTime << "ms, decoded " << totalTime << "ms, "
+			<< (double)textures.size() / (totalTime / 1000.0) << " textures/s, " << syncTime / totalTime << "x\n";
+
+		if (failedCount > 0)
+		{
+			std::cout << "Error: " << failedCount << " textures were not decoded\n";
+		}
+	}
+
+	return 0;
+}
@@ -10,6 +10,8 @@
 
 #include "Core/assert.hpp"
 #include "Core/Profiler.hpp"
+#include "Core/JobSystem.hpp"
+#include "Memory/FrameAllocator.hpp"
 
 #include "App/GLFWWindow.hpp"
 #include "App/Input/GLFW/Manager.hpp"
@@ -71,6 +73,7 @@ namespace Aurora
 		m_AppContext(nullptr),
 		m_RmlUI(nullptr),
 		m_ViewPortManager(nullptr),
+		m_JobSystem(nullptr),
 		m_VgRender(nullptr),
 		m_EditorPanel(nullptr),
 		m_RenderViewPort(nullptr)
@@ -82,7 +85,7 @@ namespace Aurora
 	AuroraEngine::~AuroraEngine()
 	{
 		DShapes::Destroy();
-		Aum::AllMemoryAllocators.clear();
+		Aum::ClearAllocators();
 		delete Aurora::AppContext::m_GameMode; // Needs to be deleted here because of destroy order
 		delete m_AppContext;
 		delete m_EditorPanel;
@@ -103,6 +106,7 @@ namespace Aurora
 			gladUninstallGLDebug();
 		}
 
+		delete m_JobSystem;
 		delete m_SwapChain;
 		delete m_Window;
 		delete GEngine;
@@ -181,7 +185,7 @@ namespace Aurora
 
 		AppContext::m_EditorMode = editor;
 
-		LocalProfileScope::Reset("GameInit");
+		Profiler::SetThreadName("Main");
 
 		if(!glfwInit())
         {
@@ -193,6 +197,9 @@ namespace Aurora
 		GEngine = new AuroraContext();
 		GEngine->m_AppContext = appContext;
 
+		m_JobSystem = new JobSystem();
+		GEngine->m_JobSystem = m_JobSystem;
+
 		// Init and create window
 		m_Window = new GLFWWindow();
 		m_Window->Initialize(windowDefinition, nullptr);
@@ -256,7 +263,7 @@ namespace Aurora
 		m_RenderManager = new RenderManager(m_RenderDevice);
 
 		// Init resource manager (for loading assets)
-		m_ResourceManager = new ResourceManager(m_RenderDevice);
+		m_ResourceManager = new ResourceManager(m_RenderDevice, m_JobSystem);
 #if AU_IN_PROJECT_ASSETS
 		m_ResourceManager->AddFileSearchPath(AURORA_PROJECT_DIR);
 #endif
@@ -356,7 +363,8 @@ namespace Aurora
 
 		while(m_Window->IsShouldClose() == false && GEngine->m_IsRunning)
 		{
-			LocalProfileScope::Reset("GameFrame");
+			Profiler::BeginFrame();
+			FrameAllocator::Get().BeginFrame();
 			double currentTime = glfwGetTime();
 			double frameTime = currentTime - lastTime;
 			double delta = frameTime;
@@ -409,6 +417,11 @@ namespace Aurora
 				}
 			}
 
+			{
+				CPU_DEBUG_SCOPE("ResourceUploads");
+				m_ResourceManager->ProcessUploads();
+			}
+
 #ifdef AU_FMOD_SOUND
 			{
 				CPU_DEBUG_SCOPE("FMOD SoundSystem");
@@ -423,6 +436,11 @@ namespace Aurora
 				ImGui::NewFrame();
 			}
 
+			if(ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_F10), false))
+			{
+				Profiler::ExportChromeTrace("profile.json");
+			}
+
 			if(ImGui::GetIO().KeysDown[ImGui::GetKeyIndex(ImGuiKey_F11)])
 			{
 				if (GEngine->GetAppContext()->GetSceneRenderer())
@@ -614,6 +632,27 @@ namespace Aurora
 			GEngine->m_RenderDevice->InvalidateState();
 			DShapes::Reset();
 
+			if (Profiler::IsEnabled())
+			{
+				const FrameRenderStatistics& renderStatistics = m_RenderDevice->GetFrameRenderStatistics();
+				Profiler::SetCounter("Draw calls", renderStatistics.DrawCalls);
+				Profiler::SetCounter("Vertices", renderStatistics.VertexCount);
+				Profiler::SetCounter("Buffer writes", renderStatistics.BufferWrites);
+				Profiler::SetCounter("Uniform buffer bytes", m_RenderManager->GetUniformBufferCache().GetNumBytesPerFrame());
+
+				size_t allocatorUsedBytes = 0;
+				size_t allocatorAllocations = 0;
+				Aum::ForEachAllocator([&allocatorUsedBytes, &allocatorAllocations](Aum* allocator)
+				{
+					allocatorUsedBytes += allocator->GetUsedBytes();
+					allocatorAllocations += allocator->GetAllocationCount();
+				});
+
+				Profiler::SetCounter("Allocator used bytes", (int64_t)allocatorUsedBytes);
+				Profiler::SetCounter("Allocator allocations", (int64_t)allocatorAllocations);
+				Profiler::SetCounter("Frame allocator bytes", (int64_t)FrameAllocator::Get().GetStats().FrameBytes);
+			}
+
 			{
 				m_RenderManager->EndFrame();
 				m_RenderDevice->ResetFrameRenderStatistics();
@@ -12,6 +12,7 @@ namespace Aurora
 	class ViewPortManager;
 	struct RenderViewPort;
 	class MainEditorPanel;
+	class JobSystem;
 
 	namespace Input
 	{
@@ -30,6 +31,7 @@ namespace Aurora
 		RmlUI* m_RmlUI;
 		VgRender* m_VgRender;
 		ViewPortManager* m_ViewPortManager;
+		JobSystem* m_JobSystem;
 
 		AppContext* m_AppContext;
 
@@ -1,6 +1,12 @@
 #pragma once
 
 #include <vector>
+#include <span>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
 #include "Types.hpp"
 #include "Vector.hpp"
 
@@ -50,19 +56,28 @@
 
 namespace Aurora
 {
+	// Binary buffer for serialization. Arrays of trivially copyable types are copied in bulk.
+	// An archive created from a span is a read-only view, the data is not copied and has to outlive the archive.
 	class Archive
 	{
 	private:
 		std::vector<uint8_t> m_Buffer;
+		std::span<const uint8_t> m_View;
+		bool m_IsView{};
 		size_t m_CurrentRead{};
 		static const std::size_t StreamEofBufferStep = 1024;
 	public:
-		Archive() : m_Buffer(), m_CurrentRead(0)
+		Archive() : m_Buffer(), m_View(), m_IsView(false), m_CurrentRead(0)
 		{
 
 		}
 
-		explicit Archive(std::vector<uint8_t> buffer) : m_Buffer(std::move(buffer)), m_CurrentRead(0)
+		explicit Archive(std::vector<uint8_t> buffer) : m_Buffer(std::move(buffer)), m_View(), m_IsView(false), m_CurrentRead(0)
+		{
+
+		}
+
+		explicit Archive(std::span<const uint8_t> view) : m_Buffer(), m_View(view), m_IsView(true), m_CurrentRead(0)
 		{
 
 		}
@@ -107,53 +122,161 @@ namespace Aurora
 			std::copy(array, array + arraySize, m_Buffer.data());
 		}
 
-		template<typename T>
-		inline void Write(T data)
+		inline void Reserve(size_t size)
 		{
-			m_Buffer.reserve(sizeof(T));
+			m_Buffer.reserve(size);
+		}
+
+		inline void WriteBytes(const void* data, size_t size)
+		{
+			if (m_IsView)
+				throw std::runtime_error("Cannot write to a read-only archive");
+
+			if (size == 0)
+				return;
 
-			for(std::size_t i = 0; i < sizeof(T); i++)
-				m_Buffer.emplace_back(*(reinterpret_cast<char*>(&data) + i));
+			size_t offset = m_Buffer.size();
+
+			// Grow geometrically, resize alone would reallocate on every write once the reserved space runs out
+			if (offset + size > m_Buffer.capacity())
+				m_Buffer.reserve(std::max(offset + size, m_Buffer.capacity() * 2));
+
+			m_Buffer.resize(offset + size);
+			std::memcpy(m_Buffer.data() + offset, data, size);
+		}
+
+		inline void ReadBytes(void* data, size_t size)
+		{
+			if (size > GetRemaining())
+				throw std::runtime_error("Archive read past the end");
+
+			if (size == 0)
+				return;
+
+			std::memcpy(data, GetData() + m_CurrentRead, size);
+			m_CurrentRead += size;
 		}
 
 		template<typename T>
-		inline T Read()
+		inline void Write(const T& data)
 		{
-			T var;
+			static_assert(std::is_trivially_copyable_v<T>);
+			WriteBytes(&data, sizeof(T));
+		}
 
-			memcpy(&var, GetBufferPointer() + m_CurrentRead, sizeof(T));
-			m_CurrentRead += sizeof(T);
+		template<typename T>
+		inline T Read()
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
 
+			T var;
+			ReadBytes(&var, sizeof(T));
 			return var;
 		}
 
 		template<typename T>
 		inline void WriteArray(const T* data, size_t size)
 		{
-			for (size_t i = 0; i < size; ++i) {
-				(*this) << data[i];
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				WriteBytes(data, size * sizeof(T));
+			}
+			else
+			{
+				for (size_t i = 0; i < size; ++i) {
+					(*this) << data[i];
+				}
 			}
 		}
 
 		template<typename T>
 		inline void ReadArray(T* data, size_t size)
 		{
-			for (size_t i = 0; i < size; ++i) {
-				(*this) >> data[i];
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (size > GetRemaining() / sizeof(T))
+					throw std::runtime_error("Archive read past the end");
+
+				ReadBytes(data, size * sizeof(T));
+			}
+			else
+			{
+				for (size_t i = 0; i < size; ++i) {
+					(*this) >> data[i];
+				}
 			}
 		}
 
+		static constexpr uint32_t MakeChunkTag(const char (&name)[5])
+		{
+			return (uint32_t)(uint8_t)name[0] | ((uint32_t)(uint8_t)name[1] << 8) | ((uint32_t)(uint8_t)name[2] << 16) | ((uint32_t)(uint8_t)name[3] << 24);
+		}
+
+		// Chunks are a tag and the byte size of their content, readers skip the chunks they do not know.
+		// Returns the position that has to be passed to EndChunk once the content is written.
+		inline size_t BeginChunk(uint32_t tag)
+		{
+			size_t position = m_Buffer.size();
+			ChunkHeader header = {tag, 0, 0};
+			Write(header);
+			return position;
+		}
+
+		inline void EndChunk(size_t position)
+		{
+			uint64_t size = m_Buffer.size() - position - sizeof(ChunkHeader);
+			std::memcpy(m_Buffer.data() + position + offsetof(ChunkHeader, Size), &size, sizeof(size));
+		}
+
+		// The chunk archive views the content of the next chunk, returns false at the end of the archive
+		inline bool ReadChunk(uint32_t& tag, Archive& chunk)
+		{
+			if (IsEnd())
+				return false;
+
+			auto header = Read<ChunkHeader>();
+
+			if (header.Size > GetRemaining())
+				throw std::runtime_error("Archive chunk is larger than the archive");
+
+			tag = header.Tag;
+			chunk = Archive(std::span<const uint8_t>(GetData() + m_CurrentRead, (size_t)header.Size));
+			m_CurrentRead += header.Size;
+			return true;
+		}
+
+		inline void Skip(size_t size)
+		{
+			if (size > GetRemaining())
+				throw std::runtime_error("Archive read past the end");
+
+			m_CurrentRead += size;
+		}
+
 		inline friend std::ostream& operator<<(std::ostream& out, Archive& buffer)
 		{
-			out.write(reinterpret_cast<const char*>(buffer.GetBufferPointer()), buffer.GetLength());
+			out.write(reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength());
 
 			return out;
 		}
 
 		inline uint8_t* GetBufferPointer() { return GetBuffer().data(); }
 		inline std::vector<uint8_t>& GetBuffer() { return m_Buffer; }
-		inline size_t GetSize() { return m_Buffer.size() * sizeof(uint8_t); }
-		inline size_t GetLength() { return m_Buffer.size(); }
+		[[nodiscard]] inline const uint8_t* GetData() const { return m_IsView ? m_View.data() : m_Buffer.data(); }
+		[[nodiscard]] inline size_t GetSize() const { return m_IsView ? m_View.size() : m_Buffer.size(); }
+		[[nodiscard]] inline size_t GetLength() const { return GetSize(); }
+		[[nodiscard]] inline bool IsView() const { return m_IsView; }
+
+		[[nodiscard]] inline size_t GetReadPosition() const { return m_CurrentRead; }
+		[[nodiscard]] inline size_t GetRemaining() const { return GetSize() - m_CurrentRead; }
+		[[nodiscard]] inline bool IsEnd() const { return m_CurrentRead >= GetSize(); }
+	private:
+		struct ChunkHeader
+		{
+			uint32_t Tag;
+			uint32_t Reserved;
+			uint64_t Size;
+		};
 	public:
 		DEF_OP(int8_t);
 		DEF_OP(uint8_t);
@@ -188,11 +311,7 @@ namespace Aurora
 		inline friend Archive& operator<<(Archive& buffer, const std::string& value)
 		{
 			buffer << static_cast<int>(value.length());
-
-			for (char i : value) {
-				buffer << static_cast<int8_t>(i);
-			}
-
+			buffer.WriteBytes(value.data(), value.length());
 			return buffer;
 		}
 
@@ -200,11 +319,12 @@ namespace Aurora
 		{
 			int len;
 			buffer >> len;
-			for (int i = 0; i < len; ++i) {
-				int8_t c;
-				buffer >> c;
-				value += c;
-			}
+
+			if (len < 0 || (size_t)len > buffer.GetRemaining())
+				throw std::runtime_error("Archive read past the end");
+
+			value.assign(reinterpret_cast<const char*>(buffer.GetData() + buffer.m_CurrentRead), (size_t)len);
+			buffer.m_CurrentRead += len;
 			return buffer;
 		}
 
@@ -212,21 +332,26 @@ namespace Aurora
 		inline friend Archive& operator<<(Archive& buffer, const std::vector<T>& list)
 		{
 			buffer << static_cast<uint32_t>(list.size());
-			for(auto& e : list) {
-				buffer.Write<T>(e);
-			}
+			buffer.WriteArray(list.data(), list.size());
 			return buffer;
 		}
 
 		template<typename T>
 		inline friend Archive& operator>>(Archive& buffer, std::vector<T>& list)
 		{
-			list.clear();
 			uint32_t count;
 			buffer >> count;
-			for (int i = 0; i < count; ++i) {
-				list.push_back(buffer.Read<T>());
+
+			// Count is checked before the allocation, a corrupted one must not allocate gigabytes
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (count > buffer.GetRemaining() / sizeof(T))
+					throw std::runtime_error("Archive read past the end");
 			}
+
+			list.clear();
+			list.resize(count);
+			buffer.ReadArray(list.data(), list.size());
 			return buffer;
 		}
 	};
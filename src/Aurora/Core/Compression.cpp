@@ -0,0 +1,123 @@
+#include "Compression.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <lz4.h>
+#include <lz4hc.h>
+#include <zstd.h>
+
+namespace Aurora::Compression
+{
+	struct ZstdContexts
+	{
+		ZSTD_CCtx* CompressContext = nullptr;
+		ZSTD_DCtx* DecompressContext = nullptr;
+
+		~ZstdContexts()
+		{
+			ZSTD_freeCCtx(CompressContext);
+			ZSTD_freeDCtx(DecompressContext);
+		}
+	};
+
+	// Contexts hold the codec work memory, creating them for every call would allocate hundreds of kilobytes each time
+	static ZstdContexts& GetZstdContexts()
+	{
+		thread_local ZstdContexts contexts;
+		return contexts;
+	}
+
+	size_t GetCompressBound(ECompressionCodec codec, size_t size)
+	{
+		switch (codec)
+		{
+			case ECompressionCodec::LZ4:
+				return size > LZ4_MAX_INPUT_SIZE ? 0 : (size_t)LZ4_compressBound((int)size);
+			case ECompressionCodec::Zstd:
+				return ZSTD_compressBound(size);
+			default:
+				return size;
+		}
+	}
+
+	size_t Compress(const CompressionSettings& settings, std::span<const uint8_t> source, std::span<uint8_t> destination)
+	{
+		switch (settings.Codec)
+		{
+			case ECompressionCodec::LZ4:
+			{
+				if (source.size() > LZ4_MAX_INPUT_SIZE)
+					return 0;
+
+				auto sourceData = reinterpret_cast<const char*>(source.data());
+				auto destinationData = reinterpret_cast<char*>(destination.data());
+				auto destinationSize = (int)std::min<size_t>(destination.size(), INT32_MAX);
+
+				int size;
+				if (settings.Level > 2)
+					size = LZ4_compress_HC(sourceData, destinationData, (int)source.size(), destinationSize, settings.Level);
+				else
+					size = LZ4_compress_default(sourceData, destinationData, (int)source.size(), destinationSize);
+
+				return size > 0 ? (size_t)size : 0;
+			}
+			case ECompressionCodec::Zstd:
+			{
+				ZstdContexts& contexts = GetZstdContexts();
+
+				if (!contexts.CompressContext)
+					contexts.CompressContext = ZSTD_createCCtx();
+
+				size_t size = ZSTD_compressCCtx(contexts.CompressContext, destination.data(), destination.size(), source.data(), source.size(), settings.Level);
+				return ZSTD_isError(size) ? 0 : size;
+			}
+			default:
+			{
+				if (destination.size() < source.size())
+					return 0;
+
+				if (!source.empty())
+					std::memcpy(destination.data(), source.data(), source.size());
+
+				return source.size();
+			}
+		}
+	}
+
+	bool Decompress(ECompressionCodec codec, std::span<const uint8_t> source, std::span<uint8_t> destination)
+	{
+		switch (codec)
+		{
+			case ECompressionCodec::LZ4:
+			{
+				if (source.size() > INT32_MAX || destination.size() > INT32_MAX)
+					return false;
+
+				int size = LZ4_decompress_safe(reinterpret_cast<const char*>(source.data()), reinterpret_cast<char*>(destination.data()), (int)source.size(), (int)destination.size());
+				return size >= 0 && (size_t)size == destination.size();
+			}
+			case ECompressionCodec::Zstd:
+			{
+				ZstdContexts& contexts = GetZstdContexts();
+
+				if (!contexts.DecompressContext)
+					contexts.DecompressContext = ZSTD_createDCtx();
+
+				size_t size = ZSTD_decompressDCtx(contexts.DecompressContext, destination.data(), destination.size(), source.data(), source.size());
+				return !ZSTD_isError(size) && size == destination.size();
+			}
+			case ECompressionCodec::None:
+			{
+				if (source.size() != destination.size())
+					return false;
+
+				if (!source.empty())
+					std::memcpy(destination.data(), source.data(), source.size());
+
+				return true;
+			}
+			default:
+				return false;
+		}
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <span>
+#include "Types.hpp"
+
+namespace Aurora
+{
+	enum class ECompressionCodec : uint32_t
+	{
+		None = 0,
+		// Fastest to decode, used for large binary data
+		LZ4,
+		// Best ratio, used for text
+		Zstd
+	};
+
+	struct CompressionSettings
+	{
+		ECompressionCodec Codec = ECompressionCodec::None;
+		// Codec specific, LZ4 levels above 2 use the HC compressor
+		int Level = 0;
+	};
+}
+
+namespace Aurora::Compression
+{
+	// Largest output Compress can produce for the input size
+	AU_API size_t GetCompressBound(ECompressionCodec codec, size_t size);
+
+	// Returns the compressed size or 0 when the data could not be compressed into the destination
+	AU_API size_t Compress(const CompressionSettings& settings, std::span<const uint8_t> source, std::span<uint8_t> destination);
+
+	// Destination has to be exactly the size of the uncompressed data
+	AU_API bool Decompress(ECompressionCodec codec, std::span<const uint8_t> source, std::span<uint8_t> destination);
+}
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Aurora
@@ -12,65 +18,184 @@ namespace Aurora
 		typedef ReturnType(UserClass::*Type)(ArgsTypes...);
 	};
 
+	template<class UserClass, typename ReturnType, typename... ArgsTypes>
+	struct ConstMethodAction
+	{
+		typedef ReturnType(UserClass::*Type)(ArgsTypes...) const;
+	};
+
 	template<typename ReturnType, typename... ArgsTypes>
 	struct FunctionAction
 	{
 		typedef ReturnType(*Type)(ArgsTypes...);
 	};
 
+	// Callable stored by value, function pointers, methods and lambdas up to InlineSize bytes never allocate.
+	// Larger callables are moved to the heap.
 	template<typename ReturnType = void, typename... ArgsTypes>
-	class IDelegate
-	{
-	public:
-		virtual ~IDelegate() = default;
-		virtual ReturnType Invoke(ArgsTypes&& ...args) = 0;
-		virtual ReturnType InvokeCopy(ArgsTypes ...args) = 0;
-	};
-
-	template<class UserClass, typename ReturnType, typename... ArgsTypes>
-	class MethodDelegate : public IDelegate<ReturnType, ArgsTypes...>
+	class Delegate
 	{
 	public:
-		typedef typename MethodAction<UserClass, ReturnType, ArgsTypes...>::Type MethodPtr;
+		// Fits an instance pointer with any method pointer, which take up to three pointers on MSVC
+		static constexpr size_t InlineSize = 4 * sizeof(void*);
 	private:
-		UserClass* m_Instance;
-		MethodPtr m_Method;
-	public:
-		MethodDelegate() : m_Instance(nullptr), m_Method(nullptr) {}
-		MethodDelegate(UserClass* instance, MethodPtr method) : m_Instance(instance), m_Method(method) {}
+		enum class EOperation : uint8_t
+		{
+			Move,
+			Destroy
+		};
+
+		typedef ReturnType(*InvokeFunction)(void* storage, ArgsTypes&&... args);
+		// Null for callables stored inline that can be copied with memcpy
+		typedef void(*ManageFunction)(EOperation operation, void* storage, void* other);
+
+		alignas(alignof(void*)) mutable unsigned char m_Storage[InlineSize];
+		InvokeFunction m_Invoke;
+		ManageFunction m_Manage;
+
+		template<typename Callable>
+		static constexpr bool IsInline = sizeof(Callable) <= InlineSize && alignof(Callable) <= alignof(void*) && std::is_nothrow_move_constructible_v<Callable>;
 
-		ReturnType Invoke(ArgsTypes&& ...args) override
+		template<typename Callable>
+		static Callable* GetCallable(void* storage)
 		{
-			return (*m_Instance.*m_Method)(std::forward<ArgsTypes&&>(args)...);
-			//return std::invoke(m_Method, *m_Instance, args...);
+			if constexpr (IsInline<Callable>)
+				return std::launder(reinterpret_cast<Callable*>(storage));
+			else
+				return *reinterpret_cast<Callable**>(storage);
 		}
 
-		ReturnType InvokeCopy(ArgsTypes ...args) override
+		template<typename Callable>
+		static ReturnType InvokeCallable(void* storage, ArgsTypes&&... args)
 		{
-			return (*m_Instance.*m_Method)(args...);
-			//return std::invoke(m_Method, *m_Instance, args...);
+			return (*GetCallable<Callable>(storage))(std::forward<ArgsTypes>(args)...);
 		}
-	};
 
-	template<typename ReturnType, typename... ArgsTypes>
-	class FunctionDelegate : public IDelegate<ReturnType, ArgsTypes...>
-	{
-	public:
-		typedef typename FunctionAction<ReturnType, ArgsTypes...>::Type FunctionPtr;
-	private:
-		FunctionPtr m_Function;
+		template<typename Callable>
+		static void ManageCallable(EOperation operation, void* storage, void* other)
+		{
+			switch (operation)
+			{
+				case EOperation::Move:
+					if constexpr (IsInline<Callable>)
+					{
+						Callable* callable = GetCallable<Callable>(other);
+						new(storage) Callable(std::move(*callable));
+						callable->~Callable();
+					}
+					else
+					{
+						std::memcpy(storage, other, sizeof(Callable*));
+					}
+					break;
+				case EOperation::Destroy:
+					if constexpr (IsInline<Callable>)
+						GetCallable<Callable>(storage)->~Callable();
+					else
+						delete GetCallable<Callable>(storage);
+					break;
+			}
+		}
+
+		template<typename Callable>
+		void Store(Callable&& callable)
+		{
+			typedef std::decay_t<Callable> CallableType;
+
+			if constexpr (IsInline<CallableType>)
+				new(m_Storage) CallableType(std::forward<Callable>(callable));
+			else
+				*reinterpret_cast<CallableType**>(m_Storage) = new CallableType(std::forward<Callable>(callable));
+
+			m_Invoke = &InvokeCallable<CallableType>;
+			m_Manage = IsInline<CallableType> && std::is_trivially_copyable_v<CallableType> ? nullptr : &ManageCallable<CallableType>;
+		}
+
+		void MoveFrom(Delegate& other) noexcept
+		{
+			if (other.m_Manage)
+				other.m_Manage(EOperation::Move, m_Storage, other.m_Storage);
+			else
+				std::memcpy(m_Storage, other.m_Storage, InlineSize);
+
+			m_Invoke = other.m_Invoke;
+			m_Manage = other.m_Manage;
+			other.m_Invoke = nullptr;
+			other.m_Manage = nullptr;
+		}
+
+		void Reset() noexcept
+		{
+			if (m_Manage)
+				m_Manage(EOperation::Destroy, m_Storage, nullptr);
+
+			m_Invoke = nullptr;
+			m_Manage = nullptr;
+		}
 	public:
-		inline explicit FunctionDelegate(FunctionPtr function) : m_Function(function) {}
+		Delegate() noexcept : m_Storage(), m_Invoke(nullptr), m_Manage(nullptr) {}
+
+		Delegate(typename FunctionAction<ReturnType, ArgsTypes...>::Type function) : Delegate()
+		{
+			if (function)
+				Store(function);
+		}
+
+		template<class UserClass>
+		Delegate(UserClass* instance, typename MethodAction<UserClass, ReturnType, ArgsTypes...>::Type method) : Delegate()
+		{
+			Store([instance, method](ArgsTypes&&... args) -> ReturnType { return (instance->*method)(std::forward<ArgsTypes>(args)...); });
+		}
 
-		ReturnType Invoke(ArgsTypes&& ...args) override
+		template<class UserClass>
+		Delegate(const UserClass* instance, typename ConstMethodAction<UserClass, ReturnType, ArgsTypes...>::Type method) : Delegate()
 		{
-			return m_Function(std::forward<ArgsTypes&&>(args)...);
+			Store([instance, method](ArgsTypes&&... args) -> ReturnType { return (instance->*method)(std::forward<ArgsTypes>(args)...); });
 		}
 
-		ReturnType InvokeCopy(ArgsTypes ...args) override
+		template<typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, Delegate> && std::is_invocable_r_v<ReturnType, Callable&, ArgsTypes...>>>
+		Delegate(Callable&& callable) : Delegate()
+		{
+			Store(std::forward<Callable>(callable));
+		}
+
+		// Only movable, a copy would share the state of the callable
+		Delegate(const Delegate& other) = delete;
+		Delegate& operator=(const Delegate& other) = delete;
+
+		Delegate(Delegate&& other) noexcept : Delegate()
 		{
-			return m_Function(args...);
+			MoveFrom(other);
 		}
+
+		Delegate& operator=(Delegate&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Reset();
+				MoveFrom(other);
+			}
+
+			return *this;
+		}
+
+		~Delegate()
+		{
+			Reset();
+		}
+
+		ReturnType Invoke(ArgsTypes&& ...args) const
+		{
+			return m_Invoke(m_Storage, std::forward<ArgsTypes>(args)...);
+		}
+
+		ReturnType InvokeCopy(ArgsTypes ...args) const
+		{
+			return m_Invoke(m_Storage, std::forward<ArgsTypes>(args)...);
+		}
+
+		[[nodiscard]] bool IsBound() const { return m_Invoke != nullptr; }
+		explicit operator bool() const { return m_Invoke != nullptr; }
 	};
 
 #if INTPTR_MAX == INT64_MAX
@@ -124,83 +249,187 @@ namespace Aurora
 		}
 	};
 
+	// Listeners are kept in one array in the order they were bound, EventIDs only grow so they stay sorted.
+	// Listeners may bind and unbind from inside Invoke: unbound ones are skipped right away,
+	// new ones are called from the next Invoke on.
 	template<typename... ArgsTypes>
 	class EventEmitter : public EventEmitterBase
 	{
 	public:
-		typedef IDelegate<void, ArgsTypes...>* Delegate;
+		typedef Aurora::Delegate<void, ArgsTypes...> Delegate;
 	private:
-		std::vector<Delegate> m_Delegates;
-	public:
-		~EventEmitter() override
+		struct Listener
+		{
+			EventID ID;
+			bool Bound;
+			Delegate Callback;
+		};
+
+		// Unbound listeners stay in place until they are the majority, so unbinding does not move the others
+		mutable std::vector<Listener> m_Listeners;
+		// Bound during Invoke, m_Listeners can not grow while it is iterated
+		mutable std::vector<Listener> m_PendingListeners;
+		mutable uint32_t m_InvokeDepth = 0;
+		mutable bool m_HasPendingListeners = false;
+		size_t m_UnboundCount = 0;
+		EventID m_NextID = 1;
+
+		struct InvokeScope
 		{
-			for(Delegate delegate : m_Delegates)
+			const EventEmitter& Emitter;
+
+			explicit InvokeScope(const EventEmitter& emitter) : Emitter(emitter)
+			{
+				Emitter.m_InvokeDepth++;
+			}
+
+			~InvokeScope()
 			{
-				delete delegate;
+				if (--Emitter.m_InvokeDepth == 0 && Emitter.m_HasPendingListeners)
+					Emitter.AddPendingListeners();
 			}
+		};
+
+		void AddPendingListeners() const
+		{
+			for (Listener& listener : m_PendingListeners)
+			{
+				if (listener.Bound)
+					m_Listeners.push_back(std::move(listener));
+			}
+
+			m_PendingListeners.clear();
+			m_HasPendingListeners = false;
 		}
 
-		EventID Bind(Delegate delegate)
+		void RemoveUnboundListeners()
+		{
+			m_Listeners.erase(std::remove_if(m_Listeners.begin(), m_Listeners.end(), [](const Listener& listener) { return !listener.Bound; }), m_Listeners.end());
+			m_UnboundCount = 0;
+		}
+	public:
+		EventID Bind(Delegate&& delegate)
 		{
-			m_Delegates.push_back(delegate);
-			return reinterpret_cast<EventID>(delegate);
+			EventID eventId = m_NextID++;
+
+			if (m_InvokeDepth > 0)
+			{
+				m_PendingListeners.push_back({eventId, true, std::move(delegate)});
+				m_HasPendingListeners = true;
+			}
+			else
+			{
+				m_Listeners.push_back({eventId, true, std::move(delegate)});
+			}
+
+			return eventId;
 		}
 
-		UniqueEvent BindUnique(Delegate delegate)
+		UniqueEvent BindUnique(Delegate&& delegate)
 		{
-			m_Delegates.push_back(delegate);
-			return UniqueEvent(this, reinterpret_cast<EventID>(delegate));
+			return UniqueEvent(this, Bind(std::move(delegate)));
 		}
 
 		EventID Bind(typename FunctionAction<void, ArgsTypes...>::Type function)
 		{
-			return Bind(new FunctionDelegate<void, ArgsTypes...>(function));
+			return Bind(Delegate(function));
 		}
 
 		UniqueEvent BindUnique(typename FunctionAction<void, ArgsTypes...>::Type function)
 		{
-			return BindUnique(new FunctionDelegate<void, ArgsTypes...>(function));
+			return BindUnique(Delegate(function));
 		}
 
 		template<class UserClass>
 		EventID Bind(UserClass* instance, typename MethodAction<UserClass, void, ArgsTypes...>::Type method)
 		{
-			return Bind(new MethodDelegate<UserClass, void, ArgsTypes...>(instance, method));
+			return Bind(Delegate(instance, method));
 		}
 
 		template<class UserClass>
 		UniqueEvent BindUnique(UserClass* instance, typename MethodAction<UserClass, void, ArgsTypes...>::Type method)
 		{
-			return BindUnique(new MethodDelegate<UserClass, void, ArgsTypes...>(instance, method));
+			return BindUnique(Delegate(instance, method));
+		}
+
+		template<typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, Delegate> && std::is_invocable_v<Callable&, ArgsTypes...>>>
+		EventID Bind(Callable&& callable)
+		{
+			return Bind(Delegate(std::forward<Callable>(callable)));
+		}
+
+		template<typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, Delegate> && std::is_invocable_v<Callable&, ArgsTypes...>>>
+		UniqueEvent BindUnique(Callable&& callable)
+		{
+			return BindUnique(Delegate(std::forward<Callable>(callable)));
 		}
 
 		bool Unbind(EventID eventId) override
 		{
-			auto it = std::find(m_Delegates.begin(), m_Delegates.end(), reinterpret_cast<Delegate>(eventId));
+			auto it = std::lower_bound(m_Listeners.begin(), m_Listeners.end(), eventId, [](const Listener& listener, EventID id) { return listener.ID < id; });
+
+			if (it == m_Listeners.end() || it->ID != eventId)
+			{
+				// Bound during the current Invoke
+				it = std::find_if(m_PendingListeners.begin(), m_PendingListeners.end(), [eventId](const Listener& listener) { return listener.ID == eventId; });
 
-			if(it == m_Delegates.end())
+				if (it == m_PendingListeners.end() || !it->Bound)
+					return false;
+
+				it->Bound = false;
+				return true;
+			}
+
+			if (!it->Bound)
 				return false;
 
-			delete *it;
-			m_Delegates.erase(it);
+			// The listener may be the one running, its callable is only destroyed outside of Invoke
+			it->Bound = false;
+			m_UnboundCount++;
+
+			if (m_InvokeDepth == 0 && m_UnboundCount * 2 > m_Listeners.size())
+				RemoveUnboundListeners();
 
 			return true;
 		}
 
+		[[nodiscard]] size_t GetListenerCount() const
+		{
+			size_t count = m_Listeners.size() - m_UnboundCount;
+
+			for (const Listener& listener : m_PendingListeners)
+				count += listener.Bound;
+
+			return count;
+		}
+
 		void Invoke(ArgsTypes&& ...args) const
 		{
-			for(const Delegate& delegate : m_Delegates)
+			InvokeScope scope(*this);
+
+			// Listeners bound from here on go to m_PendingListeners, so the array does not move
+			const size_t count = m_Listeners.size();
+			for (size_t i = 0; i < count; ++i)
 			{
-				delegate->Invoke(std::forward<ArgsTypes>(args)...);
+				const Listener& listener = m_Listeners[i];
+
+				if (listener.Bound)
+					listener.Callback.Invoke(std::forward<ArgsTypes>(args)...);
 			}
 		}
 
 		void InvokeCopy(ArgsTypes ...args) const
 		{
-			for(const Delegate& delegate : m_Delegates)
+			InvokeScope scope(*this);
+
+			const size_t count = m_Listeners.size();
+			for (size_t i = 0; i < count; ++i)
 			{
-				delegate->InvokeCopy(args...);
+				const Listener& listener = m_Listeners[i];
+
+				if (listener.Bound)
+					listener.Callback.InvokeCopy(args...);
 			}
 		}
 	};
-}
\ No newline at end of file
+}
@@ -1,6 +1,15 @@
 #include "FileWatcher.hpp"
 #include "Aurora/Logger/Logger.hpp"
 
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
 namespace Aurora
 {
 #if defined(_WIN32)
@@ -60,19 +69,32 @@ namespace Aurora
 
 				if (actionEnum != EFileAction::Renamed || action == FILE_ACTION_RENAMED_NEW_NAME)
 				{
-					task->m_Mutex.lock();
-					task->m_ThreadEvents.emplace(actionEnum, task->m_WatchingPath / tmp, prevPath);
-					task->m_Mutex.unlock();
+					task->QueueEvent(actionEnum, task->m_WatchingPath / tmp, prevPath);
 				}
 
 				info = info->NextEntryOffset == 0 ? nullptr : (FILE_NOTIFY_INFORMATION*)(((uint8_t*)info) + info->NextEntryOffset);
 			}
 		}
 	};
-	#endif
+#elif defined(__linux__)
+	// Modifications are reported once the writer closes the file, IN_MODIFY would queue an event for every write call
+	static constexpr uint32_t WatchMask = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+#endif
+
+	static bool IsSameOrSubPath(const Path::string_type& pathString, const Path::string_type& parentString)
+	{
+		if (pathString.size() < parentString.size() || pathString.compare(0, parentString.size(), parentString) != 0)
+			return false;
 
-	FileWatcher::FileWatcher(Path path) : m_WatchingPath(std::move(path))
+		return pathString.size() == parentString.size() || pathString[parentString.size()] == Path::preferred_separator;
+	}
+
+	FileWatcher::FileWatcher(Path path, uint32_t debounceMilliseconds) : m_WatchingPath(std::move(path)), m_Debounce(std::chrono::milliseconds(debounceMilliseconds))
 	{
+		// Everything there before watching started, later changes arrive as events
+		AddKnownPath(m_WatchingPath);
+
 #if defined(_WIN32)
 		m_handle = CreateFile(m_WatchingPath.string().c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
 		if (m_handle == INVALID_HANDLE_VALUE)
@@ -91,6 +113,19 @@ namespace Aurora
 				SleepEx(INFINITE, TRUE);
 			}
 		});
+#elif defined(__linux__)
+		m_NotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		m_WakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+		if (m_NotifyFD < 0 || m_WakeFD < 0)
+		{
+			AU_LOG_ERROR("Could not create file watcher for ", m_WatchingPath.string(), ": ", strerror(errno));
+			return;
+		}
+
+		// Watches are added before the thread starts, from then on only the thread touches them
+		WatchDirectory(m_WatchingPath);
+		m_Thread = std::thread(&FileWatcher::ThreadMain, this);
 #endif
 	}
 
@@ -100,20 +135,429 @@ namespace Aurora
 		CancelIoEx(m_handle, nullptr);
 		CloseHandle(m_handle);
 		m_Thread.join();
+#elif defined(__linux__)
+		if (m_Thread.joinable())
+		{
+			uint64_t wake = 1;
+			[[maybe_unused]] ssize_t written = write(m_WakeFD, &wake, sizeof(wake));
+			m_Thread.join();
+		}
+
+		if (m_NotifyFD >= 0)
+			close(m_NotifyFD);
+
+		if (m_WakeFD >= 0)
+			close(m_WakeFD);
 #endif
 	}
 
-	void FileWatcher::Update()
+	void FileWatcher::QueueEvent(EFileAction action, const Path& path, const Path& prevPath)
 	{
-#if defined(_WIN32)
 		std::lock_guard<std::mutex> lock(m_Mutex);
 
-		while(!m_ThreadEvents.empty())
+		// Listeners rescan everything after an overflow, later events do not matter until then
+		if (m_Overflowed)
+			return;
+
+		if (m_ThreadEvents.size() >= MaxQueuedEvents)
 		{
-			FileEvent e = m_ThreadEvents.front();
-			m_ThreadEvents.pop();
+			m_Overflowed = true;
+			m_ThreadEvents.clear();
+			return;
+		}
+
+		m_ThreadEvents.push_back({action, path, prevPath});
+	}
+
+	void FileWatcher::CoalesceEvent(FileEvent&& event)
+	{
+		// A rename continues the history of its old path
+		const Path& key = event.Action == EFileAction::Renamed ? event.PrevPath : event.FilePath;
+		auto it = m_PendingIndices.find(key.native());
+
+		if (it == m_PendingIndices.end())
+		{
+			m_PendingIndices[event.FilePath.native()] = m_PendingEvents.size();
+			m_PendingEvents.emplace_back(std::move(event));
+			return;
+		}
+
+		size_t pendingIndex = it->second;
+		FileEvent& pending = m_PendingEvents[pendingIndex];
+		bool merged = true;
+
+		switch (event.Action)
+		{
+			case EFileAction::Added:
+				// Saved by removing the file and writing it again
+				if (pending.Action == EFileAction::Removed)
+					pending.Action = EFileAction::Modified;
+				else
+					merged = false;
+				break;
+			case EFileAction::Modified:
+				merged = pending.Action == EFileAction::Added || pending.Action == EFileAction::Modified;
+				break;
+			case EFileAction::Removed:
+				if (pending.Action == EFileAction::Added)
+				{
+					// Temporary file, listeners never hear of it
+					pending.Action = EFileAction::Unknown;
+				}
+				else if (pending.Action == EFileAction::Modified)
+				{
+					pending.Action = EFileAction::Removed;
+				}
+				else if (pending.Action == EFileAction::Renamed)
+				{
+					pending.Action = EFileAction::Removed;
+					pending.FilePath = std::move(pending.PrevPath);
+					pending.PrevPath.clear();
+				}
+				else
+				{
+					merged = false;
+				}
+				break;
+			case EFileAction::Renamed:
+				// Written under a temporary name and moved in place, or renamed several times
+				if (pending.Action == EFileAction::Added || pending.Action == EFileAction::Renamed)
+				{
+					pending.FilePath = std::move(event.FilePath);
+
+					if (pending.Action == EFileAction::Renamed && pending.FilePath == pending.PrevPath)
+						pending.Action = EFileAction::Unknown;
+				}
+				else
+				{
+					merged = false;
+				}
+				break;
+			default:
+				merged = false;
+				break;
+		}
+
+		if (!merged)
+		{
+			m_PendingIndices[event.FilePath.native()] = m_PendingEvents.size();
+			m_PendingEvents.emplace_back(std::move(event));
+			return;
+		}
+
+		// The key may point to another path now
+		m_PendingIndices.erase(key.native());
+
+		if (pending.Action != EFileAction::Unknown)
+			m_PendingIndices[pending.FilePath.native()] = pendingIndex;
+	}
+
+	void FileWatcher::AddKnownPath(const Path& path)
+	{
+		std::error_code error;
+		bool isDirectory = std::filesystem::is_directory(path, error);
+		m_KnownPaths[path.native()] = isDirectory;
+
+		// A directory moved in is reported alone, nothing is reported for its content
+		if (!isDirectory)
+			return;
+
+		for (auto it = std::filesystem::recursive_directory_iterator(path, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+			m_KnownPaths[it->path().native()] = it->is_directory(error);
+	}
+
+	void FileWatcher::RemoveKnownPath(const Path& path, const Path& renamedTo)
+	{
+		auto it = m_KnownPaths.find(path.native());
+
+		if (it == m_KnownPaths.end())
+		{
+			if (!renamedTo.empty())
+				AddKnownPath(renamedTo);
+			return;
+		}
+
+		bool isDirectory = it->second;
+		m_KnownPaths.erase(it);
+
+		if (!renamedTo.empty())
+			m_KnownPaths[renamedTo.native()] = isDirectory;
+
+		if (!isDirectory)
+			return;
+
+		std::vector<std::pair<Path::string_type, bool>> children;
+		for (const auto& [knownPath, knownIsDirectory] : m_KnownPaths)
+		{
+			if (knownPath.size() > path.native().size() && IsSameOrSubPath(knownPath, path.native()))
+				children.emplace_back(knownPath, knownIsDirectory);
+		}
+
+		for (const auto& [childPath, childIsDirectory] : children)
+		{
+			m_KnownPaths.erase(childPath);
+
+			if (!renamedTo.empty())
+				m_KnownPaths[renamedTo.native() + childPath.substr(path.native().size())] = childIsDirectory;
+		}
+	}
+
+	void FileWatcher::FlushPendingEvents()
+	{
+		std::vector<FileEvent> events;
+		events.swap(m_PendingEvents);
+		m_PendingIndices.clear();
+
+		for (FileEvent& e : events)
+		{
+			switch (e.Action)
+			{
+				case EFileAction::Unknown:
+					continue;
+				case EFileAction::Added:
+					// Saved by moving a temporary file over it, or moved in over it
+					if (m_KnownPaths.contains(e.FilePath.native()))
+						e.Action = EFileAction::Modified;
+					else
+						AddKnownPath(e.FilePath);
+					break;
+				case EFileAction::Renamed:
+					if (m_KnownPaths.contains(e.FilePath.native()))
+					{
+						// Moved over a known file, the old name is gone and the file has new content
+						RemoveKnownPath(e.PrevPath);
+						m_EventListeners.Invoke(EFileAction::Removed, e.PrevPath, Path());
+
+						e.Action = EFileAction::Modified;
+						e.PrevPath.clear();
+					}
+					else
+					{
+						RemoveKnownPath(e.PrevPath, e.FilePath);
+					}
+					break;
+				case EFileAction::Removed:
+					RemoveKnownPath(e.FilePath);
+					break;
+				default:
+					break;
+			}
+
 			m_EventListeners.Invoke(std::forward<EFileAction>(e.Action), e.FilePath, e.PrevPath);
 		}
-#endif
+
+		// Keeps the capacity
+		events.clear();
+		m_PendingEvents.swap(events);
+	}
+
+	void FileWatcher::Update()
+	{
+		bool overflowed;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_ReceivedEvents.swap(m_ThreadEvents);
+			overflowed = m_Overflowed;
+			m_Overflowed = false;
+		}
+
+		if (overflowed)
+		{
+			m_ReceivedEvents.clear();
+			m_PendingEvents.clear();
+			m_PendingIndices.clear();
+
+			m_KnownPaths.clear();
+			AddKnownPath(m_WatchingPath);
+
+			m_EventListeners.Invoke(EFileAction::Overflow, m_WatchingPath, Path());
+			return;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+
+		if (!m_ReceivedEvents.empty())
+		{
+			if (m_PendingEvents.empty())
+				m_FirstPendingTime = now;
+
+			m_LastPendingTime = now;
+
+			for (FileEvent& e : m_ReceivedEvents)
+				CoalesceEvent(std::move(e));
+
+			m_ReceivedEvents.clear();
+		}
+
+		if (m_PendingEvents.empty())
+			return;
+
+		// Waits for a burst to end, files that are written all the time are still reported a few times per second
+		if (now - m_LastPendingTime >= m_Debounce || now - m_FirstPendingTime >= m_Debounce * 10)
+			FlushPendingEvents();
 	}
-}
\ No newline at end of file
+
+#if defined(__linux__)
+	void FileWatcher::WatchDirectory(const Path& path)
+	{
+		int watch = inotify_add_watch(m_NotifyFD, path.c_str(), WatchMask);
+
+		if (watch < 0)
+		{
+			AU_LOG_WARNING("Could not watch directory ", path.string(), ": ", strerror(errno));
+			return;
+		}
+
+		m_WatchPaths[watch] = path;
+
+		std::error_code error;
+		for (auto it = std::filesystem::directory_iterator(path, error); !error && it != std::filesystem::directory_iterator(); it.increment(error))
+		{
+			if (it->is_directory(error) && !it->is_symlink(error))
+				WatchDirectory(it->path());
+		}
+	}
+
+	void FileWatcher::UnwatchDirectory(const Path& path)
+	{
+		std::vector<int> watches;
+		for (const auto& [watch, watchPath] : m_WatchPaths)
+		{
+			if (IsSameOrSubPath(watchPath.native(), path.native()))
+				watches.push_back(watch);
+		}
+
+		for (int watch : watches)
+		{
+			inotify_rm_watch(m_NotifyFD, watch);
+			m_WatchPaths.erase(watch);
+		}
+	}
+
+	void FileWatcher::MoveWatchedDirectory(const Path& from, const Path& to)
+	{
+		size_t prefixLength = from.native().size();
+
+		for (auto& [watch, watchPath] : m_WatchPaths)
+		{
+			if (IsSameOrSubPath(watchPath.native(), from.native()))
+				watchPath = Path(to.native() + watchPath.native().substr(prefixLength));
+		}
+	}
+
+	void FileWatcher::ThreadMain()
+	{
+		struct MovedFrom
+		{
+			uint32_t Cookie = 0;
+			Path FilePath;
+			bool IsDirectory = false;
+			bool Valid = false;
+		} movedFrom;
+
+		// A move out of the watched directory has no IN_MOVED_TO, it is a removal
+		auto flushMovedFrom = [this, &movedFrom]()
+		{
+			if (!movedFrom.Valid)
+				return;
+
+			if (movedFrom.IsDirectory)
+				UnwatchDirectory(movedFrom.FilePath);
+
+			QueueEvent(EFileAction::Removed, movedFrom.FilePath);
+			movedFrom.Valid = false;
+		};
+
+		alignas(inotify_event) char buffer[16384];
+		pollfd fds[2] = {
+			{ m_NotifyFD, POLLIN, 0 },
+			{ m_WakeFD, POLLIN, 0 }
+		};
+
+		while (true)
+		{
+			if (poll(fds, 2, -1) < 0)
+			{
+				if (errno == EINTR)
+					continue;
+
+				AU_LOG_ERROR("File watcher poll failed: ", strerror(errno));
+				break;
+			}
+
+			if (fds[1].revents != 0)
+				break;
+
+			ssize_t length;
+			while ((length = read(m_NotifyFD, buffer, sizeof(buffer))) > 0)
+			{
+				for (char* position = buffer; position < buffer + length; position += sizeof(inotify_event) + reinterpret_cast<inotify_event*>(position)->len)
+				{
+					const auto* event = reinterpret_cast<const inotify_event*>(position);
+
+					if (event->mask & IN_Q_OVERFLOW)
+					{
+						std::lock_guard<std::mutex> lock(m_Mutex);
+						m_Overflowed = true;
+						m_ThreadEvents.clear();
+						continue;
+					}
+
+					// Sent when a watched directory is deleted or unwatched
+					if (event->mask & IN_IGNORED)
+					{
+						m_WatchPaths.erase(event->wd);
+						continue;
+					}
+
+					auto it = m_WatchPaths.find(event->wd);
+
+					if (it == m_WatchPaths.end() || event->len == 0)
+						continue;
+
+					Path path = it->second / event->name;
+					bool isDirectory = (event->mask & IN_ISDIR) != 0;
+
+					// Both halves of a rename are queued next to each other with the same cookie
+					if (event->mask & IN_MOVED_TO && movedFrom.Valid && movedFrom.Cookie == event->cookie)
+					{
+						if (isDirectory)
+							MoveWatchedDirectory(movedFrom.FilePath, path);
+
+						QueueEvent(EFileAction::Renamed, path, movedFrom.FilePath);
+						movedFrom.Valid = false;
+						continue;
+					}
+
+					flushMovedFrom();
+
+					if (event->mask & IN_MOVED_FROM)
+					{
+						movedFrom.Cookie = event->cookie;
+						movedFrom.FilePath = std::move(path);
+						movedFrom.IsDirectory = isDirectory;
+						movedFrom.Valid = true;
+					}
+					else if (event->mask & (IN_CREATE | IN_MOVED_TO))
+					{
+						if (isDirectory)
+							WatchDirectory(path);
+
+						QueueEvent(EFileAction::Added, path);
+					}
+					else if (event->mask & IN_DELETE)
+					{
+						QueueEvent(EFileAction::Removed, path);
+					}
+					else if (event->mask & IN_CLOSE_WRITE)
+					{
+						QueueEvent(EFileAction::Modified, path);
+					}
+				}
+			}
+
+			flushMovedFrom();
+		}
+	}
+#endif
+}
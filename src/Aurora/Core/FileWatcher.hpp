@@ -2,17 +2,15 @@
 
 #include "Types.hpp"
 #include "Delegate.hpp"
+#include "Aurora/Tools/robin_hood.h"
 
 #if defined(_WIN32)
 #include <Windows.h>
-#else
-#include <sys/inotify.h>
-#include <sys/select.h>
-// TODO: Complete file watcher for linux https://github.com/nem0/LumixEngine/blob/master/src/editor/linux/file_system_watcher.cpp
 #endif
 
+#include <chrono>
 #include <thread>
-#include <queue>
+#include <vector>
 #include <mutex>
 
 namespace Aurora
@@ -23,12 +21,19 @@ namespace Aurora
 		Added,
 		Renamed,
 		Modified,
-		Removed
+		Removed,
+		// Events were lost, everything under the path may have changed
+		Overflow
 	};
 
-	class FileWatcher
+	// Watches a directory recursively. Changes are queued by a background thread and coalesced in Update,
+	// listeners get one event per file once the directory was quiet for the debounce time.
+	class AU_API FileWatcher
 	{
 		friend class FileHandler;
+	public:
+		static constexpr uint32_t DefaultDebounceMilliseconds = 50;
+		static constexpr size_t MaxQueuedEvents = 8192;
 	private:
 		struct FileEvent
 		{
@@ -39,21 +44,53 @@ namespace Aurora
 
 		Path m_WatchingPath;
 		EventEmitter<EFileAction, const Path&, const Path&> m_EventListeners;
+		std::chrono::steady_clock::duration m_Debounce;
+
+		std::thread m_Thread;
+		mutable std::mutex m_Mutex;
+		std::vector<FileEvent> m_ThreadEvents;
+		bool m_Overflowed = false;
+
+		// Only touched by Update
+		std::vector<FileEvent> m_ReceivedEvents;
+		std::vector<FileEvent> m_PendingEvents;
+		robin_hood::unordered_map<Path::string_type, size_t> m_PendingIndices;
+		// Paths listeners were told about, true for directories. Adding one of them again is a modification.
+		robin_hood::unordered_map<Path::string_type, bool> m_KnownPaths;
+		std::chrono::steady_clock::time_point m_FirstPendingTime;
+		std::chrono::steady_clock::time_point m_LastPendingTime;
 #if defined(_WIN32)
 		uint8_t m_info[4096]{};
 		HANDLE m_handle = nullptr;
 		DWORD m_received = 0;
 		OVERLAPPED m_overlapped{};
-		std::thread m_Thread;
-		mutable std::mutex m_Mutex;
-		std::queue<FileEvent> m_ThreadEvents;
+#elif defined(__linux__)
+		int m_NotifyFD = -1;
+		int m_WakeFD = -1;
+		robin_hood::unordered_map<int, Path> m_WatchPaths;
 #endif
 	public:
-		explicit FileWatcher(Path path);
+		explicit FileWatcher(Path path, uint32_t debounceMilliseconds = DefaultDebounceMilliseconds);
 		~FileWatcher();
 
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator=(const FileWatcher&) = delete;
+
 		void Update();
 
 		EventEmitter<EFileAction, const Path&, const Path&>& GetEmitter() { return m_EventListeners; }
+	private:
+		void QueueEvent(EFileAction action, const Path& path, const Path& prevPath = {});
+		void CoalesceEvent(FileEvent&& event);
+		void FlushPendingEvents();
+		void AddKnownPath(const Path& path);
+		// Paths under a directory go with it
+		void RemoveKnownPath(const Path& path, const Path& renamedTo = {});
+#if defined(__linux__)
+		void WatchDirectory(const Path& path);
+		void UnwatchDirectory(const Path& path);
+		void MoveWatchedDirectory(const Path& from, const Path& to);
+		void ThreadMain();
+#endif
 	};
 }
\ No newline at end of file
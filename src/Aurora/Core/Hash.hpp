@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
+#include <span>
 
 namespace Aurora
 {
@@ -20,6 +22,32 @@ namespace Aurora
 		return hash;
 	}
 
+	// Same result on every platform, use this for hashes stored in files
+	constexpr uint64_t Hash_FNV1a64(std::string_view str)
+	{
+		uint64_t hash = 14695981039346656037ull;
+
+		for (char c : str)
+		{
+			hash ^= (uint8_t)c;
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	// Continues the hash of the previous data when given its result
+	constexpr uint64_t Hash_FNV1a64(std::span<const uint8_t> data, uint64_t hash = 14695981039346656037ull)
+	{
+		for (uint8_t byte : data)
+		{
+			hash ^= byte;
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
 	TTypeID constexpr operator "" _HASH(const char* s, std::size_t) {
 		return Hash_djb2(s);
 	}
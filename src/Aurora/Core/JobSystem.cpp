@@ -0,0 +1,363 @@
+#include "JobSystem.hpp"
+
+#include <memory>
+#include <common/TracySystem.hpp>
+
+#include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Logger/Logger.hpp"
+
+namespace Aurora
+{
+	static constexpr uint32_t JobPoolSize = 4096;
+
+	// Jobs are recycled from a per-thread ring, a slot that is still in flight falls back to the heap.
+	// Jobs must be finished before the thread that created them exits.
+	struct JobPool
+	{
+		Job Jobs[JobPoolSize];
+		uint32_t Index = 0;
+	};
+
+	static thread_local std::unique_ptr<JobPool> t_JobPool;
+	static thread_local const JobSystem* t_WorkerSystem = nullptr;
+	static thread_local int32_t t_WorkerIndex = -1;
+	static thread_local uint32_t t_StealSeed = 0;
+
+	JobCounter::~JobCounter()
+	{
+		// The job that completed the counter may still hold the lock while scheduling continuations
+		if (m_HasContinuations.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> lock(m_ContinuationMutex);
+		}
+	}
+
+	void JobCounter::Decrement()
+	{
+		// Counter may be destroyed right after the last decrement, so the fast path must not touch it afterwards
+		if (not m_HasContinuations.load(std::memory_order_seq_cst))
+		{
+			m_Pending.fetch_sub(1, std::memory_order_seq_cst);
+			return;
+		}
+
+		std::vector<Continuation> continuations;
+
+		{
+			std::lock_guard<std::mutex> lock(m_ContinuationMutex);
+
+			if (m_Pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				return;
+
+			continuations.swap(m_Continuations);
+		}
+
+		for (const Continuation& continuation : continuations)
+		{
+			continuation.System->Submit(continuation.PendingJob);
+		}
+	}
+
+	bool JobSystem::WorkDeque::Push(Job* job)
+	{
+		int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+		int64_t top = m_Top.load(std::memory_order_acquire);
+
+		if (bottom - top >= (int64_t)DequeCapacity)
+			return false;
+
+		m_Jobs[bottom & (DequeCapacity - 1)].store(job, std::memory_order_relaxed);
+		m_Bottom.store(bottom + 1, std::memory_order_release);
+		return true;
+	}
+
+	Job* JobSystem::WorkDeque::Pop()
+	{
+		int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+		m_Bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = m_Top.load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Job* job = m_Jobs[bottom & (DequeCapacity - 1)].load(std::memory_order_relaxed);
+
+		if (top == bottom)
+		{
+			// Last job, race against stealers
+			if (not m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				job = nullptr;
+			}
+
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		return job;
+	}
+
+	Job* JobSystem::WorkDeque::Steal()
+	{
+		int64_t top = m_Top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return nullptr;
+
+		Job* job = m_Jobs[top & (DequeCapacity - 1)].load(std::memory_order_relaxed);
+
+		if (not m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+
+		return job;
+	}
+
+	JobSystem::JobSystem(uint32_t workerCount, String name)
+		: m_Name(std::move(name)), m_QueuedJobs(0), m_SleepingWorkers(0), m_Shutdown(false)
+	{
+		m_Workers.reserve(workerCount);
+
+		for (uint32_t i = 0; i < workerCount; ++i)
+		{
+			m_Workers.push_back(new Worker());
+		}
+
+		// Start threads after all deques exist, workers steal from each other right away
+		for (uint32_t i = 0; i < workerCount; ++i)
+		{
+			m_Workers[i]->Thread = std::thread([this, i] { WorkerMain(i); });
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_WakeMutex);
+			m_Shutdown = true;
+		}
+
+		m_WakeCondition.notify_all();
+
+		// Join everything first, running workers still steal from the other deques
+		for (Worker* worker : m_Workers)
+		{
+			if (worker->Thread.joinable())
+			{
+				worker->Thread.join();
+			}
+		}
+
+		for (Worker* worker : m_Workers)
+		{
+			delete worker;
+		}
+
+		if (not m_GlobalQueue.empty())
+		{
+			AU_LOG_WARNING("JobSystem ", m_Name, " destroyed with ", m_GlobalQueue.size(), " unfinished jobs");
+		}
+	}
+
+	uint32_t JobSystem::GetDefaultWorkerCount()
+	{
+		uint32_t cores = std::thread::hardware_concurrency();
+		return cores > 1 ? cores - 1 : 1;
+	}
+
+	int32_t JobSystem::GetCurrentWorkerIndex() const
+	{
+		return t_WorkerSystem == this ? t_WorkerIndex : -1;
+	}
+
+	Job* JobSystem::AllocateJob()
+	{
+		if (not t_JobPool)
+		{
+			t_JobPool = std::make_unique<JobPool>();
+		}
+
+		Job& job = t_JobPool->Jobs[t_JobPool->Index++ & (JobPoolSize - 1)];
+
+		if (job.InUse.load(std::memory_order_acquire))
+		{
+			Job* heapJob = new Job();
+			heapJob->HeapAllocated = true;
+			return heapJob;
+		}
+
+		job.InUse.store(true, std::memory_order_relaxed);
+		return &job;
+	}
+
+	void JobSystem::FreeJob(Job* job)
+	{
+		if (job->HeapAllocated)
+		{
+			delete job;
+			return;
+		}
+
+		job->InUse.store(false, std::memory_order_release);
+	}
+
+	void JobSystem::Submit(Job* job)
+	{
+		int32_t workerIndex = GetCurrentWorkerIndex();
+
+		// Counted before the push, so the job can never be taken before it is counted
+		m_QueuedJobs.fetch_add(1, std::memory_order_seq_cst);
+
+		if (workerIndex < 0 || not m_Workers[workerIndex]->Deque.Push(job))
+		{
+			std::lock_guard<std::mutex> lock(m_GlobalQueueMutex);
+			m_GlobalQueue.push_back(job);
+		}
+
+		WakeWorkers(1);
+	}
+
+	void JobSystem::WakeWorkers(uint32_t count)
+	{
+		if (m_SleepingWorkers.load(std::memory_order_seq_cst) == 0)
+			return;
+
+		// Taking the lock makes sure a worker going to sleep either sees the new job or gets the notification
+		{
+			std::lock_guard<std::mutex> lock(m_WakeMutex);
+		}
+
+		if (count == 1)
+		{
+			m_WakeCondition.notify_one();
+		}
+		else
+		{
+			m_WakeCondition.notify_all();
+		}
+	}
+
+	Job* JobSystem::FindJob(int32_t workerIndex)
+	{
+		Job* job = nullptr;
+
+		if (workerIndex >= 0)
+		{
+			job = m_Workers[workerIndex]->Deque.Pop();
+		}
+
+		if (not job && m_QueuedJobs.load(std::memory_order_relaxed) > 0)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_GlobalQueueMutex);
+
+				if (not m_GlobalQueue.empty())
+				{
+					job = m_GlobalQueue.front();
+					m_GlobalQueue.pop_front();
+				}
+			}
+
+			if (not job && not m_Workers.empty())
+			{
+				// Xorshift, just to spread the victims
+				uint32_t seed = t_StealSeed ? t_StealSeed : (uint32_t)(workerIndex + 2) * 2654435761u;
+				seed ^= seed << 13;
+				seed ^= seed >> 17;
+				seed ^= seed << 5;
+				t_StealSeed = seed;
+
+				uint32_t workerCount = GetWorkerCount();
+				uint32_t start = seed % workerCount;
+
+				for (uint32_t i = 0; i < workerCount && not job; ++i)
+				{
+					uint32_t victim = (start + i) % workerCount;
+
+					if ((int32_t)victim == workerIndex)
+						continue;
+
+					job = m_Workers[victim]->Deque.Steal();
+				}
+			}
+		}
+
+		if (job)
+		{
+			m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		return job;
+	}
+
+	void JobSystem::Execute(Job* job)
+	{
+		JobCounter* counter = job->Counter;
+
+		job->Invoke(job);
+		FreeJob(job);
+
+		if (counter)
+		{
+			counter->Decrement();
+		}
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		int32_t workerIndex = GetCurrentWorkerIndex();
+
+		while (not counter.IsDone())
+		{
+			if (Job* job = FindJob(workerIndex))
+			{
+				Execute(job);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::WorkerMain(uint32_t workerIndex)
+	{
+		String threadName = m_Name + " " + std::to_string(workerIndex);
+		tracy::SetThreadName(threadName.c_str());
+		Profiler::SetThreadName(threadName);
+
+		t_WorkerSystem = this;
+		t_WorkerIndex = (int32_t)workerIndex;
+
+		uint32_t spinCount = 0;
+
+		while (not m_Shutdown.load(std::memory_order_relaxed))
+		{
+			if (Job* job = FindJob((int32_t)workerIndex))
+			{
+				Execute(job);
+				spinCount = 0;
+				continue;
+			}
+
+			if (++spinCount < SpinCountBeforeSleep)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+			m_SleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+			m_WakeCondition.wait(lock, [this]() { return m_QueuedJobs.load(std::memory_order_seq_cst) > 0 || m_Shutdown.load(std::memory_order_relaxed); });
+			m_SleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+			spinCount = 0;
+		}
+
+		t_WorkerSystem = nullptr;
+		t_WorkerIndex = -1;
+	}
+}
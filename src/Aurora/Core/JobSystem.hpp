@@ -0,0 +1,248 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#include "Library.hpp"
+#include "Types.hpp"
+#include "String.hpp"
+
+namespace Aurora
+{
+	class JobSystem;
+
+	struct Job
+	{
+		static constexpr size_t StorageSize = 48;
+
+		using InvokeFunc = void(*)(Job*);
+
+		InvokeFunc Invoke = nullptr;
+		class JobCounter* Counter = nullptr;
+		std::atomic<bool> InUse = false;
+		bool HeapAllocated = false;
+		alignas(16) uint8_t Storage[StorageSize];
+	};
+
+	// Counts unfinished jobs. Jobs scheduled with ScheduleAfter run once the counter drops to zero.
+	// The counter must outlive all jobs that signal it, JobSystem::Wait guarantees that.
+	class AU_API JobCounter
+	{
+		friend class JobSystem;
+	private:
+		struct Continuation
+		{
+			JobSystem* System;
+			Job* PendingJob;
+		};
+
+		std::atomic<uint32_t> m_Pending;
+		std::atomic<bool> m_HasContinuations;
+		std::mutex m_ContinuationMutex;
+		std::vector<Continuation> m_Continuations;
+	public:
+		JobCounter() : m_Pending(0), m_HasContinuations(false) {}
+		~JobCounter();
+
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		[[nodiscard]] bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+		[[nodiscard]] uint32_t GetPendingCount() const { return m_Pending.load(std::memory_order_relaxed); }
+	private:
+		void Increment(uint32_t count = 1) { m_Pending.fetch_add(count, std::memory_order_relaxed); }
+		void Decrement();
+	};
+
+	// Work-stealing job scheduler with a fixed pool of worker threads.
+	// Every worker owns a lock-free deque, jobs spawned from a worker go to its deque and idle workers
+	// steal from the others. Jobs from other threads go to a shared queue. Threads waiting for a counter
+	// execute jobs instead of blocking, so jobs can wait for other jobs without deadlocking the pool.
+	class AU_API JobSystem
+	{
+		friend class JobCounter;
+	public:
+		static constexpr uint32_t DequeCapacity = 4096;
+		static constexpr uint32_t SpinCountBeforeSleep = 64;
+	private:
+		// Chase-Lev deque, only the owner pushes and pops, any thread can steal
+		class WorkDeque
+		{
+		private:
+			alignas(64) std::atomic<int64_t> m_Top;
+			alignas(64) std::atomic<int64_t> m_Bottom;
+			std::atomic<Job*> m_Jobs[DequeCapacity];
+		public:
+			WorkDeque() : m_Top(0), m_Bottom(0), m_Jobs() {}
+
+			bool Push(Job* job);
+			Job* Pop();
+			Job* Steal();
+		};
+
+		struct Worker
+		{
+			WorkDeque Deque;
+			std::thread Thread;
+		};
+
+		String m_Name;
+		std::vector<Worker*> m_Workers;
+
+		std::mutex m_GlobalQueueMutex;
+		std::deque<Job*> m_GlobalQueue;
+
+		std::atomic<uint32_t> m_QueuedJobs;
+		std::atomic<uint32_t> m_SleepingWorkers;
+		std::atomic<bool> m_Shutdown;
+		std::mutex m_WakeMutex;
+		std::condition_variable m_WakeCondition;
+	public:
+		// Worker count of zero is valid, all jobs are then executed by the waiting threads
+		explicit JobSystem(uint32_t workerCount = GetDefaultWorkerCount(), String name = "Worker");
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		// One worker per core, the main thread takes the remaining one
+		static uint32_t GetDefaultWorkerCount();
+
+		[[nodiscard]] uint32_t GetWorkerCount() const { return (uint32_t)m_Workers.size(); }
+		// Returns -1 when called from a thread that is not a worker of this job system
+		[[nodiscard]] int32_t GetCurrentWorkerIndex() const;
+
+		template<typename Func>
+		void Schedule(Func&& func, JobCounter* counter = nullptr)
+		{
+			Submit(CreateJob(std::forward<Func>(func), counter));
+		}
+
+		// Job is scheduled when the dependency counter reaches zero, or immediately if it is zero already
+		template<typename Func>
+		void ScheduleAfter(JobCounter& dependency, Func&& func, JobCounter* counter = nullptr)
+		{
+			Job* job = CreateJob(std::forward<Func>(func), counter);
+
+			// The flag must be visible before the guard, the guard keeps the dependency from completing while the continuation is registered
+			dependency.m_HasContinuations.store(true, std::memory_order_seq_cst);
+			dependency.m_Pending.fetch_add(1, std::memory_order_seq_cst);
+			{
+				std::lock_guard<std::mutex> lock(dependency.m_ContinuationMutex);
+				dependency.m_Continuations.push_back({this, job});
+			}
+			dependency.Decrement();
+		}
+
+		// Executes other jobs until the counter reaches zero
+		void Wait(JobCounter& counter);
+
+		// Calls func(begin, end) for sub-ranges of [0, count) with at most batchSize elements, returns when all are done.
+		// The range is split recursively, so idle workers steal large halves instead of single batches.
+		template<typename Func>
+		void ParallelFor(uint32_t count, uint32_t batchSize, Func&& func)
+		{
+			if (count == 0)
+				return;
+
+			if (batchSize == 0)
+				batchSize = 1;
+
+			if (count <= batchSize)
+			{
+				func(0u, count);
+				return;
+			}
+
+			JobCounter counter;
+			ParallelForContext<std::remove_reference_t<Func>> context = { this, &counter, &func, batchSize };
+			RunParallelForRange(context, 0, count);
+			Wait(counter);
+		}
+	private:
+		template<typename Func>
+		struct ParallelForContext
+		{
+			JobSystem* System;
+			JobCounter* Counter;
+			Func* Function;
+			uint32_t BatchSize;
+		};
+
+		template<typename Func>
+		static void RunParallelForRange(const ParallelForContext<Func>& context, uint32_t begin, uint32_t end)
+		{
+			while (end - begin > context.BatchSize)
+			{
+				uint32_t batches = (end - begin + context.BatchSize - 1) / context.BatchSize;
+				uint32_t mid = begin + (batches / 2) * context.BatchSize;
+
+				const ParallelForContext<Func>* contextPtr = &context;
+				context.System->Schedule([contextPtr, mid, end]() { RunParallelForRange(*contextPtr, mid, end); }, context.Counter);
+
+				end = mid;
+			}
+
+			(*context.Function)(begin, end);
+		}
+
+		template<typename Func>
+		static void InvokeInline(Job* job)
+		{
+			Func* func = std::launder(reinterpret_cast<Func*>(job->Storage));
+			(*func)();
+			func->~Func();
+		}
+
+		template<typename Func>
+		static void InvokeHeap(Job* job)
+		{
+			Func* func = *reinterpret_cast<Func**>(job->Storage);
+			(*func)();
+			delete func;
+		}
+
+		template<typename Func>
+		Job* CreateJob(Func&& func, JobCounter* counter)
+		{
+			using FuncType = std::decay_t<Func>;
+
+			Job* job = AllocateJob();
+			job->Counter = counter;
+
+			if constexpr (sizeof(FuncType) <= Job::StorageSize && alignof(FuncType) <= 16)
+			{
+				new(job->Storage) FuncType(std::forward<Func>(func));
+				job->Invoke = &InvokeInline<FuncType>;
+			}
+			else
+			{
+				*reinterpret_cast<FuncType**>(job->Storage) = new FuncType(std::forward<Func>(func));
+				job->Invoke = &InvokeHeap<FuncType>;
+			}
+
+			if (counter)
+			{
+				counter->Increment();
+			}
+
+			return job;
+		}
+
+		static Job* AllocateJob();
+		static void FreeJob(Job* job);
+
+		void Submit(Job* job);
+		Job* FindJob(int32_t workerIndex);
+		void Execute(Job* job);
+		void WakeWorkers(uint32_t count);
+		void WorkerMain(uint32_t workerIndex);
+	};
+}
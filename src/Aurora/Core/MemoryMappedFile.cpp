@@ -0,0 +1,115 @@
+#include "MemoryMappedFile.hpp"
+
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+namespace Aurora
+{
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		Close();
+	}
+
+#ifdef _WIN32
+	bool MemoryMappedFile::Open(const Path& path)
+	{
+		Close();
+
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (mapping == nullptr)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+		if (data == nullptr)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_FileHandle = file;
+		m_MappingHandle = mapping;
+		m_Data = static_cast<const uint8_t*>(data);
+		m_Size = (size_t)fileSize.QuadPart;
+		return true;
+	}
+
+	void MemoryMappedFile::Close()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+
+		if (m_MappingHandle)
+			CloseHandle(m_MappingHandle);
+
+		if (m_FileHandle)
+			CloseHandle(m_FileHandle);
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_FileHandle = nullptr;
+		m_MappingHandle = nullptr;
+	}
+#else
+	bool MemoryMappedFile::Open(const Path& path)
+	{
+		Close();
+
+		int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+		if (file < 0)
+			return false;
+
+		struct stat fileStat = {};
+		if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			close(file);
+			return false;
+		}
+
+		void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+		// The mapping keeps its own reference to the file
+		close(file);
+
+		if (data == MAP_FAILED)
+			return false;
+
+		m_Data = static_cast<const uint8_t*>(data);
+		m_Size = (size_t)fileStat.st_size;
+		return true;
+	}
+
+	void MemoryMappedFile::Close()
+	{
+		if (m_Data)
+			munmap(const_cast<uint8_t*>(m_Data), m_Size);
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+#endif
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <span>
+#include "Types.hpp"
+
+namespace Aurora
+{
+	// Read-only view of a whole file mapped into memory, pages are loaded by the OS on first access
+	class AU_API MemoryMappedFile
+	{
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+#ifdef _WIN32
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+#endif
+	public:
+		MemoryMappedFile() = default;
+		~MemoryMappedFile();
+
+		MemoryMappedFile(const MemoryMappedFile&) = delete;
+		MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+		bool Open(const Path& path);
+		void Close();
+
+		[[nodiscard]] bool IsOpen() const { return m_Data != nullptr; }
+		[[nodiscard]] const uint8_t* GetData() const { return m_Data; }
+		[[nodiscard]] size_t GetSize() const { return m_Size; }
+
+		// Empty span when the range is not inside of the file
+		[[nodiscard]] std::span<const uint8_t> GetSpan(uint64_t offset, uint64_t size) const
+		{
+			if (offset > m_Size || size > m_Size - offset)
+				return {};
+
+			return {m_Data + offset, (size_t)size};
+		}
+	};
+}
@@ -1,7 +1,307 @@
 #include "Profiler.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define AU_PROFILER_TSC 1
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+#else
+	#define AU_PROFILER_TSC 0
+#endif
+
 namespace Aurora
 {
-	std::stack<LocalProfileScope::LocalTiming> LocalProfileScope::m_TimingStack;
-	LocalProfileScope::LocalTiming LocalProfileScope::m_LastFrameTiming = {"_Uninitialized"};
-}
\ No newline at end of file
+	static_assert((Profiler::EventsPerThread & (Profiler::EventsPerThread - 1)) == 0, "EventsPerThread must be a power of two");
+
+	std::atomic<bool> Profiler::m_Enabled = true;
+
+	// Cycle counter where there is one, it is several times cheaper to read than the steady clock
+	static inline uint64_t ReadTicks()
+	{
+#if AU_PROFILER_TSC
+		return __rdtsc();
+#else
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	static inline int64_t ReadNanoseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// Slot of a ring. CollectEvents copies slots while the owner may overwrite them, the fields are relaxed
+	// atomics so that copy is not a data race, they compile to plain loads and stores.
+	struct RingEvent
+	{
+		std::atomic<const char*> Name;
+		std::atomic<uint64_t> Time;
+		std::atomic<int64_t> Value;
+		std::atomic<EProfileEvent> Type;
+	};
+
+	struct ThreadTimeline
+	{
+		std::unique_ptr<RingEvent[]> Events;
+		// Count of published events, only the owning thread writes it
+		std::atomic<uint64_t> Head;
+		uint32_t Index;
+		std::string Name;
+
+		explicit ThreadTimeline(uint32_t index) : Events(new RingEvent[Profiler::EventsPerThread]), Head(0), Index(index), Name("Thread " + std::to_string(index)) {}
+	};
+
+	struct ProfilerRegistry
+	{
+		std::mutex Mutex;
+		// Timelines outlive their threads, so the events of a finished job thread can still be exported
+		std::vector<std::unique_ptr<ThreadTimeline>> Timelines;
+		std::atomic<uint64_t> FrameIndex;
+		const uint64_t StartTicks;
+		const int64_t StartNanoseconds;
+
+		ProfilerRegistry() : FrameIndex(0), StartTicks(ReadTicks()), StartNanoseconds(ReadNanoseconds()) {}
+	};
+
+	// Never destroyed, threads may record while static objects are destroyed
+	static ProfilerRegistry& GetRegistry()
+	{
+		static ProfilerRegistry* registry = new ProfilerRegistry();
+		return *registry;
+	}
+
+	static thread_local ThreadTimeline* t_Timeline = nullptr;
+
+	static ThreadTimeline* CreateThreadTimeline()
+	{
+		ProfilerRegistry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.Mutex);
+
+		registry.Timelines.push_back(std::make_unique<ThreadTimeline>((uint32_t)registry.Timelines.size()));
+		t_Timeline = registry.Timelines.back().get();
+		return t_Timeline;
+	}
+
+	static inline void Record(EProfileEvent type, const char* name, int64_t value)
+	{
+		ThreadTimeline* timeline = t_Timeline;
+
+		if (!timeline)
+			timeline = CreateThreadTimeline();
+
+		uint64_t head = timeline->Head.load(std::memory_order_relaxed);
+
+		// Works like a seqlock with the head as sequence: a reader that sees any field of this write also sees
+		// every earlier head, so it knows the slot was overwritten. Free on x86, only keeps the compiler in order.
+		std::atomic_thread_fence(std::memory_order_release);
+
+		RingEvent& event = timeline->Events[head & (Profiler::EventsPerThread - 1)];
+		event.Name.store(name, std::memory_order_relaxed);
+		event.Time.store(ReadTicks(), std::memory_order_relaxed);
+		event.Value.store(value, std::memory_order_relaxed);
+		event.Type.store(type, std::memory_order_relaxed);
+
+		timeline->Head.store(head + 1, std::memory_order_release);
+	}
+
+	void Profiler::BeginScope(const char* name)
+	{
+		Record(EProfileEvent::Begin, name, 0);
+	}
+
+	void Profiler::EndScope(const char* name)
+	{
+		Record(EProfileEvent::End, name, 0);
+	}
+
+	void Profiler::SetCounter(const char* name, int64_t value)
+	{
+		if (IsEnabled())
+			Record(EProfileEvent::Counter, name, value);
+	}
+
+	void Profiler::BeginFrame()
+	{
+		uint64_t frameIndex = GetRegistry().FrameIndex.fetch_add(1, std::memory_order_relaxed);
+
+		if (IsEnabled())
+			Record(EProfileEvent::Frame, "Frame", (int64_t)frameIndex);
+	}
+
+	uint64_t Profiler::GetFrameIndex()
+	{
+		return GetRegistry().FrameIndex.load(std::memory_order_relaxed);
+	}
+
+	void Profiler::SetThreadName(const std::string& name)
+	{
+		ThreadTimeline* timeline = t_Timeline ? t_Timeline : CreateThreadTimeline();
+
+		std::lock_guard<std::mutex> lock(GetRegistry().Mutex);
+		timeline->Name = name;
+	}
+
+	void Profiler::CollectEvents(std::vector<std::pair<uint32_t, ProfileEvent>>& events)
+	{
+		ProfilerRegistry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.Mutex);
+
+		// Ticks to nanoseconds, measured over the whole run
+		double nanosecondsPerTick = 1.0;
+#if AU_PROFILER_TSC
+		uint64_t elapsedTicks = ReadTicks() - registry.StartTicks;
+		int64_t elapsedNanoseconds = ReadNanoseconds() - registry.StartNanoseconds;
+
+		if (elapsedTicks > 0 && elapsedNanoseconds > 0)
+			nanosecondsPerTick = (double)elapsedNanoseconds / (double)elapsedTicks;
+#endif
+
+		for (const std::unique_ptr<ThreadTimeline>& timeline : registry.Timelines)
+		{
+			uint64_t head = timeline->Head.load(std::memory_order_acquire);
+			uint64_t first = head > EventsPerThread ? head - EventsPerThread : 0;
+			size_t offset = events.size();
+
+			// Only the slots published before the acquire of the head are copied
+			for (uint64_t i = first; i < head; ++i)
+			{
+				const RingEvent& slot = timeline->Events[i & (EventsPerThread - 1)];
+
+				ProfileEvent event;
+				event.Name = slot.Name.load(std::memory_order_relaxed);
+				event.Time = (uint64_t)((double)(int64_t)(slot.Time.load(std::memory_order_relaxed) - registry.StartTicks) * nanosecondsPerTick);
+				event.Value = slot.Value.load(std::memory_order_relaxed);
+				event.Type = slot.Type.load(std::memory_order_relaxed);
+				events.emplace_back(timeline->Index, event);
+			}
+
+			// The owner kept recording while the ring was copied, the oldest events may have been overwritten.
+			// Pairs with the fence in Record, the head read after it covers every write seen by the copy.
+			std::atomic_thread_fence(std::memory_order_acquire);
+			uint64_t newHead = timeline->Head.load(std::memory_order_relaxed);
+			uint64_t firstValid = newHead >= EventsPerThread ? newHead - EventsPerThread + 1 : 0;
+
+			if (firstValid > first)
+			{
+				size_t overwritten = (size_t)std::min<uint64_t>(firstValid - first, head - first);
+				events.erase(events.begin() + (std::ptrdiff_t)offset, events.begin() + (std::ptrdiff_t)(offset + overwritten));
+			}
+		}
+	}
+
+	static void WriteJsonString(std::ostream& stream, const char* text)
+	{
+		stream << '"';
+
+		for (const char* c = text; *c; ++c)
+		{
+			switch (*c)
+			{
+				case '"': stream << "\\\""; break;
+				case '\\': stream << "\\\\"; break;
+				case '\n': stream << "\\n"; break;
+				case '\t': stream << "\\t"; break;
+				default:
+					if ((unsigned char)*c < 0x20)
+						stream << ' ';
+					else
+						stream << *c;
+			}
+		}
+
+		stream << '"';
+	}
+
+	bool Profiler::ExportChromeTrace(const Path& path)
+	{
+		std::vector<std::pair<uint32_t, ProfileEvent>> events;
+		CollectEvents(events);
+
+		std::vector<std::pair<uint32_t, std::string>> threadNames;
+		{
+			ProfilerRegistry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.Mutex);
+
+			for (const std::unique_ptr<ThreadTimeline>& timeline : registry.Timelines)
+				threadNames.emplace_back(timeline->Index, timeline->Name);
+		}
+
+		std::ofstream stream(path, std::ios::out | std::ios::binary);
+
+		if (!stream.is_open())
+		{
+			AU_LOG_ERROR("Could not write profile trace ", path.string());
+			return false;
+		}
+
+		uint64_t startTime = UINT64_MAX;
+		for (const auto& [thread, event] : events)
+			startTime = std::min(startTime, event.Time);
+
+		stream << std::fixed << std::setprecision(3);
+		stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+		bool first = true;
+		auto beginEvent = [&stream, &first]()
+		{
+			stream << (first ? "\n" : ",\n");
+			first = false;
+		};
+
+		for (const auto& [thread, name] : threadNames)
+		{
+			beginEvent();
+			stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":";
+			WriteJsonString(stream, name.c_str());
+			stream << "}}";
+		}
+
+		// The ring may start in the middle of a scope, its end is dropped
+		std::vector<uint32_t> depths(threadNames.size(), 0);
+
+		for (const auto& [thread, event] : events)
+		{
+			double timestamp = (double)(event.Time - startTime) / 1000.0;
+
+			switch (event.Type)
+			{
+				case EProfileEvent::Begin:
+					depths[thread]++;
+					beginEvent();
+					stream << "{\"name\":";
+					WriteJsonString(stream, event.Name);
+					stream << ",\"ph\":\"B\",\"ts\":" << timestamp << ",\"pid\":1,\"tid\":" << thread << "}";
+					break;
+				case EProfileEvent::End:
+					if (depths[thread] == 0)
+						break;
+
+					depths[thread]--;
+					beginEvent();
+					stream << "{\"ph\":\"E\",\"ts\":" << timestamp << ",\"pid\":1,\"tid\":" << thread << "}";
+					break;
+				case EProfileEvent::Counter:
+					beginEvent();
+					stream << "{\"name\":";
+					WriteJsonString(stream, event.Name);
+					stream << ",\"ph\":\"C\",\"ts\":" << timestamp << ",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"value\":" << event.Value << "}}";
+					break;
+				case EProfileEvent::Frame:
+					beginEvent();
+					stream << "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":" << timestamp << ",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"index\":" << event.Value << "}}";
+					break;
+			}
+		}
+
+		stream << "\n]}\n";
+		return stream.good();
+	}
+}
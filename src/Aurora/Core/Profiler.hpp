@@ -1,9 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <string>
+#include <utility>
 #include <vector>
-#include <stack>
 #include "Aurora/Core/Types.hpp"
 #include "Aurora/Graphics/OpenGL/GL.hpp"
 #include "../Logger/Logger.hpp"
@@ -15,91 +16,79 @@
 #define CATT(a, b) CAT(a, b)
 
 #if defined(AURORA_OPENGL) && AU_GPU_PROFILE == 1
-#include "Aurora/Graphics/OpenGL/GLRenderGroupScope.hpp"
-#define GPU_DEBUG_SCOPE(name) ::Aurora::GLRenderGroupScope CATT(_GPU_Debug_Scope_, __LINE__)(name)
+#include "Aurora/Graphics/RenderGroupScope.hpp"
+#define GPU_DEBUG_SCOPE(name) ::Aurora::RenderGroupScope CATT(_GPU_Debug_Scope_, __LINE__)(name)
 #else
 #define GPU_DEBUG_SCOPE(name)
 #endif
 
 namespace Aurora
 {
-	class AU_API LocalProfileScope
+	enum class EProfileEvent : uint32_t
+	{
+		Begin = 0,
+		End,
+		Counter,
+		Frame
+	};
+
+	// Names are string literals, events only keep the pointer
+	struct ProfileEvent
+	{
+		const char* Name;
+		uint64_t Time;
+		int64_t Value;
+		EProfileEvent Type;
+	};
+
+	// Scopes, counters and frame boundaries go to a ring of the calling thread, recording never locks or allocates
+	// once the thread recorded its first event. The rings keep the last EventsPerThread events of every thread.
+	class AU_API Profiler
 	{
 	public:
-		struct LocalTiming
-		{
-			std::string Name;
-			std::chrono::high_resolution_clock::time_point StartTime;
-			std::chrono::high_resolution_clock::time_point EndTime;
-			std::vector<LocalTiming> Childs;
-			bool IsRoot;
-
-			[[nodiscard]] inline int64_t GetElapsedTimeInNanoSeconds() const
-			{
-				return (EndTime - StartTime).count();
-			}
-
-			[[nodiscard]] inline double GetElapsedTimeInMicroseconds() const
-			{
-				return static_cast<double>(GetElapsedTimeInNanoSeconds()) / 1000.0;
-			}
-
-			[[nodiscard]] inline double GetElapsedTimeInMilliseconds() const
-			{
-				return static_cast<double>(GetElapsedTimeInMicroseconds()) / 1000.0;
-			}
-
-			[[nodiscard]] inline double GetElapsedTimeInSeconds() const
-			{
-				return GetElapsedTimeInMilliseconds() / 1000.0;
-			}
-		};
+		static constexpr uint32_t EventsPerThread = 16384;
 	private:
-		static std::stack<LocalTiming> m_TimingStack;
-		static LocalTiming m_LastFrameTiming;
+		static std::atomic<bool> m_Enabled;
 	public:
-		explicit LocalProfileScope(const std::string& name)
-		{
-			LocalTiming timing = {};
-			timing.Name = name;
-			timing.StartTime = std::chrono::high_resolution_clock::now();
-			timing.IsRoot = false;
-			m_TimingStack.emplace(timing);
-		}
+		[[nodiscard]] static bool IsEnabled() { return m_Enabled.load(std::memory_order_relaxed); }
+		static void SetEnabled(bool enabled) { m_Enabled.store(enabled, std::memory_order_relaxed); }
+
+		static void BeginScope(const char* name);
+		static void EndScope(const char* name);
+		static void SetCounter(const char* name, int64_t value);
+		// Marks the start of a frame on the calling thread
+		static void BeginFrame();
+		[[nodiscard]] static uint64_t GetFrameIndex();
+
+		// Shown in the trace instead of the thread index, name is copied
+		static void SetThreadName(const std::string& name);
+
+		// Copies the events still in the rings, converted to nanoseconds. Safe while other threads record,
+		// events they overwrite during the copy are dropped.
+		static void CollectEvents(std::vector<std::pair<uint32_t, ProfileEvent>>& events);
+		// Trace Event Format read by chrome://tracing and Perfetto
+		static bool ExportChromeTrace(const Path& path);
+	};
 
-		~LocalProfileScope()
+	class ProfileScope
+	{
+	private:
+		const char* m_Name;
+	public:
+		explicit ProfileScope(const char* name) : m_Name(Profiler::IsEnabled() ? name : nullptr)
 		{
-			auto now = std::chrono::high_resolution_clock::now();
-			LocalTiming timing = m_TimingStack.top();
-			timing.EndTime = now;
-			m_TimingStack.pop();
-
-			LocalTiming& parentTiming = m_TimingStack.top();
-			parentTiming.Childs.emplace_back(timing);
+			if (m_Name)
+				Profiler::BeginScope(m_Name);
 		}
 
-		static void Reset(const std::string& rootName)
+		~ProfileScope()
 		{
-			if(m_TimingStack.size() != 1)
-			{
-				AU_LOG_WARNING("Profiler timing stack is at reset is not 1");
-				while(!m_TimingStack.empty()) m_TimingStack.pop();
-			}
-			else
-			{
-				m_LastFrameTiming = m_TimingStack.top();
-				m_LastFrameTiming.EndTime = std::chrono::high_resolution_clock::now();
-				m_TimingStack.pop();
-			}
-
-			LocalTiming rootTiming = {};
-			rootTiming.Name = rootName;
-			rootTiming.IsRoot = true;
-			rootTiming.StartTime = std::chrono::high_resolution_clock::now();
-			m_TimingStack.emplace(rootTiming);
+			if (m_Name)
+				Profiler::EndScope(m_Name);
 		}
 
-		static const LocalTiming& GetLastFrameTimings() { return m_LastFrameTiming; }
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
 	};
 
 	class DebugScopeTime
@@ -123,7 +112,7 @@ namespace Aurora
 	};
 }
 
-#define AU_CPU_DEBUG_SCOPE(name) ::Aurora::LocalProfileScope CATT(AU_GPU_Debug_Scope_, __LINE__)(name)
+#define AU_CPU_DEBUG_SCOPE(name) ::Aurora::ProfileScope CATT(AU_CPU_Debug_Scope_, __LINE__)(name)
 #define AU_SCOPE_TIME(name) ::Aurora::DebugScopeTime CATT(AU_GPU_Debug_Scope_, __LINE__)(name)
 
 #if AU_TRACY_ENABLED
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace Aurora
+{
+	// Stable LSD radix sort of 64-bit keys carrying 32-bit values, 8 bits per pass.
+	// All histograms are built in a single read and passes where every key has the same digit are skipped,
+	// so keys with constant high bits (pass, sort type) cost nothing extra. Temp arrays must hold count elements.
+	// Sorted data ends up in keys and values.
+	inline void RadixSort(uint64_t* keys, uint32_t* values, uint64_t* tempKeys, uint32_t* tempValues, size_t count)
+	{
+		if (count < 2)
+			return;
+
+		// Insertion sort is faster for tiny inputs than clearing the histograms
+		if (count <= 32)
+		{
+			for (size_t i = 1; i < count; ++i)
+			{
+				uint64_t key = keys[i];
+				uint32_t value = values[i];
+				size_t j = i;
+
+				for (; j > 0 && keys[j - 1] > key; --j)
+				{
+					keys[j] = keys[j - 1];
+					values[j] = values[j - 1];
+				}
+
+				keys[j] = key;
+				values[j] = value;
+			}
+
+			return;
+		}
+
+		constexpr int PassCount = 8;
+		uint32_t histograms[PassCount][256];
+		std::memset(histograms, 0, sizeof(histograms));
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			uint64_t key = keys[i];
+
+			for (int pass = 0; pass < PassCount; ++pass)
+			{
+				histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+			}
+		}
+
+		uint64_t* sourceKeys = keys;
+		uint32_t* sourceValues = values;
+		uint64_t* destKeys = tempKeys;
+		uint32_t* destValues = tempValues;
+
+		for (int pass = 0; pass < PassCount; ++pass)
+		{
+			uint32_t* histogram = histograms[pass];
+			int shift = pass * 8;
+
+			if (histogram[(sourceKeys[0] >> shift) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (int digit = 0; digit < 256; ++digit)
+			{
+				uint32_t digitCount = histogram[digit];
+				histogram[digit] = offset;
+				offset += digitCount;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				uint32_t destination = histogram[(sourceKeys[i] >> shift) & 0xFF]++;
+				destKeys[destination] = sourceKeys[i];
+				destValues[destination] = sourceValues[i];
+			}
+
+			std::swap(sourceKeys, destKeys);
+			std::swap(sourceValues, destValues);
+		}
+
+		if (sourceKeys != keys)
+		{
+			std::memcpy(keys, sourceKeys, count * sizeof(uint64_t));
+			std::memcpy(values, sourceValues, count * sizeof(uint32_t));
+		}
+	}
+}
@@ -14,6 +14,13 @@ typedef int8_t int8;
 using Path = std::filesystem::path;
 using DataBlob = std::vector<uint8_t>;
 
+struct path_hash
+{
+	std::size_t operator()(const Path& path) const {
+		return hash_value(path);
+	}
+};
+
 template <typename T, typename ... Args>
 constexpr std::shared_ptr<T> MakeShared(Args&& ...args)
 {
@@ -14,6 +14,8 @@ namespace Aurora
 			return;
 		}
 
+		std::lock_guard<std::mutex> lock(m_MessagesMutex);
+
 		if(ImGui::IconButton("Clear"))
 		{
 			m_Messages.clear();
@@ -69,6 +71,7 @@ namespace Aurora
 
 	void ConsoleWindow::Log(const Logger::Severity& severity, const std::string& severityStr, const std::string &file, const std::string &function, int line, const std::string &message)
 	{
+		std::lock_guard<std::mutex> lock(m_MessagesMutex);
 		m_Messages.push_back({severity, severityStr, file, function, line, message});
 	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <vector>
 #include "Aurora/Core/String.hpp"
 #include "Aurora/Logger/Logger.hpp"
@@ -21,6 +22,8 @@ namespace Aurora
 	private:
 		bool m_AutoScroll;
 		bool m_ScrollToBottom;
+		// Messages arrive from the logging thread
+		std::mutex m_MessagesMutex;
 		std::vector<SMessage> m_Messages;
 	public:
 		ConsoleWindow() : m_AutoScroll(true), m_ScrollToBottom(false) {}
@@ -279,11 +279,14 @@ namespace Aurora
 
 						//AU_LOG_INFO(glm::to_string(ray.Origin));
 
-						std::vector<RayCastHitResult> results;
-						if (GEngine->GetAppContext()->GetPhysicsWorld()->RayCast(ray.Origin, ray.Origin + ray.Direction * 1000.0f, results))
+						// The scene is not simulated in the editor, so the broadphase has to be synced before picking
+						PhysicsWorld* physicsWorld = GEngine->GetAppContext()->GetPhysicsWorld();
+						physicsWorld->SyncColliders();
+
+						RayCastHitResult closestResult;
+						if (physicsWorld->RayCastClosest(ray.Origin, ray.Direction, 1000.0f, closestResult))
 						{
-							const RayCastHitResult& closesResult = results[0];
-							m_MainPanel->SetSelectedActor(closesResult.HitActor);
+							m_MainPanel->SetSelectedActor(closestResult.HitActor);
 						}
 					}
 				}
@@ -98,17 +98,16 @@ namespace Aurora
 		{
 			if (ImGui::Begin("Memory Allocators"))
 			{
-				for (Aum* al : Aum::AllMemoryAllocators)
+				Aum::ForEachAllocator([](Aum* al)
 				{
-					ImGui::Text("%s", al->GetName().c_str());
-					int i = 0;
-					for (const Aum::MemoryBlock& block : al->GetMemoryBlocks())
-					{
-						ImGui::Text(" - Block #%d: fragments=%llu", i, block.Fragments.size());
-						i++;
-					}
+					Aum::Stats stats = al->GetStats();
+
+					ImGui::Text("%s (%s)", al->GetName().c_str(), al->GetMode() == Aum::EMode::SizeClass ? "SizeClass" : "FirstFit");
+					ImGui::Text(" - Blocks: %llu, allocations: %llu", (unsigned long long)stats.BlockCount, (unsigned long long)stats.AllocationCount);
+					ImGui::Text(" - Used: %s / %s", FormatBytes(stats.UsedBytes).c_str(), FormatBytes(stats.TotalBytes).c_str());
+					ImGui::Text(" - Free fragments: %llu, largest: %s, fragmentation: %.1f%%", (unsigned long long)stats.FreeFragmentCount, FormatBytes(stats.LargestFreeFragment).c_str(), stats.GetFragmentation() * 100.0);
 					ImGui::Separator();
-				}
+				});
 			}
 			ImGui::End();
 		}
@@ -20,7 +20,7 @@ namespace Aurora
 		MainEditorPanel* m_MainPanel;
 		Transform m_TransformToCopy;
 		bool m_IsTransformBeingCopied;
-		robin_hood::unordered_map<TTypeID, MethodDelegate<PropertiesWindow, void, ActorComponent*>> m_ComponentGUIMethods;
+		robin_hood::unordered_map<TTypeID, Delegate<void, ActorComponent*>> m_ComponentGUIMethods;
 	public:
 		explicit PropertiesWindow(MainEditorPanel* mainEditorPanel);
 
@@ -38,7 +38,7 @@ namespace Aurora
 				return;
 			}
 
-			m_ComponentGUIMethods[typeId] = MethodDelegate<PropertiesWindow, void, ActorComponent*>(this, method);
+			m_ComponentGUIMethods[typeId] = Delegate<void, ActorComponent*>(this, method);
 		}
 
 		template<class ComponentType>
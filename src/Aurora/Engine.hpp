@@ -19,6 +19,7 @@ namespace Aurora
 	class VgRender;
 	class ViewPortManager;
 	class AppContext;
+	class JobSystem;
 
 	namespace Input
 	{
@@ -28,6 +29,7 @@ namespace Aurora
 	class AuroraContext
 	{
 		friend class AuroraEngine;
+		friend class HeadlessEngine;
 	private:
 		ResourceManager* m_ResourceManager = nullptr;
 		RenderManager* m_RenderManager = nullptr;
@@ -38,6 +40,7 @@ namespace Aurora
 		VgRender* m_VgRender = nullptr;
 		ViewPortManager* m_ViewPortManager = nullptr;
 		AppContext* m_AppContext = nullptr;
+		JobSystem* m_JobSystem = nullptr;
 
 #if AU_HAS_AUDIO
 		FMOD::SoundSystem* m_SoundSystem = nullptr;
@@ -54,6 +57,7 @@ namespace Aurora
 		[[nodiscard]] inline VgRender* GetVgRender() const { return m_VgRender; }
 		[[nodiscard]] inline ViewPortManager* GetViewPortManager() const { return m_ViewPortManager; }
 		[[nodiscard]] inline AppContext* GetAppContext() const { return m_AppContext; }
+		[[nodiscard]] inline JobSystem* GetJobSystem() const { return m_JobSystem; }
 #if AU_HAS_AUDIO
 	[[nodiscard]] inline FMOD::SoundSystem* GetSoundSystem() const { return m_SoundSystem; }
 #endif
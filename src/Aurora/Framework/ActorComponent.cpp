@@ -28,6 +28,8 @@ namespace Aurora
 
 		m_Socket = socket;
 
+		OnAttachmentChanged();
+
 		return true;
 	}
 
@@ -39,6 +41,7 @@ namespace Aurora
 		{
 			VectorRemove<ActorComponent*>(m_Parent->m_Components, this);
 			m_Parent = nullptr;
+			OnAttachmentChanged();
 		}
 	}
 }
\ No newline at end of file
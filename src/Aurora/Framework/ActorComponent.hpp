@@ -43,8 +43,11 @@ namespace Aurora
 		[[nodiscard]] bool IsParentActive() const;
 
 		virtual int32_t GetSocketIndex(const String& socket) const { return -1; };
+		[[nodiscard]] const String& GetSocket() const { return m_Socket; }
 
 		bool AttachToComponent(SceneComponent* InParent, const String& socket = "");
 		void DetachFromComponent();
+	protected:
+		virtual void OnAttachmentChanged() {}
 	};
 }
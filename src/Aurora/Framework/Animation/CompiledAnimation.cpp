@@ -0,0 +1,193 @@
+#include "CompiledAnimation.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace Aurora::Animation
+{
+	CompiledSkeleton CompileSkeleton(const Armature& armature)
+	{
+		CompiledSkeleton skeleton;
+		skeleton.GlobalInverseTransform = armature.GlobalInverseTransform;
+
+		struct PendingBone
+		{
+			const Bone* Source;
+			int32_t ParentSlot;
+		};
+
+		// Depth first, so a parent always gets its slot before the children are visited
+		std::vector<PendingBone> stack;
+		for (auto it = armature.RootBones.rbegin(); it != armature.RootBones.rend(); ++it)
+		{
+			stack.push_back({*it, -1});
+		}
+
+		while (!stack.empty())
+		{
+			PendingBone pending = stack.back();
+			stack.pop_back();
+
+			auto slot = (int32_t)skeleton.BoneIndices.size();
+			skeleton.BoneIndices.push_back(pending.Source->Index);
+			skeleton.ParentSlots.push_back(pending.ParentSlot);
+			skeleton.OffsetMatrices.push_back(pending.Source->OffsetMatrix);
+
+			for (auto it = pending.Source->Children.rbegin(); it != pending.Source->Children.rend(); ++it)
+			{
+				stack.push_back({*it, slot});
+			}
+		}
+
+		return skeleton;
+	}
+
+	template<typename T, typename V>
+	static KeyTrack AppendTrack(const std::vector<AnimationKey<T>>& keys, std::vector<float>& times, std::vector<V>& values)
+	{
+		KeyTrack track{(uint32_t)times.size(), (uint32_t)keys.size()};
+
+		for (const AnimationKey<T>& key : keys)
+		{
+			times.push_back((float)key.Time);
+
+			if constexpr (std::is_same_v<V, Quaternion>)
+				values.push_back(glm::normalize(key.Value));
+			else
+				values.push_back(key.Value);
+		}
+
+		return track;
+	}
+
+	CompiledAnimationClip CompileAnimation(const FAnimation& animation, const CompiledSkeleton& skeleton)
+	{
+		CompiledAnimationClip clip;
+		clip.Duration = animation.Duration;
+		clip.TicksPerSecond = animation.TicksPerSecond;
+
+		uint32_t slotCount = skeleton.GetSlotCount();
+		clip.PositionTracks.resize(slotCount);
+		clip.RotationTracks.resize(slotCount);
+		clip.ScaleTracks.resize(slotCount);
+		clip.HasChannel.resize(slotCount, 0);
+
+		// Channel lookup by bone index, done once here instead of for every bone on every sample
+		std::vector<const AnimationChannel*> boneChannels;
+		for (const AnimationChannel& channel : animation.Channels)
+		{
+			if (channel.Index < 0)
+				continue;
+
+			if ((size_t)channel.Index >= boneChannels.size())
+				boneChannels.resize(channel.Index + 1, nullptr);
+
+			boneChannels[channel.Index] = &channel;
+		}
+
+		for (uint32_t slot = 0; slot < slotCount; ++slot)
+		{
+			int32_t boneIndex = skeleton.BoneIndices[slot];
+
+			if ((size_t)boneIndex >= boneChannels.size() || boneChannels[boneIndex] == nullptr)
+				continue;
+
+			const AnimationChannel& channel = *boneChannels[boneIndex];
+			clip.HasChannel[slot] = 1;
+			clip.PositionTracks[slot] = AppendTrack(channel.PositionKeys, clip.PositionTimes, clip.PositionValues);
+			clip.RotationTracks[slot] = AppendTrack(channel.RotationKeys, clip.RotationTimes, clip.RotationValues);
+			clip.ScaleTracks[slot] = AppendTrack(channel.ScaleKeys, clip.ScaleTimes, clip.ScaleValues);
+		}
+
+		return clip;
+	}
+
+	static inline Vector3 Interpolate(const Vector3& start, const Vector3& end, float factor)
+	{
+		return start + factor * (end - start);
+	}
+
+	static inline Quaternion Interpolate(const Quaternion& start, const Quaternion& end, float factor)
+	{
+		return glm::slerp(start, end, factor);
+	}
+
+	template<typename T>
+	static T SampleTrack(const KeyTrack& track, const float* times, const T* values, float time, uint32_t& cursor, const T& defaultValue)
+	{
+		if (track.Count == 0)
+			return defaultValue;
+
+		times += track.First;
+		values += track.First;
+
+		if (track.Count == 1)
+			return values[0];
+
+		uint32_t key = std::min(cursor, track.Count - 2);
+
+		// Playback looped or jumped back, find the key again
+		if (time < times[key])
+		{
+			key = (uint32_t)(std::upper_bound(times, times + track.Count, time) - times);
+			key = key > 0 ? key - 1 : 0;
+		}
+
+		while (key + 2 < track.Count && times[key + 1] <= time)
+		{
+			key++;
+		}
+
+		cursor = key;
+
+		if (time <= times[key])
+			return values[key];
+
+		if (time >= times[key + 1])
+			return values[key + 1];
+
+		float factor = (time - times[key]) / (times[key + 1] - times[key]);
+		return Interpolate(values[key], values[key + 1], factor);
+	}
+
+	void EvaluatePose(const CompiledSkeleton& skeleton, const CompiledAnimationClip& clip, double time, AnimationCursor& cursor, Matrix4* transforms)
+	{
+		uint32_t slotCount = skeleton.GetSlotCount();
+
+		if (cursor.Keys.size() != slotCount * 3)
+			cursor.Keys.assign(slotCount * 3, 0);
+
+		// Model space transforms of the slots, reused by every evaluation on this thread
+		thread_local std::vector<Matrix4> globalTransforms;
+		globalTransforms.resize(slotCount);
+
+		auto sampleTime = (float)time;
+
+		for (uint32_t slot = 0; slot < slotCount; ++slot)
+		{
+			Matrix4 localTransform(1.0f);
+
+			if (clip.HasChannel[slot])
+			{
+				uint32_t* keys = &cursor.Keys[slot * 3];
+
+				Vector3 position = SampleTrack(clip.PositionTracks[slot], clip.PositionTimes.data(), clip.PositionValues.data(), sampleTime, keys[0], Vector3(0.0f));
+				Quaternion rotation = SampleTrack(clip.RotationTracks[slot], clip.RotationTimes.data(), clip.RotationValues.data(), sampleTime, keys[1], glm::identity<Quaternion>());
+				Vector3 scale = SampleTrack(clip.ScaleTracks[slot], clip.ScaleTimes.data(), clip.ScaleValues.data(), sampleTime, keys[2], Vector3(1.0f));
+
+				// translate * rotate * scale without the two matrix products
+				localTransform = glm::mat4_cast(rotation);
+				localTransform[0] *= scale.x;
+				localTransform[1] *= scale.y;
+				localTransform[2] *= scale.z;
+				localTransform[3] = Vector4(position, 1.0f);
+			}
+
+			// The global inverse is folded into the roots, so every bone pays a single product for it
+			int32_t parentSlot = skeleton.ParentSlots[slot];
+			globalTransforms[slot] = (parentSlot < 0 ? skeleton.GlobalInverseTransform : globalTransforms[parentSlot]) * localTransform;
+
+			transforms[skeleton.BoneIndices[slot]] = globalTransforms[slot] * skeleton.OffsetMatrices[slot];
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Core/Vector.hpp"
+#include "Armature.hpp"
+#include "Animation.hpp"
+
+namespace Aurora::Animation
+{
+	// Armature flattened into evaluation order (slots), every parent slot comes before its children.
+	// Bones which are not reachable from the root bones are left out.
+	struct CompiledSkeleton
+	{
+		// Output bone index of every slot
+		std::vector<int32_t> BoneIndices;
+		// Slot of the parent bone, -1 for roots
+		std::vector<int32_t> ParentSlots;
+		std::vector<Matrix4> OffsetMatrices;
+		Matrix4 GlobalInverseTransform{1.0f};
+
+		[[nodiscard]] uint32_t GetSlotCount() const { return (uint32_t)BoneIndices.size(); }
+	};
+
+	// Range of one track inside the key arrays of a clip
+	struct KeyTrack
+	{
+		uint32_t First = 0;
+		uint32_t Count = 0;
+	};
+
+	// Animation bound to a compiled skeleton, tracks are indexed by slot and keys are stored as separate time and value arrays
+	struct CompiledAnimationClip
+	{
+		double Duration = 0;
+		double TicksPerSecond = 0;
+
+		std::vector<KeyTrack> PositionTracks;
+		std::vector<KeyTrack> RotationTracks;
+		std::vector<KeyTrack> ScaleTracks;
+		// Slots without a channel keep the identity local transform
+		std::vector<uint8_t> HasChannel;
+
+		std::vector<float> PositionTimes;
+		std::vector<Vector3> PositionValues;
+		std::vector<float> RotationTimes;
+		// Normalized at compile time
+		std::vector<Quaternion> RotationValues;
+		std::vector<float> ScaleTimes;
+		std::vector<Vector3> ScaleValues;
+	};
+
+	// Last sampled key of every track for one animated instance. Playback moves forward by a frame at a time,
+	// so sampling continues from these keys instead of searching from the start. Any clip can be sampled with any cursor,
+	// a cursor that does not match just costs a search.
+	struct AnimationCursor
+	{
+		// Position, rotation and scale key per slot
+		std::vector<uint32_t> Keys;
+	};
+
+	AU_API CompiledSkeleton CompileSkeleton(const Armature& armature);
+	AU_API CompiledAnimationClip CompileAnimation(const FAnimation& animation, const CompiledSkeleton& skeleton);
+
+	// Samples the clip at time (in ticks) and writes skinning matrices of the skeleton bones to transforms, indexed by bone index
+	AU_API void EvaluatePose(const CompiledSkeleton& skeleton, const CompiledAnimationClip& clip, double time, AnimationCursor& cursor, Matrix4* transforms);
+}
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <tuple>
 #include "Aurora/Core/Object.hpp"
 #include "Aurora/Core/Common.hpp"
+#include "Aurora/Core/assert.hpp"
 #include "Aurora/Core/String.hpp"
 #include "Aurora/Logger/Logger.hpp"
 #include "Aurora/Memory/Aum.hpp"
@@ -14,76 +16,95 @@ namespace Aurora
 	class ComponentIterator
 	{
 	private:
-		T** m_Current;
-		size_t m_Index;
+		ActorComponent* const* m_Current;
 	public:
-		explicit ComponentIterator(T** current, size_t index) : m_Current(current), m_Index(index) {}
+		explicit ComponentIterator(ActorComponent* const* current) : m_Current(current) {}
 
-		T* operator*()
+		T* operator*() const
 		{
-			return *m_Current;
+			return static_cast<T*>(*m_Current);
 		}
 
 		ComponentIterator& operator++()
 		{
 			m_Current++;
-			m_Index++;
 
 			return *this;
 		}
 
 		bool operator==(const ComponentIterator<T>& other) const
 		{
-			return m_Index == other.m_Index;
+			return m_Current == other.m_Current;
 		}
 
 		bool operator!=(const ComponentIterator<T>& other) const
 		{
-			return m_Index != other.m_Index;
+			return m_Current != other.m_Current;
 		}
 	};
 
+	// Non-owning view into the dense array of one component type, it reflects the current storage state
+	// (a view of a type that had no components at query time stays empty).
+	// Iterators are invalidated by CreateComponent/DestroyComponent, index based loops can survive destruction.
 	template<typename T>
 	class ComponentView
 	{
 	private:
-		std::vector<std::uintptr_t> m_DataVector;
+		const std::vector<ActorComponent*>* m_Components;
 	public:
-		ComponentView() : m_DataVector() {}
+		ComponentView() : m_Components(nullptr) {}
 
-		explicit ComponentView(std::vector<std::uintptr_t> data) : m_DataVector(std::move(data))
+		explicit ComponentView(const std::vector<ActorComponent*>* components) : m_Components(components)
 		{
 		}
 
-		[[nodiscard]] std::vector<std::uintptr_t>::size_type size() const { return m_DataVector.size(); }
-		[[nodiscard]] bool empty() const { return m_DataVector.empty(); }
+		[[nodiscard]] size_t size() const { return m_Components ? m_Components->size() : 0; }
+		[[nodiscard]] bool empty() const { return size() == 0; }
 
-		ComponentIterator<T> begin()
+		T* operator[](size_t index) const
 		{
-			if(m_DataVector.empty())
+			return static_cast<T*>((*m_Components)[index]);
+		}
+
+		ComponentIterator<T> begin() const
+		{
+			if(empty())
 			{
-				return ComponentIterator<T>(nullptr, 0);
+				return ComponentIterator<T>(nullptr);
 			}
 
-			return ComponentIterator<T>(reinterpret_cast<T**>(&m_DataVector[0]), 0);
+			return ComponentIterator<T>(m_Components->data());
 		}
 
-		ComponentIterator<T> end()
+		ComponentIterator<T> end() const
 		{
-			if(m_DataVector.empty())
+			if(empty())
 			{
-				return ComponentIterator<T>(nullptr, 0);
+				return ComponentIterator<T>(nullptr);
 			}
 
-			return ComponentIterator<T>(nullptr, m_DataVector.size());
+			return ComponentIterator<T>(m_Components->data() + m_Components->size());
 		}
 	};
 
 	class AU_API ComponentStorage
 	{
 	private:
+		struct ComponentBucket
+		{
+			std::vector<ActorComponent*> Components;
+			robin_hood::unordered_flat_map<ActorComponent*, uint32_t> Indices;
+		};
+
 		robin_hood::unordered_map<TTypeID, Aum*> m_ComponentMemory;
-		robin_hood::unordered_map<TTypeID, std::vector<std::uintptr_t>> m_ComponentPointers;
+		// Every component is stored in the bucket of its own type and in the buckets of all its base types
+		robin_hood::unordered_node_map<TTypeID, ComponentBucket> m_ComponentBuckets;
+		robin_hood::unordered_map<TTypeID, std::vector<ComponentBucket*>> m_TypeBuckets;
+
+		// Components destroyed while a loop over the arrays is running, freed by EndDeferredDestroy
+		uint32_t m_DeferDestroyDepth = 0;
+		std::vector<ActorComponent*> m_PendingDestroy;
+		robin_hood::unordered_flat_set<const ActorComponent*> m_PendingDestroySet;
 	public:
 		~ComponentStorage()
 		{
@@ -109,33 +130,59 @@ namespace Aurora
 			}
 			else
 			{
-				allocator = new Aum();
+				allocator = new Aum(Aum::DefaultBlockSize, Aum::EMode::SizeClass);
 				allocator->SetName(std::string("ComponentMemory:") + T::TypeName());
 				m_ComponentMemory.emplace(componentID, allocator);
 				AU_LOG_INFO("New allocator for component ", T::TypeName(), " with size of ", FormatBytes(componentSize), " aligned ", FormatBytes(componentSizeAligned));
 			}
 
 			MemPtr componentMemory = allocator->Alloc(componentSizeAligned);
-			ActorComponent* component = new(componentMemory) T(std::forward<Args>(args)...);
+			T* component = new(componentMemory) T(std::forward<Args>(args)...);
 			component->SetName(name);
 
-			m_ComponentPointers[componentID].push_back((std::uintptr_t)component);
+			auto typeBucketsIt = m_TypeBuckets.find(componentID);
+
+			if(typeBucketsIt == m_TypeBuckets.end())
+			{
+				typeBucketsIt = m_TypeBuckets.emplace(componentID, std::vector<ComponentBucket*>()).first;
+				CollectTypeBuckets<T>(typeBucketsIt->second);
+			}
+
+			for(ComponentBucket* bucket : typeBucketsIt->second)
+			{
+				bucket->Indices.emplace(component, (uint32_t)bucket->Components.size());
+				bucket->Components.push_back(component);
+			}
 
-			return (T*) component;
+			return component;
 		}
 
 		template<typename T, typename std::enable_if<std::is_base_of<ActorComponent, T>::value>::type* = nullptr>
 		void DestroyComponent(T* component)
 		{
+			if(m_DeferDestroyDepth > 0)
+			{
+				if(m_PendingDestroySet.insert(component).second)
+				{
+					m_PendingDestroy.push_back(component);
+				}
+				return;
+			}
+
 			TTypeID componentID = component->GetTypeID();
 
-			if(!m_ComponentMemory.contains(componentID))
+			auto typeBucketsIt = m_TypeBuckets.find(componentID);
+
+			if(!m_ComponentMemory.contains(componentID) || typeBucketsIt == m_TypeBuckets.end())
 			{
 				AU_LOG_WARNING("Component ", component->GetTypeName(), " does not exists in Scene !");
 				return;
 			}
 
-			VectorRemove<std::uintptr_t>(m_ComponentPointers[componentID], (std::uintptr_t)component);
+			for(ComponentBucket* bucket : typeBucketsIt->second)
+			{
+				RemoveFromBucket(*bucket, component);
+			}
 
 			if (not m_ComponentMemory[componentID]->CheckMemory(component))
 			{
@@ -146,43 +193,128 @@ namespace Aurora
 			m_ComponentMemory[componentID]->DeAllocAndUnload<T>(component);
 		}
 
+		// Between these calls destroyed components stay in the arrays and in memory, so an index loop over a view
+		// neither skips nor repeats components. Loops check IsPendingDestroy to skip the destroyed ones.
+		void BeginDeferredDestroy()
+		{
+			m_DeferDestroyDepth++;
+		}
+
+		void EndDeferredDestroy()
+		{
+			au_assert(m_DeferDestroyDepth > 0);
+
+			if(--m_DeferDestroyDepth > 0)
+			{
+				return;
+			}
+
+			std::vector<ActorComponent*> pendingDestroy = std::move(m_PendingDestroy);
+			m_PendingDestroy.clear();
+			m_PendingDestroySet.clear();
+
+			for(ActorComponent* component : pendingDestroy)
+			{
+				DestroyComponent(component);
+			}
+		}
+
+		[[nodiscard]] bool IsPendingDestroy(const ActorComponent* component) const
+		{
+			return !m_PendingDestroySet.empty() && m_PendingDestroySet.contains(component);
+		}
+
 		// Not multi-thread friendly currently
 		template<typename T, typename std::enable_if<std::is_base_of<ActorComponent, T>::value>::type* = nullptr>
-		ComponentView<T> GetComponents()
+		ComponentView<T> GetComponents() const
 		{
-			std::vector<std::uintptr_t> foundComponents;
+			auto it = m_ComponentBuckets.find(T::TypeID());
 
-			for(auto& it : m_ComponentPointers)
+			if(it == m_ComponentBuckets.end())
 			{
-				if(it.second.empty()) continue;
+				return ComponentView<T>();
+			}
 
-				auto* typeBase = reinterpret_cast<ObjectBase*>(it.second[0]);
+			return ComponentView<T>(&it->second.Components);
+		}
 
-				if(typeBase->HasType(T::TypeID()))
-				{
-					foundComponents.insert(foundComponents.end(), it.second.begin(), it.second.end());
-				}
+		template<typename T, typename std::enable_if<std::is_base_of<ActorComponent, T>::value>::type* = nullptr>
+		T* FindFirstComponent() const
+		{
+			ComponentView<T> components = GetComponents<T>();
+
+			if(components.empty())
+			{
+				return nullptr;
 			}
 
-			return ComponentView<T>(std::forward<std::vector<std::uintptr_t>>(foundComponents));
+			return components[0];
 		}
 
-		template<typename T, typename std::enable_if<std::is_base_of<ActorComponent, T>::value>::type* = nullptr>
-		T* FindFirstComponent()
+		// Calls func(T*, With*...) for every component of type T whose owner also has all the With components.
+		// Requires Actor to be a complete type at the point of use (include Scene.hpp or Actor.hpp).
+		template<typename T, typename... With, typename Func>
+		void ForEach(Func&& func) const
 		{
-			for(auto& it : m_ComponentPointers)
+			ComponentView<T> components = GetComponents<T>();
+
+			// Skip the whole query when one of the required types has no instances at all
+			if(components.empty() || (GetComponents<With>().empty() || ...))
 			{
-				if(it.second.empty()) continue;
+				return;
+			}
+
+			for(size_t i = 0; i < components.size(); ++i)
+			{
+				T* component = components[i];
+				auto* owner = component->GetOwner();
+
+				if(!owner)
+				{
+					continue;
+				}
 
-				auto* typeBase = reinterpret_cast<ObjectBase*>(it.second[0]);
+				std::tuple<With*...> others = { owner->template FindComponentOfType<With>()... };
 
-				if(typeBase->HasType(T::TypeID()))
+				if(((std::get<With*>(others) != nullptr) && ...))
 				{
-					return reinterpret_cast<T*>(*it.second.begin());
+					func(component, std::get<With*>(others)...);
 				}
 			}
+		}
+	private:
+		template<typename T>
+		void CollectTypeBuckets(std::vector<ComponentBucket*>& buckets)
+		{
+			buckets.push_back(&m_ComponentBuckets[T::TypeID()]);
+
+			if constexpr (!std::is_same_v<T, ActorComponent>)
+			{
+				CollectTypeBuckets<typename T::Super>(buckets);
+			}
+		}
+
+		static void RemoveFromBucket(ComponentBucket& bucket, ActorComponent* component)
+		{
+			auto indexIt = bucket.Indices.find(component);
 
-			return nullptr;
+			if(indexIt == bucket.Indices.end())
+			{
+				return;
+			}
+
+			uint32_t index = indexIt->second;
+			bucket.Indices.erase(indexIt);
+
+			// Swap with the last component to keep the array dense
+			ActorComponent* last = bucket.Components.back();
+			bucket.Components.pop_back();
+
+			if(last != component)
+			{
+				bucket.Components[index] = last;
+				bucket.Indices[last] = index;
+			}
 		}
 	};
-}
\ No newline at end of file
+}
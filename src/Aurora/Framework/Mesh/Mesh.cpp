@@ -50,4 +50,321 @@ namespace Aurora
 				lodResource.Indices.clear();
 		}
 	}
-}
\ No newline at end of file
+
+	LOD Mesh::SelectLOD(float screenSize) const
+	{
+		LOD lod = 0;
+		float threshold = LODScreenSize;
+
+		while (screenSize < threshold && LODResources.contains((LOD)(lod + 1)))
+		{
+			lod++;
+			threshold *= 0.5f;
+		}
+
+		return lod;
+	}
+
+	void Mesh::SerializeInfo(Archive& archive) const
+	{
+		size_t chunk = archive.BeginChunk(MeshChunk::Info);
+		archive << Name;
+		archive << m_Bounds.GetMin();
+		archive << m_Bounds.GetMax();
+		archive.EndChunk(chunk);
+	}
+
+	void Mesh::SerializeMaterialSlots(Archive& archive) const
+	{
+		size_t chunk = archive.BeginChunk(MeshChunk::Materials);
+		archive << (uint32_t)MaterialSlots.size();
+
+		for (const auto& [slotID, slot] : MaterialSlots)
+		{
+			archive << slotID;
+			archive << slot.MaterialSlotName;
+			//archive << slot.Material->GetResourceName(); // TODO Finish resource names
+			String resourceName = "none";
+			archive << resourceName;
+		}
+
+		archive.EndChunk(chunk);
+	}
+
+	bool Mesh::DeserializeCommonChunk(uint32_t tag, Archive& chunk)
+	{
+		switch (tag)
+		{
+			case MeshChunk::Info:
+			{
+				Vector3 min;
+				Vector3 max;
+				chunk >> Name;
+				chunk >> min;
+				chunk >> max;
+				m_Bounds.Set(min, max);
+				return true;
+			}
+			case MeshChunk::Materials:
+			{
+				uint32_t materialSlots;
+				chunk >> materialSlots;
+
+				for (uint32_t i = 0; i < materialSlots; ++i)
+				{
+					MaterialSlot slot;
+
+					int32_t slotID;
+					chunk >> slotID;
+
+					chunk >> slot.MaterialSlotName;
+					String resourceName;
+					chunk >> resourceName;
+
+					MaterialSlots[slotID] = slot;
+				}
+
+				return true;
+			}
+			default:
+				return false;
+		}
+	}
+
+	void StaticMesh::Deserialize(Archive& archive)
+	{
+		uint32_t tag;
+		Archive chunk;
+
+		while (archive.ReadChunk(tag, chunk))
+		{
+			if (tag == MeshChunk::Lod)
+			{
+				DeserializeLOD<Vertex>(chunk);
+				continue;
+			}
+
+			DeserializeCommonChunk(tag, chunk);
+		}
+	}
+
+	void StaticMesh::DeserializeVersion1(Archive& archive)
+	{
+		archive >> Name;
+		uint32_t numLods;
+		archive >> numLods;
+
+		for (uint32_t i = 0; i < numLods; ++i)
+		{
+			LOD lod;
+			archive >> lod;
+
+			uint32_t vertexCount;
+			archive >> vertexCount;
+
+			if (vertexCount > archive.GetRemaining() / sizeof(Vertex))
+				throw std::runtime_error("Archive read past the end");
+
+			MeshLodResource* lodResource;
+			VertexBuffer<Vertex>* vertexBuffer = CreateVertexBuffer<Vertex>(lod, &lodResource);
+			vertexBuffer->Resize(vertexCount);
+			archive.ReadArray(vertexBuffer->GetElements(), vertexCount);
+
+			uint8_t indexFormat;
+			archive >> indexFormat;
+			lodResource->IndexFormat = (EIndexBufferFormat)indexFormat;
+
+			archive >> lodResource->Indices;
+			archive >> lodResource->Sections;
+		}
+
+		uint32_t materialSlots;
+		archive >> materialSlots;
+
+		for (uint32_t i = 0; i < materialSlots; ++i)
+		{
+			MaterialSlot slot;
+
+			int32_t SlotID;
+			archive >> SlotID;
+
+			archive >> slot.MaterialSlotName;
+			String resourceName;
+			archive >> resourceName;
+
+			MaterialSlots[SlotID] = slot;
+		}
+
+		Vector3 min;
+		Vector3 max;
+		archive >> min;
+		archive >> max;
+		m_Bounds.Set(min, max);
+	}
+
+	void SkeletalMesh::Serialize(Archive& archive)
+	{
+		SerializeInfo(archive);
+		SerializeLODs<Vertex>(archive);
+		SerializeMaterialSlots(archive);
+
+		// Bone pointers are stored as indices to Bones
+		size_t chunk = archive.BeginChunk(MeshChunk::Skeleton);
+		archive << (uint32_t)Armature.Bones.size();
+
+		for (const Animation::Bone& bone : Armature.Bones)
+		{
+			archive << bone.Index;
+			archive << bone.Name;
+			archive << bone.Parent;
+			archive << bone.OffsetMatrix;
+
+			archive << (uint32_t)bone.Children.size();
+			for (const Animation::Bone* child : bone.Children)
+				archive << (int32_t)(child - Armature.Bones.data());
+		}
+
+		archive << (uint32_t)Armature.RootBones.size();
+		for (const Animation::Bone* rootBone : Armature.RootBones)
+			archive << (int32_t)(rootBone - Armature.Bones.data());
+
+		archive << Armature.GlobalInverseTransform;
+		archive.EndChunk(chunk);
+
+		for (const Animation::FAnimation& animation : Animations)
+		{
+			chunk = archive.BeginChunk(MeshChunk::AnimationClip);
+			archive << animation.Name;
+			archive << animation.Duration;
+			archive << animation.TicksPerSecond;
+			archive << (uint32_t)animation.Channels.size();
+
+			for (const Animation::AnimationChannel& channel : animation.Channels)
+			{
+				archive << (int32_t)channel.Index;
+				archive << channel.Name;
+				archive << channel.PositionKeys;
+				archive << channel.RotationKeys;
+				archive << channel.ScaleKeys;
+			}
+
+			archive.EndChunk(chunk);
+		}
+	}
+
+	static Animation::Bone* ReadBoneReference(Archive& archive, std::vector<Animation::Bone>& bones)
+	{
+		int32_t index;
+		archive >> index;
+
+		if (index < 0 || index >= (int32_t)bones.size())
+			throw std::runtime_error("Bone index out of range");
+
+		return &bones[index];
+	}
+
+	void SkeletalMesh::Deserialize(Archive& archive)
+	{
+		Animations.clear();
+		CompiledAnimations.clear();
+
+		uint32_t tag;
+		Archive chunk;
+
+		while (archive.ReadChunk(tag, chunk))
+		{
+			switch (tag)
+			{
+				case MeshChunk::Lod:
+				{
+					DeserializeLOD<Vertex>(chunk);
+					break;
+				}
+				case MeshChunk::Skeleton:
+				{
+					uint32_t boneCount;
+					chunk >> boneCount;
+
+					Armature = {};
+					Armature.Bones.resize(boneCount);
+
+					for (uint32_t i = 0; i < boneCount; ++i)
+					{
+						Animation::Bone& bone = Armature.Bones[i];
+						chunk >> bone.Index;
+						chunk >> bone.Name;
+						chunk >> bone.Parent;
+						chunk >> bone.OffsetMatrix;
+
+						uint32_t childCount;
+						chunk >> childCount;
+
+						if (childCount > boneCount)
+							throw std::runtime_error("Bone index out of range");
+
+						bone.Children.resize(childCount);
+						for (uint32_t c = 0; c < childCount; ++c)
+							bone.Children[c] = ReadBoneReference(chunk, Armature.Bones);
+
+						Armature.BoneMapping[bone.Name] = (int32_t)i;
+					}
+
+					uint32_t rootCount;
+					chunk >> rootCount;
+
+					if (rootCount > boneCount)
+						throw std::runtime_error("Bone index out of range");
+
+					Armature.RootBones.resize(rootCount);
+					for (uint32_t r = 0; r < rootCount; ++r)
+						Armature.RootBones[r] = ReadBoneReference(chunk, Armature.Bones);
+
+					chunk >> Armature.GlobalInverseTransform;
+					break;
+				}
+				case MeshChunk::AnimationClip:
+				{
+					Animation::FAnimation& animation = Animations.emplace_back();
+					chunk >> animation.Name;
+					chunk >> animation.Duration;
+					chunk >> animation.TicksPerSecond;
+
+					uint32_t channelCount;
+					chunk >> channelCount;
+
+					for (uint32_t i = 0; i < channelCount; ++i)
+					{
+						Animation::AnimationChannel& channel = animation.Channels.emplace_back();
+						int32_t channelIndex;
+						chunk >> channelIndex;
+						channel.Index = channelIndex;
+						chunk >> channel.Name;
+						chunk >> channel.PositionKeys;
+						chunk >> channel.RotationKeys;
+						chunk >> channel.ScaleKeys;
+					}
+					break;
+				}
+				default:
+					DeserializeCommonChunk(tag, chunk);
+					break;
+			}
+		}
+	}
+
+	void SkeletalMesh::EnsureCompiledAnimations()
+	{
+		if (!CompiledAnimations.empty() && CompiledAnimations.size() == Animations.size())
+			return;
+
+		CompiledSkeleton = Animation::CompileSkeleton(Armature);
+
+		CompiledAnimations.clear();
+		CompiledAnimations.reserve(Animations.size());
+
+		for (const Animation::FAnimation& animation : Animations)
+		{
+			CompiledAnimations.push_back(Animation::CompileAnimation(animation, CompiledSkeleton));
+		}
+	}
+}
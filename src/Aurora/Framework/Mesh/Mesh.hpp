@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include "Aurora/Core/Types.hpp"
 #include "Aurora/Core/Vector.hpp"
 #include "Aurora/Core/Object.hpp"
@@ -13,6 +14,7 @@
 
 #include "Aurora/Framework/Animation/Armature.hpp"
 #include "Aurora/Framework/Animation/Animation.hpp"
+#include "Aurora/Framework/Animation/CompiledAnimation.hpp"
 
 namespace Aurora
 {
@@ -72,6 +74,16 @@ namespace Aurora
 
 	typedef std::unordered_map<int32_t, MaterialSlot> MaterialSet;
 
+	// Chunks of an .amesh file, they follow the version and the mesh type. Readers skip the chunks they do not know.
+	namespace MeshChunk
+	{
+		static constexpr uint32_t Info = Archive::MakeChunkTag("INFO");
+		static constexpr uint32_t Lod = Archive::MakeChunkTag("LOD ");
+		static constexpr uint32_t Materials = Archive::MakeChunkTag("MATS");
+		static constexpr uint32_t Skeleton = Archive::MakeChunkTag("SKEL");
+		static constexpr uint32_t AnimationClip = Archive::MakeChunkTag("ANIM");
+	}
+
 	AU_CLASS(Mesh) : public ObjectBase
 	{
 	public:
@@ -87,6 +99,10 @@ namespace Aurora
 
 		virtual void ComputeAABB() = 0;
 
+		// Screen size is the bounds radius divided by the distance to the camera, each next LOD is used from half of the previous size
+		static constexpr float LODScreenSize = 0.25f;
+		[[nodiscard]] LOD SelectLOD(float screenSize) const;
+
 		static TTypeID ReadMeshType(Archive& archive)
 		{
 			TTypeID type;
@@ -100,6 +116,13 @@ namespace Aurora
 		}
 
 		virtual void Serialize(Archive& archive) = 0;
+		// Throws std::runtime_error when the data is malformed
+		virtual void Deserialize(Archive& archive) = 0;
+	protected:
+		void SerializeInfo(Archive& archive) const;
+		void SerializeMaterialSlots(Archive& archive) const;
+		// Info and material slot chunks, returns false for the other ones
+		bool DeserializeCommonChunk(uint32_t tag, Archive& chunk);
 	};
 
 	template<typename Self>
@@ -171,6 +194,77 @@ namespace Aurora
 
 			return (VertexBuffer<BufferTypename>*)lodResource->Vertices.get();
 		}
+	protected:
+		// One chunk per LOD, vertices and indices are written as single blocks
+		template<typename BufferTypename>
+		void SerializeLODs(Archive& archive)
+		{
+			auto& lodResources = static_cast<Self*>(this)->LODResources;
+
+			std::vector<LOD> lods;
+			size_t dataSize = 0;
+
+			for (const auto& [lod, lodResource] : lodResources)
+			{
+				lods.push_back(lod);
+				dataSize += lodResource.Indices.size() * sizeof(Index_t);
+
+				if (lodResource.Vertices)
+					dataSize += lodResource.Vertices->GetSize();
+			}
+
+			std::sort(lods.begin(), lods.end());
+			archive.Reserve(archive.GetSize() + dataSize + 1024);
+
+			for (LOD lod : lods)
+			{
+				const MeshLodResource& lodResource = lodResources[lod];
+				VertexBuffer<BufferTypename>* vertexBuffer = GetVertexBuffer<BufferTypename>(lod);
+				uint32_t vertexCount = vertexBuffer ? (uint32_t)vertexBuffer->GetCount() : 0;
+
+				size_t chunk = archive.BeginChunk(MeshChunk::Lod);
+				archive << lod;
+				archive << (uint32_t)sizeof(BufferTypename);
+				archive << vertexCount;
+
+				if (vertexCount > 0)
+					archive.WriteArray(vertexBuffer->GetElements(), vertexCount);
+
+				archive << (uint8_t)lodResource.IndexFormat;
+				archive << lodResource.Indices;
+				archive << lodResource.Sections;
+				archive.EndChunk(chunk);
+			}
+		}
+
+		template<typename BufferTypename>
+		void DeserializeLOD(Archive& chunk)
+		{
+			LOD lod;
+			uint32_t vertexStride;
+			uint32_t vertexCount;
+			chunk >> lod;
+			chunk >> vertexStride;
+			chunk >> vertexCount;
+
+			if (vertexStride != sizeof(BufferTypename))
+				throw std::runtime_error("Mesh vertex layout does not match");
+
+			if (vertexCount > chunk.GetRemaining() / sizeof(BufferTypename))
+				throw std::runtime_error("Archive read past the end");
+
+			MeshLodResource* lodResource;
+			VertexBuffer<BufferTypename>* vertexBuffer = CreateVertexBuffer<BufferTypename>(lod, &lodResource);
+			vertexBuffer->Resize(vertexCount);
+			chunk.ReadArray(vertexBuffer->GetElements(), vertexCount);
+
+			uint8_t indexFormat;
+			chunk >> indexFormat;
+			lodResource->IndexFormat = (EIndexBufferFormat)indexFormat;
+
+			chunk >> lodResource->Indices;
+			chunk >> lodResource->Sections;
+		}
 	};
 
 	AU_CLASS(StaticMesh) : public Mesh, public MeshBufferHelper<StaticMesh>
@@ -219,93 +313,14 @@ namespace Aurora
 
 		void Serialize(Archive& archive) override
 		{
-			archive << Name;
-			archive << (uint32_t)LODResources.size();
-
-			for (const auto& [lod, res] : LODResources)
-			{
-				archive << lod;
-				VertexBuffer<Vertex>* vertexBuffer = GetVertexBuffer<Vertex>(lod);
-				archive << (uint32_t)vertexBuffer->GetCount();
-				for (size_t i = 0; i < vertexBuffer->GetCount(); ++i)
-				{
-					const Vertex& vertex = vertexBuffer->Get(i);
-					archive.Write(vertex);
-				}
-
-				archive << (uint8_t)res.IndexFormat;
-				archive << res.Indices;
-				archive << res.Sections;
-			}
-
-			archive << (uint32_t)MaterialSlots.size();
-			for (const auto& [SlotID, slot] : MaterialSlots)
-			{
-				archive << SlotID;
-				archive << slot.MaterialSlotName;
-				//archive << slot.Material->GetResourceName(); // TODO Finish resource names
-				String resourceName = "none";
-				archive << resourceName;
-			}
-
-			archive << m_Bounds.GetMin();
-			archive << m_Bounds.GetMax();
+			SerializeInfo(archive);
+			SerializeLODs<Vertex>(archive);
+			SerializeMaterialSlots(archive);
 		}
 
-		void Deserialize(Archive& archive)
-		{
-			archive >> Name;
-			uint32_t numLods;
-			archive >> numLods;
-
-			for (uint32_t i = 0; i < numLods; ++i)
-			{
-				LOD lod;
-				archive >> lod;
-
-				uint32_t vertexCount;
-				archive >> vertexCount;
-
-				MeshLodResource* lodResource;
-				VertexBuffer<Vertex>* vertexBuffer = CreateVertexBuffer<Vertex>(lod, &lodResource);
-
-				for (int vi = 0; vi < vertexCount; ++vi)
-				{
-					Vertex vertex = archive.Read<Vertex>();
-					vertexBuffer->Emplace(vertex);
-				}
-
-				uint8_t indexFormat;
-				archive >> indexFormat;
-				lodResource->IndexFormat = (EIndexBufferFormat)indexFormat;
-
-				archive >> lodResource->Indices;
-				archive >> lodResource->Sections;
-			}
-
-			uint32_t materialSlots;
-			archive >> materialSlots;
-
-			for (uint32_t i = 0; i < materialSlots; ++i)
-			{
-				MaterialSlot slot;
-
-				int32_t SlotID;
-				archive >> SlotID;
-
-				archive >> slot.MaterialSlotName;
-				String resourceName;
-				archive >> resourceName;
-
-				MaterialSlots[SlotID] = slot;
-			}
-
-			Vector3 min;
-			Vector3 max;
-			archive >> min;
-			archive >> max;
-			m_Bounds.Set(min, max);
-		}
+		void Deserialize(Archive& archive) override;
+		// Meshes written before the chunked format
+		void DeserializeVersion1(Archive& archive);
 	};
 
 	#define NUM_BONES_PER_VEREX 4
@@ -338,6 +353,13 @@ namespace Aurora
 		Animation::Armature Armature;
 		std::vector<Animation::FAnimation> Animations;
 
+		// Sampling data built from Armature and Animations by EnsureCompiledAnimations
+		Animation::CompiledSkeleton CompiledSkeleton;
+		std::vector<Animation::CompiledAnimationClip> CompiledAnimations;
+
+		// Compiles the animations when they changed in count since the last call, the armature is expected to stay the same
+		void EnsureCompiledAnimations();
+
 		struct Vertex
 		{
 			Vector3 Position;
@@ -383,9 +405,7 @@ namespace Aurora
 			}
 		}
 
-		void Serialize(Archive& archive) override
-		{
-
-		}
+		void Serialize(Archive& archive) override;
+		void Deserialize(Archive& archive) override;
 	};
 }
\ No newline at end of file
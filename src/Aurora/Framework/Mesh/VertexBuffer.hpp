@@ -41,6 +41,19 @@ namespace Aurora
 			return Buffer[index];
 		}
 
+		// For filling the buffer in bulk, Resize and then copy to GetElements
+		inline void Resize(size_t count) {
+			Buffer.resize(count);
+		}
+
+		[[nodiscard]] inline VertexBufferType* GetElements() {
+			return Buffer.data();
+		}
+
+		[[nodiscard]] inline const VertexBufferType* GetElements() const {
+			return Buffer.data();
+		}
+
 		[[nodiscard]] inline size_t GetCount() const override {
 			return Buffer.size();
 		}
@@ -1,9 +1,18 @@
 #include "ColliderComponent.hpp"
 
 #include "../SceneComponent.hpp"
+#include "../Scene.hpp"
 
 namespace Aurora
 {
+	void ColliderComponent::BeginDestroy()
+	{
+		if (m_BroadphaseProxy != AABB_NULL_NODE && m_Scene)
+		{
+			m_Scene->GetPhysicsWorld().RemoveCollider(this);
+		}
+	}
+
 	AABB ColliderComponent::GetTransformedAABB() const
 	{
 		AABB bounds = GetAABB();
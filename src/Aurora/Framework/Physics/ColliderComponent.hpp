@@ -4,6 +4,8 @@
 #include "../Transform.hpp"
 #include "Aurora/Physics/AABB.hpp"
 #include "Aurora/Physics/Types.hpp"
+#include "Aurora/Physics/AABBTree.hpp"
+#include "Aurora/Framework/Layer.hpp"
 
 namespace Aurora
 {
@@ -12,10 +14,18 @@ namespace Aurora
 	protected:
 		AABB m_Bounds;
 		Vector3 m_Origin;
+		LayerEnum m_Layer;
+	private:
+		// Leaf of this collider in the physics world broadphase tree
+		NodeIndex_t m_BroadphaseProxy;
+
+		friend class PhysicsWorld;
 	public:
 		CLASS_OBJ(ColliderComponent, ActorComponent);
 
-		ColliderComponent() : m_Bounds(), m_Origin(0.0f) {}
+		ColliderComponent() : m_Bounds(), m_Origin(0.0f), m_Layer(Layer0), m_BroadphaseProxy(AABB_NULL_NODE) {}
+
+		void BeginDestroy() override;
 
 		virtual void GetAabb(const Transform& transform, phVector3& aabbMin, phVector3& aabbMax) const
 		{
@@ -33,6 +43,9 @@ namespace Aurora
 			center = (aabbMin + aabbMax) * phScalar(0.5);
 		}
 
+		inline void SetLayer(LayerEnum layer) { m_Layer = layer; }
+		[[nodiscard]] inline LayerEnum GetLayer() const { return m_Layer; }
+
 		inline void SetOrigin(const Vector3& origin) { m_Origin = origin; }
 		inline const Vector3& GetOrigin() const { return m_Origin; }
 		inline Vector3& GetOrigin() { return m_Origin; }
@@ -1,10 +1,14 @@
 #include "Scene.hpp"
+#include "Aurora/Engine.hpp"
 #include "Aurora/Core/Common.hpp"
+#include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Memory/FrameAllocator.hpp"
+#include "SkeletalMeshComponent.hpp"
 
 namespace Aurora
 {
 
-	Scene::Scene() : m_ActorMemory(), m_PhysicsWorld(this)
+	Scene::Scene() : m_ActorMemory(Aum::DefaultBlockSize, Aum::EMode::SizeClass), m_PhysicsWorld(this)
 	{
 		m_ActorMemory.SetName("Actors");
 	}
@@ -63,11 +67,86 @@ namespace Aurora
 			m_Actors[i]->Tick(delta);
 		}
 
-		for(ActorComponent* actorComponent : GetComponents<ActorComponent>())
+		// Destruction is deferred while ticking, so the array keeps its order. Components created by a tick start on the next frame.
+		m_ComponentStorage.BeginDeferredDestroy();
+
+		ComponentView<ActorComponent> components = GetComponents<ActorComponent>();
+		size_t componentCount = components.size();
+		for (size_t i = 0; i < componentCount; ++i)
 		{
-			actorComponent->Tick(delta);
+			ActorComponent* component = components[i];
+
+			if (m_ComponentStorage.IsPendingDestroy(component))
+				continue;
+
+			component->Tick(delta);
+		}
+
+		m_ComponentStorage.EndDeferredDestroy();
+
+		ComponentView<SkeletalMeshComponent> skeletalMeshComponents = GetComponents<SkeletalMeshComponent>();
+		if (!skeletalMeshComponents.empty())
+		{
+			FrameVector<SkeletalMeshComponent*> animatedComponents;
+			animatedComponents.reserve(skeletalMeshComponents.size());
+
+			for (SkeletalMeshComponent* component : skeletalMeshComponents)
+			{
+				animatedComponents.push_back(component);
+			}
+
+			SkeletalMeshComponent::UpdateAnimations(animatedComponents, delta, GEngine ? GEngine->GetJobSystem() : nullptr);
 		}
 
 		m_PhysicsWorld.Update(delta);
+
+		UpdateWorldTransforms();
+	}
+
+	void Scene::UpdateWorldTransforms()
+	{
+		CPU_DEBUG_SCOPE("Scene::UpdateWorldTransforms");
+
+		ComponentView<SceneComponent> components = GetComponents<SceneComponent>();
+
+		FrameVector<SceneComponent*> dirtyComponents;
+		FrameVector<uint32_t> depthOffsets;
+
+		for (SceneComponent* component : components)
+		{
+			if (not component->m_WorldMatrixDirty)
+				continue;
+
+			uint32_t depth = component->m_HierarchyDepth;
+
+			if (depth >= depthOffsets.size())
+				depthOffsets.resize(depth + 1, 0);
+
+			depthOffsets[depth]++;
+			dirtyComponents.push_back(component);
+		}
+
+		if (dirtyComponents.empty())
+			return;
+
+		// Counting sort by depth, so every parent is resolved before its children
+		uint32_t offset = 0;
+		for (uint32_t& depthOffset : depthOffsets)
+		{
+			uint32_t count = depthOffset;
+			depthOffset = offset;
+			offset += count;
+		}
+
+		FrameVector<SceneComponent*> sortedComponents(dirtyComponents.size());
+		for (SceneComponent* component : dirtyComponents)
+		{
+			sortedComponents[depthOffsets[component->m_HierarchyDepth]++] = component;
+		}
+
+		for (SceneComponent* component : sortedComponents)
+		{
+			component->UpdateWorldMatrix();
+		}
 	}
 }
\ No newline at end of file
@@ -78,7 +78,15 @@ namespace Aurora
 			return m_ComponentStorage.template FindFirstComponent<T>();
 		}
 
+		template<typename T, typename... With, typename Func, typename std::enable_if<std::is_base_of<ActorComponent, T>::value>::type* = nullptr>
+		void ForEachComponent(Func&& func)
+		{
+			m_ComponentStorage.template ForEach<T, With...>(std::forward<Func>(func));
+		}
+
 		void Update(double delta);
+		// Recomputes dirty world matrices, parents are always updated before their children
+		void UpdateWorldTransforms();
 
 	public:
 		void FinishSpawningActor(Actor* actor);
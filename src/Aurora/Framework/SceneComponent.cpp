@@ -4,14 +4,29 @@
 
 namespace Aurora
 {
-	SceneComponent::SceneComponent() : ActorComponent()
+	SceneComponent::SceneComponent() : ActorComponent(), m_WorldMatrix(glm::identity<Matrix4>()), m_WorldMatrixDirty(true), m_HierarchyDepth(0)
 	{
+		m_Transform.Owner = this;
+	}
+
+	const Matrix4& SceneComponent::GetTransformationMatrix() const
+	{
+		if (m_WorldMatrixDirty)
+		{
+			if (m_Parent)
+			{
+				m_Parent->GetTransformationMatrix();
+			}
 
+			UpdateWorldMatrix();
+		}
+
+		return m_WorldMatrix;
 	}
 
-	Matrix4 SceneComponent::GetTransformationMatrix() const
+	void SceneComponent::UpdateWorldMatrix() const
 	{
-		// TODO: Cache matrix and update it only when transform changes!
+		m_WorldMatrixDirty = false;
 
 		if(m_Parent)
 		{
@@ -21,13 +36,71 @@ namespace Aurora
 
 				if (socketIndex >= 0)
 				{
-					return m_Parent->GetTransformationMatrix() * m_Parent->GetSocketTransform(socketIndex) * m_Transform.GetTransform();
+					m_WorldMatrix = m_Parent->m_WorldMatrix * m_Parent->GetSocketTransform(socketIndex) * m_Transform.GetTransform();
+					return;
 				}
 			}
 
-			return m_Parent->GetTransformationMatrix() * m_Transform.GetTransform();
+			m_WorldMatrix = m_Parent->m_WorldMatrix * m_Transform.GetTransform();
+			return;
 		}
 
-		return m_Transform.GetTransform();
+		m_WorldMatrix = m_Transform.GetTransform();
+	}
+
+	void SceneComponent::MarkWorldTransformDirty()
+	{
+		if (m_WorldMatrixDirty)
+		{
+			return;
+		}
+
+		m_WorldMatrixDirty = true;
+
+		for (ActorComponent* component : m_Components)
+		{
+			if (SceneComponent* sceneComponent = SceneComponent::SafeCast(component))
+			{
+				sceneComponent->MarkWorldTransformDirty();
+			}
+		}
+	}
+
+	void SceneComponent::MarkSocketChildrenDirty()
+	{
+		for (ActorComponent* component : m_Components)
+		{
+			if (component->GetSocket().empty())
+			{
+				continue;
+			}
+
+			if (SceneComponent* sceneComponent = SceneComponent::SafeCast(component))
+			{
+				sceneComponent->MarkWorldTransformDirty();
+			}
+		}
+	}
+
+	void SceneComponent::OnAttachmentChanged()
+	{
+		UpdateHierarchyDepth();
+
+		// Children of a dirty component are dirty already, so force the propagation from here
+		m_WorldMatrixDirty = false;
+		MarkWorldTransformDirty();
+	}
+
+	void SceneComponent::UpdateHierarchyDepth()
+	{
+		m_HierarchyDepth = m_Parent ? m_Parent->m_HierarchyDepth + 1 : 0;
+
+		for (ActorComponent* component : m_Components)
+		{
+			if (SceneComponent* sceneComponent = SceneComponent::SafeCast(component))
+			{
+				sceneComponent->UpdateHierarchyDepth();
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -10,9 +10,14 @@ namespace Aurora
 	private:
 		Transform m_Transform;
 		std::vector<ActorComponent*> m_Components;
+		// Cached world matrix, it is dirty when this or any parent transform changed (dirty parent implies dirty children)
+		mutable Matrix4 m_WorldMatrix;
+		mutable bool m_WorldMatrixDirty;
+		uint32_t m_HierarchyDepth;
 	public:
 		friend class Actor;
 		friend class ActorComponent;
+		friend class Scene;
 
 		CLASS_OBJ(SceneComponent, ActorComponent);
 
@@ -26,7 +31,7 @@ namespace Aurora
 		[[nodiscard]] const Vector3& GetRotation() const { return m_Transform.GetRotation(); }
 		[[nodiscard]] const Vector3& GetScale() const { return m_Transform.GetScale(); }
 
-		[[nodiscard]] Matrix4 GetTransformationMatrix() const;
+		[[nodiscard]] const Matrix4& GetTransformationMatrix() const;
 		[[nodiscard]] Vector3 GetWorldPosition() const { return GetTransformationMatrix()[3]; }
 		[[nodiscard]] Vector3 GetForwardVector() const { return GetTransformationMatrix()[2]; }
 		[[nodiscard]] Vector3 GetUpVector() const { return GetTransformationMatrix()[1]; }
@@ -36,6 +41,12 @@ namespace Aurora
 
 		virtual Matrix4 GetSocketTransform(int32_t socketId) const { return glm::identity<Matrix4>(); }
 
+		void MarkWorldTransformDirty();
+		// Needs to be called when socket transforms change, e.g. after animation update
+		void MarkSocketChildrenDirty();
+		[[nodiscard]] bool IsWorldTransformDirty() const { return m_WorldMatrixDirty; }
+		[[nodiscard]] uint32_t GetHierarchyDepth() const { return m_HierarchyDepth; }
+
 		template<typename T>
 		bool GetComponentsOfType(std::vector<T*>& components)
 		{
@@ -61,5 +72,11 @@ namespace Aurora
 
 			return !components.empty();
 		}
+	protected:
+		void OnAttachmentChanged() override;
+	private:
+		// Expects the parent world matrix to be up-to-date
+		void UpdateWorldMatrix() const;
+		void UpdateHierarchyDepth();
 	};
 }
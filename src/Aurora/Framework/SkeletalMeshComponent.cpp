@@ -1,159 +1,96 @@
 #include "SkeletalMeshComponent.hpp"
 #include "Aurora/Engine.hpp"
+#include "Aurora/Core/JobSystem.hpp"
+#include "Aurora/Core/Profiler.hpp"
 #include "Aurora/Graphics/Base/IRenderDevice.hpp"
+#include "Aurora/Memory/FrameAllocator.hpp"
 
 using namespace Aurora::Animation;
 
 namespace Aurora
 {
-	const AnimationChannel* FindChannel(const FAnimation& animation, const Bone& bone)
-	{
-		for (auto& channel : animation.Channels)
-		{
-			if (channel.Index == bone.Index)
-			{
-				return &channel;
-			}
-		}
+	// Characters evaluated by one job
+	static constexpr uint32_t AnimationBatchSize = 16;
 
-		return nullptr;
-	}
-
-	Vector3 Interpolate(const Vector3& start, const Vector3& end, double factor)
+	bool SkeletalMeshComponent::EvaluateAnimation(double delta)
 	{
-		return start + (float)factor * (end - start);
-	}
+		if (m_Mesh == nullptr || m_Mesh->Animations.empty())
+			return false;
 
-	Quaternion Interpolate(Quaternion a, Quaternion b, double factor)
-	{
-		float blend = (float)factor;
+		if (SelectedAnimation < 0 || SelectedAnimation >= (int32_t)m_Mesh->CompiledAnimations.size())
+			return false;
 
-		a = glm::normalize(a);
-		b = glm::normalize(b);
+		const CompiledAnimationClip& animation = m_Mesh->CompiledAnimations[SelectedAnimation];
+		EvaluatePose(m_Mesh->CompiledSkeleton, animation, AnimationTime, m_AnimationCursor, Bones);
 
-		/*Quaternion result;
-		float dot_product = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
-		float one_minus_blend = 1.0f - blend;
+		if (Playing)
+			AnimationTime += delta * animation.TicksPerSecond;
 
-		if (dot_product < 0.0f)
+		if (AnimationLooping)
 		{
-			result.x = a.x * one_minus_blend + blend * -b.x;
-			result.y = a.y * one_minus_blend + blend * -b.y;
-			result.z = a.z * one_minus_blend + blend * -b.z;
-			result.w = a.w * one_minus_blend + blend * -b.w;
+			AnimationTime = std::fmod(AnimationTime, animation.Duration);
 		}
 		else
 		{
-			result.x = a.x * one_minus_blend + blend * b.x;
-			result.y = a.y * one_minus_blend + blend * b.y;
-			result.z = a.z * one_minus_blend + blend * b.z;
-			result.w = a.w * one_minus_blend + blend * b.w;
-		}
-
-		return glm::normalize(result);*/
-
-		return glm::slerp(a, b, blend);
-	}
-
-	template<typename T>
-	T InterpolateChannel(double time, const std::vector<AnimationKey<T>>& channelData)
-	{
-		if (channelData.empty())
-		{
-			return T();
-		}
-
-		if (channelData.size() == 1)
-		{
-			return channelData[0].Value;
-		}
-
-		int channelIndex = 0;
+			AnimationTime = glm::clamp<double>(AnimationTime, 0, animation.Duration);
 
-		for (int i = 1; i < channelData.size(); ++i)
-		{
-			if (channelData[i].Time > time)
+			if (AnimationTime >= animation.Duration)
 			{
-				channelIndex = i - 1;
-				break;
+				Playing = false;
+				AnimationTime = 0;
 			}
 		}
 
-		int nextChannelIndex = channelIndex + 1;
-		if (nextChannelIndex >= channelData.size())
-		{
-			std::cerr << "Next channel index(" << nextChannelIndex << ") not found!" << std::endl;
-			return channelData[channelIndex].Value;
-		}
-
-		double delta_time = channelData[nextChannelIndex].Time - channelData[channelIndex].Time;
-		double factor = (time - channelData[channelIndex].Time) / delta_time;
-
-		factor = glm::abs(factor);
+		return true;
+	}
 
-		T start = channelData[channelIndex].Value;
-		T end = channelData[nextChannelIndex].Value;
+	void SkeletalMeshComponent::UpdateAnimation(double delta)
+	{
+		if (m_Mesh != nullptr && !m_Mesh->Animations.empty())
+			m_Mesh->EnsureCompiledAnimations();
 
-		return Interpolate(start, end, factor);
+		if (EvaluateAnimation(delta))
+			MarkSocketChildrenDirty();
 	}
 
-	void TransformBonesSingleAnimation(const FAnimation& animation, const Matrix4& globalInverseTransform, double time, const Bone& bone, glm::mat4 parentTransform, Matrix4* transforms)
+	void SkeletalMeshComponent::UpdateAnimations(std::span<SkeletalMeshComponent* const> components, double delta, JobSystem* jobSystem)
 	{
-		const AnimationChannel* channel = FindChannel(animation, bone);
+		CPU_DEBUG_SCOPE("SkeletalMeshComponent::UpdateAnimations");
 
-		Matrix4 bone_transformation(1.0f);
+		if (components.empty())
+			return;
 
-		if (channel)
+		// Meshes are shared, so they are compiled before any evaluation runs in parallel
+		for (SkeletalMeshComponent* component : components)
 		{
-			Vector3 position = InterpolateChannel(time, channel->PositionKeys);
-			Quaternion rotation = InterpolateChannel(time, channel->RotationKeys);
-			Vector3 scale = InterpolateChannel(time, channel->ScaleKeys);
-
-			bone_transformation = glm::translate(position) * Matrix4(rotation) * glm::scale(scale);
+			if (component->m_Mesh != nullptr && !component->m_Mesh->Animations.empty())
+				component->m_Mesh->EnsureCompiledAnimations();
 		}
 
-		Matrix4 global_transformation = parentTransform * bone_transformation;
-
-		transforms[bone.Index] = globalInverseTransform * global_transformation * bone.OffsetMatrix;
-
-		for (Bone* child : bone.Children)
-		{
-			TransformBonesSingleAnimation(animation, globalInverseTransform, time, *child, global_transformation, transforms);
-		}
-	}
+		FrameVector<uint8_t> evaluated(components.size(), 0);
 
-	void TransformBonesSingleAnimation(const Armature& armature, const FAnimation& animation, double time, Matrix4* transforms)
-	{
-		for (Bone* bone : armature.RootBones)
+		auto evaluate = [&components, &evaluated, delta](uint32_t begin, uint32_t end)
 		{
-			TransformBonesSingleAnimation(animation, armature.GlobalInverseTransform, time, *bone, glm::identity<Matrix4>(), transforms);
-		}
-	}
-
-	void SkeletalMeshComponent::Tick(double delta)
-	{
-		if (m_Mesh->Animations.empty())
-			return;
-
-		const FAnimation& animation = m_Mesh->Animations[SelectedAnimation];
-		TransformBonesSingleAnimation(GetSkeletalMesh()->Armature, animation, AnimationTime, Bones);
-
-		if (Playing)
-			AnimationTime += delta * animation.TicksPerSecond;
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				evaluated[i] = components[i]->EvaluateAnimation(delta) ? 1 : 0;
+			}
+		};
 
-		if (AnimationLooping)
+		if (jobSystem && components.size() > AnimationBatchSize)
 		{
-			AnimationTime = std::fmod(AnimationTime, animation.Duration);
+			jobSystem->ParallelFor((uint32_t)components.size(), AnimationBatchSize, evaluate);
 		}
 		else
 		{
-			AnimationTime = glm::clamp<double>(AnimationTime, 0, animation.Duration);
+			evaluate(0, (uint32_t)components.size());
+		}
 
-			if (AnimationTime >= animation.Duration)
-			{
-				Playing = false;
-				AnimationTime = 0;
-			}
+		// Dirty propagation walks the attachment hierarchy, which is not safe to do from several threads
+		for (size_t i = 0; i < components.size(); ++i)
+		{
+			if (evaluated[i])
+				components[i]->MarkSocketChildrenDirty();
 		}
 	}
 
@@ -1,14 +1,18 @@
 #pragma once
 
+#include <span>
 #include "MeshComponent.hpp"
 
 namespace Aurora
 {
+class JobSystem;
+
 class AU_API SkeletalMeshComponent : public MeshComponent
 {
 private:
 	SkeletalMesh_ptr m_Mesh = nullptr;
 	Matrix4 Bones[MAX_BONES];
+	Animation::AnimationCursor m_AnimationCursor;
 public:
 	CLASS_OBJ(SkeletalMeshComponent, MeshComponent);
 
@@ -21,9 +25,14 @@ public:
 	[[nodiscard]] const SkeletalMesh_ptr& GetSkeletalMesh() const { return m_Mesh; }
 	[[nodiscard]] bool HasMesh() const override { return m_Mesh != nullptr; }
 
-	void Tick(double delta) override;
 	void UploadAnimation(Buffer_ptr& buffer) override;
 
+	// Samples the selected animation into the bone transforms and advances the animation time
+	void UpdateAnimation(double delta);
+	// Same as UpdateAnimation for every component, poses are evaluated in parallel when a job system is given.
+	// Scene updates all its skeletal meshes with this after ticking components.
+	static void UpdateAnimations(std::span<SkeletalMeshComponent* const> components, double delta, JobSystem* jobSystem = nullptr);
+
 	void Play(int32_t animationIndex, bool loop)
 	{
 		SelectedAnimation = animationIndex;
@@ -65,5 +74,8 @@ public:
 	}
 
 	[[nodiscard]] TTypeID GetSupportedMeshType() const override { return SkeletalMesh::TypeID(); }
+private:
+	// Thread safe as long as meshes are compiled, returns false when there was nothing to evaluate
+	bool EvaluateAnimation(double delta);
 };
 }
\ No newline at end of file
@@ -1,7 +1,40 @@
 #include "Transform.hpp"
+#include "SceneComponent.hpp"
 
 namespace Aurora
 {
+	Transform::Transform(const Transform& other) :
+		Location(other.Location),
+		Rotation(other.Rotation),
+		EulerRotation(other.EulerRotation),
+		Scale(other.Scale),
+		TransformMatrix(other.TransformMatrix),
+		NeedsUpdateMatrix(other.NeedsUpdateMatrix),
+		Owner(nullptr)
+	{
+
+	}
+
+	Transform& Transform::operator=(const Transform& other)
+	{
+		Location = other.Location;
+		Rotation = other.Rotation;
+		EulerRotation = other.EulerRotation;
+		Scale = other.Scale;
+		TransformMatrix = other.TransformMatrix;
+		NeedsUpdateMatrix = other.NeedsUpdateMatrix;
+		NotifyOwner();
+		return *this;
+	}
+
+	void Transform::NotifyOwner()
+	{
+		if (Owner)
+		{
+			Owner->MarkWorldTransformDirty();
+		}
+	}
+
 	void Transform::UpdateRotationFromEuler()
 	{
 		glm::quat qYaw = glm::angleAxis(glm::radians(EulerRotation.x), glm::vec3(1, 0, 0));
@@ -62,6 +95,7 @@ namespace Aurora
 		EulerRotation = glm::degrees(glm::eulerAngles(Rotation));
 		TransformMatrix = mat;
 		NeedsUpdateMatrix = false;
+		NotifyOwner();
 	}
 
 	void Transform::SetFromMatrixNoScale(const Matrix4& mat)
@@ -73,5 +107,6 @@ namespace Aurora
 		EulerRotation = glm::degrees(glm::eulerAngles(Rotation));
 		TransformMatrix = mat;
 		NeedsUpdateMatrix = false;
+		NotifyOwner();
 	}
 }
\ No newline at end of file
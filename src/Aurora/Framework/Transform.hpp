@@ -4,8 +4,11 @@
 
 namespace Aurora
 {
+	class SceneComponent;
+
 	class AU_API Transform
 	{
+		friend class SceneComponent;
 	public:
 		enum class Space
 		{
@@ -18,12 +21,16 @@ namespace Aurora
 		Vector3 Scale = { 1.0f, 1.0f, 1.0f };
 		mutable Matrix4 TransformMatrix = glm::identity<Matrix4>();
 		mutable bool NeedsUpdateMatrix = true;
+		// Component whose cached world matrix depends on this transform, never copied with the transform
+		SceneComponent* Owner = nullptr;
 	public:
 		Transform() = default;
-		Transform(const Transform& other) = default;
+		Transform(const Transform& other);
 		explicit Transform(const glm::vec3& location) : Location(location) {}
 
-		void MarkForUpdate() { NeedsUpdateMatrix = true; }
+		Transform& operator=(const Transform& other);
+
+		void MarkForUpdate() { NeedsUpdateMatrix = true; NotifyOwner(); }
 
 		void UpdateRotationFromEuler();
 
@@ -62,5 +69,7 @@ namespace Aurora
 		[[nodiscard]] Vector3D GetForwardVector() const { return GetTransform()[2]; }
 		[[nodiscard]] Vector3D GetUpVector() const { return GetTransform()[1]; }
 		[[nodiscard]] Vector3D GetLeftVector() const { return GetTransform()[0]; }
+	private:
+		void NotifyOwner();
 	};
 }
\ No newline at end of file
@@ -68,5 +68,13 @@ namespace Aurora
 		  ColorWriteEnable(EColorMask::All),
 		  BlendFactor(0, 0, 0, 0),
 		  AlphaToCoverage(false) { }
+
+		bool operator==(const FBlendState& other) const
+		{
+			return Enabled == other.Enabled &&
+				SrcBlend == other.SrcBlend && DestBlend == other.DestBlend && BlendOp == other.BlendOp &&
+				SrcBlendAlpha == other.SrcBlendAlpha && DestBlendAlpha == other.DestBlendAlpha && BlendOpAlpha == other.BlendOpAlpha &&
+				ColorWriteEnable == other.ColorWriteEnable && BlendFactor.rgba == other.BlendFactor.rgba && AlphaToCoverage == other.AlphaToCoverage;
+		}
 	};
 }
\ No newline at end of file
@@ -42,6 +42,12 @@ namespace Aurora
 			EStencilOp StencilDepthFailOp;
 			EStencilOp StencilPassOp;
 			EComparisonFunc StencilFunc;
+
+			bool operator==(const StencilOpDesc& other) const
+			{
+				return StencilFailOp == other.StencilFailOp && StencilDepthFailOp == other.StencilDepthFailOp &&
+					StencilPassOp == other.StencilPassOp && StencilFunc == other.StencilFunc;
+			}
 		};
 
 		bool            DepthEnable;
@@ -73,5 +79,14 @@ namespace Aurora
 			FrontFace = stencilOpDesc;
 			BackFace = stencilOpDesc;
 		}
+
+		// Padding is not compared
+		bool operator==(const FDepthStencilState& other) const
+		{
+			return DepthEnable == other.DepthEnable && DepthWriteMask == other.DepthWriteMask && DepthFunc == other.DepthFunc &&
+				StencilEnable == other.StencilEnable && StencilReadMask == other.StencilReadMask &&
+				StencilWriteMask == other.StencilWriteMask && StencilRefValue == other.StencilRefValue &&
+				FrontFace == other.FrontFace && BackFace == other.BackFace;
+		}
 	};
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 
 namespace Aurora
@@ -40,4 +41,54 @@ namespace Aurora
 		X24G8_UINT,
 		D32,
 	};
+
+	// Bytes of one pixel, 0 for unknown formats
+	inline uint32_t GetFormatPixelSize(GraphicsFormat format)
+	{
+		switch (format)
+		{
+			case GraphicsFormat::R8_UINT:
+			case GraphicsFormat::R8_UNORM:
+				return 1;
+			case GraphicsFormat::RG8_UINT:
+			case GraphicsFormat::RG8_UNORM:
+			case GraphicsFormat::R16_UINT:
+			case GraphicsFormat::R16_UNORM:
+			case GraphicsFormat::R16_FLOAT:
+			case GraphicsFormat::D16:
+				return 2;
+			case GraphicsFormat::RGB8_UNORM:
+				return 3;
+			case GraphicsFormat::RGBA8_UNORM:
+			case GraphicsFormat::BGRA8_UNORM:
+			case GraphicsFormat::SRGBA8_UNORM:
+			case GraphicsFormat::R10G10B10A2_UNORM:
+			case GraphicsFormat::R11G11B10_FLOAT:
+			case GraphicsFormat::RG16_UINT:
+			case GraphicsFormat::RG16_FLOAT:
+			case GraphicsFormat::R32_UINT:
+			case GraphicsFormat::R32_FLOAT:
+			case GraphicsFormat::D24S8:
+			case GraphicsFormat::X24G8_UINT:
+			case GraphicsFormat::D32:
+				return 4;
+			case GraphicsFormat::RGB16_FLOAT:
+				return 6;
+			case GraphicsFormat::RGBA16_FLOAT:
+			case GraphicsFormat::RGBA16_UNORM:
+			case GraphicsFormat::RGBA16_SNORM:
+			case GraphicsFormat::RG32_UINT:
+			case GraphicsFormat::RG32_FLOAT:
+			case GraphicsFormat::RGBA16_UINT:
+				return 8;
+			case GraphicsFormat::RGB32_UINT:
+			case GraphicsFormat::RGB32_FLOAT:
+				return 12;
+			case GraphicsFormat::RGBA32_UINT:
+			case GraphicsFormat::RGBA32_FLOAT:
+				return 16;
+			default:
+				return 0;
+		}
+	}
 }
\ No newline at end of file
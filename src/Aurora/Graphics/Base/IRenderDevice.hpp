@@ -301,45 +301,108 @@ namespace Aurora
 		}
 	};
 
+	// Fixed size table of resources keyed by the hashed name of the shader variable, bind with "u_Name"_HASH.
+	// The slots are filled in bind order and searched linearly, which for the handful of resources a draw uses
+	// is cheaper than hashing a string and never allocates.
+	template<typename T, uint8_t Capacity>
+	struct ResourceBindingSlots
+	{
+		std::array<TTypeID, Capacity> Names{};
+		std::array<T, Capacity> Bindings{};
+		uint8_t Count = 0;
+
+		inline void Set(TTypeID name, const T& binding)
+		{
+			for (uint8_t slot = 0; slot < Count; ++slot)
+			{
+				if (Names[slot] == name)
+				{
+					Bindings[slot] = binding;
+					return;
+				}
+			}
+
+			if (Count == Capacity)
+			{
+				AU_LOG_ERROR("Cannot bind resource ", name, ", all ", (int)Capacity, " slots are used !");
+				return;
+			}
+
+			Names[Count] = name;
+			Bindings[Count] = binding;
+			Count++;
+		}
+
+		[[nodiscard]] inline const T* Find(TTypeID name) const
+		{
+			for (uint8_t slot = 0; slot < Count; ++slot)
+			{
+				if (Names[slot] == name)
+				{
+					return &Bindings[slot];
+				}
+			}
+
+			return nullptr;
+		}
+
+		// Drops the references too, so a reused state does not keep resources alive
+		inline void Clear()
+		{
+			for (uint8_t slot = 0; slot < Count; ++slot)
+			{
+				Bindings[slot] = T();
+			}
+
+			Count = 0;
+		}
+
+		[[nodiscard]] inline uint8_t Size() const noexcept { return Count; }
+		[[nodiscard]] inline bool Empty() const noexcept { return Count == 0; }
+	};
+
 	struct StateResources
 	{
-		static constexpr uint8_t MaxBoundTextures = 8;
+		static constexpr uint8_t MaxBoundTextures = 16;
+		static constexpr uint8_t MaxBoundSamplers = 16;
+		static constexpr uint8_t MaxBoundUniformBuffers = 16;
+		static constexpr uint8_t MaxBoundSSBOBuffers = 8;
 
-		robin_hood::unordered_map<std::string, TextureBinding> BoundTextures{};
-		robin_hood::unordered_map<std::string, Sampler_ptr> BoundSamplers{};
-		robin_hood::unordered_map<std::string, BufferBinding> BoundUniformBuffers{};
-		robin_hood::unordered_map<std::string, BufferBinding> SSBOBuffers{};
+		ResourceBindingSlots<TextureBinding, MaxBoundTextures> BoundTextures{};
+		ResourceBindingSlots<Sampler_ptr, MaxBoundSamplers> BoundSamplers{};
+		ResourceBindingSlots<BufferBinding, MaxBoundUniformBuffers> BoundUniformBuffers{};
+		ResourceBindingSlots<BufferBinding, MaxBoundSSBOBuffers> SSBOBuffers{};
 
 		UniformResources Uniforms;
 
 		virtual void ResetResources()
 		{
-			BoundTextures.clear();
-			BoundSamplers.clear();
-			BoundUniformBuffers.clear();
-			SSBOBuffers.clear();
+			BoundTextures.Clear();
+			BoundSamplers.Clear();
+			BoundUniformBuffers.Clear();
+			SSBOBuffers.Clear();
 
 			Uniforms.ResetResources();
 		}
 
-		inline void BindTexture(const std::string& name, const Texture_ptr& texture, bool isUAV = false, TextureBinding::EAccess access = TextureBinding::EAccess::Write, int mipLevel = 0)
+		inline void BindTexture(TTypeID name, const Texture_ptr& texture, bool isUAV = false, TextureBinding::EAccess access = TextureBinding::EAccess::Write, int mipLevel = 0)
 		{
-			BoundTextures[name] = TextureBinding(texture, isUAV, access, mipLevel);
+			BoundTextures.Set(name, TextureBinding(texture, isUAV, access, mipLevel));
 		}
 
-		inline void BindSampler(const std::string& name, const Sampler_ptr& sampler)
+		inline void BindSampler(TTypeID name, const Sampler_ptr& sampler)
 		{
-			BoundSamplers[name] = sampler;
+			BoundSamplers.Set(name, sampler);
 		}
 
-		inline void BindUniformBuffer(const std::string& name, const Buffer_ptr& uniformBuffer, uint32_t offset = 0, uint32_t size = 0)
+		inline void BindUniformBuffer(TTypeID name, const Buffer_ptr& uniformBuffer, uint32_t offset = 0, uint32_t size = 0)
 		{
-			BoundUniformBuffers[name] = {uniformBuffer, offset, size};
+			BoundUniformBuffers.Set(name, {uniformBuffer, offset, size});
 		}
 
-		inline void BindSSBOBuffer(const std::string& name, const Buffer_ptr& ssbo, uint32_t offset = 0, uint32_t size = 0)
+		inline void BindSSBOBuffer(TTypeID name, const Buffer_ptr& ssbo, uint32_t offset = 0, uint32_t size = 0)
 		{
-			SSBOBuffers[name] = {ssbo, offset, size};
+			SSBOBuffers.Set(name, {ssbo, offset, size});
 		}
 	};
 
@@ -574,6 +637,12 @@ namespace Aurora
 
 		virtual void UnmapBuffer(const Buffer_ptr& buffer) = 0;
 		inline Buffer_ptr CreateBuffer(const BufferDesc& desc) { return CreateBuffer(desc, nullptr); }
+		// Fences for persistently mapped (DMA) buffers. Lock a range after the commands reading it were submitted,
+		// wait for it before the CPU writes there again.
+		virtual void LockBufferRange(const Buffer_ptr& buffer, size_t offset, size_t size) = 0;
+		virtual void WaitForBufferRange(const Buffer_ptr& buffer, size_t offset, size_t size) = 0;
+		[[nodiscard]] virtual uint32_t GetUniformBufferOffsetAlignment() const = 0;
+		[[nodiscard]] virtual uint32_t GetStorageBufferOffsetAlignment() const = 0;
 		// Samplers
 		virtual Sampler_ptr CreateSampler(const SamplerDesc& desc) = 0;
 		// InputLayout
@@ -581,7 +650,8 @@ namespace Aurora
 		// Drawing
 		virtual void Draw(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState = true) = 0;
 		virtual void DrawIndexed(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState = true) = 0;
-		virtual void DrawIndirect(const DrawCallState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes) = 0;
+		// Multi draw of drawCount DrawElementsIndirectCommands from offsetBytes, with the index buffer of the state
+		virtual void DrawIndirect(const DrawCallState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes, uint32_t drawCount = 1) = 0;
 
 		virtual void Dispatch(const DispatchState& state, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) = 0;
 		virtual void DispatchIndirect(const DispatchState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes) = 0;
@@ -604,6 +674,10 @@ namespace Aurora
 		virtual void ClearRenderTargets(const DrawCallState &state) = 0;
 		virtual void SetDepthStencilState(FDepthStencilState state) = 0;
 
+		// Debug groups, shown by graphics debuggers
+		virtual void PushDebugGroup(const char* name) = 0;
+		virtual void PopDebugGroup() = 0;
+
 		virtual size_t GetUsedGPUMemory() = 0;
 
 		[[nodiscard]] inline const FrameRenderStatistics& GetFrameRenderStatistics() const { return m_FrameRenderStatistics; }
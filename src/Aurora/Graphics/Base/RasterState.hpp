@@ -41,5 +41,14 @@ namespace Aurora
 		  DepthBiasClamp(0),
 		  SlopeScaledDepthBias(0),
 		  LineWidth(1.0f) { }
+
+		bool operator==(const FRasterState& other) const
+		{
+			return FillMode == other.FillMode && CullMode == other.CullMode &&
+				FrontCounterClockwise == other.FrontCounterClockwise && DepthClipEnable == other.DepthClipEnable &&
+				ScissorEnable == other.ScissorEnable && MultisampleEnable == other.MultisampleEnable &&
+				DepthBias == other.DepthBias && DepthBiasClamp == other.DepthBiasClamp &&
+				SlopeScaledDepthBias == other.SlopeScaledDepthBias && LineWidth == other.LineWidth;
+		}
 	};
 }
\ No newline at end of file
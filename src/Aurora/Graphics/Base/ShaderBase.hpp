@@ -10,6 +10,7 @@
 #include "InputLayout.hpp"
 #include "TypeBase.hpp"
 #include "Aurora/Core/Types.hpp"
+#include "Aurora/Core/Hash.hpp"
 #include "Aurora/Logger/Logger.hpp"
 
 namespace Aurora
@@ -187,6 +188,9 @@ namespace Aurora
 	{
 		std::string Name;
 
+		/// Hash_djb2 of the name, resources are bound to a state by it
+		TTypeID NameID = 0;
+
 		/// Shader resource type
 		ShaderResourceType Type = ShaderResourceType::Unknown;
 
@@ -1,111 +1,62 @@
 #include "BufferCache.hpp"
 #include "Base/IRenderDevice.hpp"
-#include "Aurora/Core/String.hpp"
+#include "Aurora/Logger/Logger.hpp"
 
 namespace Aurora
 {
-
-	BufferCache::BufferCache(IRenderDevice* renderDevice, EBufferType bufferType, uint numberOfBuffers, uint singleBufferSize, bool useGpuMapping)
-			: m_RenderDevice(renderDevice),
-			m_NumBuffers(numberOfBuffers),
-			m_Buffers(numberOfBuffers),
-			m_SingleBufferSize(singleBufferSize),
-			m_CurrentOffset(0),
-			m_CurrentBuffer(0),
-			m_NumBytesPerFrame(0),
-			m_UseGpuMapping(useGpuMapping)
+	static uint GetDefaultAlignment(IRenderDevice* renderDevice, EBufferType bufferType)
 	{
-		for (int i = 0; i < numberOfBuffers; ++i)
-		{
-			m_Buffers[i] = renderDevice->CreateBuffer(BufferDesc("BufferCache #" + std::to_string(i), singleBufferSize, bufferType));
-		}
-
-		if(!m_UseGpuMapping)
+		switch (bufferType)
 		{
-			m_LocalMappedMemory = new uint8_t[numberOfBuffers * singleBufferSize];
+			case EBufferType::UniformBuffer:
+				return renderDevice->GetUniformBufferOffsetAlignment();
+			case EBufferType::ShaderStorageBuffer:
+				return renderDevice->GetStorageBufferOffsetAlignment();
+			default:
+				return 16;
 		}
 	}
 
-	BufferCache::~BufferCache()
+	BufferCache::BufferCache(IRenderDevice* renderDevice, const String& name, EBufferType bufferType, uint frameSize, uint framesInFlight)
+			: m_RenderDevice(renderDevice),
+			m_Buffer(nullptr),
+			m_MappedMemory(nullptr),
+			m_Allocator(frameSize, framesInFlight),
+			m_DefaultAlignment(GetDefaultAlignment(renderDevice, bufferType))
 	{
-		delete[] m_LocalMappedMemory;
+		// DMA buffers are mapped persistent and coherent for their whole life
+		m_Buffer = renderDevice->CreateBuffer(BufferDesc(name, m_Allocator.GetTotalSize(), bufferType, EBufferUsage::DynamicDraw, true));
+		m_MappedMemory = renderDevice->MapBuffer(m_Buffer, EBufferAccess::WriteOnly);
 	}
 
-	uint8* BufferCache::GetOrMap(uint size, VBufferCacheIndex &bufferCacheIndex)
+	uint8* BufferCache::GetOrMap(uint size, uint alignment, VBufferCacheIndex &bufferCacheIndex)
 	{
-		if(size > m_SingleBufferSize)
-		{
-			AU_LOG_WARNING("Cannot write ", FormatBytes(size), " to cache with max size ", FormatBytes(m_SingleBufferSize), " !");
-			return nullptr;
-		}
-
-		uint freeSpace = m_SingleBufferSize - m_CurrentOffset;
-
-		if(size <= freeSpace && m_CurrentBuffer < m_NumBuffers)
-		{ // Free space, get memory and advance
-			bufferCacheIndex.Offset = m_CurrentOffset;
-			bufferCacheIndex.BufferIndex = m_CurrentBuffer;
-			bufferCacheIndex.Size = size;
-			bufferCacheIndex.Buffer = m_Buffers[bufferCacheIndex.BufferIndex];
-
-			m_CurrentOffset += std::max(size, 256u);
-
-			if(freeSpace == size)
-			{ // If we fill whole buffer we advance to another
-				m_CurrentOffset = 0;
-				m_CurrentBuffer += 1;
-			}
-
-			m_NumBytesPerFrame += size;
+		StreamingAllocation allocation = {};
 
-			size_t offset = bufferCacheIndex.BufferIndex * m_SingleBufferSize + bufferCacheIndex.Offset;
-			if(m_UseGpuMapping)
-			{
-				return reinterpret_cast<uint8_t*>(m_RenderDevice->MapBuffer(bufferCacheIndex.Buffer, EBufferAccess::WriteOnly)) + offset;
-			}
-			else
+		if(m_MappedMemory == nullptr || !m_Allocator.Allocate(size, alignment, allocation))
+		{
+			// Only the first one, a full region fails everything until the end of the frame
+			if(m_Allocator.GetFailedAllocations() == 1)
 			{
-				return &m_LocalMappedMemory[offset];
+				AU_LOG_WARNING(m_Buffer->GetDesc().Name, " is out of memory, ", FormatBytes(m_Allocator.GetRegionSize()), " per frame is not enough !");
 			}
-		}
-		else if(m_CurrentBuffer < m_NumBuffers - 1)
-		{ // No free space, need to cache remaining and advance buffer
-			AU_LOG_WARNING(FormatBytes(freeSpace), " bytes was skipped at the end of BufferCache !");
-			m_CurrentOffset = std::max(size, 256u);
-			m_CurrentBuffer += 1;
 
-			bufferCacheIndex.Offset = m_CurrentOffset;
-			bufferCacheIndex.BufferIndex = m_CurrentBuffer;
-			bufferCacheIndex.Size = size;
-			bufferCacheIndex.Buffer = m_Buffers[bufferCacheIndex.BufferIndex];
-
-			m_NumBytesPerFrame += size;
-
-			return m_RenderDevice->MapBuffer(bufferCacheIndex.Buffer, EBufferAccess::WriteOnly);
-		}
-		else
-		{ // We are at the end of max memory, throw an error
-			AU_LOG_WARNING("BufferCache memory at maximum ", FormatBytes(m_NumBuffers * m_SingleBufferSize), " !");
+			return nullptr;
 		}
 
-		return nullptr;
+		bufferCacheIndex.Offset = allocation.Offset;
+		bufferCacheIndex.Size = allocation.Size;
+		bufferCacheIndex.Buffer = m_Buffer;
+
+		return m_MappedMemory + allocation.Offset;
 	}
 
-	void BufferCache::Unmap(VBufferCacheIndex &bufferCacheIndex)
+	void BufferCache::OnFrameEnd()
 	{
-		if(bufferCacheIndex.Buffer == nullptr)
-		{
-			return;
-		}
+		uint32_t regionSize = m_Allocator.GetRegionSize();
 
-		if(m_UseGpuMapping)
-		{
-			m_RenderDevice->UnmapBuffer(bufferCacheIndex.Buffer);
-		}
-		else
-		{
-			size_t offset = bufferCacheIndex.BufferIndex * m_SingleBufferSize + bufferCacheIndex.Offset;
-			m_RenderDevice->WriteBuffer(bufferCacheIndex.Buffer, &m_LocalMappedMemory[offset], bufferCacheIndex.Size, offset);
-		}
+		m_RenderDevice->LockBufferRange(m_Buffer, m_Allocator.GetRegionStart(m_Allocator.GetCurrentRegion()), regionSize);
+		uint32_t nextRegion = m_Allocator.NextRegion();
+		m_RenderDevice->WaitForBufferRange(m_Buffer, m_Allocator.GetRegionStart(nextRegion), regionSize);
 	}
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Aurora/Core/Types.hpp"
+#include "Aurora/Core/String.hpp"
 #include "Aurora/Graphics/Base/Buffer.hpp"
+#include "StreamingRingAllocator.hpp"
 
 namespace Aurora
 {
@@ -11,30 +13,34 @@ namespace Aurora
 	{
 		uint Offset;
 		uint Size;
-		uint BufferIndex;
 		Buffer_ptr Buffer;
 
-		VBufferCacheIndex() : Offset(0), Size(0), BufferIndex(0), Buffer(nullptr)
+		VBufferCacheIndex() : Offset(0), Size(0), Buffer(nullptr)
 		{}
 	};
 
+	// Streams data that changes every frame (uniforms, instances, debug vertices) through one persistently mapped buffer.
+	// The buffer holds a region per frame in flight. A region is fenced at the end of the frame that wrote it and waited on
+	// before it is written again, so writes never stall on the driver and never touch data the GPU has not read yet.
 	class AU_API BufferCache
 	{
 	private:
 		IRenderDevice* m_RenderDevice;
-		std::vector<Buffer_ptr> m_Buffers;
-		uint m_NumBuffers;
-		uint m_SingleBufferSize;
-		uint m_CurrentOffset;
-		uint m_CurrentBuffer;
-		uint m_NumBytesPerFrame;
-		bool m_UseGpuMapping;
-		uint8_t* m_LocalMappedMemory;
+		Buffer_ptr m_Buffer;
+		uint8_t* m_MappedMemory;
+		StreamingRingAllocator m_Allocator;
+		uint m_DefaultAlignment;
 	public:
-		BufferCache(IRenderDevice* renderDevice, EBufferType bufferType, uint numberOfBuffers, uint singleBufferSize, bool useGpuMapping);
-		~BufferCache();
+		BufferCache(IRenderDevice* renderDevice, const String& name, EBufferType bufferType, uint frameSize, uint framesInFlight = 3);
+		~BufferCache() = default;
 
-		uint8* GetOrMap(uint size, VBufferCacheIndex& bufferCacheIndex);
+		// Memory is valid until the end of the frame, returns nullptr when the frame region is full
+		uint8* GetOrMap(uint size, uint alignment, VBufferCacheIndex& bufferCacheIndex);
+
+		uint8* GetOrMap(uint size, VBufferCacheIndex& bufferCacheIndex)
+		{
+			return GetOrMap(size, m_DefaultAlignment, bufferCacheIndex);
+		}
 
 		template<typename T>
 		T* GetOrMap(uint size, VBufferCacheIndex& bufferCacheIndex)
@@ -42,22 +48,24 @@ namespace Aurora
 			return reinterpret_cast<T*>(GetOrMap(size, bufferCacheIndex));
 		}
 
-		void Unmap(VBufferCacheIndex& bufferCacheIndex);
-
-		void Reset()
+		template<typename T>
+		T* GetOrMap(uint size, uint alignment, VBufferCacheIndex& bufferCacheIndex)
 		{
-			m_CurrentOffset = 0;
-			m_CurrentBuffer = 0;
+			return reinterpret_cast<T*>(GetOrMap(size, alignment, bufferCacheIndex));
 		}
 
-		void OnFrameEnd()
-		{
-			m_NumBytesPerFrame = 0;
-		}
+		// The mapping is coherent, nothing has to be flushed
+		void Unmap(VBufferCacheIndex& bufferCacheIndex) {}
+
+		// Fences the region of this frame and waits until the GPU is done with the next one
+		void OnFrameEnd();
 
 		uint GetNumBytesPerFrame()
 		{
-			return m_NumBytesPerFrame;
+			return m_Allocator.GetAllocatedBytes();
 		}
+
+		[[nodiscard]] const StreamingRingAllocator& GetAllocator() const { return m_Allocator; }
+		[[nodiscard]] const Buffer_ptr& GetBuffer() const { return m_Buffer; }
 	};
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Aurora/Framework/CameraComponent.hpp"
 #include "Aurora/Framework/Lights.hpp"
 #include "Aurora/Graphics/VgRender.hpp"
+#include "Aurora/Graphics/RenderManager.hpp"
 
 namespace Aurora
 {
@@ -21,17 +22,12 @@ namespace Aurora
 		Vector3 Color;
 	};
 
-	Buffer_ptr g_LineBuffer = nullptr;
 	InputLayout_ptr g_LineInputLayout = nullptr;
 	Shader_ptr g_LineShader = nullptr;
 
 	void DShapes::Init()
 	{
-		uint32_t maxLines = 200000;
-		uint32_t lineVertexBufferSize = (sizeof(Vector3) * 2) * maxLines;
-		AU_LOG_INFO("Allocated ", FormatBytes(lineVertexBufferSize), " for debug line render.");
-
-		g_LineBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("DebugLinesVBuffer", lineVertexBufferSize, EBufferType::VertexBuffer, EBufferUsage::DynamicDraw));
+		// Vertices are streamed through the vertex buffer cache of the render manager
 		g_LineInputLayout = GEngine->GetRenderDevice()->CreateInputLayout({
 			{"POSITION", GraphicsFormat::RGB32_FLOAT, 0, offsetof(BaseShapeVertex, Position), 0, sizeof(BaseShapeVertex), false, false },
 			{"COLOR", GraphicsFormat::RGB32_FLOAT, 0, offsetof(BaseShapeVertex, Color), 1, sizeof(BaseShapeVertex), false, false }
@@ -84,61 +80,57 @@ namespace Aurora
 			return false;
 		});
 
-		drawState.SetVertexBuffer(0, g_LineBuffer);
 		drawState.InputLayoutHandle = g_LineInputLayout;
 		drawState.Shader = g_LineShader;
 
-		int lineDrawCount = 0;
+		BufferCache& vertexBufferCache = GEngine->GetRenderManager()->GetVertexBufferCache();
 
-		for (int i = 0; i < m_LineShapes.size(); ++i)
+		for (size_t i = 0; i < m_LineShapes.size();)
 		{
 			const ShapeStructs::LineShape& currentShape = m_LineShapes[i];
 
-			BaseShapeVertex* vertices = GEngine->GetRenderDevice()->MapBuffer<BaseShapeVertex>(g_LineBuffer, EBufferAccess::WriteOnly);
+			// Lines with the same thickness and depth test go in one draw
+			size_t batchEnd = i + 1;
+			while (batchEnd < m_LineShapes.size() && m_LineShapes[batchEnd].Thickness == currentShape.Thickness && m_LineShapes[batchEnd].UseDepthBuffer == currentShape.UseDepthBuffer)
+			{
+				batchEnd++;
+			}
 
-			vertices->Position = currentShape.P0;
-			vertices->Color = currentShape.Color;
-			vertices++;
-			vertices->Position = currentShape.P1;
-			vertices->Color = currentShape.Color;
-			vertices++;
+			auto renderLineCount = static_cast<uint32_t>(batchEnd - i);
 
-			uint32_t renderLineCount = 1;
+			// Aligned to the vertex size, so the draw can start at the allocation
+			VBufferCacheIndex cacheIndex;
+			auto* vertices = vertexBufferCache.GetOrMap<BaseShapeVertex>(renderLineCount * 2 * sizeof(BaseShapeVertex), sizeof(BaseShapeVertex), cacheIndex);
 
-			 // If not at the end of an array
-			if(i != m_LineShapes.size() - 1)
+			if(vertices == nullptr)
 			{
-				for (int j = i + 1; j < m_LineShapes.size(); ++j)
-				{
-					const ShapeStructs::LineShape& nextShape = m_LineShapes[j];
-
-					if(nextShape.Thickness != currentShape.Thickness || nextShape.UseDepthBuffer != currentShape.UseDepthBuffer)
-						break;
-
-					vertices->Position = nextShape.P0;
-					vertices->Color = nextShape.Color;
-					vertices++;
-					vertices->Position = nextShape.P1;
-					vertices->Color = nextShape.Color;
-					vertices++;
-
-					renderLineCount++;
-					i++;
-				}
+				break;
 			}
 
-			GEngine->GetRenderDevice()->UnmapBuffer(g_LineBuffer);
-
 			drawState.PrimitiveType = EPrimitiveType::LineList;
 			drawState.RasterState.LineWidth = currentShape.Thickness;
 			drawState.DepthStencilState.DepthEnable = currentShape.UseDepthBuffer;
 
+			for (; i < batchEnd; ++i)
+			{
+				const ShapeStructs::LineShape& shape = m_LineShapes[i];
+
+				vertices->Position = shape.P0;
+				vertices->Color = shape.Color;
+				vertices++;
+				vertices->Position = shape.P1;
+				vertices->Color = shape.Color;
+				vertices++;
+			}
+
+			vertexBufferCache.Unmap(cacheIndex);
+			drawState.SetVertexBuffer(0, cacheIndex.Buffer);
+
 			DrawArguments drawArguments;
 			drawArguments.VertexCount = renderLineCount * 2;
+			drawArguments.StartVertexLocation = cacheIndex.Offset / sizeof(BaseShapeVertex);
 
 			GEngine->GetRenderDevice()->Draw(drawState, {drawArguments});
-
-			lineDrawCount++;
 		}
 
 		// TODO: Implement box, sphere and arrow shape render
@@ -180,7 +172,6 @@ namespace Aurora
 
 	void DShapes::Destroy()
 	{
-		g_LineBuffer.reset();
 		g_LineInputLayout.reset();
 		g_LineShader.reset();
 	}
@@ -6,21 +6,22 @@
 
 #include "MaterialDefinition.hpp"
 
-#include "Aurora/Graphics/OpenGL/GLRenderGroupScope.hpp"
+#include "Aurora/Graphics/RenderGroupScope.hpp"
 
 namespace Aurora
 {
 	uint64_t HashShaderMacros(const ShaderMacros& macros)
 	{
-		std::stringstream ss;
+		uint64_t hash = Hash_FNV1a64(std::span<const uint8_t>());
 
+		// The terminators are hashed too, so "AB" "C" and "A" "BC" differ
 		for(const auto& it : macros)
 		{
-			ss << it.first;
-			ss << it.second;
+			hash = Hash_FNV1a64(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(it.first.c_str()), it.first.size() + 1), hash);
+			hash = Hash_FNV1a64(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(it.second.c_str()), it.second.size() + 1), hash);
 		}
 
-		return std::hash<String>()(ss.str());
+		return hash;
 	}
 
 	std::ostream& operator<<(std::ostream &out, ShaderMacros const& macros)
@@ -64,7 +65,7 @@ namespace Aurora
 
 #pragma region RenderPass
 
-	void Material::BeginPass(PassType_t pass, DrawCallState& drawState)
+	bool Material::BeginPass(PassType_t pass, DrawCallState& drawState, bool indirectDraw)
 	{
 		CPU_DEBUG_SCOPE("Material::BeginPass");
 
@@ -74,68 +75,45 @@ namespace Aurora
 		}
 		m_StateCheck++;
 
-		char groupName[512];
-		snprintf(groupName, sizeof(groupName), "Material: %s", m_MatDef->GetName().c_str());
-		glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, static_cast<GLsizei>(strlen(groupName)), groupName);
-
 		IRenderDevice* renderDevice = GEngine->GetRenderDevice();
-		MaterialPassDef* passDef = m_MatDef->GetPassDefinition(pass);
-
-		if(passDef == nullptr)
-		{
-			//TODO: Do something
-			AU_LOG_WARNING("Pass ", (uint32_t)pass, " not found for ", m_MatDef->m_Name);
-		}
-
-		Shader_ptr shader = passDef->GetShader(m_Macros);
+		renderDevice->PushDebugGroup(m_MatDef->GetDebugGroupName().c_str());
 
-		if(shader == nullptr)
-		{
-			//TODO: Do something
-			AU_LOG_WARNING("Shader for pass", pass, " is null !");
-		}
+		const MaterialCompiledPass& compiledPass = GetCompiledPass(pass, indirectDraw);
 
-		drawState.Shader = shader;
-		renderDevice->SetShader(shader);
+		drawState.Shader = compiledPass.Shader;
+		renderDevice->SetShader(compiledPass.Shader);
 
 		// Set buffers
+		BufferCache& uniformBufferCache = GEngine->GetRenderManager()->GetUniformBufferCache();
+		bool uniformsBound = true;
 
-		for(uint8 uniformBlockIndex : m_MatDef->m_PassUniformBlockMapping[pass])
+		for(const MaterialCompiledPass::UniformBlockSlot& block : compiledPass.UniformBlocks)
 		{
-			const MUniformBlock& block = m_MatDef->m_UniformBlocksDef[uniformBlockIndex];
-
 			VBufferCacheIndex cacheIndex;
-			uint8* data = GEngine->GetRenderManager()->GetUniformBufferCache().GetOrMap(block.Size, cacheIndex);
-			std::memcpy(data, m_UniformData.data() + block.Offset, block.Size);
-			GEngine->GetRenderManager()->GetUniformBufferCache().Unmap(cacheIndex);
-			drawState.BindUniformBuffer(block.Name, cacheIndex.Buffer, cacheIndex.Offset, cacheIndex.Size);
-		}
+			uint8* data = uniformBufferCache.GetOrMap(block.Size, cacheIndex);
 
-		// Set textures
-		for(TTypeID texId : m_MatDef->m_PassTextureMapping[pass])
-		{
-			MTextureVar* textureVar = GetTextureVar(texId);
-
-			if(textureVar->Texture == nullptr)
+			// The frame region of the cache is full, the cache already warned about it
+			if (data == nullptr)
 			{
-				if (textureVar->InShaderName[0] == 'g')
-				{
-					continue;
-				}
-
-				// TODO: Look at this and maybe fix this
-				drawState.BindTexture(textureVar->InShaderName, GEngine->GetResourceManager()->LoadTexture("Assets/Textures/blueprint.png"));
-				drawState.BindSampler(textureVar->InShaderName, textureVar->Sampler);
+				uniformsBound = false;
 				continue;
 			}
 
-			drawState.BindTexture(textureVar->InShaderName, textureVar->Texture);
-			drawState.BindSampler(textureVar->InShaderName, textureVar->Sampler);
+			std::memcpy(data, m_UniformData.data() + block.Offset, block.Size);
+			uniformBufferCache.Unmap(cacheIndex);
+			drawState.BindUniformBuffer(block.NameID, cacheIndex.Buffer, cacheIndex.Offset, cacheIndex.Size);
+		}
+
+		// Set textures
+		for(const MaterialCompiledPass::TextureSlot& texture : compiledPass.Textures)
+		{
+			drawState.BindTexture(texture.NameID, texture.Texture);
+			drawState.BindSampler(texture.NameID, texture.Sampler);
 		}
 
 		renderDevice->BindShaderResources(drawState);
 
-		MaterialPassState& passState = m_PassStates[pass];
+		const MaterialPassState& passState = m_PassStates[pass];
 		renderDevice->SetRasterState(passState.RasterState);
 		renderDevice->SetDepthStencilState(passState.DepthStencilState);
 		renderDevice->SetBlendState(passState.BlendState);
@@ -143,6 +121,8 @@ namespace Aurora
 		drawState.RasterState = passState.RasterState;
 		drawState.DepthStencilState = passState.DepthStencilState;
 		drawState.BlendState = passState.BlendState;
+
+		return uniformsBound;
 	}
 
 	void Material::EndPass(PassType_t pass, DrawCallState& state)
@@ -156,12 +136,95 @@ namespace Aurora
 		//state.Uniforms.ResetResources();
 
 		CPU_DEBUG_SCOPE("Material::EndPass");
-		glPopDebugGroup();
+		GEngine->GetRenderDevice()->PopDebugGroup();
 
 		(void)pass;
 		(void)state;
+	}
+
+	void Material::InvalidatePasses()
+	{
+		for (MaterialCompiledPass& compiledPass : m_CompiledPasses)
+		{
+			compiledPass.Valid = false;
+		}
+	}
+
+	const MaterialCompiledPass& Material::GetCompiledPass(PassType_t pass, bool indirectDraw)
+	{
+		MaterialCompiledPass& compiledPass = m_CompiledPasses[indirectDraw ? Pass::Count + pass : pass];
+
+		if (!compiledPass.Valid || compiledPass.ShaderRevision != m_MatDef->GetShaderRevision())
+		{
+			CompilePass(pass, indirectDraw, compiledPass);
+		}
 
-		GEngine->GetRenderManager()->GetUniformBufferCache().Reset();
+		return compiledPass;
+	}
+
+	void Material::CompilePass(PassType_t pass, bool indirectDraw, MaterialCompiledPass& compiledPass)
+	{
+		CPU_DEBUG_SCOPE("Material::CompilePass");
+
+		compiledPass.Shader = nullptr;
+		compiledPass.UniformBlocks.clear();
+		compiledPass.Textures.clear();
+		compiledPass.ShaderRevision = m_MatDef->GetShaderRevision();
+		compiledPass.Valid = true;
+
+		MaterialPassDef* passDef = m_MatDef->GetPassDefinition(pass);
+
+		if(passDef == nullptr)
+		{
+			//TODO: Do something
+			AU_LOG_WARNING("Pass ", (uint32_t)pass, " not found for ", m_MatDef->m_Name);
+			return;
+		}
+
+		if(indirectDraw)
+		{
+			ShaderMacros macros = m_Macros;
+			macros["INDIRECT_DRAW"] = "1";
+			compiledPass.Shader = passDef->GetShader(macros);
+		}
+		else
+		{
+			compiledPass.Shader = passDef->GetShader(m_Macros);
+		}
+
+		if(compiledPass.Shader == nullptr)
+		{
+			//TODO: Do something
+			AU_LOG_WARNING("Shader for pass", pass, " is null !");
+		}
+
+		for(uint8 uniformBlockIndex : m_MatDef->m_PassUniformBlockMapping[pass])
+		{
+			const MUniformBlock& block = m_MatDef->m_UniformBlocksDef[uniformBlockIndex];
+			compiledPass.UniformBlocks.push_back({block.NameID, (uint32_t)block.Offset, (uint32_t)block.Size});
+		}
+
+		for(TTypeID texId : m_MatDef->m_PassTextureMapping[pass])
+		{
+			MTextureVar* textureVar = GetTextureVar(texId);
+
+			if(textureVar == nullptr)
+				continue;
+
+			if(textureVar->Texture == nullptr)
+			{
+				if (textureVar->InShaderName[0] == 'g')
+				{
+					continue;
+				}
+
+				// TODO: Look at this and maybe fix this
+				compiledPass.Textures.push_back({textureVar->InShaderNameID, GEngine->GetResourceManager()->LoadTexture("Assets/Textures/blueprint.png"), textureVar->Sampler});
+				continue;
+			}
+
+			compiledPass.Textures.push_back({textureVar->InShaderNameID, textureVar->Texture, textureVar->Sampler});
+		}
 	}
 
 #pragma endregion RenderPass
@@ -300,6 +363,7 @@ namespace Aurora
 		if (var->HasEnableMacro)
 			m_Macros[var->MacroName] = var->Texture != nullptr ? "1" : "0";
 
+		InvalidatePasses();
 		return true;
 	}
 
@@ -311,6 +375,8 @@ namespace Aurora
 			return false;
 
 		var->Sampler = sampler;
+
+		InvalidatePasses();
 		return true;
 	}
 
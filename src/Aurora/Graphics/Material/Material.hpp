@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include "Aurora/Core/Types.hpp"
 #include "Aurora/Core/Object.hpp"
 #include "Aurora/Core/String.hpp"
@@ -52,6 +54,7 @@ namespace Aurora
 	struct MTextureVar : MVarBase
 	{
 		String InShaderName;
+		TTypeID InShaderNameID;
 		Texture_ptr Texture;
 		Sampler_ptr Sampler;
 	};
@@ -95,6 +98,31 @@ namespace Aurora
 		MaterialPassState() : RasterState(), DepthStencilState(), BlendState() {}
 	};
 
+	// What BeginPass needs for one pass, resolved from the definition, macros and textures of the material.
+	// Rebuilt only when one of them changes, so a material switch does no lookups by name or macro hashing.
+	struct MaterialCompiledPass
+	{
+		struct UniformBlockSlot
+		{
+			TTypeID NameID;
+			uint32_t Offset; // In the uniform data of the material
+			uint32_t Size;
+		};
+
+		struct TextureSlot
+		{
+			TTypeID NameID;
+			Texture_ptr Texture;
+			Sampler_ptr Sampler;
+		};
+
+		Shader_ptr Shader = nullptr;
+		std::vector<UniformBlockSlot> UniformBlocks;
+		std::vector<TextureSlot> Textures;
+		uint32_t ShaderRevision = 0;
+		bool Valid = false;
+	};
+
 	typedef uint64_t SortID;
 
 	enum class RenderSortType : uint8
@@ -129,7 +157,9 @@ namespace Aurora
 
 		ShaderMacros m_Macros; // TODO: Finish macros
 
-		robin_hood::unordered_map<PassType_t, MaterialPassState> m_PassStates;
+		std::array<MaterialPassState, Pass::Count> m_PassStates;
+		// Direct draws first, then the INDIRECT_DRAW permutations used by multi draw indirect
+		std::array<MaterialCompiledPass, Pass::Count * 2> m_CompiledPasses;
 
 		RenderSortType m_SortType = RenderSortType::Opaque;
 		uint8_t m_Flags = MF_INSTANCED | MF_TRANSFORM;
@@ -154,13 +184,20 @@ namespace Aurora
 		FDepthStencilState& DepthStencilState(PassType_t pass = 0);
 		FBlendState& BlendState(PassType_t pass = 0);
 
-		ShaderMacros& GetMacros() { return m_Macros; }
+		// The macros may be changed through the reference, so the passes are recompiled
+		ShaderMacros& GetMacros() { InvalidatePasses(); return m_Macros; }
 		[[nodiscard]] const ShaderMacros& GetMacros() const { return m_Macros; }
-		void SetMacro(const String& key, const String& value) { m_Macros[key] = value; }
+		void SetMacro(const String& key, const String& value) { m_Macros[key] = value; InvalidatePasses(); }
 
-		void BeginPass(PassType_t pass, DrawCallState& state);
+		// Indirect draw uses the INDIRECT_DRAW shader permutation, instances are read from the IndirectInstances storage block.
+		// Returns false when a uniform block did not fit the uniform buffer cache, the pass is begun anyway and EndPass
+		// has to be called, but nothing should be drawn with it.
+		bool BeginPass(PassType_t pass, DrawCallState& state, bool indirectDraw = false);
 		void EndPass(PassType_t pass, DrawCallState& state);
 
+		// Called by every setter that changes what BeginPass binds
+		void InvalidatePasses();
+
 		std::shared_ptr<Material> Clone();
 		virtual void ReloadShader();
 
@@ -174,6 +211,8 @@ namespace Aurora
 			{
 				m_Macros.erase("USE_ALPHA_THRESHOLD");
 			}
+
+			InvalidatePasses();
 		}
 
 		[[nodiscard]] bool IsAlphaThresholdSet() const
@@ -232,6 +271,7 @@ namespace Aurora
 
 		//////// Textures ////////
 	public:
+		// Change textures and samplers with SetTexture and SetSampler, they keep the compiled passes up to date
 		MTextureVar* GetTextureVar(TTypeID varId);
 	public:
 		bool SetTexture(TTypeID varId, const Texture_ptr& texture);
@@ -242,6 +282,9 @@ namespace Aurora
 
 		//////// Buffers ////////
 		bool SetBuffer(TTypeID bufferId, const Buffer_ptr& buffer) { return false; } // TODO: Complete buffers
+	private:
+		const MaterialCompiledPass& GetCompiledPass(PassType_t pass, bool indirectDraw);
+		void CompilePass(PassType_t pass, bool indirectDraw, MaterialCompiledPass& compiledPass);
 	};
 
 	using matref = std::shared_ptr<Material>;
@@ -62,7 +62,7 @@ namespace Aurora
 	}
 
 	MaterialDefinition::MaterialDefinition(const MaterialDefinitionDesc& desc)
-		: Material(this), m_Name(desc.Name), m_Path(desc.Filepath), m_PassDefs(desc.ShaderPasses.size())
+		: Material(this), m_Name(desc.Name), m_Path(desc.Filepath), m_DebugGroupName("Material: " + desc.Name), m_ShaderRevision(0), m_PassDefs(desc.ShaderPasses.size())
 	{
 		size_t memorySize = 0;
 
@@ -107,6 +107,7 @@ namespace Aurora
 					textureVar.HasEnableMacro = false;
 					textureVar.MacroName = "";
 					textureVar.InShaderName = samplerName;
+					textureVar.InShaderNameID = samplerId;
 					textureVar.Texture = nullptr;
 					textureVar.Sampler = Samplers::WrapWrapLinearLinear;
 					m_TextureVars[samplerId] = textureVar;
@@ -283,5 +284,7 @@ namespace Aurora
 		{
 			def.ReloadShader();
 		}
+
+		m_ShaderRevision++;
 	}
 }
\ No newline at end of file
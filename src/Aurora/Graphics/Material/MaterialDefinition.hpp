@@ -18,7 +18,7 @@ namespace Aurora
 	{
 	private:
 		ShaderProgramDesc m_ShaderBaseDescription;
-		std::unordered_map<PassType_t, Shader_ptr> m_ShaderPermutations;
+		std::unordered_map<uint64_t, Shader_ptr> m_ShaderPermutations;
 
 		MaterialPassState m_PassStates;
 	public:
@@ -56,6 +56,9 @@ namespace Aurora
 	private:
 		String m_Name;
 		Path m_Path;
+		String m_DebugGroupName;
+		// Bumped on every shader reload, compiled passes of the instances holding an older one are rebuilt
+		uint32_t m_ShaderRevision;
 
 		std::vector<std::weak_ptr<Material>> m_MaterialRefs;
 
@@ -75,6 +78,8 @@ namespace Aurora
 
 		[[nodiscard]] inline const String& GetName() const { return m_Name; }
 		[[nodiscard]] inline const Path& GetPath() const { return m_Path; }
+		[[nodiscard]] inline const String& GetDebugGroupName() const { return m_DebugGroupName; }
+		[[nodiscard]] inline uint32_t GetShaderRevision() const { return m_ShaderRevision; }
 
 		[[nodiscard]] const std::vector<MUniformBlock>& GetUniformBlocks() const { return m_UniformBlocksDef; }
 		[[nodiscard]] const robin_hood::unordered_map<TTypeID, MTextureVar>& GetTextureVars() const { return m_TextureVars; }
@@ -0,0 +1,715 @@
+#include "NullRenderDevice.hpp"
+
+#include <cstring>
+#include "Aurora/Core/Profiler.hpp"
+
+namespace Aurora
+{
+	namespace
+	{
+		// Repeats a value of four bytes over the whole range, like a clear of a 32 bit format
+		void FillPattern(uint8_t* data, size_t size, const void* value)
+		{
+			const auto* pattern = static_cast<const uint8_t*>(value);
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				data[i] = pattern[i % 4];
+			}
+		}
+
+		inline UniqueIdentifier GetID(const IBuffer* buffer) { return buffer ? buffer->GetUniqueID() : 0; }
+		inline UniqueIdentifier GetID(const ITexture* texture) { return texture ? texture->GetUniqueID() : 0; }
+	}
+
+	NullRenderDevice::NullRenderDevice()
+		: IRenderDevice(),
+		  m_DeviceStatistics(),
+		  m_Recorder(nullptr),
+		  m_LastShader(0),
+		  m_BoundIndexBuffer(0),
+		  m_LastInputLayout(nullptr),
+		  m_LastRenderTargets(),
+		  m_LastDepthTarget(nullptr),
+		  m_HasBlendState(false),
+		  m_HasRasterState(false),
+		  m_HasDepthState(false),
+		  m_LastViewPort(),
+		  m_LastBlendState(),
+		  m_LastRasterState(),
+		  m_LastDepthState()
+	{
+
+	}
+
+	void NullRenderDevice::Init()
+	{
+		InvalidateState();
+		AU_LOG_INFO("Null render device initialized");
+	}
+
+	Shader_ptr NullRenderDevice::CreateShaderProgram(const ShaderProgramDesc& desc)
+	{
+		CPU_DEBUG_SCOPE("NullRenderDevice::CreateShaderProgram");
+		return std::make_shared<NullShaderProgram>(desc);
+	}
+
+	void NullRenderDevice::SetShader(const Shader_ptr& shader)
+	{
+		UniqueIdentifier id = shader ? shader->GetUniqueID() : 0;
+
+		if (id == m_LastShader)
+			return;
+
+		m_LastShader = id;
+		m_DeviceStatistics.ShaderChanges++;
+		m_DeviceStatistics.StateChanges++;
+		Record(ERenderCommand::SetShader, shader.get());
+	}
+
+	Texture_ptr NullRenderDevice::CreateTexture(const TextureDesc& desc, TextureData textureData)
+	{
+		auto texture = std::make_shared<NullTexture>(desc);
+
+		if (textureData)
+		{
+			// Mip 0 of every layer
+			size_t size = texture->GetMipByteSize(0) * texture->GetLayerCount();
+			std::memcpy(texture->Data(), textureData, size);
+			m_DeviceStatistics.BytesUploaded += size;
+			Record(ERenderCommand::WriteTexture, texture.get(), 0, 0, size);
+		}
+
+		return texture;
+	}
+
+	void NullRenderDevice::WriteTexture(const Texture_ptr& texture, uint32_t mipLevel, uint32_t subresource, const void* data)
+	{
+		if (texture == nullptr || data == nullptr)
+			return;
+
+		auto* nullTexture = static_cast<NullTexture*>(texture.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+
+		if (mipLevel >= std::max<uint32_t>(1, nullTexture->GetDesc().MipLevels) || subresource >= nullTexture->GetLayerCount())
+		{
+			AU_LOG_ERROR("Cannot write mip ", mipLevel, " layer ", subresource, " of texture ", nullTexture->GetDesc().Name, " !");
+			return;
+		}
+
+		size_t size = nullTexture->GetMipByteSize(mipLevel);
+		std::memcpy(nullTexture->Data() + nullTexture->GetSubresourceOffset(mipLevel, subresource), data, size);
+
+		m_DeviceStatistics.BytesUploaded += size;
+		Record(ERenderCommand::WriteTexture, nullTexture, mipLevel, subresource, size);
+	}
+
+	void NullRenderDevice::ClearTextureFloat(const Texture_ptr& texture, float val)
+	{
+		if (texture == nullptr)
+			return;
+
+		auto* nullTexture = static_cast<NullTexture*>(texture.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+		FillPattern(nullTexture->Data(), nullTexture->GetByteSize(), &val);
+		Record(ERenderCommand::ClearTexture, nullTexture);
+	}
+
+	void NullRenderDevice::ClearTextureUInt(const Texture_ptr& texture, uint32_t clearColor)
+	{
+		if (texture == nullptr)
+			return;
+
+		auto* nullTexture = static_cast<NullTexture*>(texture.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+		FillPattern(nullTexture->Data(), nullTexture->GetByteSize(), &clearColor);
+		Record(ERenderCommand::ClearTexture, nullTexture);
+	}
+
+	void NullRenderDevice::GenerateMipmaps(const Texture_ptr& texture)
+	{
+		Record(ERenderCommand::GenerateMipmaps, texture.get());
+	}
+
+	bool NullRenderDevice::ReadTexture(const Texture_ptr& texture, std::vector<uint8>& imageBuffer)
+	{
+		if (texture == nullptr)
+		{
+			return false;
+		}
+
+		auto* nullTexture = static_cast<NullTexture*>(texture.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+
+		// Like glGetTexImage, mip 0 into a buffer the caller sized
+		size_t size = std::min(imageBuffer.size(), nullTexture->GetMipByteSize(0) * nullTexture->GetLayerCount());
+
+		if (nullTexture->HasData())
+			std::memcpy(imageBuffer.data(), nullTexture->Data(), size);
+		else
+			std::memset(imageBuffer.data(), 0, size);
+
+		return true;
+	}
+
+	void* NullRenderDevice::GetTextureHandleForBindless(const Texture_ptr& texture, bool srgb)
+	{
+		return texture ? texture->GetRawHandle() : nullptr;
+	}
+
+	bool NullRenderDevice::MakeTextureHandleResident(const Texture_ptr& texture, bool enabled)
+	{
+		return texture != nullptr && texture->GetDesc().UseAsBindless;
+	}
+
+	Buffer_ptr NullRenderDevice::CreateBuffer(const BufferDesc& desc, const void* data)
+	{
+		auto buffer = std::make_shared<NullBuffer>(desc);
+
+		if (data)
+		{
+			std::memcpy(buffer->Data(), data, desc.ByteSize);
+			m_DeviceStatistics.BytesUploaded += desc.ByteSize;
+			Record(ERenderCommand::WriteBuffer, buffer.get(), 0, 0, desc.ByteSize);
+		}
+
+		return buffer;
+	}
+
+	void NullRenderDevice::WriteBuffer(const Buffer_ptr& buffer, const void* data, size_t dataSize, size_t offset)
+	{
+		if (buffer == nullptr)
+		{
+			return;
+		}
+
+		auto* nullBuffer = static_cast<NullBuffer*>(buffer.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+
+		au_assert(nullBuffer->GetDesc().ByteSize >= offset + dataSize);
+
+		if (offset + dataSize > nullBuffer->GetDesc().ByteSize)
+			return;
+
+		std::memcpy(nullBuffer->Data() + offset, data, dataSize);
+
+		m_FrameRenderStatistics.BufferWrites++;
+		m_DeviceStatistics.BytesUploaded += dataSize;
+		Record(ERenderCommand::WriteBuffer, nullBuffer, 0, offset, dataSize);
+	}
+
+	void NullRenderDevice::ClearBufferUInt(const Buffer_ptr& buffer, uint32_t clearValue)
+	{
+		if (buffer == nullptr)
+		{
+			return;
+		}
+
+		auto* nullBuffer = static_cast<NullBuffer*>(buffer.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+		FillPattern(nullBuffer->Data(), nullBuffer->GetDesc().ByteSize, &clearValue);
+		Record(ERenderCommand::ClearBuffer, nullBuffer, 0, clearValue);
+	}
+
+	void NullRenderDevice::CopyToBuffer(const Buffer_ptr& dest, uint32_t destOffsetBytes, const Buffer_ptr& src, uint32_t srcOffsetBytes, size_t dataSizeBytes)
+	{
+		if (dest == nullptr || src == nullptr)
+		{
+			return;
+		}
+
+		auto* destBuffer = static_cast<NullBuffer*>(dest.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+		auto* srcBuffer = static_cast<NullBuffer*>(src.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+
+		if (destOffsetBytes + dataSizeBytes > destBuffer->GetDesc().ByteSize || srcOffsetBytes + dataSizeBytes > srcBuffer->GetDesc().ByteSize)
+		{
+			AU_LOG_ERROR("Buffer copy from ", srcBuffer->GetDesc().Name, " to ", destBuffer->GetDesc().Name, " is out of range !");
+			return;
+		}
+
+		// Source and destination can be the same buffer
+		std::memmove(destBuffer->Data() + destOffsetBytes, srcBuffer->Data() + srcOffsetBytes, dataSizeBytes);
+		Record(ERenderCommand::CopyBuffer, destBuffer, 0, destOffsetBytes, srcOffsetBytes, dataSizeBytes, srcBuffer);
+	}
+
+	uint8_t* NullRenderDevice::MapBuffer(const Buffer_ptr& buffer, EBufferAccess bufferAccess)
+	{
+		if (buffer == nullptr)
+		{
+			return nullptr;
+		}
+		m_FrameRenderStatistics.BufferMaps++;
+
+		auto* nullBuffer = static_cast<NullBuffer*>(buffer.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+		nullBuffer->m_Mapped = true;
+
+		if (bufferAccess != EBufferAccess::ReadOnly)
+			m_DeviceStatistics.BytesMapped += nullBuffer->GetDesc().ByteSize;
+
+		Record(ERenderCommand::MapBuffer, nullBuffer, 0, (uint64_t)bufferAccess);
+		return nullBuffer->Data();
+	}
+
+	void NullRenderDevice::UnmapBuffer(const Buffer_ptr& buffer)
+	{
+		if (buffer == nullptr)
+		{
+			return;
+		}
+
+		static_cast<NullBuffer*>(buffer.get())->m_Mapped = false; // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+	}
+
+	void NullRenderDevice::LockBufferRange(const Buffer_ptr& buffer, size_t offset, size_t size)
+	{
+		Record(ERenderCommand::LockBufferRange, buffer.get(), 0, offset, size);
+	}
+
+	void NullRenderDevice::WaitForBufferRange(const Buffer_ptr& buffer, size_t offset, size_t size)
+	{
+		Record(ERenderCommand::WaitForBufferRange, buffer.get(), 0, offset, size);
+	}
+
+	Sampler_ptr NullRenderDevice::CreateSampler(const SamplerDesc& desc)
+	{
+		return std::make_shared<NullSampler>(desc);
+	}
+
+	InputLayout_ptr NullRenderDevice::CreateInputLayout(const std::vector<VertexAttributeDesc>& desc)
+	{
+		return std::make_shared<BasicInputLayout>(desc);
+	}
+
+	void NullRenderDevice::Draw(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState)
+	{
+		CPU_DEBUG_SCOPE("Draw");
+
+		if (bindState)
+		{
+			if (state.Shader == nullptr)
+			{
+				AU_LOG_ERROR("Cannot draw without shader !");
+				return;
+			}
+
+			ApplyDrawCallState(state);
+		}
+
+		for (const auto& drawArg : args)
+		{
+			m_FrameRenderStatistics.VertexCount += drawArg.VertexCount * drawArg.InstanceCount;
+			Record(ERenderCommand::Draw, state.Shader.get(), 0, drawArg.VertexCount, drawArg.InstanceCount, drawArg.StartVertexLocation);
+		}
+
+		m_FrameRenderStatistics.DrawCalls++;
+	}
+
+	void NullRenderDevice::DrawIndexed(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState)
+	{
+		CPU_DEBUG_SCOPE("DrawIndexed");
+
+		if (state.IndexBuffer.Buffer == nullptr || state.Shader == nullptr)
+		{
+			AU_LOG_ERROR("Cannot draw with these arguments !");
+			return;
+		}
+
+		if (bindState)
+			ApplyDrawCallState(state);
+
+		UniqueIdentifier indexBuffer = state.IndexBuffer.Buffer->GetUniqueID();
+
+		if (indexBuffer != m_BoundIndexBuffer)
+		{
+			m_BoundIndexBuffer = indexBuffer;
+			m_DeviceStatistics.StateChanges++;
+			Record(ERenderCommand::BindIndexBuffer, state.IndexBuffer.Buffer.get(), 0, (uint64_t)state.IndexBuffer.Format);
+		}
+
+		for (const auto& drawArg : args)
+		{
+			m_FrameRenderStatistics.VertexCount += drawArg.VertexCount * 3 * drawArg.InstanceCount;
+			Record(ERenderCommand::DrawIndexed, state.Shader.get(), 0, drawArg.VertexCount, drawArg.InstanceCount, drawArg.StartIndexLocation);
+		}
+
+		m_FrameRenderStatistics.DrawCalls++;
+	}
+
+	void NullRenderDevice::DrawIndirect(const DrawCallState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes, uint32_t drawCount)
+	{
+		CPU_DEBUG_SCOPE("DrawIndirect");
+
+		if (state.IndexBuffer.Buffer == nullptr || indirectParams == nullptr || drawCount == 0)
+		{
+			AU_LOG_ERROR("Cannot draw with these arguments !");
+			return;
+		}
+
+		auto* commandBuffer = static_cast<NullBuffer*>(indirectParams.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+
+		if (offsetBytes + drawCount * sizeof(DrawElementsIndirectCommand) > commandBuffer->GetDesc().ByteSize)
+		{
+			AU_LOG_ERROR("Indirect commands of ", commandBuffer->GetDesc().Name, " are out of range !");
+			return;
+		}
+
+		UniqueIdentifier indexBuffer = state.IndexBuffer.Buffer->GetUniqueID();
+
+		if (indexBuffer != m_BoundIndexBuffer)
+		{
+			m_BoundIndexBuffer = indexBuffer;
+			m_DeviceStatistics.StateChanges++;
+			Record(ERenderCommand::BindIndexBuffer, state.IndexBuffer.Buffer.get(), 0, (uint64_t)state.IndexBuffer.Format);
+		}
+
+		// The commands are in memory, so vertices are counted the same way DrawIndexed does
+		const auto* commands = reinterpret_cast<const DrawElementsIndirectCommand*>(commandBuffer->Data() + offsetBytes);
+
+		for (uint32_t i = 0; i < drawCount; ++i)
+		{
+			m_FrameRenderStatistics.VertexCount += commands[i].count * 3 * commands[i].instanceCount;
+		}
+
+		Record(ERenderCommand::DrawIndirect, state.Shader.get(), 0, offsetBytes, drawCount, 0, indirectParams.get());
+		m_FrameRenderStatistics.DrawCalls++;
+	}
+
+	void NullRenderDevice::Dispatch(const DispatchState& state, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+	{
+		CPU_DEBUG_SCOPE("Dispatch");
+		ApplyDispatchState(state);
+
+		Record(ERenderCommand::Dispatch, state.Shader.get(), 0, groupsX, groupsY, groupsZ);
+	}
+
+	void NullRenderDevice::DispatchIndirect(const DispatchState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes)
+	{
+		assert(state.Shader != nullptr);
+
+		ApplyDispatchState(state);
+
+		Record(ERenderCommand::DispatchIndirect, state.Shader.get(), 0, offsetBytes, 0, 0, indirectParams.get());
+	}
+
+	void NullRenderDevice::InvalidateState()
+	{
+		m_LastShader = 0;
+		m_BoundTextures.clear();
+		m_BoundImages.clear();
+		m_BoundSamplers.clear();
+		m_BoundUniformBuffers.clear();
+		m_BoundStorageBuffers.clear();
+		m_BoundVertexBuffers.clear();
+		m_BoundIndexBuffer = 0;
+		m_LastInputLayout = nullptr;
+
+		m_LastRenderTargets = {};
+		m_LastDepthTarget = nullptr;
+		m_HasBlendState = false;
+		m_HasRasterState = false;
+		m_HasDepthState = false;
+	}
+
+	void NullRenderDevice::Blit(const Texture_ptr& src, const Texture_ptr& dest)
+	{
+		Record(ERenderCommand::Blit, src.get(), 0, 0, 0, 0, dest.get());
+	}
+
+	void NullRenderDevice::SetViewPort(const FViewPort& wp)
+	{
+		au_assert(wp.Width > 0);
+		au_assert(wp.Height > 0);
+
+		if (wp != m_LastViewPort)
+		{
+			m_LastViewPort = wp;
+			m_DeviceStatistics.StateChanges++;
+			Record(ERenderCommand::SetViewPort, nullptr, 0, (uint64_t)(uint32_t)wp.X | (uint64_t)(uint32_t)wp.Y << 32, wp.Width, wp.Height);
+		}
+	}
+
+	const FViewPort& NullRenderDevice::GetCurrentViewPort() const
+	{
+		return m_LastViewPort;
+	}
+
+	size_t NullRenderDevice::GetUsedGPUMemory()
+	{
+		return GetNullResourceMemory();
+	}
+
+	bool NullRenderDevice::BindSlot(std::vector<UniqueIdentifier>& slots, uint32_t binding, UniqueIdentifier id)
+	{
+		if (binding >= slots.size())
+			slots.resize(binding + 1, 0);
+
+		if (slots[binding] == id)
+			return false;
+
+		slots[binding] = id;
+		return true;
+	}
+
+	bool NullRenderDevice::BindBufferSlot(std::vector<BoundBuffer>& slots, uint32_t binding, const BufferBinding& bufferBinding)
+	{
+		if (binding >= slots.size())
+			slots.resize(binding + 1, {0, 0, 0});
+
+		BoundBuffer& bound = slots[binding];
+		UniqueIdentifier id = GetID(bufferBinding.Buffer.get());
+
+		if (bound.ID == id && bound.Offset == bufferBinding.Offset && bound.Size == bufferBinding.Size)
+			return false;
+
+		bound = {id, bufferBinding.Offset, bufferBinding.Size};
+		return true;
+	}
+
+	void NullRenderDevice::BindShaderResources(const BaseState& state)
+	{
+		if (state.Shader == nullptr) return;
+
+		auto shader = static_cast<NullShaderProgram*>(state.Shader.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+
+		// Binding points follow the reflection order, lookups by name ID cost the same as in the GL device
+		const std::vector<ShaderResourceDesc>& samplers = shader->GetSamplers();
+
+		for (uint32_t binding = 0; binding < samplers.size(); ++binding)
+		{
+			m_DeviceStatistics.BindCalls++;
+
+			const TextureBinding* textureBinding = state.BoundTextures.Find(samplers[binding].NameID);
+			ITexture* texture = textureBinding ? textureBinding->Texture.get() : nullptr;
+
+			if (BindSlot(m_BoundTextures, binding, GetID(texture)))
+			{
+				m_DeviceStatistics.BindingChanges++;
+				Record(ERenderCommand::BindTexture, texture, binding);
+			}
+
+			const Sampler_ptr* boundSampler = state.BoundSamplers.Find(samplers[binding].NameID);
+			ISampler* sampler = boundSampler ? boundSampler->get() : nullptr;
+
+			if (BindSlot(m_BoundSamplers, binding, sampler ? sampler->GetUniqueID() : 0))
+			{
+				m_DeviceStatistics.BindingChanges++;
+				Record(ERenderCommand::BindSampler, sampler, binding);
+			}
+		}
+
+		const std::vector<ShaderResourceDesc>& images = shader->GetImages();
+
+		for (uint32_t binding = 0; binding < images.size(); ++binding)
+		{
+			m_DeviceStatistics.BindCalls++;
+
+			const TextureBinding* boundTexture = state.BoundTextures.Find(images[binding].NameID);
+
+			if (boundTexture == nullptr)
+			{
+				if (BindSlot(m_BoundImages, binding, 0))
+				{
+					m_DeviceStatistics.BindingChanges++;
+					Record(ERenderCommand::BindTexture, nullptr, binding);
+				}
+				continue;
+			}
+
+			const TextureBinding& textureBinding = *boundTexture;
+
+			if (textureBinding.Texture == nullptr || !textureBinding.Texture->GetDesc().IsUAV || !textureBinding.IsUAV)
+			{
+				AU_LOG_WARNING("Trying to bind image as UAV but somewhere the texture is not marked as UAV");
+				continue;
+			}
+
+			if (BindSlot(m_BoundImages, binding, textureBinding.Texture->GetUniqueID()))
+			{
+				m_DeviceStatistics.BindingChanges++;
+				Record(ERenderCommand::BindTexture, textureBinding.Texture.get(), binding, (uint64_t)textureBinding.Access, textureBinding.MipLevel);
+			}
+		}
+
+		const std::vector<ShaderResourceDesc>& uniformBlocks = shader->GetUniformBlocks();
+
+		for (uint32_t binding = 0; binding < uniformBlocks.size(); ++binding)
+		{
+			m_DeviceStatistics.BindCalls++;
+
+			const BufferBinding* boundBuffer = state.BoundUniformBuffers.Find(uniformBlocks[binding].NameID);
+
+			if (boundBuffer == nullptr || boundBuffer->Buffer == nullptr)
+				continue;
+
+			BufferBinding uniformBinding = *boundBuffer;
+
+			if (uniformBinding.Size == 0)
+				uniformBinding.Size = uniformBinding.Buffer->GetDesc().ByteSize;
+
+			if (BindBufferSlot(m_BoundUniformBuffers, binding, uniformBinding))
+			{
+				m_DeviceStatistics.BindingChanges++;
+				Record(ERenderCommand::BindUniformBuffer, uniformBinding.Buffer.get(), binding, uniformBinding.Offset, uniformBinding.Size);
+			}
+		}
+
+		const std::vector<ShaderResourceDesc>& storageBlocks = shader->GetStorageBlocks();
+
+		for (uint32_t binding = 0; binding < storageBlocks.size(); ++binding)
+		{
+			m_DeviceStatistics.BindCalls++;
+
+			const BufferBinding* boundBuffer = state.SSBOBuffers.Find(storageBlocks[binding].NameID);
+
+			if (boundBuffer == nullptr || boundBuffer->Buffer == nullptr)
+				continue;
+
+			BufferBinding ssboBinding = *boundBuffer;
+
+			if (ssboBinding.Size == 0)
+				ssboBinding.Size = ssboBinding.Buffer->GetDesc().ByteSize;
+
+			if (BindBufferSlot(m_BoundStorageBuffers, binding, ssboBinding))
+			{
+				m_DeviceStatistics.BindingChanges++;
+				Record(ERenderCommand::BindStorageBuffer, ssboBinding.Buffer.get(), binding, ssboBinding.Offset, ssboBinding.Size);
+			}
+		}
+
+		ApplyShaderUniformResources(state.Shader, state.Uniforms);
+	}
+
+	void NullRenderDevice::ApplyShaderUniformResources(const Shader_ptr& shader, const UniformResources& resources)
+	{
+		if (shader == nullptr) return;
+
+		// Loose uniforms are not reflected, the GL device sets every variable it gets each time
+		size_t variableCount = resources.Uniforms.size();
+		size_t arrayCount = resources.UniformsMat4Arrays.size();
+
+		if (variableCount == 0 && arrayCount == 0)
+			return;
+
+		m_DeviceStatistics.BindCalls += variableCount + arrayCount;
+		Record(ERenderCommand::SetUniforms, shader.get(), 0, variableCount, arrayCount);
+	}
+
+	void NullRenderDevice::ApplyDispatchState(const DispatchState& state)
+	{
+		SetShader(state.Shader);
+		BindShaderResources(state);
+	}
+
+	void NullRenderDevice::ApplyDrawCallState(const DrawCallState& state)
+	{
+		SetShader(state.Shader);
+
+		BindShaderInputs(state, false);
+		BindShaderResources(state);
+
+		BindRenderTargets(state);
+
+		SetBlendState(state.BlendState);
+		SetRasterState(state.RasterState);
+
+		SetDepthStencilState(state.DepthStencilState);
+
+		ClearRenderTargets(state);
+	}
+
+	void NullRenderDevice::BindShaderInputs(const DrawCallState& state, bool force)
+	{
+		if (state.Shader == nullptr || !state.Shader->HasInputLayout() || state.InputLayoutHandle == nullptr)
+			return;
+
+		if (state.InputLayoutHandle != m_LastInputLayout || force)
+		{
+			m_LastInputLayout = state.InputLayoutHandle;
+			m_DeviceStatistics.StateChanges++;
+			Record(ERenderCommand::BindInputLayout, state.InputLayoutHandle.get());
+		}
+
+		for (const auto& [slot, buffer] : state.VertexBuffers)
+		{
+			if (BindSlot(m_BoundVertexBuffers, slot, GetID(buffer.get())))
+			{
+				m_DeviceStatistics.StateChanges++;
+				Record(ERenderCommand::BindVertexBuffer, buffer.get(), slot);
+			}
+		}
+	}
+
+	void NullRenderDevice::BindRenderTargets(const DrawCallState& state)
+	{
+		bool changed = state.DepthTarget.get() != m_LastDepthTarget;
+		uint32_t targetCount = 0;
+
+		for (int i = 0; i < DrawCallState::MaxRenderTargets; ++i)
+		{
+			const TargetBinding& target = state.RenderTargets[i];
+			const TargetBinding& lastTarget = m_LastRenderTargets[i];
+
+			if (target.Texture)
+				targetCount++;
+
+			if (target.Texture != lastTarget.Texture || target.Index != lastTarget.Index || target.MipSlice != lastTarget.MipSlice)
+			{
+				m_LastRenderTargets[i] = target;
+				changed = true;
+			}
+		}
+
+		if (!changed)
+			return;
+
+		m_LastDepthTarget = state.DepthTarget.get();
+		m_DeviceStatistics.StateChanges++;
+		Record(ERenderCommand::BindRenderTargets, state.RenderTargets[0].Texture, 0, targetCount, 0, 0, m_LastDepthTarget);
+	}
+
+	// States are compared member by member, their padding bytes are never initialized
+	void NullRenderDevice::SetBlendState(const FBlendState& state)
+	{
+		if (m_HasBlendState && state == m_LastBlendState)
+			return;
+
+		m_LastBlendState = state;
+		m_HasBlendState = true;
+		m_DeviceStatistics.StateChanges++;
+		Record(ERenderCommand::SetBlendState);
+	}
+
+	void NullRenderDevice::SetRasterState(const FRasterState& rasterState)
+	{
+		if (m_HasRasterState && rasterState == m_LastRasterState)
+			return;
+
+		m_LastRasterState = rasterState;
+		m_HasRasterState = true;
+		m_DeviceStatistics.StateChanges++;
+		Record(ERenderCommand::SetRasterState);
+	}
+
+	void NullRenderDevice::ClearRenderTargets(const DrawCallState& state)
+	{
+		if (state.ClearColorTarget || state.ClearDepthTarget || state.ClearStencilTarget)
+		{
+			Record(ERenderCommand::ClearRenderTargets, nullptr, 0, state.ClearColorTarget, state.ClearDepthTarget, state.ClearStencilTarget);
+		}
+	}
+
+	void NullRenderDevice::SetDepthStencilState(FDepthStencilState state)
+	{
+		if (m_HasDepthState && state == m_LastDepthState)
+			return;
+
+		m_LastDepthState = state;
+		m_HasDepthState = true;
+		m_DeviceStatistics.StateChanges++;
+		Record(ERenderCommand::SetDepthStencilState);
+	}
+
+	void NullRenderDevice::PushDebugGroup(const char* name)
+	{
+		Record(ERenderCommand::PushDebugGroup, name);
+	}
+
+	void NullRenderDevice::PopDebugGroup()
+	{
+		Record(ERenderCommand::PopDebugGroup);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+#include "../Base/IRenderDevice.hpp"
+#include "NullResources.hpp"
+#include "NullShaderProgram.hpp"
+#include "RenderCommandRecorder.hpp"
+
+namespace Aurora
+{
+	struct NullDeviceStatistics
+	{
+		uint32_t StateChanges;		// Shader, targets, vertex input, viewport and fixed function state that really changed
+		uint32_t ShaderChanges;
+		uint32_t BindingChanges;	// Textures, samplers and buffers put on a binding point that held something else
+		uint32_t BindCalls;			// Resources the shaders asked for, bound or not
+		uint64_t BytesUploaded;		// Buffer and texture writes
+		uint64_t BytesMapped;		// Buffers mapped for writing
+	};
+
+	// Render device without a GPU behind it. Resources live in system memory, so writes, copies, maps and reads
+	// behave like on a real device while draws only update the statistics. Redundant binds are filtered per
+	// binding point the same way GLContextState does, which makes the counters comparable between renderers.
+	// An optional recorder captures every command that would have reached the driver.
+	class AU_API NullRenderDevice : public IRenderDevice
+	{
+	private:
+		struct BoundBuffer
+		{
+			UniqueIdentifier ID;
+			uint32_t Offset;
+			uint32_t Size;
+		};
+
+		NullDeviceStatistics m_DeviceStatistics;
+		RenderCommandRecorder* m_Recorder;
+
+		UniqueIdentifier m_LastShader;
+		std::vector<UniqueIdentifier> m_BoundTextures;
+		std::vector<UniqueIdentifier> m_BoundImages;
+		std::vector<UniqueIdentifier> m_BoundSamplers;
+		std::vector<BoundBuffer> m_BoundUniformBuffers;
+		std::vector<BoundBuffer> m_BoundStorageBuffers;
+		std::vector<UniqueIdentifier> m_BoundVertexBuffers;
+		UniqueIdentifier m_BoundIndexBuffer;
+		InputLayout_ptr m_LastInputLayout;
+
+		std::array<TargetBinding, DrawCallState::MaxRenderTargets> m_LastRenderTargets;
+		const ITexture* m_LastDepthTarget;
+		bool m_HasBlendState;
+		bool m_HasRasterState;
+		bool m_HasDepthState;
+
+		FViewPort m_LastViewPort;
+		FBlendState m_LastBlendState;
+		FRasterState m_LastRasterState;
+		FDepthStencilState m_LastDepthState;
+	public:
+		NullRenderDevice();
+		~NullRenderDevice() override = default;
+
+		// Recorder is not owned, pass nullptr to stop recording
+		inline void SetRecorder(RenderCommandRecorder* recorder) noexcept { m_Recorder = recorder; }
+		[[nodiscard]] inline RenderCommandRecorder* GetRecorder() const noexcept { return m_Recorder; }
+
+		[[nodiscard]] inline const NullDeviceStatistics& GetDeviceStatistics() const noexcept { return m_DeviceStatistics; }
+		inline void ResetDeviceStatistics() noexcept { m_DeviceStatistics = {}; }
+
+		// The device is also used directly, keep the convenience overloads visible
+		using IRenderDevice::CreateTexture;
+		using IRenderDevice::CreateBuffer;
+		using IRenderDevice::WriteBuffer;
+		using IRenderDevice::MapBuffer;
+	public:
+		void Init() override;
+		// Shaders
+		Shader_ptr CreateShaderProgram(const ShaderProgramDesc& desc) override;
+		void SetShader(const Shader_ptr& shader) override;
+		// Textures
+		Texture_ptr CreateTexture(const TextureDesc& desc, TextureData textureData) override;
+		void WriteTexture(const Texture_ptr &texture, uint32_t mipLevel, uint32_t subresource, const void *data) override;
+		void ClearTextureFloat(const Texture_ptr& texture, float val) override;
+		void ClearTextureUInt(const Texture_ptr& texture, uint32_t clearColor) override;
+		void GenerateMipmaps(const Texture_ptr& texture) override;
+		bool ReadTexture(const Texture_ptr& texture, std::vector<uint8>& imageBuffer) override;
+		void* GetTextureHandleForBindless(const Texture_ptr& texture, bool srgb) override;
+		bool MakeTextureHandleResident(const Texture_ptr& texture, bool enabled) override;
+		// Buffers
+		Buffer_ptr CreateBuffer(const BufferDesc& desc, const void* data) override;
+		void WriteBuffer(const Buffer_ptr& buffer, const void* data, size_t dataSize, size_t offset) override;
+		void ClearBufferUInt(const Buffer_ptr& buffer, uint32_t clearValue) override;
+		void CopyToBuffer(const Buffer_ptr& dest, uint32_t destOffsetBytes, const Buffer_ptr& src, uint32_t srcOffsetBytes, size_t dataSizeBytes) override;
+		uint8_t* MapBuffer(const Buffer_ptr& buffer, EBufferAccess bufferAccess) override;
+		void UnmapBuffer(const Buffer_ptr& buffer) override;
+		void LockBufferRange(const Buffer_ptr& buffer, size_t offset, size_t size) override;
+		void WaitForBufferRange(const Buffer_ptr& buffer, size_t offset, size_t size) override;
+		[[nodiscard]] uint32_t GetUniformBufferOffsetAlignment() const override { return 256; }
+		[[nodiscard]] uint32_t GetStorageBufferOffsetAlignment() const override { return 16; }
+		// Samplers
+		Sampler_ptr CreateSampler(const SamplerDesc& desc) override;
+		// InputLayout
+		InputLayout_ptr CreateInputLayout(const std::vector<VertexAttributeDesc>& desc) override;
+		// Drawing
+		void Draw(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState) override;
+		void DrawIndexed(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState) override;
+		void DrawIndirect(const DrawCallState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes, uint32_t drawCount) override;
+
+		void Dispatch(const DispatchState& state, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+		void DispatchIndirect(const DispatchState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes) override;
+
+		void InvalidateState() override;
+
+		void Blit(const Texture_ptr &src, const Texture_ptr &dest) override;
+
+		void SetViewPort(const FViewPort& wp) override;
+		[[nodiscard]] const FViewPort& GetCurrentViewPort() const override;
+
+		size_t GetUsedGPUMemory() override;
+	public:
+		void BindShaderResources(const BaseState& state) override;
+		void ApplyShaderUniformResources(const Shader_ptr& shader, const UniformResources& resources) override;
+		void ApplyDispatchState(const DispatchState& state) override;
+		void ApplyDrawCallState(const DrawCallState& state) override;
+		void BindShaderInputs(const DrawCallState &state, bool force) override;
+		void BindRenderTargets(const DrawCallState &state) override;
+		void SetBlendState(const FBlendState& state) override;
+		void SetRasterState(const FRasterState& rasterState) override;
+		void ClearRenderTargets(const DrawCallState &state) override;
+		void SetDepthStencilState(FDepthStencilState state) override;
+
+		void PushDebugGroup(const char* name) override;
+		void PopDebugGroup() override;
+	private:
+		inline void Record(ERenderCommand type, const void* resource = nullptr, uint32_t slot = 0, uint64_t arg0 = 0, uint64_t arg1 = 0, uint64_t arg2 = 0, const void* resource2 = nullptr)
+		{
+			if (m_Recorder)
+				m_Recorder->Record(type, resource, slot, arg0, arg1, arg2, resource2);
+		}
+
+		bool BindSlot(std::vector<UniqueIdentifier>& slots, uint32_t binding, UniqueIdentifier id);
+		bool BindBufferSlot(std::vector<BoundBuffer>& slots, uint32_t binding, const BufferBinding& bufferBinding);
+	};
+}
\ No newline at end of file
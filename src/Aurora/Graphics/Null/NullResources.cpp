@@ -0,0 +1,76 @@
+#include "NullResources.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Aurora
+{
+	static std::atomic<size_t> s_NullResourceMemory = 0;
+
+	size_t GetNullResourceMemory()
+	{
+		return s_NullResourceMemory.load(std::memory_order_relaxed);
+	}
+
+	NullBuffer::NullBuffer(BufferDesc desc) : m_Desc(std::move(desc)), m_Data(m_Desc.ByteSize, 0)
+	{
+		s_NullResourceMemory += m_Data.size();
+	}
+
+	NullBuffer::~NullBuffer()
+	{
+		s_NullResourceMemory -= m_Data.size();
+	}
+
+	NullTexture::NullTexture(TextureDesc desc) : m_Desc(std::move(desc)), m_Data(), m_LayerCount(1)
+	{
+		if (m_Desc.DimensionType == EDimensionType::TYPE_CubeMap)
+		{
+			m_LayerCount = 6;
+		}
+		else if (m_Desc.DimensionType == EDimensionType::TYPE_2DArray || m_Desc.DimensionType == EDimensionType::TYPE_3D)
+		{
+			m_LayerCount = std::max<uint32_t>(1, m_Desc.DepthOrArraySize);
+		}
+	}
+
+	NullTexture::~NullTexture()
+	{
+		s_NullResourceMemory -= m_Data.size();
+	}
+
+	size_t NullTexture::GetMipByteSize(uint32_t mipLevel) const
+	{
+		size_t width = std::max<uint32_t>(1, m_Desc.Width >> mipLevel);
+		size_t height = std::max<uint32_t>(1, m_Desc.Height >> mipLevel);
+		return width * height * GetFormatPixelSize(m_Desc.ImageFormat);
+	}
+
+	size_t NullTexture::GetSubresourceOffset(uint32_t mipLevel, uint32_t layer) const
+	{
+		size_t offset = 0;
+
+		for (uint32_t mip = 0; mip < mipLevel; ++mip)
+		{
+			offset += GetMipByteSize(mip) * m_LayerCount;
+		}
+
+		return offset + GetMipByteSize(mipLevel) * layer;
+	}
+
+	size_t NullTexture::GetByteSize() const
+	{
+		return GetSubresourceOffset(std::max<uint32_t>(1, m_Desc.MipLevels), 0);
+	}
+
+	uint8_t* NullTexture::Data()
+	{
+		if (m_Data.empty())
+		{
+			m_Data.resize(GetByteSize(), 0);
+			s_NullResourceMemory += m_Data.size();
+		}
+
+		return m_Data.data();
+	}
+}
\ No newline at end of file
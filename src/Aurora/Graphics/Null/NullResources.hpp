@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include "../Base/Buffer.hpp"
+#include "../Base/Texture.hpp"
+#include "../Base/Sampler.hpp"
+
+namespace Aurora
+{
+	// Bytes held by all null buffers and textures that are alive
+	AU_API size_t GetNullResourceMemory();
+
+	class AU_API NullBuffer : public IBuffer
+	{
+	private:
+		BufferDesc m_Desc;
+		std::vector<uint8_t> m_Data;
+	public:
+		bool m_Mapped = false;
+
+		explicit NullBuffer(BufferDesc desc);
+		~NullBuffer() override;
+
+		[[nodiscard]] inline uint8_t* Data() noexcept { return m_Data.data(); }
+		[[nodiscard]] inline const uint8_t* Data() const noexcept { return m_Data.data(); }
+		[[nodiscard]] const BufferDesc& GetDesc() const noexcept override { return m_Desc; }
+	};
+
+	// Pixels of all mips and layers in one block, mip by mip with the layers of a mip next to each other.
+	// Storage is allocated by the first write, render targets that are only drawn to never allocate it.
+	class AU_API NullTexture : public ITexture
+	{
+	private:
+		TextureDesc m_Desc;
+		std::vector<uint8_t> m_Data;
+		uint32_t m_LayerCount;
+	public:
+		explicit NullTexture(TextureDesc desc);
+		~NullTexture() override;
+
+		[[nodiscard]] inline uint32_t GetLayerCount() const noexcept { return m_LayerCount; }
+		[[nodiscard]] size_t GetMipByteSize(uint32_t mipLevel) const;
+		[[nodiscard]] size_t GetSubresourceOffset(uint32_t mipLevel, uint32_t layer) const;
+		[[nodiscard]] size_t GetByteSize() const;
+
+		// Allocates the storage when it is needed
+		uint8_t* Data();
+		[[nodiscard]] inline bool HasData() const noexcept { return !m_Data.empty(); }
+
+		[[nodiscard]] const TextureDesc& GetDesc() const override { return m_Desc; }
+		void* GetRawHandle() override { return this; }
+	};
+
+	class AU_API NullSampler : public ISampler
+	{
+	private:
+		SamplerDesc m_Desc;
+	public:
+		explicit NullSampler(SamplerDesc desc) : m_Desc(desc) {}
+
+		[[nodiscard]] const SamplerDesc& GetDesc() const noexcept override { return m_Desc; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,815 @@
+#include "NullShaderProgram.hpp"
+#include "Aurora/Tools/robin_hood.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+namespace Aurora
+{
+	namespace
+	{
+		typedef robin_hood::unordered_map<std::string, std::string> GlslDefines;
+
+		constexpr uint32_t MaxMacroDepth = 8;
+
+		inline bool IsIdentifierStart(char c)
+		{
+			return std::isalpha((unsigned char)c) || c == '_';
+		}
+
+		inline bool IsIdentifierChar(char c)
+		{
+			return std::isalnum((unsigned char)c) || c == '_';
+		}
+
+		inline uint32_t RoundUp(uint32_t value, uint32_t alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		std::vector<std::string> Tokenize(const std::string& text)
+		{
+			static const char* operators[] = {"&&", "||", "==", "!=", "<=", ">="};
+
+			std::vector<std::string> tokens;
+			size_t i = 0;
+
+			while (i < text.size())
+			{
+				if (std::isspace((unsigned char)text[i]))
+				{
+					i++;
+					continue;
+				}
+
+				size_t begin = i;
+
+				if (IsIdentifierStart(text[i]))
+				{
+					while (i < text.size() && IsIdentifierChar(text[i]))
+						i++;
+				}
+				else if (std::isdigit((unsigned char)text[i]))
+				{
+					while (i < text.size() && (IsIdentifierChar(text[i]) || text[i] == '.'))
+						i++;
+				}
+				else
+				{
+					i++;
+
+					for (const char* op : operators)
+					{
+						if (text.compare(begin, 2, op) == 0)
+						{
+							i = begin + 2;
+							break;
+						}
+					}
+				}
+
+				tokens.emplace_back(text, begin, i - begin);
+			}
+
+			return tokens;
+		}
+
+		// Integer expressions of #if and #elif, identifiers that are not defined are 0
+		class ConditionEvaluator
+		{
+		private:
+			const std::vector<std::string>& m_Tokens;
+			const GlslDefines& m_Defines;
+			uint32_t m_Depth;
+			size_t m_Position;
+		public:
+			ConditionEvaluator(const std::vector<std::string>& tokens, const GlslDefines& defines, uint32_t depth)
+				: m_Tokens(tokens), m_Defines(defines), m_Depth(depth), m_Position(0) {}
+
+			int64_t Evaluate()
+			{
+				return ParseOr();
+			}
+		private:
+			[[nodiscard]] const std::string& Peek() const
+			{
+				static const std::string empty;
+				return m_Position < m_Tokens.size() ? m_Tokens[m_Position] : empty;
+			}
+
+			bool Accept(const char* token)
+			{
+				if (Peek() != token)
+					return false;
+
+				m_Position++;
+				return true;
+			}
+
+			int64_t ParseOr()
+			{
+				int64_t value = ParseAnd();
+				while (Accept("||"))
+				{
+					int64_t right = ParseAnd();
+					value = value || right;
+				}
+				return value;
+			}
+
+			int64_t ParseAnd()
+			{
+				int64_t value = ParseEquality();
+				while (Accept("&&"))
+				{
+					int64_t right = ParseEquality();
+					value = value && right;
+				}
+				return value;
+			}
+
+			int64_t ParseEquality()
+			{
+				int64_t value = ParseRelational();
+				while (true)
+				{
+					if (Accept("=="))
+						value = value == ParseRelational();
+					else if (Accept("!="))
+						value = value != ParseRelational();
+					else
+						return value;
+				}
+			}
+
+			int64_t ParseRelational()
+			{
+				int64_t value = ParseAdditive();
+				while (true)
+				{
+					if (Accept("<="))
+						value = value <= ParseAdditive();
+					else if (Accept(">="))
+						value = value >= ParseAdditive();
+					else if (Accept("<"))
+						value = value < ParseAdditive();
+					else if (Accept(">"))
+						value = value > ParseAdditive();
+					else
+						return value;
+				}
+			}
+
+			int64_t ParseAdditive()
+			{
+				int64_t value = ParseUnary();
+				while (true)
+				{
+					if (Accept("+"))
+						value += ParseUnary();
+					else if (Accept("-"))
+						value -= ParseUnary();
+					else
+						return value;
+				}
+			}
+
+			int64_t ParseUnary()
+			{
+				if (Accept("!"))
+					return !ParseUnary();
+				if (Accept("-"))
+					return -ParseUnary();
+				return ParsePrimary();
+			}
+
+			int64_t ParsePrimary()
+			{
+				if (Accept("("))
+				{
+					int64_t value = ParseOr();
+					Accept(")");
+					return value;
+				}
+
+				if (m_Position >= m_Tokens.size())
+					return 0;
+
+				const std::string& token = m_Tokens[m_Position++];
+
+				if (token == "defined")
+				{
+					bool parenthesis = Accept("(");
+					bool isDefined = m_Position < m_Tokens.size() && m_Defines.contains(m_Tokens[m_Position]);
+					m_Position++;
+
+					if (parenthesis)
+						Accept(")");
+
+					return isDefined;
+				}
+
+				if (std::isdigit((unsigned char)token[0]))
+					return std::strtoll(token.c_str(), nullptr, 0);
+
+				auto it = m_Defines.find(token);
+
+				if (it == m_Defines.end() || m_Depth >= MaxMacroDepth)
+					return 0;
+
+				std::vector<std::string> valueTokens = Tokenize(it->second);
+				return ConditionEvaluator(valueTokens, m_Defines, m_Depth + 1).Evaluate();
+			}
+		};
+
+		std::string ExpandMacros(const std::string& text, const GlslDefines& defines, uint32_t depth)
+		{
+			std::string result;
+			result.reserve(text.size());
+
+			for (size_t i = 0; i < text.size();)
+			{
+				// Suffixes of numbers like 1u are not identifiers
+				if (IsIdentifierStart(text[i]) && (i == 0 || !IsIdentifierChar(text[i - 1])))
+				{
+					size_t end = i;
+					while (end < text.size() && IsIdentifierChar(text[end]))
+						end++;
+
+					auto it = defines.find(text.substr(i, end - i));
+
+					if (it != defines.end() && depth < MaxMacroDepth)
+						result += ExpandMacros(it->second, defines, depth + 1);
+					else
+						result.append(text, i, end - i);
+
+					i = end;
+					continue;
+				}
+
+				result += text[i++];
+			}
+
+			return result;
+		}
+
+		struct GlslType
+		{
+			uint32_t Size;			// Without padding
+			uint32_t Std140Size;
+			uint32_t Alignment;
+			uint32_t MatrixStride;
+			uint32_t Columns;
+			GraphicsFormat Format;
+		};
+
+		bool GetGlslType(const std::string& name, GlslType& type)
+		{
+			if (name == "float" || name == "int" || name == "uint" || name == "bool")
+			{
+				type = {4, 4, 4, 0, 1, name == "float" ? GraphicsFormat::R32_FLOAT : GraphicsFormat::R32_UINT};
+				return true;
+			}
+
+			size_t vecPosition = name.find("vec");
+
+			if (vecPosition != std::string::npos && vecPosition <= 1 && name.size() == vecPosition + 4)
+			{
+				uint32_t components = name.back() - '0';
+
+				if (components < 2 || components > 4)
+					return false;
+
+				type = {components * 4, components * 4, components == 2 ? 8u : 16u, 0, 1, GraphicsFormat::Unknown};
+
+				if (vecPosition == 0)
+				{
+					static const GraphicsFormat floatFormats[] = {GraphicsFormat::RG32_FLOAT, GraphicsFormat::RGB32_FLOAT, GraphicsFormat::RGBA32_FLOAT};
+					type.Format = floatFormats[components - 2];
+				}
+				else if (components == 4 && name[0] != 'b')
+				{
+					type.Format = GraphicsFormat::RGBA32_UINT;
+				}
+
+				return true;
+			}
+
+			if (name.rfind("mat", 0) == 0 && (name.size() == 4 || (name.size() == 6 && name[4] == 'x')))
+			{
+				// Columns are padded to a vec4 in std140
+				uint32_t columns = name[3] - '0';
+				uint32_t rows = name.size() == 6 ? name[5] - '0' : columns;
+
+				if (columns < 2 || columns > 4 || rows < 2 || rows > 4)
+					return false;
+
+				type = {columns * rows * 4, columns * 16, 16, 16, columns, GraphicsFormat::RGBA32_FLOAT};
+				return true;
+			}
+
+			return false;
+		}
+
+		bool IsQualifier(const std::string& token)
+		{
+			static const char* qualifiers[] = {
+				"const", "flat", "smooth", "noperspective", "centroid", "sample", "invariant", "precise",
+				"highp", "mediump", "lowp", "readonly", "writeonly", "coherent", "volatile", "restrict"
+			};
+
+			for (const char* qualifier : qualifiers)
+			{
+				if (token == qualifier)
+					return true;
+			}
+
+			return false;
+		}
+
+		struct ReflectedShader
+		{
+			std::vector<ShaderResourceDesc> UniformBlocks;
+			std::vector<ShaderResourceDesc> StorageBlocks;
+			std::vector<ShaderResourceDesc> Samplers;
+			std::vector<ShaderResourceDesc> Images;
+			ShaderInputVariables_t Inputs;
+		};
+
+		// Reads the global declarations of a preprocessed source, function bodies and other statements are skipped
+		class DeclarationParser
+		{
+		private:
+			std::vector<std::string> m_Tokens;
+			size_t m_Position;
+		public:
+			explicit DeclarationParser(const std::string& source) : m_Tokens(Tokenize(source)), m_Position(0) {}
+
+			void Parse(bool readInputs, ReflectedShader& shader)
+			{
+				while (m_Position < m_Tokens.size())
+				{
+					int32_t location = -1;
+					bool isUniform = false;
+					bool isBuffer = false;
+					bool isInput = false;
+
+					while (m_Position < m_Tokens.size())
+					{
+						const std::string& token = m_Tokens[m_Position];
+
+						if (token == "layout")
+						{
+							m_Position++;
+							location = ParseLayout();
+						}
+						else if (token == "uniform")
+						{
+							isUniform = true;
+							m_Position++;
+						}
+						else if (token == "buffer")
+						{
+							isBuffer = true;
+							m_Position++;
+						}
+						else if (token == "in")
+						{
+							isInput = true;
+							m_Position++;
+						}
+						else if (IsQualifier(token))
+						{
+							m_Position++;
+						}
+						else
+						{
+							break;
+						}
+					}
+
+					if ((isUniform || isBuffer) && Peek(1) == "{")
+					{
+						ShaderResourceDesc block;
+						block.Name = m_Tokens[m_Position];
+						block.Type = isUniform ? ShaderResourceType::ConstantBuffer : ShaderResourceType::BufferUAV;
+						block.ArraySize = 1;
+						m_Position += 2;
+
+						ParseBlockMembers(block);
+						SkipStatement(); // Instance name
+
+						(isUniform ? shader.UniformBlocks : shader.StorageBlocks).emplace_back(std::move(block));
+						continue;
+					}
+
+					if (isUniform && m_Position + 1 < m_Tokens.size())
+					{
+						const std::string& typeName = m_Tokens[m_Position];
+						bool isSampler = typeName.find("sampler") != std::string::npos;
+						bool isImage = typeName.find("image") != std::string::npos;
+
+						if (isSampler || isImage)
+						{
+							ShaderResourceDesc resource;
+							resource.Name = m_Tokens[m_Position + 1];
+							resource.Type = isSampler ? ShaderResourceType::Sampler : ShaderResourceType::TextureUAV;
+							m_Position += 2;
+							resource.ArraySize = std::max<uint32_t>(1, ParseArraySize());
+
+							(isSampler ? shader.Samplers : shader.Images).emplace_back(std::move(resource));
+						}
+					}
+					else if (isInput && readInputs && location >= 0 && m_Position + 1 < m_Tokens.size())
+					{
+						ParseInput(location, shader.Inputs);
+					}
+
+					SkipStatement();
+				}
+			}
+		private:
+			[[nodiscard]] const std::string& Peek(size_t offset = 0) const
+			{
+				static const std::string empty;
+				return m_Position + offset < m_Tokens.size() ? m_Tokens[m_Position + offset] : empty;
+			}
+
+			// Returns the location when there is one
+			int32_t ParseLayout()
+			{
+				int32_t location = -1;
+
+				if (Peek() != "(")
+					return location;
+
+				for (m_Position++; m_Position < m_Tokens.size() && m_Tokens[m_Position] != ")"; ++m_Position)
+				{
+					if (m_Tokens[m_Position] == "location" && Peek(1) == "=" && !Peek(2).empty())
+					{
+						location = (int32_t)std::strtol(Peek(2).c_str(), nullptr, 0);
+					}
+				}
+
+				m_Position++;
+				return location;
+			}
+
+			// Product of all dimensions, 1 without brackets, 0 for unsized arrays
+			uint32_t ParseArraySize()
+			{
+				uint32_t arraySize = 1;
+
+				while (Peek() == "[")
+				{
+					m_Position++;
+
+					if (Peek() == "]")
+						arraySize = 0;
+					else if (std::isdigit((unsigned char)Peek()[0]))
+						arraySize *= (uint32_t)std::strtoul(Peek().c_str(), nullptr, 0);
+
+					while (m_Position < m_Tokens.size() && m_Tokens[m_Position] != "]")
+						m_Position++;
+
+					m_Position++;
+				}
+
+				return arraySize;
+			}
+
+			void ParseBlockMembers(ShaderResourceDesc& block)
+			{
+				uint32_t offset = 0;
+
+				while (m_Position < m_Tokens.size() && Peek() != "}")
+				{
+					while (Peek() == "layout" || IsQualifier(Peek()))
+					{
+						if (m_Tokens[m_Position++] == "layout")
+							ParseLayout();
+					}
+
+					GlslType type = {};
+
+					// Structs count as one vec4
+					if (!GetGlslType(m_Tokens[m_Position++], type))
+						type = {16, 16, 16, 0, 1, GraphicsFormat::Unknown};
+
+					while (m_Position < m_Tokens.size())
+					{
+						std::string name = m_Tokens[m_Position++];
+						bool isArray = Peek() == "[";
+						uint32_t arraySize = ParseArraySize();
+
+						uint32_t alignment = type.Alignment;
+						uint32_t size = type.Std140Size;
+						uint32_t arrayStride = 0;
+
+						if (isArray)
+						{
+							arrayStride = RoundUp(type.Std140Size, 16);
+							alignment = 16;
+							size = arrayStride * arraySize;
+						}
+
+						offset = RoundUp(offset, alignment);
+						block.Variables.emplace_back(std::move(name), type.Size * std::max<uint32_t>(1, arraySize), offset, arrayStride, type.MatrixStride);
+						offset += size;
+
+						if (Peek() != ",")
+							break;
+
+						m_Position++;
+					}
+
+					if (Peek() == ";")
+						m_Position++;
+				}
+
+				if (Peek() == "}")
+					m_Position++;
+
+				block.Size = RoundUp(offset, 16);
+			}
+
+			void ParseInput(int32_t location, ShaderInputVariables_t& inputs)
+			{
+				GlslType type = {};
+
+				if (!GetGlslType(m_Tokens[m_Position], type) || type.Format == GraphicsFormat::Unknown)
+					return;
+
+				const std::string& name = m_Tokens[m_Position + 1];
+
+				// Matrices take one location per column, like the driver reports them
+				if (type.Columns > 1)
+				{
+					for (uint32_t column = 0; column < type.Columns; ++column)
+						inputs[location + column] = {name, 16, GraphicsFormat::RGBA32_FLOAT, true, location + (int32_t)column};
+					return;
+				}
+
+				inputs[location] = {name, type.Size, type.Format, name.find("_INSTANCED") != std::string::npos, location};
+			}
+
+			void SkipBraces()
+			{
+				uint32_t depth = 1;
+
+				while (m_Position < m_Tokens.size() && depth > 0)
+				{
+					const std::string& token = m_Tokens[m_Position++];
+
+					if (token == "{")
+						depth++;
+					else if (token == "}")
+						depth--;
+				}
+			}
+
+			// Up to the next semicolon, or past a function body or struct definition
+			void SkipStatement()
+			{
+				while (m_Position < m_Tokens.size())
+				{
+					const std::string& token = m_Tokens[m_Position++];
+
+					if (token == ";")
+						return;
+
+					if (token == "{")
+					{
+						SkipBraces();
+
+						if (Peek() == ";")
+							m_Position++;
+
+						return;
+					}
+				}
+			}
+		};
+
+		const char* GetStageDefine(EShaderType type)
+		{
+			switch (type)
+			{
+				case EShaderType::Vertex: return "SHADER_VERTEX";
+				case EShaderType::Hull: return "SHADER_HULL";
+				case EShaderType::Domain: return "SHADER_DOMAIN";
+				case EShaderType::Geometry: return "SHADER_GEOMETRY";
+				case EShaderType::Pixel: return "SHADER_PIXEL";
+				case EShaderType::Compute: return "SHADER_COMPUTE";
+				default: return nullptr;
+			}
+		}
+
+		void MergeResources(std::vector<ShaderResourceDesc>& resources, std::vector<ShaderResourceDesc>& stageResources, EShaderType stage)
+		{
+			for (ShaderResourceDesc& resource : stageResources)
+			{
+				auto it = std::find_if(resources.begin(), resources.end(), [&resource](const ShaderResourceDesc& other) { return other.Name == resource.Name; });
+
+				if (it != resources.end())
+					continue;
+
+				resource.NameID = Hash_djb2(resource.Name.c_str());
+				resource.ShadersIn = stage;
+				resources.emplace_back(std::move(resource));
+			}
+		}
+	}
+
+	std::string PreprocessGlsl(const std::string& source, const ShaderMacros& macros)
+	{
+		struct Conditional
+		{
+			bool ParentActive;
+			bool Taken;
+		};
+
+		GlslDefines defines;
+		for (const auto& [name, value] : macros)
+		{
+			defines[name] = value;
+		}
+
+		std::vector<Conditional> conditionals;
+		bool active = true;
+		bool inComment = false;
+
+		std::string output;
+		output.reserve(source.size());
+
+		std::istringstream input(source);
+		std::string line;
+		std::string code;
+
+		while (std::getline(input, line))
+		{
+			code.clear();
+
+			for (size_t i = 0; i < line.size(); ++i)
+			{
+				if (inComment)
+				{
+					if (line.compare(i, 2, "*/") == 0)
+					{
+						inComment = false;
+						i++;
+					}
+					continue;
+				}
+
+				if (line.compare(i, 2, "/*") == 0)
+				{
+					inComment = true;
+					i++;
+					continue;
+				}
+
+				if (line.compare(i, 2, "//") == 0)
+					break;
+
+				code += line[i];
+			}
+
+			size_t first = code.find_first_not_of(" \t\r");
+
+			if (first == std::string::npos)
+				continue;
+
+			if (code[first] != '#')
+			{
+				if (active)
+				{
+					output += ExpandMacros(code, defines, 0);
+					output += '\n';
+				}
+				continue;
+			}
+
+			std::vector<std::string> tokens = Tokenize(code.substr(first + 1));
+
+			if (tokens.empty())
+				continue;
+
+			const std::string& directive = tokens[0];
+
+			if (directive == "if" || directive == "ifdef" || directive == "ifndef")
+			{
+				bool condition = false;
+
+				if (active)
+				{
+					if (directive == "if")
+					{
+						std::vector<std::string> expression(tokens.begin() + 1, tokens.end());
+						condition = ConditionEvaluator(expression, defines, 0).Evaluate() != 0;
+					}
+					else
+					{
+						bool isDefined = tokens.size() > 1 && defines.contains(tokens[1]);
+						condition = directive == "ifdef" ? isDefined : !isDefined;
+					}
+				}
+
+				conditionals.push_back({active, condition});
+				active = active && condition;
+			}
+			else if (directive == "elif" && !conditionals.empty())
+			{
+				Conditional& conditional = conditionals.back();
+				bool condition = false;
+
+				if (conditional.ParentActive && !conditional.Taken)
+				{
+					std::vector<std::string> expression(tokens.begin() + 1, tokens.end());
+					condition = ConditionEvaluator(expression, defines, 0).Evaluate() != 0;
+				}
+
+				conditional.Taken |= condition;
+				active = condition;
+			}
+			else if (directive == "else" && !conditionals.empty())
+			{
+				Conditional& conditional = conditionals.back();
+				active = conditional.ParentActive && !conditional.Taken;
+				conditional.Taken = true;
+			}
+			else if (directive == "endif" && !conditionals.empty())
+			{
+				active = conditionals.back().ParentActive;
+				conditionals.pop_back();
+			}
+			else if (active && directive == "define" && tokens.size() > 1)
+			{
+				size_t nameEnd = code.find(tokens[1], code.find("define", first) + 6) + tokens[1].size();
+
+				// Function-like macros are not expanded
+				if (nameEnd < code.size() && code[nameEnd] == '(')
+					continue;
+
+				size_t valueBegin = code.find_first_not_of(" \t", nameEnd);
+				size_t valueEnd = code.find_last_not_of(" \t\r");
+				defines[tokens[1]] = valueBegin == std::string::npos ? std::string() : code.substr(valueBegin, valueEnd - valueBegin + 1);
+			}
+			else if (active && directive == "undef" && tokens.size() > 1)
+			{
+				defines.erase(tokens[1]);
+			}
+		}
+
+		return output;
+	}
+
+	NullShaderProgram::NullShaderProgram(ShaderProgramDesc desc) : m_Desc(std::move(desc))
+	{
+		for (const auto& [type, shaderDesc] : m_Desc.GetShaderDescriptions())
+		{
+			Reflect(shaderDesc);
+		}
+	}
+
+	void NullShaderProgram::Reflect(const ShaderDesc& shaderDesc)
+	{
+		ShaderMacros macros = shaderDesc.Macros;
+
+		if (const char* stageDefine = GetStageDefine(shaderDesc.Type))
+			macros[stageDefine] = "";
+
+		ReflectedShader reflected;
+		DeclarationParser(PreprocessGlsl(shaderDesc.Source, macros)).Parse(shaderDesc.Type == EShaderType::Vertex, reflected);
+
+		MergeResources(m_UniformBlocks, reflected.UniformBlocks, shaderDesc.Type);
+		MergeResources(m_StorageBlocks, reflected.StorageBlocks, shaderDesc.Type);
+		MergeResources(m_Samplers, reflected.Samplers, shaderDesc.Type);
+		MergeResources(m_Images, reflected.Images, shaderDesc.Type);
+
+		if (shaderDesc.Type == EShaderType::Vertex)
+		{
+			m_InputVariables = std::move(reflected.Inputs);
+		}
+	}
+
+	std::vector<ShaderResourceDesc> NullShaderProgram::GetResources(const ShaderResourceType& resourceType)
+	{
+		switch (resourceType)
+		{
+			case ShaderResourceType::ConstantBuffer:
+				return m_UniformBlocks;
+			case ShaderResourceType::Sampler:
+			case ShaderResourceType::TextureSRV:
+				return m_Samplers;
+			case ShaderResourceType::TextureUAV:
+				return m_Images;
+			case ShaderResourceType::BufferUAV:
+				return m_StorageBlocks;
+			default:
+				return {};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../Base/ShaderBase.hpp"
+
+namespace Aurora
+{
+	// Shader program that is never compiled. Resources are reflected from the GLSL sources: the sources are run through
+	// a small preprocessor with the macros of the program, then samplers, images, uniform blocks with std140 offsets,
+	// storage blocks and vertex inputs with an explicit location are read from the declarations. Unlike the driver it
+	// also reports resources the shader declares but never uses. Binding points follow the declaration order.
+	class AU_API NullShaderProgram : public IShaderProgram
+	{
+	private:
+		const ShaderProgramDesc m_Desc;
+		std::vector<ShaderResourceDesc> m_UniformBlocks;
+		std::vector<ShaderResourceDesc> m_StorageBlocks;
+		std::vector<ShaderResourceDesc> m_Samplers;
+		std::vector<ShaderResourceDesc> m_Images;
+		ShaderInputVariables_t m_InputVariables;
+	public:
+		explicit NullShaderProgram(ShaderProgramDesc desc);
+	public:
+		[[nodiscard]] const ShaderProgramDesc& GetDesc() const override { return m_Desc; }
+		[[nodiscard]] std::vector<ShaderResourceDesc> GetResources(const ShaderResourceType& resourceType) override;
+
+		[[nodiscard]] inline bool HasInputLayout() const noexcept override { return !m_InputVariables.empty(); }
+		[[nodiscard]] inline uint8_t GetInputVariablesCount() const noexcept override { return m_InputVariables.size(); }
+		[[nodiscard]] inline const ShaderInputVariables_t& GetInputVariables() const noexcept override { return m_InputVariables; }
+	public:
+		[[nodiscard]] inline const std::vector<ShaderResourceDesc>& GetUniformBlocks() const noexcept { return m_UniformBlocks; }
+		[[nodiscard]] inline const std::vector<ShaderResourceDesc>& GetStorageBlocks() const noexcept { return m_StorageBlocks; }
+		[[nodiscard]] inline const std::vector<ShaderResourceDesc>& GetSamplers() const noexcept { return m_Samplers; }
+		[[nodiscard]] inline const std::vector<ShaderResourceDesc>& GetImages() const noexcept { return m_Images; }
+	private:
+		void Reflect(const ShaderDesc& shaderDesc);
+	};
+
+	// Runs the conditionals and object-like macros of a GLSL source, the lines that are left are returned without comments
+	AU_API std::string PreprocessGlsl(const std::string& source, const ShaderMacros& macros);
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "RenderCommandRecorder.hpp"
+
+#include <algorithm>
+
+namespace Aurora
+{
+	const char* RenderCommandToString(ERenderCommand command)
+	{
+		switch (command)
+		{
+			case ERenderCommand::SetShader: return "SetShader";
+			case ERenderCommand::BindRenderTargets: return "BindRenderTargets";
+			case ERenderCommand::ClearRenderTargets: return "ClearRenderTargets";
+			case ERenderCommand::SetViewPort: return "SetViewPort";
+			case ERenderCommand::SetBlendState: return "SetBlendState";
+			case ERenderCommand::SetRasterState: return "SetRasterState";
+			case ERenderCommand::SetDepthStencilState: return "SetDepthStencilState";
+			case ERenderCommand::BindTexture: return "BindTexture";
+			case ERenderCommand::BindSampler: return "BindSampler";
+			case ERenderCommand::BindUniformBuffer: return "BindUniformBuffer";
+			case ERenderCommand::BindStorageBuffer: return "BindStorageBuffer";
+			case ERenderCommand::BindVertexBuffer: return "BindVertexBuffer";
+			case ERenderCommand::BindIndexBuffer: return "BindIndexBuffer";
+			case ERenderCommand::BindInputLayout: return "BindInputLayout";
+			case ERenderCommand::SetUniforms: return "SetUniforms";
+			case ERenderCommand::WriteBuffer: return "WriteBuffer";
+			case ERenderCommand::CopyBuffer: return "CopyBuffer";
+			case ERenderCommand::ClearBuffer: return "ClearBuffer";
+			case ERenderCommand::MapBuffer: return "MapBuffer";
+			case ERenderCommand::LockBufferRange: return "LockBufferRange";
+			case ERenderCommand::WaitForBufferRange: return "WaitForBufferRange";
+			case ERenderCommand::WriteTexture: return "WriteTexture";
+			case ERenderCommand::ClearTexture: return "ClearTexture";
+			case ERenderCommand::GenerateMipmaps: return "GenerateMipmaps";
+			case ERenderCommand::Blit: return "Blit";
+			case ERenderCommand::Draw: return "Draw";
+			case ERenderCommand::DrawIndexed: return "DrawIndexed";
+			case ERenderCommand::DrawIndirect: return "DrawIndirect";
+			case ERenderCommand::Dispatch: return "Dispatch";
+			case ERenderCommand::DispatchIndirect: return "DispatchIndirect";
+			case ERenderCommand::PushDebugGroup: return "PushDebugGroup";
+			case ERenderCommand::PopDebugGroup: return "PopDebugGroup";
+			default: return "Unknown";
+		}
+	}
+
+	RenderCommandRecorder::RenderCommandRecorder() : m_Commands(), m_Counts((size_t)ERenderCommand::Count, 0)
+	{
+
+	}
+
+	void RenderCommandRecorder::Clear()
+	{
+		m_Commands.clear();
+		std::fill(m_Counts.begin(), m_Counts.end(), 0);
+	}
+
+	void RenderCommandRecorder::Write(std::ostream& stream) const
+	{
+		for (const RenderCommand& command : m_Commands)
+		{
+			stream << RenderCommandToString(command.Type) << " slot " << command.Slot << " " << command.Resource << " " << command.Resource2
+				<< " " << command.Args[0] << " " << command.Args[1] << " " << command.Args[2] << "\n";
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "Aurora/Core/Library.hpp"
+
+namespace Aurora
+{
+	enum class ERenderCommand : uint8_t
+	{
+		SetShader = 0,		// Resource: shader
+		BindRenderTargets,	// Resource: first color target, Resource2: depth target, Args: color target count
+		ClearRenderTargets,	// Args: clear color, clear depth, clear stencil
+		SetViewPort,		// Args: x | y << 32, width, height
+		SetBlendState,
+		SetRasterState,
+		SetDepthStencilState,
+		BindTexture,		// Slot: binding point, Resource: texture
+		BindSampler,		// Slot: binding point, Resource: sampler
+		BindUniformBuffer,	// Slot: binding point, Resource: buffer, Args: offset, size
+		BindStorageBuffer,	// Slot: binding point, Resource: buffer, Args: offset, size
+		BindVertexBuffer,	// Slot: vertex buffer slot, Resource: buffer
+		BindIndexBuffer,	// Resource: buffer, Args: index format
+		BindInputLayout,	// Resource: input layout
+		SetUniforms,		// Resource: shader, Args: variable count, matrix array count
+		WriteBuffer,		// Resource: buffer, Args: offset, size
+		CopyBuffer,			// Resource: destination, Resource2: source, Args: destination offset, source offset, size
+		ClearBuffer,		// Resource: buffer, Args: clear value
+		MapBuffer,			// Resource: buffer, Args: access
+		LockBufferRange,	// Resource: buffer, Args: offset, size
+		WaitForBufferRange,	// Resource: buffer, Args: offset, size
+		WriteTexture,		// Slot: mip level, Resource: texture, Args: subresource, size
+		ClearTexture,		// Resource: texture
+		GenerateMipmaps,	// Resource: texture
+		Blit,				// Resource: source, Resource2: destination
+		Draw,				// Resource: shader, Args: vertex count, instance count, first vertex
+		DrawIndexed,		// Resource: shader, Args: index count, instance count, first index
+		DrawIndirect,		// Resource: shader, Resource2: indirect buffer, Args: offset, draw count
+		Dispatch,			// Resource: shader, Args: groups x, y, z
+		DispatchIndirect,	// Resource: shader, Resource2: indirect buffer, Args: offset
+		PushDebugGroup,
+		PopDebugGroup,
+		Count
+	};
+
+	AU_API const char* RenderCommandToString(ERenderCommand command);
+
+	// Resources are kept as raw pointers, a recording never extends their lifetime and must not be dereferenced later
+	struct RenderCommand
+	{
+		ERenderCommand Type;
+		uint32_t Slot;
+		const void* Resource;
+		const void* Resource2;
+		uint64_t Args[3];
+	};
+
+	// Captures the calls made on a NullRenderDevice, with their arguments, in order
+	class AU_API RenderCommandRecorder
+	{
+	private:
+		std::vector<RenderCommand> m_Commands;
+		std::vector<uint32_t> m_Counts;
+	public:
+		RenderCommandRecorder();
+
+		inline void Record(ERenderCommand type, const void* resource = nullptr, uint32_t slot = 0, uint64_t arg0 = 0, uint64_t arg1 = 0, uint64_t arg2 = 0, const void* resource2 = nullptr)
+		{
+			m_Commands.push_back({type, slot, resource, resource2, {arg0, arg1, arg2}});
+			m_Counts[(size_t)type]++;
+		}
+
+		void Clear();
+
+		[[nodiscard]] inline const std::vector<RenderCommand>& GetCommands() const noexcept { return m_Commands; }
+		[[nodiscard]] inline uint32_t GetCount(ERenderCommand type) const { return m_Counts[(size_t)type]; }
+
+		// One command per line, for diffing two recordings
+		void Write(std::ostream& stream) const;
+	};
+}
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "../Base/Buffer.hpp"
 #include "GL.hpp"
+#include "GLBufferLock.hpp"
+
+#include <memory>
 
 namespace Aurora
 {
@@ -14,6 +17,8 @@ namespace Aurora
 		GLenum m_Usage;
 	public:
 		uint8_t* m_MappedData = nullptr;
+		// Only DMA buffers, their memory stays mapped while the GPU reads it
+		std::unique_ptr<BufferLockManager> m_LockManager = nullptr;
 
 		GLBuffer(BufferDesc desc, GLuint handle, GLenum bindTarget, GLenum usage);
 		~GLBuffer() override;
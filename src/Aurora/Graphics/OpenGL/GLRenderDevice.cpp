@@ -83,7 +83,9 @@ namespace Aurora
 	m_LastDepthState(),
 	m_LastViewPort(0, 0),
 	m_LastInputLayout(nullptr),
-	m_GpuVendor(EGpuVendor::Unknown)
+	m_GpuVendor(EGpuVendor::Unknown),
+	m_UniformBufferOffsetAlignment(256),
+	m_StorageBufferOffsetAlignment(16)
 	{
 
 	}
@@ -158,12 +160,14 @@ namespace Aurora
 			GLint size;
 			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &size);
 			AU_LOG_INFO("GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT is ", size);
+			m_UniformBufferOffsetAlignment = size;
 		}
 
 		{
 			GLint size;
 			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &size);
 			AU_LOG_INFO("GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT is ", size);
+			m_StorageBufferOffsetAlignment = size;
 		}
 
 		glDisable(GL_MULTISAMPLE);
@@ -263,6 +267,12 @@ namespace Aurora
 				glslSourcePreprocessed.insert(18, ext);
 			}
 
+			// gl_BaseInstanceARB indexes the instance storage block of multi draw indirect
+			if (type == EShaderType::Vertex && shaderDesc.Macros.contains("INDIRECT_DRAW"))
+			{
+				glslSourcePreprocessed.insert(18, "#extension GL_ARB_shader_draw_parameters : enable\n");
+			}
+
 			std::string error;
 			GLuint shaderID = CompileShaderRaw(glslSourcePreprocessed, type, &error);
 
@@ -736,6 +746,11 @@ namespace Aurora
 
 		auto buffer = std::make_shared<GLBuffer>(desc, handle, bindTarget, usage);
 		buffer->m_MappedData = mappedData;
+
+		if (desc.IsDMA)
+		{
+			buffer->m_LockManager = std::make_unique<BufferLockManager>(true);
+		}
 		return buffer;
 	}
 
@@ -798,15 +813,16 @@ namespace Aurora
 
 	void GLRenderDevice::CopyToBuffer(const Buffer_ptr &dest, uint32_t destOffsetBytes, const Buffer_ptr &src, uint32_t srcOffsetBytes, size_t dataSizeBytes)
 	{
-		if (dest == nullptr)
+		if (dest == nullptr || src == nullptr)
 		{
 			return;
 		}
 
-		auto* glBuffer = static_cast<GLBuffer*>(dest.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+		auto* glDestBuffer = static_cast<GLBuffer*>(dest.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+		auto* glSrcBuffer = static_cast<GLBuffer*>(src.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
 
-		glBindBuffer(GL_COPY_WRITE_BUFFER, glBuffer->Handle());
-		glBindBuffer(GL_COPY_READ_BUFFER, glBuffer->Handle());
+		glBindBuffer(GL_COPY_WRITE_BUFFER, glDestBuffer->Handle());
+		glBindBuffer(GL_COPY_READ_BUFFER, glSrcBuffer->Handle());
 
 		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffsetBytes, destOffsetBytes, GLsizeiptr(dataSizeBytes));
 
@@ -849,6 +865,38 @@ namespace Aurora
 		glBindBuffer(glBuffer->BindTarget(), GL_NONE);
 	}
 
+	void GLRenderDevice::LockBufferRange(const Buffer_ptr& buffer, size_t offset, size_t size)
+	{
+		if (buffer == nullptr)
+		{
+			return;
+		}
+
+		auto* glBuffer = static_cast<GLBuffer*>(buffer.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+
+		if (glBuffer->m_LockManager)
+		{
+			glBuffer->m_LockManager->LockRange(offset, size);
+		}
+	}
+
+	void GLRenderDevice::WaitForBufferRange(const Buffer_ptr& buffer, size_t offset, size_t size)
+	{
+		CPU_DEBUG_SCOPE("GLRenderDevice::WaitForBufferRange");
+
+		if (buffer == nullptr)
+		{
+			return;
+		}
+
+		auto* glBuffer = static_cast<GLBuffer*>(buffer.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+
+		if (glBuffer->m_LockManager)
+		{
+			glBuffer->m_LockManager->WaitForLockedRange(offset, size);
+		}
+	}
+
 	Sampler_ptr GLRenderDevice::CreateSampler(const SamplerDesc &desc)
 	{
 		GLuint handle = 0;
@@ -1000,10 +1048,15 @@ namespace Aurora
 		m_FrameRenderStatistics.DrawCalls++;
 	}
 
-	void GLRenderDevice::DrawIndirect(const DrawCallState &state, const Buffer_ptr &indirectParams, uint32_t offsetBytes)
+	void GLRenderDevice::DrawIndirect(const DrawCallState &state, const Buffer_ptr &indirectParams, uint32_t offsetBytes, uint32_t drawCount)
 	{
 		CPU_DEBUG_SCOPE("DrawIndirect");
 
+		if (state.IndexBuffer.Buffer == nullptr || indirectParams == nullptr || drawCount == 0)
+		{
+			return;
+		}
+
 		GLenum primitiveType = ConvertPrimType(state.PrimitiveType);
 		GLenum ibFormat = ConvertIndexBufferFormat(state.IndexBuffer.Format);
 
@@ -1012,9 +1065,9 @@ namespace Aurora
 
 		GLBuffer* ib = GetBuffer(indirectParams);
 		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, ib->Handle());
-		//glDrawElementsIndirect(primitiveType, ibFormat, nullptr);
 
-		glMultiDrawElementsIndirect(primitiveType, ibFormat, (const void*)0, offsetBytes, sizeof(DrawElementsIndirectCommand));
+		glMultiDrawElementsIndirect(primitiveType, ibFormat, BUFFER_OFFSET(offsetBytes), GLsizei(drawCount), sizeof(DrawElementsIndirectCommand));
+		m_FrameRenderStatistics.DrawCalls++;
 	}
 
 	void GLRenderDevice::ApplyDrawCallState(const DrawCallState &state)
@@ -1303,22 +1356,11 @@ namespace Aurora
 
 		for (const auto& imageResource : shader->GetGLResource().GetSamplers())
 		{
-			auto boundTextureIt = state.BoundTextures.find(imageResource.Name);
-
-			const TextureBinding* targetTextureBinding = nullptr;
-
-			if (boundTextureIt == state.BoundTextures.end())
-			{
-				m_ContextState.BindTexture(imageResource.Binding, nullptr);
-				continue;
-			}
-
-			targetTextureBinding = &boundTextureIt->second;
+			const TextureBinding* targetTextureBinding = state.BoundTextures.Find(imageResource.NameID);
 
 			if (targetTextureBinding == nullptr)
 			{
 				m_ContextState.BindTexture(imageResource.Binding, nullptr);
-				// TODO: Set placeholder texture or throw error
 				continue;
 			}
 
@@ -1338,21 +1380,11 @@ namespace Aurora
 
 		for (const auto& imageResource : shader->GetGLResource().GetImages())
 		{
-			auto boundTextureIt = state.BoundTextures.find(imageResource.Name);
-
-			const TextureBinding* targetTextureBinding = nullptr;
-
-			if (boundTextureIt == state.BoundTextures.end())
-			{
-				m_ContextState.BindImage(imageResource.Binding, nullptr, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGB16F);
-				continue;
-			}
-
-			targetTextureBinding = &boundTextureIt->second;
+			const TextureBinding* targetTextureBinding = state.BoundTextures.Find(imageResource.NameID);
 
 			if (targetTextureBinding == nullptr)
 			{
-				// TODO: Set placeholder texture or throw error
+				m_ContextState.BindImage(imageResource.Binding, nullptr, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGB16F);
 				continue;
 			}
 
@@ -1386,12 +1418,12 @@ namespace Aurora
 		// TODO: Samplers
 		for(const auto& samplerResource : shader->GetGLResource().GetSamplers())
 		{
-			auto boundSamplerIt = state.BoundSamplers.find(samplerResource.Name);
+			const Sampler_ptr* boundSampler = state.BoundSamplers.Find(samplerResource.NameID);
 
 			Sampler_ptr targetSampler = nullptr;
 
-			if (boundSamplerIt != state.BoundSamplers.end()) {
-				targetSampler = boundSamplerIt->second;
+			if (boundSampler != nullptr) {
+				targetSampler = *boundSampler;
 			}
 
 			m_ContextState.BindSampler(samplerResource.Binding, GetSampler(targetSampler));
@@ -1400,12 +1432,12 @@ namespace Aurora
 		// binding constant buffers
 		for(const auto& uniformResource : shader->GetGLResource().GetUniformBlocks())
 		{
-			auto uniformBufferIt = state.BoundUniformBuffers.find(uniformResource.Name);
+			const BufferBinding* boundBuffer = state.BoundUniformBuffers.Find(uniformResource.NameID);
 
 			BufferBinding uniformBinding;
 
-			if (uniformBufferIt != state.BoundUniformBuffers.end()) {
-				uniformBinding = uniformBufferIt->second;
+			if (boundBuffer != nullptr) {
+				uniformBinding = *boundBuffer;
 			}
 
 			GLBuffer* glBuffer = nullptr;
@@ -1431,12 +1463,12 @@ namespace Aurora
 		// binding ssbo`s
 		for (const auto& uniformResource : shader->GetGLResource().GetStorageBlocks())
 		{
-			auto ssboIt = state.SSBOBuffers.find(uniformResource.Name);
+			const BufferBinding* boundBuffer = state.SSBOBuffers.Find(uniformResource.NameID);
 
 			BufferBinding ssboBinding;
 
-			if (ssboIt != state.SSBOBuffers.end()) {
-				ssboBinding = ssboIt->second;
+			if (boundBuffer != nullptr) {
+				ssboBinding = *boundBuffer;
 			}
 
 			GLBuffer* glBuffer = nullptr;
@@ -2112,6 +2144,16 @@ namespace Aurora
 		return m_LastViewPort;
 	}
 
+	void GLRenderDevice::PushDebugGroup(const char* name)
+	{
+		glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, static_cast<GLsizei>(strlen(name)), name);
+	}
+
+	void GLRenderDevice::PopDebugGroup()
+	{
+		glPopDebugGroup();
+	}
+
 	size_t GLRenderDevice::GetUsedGPUMemory()
 	{
 		if (m_GpuVendor == EGpuVendor::Nvidia)
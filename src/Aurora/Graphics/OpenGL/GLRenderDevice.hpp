@@ -156,6 +156,8 @@ namespace Aurora
 		Shader_ptr m_BlitShader;
 
 		EGpuVendor m_GpuVendor;
+		uint32_t m_UniformBufferOffsetAlignment;
+		uint32_t m_StorageBufferOffsetAlignment;
 	public:
 		GLRenderDevice();
 		~GLRenderDevice() override;
@@ -183,6 +185,10 @@ namespace Aurora
 		void CopyToBuffer(const Buffer_ptr& dest, uint32_t destOffsetBytes, const Buffer_ptr& src, uint32_t srcOffsetBytes, size_t dataSizeBytes) override;
 		uint8_t* MapBuffer(const Buffer_ptr& buffer, EBufferAccess bufferAccess) override;
 		void UnmapBuffer(const Buffer_ptr& buffer) override;
+		void LockBufferRange(const Buffer_ptr& buffer, size_t offset, size_t size) override;
+		void WaitForBufferRange(const Buffer_ptr& buffer, size_t offset, size_t size) override;
+		[[nodiscard]] uint32_t GetUniformBufferOffsetAlignment() const override { return m_UniformBufferOffsetAlignment; }
+		[[nodiscard]] uint32_t GetStorageBufferOffsetAlignment() const override { return m_StorageBufferOffsetAlignment; }
 		// Samplers
 		Sampler_ptr CreateSampler(const SamplerDesc& desc) override;
 		// InputLayout
@@ -190,7 +196,7 @@ namespace Aurora
 		// Drawing
 		void Draw(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState) override;
 		void DrawIndexed(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState) override;
-		void DrawIndirect(const DrawCallState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes) override;
+		void DrawIndirect(const DrawCallState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes, uint32_t drawCount) override;
 
 		void Dispatch(const DispatchState& state, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
 		void DispatchIndirect(const DispatchState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes) override;
@@ -216,6 +222,9 @@ namespace Aurora
 		void ClearRenderTargets(const DrawCallState &state) override;
 		void SetDepthStencilState(FDepthStencilState state) override;
 
+		void PushDebugGroup(const char* name) override;
+		void PopDebugGroup() override;
+
 		void NotifyTextureDestroy(class GLTexture* texture);
 		void NotifyBufferDestroy(class GLBuffer* buffer);
 		FrameBuffer_ptr GetCachedFrameBuffer(const DrawCallState &state);
@@ -107,6 +107,7 @@ namespace Aurora
 				for(const auto& ub : m_Resources.GetUniformBlocks()) {
 					ShaderResourceDesc resourceDesc = {};
 					resourceDesc.Name = ub.Name;
+					resourceDesc.NameID = ub.NameID;
 					resourceDesc.Size = ub.Size;
 					resourceDesc.Type = resourceType;
 					resourceDesc.ArraySize = ub.ArraySize;
@@ -131,6 +132,7 @@ namespace Aurora
 				for(const auto& ub : m_Resources.GetSamplers()) {
 					ShaderResourceDesc resourceDesc = {};
 					resourceDesc.Name = ub.Name;
+					resourceDesc.NameID = ub.NameID;
 					resourceDesc.Size = 0;
 					resourceDesc.Type = resourceType;
 					resourceDesc.ArraySize = ub.ArraySize;
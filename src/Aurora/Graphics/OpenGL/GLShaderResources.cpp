@@ -185,6 +185,7 @@ namespace Aurora
 
 						m_Samplers.push_back(
 							{*NamesPool.emplace(strName).first,
+							 Hash_djb2(strName.c_str()),
 							 ResourceType,
 							 m_SamplerBinding,
 							 static_cast<uint32_t>(size),
@@ -254,6 +255,7 @@ namespace Aurora
 					m_Images.push_back(
 							{
 									*NamesPool.emplace(Name.data()).first,
+									Hash_djb2(Name.data()),
 									ResourceType,
 									m_ImageBinding,
 									static_cast<uint32_t>(size),
@@ -319,7 +321,7 @@ namespace Aurora
 
 					if (uniformLocation >= 0)
 					{
-						m_Uniforms[Hash_djb2(basicUniform.Name.c_str())] = {basicUniform.Name, ShaderResourceType::Uniform, 0, uint32_t(size), uniformLocation, glType.ComponentCount, glType.Size, GetGLVarType(dataType)};
+						m_Uniforms[Hash_djb2(basicUniform.Name.c_str())] = {basicUniform.Name, Hash_djb2(basicUniform.Name.c_str()), ShaderResourceType::Uniform, 0, uint32_t(size), uniformLocation, glType.ComponentCount, glType.Size, GetGLVarType(dataType)};
 					}
 
 					break;
@@ -461,6 +463,7 @@ namespace Aurora
 #endif
 				m_UniformBlocks.push_back({
 												*NamesPool.emplace(Name.data()).first,
+												Hash_djb2(Name.data()),
 												ShaderResourceType::ConstantBuffer,
 												m_UniformBufferBinding,
 												static_cast<uint32_t>(ArraySize),
@@ -521,6 +524,7 @@ namespace Aurora
 			{
 				m_StorageBlocks.push_back({
 												*NamesPool.emplace(Name.data()).first,
+												Hash_djb2(Name.data()),
 												ShaderResourceType::BufferUAV,
 												m_StorageBufferBinding,
 												static_cast<uint32_t>(ArraySize),
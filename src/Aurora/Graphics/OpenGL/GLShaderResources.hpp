@@ -18,6 +18,7 @@ namespace Aurora
 	struct GLResourceAttribs
 	{
 		std::string Name = "Unknown";
+		TTypeID NameID = 0; // Hash_djb2 of the name, state bindings are looked up by it
 		ShaderResourceType ResourceType = ShaderResourceType::Unknown;
 		uint32_t Binding = 0;
 		uint32_t ArraySize = 0;
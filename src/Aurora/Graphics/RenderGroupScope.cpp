@@ -0,0 +1,22 @@
+#include "RenderGroupScope.hpp"
+#include "Aurora/Engine.hpp"
+#include "Base/IRenderDevice.hpp"
+
+namespace Aurora
+{
+	RenderGroupScope::RenderGroupScope(const char *name) : m_RenderDevice(GEngine ? GEngine->GetRenderDevice() : nullptr)
+	{
+		if (m_RenderDevice)
+			m_RenderDevice->PushDebugGroup(name);
+	}
+
+	RenderGroupScope::RenderGroupScope(const std::string &name) : RenderGroupScope(name.c_str())
+	{
+	}
+
+	RenderGroupScope::~RenderGroupScope()
+	{
+		if (m_RenderDevice)
+			m_RenderDevice->PopDebugGroup();
+	}
+}
\ No newline at end of file
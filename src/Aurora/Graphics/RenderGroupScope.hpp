@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+#include "Aurora/Core/Library.hpp"
+
+namespace Aurora
+{
+	class IRenderDevice;
+
+	// Debug group on the render device of the engine, does nothing when there is none
+	class AU_API RenderGroupScope
+	{
+	private:
+		IRenderDevice* m_RenderDevice;
+	public:
+		explicit RenderGroupScope(const char* name);
+		explicit RenderGroupScope(const std::string& name);
+		~RenderGroupScope();
+	};
+}
\ No newline at end of file
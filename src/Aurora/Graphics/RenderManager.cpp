@@ -27,7 +27,9 @@ namespace Aurora
 
 	RenderManager::RenderManager(IRenderDevice *renderDevice)
 	: m_RenderDevice(renderDevice),
-	m_UniformBufferCache(m_RenderDevice, EBufferType::UniformBuffer, 3, 65536 * 3, false) // We don't use GPU mapped memory because on OpenGL is too slow...
+	m_UniformBufferCache(m_RenderDevice, "UniformStream", EBufferType::UniformBuffer, 4 * 1024 * 1024),
+	m_VertexBufferCache(m_RenderDevice, "VertexStream", EBufferType::VertexBuffer, 4 * 1024 * 1024),
+	m_StorageBufferCache(m_RenderDevice, "StorageStream", EBufferType::ShaderStorageBuffer, 4 * 1024 * 1024)
 	{
 		{
 			ShaderProgramDesc desc("Blit");
@@ -339,7 +341,8 @@ namespace Aurora
 			AU_LOG_WARNING("Temporal render target count exceeded 50, are you sure you are not doing something wrong ?");
 		}
 
-		m_UniformBufferCache.Reset();
 		m_UniformBufferCache.OnFrameEnd();
+		m_VertexBufferCache.OnFrameEnd();
+		m_StorageBufferCache.OnFrameEnd();
 	}
 }
\ No newline at end of file
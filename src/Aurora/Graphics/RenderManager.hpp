@@ -137,7 +137,10 @@ namespace Aurora
 		Shader_ptr m_BlitShader;
 		std::vector<TemporalRenderTargetStorage> m_TemporalRenderTargets;
 
+		// Per frame data, each is triple buffered
 		BufferCache m_UniformBufferCache;
+		BufferCache m_VertexBufferCache;
+		BufferCache m_StorageBufferCache;
 	public:
 		explicit RenderManager(IRenderDevice *renderDevice);
 
@@ -173,12 +176,24 @@ namespace Aurora
 			Blit(src, nullptr);
 		}
 
-		// Not used for now
+		// Uniform blocks and instance data, valid until the end of the frame
 		BufferCache &GetUniformBufferCache()
 		{
 			return m_UniformBufferCache;
 		}
 
+		// Vertices generated on the CPU every frame, like debug shapes
+		BufferCache &GetVertexBufferCache()
+		{
+			return m_VertexBufferCache;
+		}
+
+		// Storage blocks and indirect draw commands
+		BufferCache &GetStorageBufferCache()
+		{
+			return m_StorageBufferCache;
+		}
+
 		void EndFrame();
 	};
 
@@ -189,11 +204,11 @@ namespace Aurora
 
 #define END_UB(bufferName) \
     GEngine->GetRenderManager()->GetUniformBufferCache().Unmap(cacheIndex); \
-    drawState.BindUniformBuffer(#bufferName, cacheIndex.Buffer, cacheIndex.Offset, cacheIndex.Size);}
+    drawState.BindUniformBuffer(std::integral_constant<::Aurora::TTypeID, ::Aurora::Hash_djb2(#bufferName)>::value, cacheIndex.Buffer, cacheIndex.Offset, cacheIndex.Size);}
 
 #define END_CUB(bufferName) \
     m_RenderManager->GetUniformBufferCache().Unmap(cacheIndex); \
-    dispatchState.BindUniformBuffer(#bufferName, cacheIndex.Buffer, cacheIndex.Offset, cacheIndex.Size);}
+    dispatchState.BindUniformBuffer(std::integral_constant<::Aurora::TTypeID, ::Aurora::Hash_djb2(#bufferName)>::value, cacheIndex.Buffer, cacheIndex.Offset, cacheIndex.Size);}
 
 #define BEGIN_UBW(type, name) \
     { type l_BufferData = {}; type* name = &l_BufferData; auto l_BufferDataSize = sizeof(type);
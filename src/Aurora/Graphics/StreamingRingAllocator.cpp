@@ -0,0 +1,49 @@
+#include "StreamingRingAllocator.hpp"
+#include "Aurora/Core/assert.hpp"
+
+namespace Aurora
+{
+	StreamingRingAllocator::StreamingRingAllocator(uint32_t regionSize, uint32_t regionCount)
+		: m_RegionSize(regionSize),
+		m_RegionCount(regionCount),
+		m_CurrentRegion(0),
+		m_RegionOffset(0),
+		m_AllocatedBytes(0),
+		m_FailedAllocations(0)
+	{
+		au_assert(regionSize > 0 && regionCount > 0);
+	}
+
+	bool StreamingRingAllocator::Allocate(uint32_t size, uint32_t alignment, StreamingAllocation& allocation)
+	{
+		if (alignment == 0)
+			alignment = 1;
+
+		// Aligned from the start of the buffer, region sizes don't have to be a multiple of the alignment
+		uint64_t regionStart = GetRegionStart(m_CurrentRegion);
+		uint64_t offset = regionStart + m_RegionOffset;
+		offset = (offset + alignment - 1) / alignment * alignment;
+
+		if (offset + size > regionStart + m_RegionSize)
+		{
+			m_FailedAllocations++;
+			return false;
+		}
+
+		allocation.Offset = static_cast<uint32_t>(offset);
+		allocation.Size = size;
+
+		m_RegionOffset = static_cast<uint32_t>(offset + size - regionStart);
+		m_AllocatedBytes += size;
+		return true;
+	}
+
+	uint32_t StreamingRingAllocator::NextRegion()
+	{
+		m_CurrentRegion = (m_CurrentRegion + 1) % m_RegionCount;
+		m_RegionOffset = 0;
+		m_AllocatedBytes = 0;
+		m_FailedAllocations = 0;
+		return m_CurrentRegion;
+	}
+}
\ No newline at end of file
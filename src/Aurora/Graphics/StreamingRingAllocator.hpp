@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Aurora/Core/Types.hpp"
+#include "Aurora/Core/Library.hpp"
+
+namespace Aurora
+{
+	struct StreamingAllocation
+	{
+		uint32_t Offset; // From the start of the whole buffer
+		uint32_t Size;
+	};
+
+	// CPU side of a streaming buffer split into one region per frame in flight. Allocations are bumped from the region
+	// of the current frame and never spill into the next one, because the GPU may still read it. The allocator does not
+	// know about the device, fencing the regions is up to the owner (see BufferCache).
+	class AU_API StreamingRingAllocator
+	{
+	private:
+		uint32_t m_RegionSize;
+		uint32_t m_RegionCount;
+		uint32_t m_CurrentRegion;
+		uint32_t m_RegionOffset;		// Bytes used in the current region, alignment padding included
+		uint32_t m_AllocatedBytes;		// Bytes requested in the current region
+		uint32_t m_FailedAllocations;	// Allocations that did not fit in the current region
+	public:
+		StreamingRingAllocator(uint32_t regionSize, uint32_t regionCount);
+
+		// Alignment does not need to be a power of two, vertex data is aligned to its stride
+		bool Allocate(uint32_t size, uint32_t alignment, StreamingAllocation& allocation);
+
+		// Moves to the next region and starts it empty, returns its index
+		uint32_t NextRegion();
+
+		[[nodiscard]] inline uint32_t GetRegionSize() const noexcept { return m_RegionSize; }
+		[[nodiscard]] inline uint32_t GetRegionCount() const noexcept { return m_RegionCount; }
+		[[nodiscard]] inline uint32_t GetTotalSize() const noexcept { return m_RegionSize * m_RegionCount; }
+		[[nodiscard]] inline uint32_t GetCurrentRegion() const noexcept { return m_CurrentRegion; }
+		[[nodiscard]] inline uint32_t GetRegionStart(uint32_t region) const noexcept { return region * m_RegionSize; }
+
+		[[nodiscard]] inline uint32_t GetUsedBytes() const noexcept { return m_RegionOffset; }
+		[[nodiscard]] inline uint32_t GetAllocatedBytes() const noexcept { return m_AllocatedBytes; }
+		[[nodiscard]] inline uint32_t GetFailedAllocations() const noexcept { return m_FailedAllocations; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "HeadlessEngine.hpp"
+
+#include "Core/assert.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/JobSystem.hpp"
+#include "Memory/FrameAllocator.hpp"
+
+#include "Graphics/Null/NullRenderDevice.hpp"
+#include "Graphics/RenderManager.hpp"
+#include "Graphics/DShape.hpp"
+#include "Resource/ResourceManager.hpp"
+
+namespace Aurora
+{
+	HeadlessEngine::HeadlessEngine()
+		: m_JobSystem(nullptr),
+		  m_RenderDevice(nullptr),
+		  m_RenderManager(nullptr),
+		  m_ResourceManager(nullptr)
+	{
+		au_assert(GEngine == nullptr);
+
+		Profiler::SetThreadName("Main");
+
+		GEngine = new AuroraContext();
+
+		m_JobSystem = new JobSystem();
+		GEngine->m_JobSystem = m_JobSystem;
+
+		m_RenderDevice = new NullRenderDevice();
+		m_RenderDevice->Init();
+
+		m_RenderManager = new RenderManager(m_RenderDevice);
+
+		m_ResourceManager = new ResourceManager(m_RenderDevice, m_JobSystem);
+		m_ResourceManager->AddFileSearchPath(AURORA_PROJECT_DIR);
+
+		GEngine->m_RenderDevice = m_RenderDevice;
+		GEngine->m_RenderManager = m_RenderManager;
+		GEngine->m_ResourceManager = m_ResourceManager;
+		GEngine->m_IsRunning = true;
+
+		// Scene renderers draw debug shapes every frame
+		DShapes::Init();
+	}
+
+	HeadlessEngine::~HeadlessEngine()
+	{
+		DShapes::Destroy();
+
+		delete m_ResourceManager;
+		GEngine->m_RenderDevice = nullptr; // Same order as AuroraEngine, caches release their buffers without a device
+		delete m_RenderManager;
+		delete m_RenderDevice;
+		delete m_JobSystem;
+		delete GEngine;
+		GEngine = nullptr;
+	}
+
+	void HeadlessEngine::BeginFrame()
+	{
+		Profiler::BeginFrame();
+		FrameAllocator::Get().BeginFrame();
+
+		CPU_DEBUG_SCOPE("ResourceUploads");
+		m_ResourceManager->ProcessUploads();
+	}
+
+	void HeadlessEngine::EndFrame()
+	{
+		m_RenderDevice->InvalidateState();
+		m_RenderManager->EndFrame();
+		m_RenderDevice->ResetFrameRenderStatistics();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Engine.hpp"
+
+namespace Aurora
+{
+	class NullRenderDevice;
+
+	// Engine context without a window or a GPU. GEngine is set up around a NullRenderDevice, so resources,
+	// materials and scene renderers run unchanged in tests, benchmarks and tools. Only one engine can exist at a time.
+	// There is no main viewport, cameras are given one from a ViewPortManager of their own.
+	class AU_API HeadlessEngine
+	{
+	private:
+		JobSystem* m_JobSystem;
+		NullRenderDevice* m_RenderDevice;
+		RenderManager* m_RenderManager;
+		ResourceManager* m_ResourceManager;
+	public:
+		HeadlessEngine();
+		~HeadlessEngine();
+
+		HeadlessEngine(const HeadlessEngine&) = delete;
+		HeadlessEngine& operator=(const HeadlessEngine&) = delete;
+
+		// Same bookkeeping as a frame of AuroraEngine::Run, read the render statistics before EndFrame
+		void BeginFrame();
+		void EndFrame();
+
+		[[nodiscard]] inline NullRenderDevice* GetRenderDevice() const { return m_RenderDevice; }
+		[[nodiscard]] inline RenderManager* GetRenderManager() const { return m_RenderManager; }
+		[[nodiscard]] inline ResourceManager* GetResourceManager() const { return m_ResourceManager; }
+	};
+}
\ No newline at end of file
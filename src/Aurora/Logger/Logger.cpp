@@ -1,6 +1,485 @@
 #include "Logger.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <common/TracySystem.hpp>
+
 namespace Aurora
 {
-	std::vector<std::shared_ptr<Logger::Sink>> Logger::m_Sinks;
-}
\ No newline at end of file
+	std::atomic<uint32_t> Logger::m_RateLimit = 100;
+
+	// Power of two, the queue takes about a megabyte
+	static constexpr uint64_t LogQueueSize = 4096;
+	static constexpr uint32_t InlineMessageSize = 200;
+
+	static const char* const SeverityNames[] = {"Info", "Warning", "ERROR", "CRITICAL ERROR"};
+
+	bool Logger::CallSite::Allow(uint32_t maxPerSecond)
+	{
+		if (maxPerSecond == 0)
+			return true;
+
+		// Windows of one second, 0 is the window of a call site that never logged
+		uint64_t window = (uint64_t)std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count() + 1;
+		uint64_t currentWindow = m_Window.load(std::memory_order_relaxed);
+
+		if (currentWindow != window && m_Window.compare_exchange_strong(currentWindow, window, std::memory_order_relaxed))
+			m_Count.store(0, std::memory_order_relaxed);
+
+		if (m_Count.fetch_add(1, std::memory_order_relaxed) < maxPerSecond)
+			return true;
+
+		m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	// Keeps its capacity, so formatting a message does not allocate once the thread logged a long one
+	class MessageBuffer : public std::streambuf
+	{
+	public:
+		std::string Text;
+	protected:
+		int_type overflow(int_type c) override
+		{
+			if (c != traits_type::eof())
+				Text.push_back((char)c);
+
+			return c;
+		}
+
+		std::streamsize xsputn(const char* data, std::streamsize count) override
+		{
+			Text.append(data, (size_t)count);
+			return count;
+		}
+	};
+
+	struct MessageStream
+	{
+		MessageBuffer Buffer;
+		std::ostream Stream;
+		std::ios_base::fmtflags DefaultFlags;
+
+		MessageStream() : Buffer(), Stream(&Buffer), DefaultFlags(Stream.flags())
+		{
+			Buffer.Text.reserve(256);
+		}
+	};
+
+	static thread_local MessageStream t_MessageStream;
+	// Set on the logging thread, messages logged by sinks are only queued
+	static thread_local bool t_InsideSink = false;
+
+	struct LogMessage
+	{
+		std::atomic<uint64_t> Sequence;
+		Logger::CallSite* Site;
+		Logger::Severity Severity;
+		uint32_t Suppressed;
+		uint32_t Length;
+		char Text[InlineMessageSize];
+		std::string LongText;
+	};
+
+	// Bounded multi-producer queue, every slot has a sequence number telling whether it is free or written
+	class LogQueue
+	{
+	private:
+		std::unique_ptr<LogMessage[]> m_Messages;
+		alignas(64) std::atomic<uint64_t> m_Head;
+		// Written by the consumer only, read by the logging thread to know whether it can sleep
+		alignas(64) std::atomic<uint64_t> m_Tail;
+	public:
+		LogQueue() : m_Messages(new LogMessage[LogQueueSize]), m_Head(0), m_Tail(0)
+		{
+			for (uint64_t i = 0; i < LogQueueSize; ++i)
+				m_Messages[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+
+		// Returns nullptr when the queue is full
+		LogMessage* Acquire(uint64_t& position)
+		{
+			uint64_t head = m_Head.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				LogMessage& message = m_Messages[head & (LogQueueSize - 1)];
+				int64_t difference = (int64_t)message.Sequence.load(std::memory_order_acquire) - (int64_t)head;
+
+				if (difference == 0)
+				{
+					if (m_Head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+					{
+						position = head;
+						return &message;
+					}
+				}
+				else if (difference < 0)
+				{
+					return nullptr;
+				}
+				else
+				{
+					head = m_Head.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		static void Publish(LogMessage* message, uint64_t position)
+		{
+			message->Sequence.store(position + 1, std::memory_order_release);
+		}
+
+		// Consumer side, only one thread at a time
+		LogMessage* Front()
+		{
+			uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+			LogMessage& message = m_Messages[tail & (LogQueueSize - 1)];
+
+			if (message.Sequence.load(std::memory_order_acquire) != tail + 1)
+				return nullptr;
+
+			return &message;
+		}
+
+		void Pop(LogMessage* message)
+		{
+			uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+			message->Sequence.store(tail + LogQueueSize, std::memory_order_release);
+			m_Tail.store(tail + 1, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] uint64_t GetHead() const { return m_Head.load(std::memory_order_acquire); }
+		[[nodiscard]] uint64_t GetTail() const { return m_Tail.load(std::memory_order_relaxed); }
+	};
+
+	class LogBackend
+	{
+	private:
+		LogQueue m_Queue;
+
+		// Held while messages are handed to the sinks, the holder is the consumer of the queue
+		std::mutex m_SinkMutex;
+		std::vector<std::shared_ptr<Logger::Sink>> m_Sinks;
+		std::string m_FileName;
+		std::string m_Function;
+		std::string m_Message;
+		std::string m_SeverityName;
+
+		std::atomic<bool> m_Running;
+		std::atomic<bool> m_Asynchronous;
+		std::atomic<bool> m_Sleeping;
+		std::atomic<uint32_t> m_Dropped;
+		std::atomic<uint64_t> m_Processed;
+
+		std::mutex m_WakeMutex;
+		std::condition_variable m_WakeCondition;
+		std::condition_variable m_FlushCondition;
+		std::thread m_Thread;
+	public:
+		LogBackend() : m_Running(true), m_Asynchronous(true), m_Sleeping(false), m_Dropped(0), m_Processed(0)
+		{
+			m_Thread = std::thread([this] { Run(); });
+		}
+
+		void AddSink(const std::shared_ptr<Logger::Sink>& sink)
+		{
+			std::lock_guard<std::mutex> lock(m_SinkMutex);
+			m_Sinks.push_back(sink);
+		}
+
+		bool RemoveSink(const std::shared_ptr<Logger::Sink>& sink)
+		{
+			std::lock_guard<std::mutex> lock(m_SinkMutex);
+			auto it = std::find(m_Sinks.begin(), m_Sinks.end(), sink);
+
+			if (it == m_Sinks.end())
+				return false;
+
+			m_Sinks.erase(it);
+			return true;
+		}
+
+		void SetAsynchronous(bool asynchronous)
+		{
+			m_Asynchronous.store(asynchronous);
+			Flush();
+		}
+
+		[[nodiscard]] bool IsAsynchronous() const { return m_Asynchronous.load(std::memory_order_relaxed); }
+
+		void Log(Logger::Severity severity, Logger::CallSite& site, const std::string& text)
+		{
+			uint32_t suppressed = site.TakeSuppressed();
+
+			if (!t_InsideSink && (!m_Asynchronous.load(std::memory_order_relaxed) || !m_Running.load(std::memory_order_relaxed)))
+			{
+				std::lock_guard<std::mutex> lock(m_SinkMutex);
+				Drain();
+				Dispatch(severity, site, suppressed, text.data(), text.size());
+				FlushSinks();
+				return;
+			}
+
+			while (!Push(severity, site, suppressed, text))
+			{
+				// Info and warnings are dropped rather than stalling the caller, errors wait for the logging thread
+				if (severity < Logger::Severity::Error || t_InsideSink)
+				{
+					m_Dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				Wake();
+				std::this_thread::yield();
+			}
+		}
+
+		void Flush()
+		{
+			// Would wait for itself
+			if (t_InsideSink)
+				return;
+
+			if (!m_Asynchronous.load() || !m_Running.load())
+			{
+				std::lock_guard<std::mutex> lock(m_SinkMutex);
+				Drain();
+				return;
+			}
+
+			uint64_t target = m_Queue.GetHead();
+			m_WakeCondition.notify_one();
+
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+			m_FlushCondition.wait(lock, [this, target] { return m_Processed.load(std::memory_order_acquire) >= target || !m_Running.load(); });
+		}
+
+		// Messages logged after this are written from the calling thread
+		void Stop()
+		{
+			if (!m_Running.exchange(false))
+				return;
+
+			m_WakeCondition.notify_one();
+			m_Thread.join();
+
+			{
+				std::lock_guard<std::mutex> lock(m_SinkMutex);
+				Drain();
+			}
+
+			NotifyFlushed();
+		}
+	private:
+		bool Push(Logger::Severity severity, Logger::CallSite& site, uint32_t suppressed, const std::string& text)
+		{
+			uint64_t position;
+			LogMessage* message = m_Queue.Acquire(position);
+
+			if (!message)
+				return false;
+
+			message->Site = &site;
+			message->Severity = severity;
+			message->Suppressed = suppressed;
+			message->Length = (uint32_t)text.size();
+
+			if (text.size() <= InlineMessageSize)
+				std::memcpy(message->Text, text.data(), text.size());
+			else
+				message->LongText = text;
+
+			LogQueue::Publish(message, position);
+
+			if (m_Sleeping.load(std::memory_order_relaxed))
+				Wake();
+
+			return true;
+		}
+
+		void Wake()
+		{
+			if (m_Sleeping.exchange(false))
+				m_WakeCondition.notify_one();
+		}
+
+		void NotifyFlushed()
+		{
+			// Taking the mutex orders the notification after the check of a waiting Flush
+			{
+				std::lock_guard<std::mutex> lock(m_WakeMutex);
+			}
+
+			m_FlushCondition.notify_all();
+		}
+
+		void Run()
+		{
+			tracy::SetThreadName("Logger");
+			t_InsideSink = true;
+
+			while (true)
+			{
+				size_t count;
+				{
+					std::lock_guard<std::mutex> lock(m_SinkMutex);
+					count = Drain();
+				}
+
+				if (count > 0)
+				{
+					NotifyFlushed();
+					continue;
+				}
+
+				if (!m_Running.load())
+					break;
+
+				// Producers wake the thread up, the timeout covers a wake up sent just before the wait
+				std::unique_lock<std::mutex> lock(m_WakeMutex);
+				m_Sleeping.store(true);
+				m_WakeCondition.wait_for(lock, std::chrono::milliseconds(10), [this] { return !m_Running.load() || m_Queue.GetHead() != m_Queue.GetTail(); });
+				m_Sleeping.store(false);
+			}
+		}
+
+		// Requires m_SinkMutex, returns the count of messages handed to the sinks
+		size_t Drain()
+		{
+			size_t count = 0;
+
+			while (LogMessage* message = m_Queue.Front())
+			{
+				const char* text = message->Length > InlineMessageSize ? message->LongText.data() : message->Text;
+				Dispatch(message->Severity, *message->Site, message->Suppressed, text, message->Length);
+
+				if (message->Length > InlineMessageSize)
+					message->LongText.clear();
+
+				m_Queue.Pop(message);
+				count++;
+			}
+
+			if (uint32_t dropped = m_Dropped.exchange(0, std::memory_order_relaxed))
+			{
+				static Logger::CallSite droppedCallSite("", "", 0);
+				std::string text = std::to_string(dropped) + " messages were dropped, the log queue was full";
+				Dispatch(Logger::Severity::Warning, droppedCallSite, 0, text.data(), text.size());
+				count++;
+			}
+
+			if (count > 0)
+				FlushSinks();
+
+			m_Processed.store(m_Queue.GetTail(), std::memory_order_release);
+			return count;
+		}
+
+		void Dispatch(Logger::Severity severity, const Logger::CallSite& site, uint32_t suppressed, const char* text, size_t length)
+		{
+			const char* fileName = site.File;
+			for (const char* c = site.File; *c; ++c)
+			{
+				if (*c == '/' || *c == '\\')
+					fileName = c + 1;
+			}
+
+			m_FileName.assign(fileName);
+			m_Function.assign(site.Function);
+			m_SeverityName.assign(SeverityNames[static_cast<uint8_t>(severity)]);
+			m_Message.assign(text, length);
+
+			if (suppressed > 0)
+				m_Message.append(" (").append(std::to_string(suppressed)).append(" similar messages suppressed)");
+
+			for (auto& sink : m_Sinks)
+			{
+				sink->Log(severity, m_SeverityName, m_FileName, m_Function, site.Line, m_Message);
+			}
+		}
+
+		void FlushSinks()
+		{
+			for (auto& sink : m_Sinks)
+			{
+				sink->Flush();
+			}
+		}
+	};
+
+	// Never destroyed, so logging from static destructors still works
+	static LogBackend* s_LogBackend = nullptr;
+
+	static LogBackend& GetLogBackend()
+	{
+		static LogBackend* backend = s_LogBackend = new LogBackend();
+		return *backend;
+	}
+
+	// Stops the logging thread at exit, writing what is left in the queue
+	static struct LogBackendShutdown
+	{
+		~LogBackendShutdown()
+		{
+			if (s_LogBackend)
+				s_LogBackend->Stop();
+		}
+	} s_LogBackendShutdown;
+
+	std::ostream& Logger::BeginMessage()
+	{
+		MessageStream& messageStream = t_MessageStream;
+		messageStream.Buffer.Text.clear();
+
+		// Manipulators used by the previous message do not carry over
+		messageStream.Stream.clear();
+		messageStream.Stream.flags(messageStream.DefaultFlags);
+		messageStream.Stream.precision(6);
+		messageStream.Stream.fill(' ');
+
+		return messageStream.Stream;
+	}
+
+	void Logger::EndMessage(Severity severity, CallSite& site)
+	{
+		const std::string& text = t_MessageStream.Buffer.Text;
+		GetLogBackend().Log(severity, site, text);
+
+		if (severity == Severity::FatalError)
+		{
+			Flush();
+			ShowErrorTraceWindow(text);
+		}
+	}
+
+	void Logger::AddSinkInternal(const std::shared_ptr<Sink>& sink)
+	{
+		GetLogBackend().AddSink(sink);
+	}
+
+	bool Logger::RemoveSinkInternal(const std::shared_ptr<Sink>& sink)
+	{
+		return GetLogBackend().RemoveSink(sink);
+	}
+
+	void Logger::SetAsynchronous(bool asynchronous)
+	{
+		GetLogBackend().SetAsynchronous(asynchronous);
+	}
+
+	bool Logger::IsAsynchronous()
+	{
+		return GetLogBackend().IsAsynchronous();
+	}
+
+	void Logger::Flush()
+	{
+		GetLogBackend().Flush();
+	}
+}
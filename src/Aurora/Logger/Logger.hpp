@@ -1,16 +1,26 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
 #include <functional>
 #include <memory>
+#include <ostream>
+#include <string>
 #include <vector>
 #include <Aurora/Core/Library.hpp>
 #include <Aurora/Core/FormatString.hpp>
 #include <Aurora/Core/SystemUtils.hpp>
 
+// Messages below this severity are compiled out, 0 Info, 1 Warning, 2 Error, 3 FatalError
+#ifndef AU_LOG_MIN_SEVERITY
+	#define AU_LOG_MIN_SEVERITY 0
+#endif
+
 namespace Aurora
 {
+	// Messages are formatted on the calling thread into a lock-free queue,
+	// a background thread hands them to the sinks and flushes them once per batch.
 	class AU_API Logger
 	{
 	public:
@@ -22,74 +32,101 @@ namespace Aurora
 			FatalError
 		};
 
+		// Sinks are called from the logging thread, or from the caller when the logger is synchronous
 		class Sink
 		{
 		public:
+			virtual ~Sink() = default;
 			virtual void Log(const Severity& severity, const std::string& severityStr, const std::string& file, const std::string& function, int line, const std::string& message) = 0;
+			// Called after each batch of messages
+			virtual void Flush() {}
 		};
 
+		// Static data of one AU_LOG, file and function point to string literals
+		class CallSite
+		{
+		public:
+			const char* const File;
+			const char* const Function;
+			const int Line;
+		private:
+			std::atomic<uint64_t> m_Window;
+			std::atomic<uint32_t> m_Count;
+			std::atomic<uint32_t> m_Suppressed;
+		public:
+			constexpr CallSite(const char* file, const char* function, int line) : File(file), Function(function), Line(line), m_Window(0), m_Count(0), m_Suppressed(0) {}
+
+			bool Allow(uint32_t maxPerSecond);
+			uint32_t TakeSuppressed() { return m_Suppressed.exchange(0, std::memory_order_relaxed); }
+		};
 	private:
-		static std::vector<std::shared_ptr<Sink>> m_Sinks;
+		static std::atomic<uint32_t> m_RateLimit;
 	public:
 		template<typename... ArgsType>
-		static void Log(const Severity& severity, const char* function, const char* fullFilePath, int line, const ArgsType&... args)
+		static void Log(const Severity& severity, CallSite& site, const ArgsType&... args)
 		{
-			auto message = FormatString(args...);
-
-			std::string fileName;
-			if(fullFilePath) fileName = fullFilePath;
-			auto lastSlashPos = fileName.find_last_of("/\\");
-			if (lastSlashPos != std::string::npos)
-				fileName.erase(0, lastSlashPos + 1);
+			// Fatal errors are never suppressed
+			if (severity != Severity::FatalError && !site.Allow(m_RateLimit.load(std::memory_order_relaxed)))
+				return;
 
-			static const char* const strSeverities[] = {"Info", "Warning", "ERROR", "CRITICAL ERROR"};
-			std::string messageSeverity = strSeverities[static_cast<uint8_t>(severity)];
-
-			std::string fncStr;
-			if(function) fncStr = function;
-
-			for(auto& sink : m_Sinks) {
-				sink->Log(severity, messageSeverity, fileName, fncStr, line, message);
-			}
-
-			if (severity == Severity::FatalError)
-			{
-				ShowErrorTraceWindow(message);
-			}
+			std::ostream& stream = BeginMessage();
+			(stream << ... << args);
+			EndMessage(severity, site);
 		}
 
 		template<class Sink, typename... ArgsType>
 		static std::shared_ptr<Sink> AddSink(ArgsType&&... args)
 		{
 			std::shared_ptr<Sink> sink = std::make_shared<Sink>(std::forward<ArgsType>(args)...);
-			m_Sinks.push_back(sink);
+			AddSinkInternal(sink);
 			return sink;
 		}
 
 		template<class Sink, typename... ArgsType>
 		static std::shared_ptr<Sink> AddSinkPtr(const std::shared_ptr<Sink>& sink)
 		{
-			m_Sinks.push_back(sink);
+			AddSinkInternal(sink);
 			return sink;
 		}
 
 		template<class Sink>
 		static bool RemoveSink(const std::shared_ptr<Sink>& sink)
 		{
-			auto it = std::find(m_Sinks.begin(), m_Sinks.end(), sink);
+			return RemoveSinkInternal(sink);
+		}
 
-			if(it == m_Sinks.end()) {
-				return false;
-			}
+		// Messages per second of one call site before the next ones are dropped and counted, 0 for no limit
+		static void SetRateLimit(uint32_t maxPerSecond) { m_RateLimit.store(maxPerSecond, std::memory_order_relaxed); }
+		static uint32_t GetRateLimit() { return m_RateLimit.load(std::memory_order_relaxed); }
 
-			m_Sinks.erase(it);
+		// Synchronous logging calls the sinks from the calling thread, after everything queued before
+		static void SetAsynchronous(bool asynchronous);
+		static bool IsAsynchronous();
 
-			return true;
-		}
+		// Blocks until every message logged before reached the sinks
+		static void Flush();
+	private:
+		static std::ostream& BeginMessage();
+		static void EndMessage(Severity severity, CallSite& site);
+
+		static void AddSinkInternal(const std::shared_ptr<Sink>& sink);
+		static bool RemoveSinkInternal(const std::shared_ptr<Sink>& sink);
 	};
 }
 
-#define AU_LOG(_severity, ...) ::Aurora::Logger::Log(::Aurora::Logger::Severity::_severity, __FUNCTION__, __FILE__, __LINE__, ##__VA_ARGS__)
+// Without a minimum every severity is logged, comparing against 0 would only trigger -Wtype-limits
+#if AU_LOG_MIN_SEVERITY > 0
+	#define AU_LOG(_severity, ...) do { \
+		if constexpr ((uint8_t)::Aurora::Logger::Severity::_severity >= AU_LOG_MIN_SEVERITY) { \
+			static ::Aurora::Logger::CallSite _auLogCallSite(__FILE__, __FUNCTION__, __LINE__); \
+			::Aurora::Logger::Log(::Aurora::Logger::Severity::_severity, _auLogCallSite, ##__VA_ARGS__); \
+		} } while(false)
+#else
+	#define AU_LOG(_severity, ...) do { \
+		static ::Aurora::Logger::CallSite _auLogCallSite(__FILE__, __FUNCTION__, __LINE__); \
+		::Aurora::Logger::Log(::Aurora::Logger::Severity::_severity, _auLogCallSite, ##__VA_ARGS__); \
+	} while(false)
+#endif
 #define AU_LOG_INFO(...) AU_LOG(Info, __VA_ARGS__)
 #define AU_LOG_WARNING(...) AU_LOG(Warning, __VA_ARGS__)
 #define AU_LOG_ERROR(...) AU_LOG(Error, __VA_ARGS__)
@@ -30,12 +30,18 @@ namespace Aurora
 			}
 
 			if(!file.empty()) {
-				m_Stream << severityStr << ": " << file << ": " << function << "(): " << line << ": " << message << std::endl;
+				m_Stream << severityStr << ": " << file << ": " << function << "(): " << line << ": " << message << '\n';
 			} else {
-				m_Stream << severityStr << ": " << message << std::endl;
+				m_Stream << severityStr << ": " << message << '\n';
 			}
+		}
 
-			m_Stream.flush();
+		// Once per batch of messages
+		void Flush() override
+		{
+			if(m_Stream.is_open()) {
+				m_Stream.flush();
+			}
 		}
 	};
 }
\ No newline at end of file
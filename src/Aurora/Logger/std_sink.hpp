@@ -11,10 +11,15 @@ namespace Aurora
 		void Log(const Logger::Severity& severity, const std::string& severityStr, const std::string& file, const std::string& function, int line, const std::string& message) override
 		{
 			if(!file.empty()) {
-				std::cout << severityStr << ": " << file << ": " << function << "(): " << line << ": " << message << std::endl;
+				std::cout << severityStr << ": " << file << ": " << function << "(): " << line << ": " << message << '\n';
 			} else {
-				std::cout << severityStr << ": " << message << std::endl;
+				std::cout << severityStr << ": " << message << '\n';
 			}
 		}
+
+		void Flush() override
+		{
+			std::cout.flush();
+		}
 	};
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "Aum.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cstring>
+#include <mutex>
 #include "Aurora/Core/assert.hpp"
 #include "Aurora/Core/String.hpp"
 #include <iostream>
@@ -8,28 +11,54 @@
 namespace Aurora
 {
 	std::vector<Aum*> Aum::AllMemoryAllocators;
+	// Allocators can be created from worker threads (ThreadArenas)
+	static std::mutex s_AllMemoryAllocatorsMutex;
 
-	Aum::Aum(MemSize blockSize) : m_BlockSize(blockSize)
+	static constexpr uint16_t BlockFlagFree = 1 << 0;
+	static constexpr uint32_t BlockMagic = 0xA0A0BEEF;
+
+	Aum::Aum(MemSize blockSize, EMode mode) : m_Mode(mode), m_BlockSize(mode == EMode::SizeClass ? Align<MemSize>(blockSize, 16) : blockSize)
 	{
-		AllMemoryAllocators.push_back(this);
 		AllocateMemoryBlock();
+
+		// Registered once constructed, the registry can be walked from another thread right away
+		std::lock_guard<std::mutex> lock(s_AllMemoryAllocatorsMutex);
+		AllMemoryAllocators.push_back(this);
 	}
 
-	Aum::Aum(MemSize objectSize, MemSize objectCount) : m_BlockSize(objectSize * objectCount)
+	Aum::Aum(MemSize objectSize, MemSize objectCount) : m_Mode(EMode::FirstFit), m_BlockSize(objectSize * objectCount)
 	{
 		AllocateMemoryBlock();
 	}
 
 	Aum::~Aum()
 	{
+		std::unique_lock<std::mutex> lock(s_AllMemoryAllocatorsMutex);
 		auto it = std::find(AllMemoryAllocators.begin(), AllMemoryAllocators.end(), this);
 		if (it != AllMemoryAllocators.end())
 		{
 			AllMemoryAllocators.erase(it);
 		}
+		lock.unlock();
 		DestroyMemory();
 	}
 
+	void Aum::ForEachAllocator(const std::function<void(Aum*)>& func)
+	{
+		std::lock_guard<std::mutex> lock(s_AllMemoryAllocatorsMutex);
+
+		for (Aum* allocator : AllMemoryAllocators)
+		{
+			func(allocator);
+		}
+	}
+
+	void Aum::ClearAllocators()
+	{
+		std::lock_guard<std::mutex> lock(s_AllMemoryAllocatorsMutex);
+		AllMemoryAllocators.clear();
+	}
+
 	void Aum::DestroyMemory()
 	{
 		for (const auto &item : m_Memory)
@@ -42,6 +71,35 @@ namespace Aurora
 
 	Aum::MemoryBlock& Aum::AllocateMemoryBlock()
 	{
+		if (m_Mode == EMode::SizeClass)
+		{
+			au_assert(m_Memory.size() < UINT16_MAX);
+
+			MemoryBlock memoryBlock;
+			memoryBlock.Memory = new uint8_t[m_BlockSize];
+			// Last header is a sentinel that is never free so coalescing stops at the end of the block
+			memoryBlock.FreeMemory = m_BlockSize - HeaderSize;
+
+			auto* block = reinterpret_cast<BlockHeader*>(memoryBlock.Memory);
+			block->Size = m_BlockSize - HeaderSize;
+			block->PrevSize = 0;
+			block->Flags = BlockFlagFree;
+			block->MemoryBlockIndex = (uint16_t)m_Memory.size();
+			block->Magic = BlockMagic;
+
+			auto* sentinel = reinterpret_cast<BlockHeader*>(memoryBlock.Memory + block->Size);
+			sentinel->Size = 0;
+			sentinel->PrevSize = block->Size;
+			sentinel->Flags = 0;
+			sentinel->MemoryBlockIndex = block->MemoryBlockIndex;
+			sentinel->Magic = 0;
+
+			InsertFreeBlock(block);
+			m_UsedBytes += HeaderSize;
+
+			return m_Memory.emplace_back(memoryBlock);
+		}
+
 		MemoryBlock memoryBlock;
 		memoryBlock.Memory = new uint8_t[m_BlockSize];
 		memoryBlock.Fragments.emplace_back(MemoryFragment{memoryBlock.Memory, memoryBlock.Memory + m_BlockSize, m_BlockSize});
@@ -62,6 +120,7 @@ namespace Aurora
 
 		// Decrement block free size
 		memoryBlock.FreeMemory -= size;
+		m_UsedBytes += size;
 
 		// Change fragment size and if remaining is 0 then delete fragment
 		fragment.Begin = newMemoryStart + size;
@@ -83,8 +142,16 @@ namespace Aurora
 	MemPtr Aum::Alloc(MemSize size)
 	{
 		au_assert(size);
+
+		if (m_Mode == EMode::SizeClass)
+		{
+			return AllocSizeClass(size);
+		}
+
 		au_assert(size <= m_BlockSize);
 
+		m_AllocationCount++;
+
 		for (MemoryBlock& memoryBlock : m_Memory)
 		{
 			if(memoryBlock.FreeMemory < size)
@@ -110,6 +177,12 @@ namespace Aurora
 	{
 		if(!mem) return;
 
+		if (m_Mode == EMode::SizeClass)
+		{
+			DeAllocSizeClass(mem);
+			return;
+		}
+
 		MemPtr memPtrBegin = reinterpret_cast<MemPtr>(mem);
 		auto it = m_MemorySizes.find((uintptr_t)memPtrBegin);
 
@@ -122,6 +195,7 @@ namespace Aurora
 		MemPtr memPtrEnd = memPtrBegin + size;
 
 		m_MemorySizes.erase(it);
+		m_AllocationCount--;
 		std::memset(memPtrBegin, 0, size);
 
 		for (MemoryBlock& memoryBlock : m_Memory)
@@ -132,6 +206,7 @@ namespace Aurora
 				// Insert free fragment at the beginning
 				memoryBlock.Fragments.insert(memoryBlock.Fragments.begin(), MemoryFragment{memPtrBegin, memPtrEnd, size});
 				memoryBlock.FreeMemory += size;
+				m_UsedBytes -= size;
 
 				// TODO: merge blocks with same begin or end
 
@@ -147,6 +222,9 @@ namespace Aurora
 		if(!ptr)
 			return false;
 
+		if (m_Mode == EMode::SizeClass)
+			return CheckMemorySizeClass(ptr);
+
 		MemPtr memPtrBegin = reinterpret_cast<MemPtr>(ptr);
 
 		auto it = m_MemorySizes.find((uintptr_t)memPtrBegin);
@@ -158,4 +236,267 @@ namespace Aurora
 
 		return true;
 	}
+
+	Aum::Stats Aum::GetStats() const
+	{
+		Stats stats;
+		stats.BlockCount = m_Memory.size();
+		stats.TotalBytes = (size_t)m_BlockSize * m_Memory.size();
+		stats.AllocationCount = m_AllocationCount;
+
+		for (const MemoryBlock& memoryBlock : m_Memory)
+		{
+			stats.FreeBytes += memoryBlock.FreeMemory;
+
+			if (m_Mode == EMode::FirstFit)
+			{
+				for (const MemoryFragment& fragment : memoryBlock.Fragments)
+				{
+					stats.LargestFreeFragment = std::max<size_t>(stats.LargestFreeFragment, fragment.Size);
+				}
+
+				stats.FreeFragmentCount += memoryBlock.Fragments.size();
+				continue;
+			}
+
+			// Walk physical blocks until the sentinel
+			auto* block = reinterpret_cast<const BlockHeader*>(memoryBlock.Memory);
+			while (block->Size != 0)
+			{
+				if (block->Flags & BlockFlagFree)
+				{
+					stats.LargestFreeFragment = std::max<size_t>(stats.LargestFreeFragment, block->Size);
+					stats.FreeFragmentCount++;
+				}
+
+				block = reinterpret_cast<const BlockHeader*>(reinterpret_cast<const uint8_t*>(block) + block->Size);
+			}
+		}
+
+		stats.UsedBytes = stats.TotalBytes - stats.FreeBytes;
+
+		return stats;
+	}
+
+	void Aum::MapSizeToClass(MemSize size, uint32_t& fl, uint32_t& sl)
+	{
+		if (size < SmallBlockSize)
+		{
+			fl = 0;
+			sl = size / (SmallBlockSize / SLCount);
+			return;
+		}
+
+		uint32_t highBit = std::bit_width(size) - 1;
+		sl = (size >> (highBit - SLLog2)) ^ (1u << SLLog2);
+		fl = highBit - (FLShift - 1);
+	}
+
+	void Aum::InsertFreeBlock(BlockHeader* block)
+	{
+		uint32_t fl, sl;
+		MapSizeToClass(block->Size, fl, sl);
+
+		auto* links = reinterpret_cast<FreeBlockLinks*>(block + 1);
+		BlockHeader* head = m_FreeLists[fl][sl];
+
+		links->Prev = nullptr;
+		links->Next = head;
+
+		if (head)
+		{
+			reinterpret_cast<FreeBlockLinks*>(head + 1)->Prev = block;
+		}
+
+		m_FreeLists[fl][sl] = block;
+		m_FLBitmap |= 1u << fl;
+		m_SLBitmap[fl] |= 1u << sl;
+	}
+
+	void Aum::RemoveFreeBlock(BlockHeader* block)
+	{
+		uint32_t fl, sl;
+		MapSizeToClass(block->Size, fl, sl);
+
+		auto* links = reinterpret_cast<FreeBlockLinks*>(block + 1);
+
+		if (links->Prev)
+		{
+			reinterpret_cast<FreeBlockLinks*>(links->Prev + 1)->Next = links->Next;
+		}
+		else
+		{
+			m_FreeLists[fl][sl] = links->Next;
+		}
+
+		if (links->Next)
+		{
+			reinterpret_cast<FreeBlockLinks*>(links->Next + 1)->Prev = links->Prev;
+		}
+
+		if (m_FreeLists[fl][sl] == nullptr)
+		{
+			m_SLBitmap[fl] &= ~(1u << sl);
+
+			if (m_SLBitmap[fl] == 0)
+			{
+				m_FLBitmap &= ~(1u << fl);
+			}
+		}
+	}
+
+	Aum::BlockHeader* Aum::FindFreeBlock(MemSize size)
+	{
+		// Round up to the next class so every block in the found list is large enough
+		MemSize roundedSize = size;
+		if (size >= SmallBlockSize)
+		{
+			roundedSize += (1u << (std::bit_width(size) - 1 - SLLog2)) - 1;
+		}
+
+		uint32_t fl, sl;
+		MapSizeToClass(roundedSize, fl, sl);
+
+		if (fl < FLCount)
+		{
+			uint32_t slMap = m_SLBitmap[fl] & (~0u << sl);
+
+			if (slMap == 0)
+			{
+				uint32_t flMap = (fl + 1 < FLCount) ? (m_FLBitmap & (~0u << (fl + 1))) : 0;
+				fl = std::countr_zero(flMap);
+				slMap = flMap != 0 ? m_SLBitmap[fl] : 0;
+			}
+
+			if (slMap != 0)
+			{
+				sl = std::countr_zero(slMap);
+				return m_FreeLists[fl][sl];
+			}
+		}
+
+		// Nothing in the classes above, blocks of the exact class may still be large enough (sizes close to the memory block size)
+		MapSizeToClass(size, fl, sl);
+
+		for (BlockHeader* block = m_FreeLists[fl][sl]; block != nullptr; block = reinterpret_cast<FreeBlockLinks*>(block + 1)->Next)
+		{
+			if (block->Size >= size)
+				return block;
+		}
+
+		return nullptr;
+	}
+
+	MemPtr Aum::AllocSizeClass(MemSize size)
+	{
+		MemSize blockSize = std::max<MemSize>(Align<MemSize>(size, 16) + HeaderSize, MinBlockSize);
+		au_assert(blockSize <= m_BlockSize - HeaderSize);
+
+		BlockHeader* block = FindFreeBlock(blockSize);
+
+		if (!block)
+		{
+			AllocateMemoryBlock();
+			block = FindFreeBlock(blockSize);
+		}
+
+		if (!block)
+		{
+			AU_LOG_FATAL("Could not allocate ", size, " bytes in ", m_Name, " !");
+			return nullptr;
+		}
+
+		RemoveFreeBlock(block);
+
+		// Split the remainder back to the free lists
+		MemSize remaining = block->Size - blockSize;
+		if (remaining >= MinBlockSize)
+		{
+			auto* rest = reinterpret_cast<BlockHeader*>(reinterpret_cast<MemPtr>(block) + blockSize);
+			rest->Size = remaining;
+			rest->PrevSize = blockSize;
+			rest->Flags = BlockFlagFree;
+			rest->MemoryBlockIndex = block->MemoryBlockIndex;
+			rest->Magic = BlockMagic;
+
+			auto* next = reinterpret_cast<BlockHeader*>(reinterpret_cast<MemPtr>(rest) + remaining);
+			next->PrevSize = remaining;
+
+			block->Size = blockSize;
+			InsertFreeBlock(rest);
+		}
+
+		block->Flags &= ~BlockFlagFree;
+		m_Memory[block->MemoryBlockIndex].FreeMemory -= block->Size;
+		m_UsedBytes += block->Size;
+		m_AllocationCount++;
+
+		return reinterpret_cast<MemPtr>(block + 1);
+	}
+
+	void Aum::DeAllocSizeClass(void* mem)
+	{
+		if (!CheckMemorySizeClass(mem))
+		{
+			AU_LOG_FATAL("Memory ", PointerToString(mem), " is not part of this allocator !");
+			return;
+		}
+
+		BlockHeader* block = reinterpret_cast<BlockHeader*>(mem) - 1;
+
+		m_Memory[block->MemoryBlockIndex].FreeMemory += block->Size;
+		m_UsedBytes -= block->Size;
+		m_AllocationCount--;
+		block->Flags |= BlockFlagFree;
+
+		// Merge with previous free neighbour
+		if (block->PrevSize != 0)
+		{
+			auto* prev = reinterpret_cast<BlockHeader*>(reinterpret_cast<MemPtr>(block) - block->PrevSize);
+
+			if (prev->Flags & BlockFlagFree)
+			{
+				RemoveFreeBlock(prev);
+				prev->Size += block->Size;
+				block->Magic = 0;
+				block = prev;
+			}
+		}
+
+		// Merge with next free neighbour, the sentinel is never free
+		auto* next = reinterpret_cast<BlockHeader*>(reinterpret_cast<MemPtr>(block) + block->Size);
+
+		if (next->Flags & BlockFlagFree)
+		{
+			RemoveFreeBlock(next);
+			block->Size += next->Size;
+			next->Magic = 0;
+			next = reinterpret_cast<BlockHeader*>(reinterpret_cast<MemPtr>(block) + block->Size);
+		}
+
+		next->PrevSize = block->Size;
+
+		InsertFreeBlock(block);
+	}
+
+	bool Aum::CheckMemorySizeClass(void* ptr) const
+	{
+		auto memPtr = reinterpret_cast<MemPtr>(ptr);
+
+		if (((uintptr_t)memPtr & 15) != 0)
+			return false;
+
+		// The header names its memory block, so only that one is checked
+		const BlockHeader* block = reinterpret_cast<const BlockHeader*>(ptr) - 1;
+
+		if (block->MemoryBlockIndex >= m_Memory.size())
+			return false;
+
+		const MemoryBlock& memoryBlock = m_Memory[block->MemoryBlockIndex];
+
+		if (memPtr < memoryBlock.Memory + HeaderSize || memPtr >= memoryBlock.Memory + m_BlockSize)
+			return false;
+
+		return block->Magic == BlockMagic && !(block->Flags & BlockFlagFree);
+	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <utility>
 #include <vector>
 #include <string>
@@ -30,6 +31,34 @@ namespace Aurora
 	class AU_API Aum
 	{
 	public:
+		enum class EMode : uint8_t
+		{
+			// Linear scan over fragments of every block, sizes are kept in a hash map
+			FirstFit,
+			// TLSF-like segregated free lists with in-place headers, O(1) alloc and free with neighbour coalescing
+			SizeClass
+		};
+
+		struct Stats
+		{
+			size_t BlockCount = 0;
+			size_t TotalBytes = 0;
+			size_t UsedBytes = 0;
+			size_t FreeBytes = 0;
+			size_t LargestFreeFragment = 0;
+			size_t FreeFragmentCount = 0;
+			size_t AllocationCount = 0;
+
+			// 0 means all free memory is in one fragment, close to 1 means it is split into many small ones
+			[[nodiscard]] double GetFragmentation() const
+			{
+				if (FreeBytes == 0)
+					return 0.0;
+
+				return 1.0 - (double)LargestFreeFragment / (double)FreeBytes;
+			}
+		};
+
 		struct MemoryFragment
 		{
 			MemPtr Begin;
@@ -44,18 +73,57 @@ namespace Aurora
 			MemSize FreeMemory;
 		};
 
-		static std::vector<Aum*> AllMemoryAllocators;
+		static constexpr MemSize DefaultBlockSize = 8388608; // 8MB
 	private:
+		// Header placed right before every block in SizeClass mode, free blocks keep their list links in the payload
+		struct BlockHeader
+		{
+			MemSize Size; // Size of the whole block including this header
+			MemSize PrevSize; // Size of the physically previous block, 0 for the first block in memory block
+			uint16_t Flags;
+			uint16_t MemoryBlockIndex;
+			uint32_t Magic;
+		};
+
+		struct FreeBlockLinks
+		{
+			BlockHeader* Next;
+			BlockHeader* Prev;
+		};
+
+		static constexpr MemSize HeaderSize = sizeof(BlockHeader);
+		static constexpr MemSize MinBlockSize = HeaderSize + sizeof(FreeBlockLinks);
+		static constexpr uint32_t SLLog2 = 4;
+		static constexpr uint32_t SLCount = 1u << SLLog2;
+		static constexpr uint32_t AlignLog2 = 4;
+		static constexpr uint32_t FLShift = SLLog2 + AlignLog2;
+		static constexpr MemSize SmallBlockSize = 1u << FLShift;
+		static constexpr uint32_t FLCount = 32 - FLShift + 1;
+
+		static_assert(HeaderSize == 16, "Block header must keep 16 byte alignment of payload");
+
+		EMode m_Mode;
 		MemSize m_BlockSize;
 		std::vector<MemoryBlock> m_Memory;
+		size_t m_AllocationCount = 0;
+		// Same as Stats::UsedBytes, kept up to date so it can be read every frame without walking the blocks
+		size_t m_UsedBytes = 0;
+
+		uint32_t m_FLBitmap = 0;
+		uint32_t m_SLBitmap[FLCount] = {};
+		BlockHeader* m_FreeLists[FLCount][SLCount] = {};
+
 #ifdef DEBUG
 		std::unordered_map<uintptr_t, MemSize> m_MemorySizes;
 #else
 		robin_hood::unordered_map<uintptr_t, MemSize> m_MemorySizes;
 #endif
 		std::string m_Name = "Unknown";
+
+		// Guarded by a lock in Aum.cpp, allocators register from any thread (ThreadArenas)
+		static std::vector<Aum*> AllMemoryAllocators;
 	public:
-		explicit Aum(MemSize blockSize = 8388608); // 8MB Default block
+		explicit Aum(MemSize blockSize = DefaultBlockSize, EMode mode = EMode::FirstFit);
 		Aum(MemSize objectSize, MemSize objectCount); // 8MB Default block
 		~Aum();
 
@@ -93,8 +161,15 @@ namespace Aurora
 			DeAlloc(mem);
 		}
 
+		// In SizeClass mode the header in front of ptr is read, so ptr has to be 16 byte aligned memory of some allocation
 		bool CheckMemory(void* ptr) const;
 
+		// Walks every block, use the counters below for per-frame reads
+		[[nodiscard]] Stats GetStats() const;
+		[[nodiscard]] size_t GetUsedBytes() const { return m_UsedBytes; }
+		[[nodiscard]] size_t GetAllocationCount() const { return m_AllocationCount; }
+		[[nodiscard]] EMode GetMode() const { return m_Mode; }
+
 		[[nodiscard]] MemSize GetMemoryBlockCount() const
 		{
 			return m_Memory.size();
@@ -113,11 +188,25 @@ namespace Aurora
 			return m_Memory;
 		}
 
+		// Runs func for every registered allocator with the registry locked, so none is destroyed meanwhile.
+		// func must not create or destroy allocators. Stats of an allocator that another thread allocates from are not synchronized.
+		static void ForEachAllocator(const std::function<void(Aum*)>& func);
+		// Empties the registry, allocators destroyed afterwards are not looked up anymore
+		static void ClearAllocators();
+
 		inline const std::string& GetName() const { return m_Name; }
 		inline void SetName(const std::string& name) { m_Name = name; }
 	private:
 		MemoryBlock& AllocateMemoryBlock();
 		void DestroyMemory();
 		MemPtr AllocFromFragment(MemoryBlock& memoryBlock, const std::vector<MemoryFragment>::iterator& framentIt, MemSize size);
+
+		static void MapSizeToClass(MemSize size, uint32_t& fl, uint32_t& sl);
+		MemPtr AllocSizeClass(MemSize size);
+		void DeAllocSizeClass(void* mem);
+		[[nodiscard]] bool CheckMemorySizeClass(void* ptr) const;
+		void InsertFreeBlock(BlockHeader* block);
+		void RemoveFreeBlock(BlockHeader* block);
+		BlockHeader* FindFreeBlock(MemSize size);
 	};
 }
\ No newline at end of file
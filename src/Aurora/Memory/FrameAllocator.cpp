@@ -0,0 +1,182 @@
+#include "FrameAllocator.hpp"
+
+#include <algorithm>
+#include "Aurora/Core/assert.hpp"
+
+namespace Aurora
+{
+	FrameAllocator::FrameAllocator(MemSize chunkSize)
+		: m_Memory(Align<MemSize>(chunkSize + 64, 16) * 4, Aum::EMode::SizeClass),
+		m_ChunkSize(Align<MemSize>(chunkSize, 16)),
+		m_BufferIndex(0),
+		m_BackingAllocations(0),
+		m_FrameAllocations(0),
+		m_FrameBytes(0),
+		m_LastFrameAllocations(0),
+		m_LastFrameBytes(0),
+		m_PeakFrameBytes(0)
+	{
+		m_Memory.SetName("FrameAllocator");
+
+		for (Buffer& buffer : m_Buffers)
+		{
+			buffer.Chunks.push_back(CreateChunk(m_ChunkSize));
+			buffer.Current = buffer.Chunks[0];
+			buffer.CurrentIndex = 0;
+		}
+	}
+
+	FrameAllocator::~FrameAllocator()
+	{
+		for (Buffer& buffer : m_Buffers)
+		{
+			for (Chunk* chunk : buffer.Chunks)
+			{
+				if (chunk->Size > m_ChunkSize)
+					delete[] chunk->Memory;
+				else
+					m_Memory.DeAlloc(chunk->Memory);
+
+				delete chunk;
+			}
+		}
+	}
+
+	FrameAllocator::Chunk* FrameAllocator::CreateChunk(MemSize size)
+	{
+		m_BackingAllocations++;
+
+		auto* chunk = new Chunk();
+		chunk->Size = size;
+		chunk->Offset = 0;
+
+		// Oversized chunks do not fit into Aum blocks
+		if (size > m_ChunkSize)
+			chunk->Memory = new uint8_t[size];
+		else
+			chunk->Memory = m_Memory.Alloc(size);
+
+		return chunk;
+	}
+
+	MemPtr FrameAllocator::Alloc(MemSize size, MemSize alignment)
+	{
+		au_assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+		// Chunk memory and all offsets are 16 byte aligned, bigger alignments are padded
+		MemSize allocSize = Align<MemSize>(std::max<MemSize>(size, 1), 16);
+		if (alignment > 16)
+			allocSize += alignment;
+
+		m_FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+		m_FrameBytes.fetch_add(allocSize, std::memory_order_relaxed);
+
+		Buffer& buffer = m_Buffers[m_BufferIndex];
+		Chunk* chunk = buffer.Current.load(std::memory_order_acquire);
+
+		MemSize offset = chunk->Offset.fetch_add(allocSize, std::memory_order_relaxed);
+		MemPtr memory;
+
+		if (offset <= chunk->Size && chunk->Size - offset >= allocSize)
+			memory = chunk->Memory + offset;
+		else
+			memory = AllocSlow(buffer, chunk, allocSize);
+
+		if (alignment > 16)
+			memory = Align<MemPtr>(memory, alignment);
+
+		return memory;
+	}
+
+	MemPtr FrameAllocator::AllocSlow(Buffer& buffer, Chunk* chunk, MemSize size)
+	{
+		std::lock_guard<std::mutex> lock(m_GrowMutex);
+
+		while (true)
+		{
+			Chunk* current = buffer.Current.load(std::memory_order_acquire);
+
+			// Another thread might have already moved to a new chunk
+			if (current != chunk)
+			{
+				MemSize offset = current->Offset.fetch_add(size, std::memory_order_relaxed);
+
+				if (offset <= current->Size && current->Size - offset >= size)
+					return current->Memory + offset;
+
+				chunk = current;
+				continue;
+			}
+
+			// Reuse chunk from previous frames or create a new one
+			Chunk* next = nullptr;
+
+			while (buffer.CurrentIndex + 1 < buffer.Chunks.size())
+			{
+				Chunk* candidate = buffer.Chunks[++buffer.CurrentIndex];
+
+				if (candidate->Size >= size)
+				{
+					next = candidate;
+					break;
+				}
+			}
+
+			if (!next)
+			{
+				next = CreateChunk(std::max<MemSize>(m_ChunkSize, size));
+				buffer.Chunks.push_back(next);
+				buffer.CurrentIndex = buffer.Chunks.size() - 1;
+			}
+
+			next->Offset.store(size, std::memory_order_relaxed);
+			buffer.Current.store(next, std::memory_order_release);
+
+			return next->Memory;
+		}
+	}
+
+	void FrameAllocator::BeginFrame()
+	{
+		m_LastFrameAllocations = m_FrameAllocations.exchange(0);
+		m_LastFrameBytes = m_FrameBytes.exchange(0);
+		m_PeakFrameBytes = std::max(m_PeakFrameBytes, m_LastFrameBytes);
+
+		m_BufferIndex = (m_BufferIndex + 1) % BufferCount;
+
+		Buffer& buffer = m_Buffers[m_BufferIndex];
+
+		for (Chunk* chunk : buffer.Chunks)
+		{
+			chunk->Offset.store(0, std::memory_order_relaxed);
+		}
+
+		buffer.CurrentIndex = 0;
+		buffer.Current.store(buffer.Chunks[0], std::memory_order_release);
+	}
+
+	FrameAllocator::Stats FrameAllocator::GetStats() const
+	{
+		Stats stats;
+		stats.BackingAllocations = m_BackingAllocations.load();
+		stats.FrameAllocations = m_LastFrameAllocations;
+		stats.FrameBytes = m_LastFrameBytes;
+		stats.PeakFrameBytes = m_PeakFrameBytes;
+
+		for (const Buffer& buffer : m_Buffers)
+		{
+			for (const Chunk* chunk : buffer.Chunks)
+			{
+				stats.ReservedBytes += chunk->Size;
+			}
+		}
+
+		return stats;
+	}
+
+	FrameAllocator& FrameAllocator::Get()
+	{
+		static FrameAllocator allocator;
+		return allocator;
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <limits>
+#include "Aum.hpp"
+
+namespace Aurora
+{
+	// Double-buffered linear allocator for data that lives at most until the end of the next frame.
+	// Alloc is thread-safe and lock-free while the current chunk has space, BeginFrame must be called
+	// once per frame when no other thread allocates. Chunks are kept between frames, so after warm-up
+	// a frame does not allocate any memory from Aum.
+	class AU_API FrameAllocator
+	{
+	public:
+		static constexpr MemSize DefaultChunkSize = 1024 * 1024; // 1MB
+		static constexpr uint32_t BufferCount = 2;
+
+		struct Stats
+		{
+			size_t BackingAllocations = 0; // Chunks allocated from Aum since creation
+			size_t FrameAllocations = 0; // Allocations made in the last finished frame
+			size_t FrameBytes = 0; // Bytes allocated in the last finished frame
+			size_t PeakFrameBytes = 0;
+			size_t ReservedBytes = 0;
+		};
+	private:
+		struct Chunk
+		{
+			MemPtr Memory;
+			MemSize Size;
+			std::atomic<MemSize> Offset;
+		};
+
+		struct Buffer
+		{
+			std::vector<Chunk*> Chunks;
+			std::atomic<Chunk*> Current = nullptr;
+			size_t CurrentIndex = 0;
+		};
+
+		Aum m_Memory;
+		MemSize m_ChunkSize;
+		Buffer m_Buffers[BufferCount];
+		uint32_t m_BufferIndex;
+		std::mutex m_GrowMutex;
+
+		std::atomic<size_t> m_BackingAllocations;
+		std::atomic<size_t> m_FrameAllocations;
+		std::atomic<size_t> m_FrameBytes;
+		size_t m_LastFrameAllocations;
+		size_t m_LastFrameBytes;
+		size_t m_PeakFrameBytes;
+	public:
+		explicit FrameAllocator(MemSize chunkSize = DefaultChunkSize);
+		~FrameAllocator();
+
+		FrameAllocator(const FrameAllocator&) = delete;
+		FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+		// Returned memory is 16 byte aligned unless larger alignment is requested
+		MemPtr Alloc(MemSize size, MemSize alignment = 16);
+
+		template<typename T>
+		T* Alloc(MemSize count = 1)
+		{
+			return reinterpret_cast<T*>(Alloc(sizeof(T) * count, alignof(T) > 16 ? alignof(T) : 16));
+		}
+
+		// Switches to the other buffer and resets it, memory from the previous frame stays valid for one more frame
+		void BeginFrame();
+
+		[[nodiscard]] Stats GetStats() const;
+
+		static FrameAllocator& Get();
+	private:
+		MemPtr AllocSlow(Buffer& buffer, Chunk* chunk, MemSize size);
+		Chunk* CreateChunk(MemSize size);
+	};
+
+	// STL allocator adapter, deallocate is a no-op because memory is released by FrameAllocator::BeginFrame
+	template<typename T>
+	class FrameStlAllocator
+	{
+	private:
+		FrameAllocator* m_Allocator;
+	public:
+		typedef T value_type;
+
+		FrameStlAllocator() noexcept : m_Allocator(&FrameAllocator::Get()) {}
+		explicit FrameStlAllocator(FrameAllocator& allocator) noexcept : m_Allocator(&allocator) {}
+
+		template<typename U>
+		FrameStlAllocator(const FrameStlAllocator<U>& other) noexcept : m_Allocator(other.GetAllocator()) {}
+
+		T* allocate(std::size_t n)
+		{
+			return reinterpret_cast<T*>(m_Allocator->Alloc((MemSize)(sizeof(T) * n), alignof(T) > 16 ? alignof(T) : 16));
+		}
+
+		void deallocate(T*, std::size_t) noexcept {}
+
+		[[nodiscard]] FrameAllocator* GetAllocator() const noexcept { return m_Allocator; }
+
+		template<typename U>
+		bool operator==(const FrameStlAllocator<U>& other) const noexcept { return m_Allocator == other.GetAllocator(); }
+
+		template<typename U>
+		bool operator!=(const FrameStlAllocator<U>& other) const noexcept { return m_Allocator != other.GetAllocator(); }
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+}
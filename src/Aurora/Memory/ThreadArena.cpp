@@ -0,0 +1,109 @@
+#include "ThreadArena.hpp"
+
+#include <algorithm>
+#include "Aurora/Core/assert.hpp"
+
+namespace Aurora
+{
+	static std::atomic<uint64_t> s_NextArenasID = 1;
+
+	struct ThreadArenaCacheEntry
+	{
+		uint64_t ArenasID;
+		void* Arena;
+	};
+
+	// IDs are never reused, so entries of destroyed arena sets can never match again
+	static thread_local std::vector<ThreadArenaCacheEntry> t_ArenaCache;
+
+	ThreadArenas::ThreadArenas(std::string name, MemSize blockSize)
+		: m_ID(s_NextArenasID.fetch_add(1)), m_BlockSize(blockSize), m_Name(std::move(name)), m_AllocationCount(0)
+	{
+
+	}
+
+	ThreadArenas::~ThreadArenas() = default;
+
+	ThreadArenas::Arena* ThreadArenas::GetThreadArena()
+	{
+		for (const ThreadArenaCacheEntry& entry : t_ArenaCache)
+		{
+			if (entry.ArenasID == m_ID)
+			{
+				return static_cast<Arena*>(entry.Arena);
+			}
+		}
+
+		Arena* arena;
+
+		{
+			std::lock_guard<std::mutex> lock(m_ArenasMutex);
+			arena = m_Arenas.emplace_back(std::make_unique<Arena>(m_BlockSize)).get();
+			arena->Memory.SetName(m_Name + " #" + std::to_string(m_Arenas.size() - 1));
+		}
+
+		t_ArenaCache.push_back({m_ID, arena});
+
+		return arena;
+	}
+
+	MemPtr ThreadArenas::Alloc(MemSize size)
+	{
+		Arena* arena = GetThreadArena();
+
+		MemPtr memory;
+		{
+			std::lock_guard<std::mutex> lock(arena->Mutex);
+			memory = arena->Memory.Alloc(size + PrefixSize);
+		}
+
+		*reinterpret_cast<Arena**>(memory) = arena;
+		m_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+		return memory + PrefixSize;
+	}
+
+	void ThreadArenas::DeAlloc(void* mem)
+	{
+		if (!mem)
+			return;
+
+		MemPtr memory = reinterpret_cast<MemPtr>(mem) - PrefixSize;
+		Arena* arena = *reinterpret_cast<Arena**>(memory);
+
+		{
+			std::lock_guard<std::mutex> lock(arena->Mutex);
+			arena->Memory.DeAlloc(memory);
+		}
+
+		m_AllocationCount.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	size_t ThreadArenas::GetArenaCount()
+	{
+		std::lock_guard<std::mutex> lock(m_ArenasMutex);
+		return m_Arenas.size();
+	}
+
+	Aum::Stats ThreadArenas::GetStats()
+	{
+		Aum::Stats stats;
+
+		std::lock_guard<std::mutex> lock(m_ArenasMutex);
+		for (const auto& arena : m_Arenas)
+		{
+			std::lock_guard<std::mutex> arenaLock(arena->Mutex);
+			Aum::Stats arenaStats = arena->Memory.GetStats();
+
+			stats.BlockCount += arenaStats.BlockCount;
+			stats.TotalBytes += arenaStats.TotalBytes;
+			stats.UsedBytes += arenaStats.UsedBytes;
+			stats.FreeBytes += arenaStats.FreeBytes;
+			stats.LargestFreeFragment = std::max(stats.LargestFreeFragment, arenaStats.LargestFreeFragment);
+			stats.FreeFragmentCount += arenaStats.FreeFragmentCount;
+			stats.AllocationCount += arenaStats.AllocationCount;
+		}
+
+		return stats;
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Aum.hpp"
+
+namespace Aurora
+{
+	// Set of SizeClass Aum arenas, one per thread that allocates through it.
+	// Every allocation remembers its arena in a small prefix, so memory can be freed from any thread.
+	// Arena locks are only contended when a thread frees memory allocated by another thread.
+	class AU_API ThreadArenas
+	{
+	private:
+		struct Arena
+		{
+			std::mutex Mutex;
+			Aum Memory;
+
+			explicit Arena(MemSize blockSize) : Mutex(), Memory(blockSize, Aum::EMode::SizeClass) {}
+		};
+
+		static constexpr MemSize PrefixSize = 16;
+
+		uint64_t m_ID;
+		MemSize m_BlockSize;
+		std::string m_Name;
+		std::mutex m_ArenasMutex;
+		std::vector<std::unique_ptr<Arena>> m_Arenas;
+		std::atomic<size_t> m_AllocationCount;
+	public:
+		explicit ThreadArenas(std::string name, MemSize blockSize = Aum::DefaultBlockSize);
+		~ThreadArenas();
+
+		ThreadArenas(const ThreadArenas&) = delete;
+		ThreadArenas& operator=(const ThreadArenas&) = delete;
+
+		MemPtr Alloc(MemSize size);
+		void DeAlloc(void* mem);
+
+		template<typename T, typename... Args>
+		T* New(Args&&... args)
+		{
+			return new(Alloc(sizeof(T))) T(std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		void Delete(T* object)
+		{
+			if (!object)
+				return;
+
+			object->~T();
+			DeAlloc(object);
+		}
+
+		[[nodiscard]] size_t GetArenaCount();
+		[[nodiscard]] size_t GetAllocationCount() const { return m_AllocationCount.load(); }
+		[[nodiscard]] Aum::Stats GetStats();
+	private:
+		Arena* GetThreadArena();
+	};
+
+	template<typename T>
+	class ArenaStlAllocator
+	{
+	private:
+		ThreadArenas* m_Arenas;
+	public:
+		typedef T value_type;
+
+		explicit ArenaStlAllocator(ThreadArenas& arenas) noexcept : m_Arenas(&arenas) {}
+
+		template<typename U>
+		ArenaStlAllocator(const ArenaStlAllocator<U>& other) noexcept : m_Arenas(other.GetArenas()) {}
+
+		T* allocate(std::size_t n)
+		{
+			static_assert(alignof(T) <= 16, "Arena memory is only 16 byte aligned");
+			return reinterpret_cast<T*>(m_Arenas->Alloc((MemSize)(sizeof(T) * n)));
+		}
+
+		void deallocate(T* ptr, std::size_t) noexcept
+		{
+			m_Arenas->DeAlloc(ptr);
+		}
+
+		[[nodiscard]] ThreadArenas* GetArenas() const noexcept { return m_Arenas; }
+
+		template<typename U>
+		bool operator==(const ArenaStlAllocator<U>& other) const noexcept { return m_Arenas == other.GetArenas(); }
+
+		template<typename U>
+		bool operator!=(const ArenaStlAllocator<U>& other) const noexcept { return m_Arenas != other.GetArenas(); }
+	};
+}
@@ -51,15 +51,13 @@ namespace Aurora
 
 		[[nodiscard]] bool Overlaps(const AABB& other) const
 		{
-			// y is deliberately first in the list of checks below as it is seen as more likely than things
-			// collide on x,z but not on y than they do on y thus we drop out sooner on a y fail
-			/*return m_Max.x > other.m_Min.x &&
+			// Inlined version of IntersectsWith, this is the hot test of every tree query
+			return m_Max.x > other.m_Min.x &&
 				m_Min.x < other.m_Max.x &&
 				m_Max.y > other.m_Min.y &&
 				m_Min.y < other.m_Max.y &&
 				m_Max.z > other.m_Min.z &&
-				m_Min.z < other.m_Max.z;*/
-			return IntersectsWith(other);
+				m_Min.z < other.m_Max.z;
 		}
 
 		[[nodiscard]] bool Contains(const AABB& other) const
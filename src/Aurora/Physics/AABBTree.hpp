@@ -1,13 +1,16 @@
 #pragma once
 
-#include <memory>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <span>
 #include <vector>
-#include <map>
-#include <forward_list>
-#include <stack>
+#include <type_traits>
 
 #include "Aurora/Core/Types.hpp"
 #include "Aurora/Physics/AABB.hpp"
+#include "Aurora/Tools/robin_hood.h"
 
 #define AABB_NULL_NODE 0xffffffff
 
@@ -18,146 +21,507 @@ namespace Aurora
 	template<typename T>
 	struct AABBNode
 	{
+		// Leaves store the fattened bounds of the object
 		AABB aabb;
 		T* Object;
 		// tree links
-		unsigned parentNodeIndex;
-		unsigned leftNodeIndex;
-		unsigned rightNodeIndex;
+		NodeIndex_t parentNodeIndex;
+		NodeIndex_t leftNodeIndex;
+		NodeIndex_t rightNodeIndex;
 		// node linked list link
-		unsigned nextNodeIndex;
+		NodeIndex_t nextNodeIndex;
+		// 0 for leaves, -1 for free nodes
+		int32_t height;
 
 		[[nodiscard]] bool IsLeaf() const { return leftNodeIndex == AABB_NULL_NODE; }
+		[[nodiscard]] bool IsFree() const { return height < 0; }
 
-		AABBNode() : Object(nullptr), parentNodeIndex(AABB_NULL_NODE), leftNodeIndex(AABB_NULL_NODE), rightNodeIndex(AABB_NULL_NODE), nextNodeIndex(AABB_NULL_NODE)
+		AABBNode() : Object(nullptr), parentNodeIndex(AABB_NULL_NODE), leftNodeIndex(AABB_NULL_NODE), rightNodeIndex(AABB_NULL_NODE), nextNodeIndex(AABB_NULL_NODE), height(-1)
 		{
 
 		}
 	};
 
+	// Persistent dynamic bounding volume tree, objects are inserted once and updated when they move.
+	// Leaves keep fattened bounds, so an object is only reinserted when its bounds leave the fat box.
+	// Insert and remove rebalance the tree with rotations. Queries use a fixed stack and never allocate.
+	// Insert returns a proxy (leaf node index) which can be stored by the owner to skip the object lookup.
 	template<typename T>
 	class AABBTree
 	{
+	public:
+		static constexpr uint32_t MaxQueryStackSize = 256;
+		// Moving objects get their fat box extended along the displacement, predicting a few steps ahead
+		static constexpr float DisplacementMultiplier = 4.0f;
+		// Rays of one packet are tracked in a 32-bit mask
+		static constexpr uint32_t MaxPacketSize = 32;
 	private:
-		std::map<T*, unsigned> _objectNodeIndexMap;
+		robin_hood::unordered_flat_map<T*, NodeIndex_t> _objectNodeIndexMap;
 		std::vector<AABBNode<T>> _nodes;
-		unsigned _rootNodeIndex;
-		unsigned _allocatedNodeCount;
-		unsigned _nextFreeNodeIndex;
-		unsigned _nodeCapacity;
-		unsigned _growthSize;
+		NodeIndex_t _rootNodeIndex;
+		uint32_t _allocatedNodeCount;
+		NodeIndex_t _nextFreeNodeIndex;
+		float _fatMargin;
 	public:
-		AABBTree(unsigned initialSize) : _rootNodeIndex(AABB_NULL_NODE), _allocatedNodeCount(0), _nextFreeNodeIndex(0), _nodeCapacity(initialSize), _growthSize(initialSize)
+		explicit AABBTree(uint32_t initialCapacity = 16, float fatMargin = 0.1f) : _rootNodeIndex(AABB_NULL_NODE), _allocatedNodeCount(0), _nextFreeNodeIndex(AABB_NULL_NODE), _fatMargin(fatMargin)
 		{
-			_nodes.resize(initialSize);
-			for (unsigned nodeIndex = 0; nodeIndex < initialSize; nodeIndex++)
-			{
-				AABBNode<T>& node = _nodes[nodeIndex];
-				node.nextNodeIndex = nodeIndex + 1;
-			}
-			_nodes[initialSize-1].nextNodeIndex = AABB_NULL_NODE;
+			growPool(std::max(initialCapacity, 1u));
+		}
+
+		[[nodiscard]] const std::vector<AABBNode<T>>& GetNodes() const { return _nodes; }
+		[[nodiscard]] size_t GetObjectCount() const { return _objectNodeIndexMap.size(); }
+		[[nodiscard]] int32_t GetHeight() const { return _rootNodeIndex == AABB_NULL_NODE ? 0 : _nodes[_rootNodeIndex].height; }
+
+		[[nodiscard]] bool Contains(T* Object) const { return _objectNodeIndexMap.contains(Object); }
+
+		[[nodiscard]] NodeIndex_t GetProxy(T* Object) const
+		{
+			auto it = _objectNodeIndexMap.find(Object);
+			return it != _objectNodeIndexMap.end() ? it->second : AABB_NULL_NODE;
 		}
 
-		const std::vector<AABBNode<T>>& GetNodes() const { return _nodes; }
+		[[nodiscard]] const AABB& GetFatAABB(NodeIndex_t proxy) const { return _nodes[proxy].aabb; }
+		[[nodiscard]] T* GetObject(NodeIndex_t proxy) const { return _nodes[proxy].Object; }
 
-		void InsertObject(T* Object, const AABB& aabb)
+		NodeIndex_t InsertObject(T* Object, const AABB& aabb)
 		{
-			unsigned nodeIndex = allocateNode();
+			assert(!Contains(Object));
+
+			NodeIndex_t nodeIndex = allocateNode();
 			AABBNode<T>& node = _nodes[nodeIndex];
 
-			node.aabb = aabb;
+			node.aabb = fatten(aabb, Vector3(0.0f));
 			node.Object = Object;
+			node.height = 0;
 
 			insertLeaf(nodeIndex);
 			_objectNodeIndexMap[Object] = nodeIndex;
+
+			return nodeIndex;
 		}
 
 		void RemoveObject(T* Object)
 		{
-			unsigned nodeIndex = _objectNodeIndexMap[Object];
-			RemoveLeaf(nodeIndex);
+			auto it = _objectNodeIndexMap.find(Object);
+			if (it == _objectNodeIndexMap.end())
+				return;
+
+			NodeIndex_t nodeIndex = it->second;
+			_objectNodeIndexMap.erase(it);
+
+			removeLeaf(nodeIndex);
 			deallocateNode(nodeIndex);
-			_objectNodeIndexMap.erase(Object);
 		}
 
-		void UpdateObject(T* Object, const AABB& aabb)
+		void RemoveProxy(NodeIndex_t proxy)
+		{
+			assert(_nodes[proxy].IsLeaf() && !_nodes[proxy].IsFree());
+
+			_objectNodeIndexMap.erase(_nodes[proxy].Object);
+			removeLeaf(proxy);
+			deallocateNode(proxy);
+		}
+
+		// Returns true when the object left its fat box and was reinserted
+		bool UpdateObject(T* Object, const AABB& aabb, const Vector3& displacement = Vector3(0.0f))
 		{
-			unsigned nodeIndex = _objectNodeIndexMap[Object];
-			UpdateLeaf(nodeIndex, aabb);
+			NodeIndex_t proxy = GetProxy(Object);
+			assert(proxy != AABB_NULL_NODE);
+
+			return UpdateProxy(proxy, aabb, displacement);
 		}
 
-		std::forward_list<T*> QueryOverlaps(T* Object, const AABB& aabb) const
+		bool UpdateProxy(NodeIndex_t proxy, const AABB& aabb, const Vector3& displacement = Vector3(0.0f))
 		{
-			std::forward_list<T*> overlaps;
-			std::stack<unsigned> stack;
-			AABB testAabb = aabb;
+			assert(_nodes[proxy].IsLeaf() && !_nodes[proxy].IsFree());
+
+			if (_nodes[proxy].aabb.Contains(aabb))
+				return false;
+
+			// Removing a leaf never allocates, so the node stays where it is
+			removeLeaf(proxy);
+			_nodes[proxy].aabb = fatten(aabb, displacement);
+			insertLeaf(proxy);
+
+			return true;
+		}
+
+		void Clear()
+		{
+			_objectNodeIndexMap.clear();
+
+			if (_rootNodeIndex == AABB_NULL_NODE)
+				return;
+
+			auto capacity = (uint32_t)_nodes.size();
+			_nodes.clear();
+			_rootNodeIndex = AABB_NULL_NODE;
+			_allocatedNodeCount = 0;
+			_nextFreeNodeIndex = AABB_NULL_NODE;
+			growPool(capacity);
+		}
 
-			stack.push(_rootNodeIndex);
-			while(!stack.empty())
+		// Callback takes T* and may return false to stop the query
+		template<typename Callback>
+		void Query(const AABB& aabb, Callback&& callback) const
+		{
+			if (_rootNodeIndex == AABB_NULL_NODE)
+				return;
+
+			NodeIndex_t stack[MaxQueryStackSize];
+			uint32_t stackSize = 0;
+			stack[stackSize++] = _rootNodeIndex;
+
+			while (stackSize > 0)
 			{
-				unsigned nodeIndex = stack.top();
-				stack.pop();
+				const AABBNode<T>& node = _nodes[stack[--stackSize]];
 
-				if (nodeIndex == AABB_NULL_NODE) continue;
+				if (!node.aabb.Overlaps(aabb))
+					continue;
 
-				const AABBNode<T>& node = _nodes[nodeIndex];
-				if (node.aabb.Overlaps(testAabb))
+				if (node.IsLeaf())
 				{
-					if (node.IsLeaf() && node.Object != Object)
+					if constexpr (std::is_same_v<std::invoke_result_t<Callback, T*>, bool>)
 					{
-						overlaps.push_front(node.Object);
+						if (!callback(node.Object))
+							return;
 					}
 					else
 					{
-						stack.push(node.leftNodeIndex);
-						stack.push(node.rightNodeIndex);
+						callback(node.Object);
 					}
 				}
+				else
+				{
+					// The tree is balanced, so the stack holds at most height + 1 nodes
+					assert(stackSize + 2 <= MaxQueryStackSize);
+
+					stack[stackSize++] = node.leftNodeIndex;
+					stack[stackSize++] = node.rightNodeIndex;
+				}
 			}
+		}
 
-			return overlaps;
+		// Same as Query, but skips the object itself
+		template<typename Callback>
+		void QueryOverlaps(T* Object, const AABB& aabb, Callback&& callback) const
+		{
+			Query(aabb, [Object, &callback](T* other)
+			{
+				if (other == Object)
+					return true;
+
+				if constexpr (std::is_same_v<std::invoke_result_t<Callback, T*>, bool>)
+				{
+					return callback(other);
+				}
+				else
+				{
+					callback(other);
+					return true;
+				}
+			});
 		}
-	private:
-		unsigned allocateNode()
+
+		// Writes overlapping objects until the span is full, returns the written count
+		size_t QueryOverlaps(T* Object, const AABB& aabb, std::span<T*> results) const
 		{
-			// if we have no free tree nodes then grow the pool
-			if (_nextFreeNodeIndex == AABB_NULL_NODE)
+			size_t count = 0;
+
+			if (results.empty())
+				return 0;
+
+			QueryOverlaps(Object, aabb, [&results, &count](T* other)
 			{
-				// FIXME: This does not work correctly
+				results[count++] = other;
+				return count < results.size();
+			});
 
-				assert(_allocatedNodeCount == _nodeCapacity);
+			return count;
+		}
 
-				_nodeCapacity += _growthSize;
-				_nodes.resize(_nodeCapacity);
-				for (unsigned nodeIndex = _allocatedNodeCount; nodeIndex < _nodeCapacity; nodeIndex++)
+		// Walks the leaves hit by the ray in near to far order of their bounds. Callback(T*) returns the new max distance:
+		// the hit distance clips the ray, the current max distance continues and 0 stops the traversal.
+		// Bounds are grown by inflate, which turns the ray into a box or sphere sweep.
+		template<typename Callback>
+		void RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, const Vector3& inflate, Callback&& callback) const
+		{
+			if (_rootNodeIndex == AABB_NULL_NODE)
+				return;
+
+			struct StackEntry
+			{
+				NodeIndex_t Node;
+				float Entry;
+			};
+
+			Vector3 invDirection = InverseDirection(direction);
+
+			StackEntry stack[MaxQueryStackSize];
+			uint32_t stackSize = 0;
+
+			float rootEntry;
+			if (!RayIntersects(_nodes[_rootNodeIndex].aabb, inflate, origin, invDirection, maxDistance, rootEntry))
+				return;
+
+			stack[stackSize++] = {_rootNodeIndex, rootEntry};
+
+			while (stackSize > 0)
+			{
+				StackEntry entry = stack[--stackSize];
+
+				// the ray could have been clipped since this node was pushed
+				if (entry.Entry > maxDistance)
+					continue;
+
+				const AABBNode<T>& node = _nodes[entry.Node];
+
+				if (node.IsLeaf())
 				{
-					AABBNode<T>& node = _nodes[nodeIndex];
-					node.nextNodeIndex = nodeIndex + 1;
+					float newMaxDistance = callback(node.Object);
+
+					if (newMaxDistance <= 0.0f)
+						return;
+
+					maxDistance = std::min(maxDistance, newMaxDistance);
+					continue;
 				}
-				_nodes[_nodeCapacity - 1].nextNodeIndex = AABB_NULL_NODE;
-				_nextFreeNodeIndex = _allocatedNodeCount;
+
+				float leftEntry, rightEntry;
+				bool hitLeft = RayIntersects(_nodes[node.leftNodeIndex].aabb, inflate, origin, invDirection, maxDistance, leftEntry);
+				bool hitRight = RayIntersects(_nodes[node.rightNodeIndex].aabb, inflate, origin, invDirection, maxDistance, rightEntry);
+
+				assert(stackSize + 2 <= MaxQueryStackSize);
+
+				// the nearer child is pushed last so it is visited first
+				if (hitLeft && hitRight && leftEntry < rightEntry)
+				{
+					stack[stackSize++] = {node.rightNodeIndex, rightEntry};
+					stack[stackSize++] = {node.leftNodeIndex, leftEntry};
+				}
+				else
+				{
+					if (hitLeft)
+						stack[stackSize++] = {node.leftNodeIndex, leftEntry};
+
+					if (hitRight)
+						stack[stackSize++] = {node.rightNodeIndex, rightEntry};
+				}
+			}
+		}
+
+		// Traverses the tree once for a packet of rays, a node is entered while any ray of the packet still hits it,
+		// so coherent rays share the node fetches. Callback(rayIndex, T*) follows the RayCast contract for that ray,
+		// maxDistances are updated in place.
+		template<typename Callback>
+		void RayCastPacket(const Vector3* origins, const Vector3* directions, float* maxDistances, uint32_t count, const Vector3& inflate, Callback&& callback) const
+		{
+			assert(count <= MaxPacketSize);
+
+			if (_rootNodeIndex == AABB_NULL_NODE || count == 0)
+				return;
+
+			struct StackEntry
+			{
+				NodeIndex_t Node;
+				uint32_t RayMask;
+			};
+
+			Vector3 invDirections[MaxPacketSize];
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				invDirections[i] = InverseDirection(directions[i]);
 			}
 
-			unsigned nodeIndex = _nextFreeNodeIndex;
+			uint32_t activeMask = count == MaxPacketSize ? ~0u : (1u << count) - 1;
+
+			StackEntry stack[MaxQueryStackSize];
+			uint32_t stackSize = 0;
+			stack[stackSize++] = {_rootNodeIndex, activeMask};
+
+			while (stackSize > 0)
+			{
+				StackEntry entry = stack[--stackSize];
+				const AABBNode<T>& node = _nodes[entry.Node];
+
+				uint32_t hitMask = 0;
+				for (uint32_t rayMask = entry.RayMask & activeMask; rayMask != 0; rayMask &= rayMask - 1)
+				{
+					uint32_t ray = std::countr_zero(rayMask);
+					float entryDistance;
+
+					if (RayIntersects(node.aabb, inflate, origins[ray], invDirections[ray], maxDistances[ray], entryDistance))
+						hitMask |= 1u << ray;
+				}
+
+				if (hitMask == 0)
+					continue;
+
+				if (node.IsLeaf())
+				{
+					for (; hitMask != 0; hitMask &= hitMask - 1)
+					{
+						uint32_t ray = std::countr_zero(hitMask);
+						float newMaxDistance = callback(ray, node.Object);
+
+						if (newMaxDistance <= 0.0f)
+							activeMask &= ~(1u << ray);
+						else
+							maxDistances[ray] = std::min(maxDistances[ray], newMaxDistance);
+					}
+
+					if (activeMask == 0)
+						return;
+				}
+				else
+				{
+					assert(stackSize + 2 <= MaxQueryStackSize);
+
+					// visit the child nearer along the direction of the first ray first, so the packet gets clipped early
+					const Vector3& direction = directions[std::countr_zero(hitMask)];
+					const AABBNode<T>& leftNode = _nodes[node.leftNodeIndex];
+					const AABBNode<T>& rightNode = _nodes[node.rightNodeIndex];
+					float leftDistance = glm::dot(leftNode.aabb.GetMin() + leftNode.aabb.GetMax(), direction);
+					float rightDistance = glm::dot(rightNode.aabb.GetMin() + rightNode.aabb.GetMax(), direction);
+
+					if (leftDistance < rightDistance)
+					{
+						stack[stackSize++] = {node.rightNodeIndex, hitMask};
+						stack[stackSize++] = {node.leftNodeIndex, hitMask};
+					}
+					else
+					{
+						stack[stackSize++] = {node.leftNodeIndex, hitMask};
+						stack[stackSize++] = {node.rightNodeIndex, hitMask};
+					}
+				}
+			}
+		}
+
+		// Zero components are replaced by a tiny value, so the slab test never multiplies zero by infinity
+		static Vector3 InverseDirection(const Vector3& direction)
+		{
+			Vector3 invDirection;
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				float component = direction[axis];
+				invDirection[axis] = 1.0f / (std::abs(component) > 1e-20f ? component : std::copysign(1e-20f, component));
+			}
+
+			return invDirection;
+		}
+
+		// Slab test against the bounds grown by inflate, entry is clamped to 0 when the origin is inside
+		static bool RayIntersects(const AABB& aabb, const Vector3& inflate, const Vector3& origin, const Vector3& invDirection, float maxDistance, float& entry)
+		{
+			float entryDistance = 0.0f;
+			float exitDistance = maxDistance;
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				float t0 = (aabb.GetMin()[axis] - inflate[axis] - origin[axis]) * invDirection[axis];
+				float t1 = (aabb.GetMax()[axis] + inflate[axis] - origin[axis]) * invDirection[axis];
+
+				entryDistance = std::max(entryDistance, std::min(t0, t1));
+				exitDistance = std::min(exitDistance, std::max(t0, t1));
+			}
+
+			entry = entryDistance;
+			return entryDistance <= exitDistance;
+		}
+
+		// Callback takes T* and the fat bounds of its leaf
+		template<typename Callback>
+		void ForEachLeaf(Callback&& callback) const
+		{
+			for (const AABBNode<T>& node : _nodes)
+			{
+				if (node.height == 0)
+				{
+					callback(node.Object, node.aabb);
+				}
+			}
+		}
+	private:
+		[[nodiscard]] AABB fatten(const AABB& aabb, const Vector3& displacement) const
+		{
+			Vector3 min = aabb.GetMin() - Vector3(_fatMargin);
+			Vector3 max = aabb.GetMax() + Vector3(_fatMargin);
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				float offset = displacement[axis] * DisplacementMultiplier;
+
+				if (offset < 0.0f)
+					min[axis] += offset;
+				else
+					max[axis] += offset;
+			}
+
+			return {min, max};
+		}
+
+		void growPool(uint32_t count)
+		{
+			auto oldCapacity = (uint32_t)_nodes.size();
+			uint32_t newCapacity = oldCapacity + count;
+
+			_nodes.resize(newCapacity);
+
+			for (NodeIndex_t nodeIndex = oldCapacity; nodeIndex < newCapacity - 1; nodeIndex++)
+			{
+				_nodes[nodeIndex].nextNodeIndex = nodeIndex + 1;
+			}
+
+			_nodes[newCapacity - 1].nextNodeIndex = _nextFreeNodeIndex;
+			_nextFreeNodeIndex = oldCapacity;
+		}
+
+		// Invalidates node references, callers must keep indices
+		NodeIndex_t allocateNode()
+		{
+			// if we have no free tree nodes then double the pool
+			if (_nextFreeNodeIndex == AABB_NULL_NODE)
+			{
+				assert(_allocatedNodeCount == _nodes.size());
+				growPool((uint32_t)_nodes.size());
+			}
+
+			NodeIndex_t nodeIndex = _nextFreeNodeIndex;
 			AABBNode<T>& allocatedNode = _nodes[nodeIndex];
+			_nextFreeNodeIndex = allocatedNode.nextNodeIndex;
+
 			allocatedNode.parentNodeIndex = AABB_NULL_NODE;
 			allocatedNode.leftNodeIndex = AABB_NULL_NODE;
 			allocatedNode.rightNodeIndex = AABB_NULL_NODE;
-			_nextFreeNodeIndex = allocatedNode.nextNodeIndex;
+			allocatedNode.nextNodeIndex = AABB_NULL_NODE;
+			allocatedNode.Object = nullptr;
+			allocatedNode.height = 0;
 			_allocatedNodeCount++;
 
 			return nodeIndex;
 		}
 
-		void deallocateNode(unsigned nodeIndex)
+		void deallocateNode(NodeIndex_t nodeIndex)
 		{
 			AABBNode<T>& deallocatedNode = _nodes[nodeIndex];
 			deallocatedNode.nextNodeIndex = _nextFreeNodeIndex;
+			deallocatedNode.Object = nullptr;
+			deallocatedNode.height = -1;
 			_nextFreeNodeIndex = nodeIndex;
 			_allocatedNodeCount--;
 		}
 
-		void insertLeaf(unsigned leafNodeIndex)
+		[[nodiscard]] float descendCost(NodeIndex_t childIndex, const AABB& leafAabb) const
+		{
+			const AABBNode<T>& child = _nodes[childIndex];
+			float mergedArea = leafAabb.Merge(child.aabb).GetSurfaceArea();
+
+			return child.IsLeaf() ? mergedArea : mergedArea - child.aabb.GetSurfaceArea();
+		}
+
+		void insertLeaf(NodeIndex_t leafNodeIndex)
 		{
 			// make sure we're inserting a new leaf
 			assert(_nodes[leafNodeIndex].parentNodeIndex == AABB_NULL_NODE);
@@ -171,76 +535,44 @@ namespace Aurora
 				return;
 			}
 
-			// search for the best place to put the new leaf in the tree
-			// we use surface area and depth as search heuristics
-			unsigned treeNodeIndex = _rootNodeIndex;
-			AABBNode<T>& leafNode = _nodes[leafNodeIndex];
+			// search for the best place to put the new leaf in the tree using the surface area heuristic
+			AABB leafAabb = _nodes[leafNodeIndex].aabb;
+			NodeIndex_t treeNodeIndex = _rootNodeIndex;
 			while (!_nodes[treeNodeIndex].IsLeaf())
 			{
-				// because of the test in the while loop above we know we are never a leaf inside it
 				const AABBNode<T>& treeNode = _nodes[treeNodeIndex];
-				unsigned leftNodeIndex = treeNode.leftNodeIndex;
-				unsigned rightNodeIndex = treeNode.rightNodeIndex;
-				const AABBNode<T>& leftNode = _nodes[leftNodeIndex];
-				const AABBNode<T>& rightNode = _nodes[rightNodeIndex];
 
-				AABB combinedAabb = treeNode.aabb.Merge(leafNode.aabb);
+				float combinedArea = treeNode.aabb.Merge(leafAabb).GetSurfaceArea();
 
-				float newParentNodeCost = 2.0f * combinedAabb.GetSurfaceArea();
-				float minimumPushDownCost = 2.0f * (combinedAabb.GetSurfaceArea() - treeNode.aabb.GetSurfaceArea());
+				// cost of creating a new parent here and the cost every level below pays for growing this node
+				float newParentNodeCost = 2.0f * combinedArea;
+				float minimumPushDownCost = 2.0f * (combinedArea - treeNode.aabb.GetSurfaceArea());
 
-				// use the costs to figure out whether to create a new parent here or descend
-				float costLeft;
-				float costRight;
-				if (leftNode.IsLeaf())
-				{
-					costLeft = leafNode.aabb.Merge(leftNode.aabb).GetSurfaceArea() + minimumPushDownCost;
-				}
-				else
-				{
-					AABB newLeftAabb = leafNode.aabb.Merge(leftNode.aabb);
-					costLeft = (newLeftAabb.GetSurfaceArea() - leftNode.aabb.GetSurfaceArea()) + minimumPushDownCost;
-				}
-				if (rightNode.IsLeaf())
-				{
-					costRight = leafNode.aabb.Merge(rightNode.aabb).GetSurfaceArea() + minimumPushDownCost;
-				}
-				else
-				{
-					AABB newRightAabb = leafNode.aabb.Merge(rightNode.aabb);
-					costRight = (newRightAabb.GetSurfaceArea() - rightNode.aabb.GetSurfaceArea()) + minimumPushDownCost;
-				}
+				float costLeft = descendCost(treeNode.leftNodeIndex, leafAabb) + minimumPushDownCost;
+				float costRight = descendCost(treeNode.rightNodeIndex, leafAabb) + minimumPushDownCost;
 
-				// if the cost of creating a new parent node here is less than descending in either direction then
-				// we know we need to create a new parent node, errrr, here and attach the leaf to that
 				if (newParentNodeCost < costLeft && newParentNodeCost < costRight)
 				{
 					break;
 				}
 
 				// otherwise descend in the cheapest direction
-				if (costLeft < costRight)
-				{
-					treeNodeIndex = leftNodeIndex;
-				}
-				else
-				{
-					treeNodeIndex = rightNodeIndex;
-				}
+				treeNodeIndex = costLeft < costRight ? treeNode.leftNodeIndex : treeNode.rightNodeIndex;
 			}
 
-			// the leafs sibling is going to be the node we found above and we are going to create a new
-			// parent node and attach the leaf and this item
-			unsigned leafSiblingIndex = treeNodeIndex;
-			AABBNode<T>& leafSibling = _nodes[leafSiblingIndex];
-			unsigned oldParentIndex = leafSibling.parentNodeIndex;
-			unsigned newParentIndex = allocateNode();
+			// the leafs sibling is the node we found above, a new parent is created for both of them
+			NodeIndex_t leafSiblingIndex = treeNodeIndex;
+			NodeIndex_t oldParentIndex = _nodes[leafSiblingIndex].parentNodeIndex;
+			NodeIndex_t newParentIndex = allocateNode();
+
 			AABBNode<T>& newParent = _nodes[newParentIndex];
+			AABBNode<T>& leafSibling = _nodes[leafSiblingIndex];
 			newParent.parentNodeIndex = oldParentIndex;
-			newParent.aabb = leafNode.aabb.Merge(leafSibling.aabb); // the new parents aabb is the leaf aabb combined with it's siblings aabb
+			newParent.aabb = leafAabb.Merge(leafSibling.aabb);
 			newParent.leftNodeIndex = leafSiblingIndex;
 			newParent.rightNodeIndex = leafNodeIndex;
-			leafNode.parentNodeIndex = newParentIndex;
+			newParent.height = leafSibling.height + 1;
+			_nodes[leafNodeIndex].parentNodeIndex = newParentIndex;
 			leafSibling.parentNodeIndex = newParentIndex;
 
 			if (oldParentIndex == AABB_NULL_NODE)
@@ -250,25 +582,14 @@ namespace Aurora
 			}
 			else
 			{
-				// the old parent was not the root and so we need to patch the left or right index to
-				// point to the new node
-				AABBNode<T>& oldParent = _nodes[oldParentIndex];
-				if (oldParent.leftNodeIndex == leafSiblingIndex)
-				{
-					oldParent.leftNodeIndex = newParentIndex;
-				}
-				else
-				{
-					oldParent.rightNodeIndex = newParentIndex;
-				}
+				replaceChild(oldParentIndex, leafSiblingIndex, newParentIndex);
 			}
 
 			// finally we need to walk back up the tree fixing heights and areas
-			treeNodeIndex = leafNode.parentNodeIndex;
-			FixUpwardsTree(treeNodeIndex);
+			fixUpwardsTree(newParentIndex);
 		}
 
-		void RemoveLeaf(unsigned leafNodeIndex)
+		void removeLeaf(NodeIndex_t leafNodeIndex)
 		{
 			// if the leaf is the root then we can just clear the root pointer and return
 			if (leafNodeIndex == _rootNodeIndex)
@@ -277,62 +598,53 @@ namespace Aurora
 				return;
 			}
 
-			AABBNode<T>& leafNode = _nodes[leafNodeIndex];
-			unsigned parentNodeIndex = leafNode.parentNodeIndex;
+			NodeIndex_t parentNodeIndex = _nodes[leafNodeIndex].parentNodeIndex;
 			const AABBNode<T>& parentNode = _nodes[parentNodeIndex];
-			unsigned grandParentNodeIndex = parentNode.parentNodeIndex;
-			unsigned siblingNodeIndex = parentNode.leftNodeIndex == leafNodeIndex ? parentNode.rightNodeIndex : parentNode.leftNodeIndex;
+			NodeIndex_t grandParentNodeIndex = parentNode.parentNodeIndex;
+			NodeIndex_t siblingNodeIndex = parentNode.leftNodeIndex == leafNodeIndex ? parentNode.rightNodeIndex : parentNode.leftNodeIndex;
 			assert(siblingNodeIndex != AABB_NULL_NODE); // we must have a sibling
-			AABBNode<T>& siblingNode = _nodes[siblingNodeIndex];
 
 			if (grandParentNodeIndex != AABB_NULL_NODE)
 			{
-				// if we have a grand parent (i.e. the parent is not the root) then destroy the parent and connect the sibling to the grandparent in its
-				// place
-				AABBNode<T>& grandParentNode = _nodes[grandParentNodeIndex];
-				if (grandParentNode.leftNodeIndex == parentNodeIndex)
-				{
-					grandParentNode.leftNodeIndex = siblingNodeIndex;
-				}
-				else
-				{
-					grandParentNode.rightNodeIndex = siblingNodeIndex;
-				}
-				siblingNode.parentNodeIndex = grandParentNodeIndex;
+				// the parent is not the root, destroy it and connect the sibling to the grandparent in its place
+				replaceChild(grandParentNodeIndex, parentNodeIndex, siblingNodeIndex);
+				_nodes[siblingNodeIndex].parentNodeIndex = grandParentNodeIndex;
 				deallocateNode(parentNodeIndex);
 
-				FixUpwardsTree(grandParentNodeIndex);
+				fixUpwardsTree(grandParentNodeIndex);
 			}
 			else
 			{
-				// if we have no grandparent then the parent is the root and so our sibling becomes the root and has it's parent removed
+				// the parent is the root and so our sibling becomes the root
 				_rootNodeIndex = siblingNodeIndex;
-				siblingNode.parentNodeIndex = AABB_NULL_NODE;
+				_nodes[siblingNodeIndex].parentNodeIndex = AABB_NULL_NODE;
 				deallocateNode(parentNodeIndex);
 			}
 
-			leafNode.parentNodeIndex = AABB_NULL_NODE;
+			_nodes[leafNodeIndex].parentNodeIndex = AABB_NULL_NODE;
 		}
 
-		void UpdateLeaf(unsigned leafNodeIndex, const AABB& newAaab)
+		void replaceChild(NodeIndex_t parentNodeIndex, NodeIndex_t oldChildIndex, NodeIndex_t newChildIndex)
 		{
-			AABBNode<T>& node = _nodes[leafNodeIndex];
+			AABBNode<T>& parentNode = _nodes[parentNodeIndex];
 
-			// if the node contains the new aabb then we just leave things
-			// TODO: when we add velocity this check should kick in as often an update will lie within the velocity fattened initial aabb
-			// to support this we might need to differentiate between velocity fattened aabb and actual aabb
-			if (node.aabb.Contains(newAaab)) return;
-
-			RemoveLeaf(leafNodeIndex);
-			node.aabb = newAaab;
-			insertLeaf(leafNodeIndex);
+			if (parentNode.leftNodeIndex == oldChildIndex)
+			{
+				parentNode.leftNodeIndex = newChildIndex;
+			}
+			else
+			{
+				assert(parentNode.rightNodeIndex == oldChildIndex);
+				parentNode.rightNodeIndex = newChildIndex;
+			}
 		}
 
-
-		void FixUpwardsTree(unsigned treeNodeIndex)
+		void fixUpwardsTree(NodeIndex_t treeNodeIndex)
 		{
 			while (treeNodeIndex != AABB_NULL_NODE)
 			{
+				treeNodeIndex = balance(treeNodeIndex);
+
 				AABBNode<T>& treeNode = _nodes[treeNodeIndex];
 
 				// every node should be a parent
@@ -341,10 +653,120 @@ namespace Aurora
 				// fix height and area
 				const AABBNode<T>& leftNode = _nodes[treeNode.leftNodeIndex];
 				const AABBNode<T>& rightNode = _nodes[treeNode.rightNodeIndex];
+				treeNode.height = 1 + std::max(leftNode.height, rightNode.height);
 				treeNode.aabb = leftNode.aabb.Merge(rightNode.aabb);
 
 				treeNodeIndex = treeNode.parentNodeIndex;
 			}
 		}
+
+		// Rotates the higher child of A up when the children heights differ by more than one.
+		// Returns the node which took the place of A.
+		//
+		//       A              C
+		//      / \            / \
+		//     B   C    ->    A   F
+		//        / \        / \
+		//       F   G      B   G
+		NodeIndex_t balance(NodeIndex_t indexA)
+		{
+			AABBNode<T>& nodeA = _nodes[indexA];
+			if (nodeA.IsLeaf() || nodeA.height < 2)
+				return indexA;
+
+			NodeIndex_t indexB = nodeA.leftNodeIndex;
+			NodeIndex_t indexC = nodeA.rightNodeIndex;
+			AABBNode<T>& nodeB = _nodes[indexB];
+			AABBNode<T>& nodeC = _nodes[indexC];
+
+			int32_t heightDifference = nodeC.height - nodeB.height;
+
+			// rotate C up
+			if (heightDifference > 1)
+			{
+				NodeIndex_t indexF = nodeC.leftNodeIndex;
+				NodeIndex_t indexG = nodeC.rightNodeIndex;
+				AABBNode<T>& nodeF = _nodes[indexF];
+				AABBNode<T>& nodeG = _nodes[indexG];
+
+				// swap A and C
+				nodeC.leftNodeIndex = indexA;
+				nodeC.parentNodeIndex = nodeA.parentNodeIndex;
+				nodeA.parentNodeIndex = indexC;
+
+				if (nodeC.parentNodeIndex != AABB_NULL_NODE)
+					replaceChild(nodeC.parentNodeIndex, indexA, indexC);
+				else
+					_rootNodeIndex = indexC;
+
+				// the higher grandchild stays under C, the other one moves to A
+				if (nodeF.height > nodeG.height)
+				{
+					nodeC.rightNodeIndex = indexF;
+					nodeA.rightNodeIndex = indexG;
+					nodeG.parentNodeIndex = indexA;
+					nodeA.aabb = nodeB.aabb.Merge(nodeG.aabb);
+					nodeC.aabb = nodeA.aabb.Merge(nodeF.aabb);
+					nodeA.height = 1 + std::max(nodeB.height, nodeG.height);
+					nodeC.height = 1 + std::max(nodeA.height, nodeF.height);
+				}
+				else
+				{
+					nodeC.rightNodeIndex = indexG;
+					nodeA.rightNodeIndex = indexF;
+					nodeF.parentNodeIndex = indexA;
+					nodeA.aabb = nodeB.aabb.Merge(nodeF.aabb);
+					nodeC.aabb = nodeA.aabb.Merge(nodeG.aabb);
+					nodeA.height = 1 + std::max(nodeB.height, nodeF.height);
+					nodeC.height = 1 + std::max(nodeA.height, nodeG.height);
+				}
+
+				return indexC;
+			}
+
+			// rotate B up
+			if (heightDifference < -1)
+			{
+				NodeIndex_t indexD = nodeB.leftNodeIndex;
+				NodeIndex_t indexE = nodeB.rightNodeIndex;
+				AABBNode<T>& nodeD = _nodes[indexD];
+				AABBNode<T>& nodeE = _nodes[indexE];
+
+				// swap A and B
+				nodeB.leftNodeIndex = indexA;
+				nodeB.parentNodeIndex = nodeA.parentNodeIndex;
+				nodeA.parentNodeIndex = indexB;
+
+				if (nodeB.parentNodeIndex != AABB_NULL_NODE)
+					replaceChild(nodeB.parentNodeIndex, indexA, indexB);
+				else
+					_rootNodeIndex = indexB;
+
+				if (nodeD.height > nodeE.height)
+				{
+					nodeB.rightNodeIndex = indexD;
+					nodeA.leftNodeIndex = indexE;
+					nodeE.parentNodeIndex = indexA;
+					nodeA.aabb = nodeC.aabb.Merge(nodeE.aabb);
+					nodeB.aabb = nodeA.aabb.Merge(nodeD.aabb);
+					nodeA.height = 1 + std::max(nodeC.height, nodeE.height);
+					nodeB.height = 1 + std::max(nodeA.height, nodeD.height);
+				}
+				else
+				{
+					nodeB.rightNodeIndex = indexE;
+					nodeA.leftNodeIndex = indexD;
+					nodeD.parentNodeIndex = indexA;
+					nodeA.aabb = nodeC.aabb.Merge(nodeD.aabb);
+					nodeB.aabb = nodeA.aabb.Merge(nodeE.aabb);
+					nodeA.height = 1 + std::max(nodeC.height, nodeD.height);
+					nodeB.height = 1 + std::max(nodeA.height, nodeE.height);
+				}
+
+				return indexB;
+			}
+
+			return indexA;
+		}
 	};
 }
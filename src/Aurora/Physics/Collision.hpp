@@ -37,18 +37,22 @@ namespace Aurora
 
 				//DShapes::Box(encapsulatedBounds, Color::blue(), true, 1.0f);
 
-				auto possibleColliders = bvhTree.QueryOverlaps(current, encapsulatedBounds);
-
-				for (ColliderComponent* collisionObject : possibleColliders)
+				bvhTree.QueryOverlaps(current, encapsulatedBounds, [&](ColliderComponent* collisionObject)
 				{
 					AABB otherBounds = collisionObject->GetTransformedAABB();
 
+					// Tree leaves are fattened, so the candidate has to be tested against its real bounds
+					if (!otherBounds.Overlaps(encapsulatedBounds))
+					{
+						return true;
+					}
+
 					// Resolve proxy first
 					if (ProxyColliderComponent* proxy = ProxyColliderComponent::SafeCast(collisionObject))
 					{
 						if (!proxy->CollideWith(currentBounds, encapsulatedBounds, velocity, updateRate, axis))
 						{
-							continue;
+							return true;
 						}
 					}
 
@@ -67,8 +71,8 @@ namespace Aurora
 					}
 
 					collision = true;
-					break;
-				}
+					return false;
+				});
 			}
 
 			return collision;
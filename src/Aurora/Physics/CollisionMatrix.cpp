@@ -24,6 +24,11 @@ namespace Aurora
 		return m_CollisionMatrix[who] & (1u << target);
 	}
 
+	Layer::Hash_t CollisionMatrix::GetCollisionMask(const LayerEnum &who)
+	{
+		return m_CollisionMatrix[who];
+	}
+
 	bool CollisionMatrix::CanCollide(const LayerEnum &who, const Layer &target)
 	{
 		return m_CollisionMatrix[who] & target.Hash();
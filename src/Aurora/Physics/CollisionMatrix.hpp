@@ -15,5 +15,7 @@ namespace Aurora
 		static bool CanCollide(const LayerEnum& who, const LayerEnum& target);
 		static bool CanCollide(const LayerEnum& who, const Layer& target);
 		static bool CanCollide(const Layer& who, const Layer& target);
+		// Bit per target layer, used to filter many colliders against one layer
+		static Layer::Hash_t GetCollisionMask(const LayerEnum& who);
 	};
 }
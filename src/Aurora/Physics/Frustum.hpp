@@ -25,6 +25,9 @@ namespace Aurora
 		[[nodiscard]] bool IsBoxVisible(const glm::vec3& minp, const glm::vec3& maxp) const;
 		[[nodiscard]] bool IsBoxVisible(const AABB& boundingBox) const;
 
+		// Planes are not normalized, order is left, right, bottom, top, near, far
+		[[nodiscard]] const glm::vec4& GetPlane(int index) const { return m_planes[index]; }
+
 	private:
 		enum Planes
 		{
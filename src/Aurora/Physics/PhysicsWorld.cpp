@@ -1,5 +1,6 @@
 #include "PhysicsWorld.hpp"
 
+#include "Aurora/Core/JobSystem.hpp"
 #include "Aurora/Core/Profiler.hpp"
 #include "Aurora/Framework/Scene.hpp"
 #include "Aurora/Framework/Physics/RigidBodyComponent.hpp"
@@ -7,9 +8,80 @@
 
 #include "Integration.hpp"
 #include "Collision.hpp"
+#include "CollisionMatrix.hpp"
 
 namespace Aurora
 {
+	// Rays traced together by one tree traversal in RayCastBatch
+	static constexpr uint32_t RayPacketSize = 16;
+	// Rays per job in RayCastBatch
+	static constexpr uint32_t RayBatchSize = RayPacketSize * 4;
+
+	// Filter resolved once per query
+	struct ColliderFilter
+	{
+		Layer::Hash_t LayerMask;
+		const Actor* IgnoredActor;
+
+		explicit ColliderFilter(const PhysicsQueryFilter& filter) :
+			LayerMask(filter.QueryLayer ? CollisionMatrix::GetCollisionMask(*filter.QueryLayer) : (Layer::Hash_t)~0u),
+			IgnoredActor(filter.IgnoredActor)
+		{
+
+		}
+
+		[[nodiscard]] bool Accepts(const ColliderComponent* collider) const
+		{
+			return (LayerMask & (1u << collider->GetLayer())) && collider->GetOwner() != IgnoredActor;
+		}
+	};
+
+	// Slab test against the collider bounds grown by inflate, the normal is the one of the entered face
+	static bool RayCastBounds(const AABB& bounds, const Vector3& inflate, const Vector3& origin, const Vector3& direction, const Vector3& invDirection, float maxDistance, float& distance, Vector3& normal)
+	{
+		float entryDistance = 0.0f;
+		float exitDistance = maxDistance;
+		int entryAxis = -1;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float t0 = (bounds.GetMin()[axis] - inflate[axis] - origin[axis]) * invDirection[axis];
+			float t1 = (bounds.GetMax()[axis] + inflate[axis] - origin[axis]) * invDirection[axis];
+			float axisEntry = std::min(t0, t1);
+
+			if (axisEntry > entryDistance)
+			{
+				entryDistance = axisEntry;
+				entryAxis = axis;
+			}
+
+			exitDistance = std::min(exitDistance, std::max(t0, t1));
+		}
+
+		if (entryDistance > exitDistance)
+			return false;
+
+		distance = entryDistance;
+		normal = Vector3(0.0f);
+
+		// Origin inside the bounds, there is no entered face
+		if (entryAxis < 0)
+			normal = -direction;
+		else
+			normal[entryAxis] = direction[entryAxis] > 0.0f ? -1.0f : 1.0f;
+
+		return true;
+	}
+
+	static void FillHit(RayCastHitResult& hit, ColliderComponent* collider, const Vector3& origin, const Vector3& direction, float distance, const Vector3& normal, float radius)
+	{
+		hit.HitActor = collider->GetOwner();
+		hit.HitPosition = origin + direction * distance - normal * radius;
+		hit.HitNormal = normal;
+		hit.HitDistance = distance;
+		hit.HitCollider = collider;
+	}
+
 	PhysicsWorld::PhysicsWorld(Scene* scene) :
 		m_Scene(scene),
 		m_Accumulator(0),
@@ -17,7 +89,7 @@ namespace Aurora
 		m_DebugRender(false),
 		m_Gravity(0, -30.0f, 0),
 		m_UpdateRate(1.0 / 120.0),
-		m_AABBTree(1)
+		m_AABBTree()
 	{
 
 	}
@@ -28,6 +100,11 @@ namespace Aurora
 
 		m_Accumulator += frameTime;
 
+		if (m_Accumulator >= m_UpdateRate)
+		{
+			SyncColliders();
+		}
+
 		while (m_Accumulator >= m_UpdateRate)
 		{
 			RunPhysics();
@@ -37,40 +114,55 @@ namespace Aurora
 
 		if (IsDebugRender())
 		{
-			for (const auto& node : m_AABBTree.GetNodes())
+			m_AABBTree.ForEachLeaf([](ColliderComponent*, const AABB& bounds)
 			{
-				if (node.parentNodeIndex == AABB_NULL_NODE || !node.IsLeaf())
-					continue;
-
-				if (node.IsLeaf())
-					DShapes::Box(node.aabb, Color::red(), true, 1.2f, 0, false);
-				else
-					DShapes::Box(node.aabb, Color::green(), true, 1.0f, 0, false);
-			}
+				DShapes::Box(bounds, Color::red(), true, 1.2f, 0, false);
+			});
 		}
 	}
 
-	void PhysicsWorld::RunPhysics()
+	void PhysicsWorld::SyncColliders()
 	{
-		ComponentView<ColliderComponent> colliderComponents = m_Scene->GetComponents<ColliderComponent>();
-
-		if (colliderComponents.empty())
-		{
-			m_AABBTree = AABBTree<ColliderComponent>(1);
-		}
-		else
-		{
-			m_AABBTree = AABBTree<ColliderComponent>(colliderComponents.size() * 2);
-		}
+		CPU_DEBUG_SCOPE("PhysicsWorld::SyncColliders");
 
+		// Static colliders stay inside their fat bounds, so this only touches the tree for moved, new and deactivated ones
+		ComponentView<ColliderComponent> colliderComponents = m_Scene->GetComponents<ColliderComponent>();
 		for (ColliderComponent* collider : colliderComponents)
 		{
 			if (!collider->IsActive() || !collider->GetParent()->IsActive() || !collider->GetOwner()->IsActive())
+			{
+				if (collider->m_BroadphaseProxy != AABB_NULL_NODE)
+				{
+					RemoveCollider(collider);
+				}
+
 				continue;
+			}
 
-			m_AABBTree.InsertObject(collider, collider->GetTransformedAABB());
+			AABB bounds = collider->GetTransformedAABB();
+
+			if (collider->m_BroadphaseProxy == AABB_NULL_NODE)
+			{
+				collider->m_BroadphaseProxy = m_AABBTree.InsertObject(collider, bounds);
+			}
+			else
+			{
+				m_AABBTree.UpdateProxy(collider->m_BroadphaseProxy, bounds);
+			}
 		}
+	}
 
+	void PhysicsWorld::RemoveCollider(ColliderComponent* collider)
+	{
+		if (collider->m_BroadphaseProxy == AABB_NULL_NODE)
+			return;
+
+		m_AABBTree.RemoveProxy(collider->m_BroadphaseProxy);
+		collider->m_BroadphaseProxy = AABB_NULL_NODE;
+	}
+
+	void PhysicsWorld::RunPhysics()
+	{
 		ComponentView<RigidBodyComponent> bodyComponents = m_Scene->GetComponents<RigidBodyComponent>();
 		for (RigidBodyComponent* rigidBodyComponent : bodyComponents)
 		{
@@ -83,7 +175,8 @@ namespace Aurora
 				rigidBodyComponent->AddAcceleration(m_Gravity * (float)m_UpdateRate);
 
 			SceneComponent* parent = rigidBodyComponent->GetParent() != nullptr ? rigidBodyComponent->GetParent() : rigidBodyComponent->GetOwner()->GetRootComponent();
-			std::vector<BoxColliderComponent*> colliders;
+			std::vector<BoxColliderComponent*>& colliders = m_BodyColliders;
+			colliders.clear();
 			parent->GetComponentsOfType(colliders);
 
 			Vector3 velocity = rigidBodyComponent->GetVelocity();
@@ -120,10 +213,14 @@ namespace Aurora
 
 			if (isMoving)
 			{
+				Vector3 displacement = velocity * (float)m_UpdateRate;
+
 				for (BoxColliderComponent* collider : colliders)
 				{
-					// Revert bounds back
-					m_AABBTree.UpdateObject(collider, collider->GetTransformedAABB());
+					if (collider->m_BroadphaseProxy != AABB_NULL_NODE)
+					{
+						m_AABBTree.UpdateProxy(collider->m_BroadphaseProxy, collider->GetTransformedAABB(), displacement);
+					}
 				}
 			}
 		}
@@ -131,41 +228,160 @@ namespace Aurora
 
 	PhysicsWorld::~PhysicsWorld() = default;
 
-	int32_t PhysicsWorld::RayCast(const Vector3& fromPos, const Vector3& toPos, std::vector<RayCastHitResult>& results) const
+	int32_t PhysicsWorld::RayCast(const Vector3& fromPos, const Vector3& toPos, std::vector<RayCastHitResult>& results, const PhysicsQueryFilter& filter) const
 	{
-		ComponentView<ColliderComponent> colliderComponents = m_Scene->GetComponents<ColliderComponent>();
+		CPU_DEBUG_SCOPE("PhysicsWorld::RayCast");
 
-		Vector3 direction = glm::normalize(toPos - fromPos);
 		float maxDistance = glm::length(toPos - fromPos);
 
-		int32_t count = 0;
+		if (maxDistance <= 0.0f)
+			return 0;
+
+		Vector3 direction = (toPos - fromPos) / maxDistance;
+		Vector3 invDirection = AABBTree<ColliderComponent>::InverseDirection(direction);
+		ColliderFilter colliderFilter(filter);
+		size_t firstResult = results.size();
 
-		for (ColliderComponent* collider : colliderComponents)
+		m_AABBTree.RayCast(fromPos, direction, maxDistance, Vector3(0.0f), [&](ColliderComponent* collider)
 		{
-			AABB bounds = collider->GetAABB();
-			bounds.SetOffset(collider->GetParent()->GetWorldPosition());
+			float distance;
+			Vector3 normal;
 
-			std::vector<AABBHit> hits;
-			if (bounds.CollideWithRay(fromPos, direction, hits))
+			if (colliderFilter.Accepts(collider) && RayCastBounds(collider->GetTransformedAABB(), Vector3(0.0f), fromPos, direction, invDirection, maxDistance, distance, normal))
 			{
-				std::sort(hits.begin(), hits.end(), [](const AABBHit& left, const AABBHit& right) -> bool { return left.Distance < right.Distance; });
-				const AABBHit& closestHit = hits[0];
+				FillHit(results.emplace_back(), collider, fromPos, direction, distance, normal, 0.0f);
+			}
 
-				if (closestHit.Distance <= maxDistance)
-				{
-					Vector3 normal = bounds.GetRayHitNormal((Vector3)closestHit.Point);
-					results.emplace_back(RayCastHitResult{collider->GetOwner(), closestHit.Point, normal, closestHit.Distance});
+			// Every hit is wanted, so the ray is never clipped
+			return maxDistance;
+		});
+
+		std::sort(results.begin() + (ptrdiff_t)firstResult, results.end(), [](const RayCastHitResult& left, const RayCastHitResult& right) -> bool { return left.HitDistance < right.HitDistance; });
+
+		return (int32_t)(results.size() - firstResult);
+	}
+
+	bool PhysicsWorld::RayCastClosest(const Vector3& origin, const Vector3& direction, float maxDistance, RayCastHitResult& hit, const PhysicsQueryFilter& filter) const
+	{
+		return SphereCast(origin, 0.0f, direction, maxDistance, hit, filter);
+	}
+
+	bool PhysicsWorld::SegmentCast(const Vector3& fromPos, const Vector3& toPos, RayCastHitResult& hit, const PhysicsQueryFilter& filter) const
+	{
+		float length = glm::length(toPos - fromPos);
+
+		if (length <= 0.0f)
+			return false;
+
+		return RayCastClosest(fromPos, (toPos - fromPos) / length, length, hit, filter);
+	}
+
+	bool PhysicsWorld::SphereCast(const Vector3& origin, float radius, const Vector3& direction, float maxDistance, RayCastHitResult& hit, const PhysicsQueryFilter& filter) const
+	{
+		CPU_DEBUG_SCOPE("PhysicsWorld::SphereCast");
+
+		Vector3 inflate(radius);
+		Vector3 invDirection = AABBTree<ColliderComponent>::InverseDirection(direction);
+		ColliderFilter colliderFilter(filter);
+		bool hasHit = false;
+
+		m_AABBTree.RayCast(origin, direction, maxDistance, inflate, [&](ColliderComponent* collider)
+		{
+			float distance;
+			Vector3 normal;
+
+			if (!colliderFilter.Accepts(collider) || !RayCastBounds(collider->GetTransformedAABB(), inflate, origin, direction, invDirection, maxDistance, distance, normal))
+				return maxDistance;
+
+			FillHit(hit, collider, origin, direction, distance, normal, radius);
+			hasHit = true;
+
+			// Clip the ray, only closer hits are interesting from now on. A hit at 0 stops the traversal.
+			maxDistance = distance;
+			return distance;
+		});
+
+		return hasHit;
+	}
+
+	uint32_t PhysicsWorld::OverlapBox(const AABB& bounds, std::vector<ColliderComponent*>& results, const PhysicsQueryFilter& filter) const
+	{
+		CPU_DEBUG_SCOPE("PhysicsWorld::OverlapBox");
+
+		ColliderFilter colliderFilter(filter);
+		size_t firstResult = results.size();
 
-					count++;
+		m_AABBTree.Query(bounds, [&](ColliderComponent* collider)
+		{
+			if (colliderFilter.Accepts(collider) && collider->GetTransformedAABB().Overlaps(bounds))
+			{
+				results.push_back(collider);
+			}
+		});
+
+		return (uint32_t)(results.size() - firstResult);
+	}
+
+	uint32_t PhysicsWorld::RayCastBatch(std::span<const RayCastQuery> queries, std::span<RayCastHitResult> hits, const PhysicsQueryFilter& filter, JobSystem* jobSystem) const
+	{
+		CPU_DEBUG_SCOPE("PhysicsWorld::RayCastBatch");
+
+		assert(hits.size() >= queries.size());
+
+		ColliderFilter colliderFilter(filter);
+
+		auto castPackets = [this, &queries, &hits, &colliderFilter](uint32_t begin, uint32_t end)
+		{
+			Vector3 origins[RayPacketSize];
+			Vector3 directions[RayPacketSize];
+			Vector3 invDirections[RayPacketSize];
+			float maxDistances[RayPacketSize];
+
+			for (uint32_t packetBegin = begin; packetBegin < end; packetBegin += RayPacketSize)
+			{
+				uint32_t packetSize = std::min(RayPacketSize, end - packetBegin);
+
+				for (uint32_t i = 0; i < packetSize; ++i)
+				{
+					const RayCastQuery& query = queries[packetBegin + i];
+					origins[i] = query.Origin;
+					directions[i] = query.Direction;
+					invDirections[i] = AABBTree<ColliderComponent>::InverseDirection(query.Direction);
+					maxDistances[i] = query.MaxDistance;
+					hits[packetBegin + i] = RayCastHitResult{nullptr, Vector3(0.0f), Vector3(0.0f), 0.0, nullptr};
 				}
+
+				m_AABBTree.RayCastPacket(origins, directions, maxDistances, packetSize, Vector3(0.0f), [&](uint32_t ray, ColliderComponent* collider)
+				{
+					float distance;
+					Vector3 normal;
+
+					if (!colliderFilter.Accepts(collider) || !RayCastBounds(collider->GetTransformedAABB(), Vector3(0.0f), origins[ray], directions[ray], invDirections[ray], maxDistances[ray], distance, normal))
+						return maxDistances[ray];
+
+					FillHit(hits[packetBegin + ray], collider, origins[ray], directions[ray], distance, normal, 0.0f);
+					return distance;
+				});
 			}
-		}
+		};
 
-		if (count == 0)
-			return 0;
+		auto queryCount = (uint32_t)queries.size();
+
+		if (jobSystem && queryCount > RayBatchSize)
+		{
+			jobSystem->ParallelFor(queryCount, RayBatchSize, castPackets);
+		}
+		else
+		{
+			castPackets(0, queryCount);
+		}
 
-		std::sort(results.begin(), results.end(), [](const RayCastHitResult& left, const RayCastHitResult& right) -> bool { return left.HitDistance < right.HitDistance; });
+		uint32_t hitCount = 0;
+		for (uint32_t i = 0; i < queryCount; ++i)
+		{
+			hitCount += hits[i].HitCollider != nullptr ? 1 : 0;
+		}
 
-		return count;
+		return hitCount;
 	}
-}
\ No newline at end of file
+}
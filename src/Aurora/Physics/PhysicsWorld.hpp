@@ -1,5 +1,8 @@
 #pragma once
 
+#include <optional>
+#include <span>
+
 #include "Aurora/Core/Library.hpp"
 #include "Aurora/Core/Vector.hpp"
 #include "Aurora/Framework/Physics/ColliderComponent.hpp"
@@ -8,6 +11,7 @@
 namespace Aurora
 {
 	class Scene;
+	class JobSystem;
 
 	struct RayCastHitResult
 	{
@@ -15,6 +19,23 @@ namespace Aurora
 		Vector3 HitPosition;
 		Vector3 HitNormal;
 		double HitDistance;
+		ColliderComponent* HitCollider = nullptr;
+	};
+
+	struct RayCastQuery
+	{
+		Vector3 Origin;
+		// Has to be normalized
+		Vector3 Direction;
+		float MaxDistance;
+	};
+
+	struct PhysicsQueryFilter
+	{
+		// When set, only colliders on layers this layer can collide with in the CollisionMatrix are hit
+		std::optional<LayerEnum> QueryLayer;
+		// Colliders of this actor are skipped, usually the one doing the query
+		const class Actor* IgnoredActor = nullptr;
 	};
 
 	class AU_API PhysicsWorld
@@ -29,7 +50,10 @@ namespace Aurora
 		Vector3 m_Gravity;
 		double m_UpdateRate;
 
+		// Persistent broadphase, colliders are inserted once and only moved ones get reinserted
 		AABBTree<ColliderComponent> m_AABBTree;
+		// Reused by every rigid body step
+		std::vector<BoxColliderComponent*> m_BodyColliders;
 	public:
 		explicit PhysicsWorld(Scene* scene);
 		~PhysicsWorld();
@@ -40,7 +64,26 @@ namespace Aurora
 
 		void Update(double frameTime);
 
-		int32_t RayCast(const Vector3& fromPos, const Vector3& toPos, std::vector<RayCastHitResult>& results) const;
+		void RemoveCollider(ColliderComponent* collider);
+		[[nodiscard]] const AABBTree<ColliderComponent>& GetBroadphaseTree() const { return m_AABBTree; }
+
+		// Brings the broadphase up to date with collider transforms, queries only see colliders as of the last sync.
+		// Runs automatically before physics steps, call it before querying a scene that is not simulated (editor).
+		void SyncColliders();
+
+		// Appends every hit between the two points sorted by distance, returns the hit count
+		int32_t RayCast(const Vector3& fromPos, const Vector3& toPos, std::vector<RayCastHitResult>& results, const PhysicsQueryFilter& filter = {}) const;
+		// Closest hit along a normalized direction
+		bool RayCastClosest(const Vector3& origin, const Vector3& direction, float maxDistance, RayCastHitResult& hit, const PhysicsQueryFilter& filter = {}) const;
+		bool SegmentCast(const Vector3& fromPos, const Vector3& toPos, RayCastHitResult& hit, const PhysicsQueryFilter& filter = {}) const;
+		// Colliders are grown by the radius, so hits near box edges are conservative. HitPosition is the contact on the collider.
+		bool SphereCast(const Vector3& origin, float radius, const Vector3& direction, float maxDistance, RayCastHitResult& hit, const PhysicsQueryFilter& filter = {}) const;
+		// Appends colliders overlapping the bounds, returns the appended count
+		uint32_t OverlapBox(const AABB& bounds, std::vector<ColliderComponent*>& results, const PhysicsQueryFilter& filter = {}) const;
+
+		// Closest hit for every query, misses have a null HitCollider. Rays are traced in packets and the packets
+		// are spread over the job system when one is given. Returns the hit count.
+		uint32_t RayCastBatch(std::span<const RayCastQuery> queries, std::span<RayCastHitResult> hits, const PhysicsQueryFilter& filter = {}, JobSystem* jobSystem = nullptr) const;
 	private:
 		void RunPhysics();
 	};
@@ -0,0 +1,212 @@
+#include "FrustumCuller.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#include "Aurora/Core/JobSystem.hpp"
+#include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Physics/Frustum.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#include <xmmintrin.h>
+	#define AU_CULLING_SSE 1
+#else
+	#define AU_CULLING_SSE 0
+#endif
+
+namespace Aurora
+{
+	void FrustumCuller::Resize(uint32_t count)
+	{
+		uint32_t paddedCount = (count + SimdWidth - 1) / SimdWidth * SimdWidth;
+
+		m_CenterX.resize(paddedCount, 0.0f);
+		m_CenterY.resize(paddedCount, 0.0f);
+		m_CenterZ.resize(paddedCount, 0.0f);
+		m_ExtentX.resize(paddedCount, 0.0f);
+		m_ExtentY.resize(paddedCount, 0.0f);
+		m_ExtentZ.resize(paddedCount, 0.0f);
+		m_Flags.resize(paddedCount, FlagDisabled);
+
+		for (uint32_t i = count; i < paddedCount; ++i)
+		{
+			m_Flags[i] = FlagDisabled;
+		}
+
+		m_Count = count;
+	}
+
+	void FrustumCuller::SetBounds(uint32_t index, const AABB& worldBounds, uint8_t flags)
+	{
+		const Vector3& min = worldBounds.GetMin();
+		const Vector3& max = worldBounds.GetMax();
+
+		m_CenterX[index] = (min.x + max.x) * 0.5f;
+		m_CenterY[index] = (min.y + max.y) * 0.5f;
+		m_CenterZ[index] = (min.z + max.z) * 0.5f;
+		m_ExtentX[index] = (max.x - min.x) * 0.5f;
+		m_ExtentY[index] = (max.y - min.y) * 0.5f;
+		m_ExtentZ[index] = (max.z - min.z) * 0.5f;
+		m_Flags[index] = flags;
+	}
+
+	uint32_t FrustumCuller::CullRange(const float planes[6][4], uint32_t begin, uint32_t end, uint32_t* output) const
+	{
+		uint32_t visibleCount = 0;
+
+#if AU_CULLING_SSE
+		static_assert(SimdWidth == 4, "SSE path tests 4 boxes at once");
+
+		__m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+		__m128 planeAbsX[6], planeAbsY[6], planeAbsZ[6];
+
+		for (int p = 0; p < 6; ++p)
+		{
+			planeX[p] = _mm_set1_ps(planes[p][0]);
+			planeY[p] = _mm_set1_ps(planes[p][1]);
+			planeZ[p] = _mm_set1_ps(planes[p][2]);
+			planeW[p] = _mm_set1_ps(planes[p][3]);
+			planeAbsX[p] = _mm_set1_ps(std::abs(planes[p][0]));
+			planeAbsY[p] = _mm_set1_ps(std::abs(planes[p][1]));
+			planeAbsZ[p] = _mm_set1_ps(std::abs(planes[p][2]));
+		}
+#endif
+
+		for (uint32_t i = begin; i < end; i += SimdWidth)
+		{
+			uint32_t outsideMask = 0;
+
+#if AU_CULLING_SSE
+			__m128 centerX = _mm_loadu_ps(&m_CenterX[i]);
+			__m128 centerY = _mm_loadu_ps(&m_CenterY[i]);
+			__m128 centerZ = _mm_loadu_ps(&m_CenterZ[i]);
+			__m128 extentX = _mm_loadu_ps(&m_ExtentX[i]);
+			__m128 extentY = _mm_loadu_ps(&m_ExtentY[i]);
+			__m128 extentZ = _mm_loadu_ps(&m_ExtentZ[i]);
+
+			__m128 outside = _mm_setzero_ps();
+
+			for (int p = 0; p < 6; ++p)
+			{
+				// Box is outside when center distance plus projected extent is still behind the plane
+				__m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(centerX, planeX[p]), _mm_mul_ps(centerY, planeY[p])),
+					_mm_add_ps(_mm_mul_ps(centerZ, planeZ[p]), planeW[p]));
+
+				__m128 radius = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(extentX, planeAbsX[p]), _mm_mul_ps(extentY, planeAbsY[p])),
+					_mm_mul_ps(extentZ, planeAbsZ[p]));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+			}
+
+			outsideMask = (uint32_t)_mm_movemask_ps(outside);
+#else
+			for (uint32_t lane = 0; lane < SimdWidth; ++lane)
+			{
+				uint32_t index = i + lane;
+
+				for (int p = 0; p < 6; ++p)
+				{
+					float distance = m_CenterX[index] * planes[p][0] + m_CenterY[index] * planes[p][1] + m_CenterZ[index] * planes[p][2] + planes[p][3];
+					float radius = m_ExtentX[index] * std::abs(planes[p][0]) + m_ExtentY[index] * std::abs(planes[p][1]) + m_ExtentZ[index] * std::abs(planes[p][2]);
+
+					if (distance + radius < 0.0f)
+					{
+						outsideMask |= 1u << lane;
+						break;
+					}
+				}
+			}
+#endif
+
+			uint32_t visibleMask = ~outsideMask & ((1u << SimdWidth) - 1);
+
+			uint32_t laneFlags;
+			std::memcpy(&laneFlags, &m_Flags[i], sizeof(laneFlags));
+
+			if (laneFlags != 0)
+			{
+				for (uint32_t lane = 0; lane < SimdWidth; ++lane)
+				{
+					uint8_t flags = m_Flags[i + lane];
+
+					if (flags & FlagAlwaysVisible)
+						visibleMask |= 1u << lane;
+
+					if (flags & FlagDisabled)
+						visibleMask &= ~(1u << lane);
+				}
+			}
+
+			// Branchless compaction, the slot is overwritten when the lane is not visible
+			for (uint32_t lane = 0; lane < SimdWidth; ++lane)
+			{
+				output[visibleCount] = i + lane;
+				visibleCount += (visibleMask >> lane) & 1u;
+			}
+		}
+
+		return visibleCount;
+	}
+
+	void FrustumCuller::Cull(const FFrustum& frustum, FrameVector<uint32_t>& visibleIndices, JobSystem* jobSystem) const
+	{
+		CPU_DEBUG_SCOPE("FrustumCuller::Cull");
+
+		visibleIndices.clear();
+
+		if (m_Count == 0)
+			return;
+
+		float planes[6][4];
+		for (int p = 0; p < 6; ++p)
+		{
+			const glm::vec4& plane = frustum.GetPlane(p);
+			planes[p][0] = plane.x;
+			planes[p][1] = plane.y;
+			planes[p][2] = plane.z;
+			planes[p][3] = plane.w;
+		}
+
+		auto paddedCount = (uint32_t)m_Flags.size();
+		uint32_t batchCount = (paddedCount + BatchSize - 1) / BatchSize;
+
+		// Every batch compacts into its own slice, so no synchronization is needed until the merge
+		uint32_t* batchOutput = FrameAllocator::Get().Alloc<uint32_t>(paddedCount);
+		FrameVector<uint32_t> batchCounts(batchCount, 0);
+
+		auto cullBatches = [this, &planes, batchOutput, &batchCounts](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t batchBegin = begin; batchBegin < end; batchBegin += BatchSize)
+			{
+				uint32_t batchEnd = std::min(batchBegin + BatchSize, end);
+				batchCounts[batchBegin / BatchSize] = CullRange(planes, batchBegin, batchEnd, batchOutput + batchBegin);
+			}
+		};
+
+		if (jobSystem && batchCount > 1)
+		{
+			jobSystem->ParallelFor(paddedCount, BatchSize, cullBatches);
+		}
+		else
+		{
+			cullBatches(0, paddedCount);
+		}
+
+		uint32_t totalCount = 0;
+		for (uint32_t count : batchCounts)
+		{
+			totalCount += count;
+		}
+
+		visibleIndices.resize(totalCount);
+
+		uint32_t offset = 0;
+		for (uint32_t batch = 0; batch < batchCount; ++batch)
+		{
+			std::memcpy(visibleIndices.data() + offset, batchOutput + batch * BatchSize, batchCounts[batch] * sizeof(uint32_t));
+			offset += batchCounts[batch];
+		}
+	}
+}
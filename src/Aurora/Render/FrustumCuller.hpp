@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Core/Types.hpp"
+#include "Aurora/Physics/AABB.hpp"
+#include "Aurora/Memory/FrameAllocator.hpp"
+
+namespace Aurora
+{
+	class FFrustum;
+	class JobSystem;
+
+	// Culls world space boxes stored as SoA center/extent arrays, so each plane test handles 4 boxes at once.
+	// Bounds are gathered once per frame and can be culled against any number of frustums (camera, shadow cascades).
+	class AU_API FrustumCuller
+	{
+	public:
+		static constexpr uint32_t SimdWidth = 4;
+		// Work unit of one job, every batch writes its visible indices to its own slice
+		static constexpr uint32_t BatchSize = 1024;
+
+		enum Flags : uint8_t
+		{
+			FlagNone = 0,
+			FlagAlwaysVisible = 1 << 0,
+			FlagDisabled = 1 << 1
+		};
+	private:
+		std::vector<float> m_CenterX;
+		std::vector<float> m_CenterY;
+		std::vector<float> m_CenterZ;
+		std::vector<float> m_ExtentX;
+		std::vector<float> m_ExtentY;
+		std::vector<float> m_ExtentZ;
+		std::vector<uint8_t> m_Flags;
+		uint32_t m_Count = 0;
+	public:
+		// Padding entries are disabled, new entries must be set before culling
+		void Resize(uint32_t count);
+
+		void SetBounds(uint32_t index, const AABB& worldBounds, uint8_t flags = FlagNone);
+		void SetDisabled(uint32_t index) { m_Flags[index] = FlagDisabled; }
+
+		[[nodiscard]] uint32_t GetCount() const { return m_Count; }
+
+		// Outputs visible indices in ascending order, runs in parallel when a job system is given.
+		// Only the plane test is done, so boxes near frustum corners may pass.
+		void Cull(const FFrustum& frustum, FrameVector<uint32_t>& visibleIndices, JobSystem* jobSystem = nullptr) const;
+	private:
+		uint32_t CullRange(const float planes[6][4], uint32_t begin, uint32_t end, uint32_t* output) const;
+	};
+}
@@ -0,0 +1,72 @@
+#include "GeometryPool.hpp"
+
+#include "Aurora/Core/assert.hpp"
+#include "Aurora/Graphics/Base/IRenderDevice.hpp"
+#include "Aurora/Framework/Mesh/Mesh.hpp"
+#include "Aurora/Logger/Logger.hpp"
+
+namespace Aurora
+{
+	GeometryPool::GeometryPool(IRenderDevice* renderDevice, const String& name, const VertexLayout& vertexLayout, uint32_t maxVertices, uint32_t maxIndices)
+		: m_RenderDevice(renderDevice),
+		m_VertexBuffer(nullptr),
+		m_IndexBuffer(nullptr),
+		m_InputLayout(nullptr),
+		m_VertexStride(0),
+		m_MaxVertices(maxVertices),
+		m_MaxIndices(maxIndices),
+		m_VertexCount(0),
+		m_IndexCount(0)
+	{
+		au_assert(!vertexLayout.empty());
+
+		// Pooled meshes have a single interleaved stream
+		m_VertexStride = (uint32_t)vertexLayout[0].Stride;
+
+		m_VertexBuffer = renderDevice->CreateBuffer(BufferDesc(name + " VB", maxVertices * m_VertexStride, EBufferType::VertexBuffer, EBufferUsage::StaticDraw));
+		m_IndexBuffer = renderDevice->CreateBuffer(BufferDesc(name + " IB", maxIndices * sizeof(Index_t), EBufferType::IndexBuffer, EBufferUsage::StaticDraw));
+		m_InputLayout = renderDevice->CreateInputLayout(vertexLayout);
+	}
+
+	const GeometryPoolEntry* GeometryPool::GetOrAdd(const MeshLodResource* lodResource)
+	{
+		if (lodResource->VertexBuffer == nullptr || lodResource->IndexBuffer == nullptr || lodResource->IndexFormat != EIndexBufferFormat::Uint32)
+		{
+			return nullptr;
+		}
+
+		UniqueIdentifier vertexBufferID = lodResource->VertexBuffer->GetUniqueID();
+		UniqueIdentifier indexBufferID = lodResource->IndexBuffer->GetUniqueID();
+
+		auto it = m_Entries.find(lodResource);
+
+		if (it != m_Entries.end())
+		{
+			if (it->second.VertexBufferID == vertexBufferID && it->second.IndexBufferID == indexBufferID)
+			{
+				return &it->second;
+			}
+
+			// Buffers were recreated, the old range stays unused
+			m_Entries.erase(it);
+		}
+
+		uint32_t vertexCount = lodResource->VertexBuffer->GetDesc().ByteSize / m_VertexStride;
+		uint32_t indexCount = lodResource->IndexBuffer->GetDesc().ByteSize / sizeof(Index_t);
+
+		if (m_VertexCount + vertexCount > m_MaxVertices || m_IndexCount + indexCount > m_MaxIndices)
+		{
+			return nullptr;
+		}
+
+		GeometryPoolEntry entry = {vertexBufferID, indexBufferID, m_VertexCount, m_IndexCount, vertexCount, indexCount};
+
+		m_RenderDevice->CopyToBuffer(m_VertexBuffer, m_VertexCount * m_VertexStride, lodResource->VertexBuffer, 0, vertexCount * m_VertexStride);
+		m_RenderDevice->CopyToBuffer(m_IndexBuffer, m_IndexCount * sizeof(Index_t), lodResource->IndexBuffer, 0, indexCount * sizeof(Index_t));
+
+		m_VertexCount += vertexCount;
+		m_IndexCount += indexCount;
+
+		return &(m_Entries[lodResource] = entry);
+	}
+}
\ No newline at end of file
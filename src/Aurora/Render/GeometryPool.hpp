@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Core/Types.hpp"
+#include "Aurora/Core/String.hpp"
+#include "Aurora/Graphics/Base/Buffer.hpp"
+#include "Aurora/Graphics/Base/InputLayout.hpp"
+#include "Aurora/Tools/robin_hood.h"
+
+namespace Aurora
+{
+	class IRenderDevice;
+	struct MeshLodResource;
+
+	struct GeometryPoolEntry
+	{
+		// Source buffers the entry was copied from, the entry is copied again when they change
+		UniqueIdentifier VertexBufferID;
+		UniqueIdentifier IndexBufferID;
+
+		uint32_t BaseVertex;
+		uint32_t FirstIndex;
+		uint32_t VertexCount;
+		uint32_t IndexCount;
+	};
+
+	// Shared vertex and index buffer for all meshes of one vertex layout, so draws of different meshes can be
+	// submitted with a single multi draw indirect. Mesh LODs are copied in on the GPU the first time they are drawn.
+	// Space is never reclaimed, a full pool returns nullptr and the mesh is drawn from its own buffers.
+	class AU_API GeometryPool
+	{
+	private:
+		IRenderDevice* m_RenderDevice;
+		Buffer_ptr m_VertexBuffer;
+		Buffer_ptr m_IndexBuffer;
+		InputLayout_ptr m_InputLayout;
+		uint32_t m_VertexStride;
+		uint32_t m_MaxVertices;
+		uint32_t m_MaxIndices;
+		uint32_t m_VertexCount;
+		uint32_t m_IndexCount;
+		robin_hood::unordered_node_map<const MeshLodResource*, GeometryPoolEntry> m_Entries; // Node map, entries stay at the same address
+	public:
+		GeometryPool(IRenderDevice* renderDevice, const String& name, const VertexLayout& vertexLayout, uint32_t maxVertices, uint32_t maxIndices);
+
+		// Only 32 bit indices, returns nullptr when the LOD has no index buffer or does not fit
+		const GeometryPoolEntry* GetOrAdd(const MeshLodResource* lodResource);
+
+		[[nodiscard]] const Buffer_ptr& GetVertexBuffer() const { return m_VertexBuffer; }
+		[[nodiscard]] const Buffer_ptr& GetIndexBuffer() const { return m_IndexBuffer; }
+		[[nodiscard]] const InputLayout_ptr& GetInputLayout() const { return m_InputLayout; }
+
+		[[nodiscard]] uint32_t GetVertexStride() const { return m_VertexStride; }
+		[[nodiscard]] uint32_t GetVertexCount() const { return m_VertexCount; }
+		[[nodiscard]] uint32_t GetIndexCount() const { return m_IndexCount; }
+		[[nodiscard]] size_t GetEntryCount() const { return m_Entries.size(); }
+	};
+}
\ No newline at end of file
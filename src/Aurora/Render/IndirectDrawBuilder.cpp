@@ -0,0 +1,116 @@
+#include "IndirectDrawBuilder.hpp"
+
+#include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Framework/Mesh/Mesh.hpp"
+#include "SceneRenderer.hpp"
+
+namespace Aurora
+{
+	IndirectDrawBuilder::IndirectDrawBuilder(IRenderDevice* renderDevice, uint32_t poolMaxVertices, uint32_t poolMaxIndices)
+		: m_RenderDevice(renderDevice),
+		m_PoolMaxVertices(poolMaxVertices),
+		m_PoolMaxIndices(poolMaxIndices)
+	{
+
+	}
+
+	bool IndirectDrawBuilder::CanDrawIndirect(const ModelContext& modelContext)
+	{
+		// Skinned meshes upload bones per component, they stay on the direct path
+		return modelContext.Mesh->GetTypeID() == StaticMesh::TypeID() &&
+			modelContext.MeshSection->PrimitiveType == EPrimitiveType::TriangleList &&
+			modelContext.LodResource->IndexBuffer != nullptr;
+	}
+
+	GeometryPool* IndirectDrawBuilder::GetPool(const Mesh* mesh)
+	{
+		auto it = m_Pools.find(mesh->GetTypeID());
+
+		if (it != m_Pools.end())
+		{
+			return it->second.get();
+		}
+
+		auto pool = std::make_unique<GeometryPool>(m_RenderDevice, "GeometryPool", mesh->GetVertexLayoutDesc(), m_PoolMaxVertices, m_PoolMaxIndices);
+		return (m_Pools[mesh->GetTypeID()] = std::move(pool)).get();
+	}
+
+	uint32_t IndirectDrawBuilder::GetMaterialIndex(Material* material)
+	{
+		auto it = m_MaterialIndices.find(material);
+
+		if (it != m_MaterialIndices.end())
+		{
+			return it->second;
+		}
+
+		auto index = (uint32_t)m_Materials.size();
+		m_Materials.push_back(material);
+		m_MaterialIndices[material] = index;
+		return index;
+	}
+
+	void IndirectDrawBuilder::Build(std::span<const ModelContext> renderSet, FrameVector<ModelContext>& fallbackSet)
+	{
+		CPU_DEBUG_SCOPE("IndirectDrawBuilder::Build");
+
+		m_Commands.clear();
+		m_Instances.clear();
+		m_Batches.clear();
+		m_Materials.clear();
+		m_MaterialIndices.clear();
+
+		for (const ModelContext& modelContext : renderSet)
+		{
+			GeometryPool* pool = nullptr;
+			const GeometryPoolEntry* entry = nullptr;
+
+			if (CanDrawIndirect(modelContext))
+			{
+				pool = GetPool(modelContext.Mesh);
+				entry = pool->GetOrAdd(modelContext.LodResource);
+			}
+
+			if (entry == nullptr)
+			{
+				fallbackSet.push_back(modelContext);
+
+				// Fallback runs switch materials on their own
+				if (!m_Batches.empty() && m_Batches.back().Pool == nullptr)
+				{
+					m_Batches.back().Count++;
+				}
+				else
+				{
+					m_Batches.push_back({modelContext.Material, nullptr, (uint32_t)fallbackSet.size() - 1, 1});
+				}
+
+				continue;
+			}
+
+			if (!m_Batches.empty() && m_Batches.back().Pool == pool && m_Batches.back().Material == modelContext.Material)
+			{
+				m_Batches.back().Count++;
+			}
+			else
+			{
+				m_Batches.push_back({modelContext.Material, pool, (uint32_t)m_Commands.size(), 1});
+			}
+
+			DrawElementsIndirectCommand command = {};
+			command.count = modelContext.MeshSection->NumTriangles;
+			command.instanceCount = (uint32_t)modelContext.Instances.size();
+			command.firstIndex = entry->FirstIndex + modelContext.MeshSection->FirstIndex;
+			command.baseVertex = entry->BaseVertex;
+			command.baseInstance = (uint32_t)m_Instances.size();
+			m_Commands.push_back(command);
+
+			uint32_t materialIndex = GetMaterialIndex(modelContext.Material);
+
+			for (const Matrix4& transform : modelContext.Instances)
+			{
+				m_Instances.push_back({transform, materialIndex, {0, 0, 0}});
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Core/Types.hpp"
+#include "Aurora/Core/Vector.hpp"
+#include "Aurora/Graphics/Base/IRenderDevice.hpp"
+#include "Aurora/Memory/FrameAllocator.hpp"
+#include "Aurora/Tools/robin_hood.h"
+#include "GeometryPool.hpp"
+
+namespace Aurora
+{
+	class Material;
+	class Mesh;
+	struct ModelContext;
+
+	// Element of the IndirectInstances storage block, std430 layout (see World/instancing.h)
+	struct IndirectInstance
+	{
+		Matrix4 Transform;
+		uint32_t MaterialIndex;
+		uint32_t Padding[3];
+	};
+
+	static_assert(sizeof(IndirectInstance) == 80, "IndirectInstance does not match the std430 layout");
+
+	struct IndirectDrawBatch
+	{
+		Aurora::Material* Material;
+		// Draw commands of the pool, or contexts of the fallback set drawn one by one when nullptr
+		GeometryPool* Pool;
+		uint32_t First;
+		uint32_t Count;
+	};
+
+	// Turns a sorted render set into multi draw indirect batches. Model contexts of static meshes are moved into the
+	// geometry pool of their vertex layout and become one draw command each, consecutive commands with the same material
+	// and pool end up in one batch, so a pass is a few MDI calls instead of a draw per context.
+	// Everything else (skinned meshes, non indexed or non triangle sections, full pools) goes to the fallback set in order.
+	class AU_API IndirectDrawBuilder
+	{
+	private:
+		IRenderDevice* m_RenderDevice;
+		uint32_t m_PoolMaxVertices;
+		uint32_t m_PoolMaxIndices;
+		robin_hood::unordered_map<TTypeID, std::unique_ptr<GeometryPool>> m_Pools;
+
+		std::vector<DrawElementsIndirectCommand> m_Commands;
+		std::vector<IndirectInstance> m_Instances;
+		std::vector<IndirectDrawBatch> m_Batches;
+		std::vector<Material*> m_Materials;
+		robin_hood::unordered_flat_map<Material*, uint32_t> m_MaterialIndices;
+	public:
+		explicit IndirectDrawBuilder(IRenderDevice* renderDevice, uint32_t poolMaxVertices = 1u << 19, uint32_t poolMaxIndices = 1u << 21);
+
+		// Keeps the order of the render set, fallback contexts are appended to the fallback set
+		void Build(std::span<const ModelContext> renderSet, FrameVector<ModelContext>& fallbackSet);
+
+		[[nodiscard]] static bool CanDrawIndirect(const ModelContext& modelContext);
+
+		// Creates the pool for the vertex layout of the mesh on first use
+		GeometryPool* GetPool(const Mesh* mesh);
+
+		[[nodiscard]] const std::vector<DrawElementsIndirectCommand>& GetCommands() const { return m_Commands; }
+		[[nodiscard]] const std::vector<IndirectInstance>& GetInstances() const { return m_Instances; }
+		[[nodiscard]] const std::vector<IndirectDrawBatch>& GetBatches() const { return m_Batches; }
+		// Material of each MaterialIndex of the instances
+		[[nodiscard]] const std::vector<Material*>& GetMaterials() const { return m_Materials; }
+	private:
+		uint32_t GetMaterialIndex(Material* material);
+	};
+}
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include "SceneRenderer.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 #include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Core/JobSystem.hpp"
+#include "Aurora/Core/RadixSort.hpp"
 #include "Aurora/Framework/Scene.hpp"
 #include "Aurora/Framework/CameraComponent.hpp"
 #include "Aurora/Framework/MeshComponent.hpp"
@@ -12,7 +17,7 @@
 
 namespace Aurora
 {
-	SceneRenderer::SceneRenderer()
+	SceneRenderer::SceneRenderer() : m_IndirectDrawBuilder(GEngine->GetRenderDevice())
 	{
 		m_InstancesBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("Instances", sizeof(Matrix4) * MaxInstances, EBufferType::UniformBuffer, EBufferUsage::DynamicDraw, false));
 		m_BaseVsDataBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("BaseVSData", sizeof(BaseVSData), EBufferType::UniformBuffer));
@@ -39,6 +44,48 @@ namespace Aurora
 		});
 	}
 
+	void SceneRenderer::PrepareCulling(Scene* scene)
+	{
+		CPU_DEBUG_SCOPE("PrepareCulling");
+
+		// Editor and game code may move components after the scene update
+		scene->UpdateWorldTransforms();
+
+		ComponentView<MeshComponent> meshComponents = scene->GetComponents<MeshComponent>();
+		auto count = (uint32_t)meshComponents.size();
+
+		m_FrustumCuller.Resize(count);
+
+		// World matrices are up-to-date, so the gather only reads component state
+		auto gatherBounds = [this, &meshComponents](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				MeshComponent* meshComponent = meshComponents[i];
+
+				if(!meshComponent->HasMesh() || !meshComponent->IsActive() || !meshComponent->IsParentActive())
+				{
+					m_FrustumCuller.SetDisabled(i);
+					continue;
+				}
+
+				AABB worldBounds = meshComponent->GetMesh()->m_Bounds.Transform(meshComponent->GetTransformationMatrix());
+				m_FrustumCuller.SetBounds(i, worldBounds, meshComponent->IsIgnoringFrustumChecks() ? FrustumCuller::FlagAlwaysVisible : FrustumCuller::FlagNone);
+			}
+		};
+
+		if (JobSystem* jobSystem = GEngine->GetJobSystem())
+		{
+			jobSystem->ParallelFor(count, 256, gatherBounds);
+		}
+		else
+		{
+			gatherBounds(0, count);
+		}
+
+		m_CullingScene = scene;
+	}
+
 	void SceneRenderer::PrepareMeshComponent(MeshComponent* meshComponent, CameraComponent* camera, const FFrustum& frustum)
 	{
 		if(!meshComponent->HasMesh() || !meshComponent->IsActive() || !meshComponent->IsParentActive())
@@ -46,16 +93,30 @@ namespace Aurora
 			return;
 		}
 
-		Matrix4 transform = meshComponent->GetTransformationMatrix();
-		Mesh_ptr mesh = meshComponent->GetMesh();
+		const Matrix4& transform = meshComponent->GetTransformationMatrix();
 
-		if (not frustum.IsBoxVisible(mesh->m_Bounds.Transform(transform)) &&  not meshComponent->IsIgnoringFrustumChecks())
+		if (not frustum.IsBoxVisible(meshComponent->GetMesh()->m_Bounds.Transform(transform)) &&  not meshComponent->IsIgnoringFrustumChecks())
 		{
 			return;
 		}
 
-		// TODO: Complete lod switching
+		AddVisibleMeshComponent(meshComponent, transform, camera ? camera->GetWorldPosition() : Vector3(0.0f));
+	}
+
+	void SceneRenderer::AddVisibleMeshComponent(MeshComponent* meshComponent, const Matrix4& transform, const Vector3& cameraPosition)
+	{
+		Mesh_ptr mesh = meshComponent->GetMesh();
+
+		float depth = glm::length2(Vector3(transform[3]) - cameraPosition);
+
 		LOD lod = 0;
+
+		if (mesh->LODResources.size() > 1 && depth > 0.0f)
+		{
+			float radius = glm::length(mesh->m_Bounds.Transform(transform).GetSize()) * 0.5f;
+			lod = mesh->SelectLOD(radius / std::sqrt(depth));
+		}
+
 		const MeshLodResource& lodResource = mesh->LODResources[lod];
 
 		for (int sectionID = 0; sectionID < lodResource.Sections.size(); ++sectionID)
@@ -84,7 +145,8 @@ namespace Aurora
 				visibleEntity.Mesh = mesh.get();
 				visibleEntity.MeshSection = sectionID;
 				visibleEntity.Lod = lod;
-				visibleEntity.Transform = transform;
+				visibleEntity.Transform = &transform;
+				visibleEntity.Depth = depth;
 
 				m_VisibleEntities[(uint8)renderSortType].emplace_back(visibleEntity);
 			}
@@ -93,9 +155,22 @@ namespace Aurora
 
 	void SceneRenderer::PrepareVisibleEntities(Scene* scene, CameraComponent* camera, const FFrustum& frustum)
 	{
-		for (MeshComponent* meshComponent : scene->GetComponents<MeshComponent>())
+		ComponentView<MeshComponent> meshComponents = scene->GetComponents<MeshComponent>();
+
+		if (m_CullingScene != scene || m_FrustumCuller.GetCount() != meshComponents.size())
 		{
-			PrepareMeshComponent(meshComponent, camera, frustum);
+			PrepareCulling(scene);
+		}
+
+		FrameVector<uint32_t> visibleIndices;
+		m_FrustumCuller.Cull(frustum, visibleIndices, GEngine->GetJobSystem());
+
+		Vector3 cameraPosition = camera ? camera->GetWorldPosition() : Vector3(0.0f);
+
+		for (uint32_t index : visibleIndices)
+		{
+			MeshComponent* meshComponent = meshComponents[index];
+			AddVisibleMeshComponent(meshComponent, meshComponent->GetTransformationMatrix(), cameraPosition);
 		}
 	}
 
@@ -107,90 +182,135 @@ namespace Aurora
 		}
 	}
 
-	void SceneRenderer::FillRenderSet(RenderSet& renderSet, int numberOfPasses, ...)
+	// Key layout from the highest bits: pass slot (4), then either material (20), mesh section (24), depth (16)
+	// for state sorted types, or depth (16), material (20), mesh section (24) for back-to-front types.
+	// Depth buckets are the upper bits of the float, which keep the ordering of positive floats.
+	// The mesh section field is mesh (13), LOD (3), section (8), so entities drawn from the same buffers are adjacent.
+	static constexpr uint64_t SortKeyPassShift = 60;
+	static constexpr uint64_t SortKeyMaterialMask = (1u << 20) - 1;
+	static constexpr uint64_t SortKeyMeshSectionMask = (1u << 24) - 1;
+
+	uint64_t SceneRenderer::BuildSortKey(const VisibleEntity& visibleEntity, RenderSortType sortType, uint32_t passSlot)
 	{
-		std::va_list args;
-		va_start(args, numberOfPasses);
+		auto materialIt = m_SortMaterialIDs.try_emplace(visibleEntity.Material, (uint32_t)m_SortMaterialIDs.size()).first;
+		auto meshIt = m_SortMeshIDs.try_emplace(visibleEntity.Mesh, (uint32_t)m_SortMeshIDs.size()).first;
 
-		// Sort and prepare model contexts
-		for (uint8_t j = 0; j < numberOfPasses; ++j)
+		uint64_t material = materialIt->second & SortKeyMaterialMask;
+		uint64_t meshSection = ((uint64_t(meshIt->second) << 11) | (uint64_t(visibleEntity.Lod & 0x7) << 8) | (visibleEntity.MeshSection & 0xFF)) & SortKeyMeshSectionMask;
+
+		uint32_t depthBits;
+		float depth = std::max(visibleEntity.Depth, 0.0f);
+		std::memcpy(&depthBits, &depth, sizeof(depthBits));
+		uint64_t depthBucket = depthBits >> 16;
+
+		uint64_t key = uint64_t(passSlot) << SortKeyPassShift;
+
+		switch (sortType)
 		{
-			uint8_t i = (uint8_t) va_arg(args, RenderSortType);
+			case RenderSortType::Translucent:
+				// Back-to-front, depth dominates so blending stays correct
+				key |= (0xFFFF - depthBucket) << 44;
+				key |= material << 24;
+				key |= meshSection;
+				break;
+			case RenderSortType::Opaque:
+			case RenderSortType::Transparent:
+				// State first, instances of one batch are front-to-back
+				key |= material << 40;
+				key |= meshSection << 16;
+				key |= depthBucket;
+				break;
+			default:
+				key |= material << 40;
+				key |= meshSection << 16;
+				break;
+		}
 
-			std::vector<VisibleEntity>& visibleEntities = m_VisibleEntities[i];
+		return key;
+	}
 
-			if(visibleEntities.empty())
-				continue;
+	void SceneRenderer::FillRenderSet(RenderSet& renderSet, int numberOfPasses, ...)
+	{
+		CPU_DEBUG_SCOPE("FillRenderSet");
 
-			std::sort(visibleEntities.begin(), visibleEntities.end(), [](const VisibleEntity& left, const VisibleEntity& right) -> bool
-			{
-				if(left.Material != right.Material)
-					return left.Material < right.Material;
+		std::array<uint8_t, SortTypeCount> sortTypes {};
+		size_t entityCount = 0;
 
-				if(left.Mesh != right.Mesh)
-					return left.Mesh < right.Mesh;
+		std::va_list args;
+		va_start(args, numberOfPasses);
+		for (int j = 0; j < numberOfPasses && j < SortTypeCount; ++j)
+		{
+			sortTypes[j] = (uint8_t) va_arg(args, RenderSortType);
+			entityCount += m_VisibleEntities[sortTypes[j]].size();
+		}
+		va_end(args);
 
-				if(left.MeshSection != right.MeshSection)
-					return left.MeshSection < right.MeshSection;
+		numberOfPasses = std::min<int>(numberOfPasses, SortTypeCount);
 
-				return false;
-			});
+		if (entityCount == 0)
+			return;
+
+		FrameAllocator& frameAllocator = FrameAllocator::Get();
+		auto* keys = frameAllocator.Alloc<uint64_t>(entityCount * 2);
+		auto* entityIndices = frameAllocator.Alloc<uint32_t>(entityCount * 2);
+		auto* entities = frameAllocator.Alloc<const VisibleEntity*>(entityCount);
 
-			VisibleEntity lastVisibleEntity = {nullptr, nullptr, nullptr, 0, 0, {}};
-			bool lastCanBeInstanced = false;
-			ModelContext currentModelContext = {nullptr, nullptr, nullptr, nullptr, nullptr, {}};
+		m_SortMaterialIDs.clear();
+		m_SortMeshIDs.clear();
 
-			for (const VisibleEntity& visibleEntity : visibleEntities)
+		// Sort only 8 byte keys with indices instead of whole entities
+		uint32_t entityIndex = 0;
+		for (int j = 0; j < numberOfPasses; ++j)
+		{
+			for (const VisibleEntity& visibleEntity : m_VisibleEntities[sortTypes[j]])
 			{
-				bool canBeInstanced = visibleEntity.Material->HasFlag(MF_INSTANCED);
+				keys[entityIndex] = BuildSortKey(visibleEntity, (RenderSortType)sortTypes[j], (uint32_t)j);
+				entityIndices[entityIndex] = entityIndex;
+				entities[entityIndex] = &visibleEntity;
+				entityIndex++;
+			}
+		}
 
-				if (lastVisibleEntity.Mesh == nullptr)
-				{
-					lastVisibleEntity = visibleEntity;
-					lastCanBeInstanced = canBeInstanced;
-
-					currentModelContext.Material = visibleEntity.Material;
-					currentModelContext.MeshComponent = visibleEntity.MeshComponent;
-					currentModelContext.Mesh = visibleEntity.Mesh;
-					currentModelContext.LodResource = &visibleEntity.Mesh->LODResources[visibleEntity.Lod];
-					currentModelContext.MeshSection = &currentModelContext.LodResource->Sections[visibleEntity.MeshSection];
-					currentModelContext.Instances.push_back(visibleEntity.Transform);
-					continue;
-				}
+		RadixSort(keys, entityIndices, keys + entityCount, entityIndices + entityCount, entityCount);
 
-				if (lastVisibleEntity == visibleEntity && lastCanBeInstanced == canBeInstanced && currentModelContext.Instances.size() < MaxInstances)
-				{
-					currentModelContext.Instances.push_back(visibleEntity.Transform);
-				}
-				else
-				{
-					lastVisibleEntity = visibleEntity;
-					lastCanBeInstanced = canBeInstanced;
+		// Transforms are written once in draw order, model contexts reference ranges of it
+		auto* instances = frameAllocator.Alloc<Matrix4>(entityCount);
 
-					if(!currentModelContext.Instances.empty())
-					{
-						renderSet.emplace_back(currentModelContext);
-						currentModelContext = {nullptr, nullptr, nullptr, nullptr, nullptr, {}};
-					}
+		ModelContext currentModelContext = {nullptr, nullptr, nullptr, nullptr, nullptr, {}};
+		const VisibleEntity* lastVisibleEntity = nullptr;
+		size_t rangeBegin = 0;
 
-					currentModelContext.Material = visibleEntity.Material;
-					currentModelContext.MeshComponent = visibleEntity.MeshComponent;
-					currentModelContext.Mesh = visibleEntity.Mesh;
-					currentModelContext.LodResource = &visibleEntity.Mesh->LODResources[visibleEntity.Lod];
-					currentModelContext.MeshSection = &currentModelContext.LodResource->Sections[visibleEntity.MeshSection];
-					currentModelContext.Instances.push_back(visibleEntity.Transform);
-				}
+		for (size_t i = 0; i < entityCount; ++i)
+		{
+			const VisibleEntity& visibleEntity = *entities[entityIndices[i]];
+			instances[i] = *visibleEntity.Transform;
+
+			if (lastVisibleEntity && *lastVisibleEntity == visibleEntity && i - rangeBegin < MaxInstances)
+			{
+				continue;
 			}
 
-			if (!currentModelContext.Instances.empty())
+			if (lastVisibleEntity)
 			{
+				currentModelContext.Instances = std::span<const Matrix4>(instances + rangeBegin, i - rangeBegin);
 				renderSet.emplace_back(currentModelContext);
 			}
+
+			lastVisibleEntity = &visibleEntity;
+			rangeBegin = i;
+
+			currentModelContext.Material = visibleEntity.Material;
+			currentModelContext.MeshComponent = visibleEntity.MeshComponent;
+			currentModelContext.Mesh = visibleEntity.Mesh;
+			currentModelContext.LodResource = &visibleEntity.Mesh->LODResources[visibleEntity.Lod];
+			currentModelContext.MeshSection = &currentModelContext.LodResource->Sections[visibleEntity.MeshSection];
 		}
-		va_end(args);
+
+		currentModelContext.Instances = std::span<const Matrix4>(instances + rangeBegin, entityCount - rangeBegin);
+		renderSet.emplace_back(currentModelContext);
 	}
 
-	void SceneRenderer::RenderPass(PassType_t pass, DrawCallState& drawCallState, CameraComponent* camera, const RenderSet& renderSet, bool drawInjected)
+	void SceneRenderer::RenderPass(PassType_t pass, DrawCallState& drawCallState, CameraComponent* camera, std::span<const ModelContext> renderSet, bool drawInjected)
 	{
 		// Render model contexts
 
@@ -200,6 +320,7 @@ namespace Aurora
 		FMeshSection* currentSection = nullptr;
 		MeshComponent* currentComponent = nullptr;
 		bool updateInputLayout = false;
+		bool materialBound = false;
 
 		for (const ModelContext& modelContext : renderSet)
 		{
@@ -211,10 +332,15 @@ namespace Aurora
 				}
 				currentMaterial = modelContext.Material;
 				currentMaterial->BeforeMaterialBegin.Invoke(std::forward<PassType_t>(pass), std::forward<DrawCallState&>(drawCallState), std::forward<CameraComponent*>(camera), std::forward<Material*>(currentMaterial));
-				currentMaterial->BeginPass(pass, drawCallState);
+				materialBound = currentMaterial->BeginPass(pass, drawCallState);
 				updateInputLayout = true;
 			}
 
+			if (!materialBound)
+			{
+				continue;
+			}
+
 			if (!(currentMesh == modelContext.Mesh && currentLodResource == modelContext.LodResource && currentSection == modelContext.MeshSection))
 			{
 				currentMesh = modelContext.Mesh;
@@ -242,12 +368,23 @@ namespace Aurora
 				currentComponent = modelContext.MeshComponent;
 
 				currentComponent->UploadAnimation(m_BonesBuffer);
-				drawCallState.BindUniformBuffer("GLOB_BoneData", m_BonesBuffer);
-				GEngine->GetRenderDevice()->BindShaderResources(drawCallState);
+				drawCallState.BindUniformBuffer("GLOB_BoneData"_HASH, m_BonesBuffer);
+			}
+
+			// Write instances to the streaming buffer, the GPU may still read the ones of previous draws
+			VBufferCacheIndex instancesCacheIndex;
+			uint32_t instancesSize = modelContext.Instances.size() * sizeof(Matrix4);
+			uint8* instances = GEngine->GetRenderManager()->GetUniformBufferCache().GetOrMap(instancesSize, instancesCacheIndex);
+
+			if (instances == nullptr)
+			{
+				continue;
 			}
 
-			// Write instances
-			GEngine->GetRenderDevice()->WriteBuffer(m_InstancesBuffer, modelContext.Instances.data(), modelContext.Instances.size() * sizeof(Matrix4), 0);
+			std::memcpy(instances, modelContext.Instances.data(), instancesSize);
+			GEngine->GetRenderManager()->GetUniformBufferCache().Unmap(instancesCacheIndex);
+			drawCallState.BindUniformBuffer("Instances"_HASH, instancesCacheIndex.Buffer, instancesCacheIndex.Offset, instancesCacheIndex.Size);
+			GEngine->GetRenderDevice()->BindShaderResources(drawCallState);
 
 			DrawArguments drawArguments;
 			drawArguments.VertexCount = modelContext.MeshSection->NumTriangles;
@@ -269,6 +406,97 @@ namespace Aurora
 			m_InjectedPasses[pass].Invoke(std::forward<PassType_t>(pass), drawCallState, std::forward<CameraComponent*>(camera));
 	}
 
+	void SceneRenderer::RenderPassIndirect(PassType_t pass, DrawCallState& drawCallState, CameraComponent* camera, std::span<const ModelContext> renderSet, bool drawInjected)
+	{
+		CPU_DEBUG_SCOPE("RenderPassIndirect");
+
+		RenderSet fallbackSet;
+		m_IndirectDrawBuilder.Build(renderSet, fallbackSet);
+
+		const std::vector<DrawElementsIndirectCommand>& commands = m_IndirectDrawBuilder.GetCommands();
+		const std::vector<IndirectInstance>& instances = m_IndirectDrawBuilder.GetInstances();
+
+		// Commands and instances of the whole pass are written once
+		BufferCache& storageBufferCache = GEngine->GetRenderManager()->GetStorageBufferCache();
+		VBufferCacheIndex commandsCacheIndex;
+		VBufferCacheIndex instancesCacheIndex;
+		uint8* commandsData = nullptr;
+		uint8* instancesData = nullptr;
+
+		if (!commands.empty())
+		{
+			commandsData = storageBufferCache.GetOrMap(commands.size() * sizeof(DrawElementsIndirectCommand), commandsCacheIndex);
+			instancesData = storageBufferCache.GetOrMap(instances.size() * sizeof(IndirectInstance), instancesCacheIndex);
+
+			if (commandsData == nullptr || instancesData == nullptr)
+			{
+				RenderPass(pass, drawCallState, camera, renderSet, drawInjected);
+				return;
+			}
+
+			std::memcpy(commandsData, commands.data(), commandsCacheIndex.Size);
+			std::memcpy(instancesData, instances.data(), instancesCacheIndex.Size);
+			storageBufferCache.Unmap(commandsCacheIndex);
+			storageBufferCache.Unmap(instancesCacheIndex);
+		}
+
+		Material* currentMaterial = nullptr;
+		bool materialBound = false;
+
+		for (const IndirectDrawBatch& batch : m_IndirectDrawBuilder.GetBatches())
+		{
+			if (batch.Pool == nullptr)
+			{
+				if (currentMaterial)
+				{
+					currentMaterial->EndPass(pass, drawCallState);
+					currentMaterial = nullptr;
+				}
+
+				RenderPass(pass, drawCallState, camera, std::span<const ModelContext>(fallbackSet).subspan(batch.First, batch.Count), false);
+				continue;
+			}
+
+			if (currentMaterial != batch.Material)
+			{
+				if (currentMaterial)
+				{
+					currentMaterial->EndPass(pass, drawCallState);
+				}
+				currentMaterial = batch.Material;
+				currentMaterial->BeforeMaterialBegin.Invoke(std::forward<PassType_t>(pass), std::forward<DrawCallState&>(drawCallState), std::forward<CameraComponent*>(camera), std::forward<Material*>(currentMaterial));
+				materialBound = currentMaterial->BeginPass(pass, drawCallState, true);
+			}
+
+			if (!materialBound)
+			{
+				continue;
+			}
+
+			drawCallState.PrimitiveType = EPrimitiveType::TriangleList;
+			drawCallState.InputLayoutHandle = batch.Pool->GetInputLayout();
+			drawCallState.SetIndexBuffer(batch.Pool->GetIndexBuffer(), EIndexBufferFormat::Uint32);
+			drawCallState.SetVertexBuffer(0, batch.Pool->GetVertexBuffer());
+			drawCallState.BindSSBOBuffer("IndirectInstances"_HASH, instancesCacheIndex.Buffer, instancesCacheIndex.Offset, instancesCacheIndex.Size);
+
+			GEngine->GetRenderDevice()->BindShaderInputs(drawCallState, true);
+			GEngine->GetRenderDevice()->BindShaderResources(drawCallState);
+			GEngine->GetRenderDevice()->DrawIndirect(drawCallState, commandsCacheIndex.Buffer, commandsCacheIndex.Offset + batch.First * sizeof(DrawElementsIndirectCommand), batch.Count);
+
+			drawCallState.ClearColorTarget = false;
+			drawCallState.ClearDepthTarget = false;
+			drawCallState.ClearStencilTarget = false;
+		}
+
+		if (currentMaterial)
+		{
+			currentMaterial->EndPass(pass, drawCallState);
+		}
+
+		if (drawInjected)
+			m_InjectedPasses[pass].Invoke(std::forward<PassType_t>(pass), drawCallState, std::forward<CameraComponent*>(camera));
+	}
+
 	TemporalRenderTarget SceneRenderer::RenderBloom(const FViewPort& wp, const Texture_ptr& inputHDRRT)
 	{
 		TemporalRenderTarget bloomRTs[3];
@@ -308,13 +536,13 @@ namespace Aurora
 				state.ClearColorTarget = false;
 				state.ClearDepthTarget = false;
 
-				state.BindUniformBuffer("BloomDesc", m_BloomDescBuffer);
-				state.BindSampler("u_Texture", Samplers::ClampClampLinearLinear);
-				state.BindSampler("u_BloomTexture", Samplers::ClampClampLinearLinear);
+				state.BindUniformBuffer("BloomDesc"_HASH, m_BloomDescBuffer);
+				state.BindSampler("u_Texture"_HASH, Samplers::ClampClampLinearLinear);
+				state.BindSampler("u_BloomTexture"_HASH, Samplers::ClampClampLinearLinear);
 
-				state.BindTexture("u_Texture", inputHDRRT);
-				state.BindTexture("u_BloomTexture", inputHDRRT);
-				state.BindTexture("o_Image", bloomRTs[0], true);
+				state.BindTexture("u_Texture"_HASH, inputHDRRT);
+				state.BindTexture("u_BloomTexture"_HASH, inputHDRRT);
+				state.BindTexture("o_Image"_HASH, bloomRTs[0], true);
 
 				state.BindTarget(0, bloomRTs[0], 0, 0);
 				bloomDesc.HalfTexel = (1.0f / (Vector2)bloomRTs[0]->GetDesc().GetSize()) * 0.5f;
@@ -339,7 +567,7 @@ namespace Aurora
 						bloomDesc.LodAndMode.x = (float)i - 1.0f;
 						GEngine->GetRenderDevice()->WriteBuffer(m_BloomDescBuffer, &bloomDesc);
 
-						state.BindTexture("u_Texture", bloomRTs[0]);
+						state.BindTexture("u_Texture"_HASH, bloomRTs[0]);
 						GEngine->GetRenderDevice()->Draw(state, {DrawArguments(4)}, true);
 					}
 
@@ -351,7 +579,7 @@ namespace Aurora
 						// Input
 						bloomDesc.LodAndMode.x = (float)i;
 						GEngine->GetRenderDevice()->WriteBuffer(m_BloomDescBuffer, &bloomDesc);
-						state.BindTexture("u_Texture", bloomRTs[1]);
+						state.BindTexture("u_Texture"_HASH, bloomRTs[1]);
 						GEngine->GetRenderDevice()->Draw(state, {DrawArguments(4)}, true);
 					}
 				}
@@ -370,7 +598,7 @@ namespace Aurora
 					// Input
 					bloomDesc.LodAndMode.x = (float)mips - 2.0f;
 					GEngine->GetRenderDevice()->WriteBuffer(m_BloomDescBuffer, &bloomDesc);
-					state.BindTexture("u_Texture", bloomRTs[0]);
+					state.BindTexture("u_Texture"_HASH, bloomRTs[0]);
 
 					GEngine->GetRenderDevice()->Draw(state, {DrawArguments(4)}, true);
 				}
@@ -390,8 +618,8 @@ namespace Aurora
 					// Input
 					bloomDesc.LodAndMode.x = mip;
 					GEngine->GetRenderDevice()->WriteBuffer(m_BloomDescBuffer, &bloomDesc);
-					state.BindTexture("u_Texture", bloomRTs[0]);
-					state.BindTexture("u_BloomTexture", bloomRTs[2]);
+					state.BindTexture("u_Texture"_HASH, bloomRTs[0]);
+					state.BindTexture("u_BloomTexture"_HASH, bloomRTs[2]);
 
 					GEngine->GetRenderDevice()->Draw(state, {DrawArguments(4)}, true);
 				}
@@ -403,15 +631,15 @@ namespace Aurora
 
 				DispatchState dispatchState;
 				dispatchState.Shader = m_BloomShader;
-				dispatchState.BindUniformBuffer("BloomDesc", m_BloomDescBuffer);
-				dispatchState.BindSampler("u_Texture", Samplers::ClampClampLinearLinear);
-				dispatchState.BindSampler("u_BloomTexture", Samplers::ClampClampLinearLinear);
+				dispatchState.BindUniformBuffer("BloomDesc"_HASH, m_BloomDescBuffer);
+				dispatchState.BindSampler("u_Texture"_HASH, Samplers::ClampClampLinearLinear);
+				dispatchState.BindSampler("u_BloomTexture"_HASH, Samplers::ClampClampLinearLinear);
 
 				GEngine->GetRenderDevice()->WriteBuffer(m_BloomDescBuffer, &bloomDesc);
 
-				dispatchState.BindTexture("u_Texture", inputHDRRT);
-				dispatchState.BindTexture("u_BloomTexture", inputHDRRT);
-				dispatchState.BindTexture("o_Image", bloomRTs[0], true);
+				dispatchState.BindTexture("u_Texture"_HASH, inputHDRRT);
+				dispatchState.BindTexture("u_BloomTexture"_HASH, inputHDRRT);
+				dispatchState.BindTexture("o_Image"_HASH, bloomRTs[0], true);
 
 				// Prefilter
 				GEngine->GetRenderDevice()->Dispatch(dispatchState, workGroupsX, workGroupsY, 1);
@@ -428,23 +656,23 @@ namespace Aurora
 
 					{ // Ping
 						// Output
-						dispatchState.BindTexture("o_Image", bloomRTs[1], true, Aurora::TextureBinding::EAccess::Write, i);
+						dispatchState.BindTexture("o_Image"_HASH, bloomRTs[1], true, Aurora::TextureBinding::EAccess::Write, i);
 						// Input
 						bloomDesc.LodAndMode.x = (float)i - 1.0f;
 						GEngine->GetRenderDevice()->WriteBuffer(m_BloomDescBuffer, &bloomDesc);
 
-						dispatchState.BindTexture("u_Texture", bloomRTs[0]);
+						dispatchState.BindTexture("u_Texture"_HASH, bloomRTs[0]);
 						GEngine->GetRenderDevice()->Dispatch(dispatchState, workGroupsX, workGroupsY, 1);
 					}
 
 					{ // Pong
 						//Output
-						dispatchState.BindTexture("o_Image", bloomRTs[0], true, Aurora::TextureBinding::EAccess::Write, i);
+						dispatchState.BindTexture("o_Image"_HASH, bloomRTs[0], true, Aurora::TextureBinding::EAccess::Write, i);
 
 						// Input
 						bloomDesc.LodAndMode.x = (float)i;
 						GEngine->GetRenderDevice()->WriteBuffer(m_BloomDescBuffer, &bloomDesc);
-						dispatchState.BindTexture("u_Texture", bloomRTs[1]);
+						dispatchState.BindTexture("u_Texture"_HASH, bloomRTs[1]);
 						GEngine->GetRenderDevice()->Dispatch(dispatchState, workGroupsX, workGroupsY, 1);
 					}
 				}
@@ -454,12 +682,12 @@ namespace Aurora
 
 				{ // Upsample First
 					//Output
-					dispatchState.BindTexture("o_Image", bloomRTs[2], true, Aurora::TextureBinding::EAccess::Write, mips - 1);
+					dispatchState.BindTexture("o_Image"_HASH, bloomRTs[2], true, Aurora::TextureBinding::EAccess::Write, mips - 1);
 
 					// Input
 					bloomDesc.LodAndMode.x = (float)mips - 2.0f;
 					GEngine->GetRenderDevice()->WriteBuffer(m_BloomDescBuffer, &bloomDesc);
-					dispatchState.BindTexture("u_Texture", bloomRTs[0]);
+					dispatchState.BindTexture("u_Texture"_HASH, bloomRTs[0]);
 
 					auto mipSize = bloomRTs[2]->GetDesc().GetMipSize(mips - 1);
 					workGroupsX = (uint32_t)glm::ceil((float)mipSize.x / (float)m_BloomComputeWorkgroupSize);
@@ -478,13 +706,13 @@ namespace Aurora
 					workGroupsY = (uint32_t)glm::ceil((float)mipSize.y / (float)m_BloomComputeWorkgroupSize);
 
 					//Output
-					dispatchState.BindTexture("o_Image", bloomRTs[2], true, Aurora::TextureBinding::EAccess::Write, mip);
+					dispatchState.BindTexture("o_Image"_HASH, bloomRTs[2], true, Aurora::TextureBinding::EAccess::Write, mip);
 
 					// Input
 					bloomDesc.LodAndMode.x = mip;
 					GEngine->GetRenderDevice()->WriteBuffer(m_BloomDescBuffer, &bloomDesc);
-					dispatchState.BindTexture("u_Texture", bloomRTs[0]);
-					dispatchState.BindTexture("u_BloomTexture", bloomRTs[2]);
+					dispatchState.BindTexture("u_Texture"_HASH, bloomRTs[0]);
+					dispatchState.BindTexture("u_BloomTexture"_HASH, bloomRTs[2]);
 
 					GEngine->GetRenderDevice()->Dispatch(dispatchState, workGroupsX, workGroupsY, 1);
 				}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <span>
 #include "Aurora/Core/Delegate.hpp"
 #include "Aurora/Core/Library.hpp"
 #include "Aurora/Tools/robin_hood.h"
@@ -9,6 +10,9 @@
 #include "Aurora/Graphics/Color.hpp"
 #include "Aurora/Graphics/RenderManager.hpp"
 #include "Aurora/Framework/Mesh/Mesh.hpp"
+#include "Aurora/Memory/FrameAllocator.hpp"
+#include "FrustumCuller.hpp"
+#include "IndirectDrawBuilder.hpp"
 
 namespace Aurora
 {
@@ -28,11 +32,15 @@ namespace Aurora
 		Aurora::Mesh* Mesh;
 		uint MeshSection;
 		LOD Lod;
-		Matrix4 Transform;
+		// Points to the cached world matrix of the component, copied once into the instance array
+		const Matrix4* Transform;
+		// Squared distance to the camera
+		float Depth;
 
 		bool operator==(const VisibleEntity& other) const
 		{
-			return Material == other.Material && Mesh == other.Mesh && MeshSection == other.MeshSection;
+			// Every LOD has its own buffers, entities at different LODs cannot share a draw
+			return Material == other.Material && Mesh == other.Mesh && MeshSection == other.MeshSection && Lod == other.Lod;
 		}
 
 		bool operator!=(const VisibleEntity& other) const
@@ -48,10 +56,12 @@ namespace Aurora
 		MeshLodResource* LodResource;
 		FMeshSection* MeshSection;
 		Aurora::MeshComponent* MeshComponent;
-		std::vector<Matrix4> Instances;
+		// Range in the contiguous per-frame instance array of the render set
+		std::span<const Matrix4> Instances;
 	};
 
-	using RenderSet = std::vector<ModelContext>;
+	// Render sets are rebuilt every frame, so they live in the frame allocator
+	using RenderSet = FrameVector<ModelContext>;
 
 	typedef EventEmitter<PassType_t, DrawCallState&, CameraComponent*> PassRenderEventEmitter;
 
@@ -124,9 +134,16 @@ namespace Aurora
 	protected:
 		robin_hood::unordered_map<TTypeID, InputLayout_ptr> m_MeshInputLayouts;
 		std::array<std::vector<VisibleEntity>, SortTypeCount> m_VisibleEntities;
+		FrustumCuller m_FrustumCuller;
+		Scene* m_CullingScene = nullptr;
+
+		// Compact IDs for sort keys, rebuilt by every FillRenderSet
+		robin_hood::unordered_flat_map<Material*, uint32_t> m_SortMaterialIDs;
+		robin_hood::unordered_flat_map<Mesh*, uint32_t> m_SortMeshIDs;
 		std::array<PassRenderEventEmitter, Pass::Count> m_InjectedPasses;
+		IndirectDrawBuilder m_IndirectDrawBuilder;
 
-		Buffer_ptr m_InstancesBuffer;
+		Buffer_ptr m_InstancesBuffer; // Bound until the first draw of a pass, RenderPass binds instances from the uniform stream
 		Buffer_ptr m_BaseVsDataBuffer;
 		Buffer_ptr m_GlobDataBuffer;
 		Buffer_ptr m_BonesBuffer;
@@ -140,6 +157,8 @@ namespace Aurora
 		const int m_BloomComputeWorkgroupSize = 16;
 	public:
 		FToneMapSettings ToneMapSettings;
+		// Opaque passes go through RenderPassIndirect, needs GL_ARB_shader_draw_parameters
+		bool IndirectDrawEnabled = false;
 	public:
 		SceneRenderer();
 		virtual ~SceneRenderer() = default;
@@ -154,21 +173,29 @@ namespace Aurora
 			}
 		}
 
+		// Gathers world bounds of all mesh components in parallel, call once per frame before PrepareVisibleEntities(scene)
+		void PrepareCulling(Scene* scene);
 		void PrepareMeshComponent(MeshComponent* scene, CameraComponent* camera, const FFrustum& frustum);
 		void PrepareVisibleEntities(Scene* scene, CameraComponent* camera, const FFrustum& frustum);
 		void PrepareVisibleEntities(Actor* actor, CameraComponent* camera, const FFrustum& frustum);
 		void FillRenderSet(RenderSet& renderSet, int numberOfPasses, ...);
 
 		virtual void Render(Scene* scene, CameraComponent* debugCamera = nullptr) = 0;
-		void RenderPass(PassType_t pass, DrawCallState& drawCallState, CameraComponent* camera, const RenderSet& renderSet, bool drawInjected = true);
+		void RenderPass(PassType_t pass, DrawCallState& drawCallState, CameraComponent* camera, std::span<const ModelContext> renderSet, bool drawInjected = true);
+		// Static meshes are drawn with a multi draw indirect per material, the rest of the set is drawn by RenderPass in order
+		void RenderPassIndirect(PassType_t pass, DrawCallState& drawCallState, CameraComponent* camera, std::span<const ModelContext> renderSet, bool drawInjected = true);
 
 		TemporalRenderTarget RenderBloom(const FViewPort& wp, const Texture_ptr& inputHDRRT);
 
 		const InputLayout_ptr& GetInputLayoutForMesh(Mesh* mesh);
 		PassRenderEventEmitter& GetPassEmitter(PassType_t passType) { return m_InjectedPasses[passType]; }
+		[[nodiscard]] const IndirectDrawBuilder& GetIndirectDrawBuilder() const { return m_IndirectDrawBuilder; }
 
 		BloomSettings& GetBloomSettings() { return m_BloomSettings; }
 		OutlineContext& GetOutlineContext() { return m_OutlineContext; }
 		[[nodiscard]] const OutlineContext& GetOutlineContext() const { return m_OutlineContext; }
+	private:
+		void AddVisibleMeshComponent(MeshComponent* meshComponent, const Matrix4& transform, const Vector3& cameraPosition);
+		uint64_t BuildSortKey(const VisibleEntity& visibleEntity, RenderSortType sortType, uint32_t passSlot);
 	};
 }
\ No newline at end of file
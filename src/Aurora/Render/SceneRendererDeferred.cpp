@@ -63,6 +63,9 @@ namespace Aurora
 
 	void SceneRendererDeferred::Render(Scene* scene, CameraComponent* debugCamera)
 	{
+		// Bounds are gathered once and culled for every camera and shadow cascade
+		PrepareCulling(scene);
+
 		for (CameraComponent* camera : scene->GetComponents<CameraComponent>())
 		{
 			CPU_DEBUG_SCOPE("RenderCamera");
@@ -105,8 +108,8 @@ namespace Aurora
 				GPU_DEBUG_SCOPE("AmbientPass");
 				CPU_DEBUG_SCOPE("AmbientPass");
 				DrawCallState drawCallState;
-				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
+				drawCallState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+				drawCallState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
 
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindTarget(0, albedoBuffer);
@@ -204,14 +207,14 @@ namespace Aurora
 				state.Shader = m_CompositeShader;
 				state.ViewPort = viewPort->ViewPort;
 				state.BindTarget(0, compositeRT);
-				state.BindTexture("AlbedoRT", albedoBuffer);
-				state.BindTexture("NormalsRT", normalsBuffer);
-				state.BindTexture("DepthRT", depthBuffer);
+				state.BindTexture("AlbedoRT"_HASH, albedoBuffer);
+				state.BindTexture("NormalsRT"_HASH, normalsBuffer);
+				state.BindTexture("DepthRT"_HASH, depthBuffer);
 
-				state.BindUniformBuffer("SkyLightStorage", m_SkyLightBuffer);
-				state.BindUniformBuffer("DirectionalLightStorage", m_DirLightsBuffer);
-				state.BindUniformBuffer("PointLightStorage", m_PointLightsBuffer);
-				state.BindUniformBuffer("CompositeDefaults", m_CompositeDefaultsBuffer);
+				state.BindUniformBuffer("SkyLightStorage"_HASH, m_SkyLightBuffer);
+				state.BindUniformBuffer("DirectionalLightStorage"_HASH, m_DirLightsBuffer);
+				state.BindUniformBuffer("PointLightStorage"_HASH, m_PointLightsBuffer);
+				state.BindUniformBuffer("CompositeDefaults"_HASH, m_CompositeDefaultsBuffer);
 
 				state.PrimitiveType = EPrimitiveType::TriangleStrip;
 				state.RasterState.CullMode = ECullMode::Back;
@@ -233,7 +236,7 @@ namespace Aurora
 				CPU_DEBUG_SCOPE("DebugShapes");
 				GPU_DEBUG_SCOPE("Debug Shapes");
 				DrawCallState drawState;
-				drawState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
+				drawState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
 
 				drawState.ClearDepthTarget = false;
 				drawState.ClearColorTarget = false;
@@ -294,8 +297,8 @@ namespace Aurora
 					{
 						GPU_DEBUG_SCOPE("DepthPass");
 						DrawCallState drawCallState;
-						drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-						drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
+						drawCallState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+						drawCallState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
 
 						drawCallState.ViewPort = viewPort->ViewPort;
 						drawCallState.ClearColorTarget = false;
@@ -313,9 +316,6 @@ namespace Aurora
 						GPU_DEBUG_SCOPE("PostPass");
 						CPU_DEBUG_SCOPE("Outline");
 
-						glEnable(GL_BLEND);
-						glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
 						OutlineGPUDesc outlineGpuDesc = {};
 						outlineGpuDesc.MainRTSize = (Vector2)viewPort->ViewPort;
 						outlineGpuDesc.InvMainRTSize = 1.0f / (Vector2)viewPort->ViewPort;
@@ -330,26 +330,32 @@ namespace Aurora
 						state.ViewPort = viewPort->ViewPort;
 						state.BindTarget(0, outlineRT);
 
-						state.BindTexture("SceneDepthRT", depthBuffer);
-						state.BindTexture("OutlineMaskDepthRT", outlineDepthRT);
-						state.BindTexture("StripeTexture", m_OutlineStripeTexture);
+						state.BindTexture("SceneDepthRT"_HASH, depthBuffer);
+						state.BindTexture("OutlineMaskDepthRT"_HASH, outlineDepthRT);
+						state.BindTexture("StripeTexture"_HASH, m_OutlineStripeTexture);
 
-						state.BindSampler("SceneDepthRT", Samplers::ClampClampNearestNearest);
-						state.BindSampler("OutlineMaskDepthRT", Samplers::ClampClampNearestNearest);
-						state.BindSampler("StripeTexture", Samplers::WrapWrapNearestNearest);
+						state.BindSampler("SceneDepthRT"_HASH, Samplers::ClampClampNearestNearest);
+						state.BindSampler("OutlineMaskDepthRT"_HASH, Samplers::ClampClampNearestNearest);
+						state.BindSampler("StripeTexture"_HASH, Samplers::WrapWrapNearestNearest);
 
-						state.BindUniformBuffer("OutlineGPUDesc", m_OutlineDescBuffer);
+						state.BindUniformBuffer("OutlineGPUDesc"_HASH, m_OutlineDescBuffer);
 
 						state.PrimitiveType = EPrimitiveType::TriangleStrip;
 						state.RasterState.CullMode = ECullMode::Back;
 						state.DepthStencilState.DepthEnable = false;
 
+						// Every outline set blends over the previous ones
+						state.BlendState.Enabled = true;
+						state.BlendState.SrcBlend = EBlendValue::SrcAlpha;
+						state.BlendState.DestBlend = EBlendValue::InvSrcAlpha;
+
 						state.ClearColorTarget = firstOutlineIteration;
 						state.ClearDepthTarget = false;
 
 						GEngine->GetRenderDevice()->Draw(state, {DrawArguments(4)}, true);
 
-						glDisable(GL_BLEND);
+						// Not every later draw binds a blend state of its own
+						GEngine->GetRenderDevice()->SetBlendState(FBlendState());
 
 						firstOutlineIteration = false;
 					}
@@ -367,17 +373,17 @@ namespace Aurora
 				state.Shader = outlineRT.Empty() ? m_HDRCompositeShaderNoOutline : m_HDRCompositeShader;
 				state.ViewPort = viewPort->ViewPort;
 				state.BindTarget(0, viewPort->Target);
-				state.BindTexture("SceneHRDTexture", compositeRT);
-				state.BindTexture("BloomTexture", bloomRT);
+				state.BindTexture("SceneHRDTexture"_HASH, compositeRT);
+				state.BindTexture("BloomTexture"_HASH, bloomRT);
 				state.Uniforms.SetFloat("BloomIntensity"_HASH, m_BloomSettings.Intensity);
 
 				if (!outlineRT.Empty())
 				{
-					state.BindTexture("OutlineTexture", outlineRT);
+					state.BindTexture("OutlineTexture"_HASH, outlineRT);
 				}
 
-				state.BindSampler("SceneHRDTexture", Samplers::ClampClampNearestNearest);
-				state.BindSampler("BloomTexture", Samplers::ClampClampLinearLinear);
+				state.BindSampler("SceneHRDTexture"_HASH, Samplers::ClampClampNearestNearest);
+				state.BindSampler("BloomTexture"_HASH, Samplers::ClampClampLinearLinear);
 
 				state.PrimitiveType = EPrimitiveType::TriangleStrip;
 				state.RasterState.CullMode = ECullMode::Back;
@@ -39,6 +39,9 @@ namespace Aurora
 
 	void SceneRendererDeferredNew::Render(Scene* scene, CameraComponent* debugCamera)
 	{
+		// Bounds are gathered once and culled for every camera and shadow cascade
+		PrepareCulling(scene);
+
 		for (CameraComponent* camera : scene->GetComponents<CameraComponent>())
 		{
 			CPU_DEBUG_SCOPE("RenderCamera");
@@ -98,8 +101,8 @@ namespace Aurora
 				CPU_DEBUG_SCOPE("AmbientPass");
 
 				DrawCallState drawState;
-				drawState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawState.BindUniformBuffer("Instances", m_InstancesBuffer);
+				drawState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+				drawState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
 
 				drawState.ViewPort = viewPort->ViewPort;
 				drawState.BindTarget(0, colorBuffer);
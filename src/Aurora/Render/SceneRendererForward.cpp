@@ -75,6 +75,9 @@ namespace Aurora
 
 	void SceneRendererForward::Render(Scene* scene, CameraComponent* debugCamera)
 	{
+		// Bounds are gathered once and culled for every camera and shadow cascade
+		PrepareCulling(scene);
+
 		for (CameraComponent* camera : scene->GetComponents<CameraComponent>())
 		{
 			CPU_DEBUG_SCOPE("RenderCamera");
@@ -155,16 +158,19 @@ namespace Aurora
 						globData.CameraDir = lightCamera->GetForwardVector();
 						GEngine->GetRenderDevice()->WriteBuffer(m_GlobDataBuffer, &globData);
 
-						drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-						drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-						drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
+						drawCallState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+						drawCallState.BindUniformBuffer("GLOB_Data"_HASH, m_GlobDataBuffer);
+						drawCallState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
 
 						drawCallState.ViewPort = FViewPort(dirLightComponent->Layers[layer].Resolution);
 
 						GEngine->GetRenderDevice()->BindRenderTargets(drawCallState);
 						GEngine->GetRenderDevice()->ClearRenderTargets(drawCallState);
 
-						RenderPass(Pass::Depth, drawCallState, lightCamera, modelContextsOpaque);
+						if (IndirectDrawEnabled)
+							RenderPassIndirect(Pass::Depth, drawCallState, lightCamera, modelContextsOpaque);
+						else
+							RenderPass(Pass::Depth, drawCallState, lightCamera, modelContextsOpaque);
 					});
 
 					/*for (int i = 0; i < dirLightComponent->ShadowMatrices.size(); ++i)
@@ -234,9 +240,9 @@ namespace Aurora
 				CPU_DEBUG_SCOPE("DepthPrePass");
 
 				DrawCallState drawCallState;
-				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-				drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
+				drawCallState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+				drawCallState.BindUniformBuffer("GLOB_Data"_HASH, m_GlobDataBuffer);
+				drawCallState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
 
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindDepthTarget(depthBuffer, 0, 0);
@@ -253,7 +259,10 @@ namespace Aurora
 				GEngine->GetRenderDevice()->BindRenderTargets(drawCallState);
 				GEngine->GetRenderDevice()->ClearRenderTargets(drawCallState);
 
-				RenderPass(Pass::Depth, drawCallState, camera, modelContextsOpaque);
+				if (IndirectDrawEnabled)
+					RenderPassIndirect(Pass::Depth, drawCallState, camera, modelContextsOpaque);
+				else
+					RenderPass(Pass::Depth, drawCallState, camera, modelContextsOpaque);
 			}
 
 			//if (!modelContextsOpaque.empty())
@@ -262,16 +271,16 @@ namespace Aurora
 				CPU_DEBUG_SCOPE("AmbientPass");
 
 				DrawCallState drawState;
-				drawState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-				drawState.BindUniformBuffer("Instances", m_InstancesBuffer);
+				drawState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+				drawState.BindUniformBuffer("GLOB_Data"_HASH, m_GlobDataBuffer);
+				drawState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
 
 				{ // Decals
-					drawState.BindTexture("g_DecalTexture", GEngine->GetResourceManager()->LoadTexture("Assets/Textures/decals_0003_1k_F6fzPK.png"));
-					drawState.BindSampler("g_DecalTexture", Samplers::ClampClampLinearLinear);
+					drawState.BindTexture("g_DecalTexture"_HASH, GEngine->GetResourceManager()->LoadTexture("Assets/Textures/decals_0003_1k_F6fzPK.png"));
+					drawState.BindSampler("g_DecalTexture"_HASH, Samplers::ClampClampLinearLinear);
 
-					drawState.BindUniformBuffer("GLOB_DecalMatricesVS", m_VSDecalBuffer);
-					drawState.BindUniformBuffer("GLOB_DecalMatricesPS", m_PSDecalBuffer);
+					drawState.BindUniformBuffer("GLOB_DecalMatricesVS"_HASH, m_VSDecalBuffer);
+					drawState.BindUniformBuffer("GLOB_DecalMatricesPS"_HASH, m_PSDecalBuffer);
 
 					Matrix4 scale = glm::translate(Vector3(0.5f)) * glm::scale(Vector3(0.5f / 1.0f));
 					uint i = 0;
@@ -279,7 +288,7 @@ namespace Aurora
 					GLOB_DecalMatricesVS vsDecalData = {};
 					GLOB_DecalMatricesPS psDecalData = {};
 
-					for (DecalComponent* decalComponent : AppContext::GetScene()->GetComponents<DecalComponent>())
+					for (DecalComponent* decalComponent : scene->GetComponents<DecalComponent>())
 					{
 						const Transform& decalTransform = decalComponent->GetTransform();
 						Matrix4 rawDecalMatrix = decalTransform.GetTransform();
@@ -303,8 +312,8 @@ namespace Aurora
 					if (dirLight->CastShadows())
 					{
 						drawState.Uniforms.SetMat4Array("ShadowmapMatrix"_HASH, dirLight->ShadowMatrices);
-						drawState.BindTexture("g_ShadowmapTexture", dirLight->RenderTexture);
-						drawState.BindSampler("g_ShadowmapTexture", Samplers::LinearShadowCompare);
+						drawState.BindTexture("g_ShadowmapTexture"_HASH, dirLight->RenderTexture);
+						drawState.BindSampler("g_ShadowmapTexture"_HASH, Samplers::LinearShadowCompare);
 					}
 
 					drawState.Uniforms.SetVec3("LightDir"_HASH, glm::normalize(dirLight->GetForwardVector()));
@@ -330,7 +339,10 @@ namespace Aurora
 				GEngine->GetRenderDevice()->BindRenderTargets(drawState);
 				GEngine->GetRenderDevice()->ClearRenderTargets(drawState);
 
-				RenderPass(Pass::Ambient, drawState, camera, modelContextsOpaque);
+				if (IndirectDrawEnabled)
+					RenderPassIndirect(Pass::Ambient, drawState, camera, modelContextsOpaque);
+				else
+					RenderPass(Pass::Ambient, drawState, camera, modelContextsOpaque);
 			}
 
 			if (!skyModelContexts.empty())
@@ -339,9 +351,9 @@ namespace Aurora
 				CPU_DEBUG_SCOPE("SkyPass");
 
 				DrawCallState drawCallState;
-				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-				drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
+				drawCallState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+				drawCallState.BindUniformBuffer("GLOB_Data"_HASH, m_GlobDataBuffer);
+				drawCallState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
 
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindTarget(0, hrdColorBuffer);
@@ -361,8 +373,8 @@ namespace Aurora
 			{ // Particles
 				DrawCallState drawCallState;
 				drawCallState.Shader = m_ParticleRenderShader;
-				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
+				drawCallState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+				drawCallState.BindUniformBuffer("GLOB_Data"_HASH, m_GlobDataBuffer);
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindTarget(0, hrdColorBuffer);
 				drawCallState.BindDepthTarget(depthBuffer, 0, 0);
@@ -381,7 +393,7 @@ namespace Aurora
 				dispatchState.Shader = m_ParticleComputeShader;
 				for (ParticleSystemComponent* particleSystemComponent : scene->GetComponents<ParticleSystemComponent>())
 				{
-					dispatchState.BindSSBOBuffer("Pos", particleSystemComponent->m_GPUPosBuffer);
+					dispatchState.BindSSBOBuffer("Pos"_HASH, particleSystemComponent->m_GPUPosBuffer);
 					dispatchState.Uniforms.SetUInt("ParticleCount"_HASH, particleSystemComponent->m_CurrentParticles);
 					GEngine->GetRenderDevice()->Dispatch(dispatchState, (particleSystemComponent->m_CurrentParticles / 128) + 1, 1, 1);
 
@@ -398,9 +410,9 @@ namespace Aurora
 				CPU_DEBUG_SCOPE("TranslucentPass");
 
 				DrawCallState drawCallState;
-				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-				drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
+				drawCallState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+				drawCallState.BindUniformBuffer("GLOB_Data"_HASH, m_GlobDataBuffer);
+				drawCallState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
 
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindTarget(0, hrdColorBuffer);
@@ -421,8 +433,8 @@ namespace Aurora
 				CPU_DEBUG_SCOPE("DebugShapes");
 				GPU_DEBUG_SCOPE("Debug Shapes");
 				DrawCallState drawState;
-				drawState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
+				drawState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+				drawState.BindUniformBuffer("GLOB_Data"_HASH, m_GlobDataBuffer);
 
 				drawState.ClearDepthTarget = false;
 				drawState.ClearColorTarget = false;
@@ -448,9 +460,9 @@ namespace Aurora
 				CPU_DEBUG_SCOPE("OverlayPass");
 
 				DrawCallState drawCallState;
-				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-				drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
+				drawCallState.BindUniformBuffer("BaseVSData"_HASH, m_BaseVsDataBuffer);
+				drawCallState.BindUniformBuffer("GLOB_Data"_HASH, m_GlobDataBuffer);
+				drawCallState.BindUniformBuffer("Instances"_HASH, m_InstancesBuffer);
 
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindTarget(0, hrdColorBuffer);
@@ -507,12 +519,12 @@ namespace Aurora
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindTarget(0, viewPort->Target);
 
-				drawCallState.BindTexture("_FinalColor", hrdColorBuffer);
+				drawCallState.BindTexture("_FinalColor"_HASH, hrdColorBuffer);
 
 				if (enabledBloom)
 				{
-					drawCallState.BindTexture("_FinalBloom", bloomFinal);
-					drawCallState.BindSampler("_FinalBloom", Samplers::ClampClampLinearLinear);
+					drawCallState.BindTexture("_FinalBloom"_HASH, bloomFinal);
+					drawCallState.BindSampler("_FinalBloom"_HASH, Samplers::ClampClampLinearLinear);
 				}
 
 				{ // ToneMap uniform set
@@ -523,8 +535,8 @@ namespace Aurora
 						float scale = (float)(lutWidth - 1) / (float)lutWidth;
 						float offset = 0.5f / (float)lutWidth;
 						drawCallState.Uniforms.SetVec2("u_LutToneMapData"_HASH, Vector2(scale, offset));
-						drawCallState.BindTexture("_LutTarget", ToneMapSettings.LutTexture);
-						drawCallState.BindSampler("_LutTarget", Samplers::ClampClampLinearLinear);
+						drawCallState.BindTexture("_LutTarget"_HASH, ToneMapSettings.LutTexture);
+						drawCallState.BindSampler("_LutTarget"_HASH, Samplers::ClampClampLinearLinear);
 					}
 
 					drawCallState.Uniforms.SetBool("u_BasicToneMapEnabled"_HASH, ToneMapSettings.BasicToneMapEnabled);
@@ -1,11 +1,15 @@
 #include "AssetBank.hpp"
 
-#include <iostream>
+#include <atomic>
 #include <cstring>
 #include <fstream>
-#include <map>
+#include <algorithm>
 
 #include "Aurora/Core/FileSystem.hpp"
+#include "Aurora/Core/Hash.hpp"
+#include "Aurora/Core/JobSystem.hpp"
+#include "Aurora/Memory/Aum.hpp"
+#include "Aurora/Logger/Logger.hpp"
 
 namespace Aurora
 {
@@ -19,111 +23,480 @@ namespace Aurora
 		return p.lexically_relative(*p.begin());
 	}
 
-	bool AssetBank::CreatePackage(const Path &baseFolderPath, const Path& outputFilePath)
+	static bool CompareEntries(const ABankEntry& left, const ABankEntry& right, const char* stringPool)
 	{
-		std::fstream fileStream;
-		fileStream.open(outputFilePath, std::ios::out | std::ios::binary);
+		if (left.NameHash != right.NameHash)
+			return left.NameHash < right.NameHash;
 
+		return std::string_view(stringPool + left.NameOffset, left.NameLength) < std::string_view(stringPool + right.NameOffset, right.NameLength);
+	}
+
+	// Formats with their own compression, compressing them again only costs load time
+	static const char* PreCompressedExtensions[] = {
+		".png",
+		".jpg",
+		".jpeg",
+		".ogg",
+		".mp3",
+		".woff",
+		".woff2",
+		".zip",
+		".abank"
+	};
+
+	// Read in place from the mapped package at runtime, so they are always stored uncompressed
+	static const char* MappedExtensions[] = {
+		".atex"
+	};
+
+	static const char* TextExtensions[] = {
+		".fss",
+		".vss",
+		".glsl",
+		".vert",
+		".frag",
+		".geom",
+		".comp",
+		".h",
+		".json",
+		".matd",
+		".mat",
+		".meta",
+		".cubemap",
+		".rml",
+		".rcss",
+		".lua",
+		".ini",
+		".txt"
+	};
+
+	// Files to pack at once, the next window is compressed while the current one is written
+	static constexpr uint32_t PackWindowFilesPerThread = 4;
+
+	// Compression has to save at least 1/16 of the size, otherwise reading the raw bytes is cheaper
+	static constexpr uint64_t MinCompressionSavingShift = 4;
+
+	struct PackedFile
+	{
+		// Bytes as stored in the package
+		DataBlob Data;
+		uint64_t Size = 0;
+		ECompressionCodec Compression = ECompressionCodec::None;
+	};
+
+	CompressionSettings AssetBank::GetCompressionSettings(const Path& path)
+	{
+		Path extension = path.extension();
+
+		for (const auto& item : PreCompressedExtensions)
+		{
+			if (item == extension)
+			{
+				return {ECompressionCodec::None, 0};
+			}
+		}
+
+		for (const auto& item : MappedExtensions)
+		{
+			if (item == extension)
+			{
+				return {ECompressionCodec::None, 0};
+			}
+		}
+
+		for (const auto& item : TextExtensions)
+		{
+			if (item == extension)
+			{
+				return {ECompressionCodec::Zstd, 12};
+			}
+		}
+
+		// Meshes and other binary data are the bulk of a package, they get the codec that decodes fastest
+		return {ECompressionCodec::LZ4, 9};
+	}
+
+	static void PackFile(const Path& path, PackedFile& packed)
+	{
+		DataBlob fileData = FS::LoadFile(path);
+		packed.Size = fileData.size();
+		packed.Compression = ECompressionCodec::None;
+
+		CompressionSettings settings = AssetBank::GetCompressionSettings(path);
+
+		if (settings.Codec != ECompressionCodec::None && !fileData.empty())
+		{
+			DataBlob compressed(Compression::GetCompressBound(settings.Codec, fileData.size()));
+			size_t compressedSize = compressed.empty() ? 0 : Compression::Compress(settings, fileData, compressed);
+
+			if (compressedSize > 0 && compressedSize < fileData.size() - (fileData.size() >> MinCompressionSavingShift))
+			{
+				compressed.resize(compressedSize);
+				packed.Data = std::move(compressed);
+				packed.Compression = settings.Codec;
+				return;
+			}
+		}
+
+		packed.Data = std::move(fileData);
+	}
+
+	bool AssetBank::CreatePackage(const Path &baseFolderPath, const Path& outputFilePath, JobSystem* jobSystem)
+	{
 		std::vector<Path> files = FS::ListFiles(baseFolderPath, true);
-		int32_t fileCount = files.size();
-		int32_t headerBeginPos = sizeof(int32_t);
-		int32_t currentOffset = headerBeginPos + (sizeof(ABankHeader) * fileCount);
-		auto* headers = new ABankHeader[fileCount];
+		// Directory iteration order is not defined, sorting keeps the package the same between builds
+		std::sort(files.begin(), files.end());
+
+		std::vector<ABankEntry> entries(files.size());
+		String stringPool;
+
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			String name = StripFirstDir(files[i]).generic_string();
+
+			ABankEntry& entry = entries[i];
+			entry.NameHash = Hash_FNV1a64(name);
+			entry.NameOffset = (uint32_t)stringPool.size();
+			entry.NameLength = (uint32_t)name.size();
+			entry.CompressedSize = 0;
+			entry.Compression = ECompressionCodec::None;
+			entry.Reserved = 0;
+			stringPool += name;
+		}
 
-		fileStream.write(reinterpret_cast<char*>(&fileCount), sizeof(int32_t));
+		ABankPackageHeader header = {};
+		header.Magic = ABANK_MAGIC;
+		header.Version = ABANK_VERSION;
+		header.EntryCount = (uint32_t)entries.size();
+		header.PageSize = ABANK_PAGE_SIZE;
+		header.EntriesOffset = sizeof(ABankPackageHeader);
+		header.StringPoolOffset = header.EntriesOffset + sizeof(ABankEntry) * entries.size();
+		header.StringPoolSize = stringPool.size();
+
+		std::ofstream fileStream(outputFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (!fileStream.is_open())
+		{
+			AU_LOG_ERROR("Cannot create package ", outputFilePath.string());
+			return false;
+		}
+
+		auto writeZeros = [&fileStream](uint64_t size)
+		{
+			static const char zeroPage[ABANK_PAGE_SIZE] = {};
+
+			while (size > 0)
+			{
+				uint64_t chunk = std::min<uint64_t>(size, ABANK_PAGE_SIZE);
+				fileStream.write(zeroPage, (std::streamsize)chunk);
+				size -= chunk;
+			}
+		};
+
+		// Placeholder for the tables, they are written after the file offsets are known
+		uint64_t currentOffset = header.StringPoolOffset + header.StringPoolSize;
+		writeZeros(currentOffset);
+
+		uint32_t windowSize = jobSystem ? (jobSystem->GetWorkerCount() + 1) * PackWindowFilesPerThread : 1;
+		std::vector<PackedFile> windows[2] = {std::vector<PackedFile>(windowSize), std::vector<PackedFile>(windowSize)};
+		JobCounter windowCounters[2];
+
+		auto packWindow = [&](size_t first, uint32_t window)
+		{
+			size_t count = std::min<size_t>(windowSize, files.size() - first);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Path* file = &files[first + i];
+				PackedFile* packed = &windows[window][i];
+
+				if (jobSystem)
+					jobSystem->Schedule([file, packed]() { PackFile(*file, *packed); }, &windowCounters[window]);
+				else
+					PackFile(*file, *packed);
+			}
+		};
+
+		if (!files.empty())
+			packWindow(0, 0);
+
+		// Files are always written in the sorted order, so the output does not depend on which job finished first
+		uint32_t window = 0;
+		for (size_t first = 0; first < files.size(); first += windowSize, window ^= 1)
+		{
+			if (jobSystem)
+				jobSystem->Wait(windowCounters[window]);
+
+			if (first + windowSize < files.size())
+				packWindow(first + windowSize, window ^ 1);
 
-		fileStream.seekp(currentOffset, std::ios::beg);
-		for (int i = 0; i < files.size(); ++i) {
-			Path& filePath = files[i];
+			size_t count = std::min<size_t>(windowSize, files.size() - first);
 
-			ABankHeader& header = headers[i];
-			header.CompressedSize = 0;
-			header.Offset = currentOffset;
-			strcpy(header.Filename, StripFirstDir(filePath).string().c_str());
+			for (size_t i = 0; i < count; ++i)
+			{
+				uint64_t alignedOffset = Align(currentOffset, ABANK_PAGE_SIZE);
+				writeZeros(alignedOffset - currentOffset);
+				currentOffset = alignedOffset;
 
-			// TODO: Compression
-			// https://github.com/lz4/lz4
+				PackedFile& packed = windows[window][i];
 
-			auto fileData = FS::LoadFile(filePath);
+				ABankEntry& entry = entries[first + i];
+				entry.Offset = currentOffset;
+				entry.Size = packed.Size;
+				entry.CompressedSize = packed.Compression != ECompressionCodec::None ? packed.Data.size() : 0;
+				entry.Compression = packed.Compression;
 
-			header.Size = fileData.size();
-			fileStream.write(reinterpret_cast<char*>(fileData.data()), fileData.size());
-			currentOffset += fileData.size();
+				fileStream.write(reinterpret_cast<const char*>(packed.Data.data()), (std::streamsize)packed.Data.size());
+				currentOffset += packed.Data.size();
+
+				packed.Data = {};
+			}
 		}
 
-		fileStream.seekp(headerBeginPos, std::ios::beg);
-		fileStream.write(reinterpret_cast<char*>(headers), sizeof(ABankHeader) * fileCount);
+		std::sort(entries.begin(), entries.end(), [&stringPool](const ABankEntry& left, const ABankEntry& right)
+		{
+			return CompareEntries(left, right, stringPool.data());
+		});
 
-		fileStream.close();
-		return true;
+		fileStream.seekp(0, std::ios::beg);
+		fileStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		fileStream.write(reinterpret_cast<const char*>(entries.data()), (std::streamsize)(sizeof(ABankEntry) * entries.size()));
+		fileStream.write(stringPool.data(), (std::streamsize)stringPool.size());
+
+		return fileStream.good();
 	}
 
-	std::map<Path, ABankHeader> AssetBank::ReadHeadersFromPackage(const Path &packageFile)
+	std::map<Path, DataBlob> AssetBank::ReadAllFilesFromPackage(const Path &packageFile, JobSystem* jobSystem)
 	{
-		std::map<Path, ABankHeader> fileHeaders;
+		std::map<Path, DataBlob> fileMap;
 
-		std::ifstream file(packageFile, std::ios::in | std::ios::binary);
+		AssetPackage package;
 
-		if (file.is_open()) {
-			int32_t fileCount;
-			file.read(reinterpret_cast<char*>(&fileCount), sizeof(int32_t));
+		if (!package.Open(packageFile))
+			return fileMap;
 
-			for (int i = 0; i < fileCount; ++i) {
-				ABankHeader header = {};
-				file.read(reinterpret_cast<char*>(&header), sizeof(header));
-				fileHeaders[std::string(header.Filename)] = header;
-			}
+		std::vector<const ABankEntry*> entries;
+		for (const ABankEntry& entry : package.GetEntries())
+			entries.push_back(&entry);
 
-			file.close();
+		std::vector<DataBlob> files(entries.size());
+		package.ReadFiles(entries, files, jobSystem);
+
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			fileMap[Path(package.GetName(*entries[i]))] = std::move(files[i]);
 		}
 
-		return fileHeaders;
+		return fileMap;
 	}
 
-	DataBlob AssetBank::ReadFileFromPackage(const Path &packageFile, const ABankHeader &header)
+	bool AssetPackage::Open(const Path& path)
 	{
-		std::ifstream file(packageFile, std::ios::in | std::ios::binary);
+		m_Path = path;
+
+		if (!m_File.Open(path))
+		{
+			AU_LOG_ERROR("Cannot open package ", path.string());
+			return false;
+		}
 
-		if (file.is_open()) {
-			DataBlob fileData(header.CompressedSize > 0 ? header.CompressedSize : header.Size);
+		uint32_t magic = 0;
+		if (m_File.GetSize() >= sizeof(magic))
+			std::memcpy(&magic, m_File.GetData(), sizeof(magic));
 
-			file.seekg(header.Offset, std::ios::beg);
-			file.read(reinterpret_cast<char*>(fileData.data()), fileData.size());
+		bool valid = magic == ABANK_MAGIC ? ReadHashedPackage() : ReadVersion1();
 
-			file.close();
-			return fileData;
+		if (!valid)
+		{
+			AU_LOG_ERROR("Package ", path.string(), " is corrupted or has unsupported version");
+			m_File.Close();
+			m_Entries = nullptr;
+			m_EntryCount = 0;
+			m_StringPool = nullptr;
+			return false;
 		}
 
-		return {};
+		return true;
 	}
 
-	std::map<Path, DataBlob> AssetBank::ReadAllFilesFromPackage(const Path &packageFile)
+	bool AssetPackage::ReadVersion1()
 	{
-		std::map<Path, DataBlob> fileMap;
+		int32_t fileCount = 0;
+		std::span<const uint8_t> countData = m_File.GetSpan(0, sizeof(fileCount));
 
-		std::ifstream file(packageFile, std::ios::in | std::ios::binary);
+		if (countData.empty())
+			return false;
 
-		if (file.is_open()) {
-			std::vector<ABankHeader> headers;
-			int32_t fileCount;
-			file.read(reinterpret_cast<char*>(&fileCount), sizeof(int32_t));
+		std::memcpy(&fileCount, countData.data(), sizeof(fileCount));
 
-			for (int i = 0; i < fileCount; ++i) {
-				ABankHeader header = {};
-				file.read(reinterpret_cast<char*>(&header), sizeof(header));
-				headers.emplace_back(header);
+		if (fileCount < 0 || m_File.GetSpan(sizeof(fileCount), sizeof(ABankHeader) * (uint64_t)fileCount).size() != sizeof(ABankHeader) * (uint64_t)fileCount)
+			return false;
+
+		m_OwnedEntries.resize(fileCount);
+		m_OwnedStringPool.clear();
+
+		const uint8_t* headerData = m_File.GetData() + sizeof(fileCount);
+
+		for (int32_t i = 0; i < fileCount; ++i)
+		{
+			ABankHeader header;
+			std::memcpy(&header, headerData + sizeof(ABankHeader) * i, sizeof(ABankHeader));
+
+			String name(header.Filename, strnlen(header.Filename, sizeof(header.Filename)));
+			std::replace(name.begin(), name.end(), '\\', '/');
+
+			ABankEntry& entry = m_OwnedEntries[i];
+			entry.NameHash = Hash_FNV1a64(name);
+			entry.NameOffset = (uint32_t)m_OwnedStringPool.size();
+			entry.NameLength = (uint32_t)name.size();
+			entry.Offset = header.Offset;
+			entry.Size = header.Size;
+			entry.CompressedSize = header.CompressedSize;
+			entry.Compression = ECompressionCodec::None;
+			entry.Reserved = 0;
+			m_OwnedStringPool += name;
+		}
+
+		std::sort(m_OwnedEntries.begin(), m_OwnedEntries.end(), [this](const ABankEntry& left, const ABankEntry& right)
+		{
+			return CompareEntries(left, right, m_OwnedStringPool.data());
+		});
+
+		m_Version = 1;
+		m_Entries = m_OwnedEntries.data();
+		m_EntryCount = (uint32_t)m_OwnedEntries.size();
+		m_StringPool = m_OwnedStringPool.data();
+
+		for (const ABankEntry& entry : m_OwnedEntries)
+		{
+			if (GetData(entry).size() != (entry.CompressedSize > 0 ? entry.CompressedSize : entry.Size))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool AssetPackage::ReadHashedPackage()
+	{
+		ABankPackageHeader header;
+		std::span<const uint8_t> headerData = m_File.GetSpan(0, sizeof(header));
+
+		if (headerData.empty())
+			return false;
+
+		std::memcpy(&header, headerData.data(), sizeof(header));
+
+		if (header.Version < 2 || header.Version > ABANK_VERSION)
+			return false;
+
+		size_t entrySize = header.Version == 2 ? ABANK_V2_ENTRY_SIZE : sizeof(ABankEntry);
+		uint64_t entriesSize = entrySize * (uint64_t)header.EntryCount;
+		std::span<const uint8_t> entryData = m_File.GetSpan(header.EntriesOffset, entriesSize);
+		std::span<const uint8_t> stringPool = m_File.GetSpan(header.StringPoolOffset, header.StringPoolSize);
+
+		if (entryData.size() != entriesSize || stringPool.size() != header.StringPoolSize || header.EntriesOffset % alignof(ABankEntry) != 0)
+			return false;
+
+		m_Version = header.Version;
+		m_EntryCount = header.EntryCount;
+		m_StringPool = reinterpret_cast<const char*>(stringPool.data());
+
+		if (header.Version == 2)
+		{
+			// Version 2 entries are a prefix of the current ones
+			m_OwnedEntries.resize(header.EntryCount);
+
+			for (uint32_t i = 0; i < header.EntryCount; ++i)
+			{
+				ABankEntry& entry = m_OwnedEntries[i];
+				std::memcpy(&entry, entryData.data() + ABANK_V2_ENTRY_SIZE * i, ABANK_V2_ENTRY_SIZE);
+				entry.Compression = ECompressionCodec::None;
+				entry.Reserved = 0;
 			}
 
-			for(const ABankHeader& header : headers) {
-				DataBlob fileData(header.CompressedSize > 0 ? header.CompressedSize : header.Size);
-				file.seekg(header.Offset, std::ios::beg);
-				file.read(reinterpret_cast<char*>(fileData.data()), fileData.size());
-				fileMap[std::string(header.Filename)] = fileData;
+			m_Entries = m_OwnedEntries.data();
+		}
+		else
+		{
+			// The tables are used in place, straight from the mapped file
+			m_Entries = reinterpret_cast<const ABankEntry*>(entryData.data());
+		}
+
+		for (const ABankEntry& entry : GetEntries())
+		{
+			if ((uint64_t)entry.NameOffset + entry.NameLength > header.StringPoolSize)
+				return false;
+
+			if (entry.Compression > ECompressionCodec::Zstd || (entry.Compression != ECompressionCodec::None && entry.CompressedSize == 0))
+				return false;
+
+			if (GetData(entry).size() != (entry.CompressedSize > 0 ? entry.CompressedSize : entry.Size))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool AssetPackage::ReadFile(const ABankEntry& entry, DataBlob& data) const
+	{
+		std::span<const uint8_t> storedData = GetData(entry);
+
+		if (entry.Compression == ECompressionCodec::None)
+		{
+			data.assign(storedData.begin(), storedData.end());
+			return true;
+		}
+
+		data.resize(entry.Size);
+
+		if (Compression::Decompress(entry.Compression, storedData, data))
+			return true;
+
+		AU_LOG_ERROR("Cannot decompress ", GetName(entry), " from package ", m_Path.string());
+		data.clear();
+		return false;
+	}
+
+	bool AssetPackage::ReadFiles(std::span<const ABankEntry* const> entries, std::span<DataBlob> data, JobSystem* jobSystem) const
+	{
+		if (entries.size() != data.size())
+			return false;
+
+		std::atomic<bool> success = true;
+
+		auto readFiles = [this, &entries, &data, &success](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				if (!ReadFile(*entries[i], data[i]))
+					success.store(false, std::memory_order_relaxed);
 			}
+		};
+
+		if (jobSystem)
+			jobSystem->ParallelFor((uint32_t)entries.size(), 4, readFiles);
+		else
+			readFiles(0, (uint32_t)entries.size());
+
+		return success.load();
+	}
 
-			file.close();
+	const ABankEntry* AssetPackage::Find(std::string_view name) const
+	{
+		uint64_t hash = Hash_FNV1a64(name);
+
+		const ABankEntry* end = m_Entries + m_EntryCount;
+		const ABankEntry* it = std::lower_bound(m_Entries, end, hash, [](const ABankEntry& entry, uint64_t value)
+		{
+			return entry.NameHash < value;
+		});
+
+		for (; it != end && it->NameHash == hash; ++it)
+		{
+			if (GetName(*it) == name)
+				return it;
 		}
 
-		return fileMap;
+		return nullptr;
 	}
-}
\ No newline at end of file
+}
@@ -1,10 +1,18 @@
 #pragma once
 
 #include <map>
+#include <span>
+#include <string_view>
 #include "Aurora/Core/Types.hpp"
+#include "Aurora/Core/String.hpp"
+#include "Aurora/Core/MemoryMappedFile.hpp"
+#include "Aurora/Core/Compression.hpp"
 
 namespace Aurora
 {
+	class JobSystem;
+
+	// Version 1 package: int32 file count, the headers and then the file data
 	struct ABankHeader
 	{
 		char Filename[256];
@@ -13,14 +21,103 @@ namespace Aurora
 		uint32_t CompressedSize;
 	};
 
+	static constexpr uint32_t ABANK_MAGIC = 0x4B4E4241; // "ABNK"
+	static constexpr uint32_t ABANK_VERSION = 3;
+	static constexpr uint32_t ABANK_PAGE_SIZE = 4096;
+
+	// Version 2 and 3 package: this header, the entries sorted by name hash, the name string pool
+	// and then the file data, every file starts on a page boundary
+	struct ABankPackageHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t EntryCount;
+		uint32_t PageSize;
+		uint64_t EntriesOffset;
+		uint64_t StringPoolOffset;
+		uint64_t StringPoolSize;
+	};
+
+	struct ABankEntry
+	{
+		// Hash_FNV1a64 of the name
+		uint64_t NameHash;
+		uint64_t Offset;
+		uint64_t Size;
+		// 0 when the file is stored uncompressed
+		uint64_t CompressedSize;
+		// Name inside of the string pool, not null terminated
+		uint32_t NameOffset;
+		uint32_t NameLength;
+		// Added in version 3, version 2 entries end here and are never compressed
+		ECompressionCodec Compression;
+		uint32_t Reserved;
+	};
+
+	static_assert(sizeof(ABankPackageHeader) == 40);
+	static_assert(sizeof(ABankEntry) == 48);
+	static constexpr size_t ABANK_V2_ENTRY_SIZE = 40;
+
+	// Opened package file. The file stays mapped for the lifetime of the package,
+	// so the data views it hands out do not need any reads or copies.
+	// Version 1 packages are mapped too, only their headers are converted into entries on open.
+	class AU_API AssetPackage
+	{
+	private:
+		Path m_Path;
+		MemoryMappedFile m_File;
+		uint32_t m_Version = 0;
+
+		const ABankEntry* m_Entries = nullptr;
+		uint32_t m_EntryCount = 0;
+		const char* m_StringPool = nullptr;
+
+		// Converted version 1 headers and version 2 entries
+		std::vector<ABankEntry> m_OwnedEntries;
+		String m_OwnedStringPool;
+	public:
+		AssetPackage() = default;
+
+		AssetPackage(const AssetPackage&) = delete;
+		AssetPackage& operator=(const AssetPackage&) = delete;
+
+		bool Open(const Path& path);
+
+		[[nodiscard]] const Path& GetPath() const { return m_Path; }
+		[[nodiscard]] uint32_t GetVersion() const { return m_Version; }
+		[[nodiscard]] std::span<const ABankEntry> GetEntries() const { return {m_Entries, m_EntryCount}; }
+
+		// Names use forward slashes
+		[[nodiscard]] const ABankEntry* Find(std::string_view name) const;
+		[[nodiscard]] std::string_view GetName(const ABankEntry& entry) const { return {m_StringPool + entry.NameOffset, entry.NameLength}; }
+
+		// Stored bytes of the entry, valid as long as the package is alive. These are the compressed bytes for compressed entries.
+		[[nodiscard]] std::span<const uint8_t> GetData(const ABankEntry& entry) const
+		{
+			return m_File.GetSpan(entry.Offset, entry.CompressedSize > 0 ? entry.CompressedSize : entry.Size);
+		}
+
+		// Uncompressed file content
+		bool ReadFile(const ABankEntry& entry, DataBlob& data) const;
+		// Same as ReadFile for every entry, decompressed in parallel when a job system is given
+		bool ReadFiles(std::span<const ABankEntry* const> entries, std::span<DataBlob> data, JobSystem* jobSystem = nullptr) const;
+	private:
+		bool ReadVersion1();
+		// Version 2 and later
+		bool ReadHashedPackage();
+	};
+
 	class AU_API AssetBank
 	{
 	private:
 
 	public:
-		static bool CreatePackage(const Path& baseFolderPath, const Path& outputFilePath);
-		static std::map<Path, ABankHeader> ReadHeadersFromPackage(const Path& packageFile);
-		static DataBlob ReadFileFromPackage(const Path& packageFile, const ABankHeader& header);
-		static std::map<Path, DataBlob> ReadAllFilesFromPackage(const Path& packageFile);
+		// Writes a package in the latest version, files are compressed in parallel when a job system is given.
+		// The output is the same no matter how many threads were used.
+		static bool CreatePackage(const Path& baseFolderPath, const Path& outputFilePath, JobSystem* jobSystem = nullptr);
+		static std::map<Path, DataBlob> ReadAllFilesFromPackage(const Path& packageFile, JobSystem* jobSystem = nullptr);
+
+		// Codec and level picked for a file by its extension
+		static CompressionSettings GetCompressionSettings(const Path& path);
 	};
 }
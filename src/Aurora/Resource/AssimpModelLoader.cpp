@@ -11,6 +11,7 @@
 #include <stb_image_resize.h>
 
 #include "Aurora/Engine.hpp"
+#include "Aurora/Core/JobSystem.hpp"
 #include "Aurora/Graphics/Base/IRenderDevice.hpp"
 
 namespace Aurora
@@ -34,106 +35,157 @@ namespace Aurora
 	inline Matrix4 mat4_cast(const aiMatrix4x4 &m) { return glm::transpose(glm::make_mat4(&m.a1)); }
 	inline Matrix4 mat4_cast(const aiMatrix3x3 &m) { return glm::transpose(glm::make_mat3(&m.a1)); }
 
-	void ProcessStaticMesh(const Mesh_ptr& meshBase, const aiMesh* sourceMesh, const Matrix4& transform, LOD lod, const MeshImportOptions& importOptions, int32_t materialIndex)
+	// One source mesh of the scene. Offsets and bones are assigned in scene order, the vertices are then converted in parallel.
+	struct MeshImportTask
 	{
-		StaticMesh_ptr mesh = StaticMesh::Cast(meshBase);
+		Mesh_ptr Mesh;
+		const aiMesh* SourceMesh;
+		Matrix4 Transform;
+		LOD Lod;
+		int32_t MaterialIndex;
+
+		size_t FirstVertex = 0;
+		size_t FirstIndex = 0;
+		// Armature bone of every bone of the source mesh
+		std::vector<int32_t> BoneIndices;
+
+		// Set once every task is reserved, the buffers do not grow after that
+		void* Vertices = nullptr;
+		Index_t* Indices = nullptr;
+	};
+
+	template<typename Vertex, typename MeshType>
+	void ReserveMeshData(MeshType& mesh, MeshImportTask& task)
+	{
+		const aiMesh* sourceMesh = task.SourceMesh;
+
+		MeshLodResource* lodResource;
+		VertexBuffer<Vertex>* buffer = mesh.template CreateVertexBuffer<Vertex>(task.Lod, &lodResource);
 
-		auto& indices = mesh->LODResources[lod].Indices;
-		auto* buffer = mesh->GetVertexBuffer<StaticMesh::Vertex>(lod);
+		task.FirstVertex = buffer->GetCount();
+		task.FirstIndex = lodResource->Indices.size();
+
+		buffer->Resize(task.FirstVertex + sourceMesh->mNumVertices);
+		lodResource->Indices.resize(task.FirstIndex + sourceMesh->mNumFaces * 3);
 
 		FMeshSection section;
-		section.MaterialIndex = materialIndex;
+		section.MaterialIndex = task.MaterialIndex;
+		section.FirstIndex = task.FirstIndex;
+		section.NumTriangles = sourceMesh->mNumFaces * 3;
+		lodResource->Sections.emplace_back(section);
+	}
 
-		size_t lastVertex = buffer->GetCount();
+	template<typename Vertex, typename MeshType>
+	void ResolveMeshData(MeshType& mesh, MeshImportTask& task)
+	{
+		task.Vertices = mesh.template GetVertexBuffer<Vertex>(task.Lod)->GetElements() + task.FirstVertex;
+		task.Indices = mesh.LODResources[task.Lod].Indices.data() + task.FirstIndex;
+	}
 
-		for (uint vertIdx = 0u; vertIdx < sourceMesh->mNumVertices; vertIdx++)
-		{
-			StaticMesh::Vertex vertex = {};
+	void RegisterBones(SkeletalMesh& mesh, MeshImportTask& task)
+	{
+		const aiMesh* sourceMesh = task.SourceMesh;
+		auto& BoneMapping = mesh.Armature.BoneMapping;
 
-			aiVector3D vert = sourceMesh->mVertices[vertIdx];
-			aiVector3D norm = sourceMesh->mNormals[vertIdx];
+		task.BoneIndices.resize(sourceMesh->mNumBones);
 
-			vertex.Position = vec3_cast(vert) * importOptions.DefaultScale;
-			vertex.Normal = vec3_cast(norm);
+		for (uint32_t i = 0; i < sourceMesh->mNumBones; i++)
+		{
+			int32_t bone_index;
+			String bone_name = sourceMesh->mBones[i]->mName.C_Str();
 
-			if(sourceMesh->HasTextureCoords(0))
+			if (BoneMapping.find(bone_name) == BoneMapping.end())
 			{
-				aiVector3D tex = sourceMesh->mTextureCoords[0][vertIdx];
-				vertex.TexCoord = vec2_cast(tex);
+				bone_index = int32_t(mesh.Armature.Bones.size());
+				mesh.Armature.Bones.emplace_back(bone_index, -1, bone_name, mat4_cast(sourceMesh->mBones[i]->mOffsetMatrix));
+				BoneMapping[bone_name] = bone_index;
+			} else
+			{
+				bone_index = BoneMapping[bone_name];
 			}
 
-			if(sourceMesh->HasTangentsAndBitangents())
-			{
-				aiVector3D tan = sourceMesh->mTangents[vertIdx];
-				aiVector3D bit = sourceMesh->mBitangents[vertIdx];
+			task.BoneIndices[i] = bone_index;
+		}
+	}
 
-				vertex.Tangent = vec3_cast(tan);
-				vertex.BiTangent = vec3_cast(bit);
-			}
+	template<typename Vertex>
+	void ConvertVertex(Vertex& vertex, const aiMesh* sourceMesh, uint vertIdx, const Matrix4& transform, const MeshImportOptions& importOptions)
+	{
+		aiVector3D vert = sourceMesh->mVertices[vertIdx];
+		aiVector3D norm = sourceMesh->mNormals[vertIdx];
 
-			if(importOptions.PreTransform)
-			{
-				vertex.Position = transform * Vector4(vertex.Position, 1.0f);
-				vertex.Normal = transform * Vector4(vertex.Normal, 0.0f);
+		vertex.Position = vec3_cast(vert) * importOptions.DefaultScale;
+		vertex.Normal = vec3_cast(norm);
 
-				if(sourceMesh->HasTangentsAndBitangents())
-				{
-					vertex.Tangent = transform * Vector4(vertex.Tangent, 0.0f);
-					vertex.BiTangent = transform * Vector4(vertex.BiTangent, 0.0f);
-				}
-			}
+		if(sourceMesh->HasTextureCoords(0))
+		{
+			aiVector3D tex = sourceMesh->mTextureCoords[0][vertIdx];
+			vertex.TexCoord = vec2_cast(tex);
+		}
+
+		if(sourceMesh->HasTangentsAndBitangents())
+		{
+			aiVector3D tan = sourceMesh->mTangents[vertIdx];
+			aiVector3D bit = sourceMesh->mBitangents[vertIdx];
+
+			vertex.Tangent = vec3_cast(tan);
+			vertex.BiTangent = vec3_cast(bit);
+		}
+
+		if(importOptions.PreTransform)
+		{
+			vertex.Position = transform * Vector4(vertex.Position, 1.0f);
+			vertex.Normal = transform * Vector4(vertex.Normal, 0.0f);
 
-			buffer->Add(vertex);
+			if(sourceMesh->HasTangentsAndBitangents())
+			{
+				vertex.Tangent = transform * Vector4(vertex.Tangent, 0.0f);
+				vertex.BiTangent = transform * Vector4(vertex.BiTangent, 0.0f);
+			}
 		}
+	}
 
-		section.FirstIndex = indices.size();
+	void ConvertIndices(const MeshImportTask& task)
+	{
+		const aiMesh* sourceMesh = task.SourceMesh;
 
 		for (uint faceIdx = 0u; faceIdx < sourceMesh->mNumFaces; faceIdx++)
 		{
 			for (uint8_t id = 0; id < 3; id++)
 			{
 				uint index = sourceMesh->mFaces[faceIdx].mIndices[id];
-				uint32_t newIndex = lastVertex + index;
-				indices.push_back(newIndex);
+				task.Indices[faceIdx * 3 + id] = (Index_t)(task.FirstVertex + index);
 			}
 		}
-
-		section.NumTriangles = sourceMesh->mNumFaces * 3;
-		mesh->LODResources[lod].Sections.emplace_back(section);
 	}
 
-	void ProcessSkeletalMesh(const Mesh_ptr& meshBase, const aiMesh* sourceMesh, const Matrix4& transform, LOD lod, const MeshImportOptions& importOptions, int32_t materialIndex)
+	void ProcessStaticMesh(const MeshImportTask& task, const MeshImportOptions& importOptions)
 	{
-		SkeletalMesh_ptr mesh = SkeletalMesh::Cast(meshBase);
+		const aiMesh* sourceMesh = task.SourceMesh;
+		auto* vertices = static_cast<StaticMesh::Vertex*>(task.Vertices);
 
-		auto& indices = mesh->LODResources[lod].Indices;
-		auto* buffer = mesh->GetVertexBuffer<SkeletalMesh::Vertex>(lod);
+		for (uint vertIdx = 0u; vertIdx < sourceMesh->mNumVertices; vertIdx++)
+		{
+			StaticMesh::Vertex vertex = {};
+			ConvertVertex(vertex, sourceMesh, vertIdx, task.Transform, importOptions);
+			vertices[vertIdx] = vertex;
+		}
 
-		FMeshSection section;
-		section.MaterialIndex = materialIndex;
+		ConvertIndices(task);
+	}
 
-		size_t lastVertex = buffer->GetCount();
+	void ProcessSkeletalMesh(const MeshImportTask& task, const MeshImportOptions& importOptions)
+	{
+		const aiMesh* sourceMesh = task.SourceMesh;
+		auto* vertices = static_cast<SkeletalMesh::Vertex*>(task.Vertices);
 
 		std::vector<VertexBoneData> bones_id_weights_for_each_vertex;
 		bones_id_weights_for_each_vertex.resize(sourceMesh->mNumVertices);
 
-		// Load bones
-		auto& BoneMapping = mesh->Armature.BoneMapping;
-
+		// Load bone weights
 		for (uint32_t i = 0; i < sourceMesh->mNumBones; i++)
 		{
-			int32_t bone_index;
-			String bone_name = sourceMesh->mBones[i]->mName.C_Str();
-
-			if (BoneMapping.find(bone_name) == BoneMapping.end())
-			{
-				bone_index = int32_t(mesh->Armature.Bones.size());
-				mesh->Armature.Bones.emplace_back(bone_index, -1, bone_name, mat4_cast(sourceMesh->mBones[i]->mOffsetMatrix));
-				BoneMapping[bone_name] = bone_index;
-			} else
-			{
-				bone_index = BoneMapping[bone_name];
-			}
+			int32_t bone_index = task.BoneIndices[i];
 
 			for (uint32_t j = 0; j < sourceMesh->mBones[i]->mNumWeights; j++)
 			{
@@ -147,61 +199,16 @@ namespace Aurora
 		for (uint vertIdx = 0u; vertIdx < sourceMesh->mNumVertices; vertIdx++)
 		{
 			SkeletalMesh::Vertex vertex = {};
-
-			aiVector3D vert = sourceMesh->mVertices[vertIdx];
-			aiVector3D norm = sourceMesh->mNormals[vertIdx];
-
-			vertex.Position = vec3_cast(vert) * importOptions.DefaultScale;
-			vertex.Normal = vec3_cast(norm);
-
-			if(sourceMesh->HasTextureCoords(0))
-			{
-				aiVector3D tex = sourceMesh->mTextureCoords[0][vertIdx];
-				vertex.TexCoord = vec2_cast(tex);
-			}
-
-			if(sourceMesh->HasTangentsAndBitangents())
-			{
-				aiVector3D tan = sourceMesh->mTangents[vertIdx];
-				aiVector3D bit = sourceMesh->mBitangents[vertIdx];
-
-				vertex.Tangent = vec3_cast(tan);
-				vertex.BiTangent = vec3_cast(bit);
-			}
-
-			if(importOptions.PreTransform)
-			{
-				vertex.Position = transform * Vector4(vertex.Position, 1.0f);
-				vertex.Normal = transform * Vector4(vertex.Normal, 0.0f);
-
-				if(sourceMesh->HasTangentsAndBitangents())
-				{
-					vertex.Tangent = transform * Vector4(vertex.Tangent, 0.0f);
-					vertex.BiTangent = transform * Vector4(vertex.BiTangent, 0.0f);
-				}
-			}
+			ConvertVertex(vertex, sourceMesh, vertIdx, task.Transform, importOptions);
 
 			VertexBoneData& boneData = bones_id_weights_for_each_vertex[vertIdx];
 			vertex.BoneIndices = {boneData.Ids[0], boneData.Ids[1], boneData.Ids[2], boneData.Ids[3]};
 			vertex.BoneWeights = {boneData.Weights[0], boneData.Weights[1], boneData.Weights[2], boneData.Weights[3]};
 
-			buffer->Add(vertex);
-		}
-
-		section.FirstIndex = indices.size();
-
-		for (uint faceIdx = 0u; faceIdx < sourceMesh->mNumFaces; faceIdx++)
-		{
-			for (uint8_t id = 0; id < 3; id++)
-			{
-				uint index = sourceMesh->mFaces[faceIdx].mIndices[id];
-				uint32_t newIndex = lastVertex + index;
-				indices.push_back(newIndex);
-			}
+			vertices[vertIdx] = vertex;
 		}
 
-		section.NumTriangles = sourceMesh->mNumFaces * 3;
-		mesh->LODResources[lod].Sections.emplace_back(section);
+		ConvertIndices(task);
 	}
 
 	void AssimpModelLoader::LoadMaterial(const aiScene* scene, const Mesh_ptr& mesh, int32_t materialIndex, const aiMaterial* sourceMaterial)
@@ -231,6 +238,10 @@ namespace Aurora
 
 				if (const aiTexture* asTexture = scene->GetEmbeddedTexture(texturePathAiStr.C_Str()))
 				{
+					// Imported without a render device, for example by tools
+					if (!GEngine || !GEngine->GetRenderDevice())
+						break;
+
 					Texture_ptr texture;
 
 					if (m_TextureCache.contains(asTexture))
@@ -336,8 +347,7 @@ namespace Aurora
 		}
 	}
 
-	template<typename MeshProcessor>
-	void ProcessNode(AssimpModelLoader* loader, std::vector<Mesh_ptr>& meshes, int32_t& currentMeshIndex, int32_t& currentMaterialIndex, MeshProcessor& meshProcessor, const aiScene* scene, aiNode* node, const aiMatrix4x4& parentTransform, const MeshImportOptions& importOptions)
+	void ProcessNode(AssimpModelLoader* loader, std::vector<Mesh_ptr>& meshes, std::vector<MeshImportTask>& tasks, int32_t& currentMeshIndex, int32_t& currentMaterialIndex, const aiScene* scene, aiNode* node, const aiMatrix4x4& parentTransform, const MeshImportOptions& importOptions)
 	{
 		aiMatrix4x4 transform;
 
@@ -416,7 +426,7 @@ namespace Aurora
 
 			aiMaterial* sourceMaterial = scene->mMaterials[sourceMesh->mMaterialIndex];
 			loader->LoadMaterial(scene, mesh, currentMaterialIndex, sourceMaterial);
-			meshProcessor(mesh, sourceMesh, mat4_cast(transform), lod, importOptions, currentMaterialIndex);
+			tasks.push_back({mesh, sourceMesh, mat4_cast(transform), lod, currentMaterialIndex});
 
 			currentMaterialIndex++;
 
@@ -430,7 +440,7 @@ namespace Aurora
 		// Iterate over children
 		for (uint i = 0; i < node->mNumChildren; i++)
 		{
-			ProcessNode(loader, meshes, currentMeshIndex, currentMaterialIndex, meshProcessor, scene, node->mChildren[i], node->mTransformation, importOptions);
+			ProcessNode(loader, meshes, tasks, currentMeshIndex, currentMaterialIndex, scene, node->mChildren[i], node->mTransformation, importOptions);
 		}
 	}
 
@@ -527,9 +537,10 @@ namespace Aurora
 		return true;
 	}
 
-	MeshImportedData AssimpModelLoader::ImportModel(const String &name, const DataBlob &data, MeshImportOptions importOptions)
+	MeshImportedData AssimpModelLoader::ImportModel(const String &name, const DataBlob &data, MeshImportOptions importOptions, JobSystem* jobSystem)
 	{
 		MeshImportedData importedData;
+		std::vector<MeshImportTask> tasks;
 
 		int baseFlags = aiProcess_CalcTangentSpace | aiProcess_GenNormals | aiProcess_GenUVCoords | aiProcess_Triangulate;
 		int additionalFlags = 0;
@@ -567,7 +578,17 @@ namespace Aurora
 
 			importOptions.SplitMeshes = false;
 			importOptions.PreTransform = false;
-			ProcessNode(this, importedData.Meshes, currentMesh, currentMaterial, ProcessSkeletalMesh, scene, scene->mRootNode, aiMatrix4x4(), importOptions);
+			ProcessNode(this, importedData.Meshes, tasks, currentMesh, currentMaterial, scene, scene->mRootNode, aiMatrix4x4(), importOptions);
+
+			for (MeshImportTask& task : tasks)
+			{
+				SkeletalMesh& skeletalMesh = SkeletalMesh::Cast(*task.Mesh);
+				ReserveMeshData<SkeletalMesh::Vertex>(skeletalMesh, task);
+				RegisterBones(skeletalMesh, task);
+			}
+
+			for (MeshImportTask& task : tasks)
+				ResolveMeshData<SkeletalMesh::Vertex>(SkeletalMesh::Cast(*task.Mesh), task);
 
 			if (not importedData.Meshes.empty())
 			{
@@ -619,15 +640,56 @@ namespace Aurora
 		}
 		else
 		{
-			ProcessNode(this, importedData.Meshes, currentMesh, currentMaterial, ProcessStaticMesh, scene, scene->mRootNode, aiMatrix4x4(), importOptions);
+			ProcessNode(this, importedData.Meshes, tasks, currentMesh, currentMaterial, scene, scene->mRootNode, aiMatrix4x4(), importOptions);
+
+			for (MeshImportTask& task : tasks)
+				ReserveMeshData<StaticMesh::Vertex>(StaticMesh::Cast(*task.Mesh), task);
+
+			for (MeshImportTask& task : tasks)
+				ResolveMeshData<StaticMesh::Vertex>(StaticMesh::Cast(*task.Mesh), task);
 		}
 
+		bool skeletal = scene->HasAnimations();
+		auto processMeshes = [&tasks, &importOptions, skeletal](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				if (skeletal)
+					ProcessSkeletalMesh(tasks[i], importOptions);
+				else
+					ProcessStaticMesh(tasks[i], importOptions);
+			}
+		};
+
+		if (jobSystem)
+			jobSystem->ParallelFor((uint32_t)tasks.size(), 1, processMeshes);
+		else
+			processMeshes(0, (uint32_t)tasks.size());
+
 		m_Importer.FreeScene();
 
-		for (auto& mesh : importedData.Meshes)
+		if (importOptions.OptimizeMeshes)
+			importedData.OptimizeStats.resize(importedData.Meshes.size());
+		auto optimizeMeshes = [&importedData, &importOptions](uint32_t begin, uint32_t end)
 		{
-			mesh->ComputeAABB();
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				const Mesh_ptr& mesh = importedData.Meshes[i];
 
+				if (importOptions.OptimizeMeshes)
+					importedData.OptimizeStats[i] = MeshOptimizer::Optimize(mesh, importOptions.Optimize);
+
+				mesh->ComputeAABB();
+			}
+		};
+
+		if (jobSystem)
+			jobSystem->ParallelFor((uint32_t)importedData.Meshes.size(), 1, optimizeMeshes);
+		else
+			optimizeMeshes(0, (uint32_t)importedData.Meshes.size());
+
+		for (auto& mesh : importedData.Meshes)
+		{
 			if(importOptions.UploadToGPU)
 				mesh->UploadToGPU(importOptions.KeepCPUData);
 		}
@@ -7,6 +7,7 @@
 #include "Aurora/Core/Library.hpp"
 
 #include "Aurora/Framework/Mesh/Mesh.hpp"
+#include "MeshOptimizer.hpp"
 
 struct aiTexture;
 struct aiMaterial;
@@ -14,6 +15,8 @@ struct aiScene;
 
 namespace Aurora
 {
+	class JobSystem;
+
 	struct MeshImportOptions
 	{
 		bool SplitMeshes = false;
@@ -22,6 +25,8 @@ namespace Aurora
 		bool KeepCPUData = false;
 		bool UploadToGPU = true;
 		float DefaultScale = 1.0f;
+		bool OptimizeMeshes = true;
+		MeshOptimizeOptions Optimize = {};
 	};
 
 	struct MeshImportedData
@@ -29,6 +34,8 @@ namespace Aurora
 		bool Imported = false;
 		Mesh_ptr Mesh = nullptr;
 		std::vector<Mesh_ptr> Meshes = {};
+		// Same order as Meshes, empty when the meshes were not optimized
+		std::vector<MeshOptimizeStats> OptimizeStats = {};
 
 		explicit operator bool() const
 		{
@@ -55,7 +62,8 @@ namespace Aurora
 	public:
 		AssimpModelLoader();
 
-		MeshImportedData ImportModel(const String& name, const DataBlob& data, MeshImportOptions importOptions = {});
+		// Meshes are converted and optimized in parallel with a job system
+		MeshImportedData ImportModel(const String& name, const DataBlob& data, MeshImportOptions importOptions = {}, JobSystem* jobSystem = nullptr);
 		bool ImportAnimation(const DataBlob& data, SkeletalMesh_ptr& skeletalMesh);
 
 	public:
@@ -0,0 +1,85 @@
+#include "CookedTexture.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include "Aurora/Memory/Aum.hpp"
+
+namespace Aurora
+{
+	bool CookedTexture::Read(std::span<const uint8_t> data)
+	{
+		m_Header = nullptr;
+		m_Mips = nullptr;
+		m_Data = {};
+
+		if (data.size() < sizeof(ATexHeader))
+			return false;
+
+		auto header = reinterpret_cast<const ATexHeader*>(data.data());
+
+		if (header->Magic != ATEX_MAGIC || header->Version != ATEX_VERSION || header->MipCount == 0)
+			return false;
+
+		if (header->MipCount > (data.size() - sizeof(ATexHeader)) / sizeof(ATexMip))
+			return false;
+
+		// The pixels are uploaded as they are, so every mip has to hold exactly its level in the format
+		uint32_t pixelSize = GetFormatPixelSize((GraphicsFormat)header->Format);
+
+		if (pixelSize == 0 || header->Width == 0 || header->Height == 0 || header->MipCount > 32)
+			return false;
+
+		auto mips = reinterpret_cast<const ATexMip*>(data.data() + sizeof(ATexHeader));
+
+		for (uint32_t mipLevel = 0; mipLevel < header->MipCount; mipLevel++)
+		{
+			const ATexMip& mip = mips[mipLevel];
+
+			if (mip.Offset > data.size() || mip.Size > data.size() - mip.Offset)
+				return false;
+
+			uint32_t mipWidth = std::max<uint32_t>(1, header->Width >> mipLevel);
+			uint32_t mipHeight = std::max<uint32_t>(1, header->Height >> mipLevel);
+
+			if (mip.Width != mipWidth || mip.Height != mipHeight || mip.Size != (uint64_t)mipWidth * mipHeight * pixelSize)
+				return false;
+		}
+
+		m_Header = header;
+		m_Mips = mips;
+		m_Data = data;
+		return true;
+	}
+
+	DataBlob CookedTexture::Write(const CookedTextureDesc& desc, std::span<const ATexMip> mips, std::span<const uint8_t> pixels)
+	{
+		ATexHeader header = {};
+		header.Magic = ATEX_MAGIC;
+		header.Version = ATEX_VERSION;
+		header.Width = mips.empty() ? 0 : mips[0].Width;
+		header.Height = mips.empty() ? 0 : mips[0].Height;
+		header.MipCount = (uint32_t)mips.size();
+		header.Format = (uint32_t)desc.Format;
+		header.Flags = desc.Flags;
+		header.IDLow = desc.ID.Low();
+		header.IDHigh = desc.ID.High();
+		header.CacheKey = desc.CacheKey;
+
+		size_t pixelsOffset = Align(sizeof(ATexHeader) + mips.size() * sizeof(ATexMip), (size_t)ATEX_DATA_ALIGNMENT);
+
+		DataBlob data(pixelsOffset + pixels.size(), 0);
+		std::memcpy(data.data(), &header, sizeof(header));
+
+		for (size_t mipLevel = 0; mipLevel < mips.size(); mipLevel++)
+		{
+			ATexMip mip = mips[mipLevel];
+			mip.Offset += pixelsOffset;
+			std::memcpy(data.data() + sizeof(ATexHeader) + mipLevel * sizeof(ATexMip), &mip, sizeof(mip));
+		}
+
+		if (!pixels.empty())
+			std::memcpy(data.data() + pixelsOffset, pixels.data(), pixels.size());
+
+		return data;
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <span>
+#include "Aurora/Core/Types.hpp"
+#include "Aurora/Core/AUID.hpp"
+#include "Aurora/Graphics/Base/Format.hpp"
+
+namespace Aurora
+{
+	static constexpr uint32_t ATEX_MAGIC = 0x58455441; // "ATEX"
+	static constexpr uint32_t ATEX_VERSION = 1;
+	static constexpr uint32_t ATEX_DATA_ALIGNMENT = 16;
+
+	static constexpr uint32_t ATEX_FLAG_SRGB = BITF(0);
+	static constexpr uint32_t ATEX_FLAG_NORMAL_MAP = BITF(1);
+
+	// Cooked texture file: this header, one ATexMip per mip level and then the pixels of every level,
+	// ready to be uploaded as they are. Written next to the source with the .atex extension appended.
+	struct ATexHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t MipCount;
+		// GraphicsFormat of the pixels
+		uint32_t Format;
+		uint32_t Flags;
+		uint32_t Reserved;
+		// ID of the source from its meta file
+		uint64_t IDLow;
+		uint64_t IDHigh;
+		// Derived data cache key of the cooked result, equal keys mean the cooked file is up to date
+		uint64_t CacheKey;
+	};
+
+	struct ATexMip
+	{
+		uint32_t Width;
+		uint32_t Height;
+		// From the start of the file
+		uint64_t Offset;
+		uint64_t Size;
+	};
+
+	static_assert(sizeof(ATexHeader) == 56);
+	static_assert(sizeof(ATexMip) == 24);
+
+	struct CookedTextureDesc
+	{
+		GraphicsFormat Format = GraphicsFormat::RGBA8_UNORM;
+		uint32_t Flags = 0;
+		AUID ID;
+		uint64_t CacheKey = 0;
+	};
+
+	// View of a cooked texture in memory, nothing is copied. The data has to outlive the view.
+	class AU_API CookedTexture
+	{
+	private:
+		const ATexHeader* m_Header = nullptr;
+		const ATexMip* m_Mips = nullptr;
+		std::span<const uint8_t> m_Data;
+	public:
+		// Validates the header and that every mip lies inside of the data and matches the size of its level
+		bool Read(std::span<const uint8_t> data);
+
+		[[nodiscard]] bool IsValid() const { return m_Header != nullptr; }
+		[[nodiscard]] const ATexHeader& GetHeader() const { return *m_Header; }
+		[[nodiscard]] std::span<const ATexMip> GetMips() const { return {m_Mips, m_Header->MipCount}; }
+		[[nodiscard]] std::span<const uint8_t> GetMipData(uint32_t mipLevel) const { return m_Data.subspan(m_Mips[mipLevel].Offset, m_Mips[mipLevel].Size); }
+
+		[[nodiscard]] GraphicsFormat GetFormat() const { return (GraphicsFormat)m_Header->Format; }
+		[[nodiscard]] bool IsSRGB() const { return (m_Header->Flags & ATEX_FLAG_SRGB) != 0; }
+		[[nodiscard]] AUID GetID() const { return {m_Header->IDLow, m_Header->IDHigh}; }
+
+		// Mip offsets are relative to the pixels here, the written file has them relative to its start
+		static DataBlob Write(const CookedTextureDesc& desc, std::span<const ATexMip> mips, std::span<const uint8_t> pixels);
+	};
+}
@@ -0,0 +1,85 @@
+#include "DerivedDataCache.hpp"
+
+#include <fstream>
+#include <thread>
+#include <cstdio>
+#include "Aurora/Core/Hash.hpp"
+#include "Aurora/Core/FileSystem.hpp"
+#include "Aurora/Logger/Logger.hpp"
+
+namespace Aurora
+{
+	DerivedDataCache::DerivedDataCache(Path directory) : m_Directory(std::move(directory))
+	{
+
+	}
+
+	uint64_t DerivedDataCache::MakeKey(std::string_view typeName, uint32_t version, std::span<const uint8_t> sourceData, std::span<const uint8_t> settings)
+	{
+		uint64_t hash = Hash_FNV1a64(typeName);
+		hash = Hash_FNV1a64({reinterpret_cast<const uint8_t*>(&version), sizeof(version)}, hash);
+		hash = Hash_FNV1a64(settings, hash);
+		return Hash_FNV1a64(sourceData, hash);
+	}
+
+	Path DerivedDataCache::GetEntryPath(uint64_t key) const
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.ddc", (unsigned long long)key);
+		return m_Directory / name;
+	}
+
+	bool DerivedDataCache::Contains(uint64_t key) const
+	{
+		return FS::FileExists(GetEntryPath(key));
+	}
+
+	bool DerivedDataCache::Get(uint64_t key, DataBlob& data) const
+	{
+		Path entryPath = GetEntryPath(key);
+
+		if (!FS::FileExists(entryPath))
+			return false;
+
+		data = FS::LoadFile(entryPath);
+		return !data.empty();
+	}
+
+	bool DerivedDataCache::Put(uint64_t key, std::span<const uint8_t> data) const
+	{
+		std::error_code errorCode;
+		std::filesystem::create_directories(m_Directory, errorCode);
+
+		Path entryPath = GetEntryPath(key);
+		Path temporaryPath = entryPath.string() + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+		{
+			std::ofstream stream(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+			if (!stream.is_open())
+			{
+				AU_LOG_WARNING("Cannot write derived data ", temporaryPath.string());
+				return false;
+			}
+
+			stream.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)data.size());
+
+			if (!stream.good())
+			{
+				stream.close();
+				std::filesystem::remove(temporaryPath, errorCode);
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporaryPath, entryPath, errorCode);
+
+		if (errorCode)
+		{
+			std::filesystem::remove(temporaryPath, errorCode);
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+#include "Aurora/Core/Types.hpp"
+
+namespace Aurora
+{
+	// Results of expensive asset processing stored by a key computed from everything the result depends on.
+	// Entries are never invalidated, a changed source, setting or processor version simply produces a new key.
+	class AU_API DerivedDataCache
+	{
+	private:
+		Path m_Directory;
+	public:
+		explicit DerivedDataCache(Path directory);
+
+		void SetDirectory(Path directory) { m_Directory = std::move(directory); }
+		[[nodiscard]] const Path& GetDirectory() const { return m_Directory; }
+
+		// The type name separates processors that read the same sources, bump the version when the output changes
+		static uint64_t MakeKey(std::string_view typeName, uint32_t version, std::span<const uint8_t> sourceData, std::span<const uint8_t> settings = {});
+
+		[[nodiscard]] Path GetEntryPath(uint64_t key) const;
+		[[nodiscard]] bool Contains(uint64_t key) const;
+		bool Get(uint64_t key, DataBlob& data) const;
+		// Written to a temporary file first, so an interrupted write never leaves a broken entry behind
+		bool Put(uint64_t key, std::span<const uint8_t> data) const;
+	};
+}
@@ -4,40 +4,55 @@
 namespace Aurora
 {
 
-	PathNode *PathNode::Find(const std::filesystem::path &path)
+	static bool IsSameOrSubPath(const std::filesystem::path& path, const std::filesystem::path& parent)
 	{
-		if (Path == path)
-		{
-			return this;
-		}
+		const std::filesystem::path::string_type& pathString = path.native();
+		const std::filesystem::path::string_type& parentString = parent.native();
 
-		PathNode* foundNode = nullptr;
+		if (pathString.size() < parentString.size() || pathString.compare(0, parentString.size(), parentString) != 0)
+			return false;
 
-		for (PathNode& node : Childrens)
-		{
-			foundNode = node.Find(path);
+		return pathString.size() == parentString.size() || pathString[parentString.size()] == std::filesystem::path::preferred_separator;
+	}
 
-			if (foundNode)
-				break;
+	PathNode *PathNode::Find(const std::filesystem::path &path)
+	{
+		PathNode* node = FindHomeForPath(path);
+
+		if (node && node->Path == path)
+		{
+			return node;
 		}
 
-		return foundNode;
+		return nullptr;
 	}
 
 	PathNode *PathNode::FindHomeForPath(const std::filesystem::path &path)
 	{
-		std::filesystem::path currentPath = path;
-		PathNode* currentNode;
+		if (!IsSameOrSubPath(path, Path))
+			return nullptr;
+
+		// Walks down the directories of the path instead of searching the whole tree
+		PathNode* currentNode = this;
 
-		if (!std::filesystem::is_directory(currentPath))
+		while (currentNode->Path != path)
 		{
-			currentPath = currentPath.parent_path();
-		}
+			PathNode* nextNode = nullptr;
 
-		do {
-			currentNode = Find(currentPath);
-			currentPath = currentPath.parent_path();
-		} while(currentNode == nullptr && !currentPath.empty());
+			for (PathNode& node : currentNode->Childrens)
+			{
+				if (IsSameOrSubPath(path, node.Path))
+				{
+					nextNode = &node;
+					break;
+				}
+			}
+
+			if (!nextNode)
+				break;
+
+			currentNode = nextNode;
+		}
 
 		return currentNode;
 	}
@@ -46,29 +61,29 @@ namespace Aurora
 	{
 		PathNode* homeFolder = FindHomeForPath(path);
 
-		if (!homeFolder)
+		if (!homeFolder || homeFolder->Path == path || !homeFolder->IsDirectory)
 			return false;
 
-		homeFolder->Childrens.emplace_back(PathNode(path, std::filesystem::is_directory(path), homeFolder, {}));
+		// Directories missing in between were created too fast to be reported separately, the traversal adds the rest
+		std::filesystem::path childPath = homeFolder->Path / *path.lexically_relative(homeFolder->Path).begin();
+
+		std::error_code error;
+		PathNode& node = homeFolder->Childrens.emplace_back(childPath, std::filesystem::is_directory(childPath, error), homeFolder, std::vector<PathNode>());
+		node.Traverse();
+		homeFolder->LinkChildren();
 		return true;
 	}
 
 	bool PathNode::RemoveFile(const std::filesystem::path &path)
 	{
-		PathNode* homeFolder = FindHomeForPath(path);
+		PathNode* node = Find(path);
 
-		if (!homeFolder)
-			return false;
-
-		if(*homeFolder == path)
-		{
-			homeFolder = homeFolder->ParentNode;
-		}
-
-		if (!homeFolder)
+		if (!node || !node->ParentNode)
 			return false;
 
+		PathNode* homeFolder = node->ParentNode;
 		homeFolder->Childrens.erase(std::find(homeFolder->Childrens.begin(), homeFolder->end(), path));
+		homeFolder->LinkChildren();
 		return true;
 	}
 
@@ -76,16 +91,35 @@ namespace Aurora
 	{
 		PathNode* node = Find(oldNamePath);
 
-		if (!node)
+		if (!node || !node->ParentNode)
 		{
 			AU_LOG_INFO("Cound not rename file because it does not exists in filetree ", oldNamePath);
-			return false;
+			return AddFile(newPath);
 		}
 
-		node->Childrens.clear();
-		node->Path = newPath;
-		node->IsDirectory = std::filesystem::is_directory(newPath);
-		node->Traverse();
+		PathNode* homeFolder = node->ParentNode;
+
+		if (homeFolder->Path == newPath.parent_path())
+		{
+			node->SetPath(newPath);
+			return true;
+		}
+
+		// Moved to another directory, the subtree moves with it
+		auto nodeIt = std::find(homeFolder->Childrens.begin(), homeFolder->end(), oldNamePath);
+		PathNode movedNode = std::move(*nodeIt);
+		homeFolder->Childrens.erase(nodeIt);
+		homeFolder->LinkChildren();
+
+		PathNode* newHomeFolder = Find(newPath.parent_path());
+
+		if (!newHomeFolder || !newHomeFolder->IsDirectory)
+			return AddFile(newPath);
+
+		movedNode.SetPath(newPath);
+		movedNode.ParentNode = newHomeFolder;
+		newHomeFolder->Childrens.emplace_back(std::move(movedNode));
+		newHomeFolder->LinkChildren();
 		return true;
 	}
 
@@ -94,19 +128,53 @@ namespace Aurora
 		if(!IsDirectory)
 			return;
 
-		for (auto& dirIt : std::filesystem::directory_iterator(Path))
+		// Files can disappear while the directory is read
+		std::error_code error;
+		for (auto dirIt = std::filesystem::directory_iterator(Path, error); !error && dirIt != std::filesystem::directory_iterator(); dirIt.increment(error))
 		{
-			const std::filesystem::path& path = dirIt.path();
+			const std::filesystem::path& path = dirIt->path();
+			std::error_code typeError;
 
 			PathNode node(
 				path,
-				dirIt.is_directory(),
+				dirIt->is_directory(typeError),
 				this,
 				{}
 			);
 
 			Childrens.emplace_back(node).Traverse();
 		}
+
+		LinkChildren();
+	}
+
+	void PathNode::Rescan()
+	{
+		Childrens.clear();
+		Traverse();
+	}
+
+	void PathNode::SetPath(const std::filesystem::path &path)
+	{
+		Path = path;
+
+		for (PathNode& node : Childrens)
+		{
+			node.SetPath(path / node.Path.filename());
+		}
+	}
+
+	void PathNode::LinkChildren()
+	{
+		for (PathNode& node : Childrens)
+		{
+			node.ParentNode = this;
+
+			for (PathNode& childNode : node.Childrens)
+			{
+				childNode.ParentNode = &node;
+			}
+		}
 	}
 
 	void PathNode::SearchFor(std::string searchString, std::vector<PathNode> &foundFiles, bool includeDirectories) const
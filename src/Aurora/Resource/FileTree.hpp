@@ -32,6 +32,7 @@ namespace Aurora
 		PathNode* Find(const std::filesystem::path& path);
 		PathNode* FindHomeForPath(const std::filesystem::path& path);
 
+		// Incremental updates from file watcher events, only added directories are read from disk
 		bool AddFile(const std::filesystem::path& path);
 		bool RemoveFile(const std::filesystem::path& path);
 		bool RenameFile(const std::filesystem::path& newPath, const std::filesystem::path& oldNamePath);
@@ -40,7 +41,12 @@ namespace Aurora
 		bool SearchForFilesWithExtension(const std::string& extension, std::vector<PathNode>& foundFiles) const;
 
 		void Traverse();
+		// Reads the whole directory again
+		void Rescan();
 	private:
+		void SetPath(const std::filesystem::path& path);
+		// Children are stored by value, their parent pointers change whenever the vector moves them
+		void LinkChildren();
 		void SearchForInternal(const std::string& searchString, std::vector<PathNode>& foundFiles, bool includeDirectories) const;
 	};
 
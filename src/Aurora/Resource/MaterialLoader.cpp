@@ -80,6 +80,7 @@ namespace Aurora
 				MTextureVar textureVar;
 				textureVar.Name = name;
 				textureVar.InShaderName = in_shader_name;
+				textureVar.InShaderNameID = Hash_djb2(in_shader_name.c_str());
 				textureVar.Texture = texturePath.length() ? GEngine->GetResourceManager()->LoadTexture(texturePath) : nullptr;
 				textureVar.Sampler = sampler;
 				textureVar.HasEnableMacro = it.contains("macro");
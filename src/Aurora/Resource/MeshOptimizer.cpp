@@ -0,0 +1,241 @@
+#include "MeshOptimizer.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <meshoptimizer.h>
+
+#include "Aurora/Logger/Logger.hpp"
+
+namespace Aurora
+{
+	// Cache model of the statistics, FIFO of 16 vertices like most current GPUs
+	static const uint32_t VertexCacheSize = 16;
+
+	static float AnalyzeACMR(const std::vector<Index_t>& indices, size_t vertexCount)
+	{
+		if (indices.empty())
+			return 0.0f;
+
+		return meshopt_analyzeVertexCache(indices.data(), indices.size(), vertexCount, VertexCacheSize, 0, 0).acmr;
+	}
+
+	// Section index counts are stored in FMeshSection::NumTriangles
+	static bool ValidateSections(const MeshLodResource& lodResource)
+	{
+		for (const FMeshSection& section : lodResource.Sections)
+		{
+			if ((size_t)section.FirstIndex + section.NumTriangles > lodResource.Indices.size() || section.NumTriangles % 3 != 0)
+				return false;
+		}
+
+		return true;
+	}
+
+	template<typename Vertex>
+	static void SetVertices(VertexBuffer<Vertex>* vertexBuffer, const std::vector<Vertex>& vertices, size_t count)
+	{
+		vertexBuffer->Resize(count);
+		std::memcpy(vertexBuffer->GetElements(), vertices.data(), count * sizeof(Vertex));
+	}
+
+	template<typename Vertex>
+	static void WeldVertices(VertexBuffer<Vertex>* vertexBuffer, MeshLodResource& lodResource)
+	{
+		size_t vertexCount = vertexBuffer->GetCount();
+		std::vector<Index_t>& indices = lodResource.Indices;
+
+		// Vertices no index points to are dropped as well
+		std::vector<uint32_t> remap(vertexCount);
+		size_t uniqueCount = meshopt_generateVertexRemap(remap.data(), indices.data(), indices.size(), vertexBuffer->GetElements(), vertexCount, sizeof(Vertex));
+
+		std::vector<Vertex> vertices(uniqueCount);
+		meshopt_remapVertexBuffer(vertices.data(), vertexBuffer->GetElements(), vertexCount, sizeof(Vertex), remap.data());
+		meshopt_remapIndexBuffer(indices.data(), indices.data(), indices.size(), remap.data());
+
+		SetVertices(vertexBuffer, vertices, uniqueCount);
+	}
+
+	// Welded vertices can collapse triangles to a line or a point
+	static void RemoveDegenerateTriangles(MeshLodResource& lodResource)
+	{
+		std::vector<Index_t> indices;
+		indices.reserve(lodResource.Indices.size());
+
+		for (FMeshSection& section : lodResource.Sections)
+		{
+			Index_t firstIndex = (Index_t)indices.size();
+
+			for (Index_t i = section.FirstIndex; i < section.FirstIndex + section.NumTriangles; i += 3)
+			{
+				Index_t a = lodResource.Indices[i];
+				Index_t b = lodResource.Indices[i + 1];
+				Index_t c = lodResource.Indices[i + 2];
+
+				if (a == b || b == c || a == c)
+					continue;
+
+				indices.insert(indices.end(), {a, b, c});
+			}
+
+			section.FirstIndex = firstIndex;
+			section.NumTriangles = (Index_t)indices.size() - firstIndex;
+		}
+
+		lodResource.Indices = std::move(indices);
+	}
+
+	template<typename Vertex>
+	static void OptimizeLOD(VertexBuffer<Vertex>* vertexBuffer, MeshLodResource& lodResource, const MeshOptimizeOptions& options)
+	{
+		size_t vertexCount = vertexBuffer->GetCount();
+		const float* positions = &vertexBuffer->GetElements()->Position.x;
+
+		std::vector<Index_t> sectionIndices;
+
+		// Per section, so every section stays one contiguous range
+		for (const FMeshSection& section : lodResource.Sections)
+		{
+			Index_t* indices = lodResource.Indices.data() + section.FirstIndex;
+			size_t indexCount = section.NumTriangles;
+
+			if (indexCount == 0)
+				continue;
+
+			if (options.OptimizeVertexCache)
+			{
+				sectionIndices.assign(indices, indices + indexCount);
+				meshopt_optimizeVertexCache(indices, sectionIndices.data(), indexCount, vertexCount);
+			}
+
+			if (options.OptimizeOverdraw)
+			{
+				sectionIndices.assign(indices, indices + indexCount);
+				meshopt_optimizeOverdraw(indices, sectionIndices.data(), indexCount, positions, vertexCount, sizeof(Vertex), options.OverdrawThreshold);
+			}
+		}
+
+		if (options.OptimizeVertexFetch)
+		{
+			std::vector<Vertex> vertices(vertexCount);
+			size_t usedCount = meshopt_optimizeVertexFetch(vertices.data(), lodResource.Indices.data(), lodResource.Indices.size(), vertexBuffer->GetElements(), vertexCount, sizeof(Vertex));
+			SetVertices(vertexBuffer, vertices, usedCount);
+		}
+	}
+
+	template<typename Vertex, typename MeshType>
+	static void GenerateLODs(MeshType& mesh, const MeshOptimizeOptions& options)
+	{
+		// Copies, adding LODs to the map can move the resources of LOD0
+		const std::vector<Index_t> baseIndices = mesh.LODResources[0].Indices;
+		const std::vector<FMeshSection> baseSections = mesh.LODResources[0].Sections;
+		const EIndexBufferFormat indexFormat = mesh.LODResources[0].IndexFormat;
+
+		VertexBuffer<Vertex>* baseVertexBuffer = mesh.template GetVertexBuffer<Vertex>(0);
+		const std::vector<Vertex> baseVertices(baseVertexBuffer->GetElements(), baseVertexBuffer->GetElements() + baseVertexBuffer->GetCount());
+		const float* positions = &baseVertices.data()->Position.x;
+
+		size_t previousIndexCount = baseIndices.size();
+		std::vector<Index_t> simplified;
+
+		for (uint32_t level = 1; level <= options.GeneratedLODCount; ++level)
+		{
+			// Always simplified from LOD0, the error does not add up over the levels
+			float reduction = std::pow(options.LODReduction, (float)level);
+			float targetError = options.LODTargetError * (float)level;
+
+			std::vector<Index_t> indices;
+			std::vector<FMeshSection> sections;
+
+			for (const FMeshSection& baseSection : baseSections)
+			{
+				size_t indexCount = baseSection.NumTriangles;
+				size_t targetIndexCount = (size_t)((float)(indexCount / 3) * reduction) * 3;
+
+				simplified.resize(indexCount);
+				size_t simplifiedCount = indexCount > 0 ? meshopt_simplify(simplified.data(), baseIndices.data() + baseSection.FirstIndex, indexCount, positions, baseVertices.size(), sizeof(Vertex), targetIndexCount, targetError, 0, nullptr) : 0;
+
+				FMeshSection section = baseSection;
+				section.FirstIndex = (Index_t)indices.size();
+				section.NumTriangles = (Index_t)simplifiedCount;
+				sections.push_back(section);
+
+				indices.insert(indices.end(), simplified.begin(), simplified.begin() + (ptrdiff_t)simplifiedCount);
+			}
+
+			// The error limit was reached, further levels would look the same
+			if (indices.empty() || (double)indices.size() > (double)previousIndexCount * 0.9)
+				break;
+
+			previousIndexCount = indices.size();
+
+			MeshLodResource* lodResource;
+			VertexBuffer<Vertex>* vertexBuffer = mesh.template CreateVertexBuffer<Vertex>((LOD)level, &lodResource);
+			lodResource->Indices = std::move(indices);
+			lodResource->Sections = std::move(sections);
+			lodResource->IndexFormat = indexFormat;
+			SetVertices(vertexBuffer, baseVertices, baseVertices.size());
+
+			// Vertex fetch drops the vertices the simplified triangles do not use
+			MeshOptimizeOptions lodOptions = options;
+			lodOptions.OptimizeVertexFetch = true;
+			OptimizeLOD(vertexBuffer, *lodResource, lodOptions);
+		}
+	}
+
+	template<typename Vertex, typename MeshType>
+	static MeshOptimizeStats OptimizeMesh(MeshType& mesh, const MeshOptimizeOptions& options)
+	{
+		static_assert(offsetof(Vertex, Position) == 0, "Positions are read from the start of the vertex");
+
+		MeshOptimizeStats stats;
+
+		VertexBuffer<Vertex>* vertexBuffer = mesh.template GetVertexBuffer<Vertex>(0);
+
+		if (!vertexBuffer || vertexBuffer->GetCount() == 0)
+			return stats;
+
+		MeshLodResource& lodResource = mesh.LODResources[0];
+
+		if (lodResource.Indices.empty() || lodResource.Indices.size() % 3 != 0 || !ValidateSections(lodResource))
+		{
+			AU_LOG_WARNING("Mesh ", mesh.Name, " has invalid sections, it was not optimized");
+			return stats;
+		}
+
+		stats.VerticesBefore = (uint32_t)vertexBuffer->GetCount();
+		stats.TrianglesBefore = (uint32_t)lodResource.Indices.size() / 3;
+		stats.ACMRBefore = AnalyzeACMR(lodResource.Indices, vertexBuffer->GetCount());
+
+		if (options.WeldVertices)
+		{
+			WeldVertices(vertexBuffer, lodResource);
+			RemoveDegenerateTriangles(lodResource);
+		}
+
+		OptimizeLOD(vertexBuffer, lodResource, options);
+
+		stats.VerticesAfter = (uint32_t)vertexBuffer->GetCount();
+		stats.TrianglesAfter = (uint32_t)lodResource.Indices.size() / 3;
+		stats.ACMRAfter = AnalyzeACMR(lodResource.Indices, vertexBuffer->GetCount());
+
+		// Meshes with authored LODs keep them
+		if (options.GeneratedLODCount > 0 && mesh.LODResources.size() == 1)
+			GenerateLODs<Vertex>(mesh, options);
+
+		for (LOD lod = 0; mesh.LODResources.contains(lod); ++lod)
+			stats.LODTriangles.push_back((uint32_t)mesh.LODResources[lod].Indices.size() / 3);
+
+		return stats;
+	}
+
+	MeshOptimizeStats MeshOptimizer::Optimize(const Mesh_ptr& mesh, const MeshOptimizeOptions& options)
+	{
+		if (StaticMesh_ptr staticMesh = StaticMesh::SafeCast(mesh))
+			return OptimizeMesh<StaticMesh::Vertex>(*staticMesh, options);
+
+		if (SkeletalMesh_ptr skeletalMesh = SkeletalMesh::SafeCast(mesh))
+			return OptimizeMesh<SkeletalMesh::Vertex>(*skeletalMesh, options);
+
+		return {};
+	}
+}
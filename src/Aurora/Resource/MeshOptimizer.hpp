@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Aurora/Core/Types.hpp"
+#include "Aurora/Framework/Mesh/Mesh.hpp"
+
+namespace Aurora
+{
+	struct MeshOptimizeOptions
+	{
+		// Merges vertices with the same bytes
+		bool WeldVertices = true;
+		// Reorders triangles for the post-transform vertex cache
+		bool OptimizeVertexCache = true;
+		// Reorders triangles front to back, may make the vertex cache efficiency worse by OverdrawThreshold at most
+		bool OptimizeOverdraw = true;
+		float OverdrawThreshold = 1.05f;
+		// Reorders vertices in the order they are used
+		bool OptimizeVertexFetch = true;
+
+		// LODs simplified from LOD0 when the mesh has no other LODs, LOD n keeps LODReduction^n of the triangles.
+		// Simplification stops early at LODTargetError * n, relative to the mesh extents.
+		uint8_t GeneratedLODCount = 0;
+		float LODReduction = 0.5f;
+		float LODTargetError = 0.02f;
+	};
+
+	struct MeshOptimizeStats
+	{
+		uint32_t VerticesBefore = 0;
+		uint32_t VerticesAfter = 0;
+		uint32_t TrianglesBefore = 0;
+		uint32_t TrianglesAfter = 0;
+		// Average vertex shader invocations per triangle of LOD0
+		float ACMRBefore = 0.0f;
+		float ACMRAfter = 0.0f;
+		// Triangles of each LOD after the optimization, LOD0 included
+		std::vector<uint32_t> LODTriangles;
+	};
+
+	// Import-time processing of static and skeletal meshes, sections keep their index ranges contiguous
+	class AU_API MeshOptimizer
+	{
+	public:
+		static MeshOptimizeStats Optimize(const Mesh_ptr& mesh, const MeshOptimizeOptions& options);
+	};
+}
@@ -2,6 +2,7 @@
 
 #include <fstream>
 #include <regex>
+#include <cstring>
 #include "Aurora/Core/FileSystem.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -20,9 +21,25 @@
 #include "Aurora/Core/AUID.hpp"
 #include "Aurora/App/AppContext.hpp"
 #include "Aurora/Graphics/RenderManager.hpp"
+#include "Aurora/Render/SceneRenderer.hpp"
 
 namespace Aurora
 {
+	// Same as the F11 shader reload, for the shader that changed on disk
+	static void ReloadChangedShaders(const Path& path)
+	{
+		if (!ResourceManager::IsFileType(path, FT_SHADER))
+			return;
+
+		if (SceneRenderer* sceneRenderer = GEngine->GetAppContext()->GetSceneRenderer())
+			sceneRenderer->LoadShaders();
+
+		for (const auto& item : GEngine->GetResourceManager()->GetMaterialDefs())
+		{
+			item.second->ReloadShader();
+		}
+	}
+
 	void FileTreeContainer::OnTreeChanged(EFileAction action, const Path &path, const Path& prevPath)
 	{
 		Path relativePath = std::filesystem::relative(path, Root.parent_path());
@@ -39,22 +56,119 @@ namespace Aurora
 				break;
 			case EFileAction::Modified:
 				AU_LOG_INFO("File Modified ", relativePath.string());
+				ReloadChangedShaders(path);
 				break;
 			case EFileAction::Removed:
 				Tree->RemoveFile(path);
 				AU_LOG_INFO("File Removed ", relativePath.string());
 				break;
+			case EFileAction::Overflow:
+				AU_LOG_WARNING("Too many file changes in ", Root.string(), ", reading the whole directory again");
+				Tree->Rescan();
+				break;
 			default: break;
 		}
 	}
 
-	ResourceManager::ResourceManager(IRenderDevice* renderDevice) : m_RenderDevice(renderDevice)
+	class TextureLoadRequest : public TResourceRequest<Texture_ptr>
+	{
+	private:
+		TextureLoadDesc m_LoadDesc;
+		ResourceManager::DecodedTexture m_DecodedTexture;
+	public:
+		TextureLoadRequest(const Path& path, const TextureLoadDesc& loadDesc) : TResourceRequest<Texture_ptr>(path), m_LoadDesc(loadDesc), m_DecodedTexture() {}
+	protected:
+		bool Decode(const ResourceManager& resourceManager) override
+		{
+			return resourceManager.DecodeTexture(GetPath(), m_LoadDesc, m_DecodedTexture);
+		}
+
+		bool Finalize(ResourceManager& resourceManager) override
+		{
+			Resource = resourceManager.CreateTextureFromDecoded(GetPath(), m_LoadDesc, m_DecodedTexture);
+			m_DecodedTexture = ResourceManager::DecodedTexture();
+			return Resource != nullptr;
+		}
+
+		[[nodiscard]] size_t GetUploadSize() const override
+		{
+			return m_DecodedTexture.Pixels.size();
+		}
+	};
+
+	class MeshLoadRequest : public TResourceRequest<Mesh_ptr>
+	{
+	public:
+		explicit MeshLoadRequest(const Path& path) : TResourceRequest<Mesh_ptr>(path) {}
+	protected:
+		bool Decode(const ResourceManager& resourceManager) override
+		{
+			Resource = resourceManager.ReadMesh(GetPath());
+			return Resource != nullptr;
+		}
+
+		bool Finalize(ResourceManager& resourceManager) override
+		{
+			Resource->UploadToGPU(false);
+			return true;
+		}
+
+		[[nodiscard]] size_t GetUploadSize() const override
+		{
+			size_t size = 0;
+
+			if (Resource == nullptr)
+				return size;
+
+			for (const auto& [lod, lodResource] : Resource->LODResources)
+			{
+				if (lodResource.Vertices)
+					size += lodResource.Vertices->GetSize();
+
+				size += lodResource.Indices.size() * sizeof(Index_t);
+			}
+
+			return size;
+		}
+	};
+
+	// The json is parsed on a worker, the definition and its shaders are created on the main thread
+	class MaterialLoadRequest : public TResourceRequest<Material_ptr>
+	{
+	private:
+		nlohmann::json m_Json;
+	public:
+		explicit MaterialLoadRequest(const Path& path) : TResourceRequest<Material_ptr>(path), m_Json() {}
+	protected:
+		bool Decode(const ResourceManager& resourceManager) override
+		{
+			// LoadJson exits on missing files, a missing material only fails its request
+			if (!resourceManager.FileExists(GetPath()) || !resourceManager.LoadJson(GetPath(), m_Json))
+			{
+				AU_LOG_WARNING("Could not load material ", GetPath().string());
+				return false;
+			}
+
+			return true;
+		}
+
+		bool Finalize(ResourceManager& resourceManager) override
+		{
+			Resource = resourceManager.CreateMaterialFromJson(GetPath(), m_Json);
+			return Resource != nullptr;
+		}
+	};
+
+	ResourceManager::ResourceManager(IRenderDevice* renderDevice, JobSystem* jobSystem) : m_RenderDevice(renderDevice), m_JobSystem(jobSystem), m_DerivedDataCache("DerivedDataCache"), m_Streamer(std::make_unique<ResourceStreamer>(this, jobSystem))
 	{
 
 	}
 
 	ResourceManager::~ResourceManager()
 	{
+		// Loads in flight use the search paths and packages
+		m_Streamer.reset();
+
 		for (const auto& [path, treeCont] : m_FileTrees)
 		{
 			delete treeCont;
@@ -77,6 +191,7 @@ namespace Aurora
 		if (AppContext::IsEditorMode())
 		{
 			CreateFileTree(Path(path) / "Assets", true);
+			m_DerivedDataCache.SetDirectory(Path(path) / "DerivedDataCache");
 		}
 	}
 
@@ -131,20 +246,28 @@ namespace Aurora
 
 	void ResourceManager::LoadPackageFile(const Path& path)
 	{
-		auto map = AssetBank::ReadHeadersFromPackage(path);
+		auto package = std::make_unique<AssetPackage>();
+
+		if (!package->Open(path))
+			return;
 
-		for(auto& it : map) {
-			if(m_AssetPackageFiles.find(it.first) != m_AssetPackageFiles.end()) {
-				std::cerr << "Found duplicated file: " << it.first << " in package:" << path << std::endl;
+		for (const ABankEntry& entry : package->GetEntries())
+		{
+			Path filePath = package->GetName(entry);
+
+			if(m_AssetPackageFiles.find(filePath) != m_AssetPackageFiles.end()) {
+				std::cerr << "Found duplicated file: " << filePath << " in package:" << path << std::endl;
 				continue;
 			}
 
-			m_AssetPackageFiles[it.first] = std::pair<Path, ABankHeader>(path, it.second);
+			m_AssetPackageFiles[filePath] = std::pair<const AssetPackage*, const ABankEntry*>(package.get(), &entry);
 
-			Path fileFolder = it.first.parent_path();
+			Path fileFolder = filePath.parent_path();
 
-			m_AssetPackageFolders[fileFolder].push_back(it.first);
+			m_AssetPackageFolders[fileFolder].push_back(filePath);
 		}
+
+		m_AssetPackages.push_back(std::move(package));
 	}
 
 	String ResourceManager::LoadFileToString(const Path& path, bool* isFromAssetPackage) const
@@ -161,8 +284,10 @@ namespace Aurora
 				*isFromAssetPackage = true;
 			}
 
-			auto& packageDesc = m_AssetPackageFiles.at(path);
-			return AssetBank::ReadFileFromPackage(packageDesc.first, packageDesc.second);
+			auto& [package, entry] = m_AssetPackageFiles.at(path);
+			DataBlob data;
+			package->ReadFile(*entry, data);
+			return data;
 		}
 
 		if(isFromAssetPackage != nullptr) {
@@ -182,6 +307,16 @@ namespace Aurora
 		return FS::LoadFile(path);
 	}
 
+	std::span<const uint8_t> ResourceManager::GetPackageFileView(const Path& path) const
+	{
+		auto it = m_AssetPackageFiles.find(path);
+
+		if (it == m_AssetPackageFiles.end() || it->second.second->Compression != ECompressionCodec::None)
+			return {};
+
+		return it->second.first->GetData(*it->second.second);
+	}
+
 	bool ResourceManager::FileExists(const Path& path, bool* isFromAssetPackage) const
 	{
 		if(m_AssetPackageFiles.find(path) != m_AssetPackageFiles.end()) {
@@ -410,7 +545,7 @@ namespace Aurora
 		return shaderProgram;
 	}
 
-	bool ResourceManager::LoadJson(const Path &path, nlohmann::json &json)
+	bool ResourceManager::LoadJson(const Path &path, nlohmann::json &json) const
 	{
 		auto file = LoadFile(path);
 
@@ -432,144 +567,316 @@ namespace Aurora
 			return m_LoadedTextures[path];
 		}
 
-		bool fromAssetPackage = false;
-		auto fileData = LoadFile(path, &fromAssetPackage);
+		if (loadDesc.UseCookedData && !(loadDesc.Width > 0 && loadDesc.Height > 0) && IsCookedTextureOutdated(path))
+		{
+			Path sourcePath;
+			GetRealPath(path, sourcePath);
+			CookTexture(sourcePath);
+		}
 
-		if (fileData.empty()) {
+		DecodedTexture decodedTexture;
+		if (!DecodeTexture(path, loadDesc, decodedTexture)) {
 			return nullptr;
 		}
 
-		Texture_ptr texture = nullptr;
+		return CreateTextureFromDecoded(path, loadDesc, decodedTexture);
+	}
 
-		int width,height,channels_in_file;
-		unsigned char *data = stbi_load_from_memory(reinterpret_cast<stbi_uc*>(fileData.data()), fileData.size(), &width, &height, &channels_in_file, STBI_rgb_alpha);
-		if (!data) {
+	bool ResourceManager::DecodeTexture(const Path& path, const TextureLoadDesc& loadDesc, DecodedTexture& decodedTexture) const
+	{
+		if (loadDesc.UseCookedData && !(loadDesc.Width > 0 && loadDesc.Height > 0) && ReadCookedTexture(path, loadDesc, decodedTexture)) {
+			return true;
+		}
+
+		if (!FileExists(path)) {
+			AU_LOG_ERROR("Cannot find texture ", path.string());
+			return false;
+		}
+
+		auto fileData = LoadFile(path, &decodedTexture.FromAssetPackage);
+
+		if (fileData.empty()) {
+			return false;
+		}
+
+		if (!DecodeImage(fileData, loadDesc, decodedTexture)) {
 			AU_LOG_ERROR("Cannot load texture !", path.string());
-			return nullptr;
+			return false;
 		}
 
-		channels_in_file = 4;
+		return true;
+	}
 
-		GraphicsFormat format = GraphicsFormat::RGBA8_UNORM;
+	bool ResourceManager::ReadCookedTexture(const Path& path, const TextureLoadDesc& loadDesc, DecodedTexture& decodedTexture) const
+	{
+		Path cookedPath = GetCookedTexturePath(path);
 
-		// stbi_load will return you actual channels_in_file even if you request something
-		// YES if will change the channels, but the original channel count its returned into the channels_in_file property
-		/*switch (channels_in_file)
+		// Uncompressed package entries are uploaded straight from the mapped file
+		std::span<const uint8_t> data = GetPackageFileView(cookedPath);
+		decodedTexture.FromAssetPackage = !data.empty();
+
+		if (data.empty())
 		{
-			case 1:
-				format = GraphicsFormat::R8_UNORM;
-				break;
-			case 2:
-				format = GraphicsFormat::RG8_UNORM;
-				break;
-			case 3:
-				format = GraphicsFormat::RGB8_UNORM;
-				break;
-			case 4:
-				format = GraphicsFormat::RGBA8_UNORM;
-				break;
-			default: break;
+			if (!FileExists(cookedPath)) {
+				return false;
+			}
+
+			decodedTexture.Storage = LoadFile(cookedPath, &decodedTexture.FromAssetPackage);
+			data = decodedTexture.Storage;
 		}
 
-		if (format == GraphicsFormat::Unknown)
+		CookedTexture cookedTexture;
+		if (!cookedTexture.Read(data))
 		{
-			stbi_image_free(data);
-			AU_LOG_ERROR("Could not load image ", path.string(), " wrong format !");
-			return nullptr;
-		}*/
+			AU_LOG_WARNING("Cooked texture ", cookedPath.string(), " is corrupted or outdated, loading the source");
+			decodedTexture = DecodedTexture();
+			return false;
+		}
+
+		std::span<const ATexMip> mips = cookedTexture.GetMips();
+
+		decodedTexture.Pixels = data;
+		decodedTexture.Mips.assign(mips.begin(), loadDesc.GenerateMips ? mips.end() : mips.begin() + 1);
+		decodedTexture.Format = cookedTexture.GetFormat();
+		decodedTexture.Cooked = true;
+		decodedTexture.SRGB = cookedTexture.IsSRGB();
+		decodedTexture.ID = cookedTexture.GetID();
+		return true;
+	}
+
+	bool ResourceManager::DecodeImage(std::span<const uint8_t> fileData, const TextureLoadDesc& loadDesc, DecodedTexture& decodedTexture)
+	{
+		// stbi_load will return you actual channels_in_file even if you request something
+		// YES if will change the channels, but the original channel count its returned into the channels_in_file property
+		int width,height,channels_in_file;
+		unsigned char *data = stbi_load_from_memory(fileData.data(), (int)fileData.size(), &width, &height, &channels_in_file, STBI_rgb_alpha);
+		if (!data) {
+			return false;
+		}
 
 		// Resize if requested
+		int targetWidth = width;
+		int targetHeight = height;
+
 		if (loadDesc.Width > 0 && loadDesc.Height > 0)
 		{
-			int targetWidth = std::min<int>(loadDesc.Width, width);
-			int targetHeight = std::min<int>(loadDesc.Height, height);
+			targetWidth = std::min<int>(loadDesc.Width, width);
+			targetHeight = std::min<int>(loadDesc.Height, height);
+		}
+
+		uint32_t mipLevels = loadDesc.GenerateMips ? TextureDesc::GetMipLevelCount(targetWidth, targetHeight) : 1;
 
-			auto* resizedData = new uint8_t[targetWidth * targetHeight * channels_in_file];
-			stbir_resize_uint8(data, width, height, 0, resizedData, targetWidth, targetHeight, 0, channels_in_file);
-			stbi_image_free(data);
+		// All mips are stored in one allocation
+		size_t totalSize = 0;
+		decodedTexture.Mips.clear();
+		for (uint32_t mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+		{
+			uint32_t mipWidth = std::max<int>(1, targetWidth >> mipLevel);
+			uint32_t mipHeight = std::max<int>(1, targetHeight >> mipLevel);
+			uint64_t mipSize = (uint64_t)mipWidth * mipHeight * STBI_rgb_alpha;
 
-			width = targetWidth;
-			height = targetHeight;
-			data = resizedData;
+			decodedTexture.Mips.push_back({mipWidth, mipHeight, totalSize, mipSize});
+			totalSize += mipSize;
 		}
 
-		String filename = path.filename().stem().string();
-		std::transform(filename.begin(), filename.end(), filename.begin(), [](unsigned char c){ return std::tolower(c); });
-		bool isNormalMap = filename.find("normal") != std::string::npos;
+		decodedTexture.Storage.resize(totalSize);
+		uint8_t* pixels = decodedTexture.Storage.data();
+
+		const ATexMip& baseMip = decodedTexture.Mips[0];
+		if ((int)baseMip.Width == width && (int)baseMip.Height == height)
+			std::memcpy(pixels, data, baseMip.Size);
+		else
+			stbir_resize_uint8(data, width, height, 0, pixels, (int)baseMip.Width, (int)baseMip.Height, 0, STBI_rgb_alpha);
+
+		stbi_image_free(data);
+
+		// Every mip is downsampled from the previous one
+		for (uint32_t mipLevel = 1; mipLevel < mipLevels; mipLevel++)
+		{
+			const ATexMip& source = decodedTexture.Mips[mipLevel - 1];
+			const ATexMip& mip = decodedTexture.Mips[mipLevel];
+
+			stbir_resize_uint8(pixels + source.Offset, (int)source.Width, (int)source.Height, 0, pixels + mip.Offset, (int)mip.Width, (int)mip.Height, 0, STBI_rgb_alpha);
+		}
+
+		decodedTexture.Pixels = decodedTexture.Storage;
+		decodedTexture.Format = GraphicsFormat::RGBA8_UNORM;
+		decodedTexture.Cooked = false;
+		return true;
+	}
+
+	Texture_ptr ResourceManager::CreateTextureFromDecoded(const Path& path, const TextureLoadDesc& loadDesc, const DecodedTexture& decodedTexture)
+	{
+		if (decodedTexture.Mips.empty()) {
+			return nullptr;
+		}
+
+		GraphicsFormat format = decodedTexture.Format;
 
 		ResourceName resourceName;
 		resourceName.Name = path.string();
 
-		if (loadDesc.GenerateMetaFile)
+		bool srgb = false;
+
+		if (decodedTexture.Cooked)
+		{
+			srgb = decodedTexture.SRGB;
+			resourceName.ID = decodedTexture.ID;
+		}
+		else if (loadDesc.GenerateMetaFile)
 		{
 			Path realPath;
-			if (!fromAssetPackage && GetRealPath(path, realPath))
+			if (!decodedTexture.FromAssetPackage && GetRealPath(path, realPath))
 			{
-				nlohmann::json metaFile = GetOrCreateMetaForPath(realPath, {
-					{"srgb", !isNormalMap},
-					{"normalMap", isNormalMap},
-				});
-
-				if (metaFile.contains("properties") && metaFile["properties"].contains("srgb"))
-				{
-					if (metaFile["properties"]["srgb"].get<bool>() && format == GraphicsFormat::RGBA8_UNORM)
-					{
-						format = GraphicsFormat::SRGBA8_UNORM;
-					}
-				}
-
-				if(metaFile.contains("uuid"))
-				{
-					String uuid = metaFile["uuid"].get<String>();
-					resourceName.ID = AUID::FromString<String>(uuid).value();
-				}
-				else
-				{
-					AU_LOG_WARNING("Texture ", path, " does not contain AUID");
-				}
+				ReadTextureMeta(realPath, srgb, resourceName.ID);
 			}
 		}
 
+		if (srgb && format == GraphicsFormat::RGBA8_UNORM)
+		{
+			format = GraphicsFormat::SRGBA8_UNORM;
+		}
+
 		if (loadDesc.ForceSRGB)
 		{
 			format = GraphicsFormat::SRGBA8_UNORM;
 		}
 
 		TextureDesc textureDesc;
-		textureDesc.Width = width;
-		textureDesc.Height = height;
-		textureDesc.MipLevels = loadDesc.GenerateMips ? textureDesc.GetMipLevelCount() : 1;
-		textureDesc.ImageFormat = GraphicsFormat::RGBA8_UNORM;
+		textureDesc.Width = (int)decodedTexture.Mips[0].Width;
+		textureDesc.Height = (int)decodedTexture.Mips[0].Height;
+		textureDesc.MipLevels = (uint32_t)decodedTexture.Mips.size();
+		textureDesc.ImageFormat = format;
 		textureDesc.Name = path.string();
 		textureDesc.UseAsBindless = false;
-		texture = m_RenderDevice->CreateTexture(textureDesc, nullptr);
+		Texture_ptr texture = m_RenderDevice->CreateTexture(textureDesc, nullptr);
 		texture->SetResourceName(resourceName);
 
 		for (unsigned int mipLevel = 0; mipLevel < textureDesc.MipLevels; mipLevel++)
 		{
-			m_RenderDevice->WriteTexture(texture, mipLevel, 0, data);
+			m_RenderDevice->WriteTexture(texture, mipLevel, 0, decodedTexture.Pixels.data() + decodedTexture.Mips[mipLevel].Offset);
+		}
+
+		if (!loadDesc.DoNotCache)
+			m_LoadedTextures[path] = texture;
+
+		return texture;
+	}
+
+	void ResourceManager::ReadTextureMeta(const Path& realPath, bool& srgb, AUID& id)
+	{
+		bool isNormalMap = IsNormalMapPath(realPath);
+
+		nlohmann::json metaFile = GetOrCreateMetaForPath(realPath, {
+			{"srgb", !isNormalMap},
+			{"normalMap", isNormalMap},
+		});
+
+		if (metaFile.contains("properties") && metaFile["properties"].contains("srgb"))
+		{
+			srgb = metaFile["properties"]["srgb"].get<bool>();
+		}
+
+		if(metaFile.contains("uuid"))
+		{
+			String uuid = metaFile["uuid"].get<String>();
+			id = AUID::FromString<String>(uuid).value();
+		}
+		else
+		{
+			AU_LOG_WARNING("Texture ", realPath, " does not contain AUID");
+		}
+	}
+
+	bool ResourceManager::CookTexture(const Path& sourcePath)
+	{
+		DataBlob sourceData = FS::LoadFile(sourcePath);
 
-			if (mipLevel < textureDesc.MipLevels - 1u)
+		if (sourceData.empty())
+		{
+			AU_LOG_WARNING("Cannot cook texture ", sourcePath.string(), ", the file is empty or missing");
+			return false;
+		}
+
+		bool srgb = false;
+		CookedTextureDesc cookedDesc;
+		ReadTextureMeta(sourcePath, srgb, cookedDesc.ID);
+
+		cookedDesc.Flags = (srgb ? ATEX_FLAG_SRGB : 0) | (IsNormalMapPath(sourcePath) ? ATEX_FLAG_NORMAL_MAP : 0);
+
+		// The ID is baked in too, two copies of the same image must not share the cooked file
+		uint64_t settings[3] = {cookedDesc.Flags, cookedDesc.ID.Low(), cookedDesc.ID.High()};
+		cookedDesc.CacheKey = DerivedDataCache::MakeKey("Texture", ATEX_VERSION, sourceData, {reinterpret_cast<const uint8_t*>(settings), sizeof(settings)});
+
+		Path cookedPath = GetCookedTexturePath(sourcePath);
+
+		{ // Only the modification time changed, the cooked file is touched so it is not checked again
+			ATexHeader header = {};
+			std::ifstream stream(cookedPath, std::ios::in | std::ios::binary);
+
+			if (stream.read(reinterpret_cast<char*>(&header), sizeof(header)) && header.Magic == ATEX_MAGIC && header.Version == ATEX_VERSION && header.CacheKey == cookedDesc.CacheKey)
 			{
-				int newWidth = std::max<int>(1, width >> 1);
-				int newHeight = std::max<int>(1, height >> 1);
+				stream.close();
 
-				auto* resizedData = new uint8_t[newWidth * newHeight * STBI_rgb_alpha];
-				stbir_resize_uint8(data, width, height, 0, resizedData, newWidth, newHeight, 0, STBI_rgb_alpha);
+				std::error_code errorCode;
+				std::filesystem::last_write_time(cookedPath, std::filesystem::file_time_type::clock::now(), errorCode);
+				return true;
+			}
+		}
 
-				stbi_image_free(data);
-				data = resizedData;
-				width = newWidth;
-				height = newHeight;
+		DataBlob cookedData;
+
+		if (!m_DerivedDataCache.Get(cookedDesc.CacheKey, cookedData))
+		{
+			DecodedTexture decodedTexture;
+			if (!DecodeImage(sourceData, TextureLoadDesc(), decodedTexture))
+			{
+				AU_LOG_ERROR("Cannot cook texture ", sourcePath.string());
+				return false;
 			}
+
+			cookedData = CookedTexture::Write(cookedDesc, decodedTexture.Mips, decodedTexture.Pixels);
+			m_DerivedDataCache.Put(cookedDesc.CacheKey, cookedData);
 		}
 
-		stbi_image_free(data);
+		std::ofstream stream(cookedPath, std::ios::out | std::ios::binary | std::ios::trunc);
 
-		if (!loadDesc.DoNotCache)
-			m_LoadedTextures[path] = texture;
+		if (!stream.is_open())
+		{
+			AU_LOG_ERROR("Cannot write cooked texture ", cookedPath.string());
+			return false;
+		}
 
-		return texture;
+		stream.write(reinterpret_cast<const char*>(cookedData.data()), (std::streamsize)cookedData.size());
+		return true;
+	}
+
+	bool ResourceManager::IsCookedTextureOutdated(const Path& path) const
+	{
+		Path sourcePath;
+
+		if (!AppContext::IsEditorMode() || m_AssetPackageFiles.contains(path) || !GetRealPath(path, sourcePath))
+			return false;
+
+		std::error_code errorCode;
+		auto cookedTime = std::filesystem::last_write_time(GetCookedTexturePath(sourcePath), errorCode);
+
+		if (errorCode)
+			return true;
+
+		if (std::filesystem::last_write_time(sourcePath, errorCode) > cookedTime)
+			return true;
+
+		// Changed sRGB flag or ID
+		auto metaTime = std::filesystem::last_write_time(sourcePath.string() + ".meta", errorCode);
+		return !errorCode && metaTime > cookedTime;
+	}
+
+	bool ResourceManager::IsNormalMapPath(const Path& path)
+	{
+		String filename = path.filename().stem().string();
+		std::transform(filename.begin(), filename.end(), filename.begin(), [](unsigned char c){ return std::tolower(c); });
+		return filename.find("normal") != std::string::npos;
 	}
 
 	Texture_ptr ResourceManager::LoadTexture(const ResourceName& resourceName, const TextureLoadDesc& loadDesc)
@@ -662,37 +969,79 @@ namespace Aurora
 
 	Mesh_ptr ResourceManager::LoadMesh(const Path& path)
 	{
-		auto fileData = LoadFile(path);
+		Mesh_ptr mesh = ReadMesh(path);
 
-		if(fileData.empty()) {
-			return nullptr;
+		if (mesh) {
+			mesh->UploadToGPU(false);
 		}
 
-		Archive archive(fileData);
-		int meshVersion;
-		archive >> meshVersion;
+		return mesh;
+	}
+
+	Mesh_ptr ResourceManager::ReadMesh(const Path& path) const
+	{
+		// The archive only views the data, vertices and indices are copied once straight into the mesh
+		DataBlob fileData;
+		std::span<const uint8_t> data = GetPackageFileView(path);
 
-		if (meshVersion != MESH_VERSION)
+		if (data.empty())
 		{
-			AU_LOG_ERROR("Incorrect amesh version !");
+			if (!FileExists(path))
+			{
+				AU_LOG_ERROR("Cannot find mesh ", path.string());
+				return nullptr;
+			}
+
+			fileData = LoadFile(path);
+			data = fileData;
+		}
+
+		if(data.empty()) {
 			return nullptr;
 		}
 
-		TTypeID meshType = Mesh::ReadMeshType(archive);
+		Archive archive(data);
 
-		if (meshType == StaticMesh::TypeID())
+		try
 		{
-			StaticMesh_ptr newMesh = std::make_shared<StaticMesh>();
-			newMesh->Deserialize(archive);
-			newMesh->UploadToGPU(false);
-			return newMesh;
-		}
+			int meshVersion;
+			archive >> meshVersion;
 
-		if (meshType == SkeletalMesh::TypeID())
+			if (meshVersion != MESH_VERSION && meshVersion != 1)
+			{
+				AU_LOG_ERROR("Incorrect amesh version !");
+				return nullptr;
+			}
+
+			TTypeID meshType = Mesh::ReadMeshType(archive);
+
+			if (meshType == StaticMesh::TypeID())
+			{
+				StaticMesh_ptr newMesh = std::make_shared<StaticMesh>();
+
+				if (meshVersion == 1)
+					newMesh->DeserializeVersion1(archive);
+				else
+					newMesh->Deserialize(archive);
+
+				return newMesh;
+			}
+
+			// Version 1 did not write skeletal meshes
+			if (meshType == SkeletalMesh::TypeID() && meshVersion == MESH_VERSION)
+			{
+				SkeletalMesh_ptr newMesh = std::make_shared<SkeletalMesh>();
+				newMesh->Deserialize(archive);
+				return newMesh;
+			}
+		}
+		catch (const std::exception& e)
 		{
-			// TODO: Implement skeletal mesh
+			AU_LOG_ERROR("Cannot read mesh ", path.string(), ": ", e.what());
+			return nullptr;
 		}
 
+		AU_LOG_ERROR("Unknown mesh type in ", path.string());
 		return nullptr;
 	}
 
@@ -735,6 +1084,11 @@ namespace Aurora
 			AU_LOG_FATAL("Cannot load engine without test material !");
 		}
 
+		return CreateMaterialFromJson(path, json);
+	}
+
+	Material_ptr ResourceManager::CreateMaterialFromJson(const Path& path, const nlohmann::json& json)
+	{
 		if(!json.contains("base"))
 		{
 			AU_LOG_WARNING("Material ", path.string(), " does not have base file defined !");
@@ -755,6 +1109,84 @@ namespace Aurora
 		return matInstance;
 	}
 
+	TextureHandle ResourceManager::LoadTextureAsync(const Path& path, const TextureLoadDesc& loadDesc, ELoadPriority priority)
+	{
+		if (!loadDesc.DoNotCache)
+		{
+			auto it = m_LoadedTextures.find(path);
+
+			if (it != m_LoadedTextures.end())
+				return TextureHandle(it->second);
+
+			// Uncached loads can have a different size, so they are never shared
+			if (auto request = std::dynamic_pointer_cast<TextureLoadRequest>(m_Streamer->Find(path, priority)))
+				return TextureHandle(request);
+		}
+
+		// Cooking would stall the main thread, the source is decoded on the worker instead
+		TextureLoadDesc requestLoadDesc = loadDesc;
+		if (requestLoadDesc.UseCookedData && IsCookedTextureOutdated(path))
+			requestLoadDesc.UseCookedData = false;
+
+		auto request = std::make_shared<TextureLoadRequest>(path, requestLoadDesc);
+		request->Placeholder = GetPlaceholderTexture(IsNormalMapPath(path));
+		m_Streamer->Submit(request, priority);
+		return TextureHandle(request);
+	}
+
+	MeshHandle ResourceManager::LoadMeshAsync(const Path& path, ELoadPriority priority)
+	{
+		if (auto request = std::dynamic_pointer_cast<MeshLoadRequest>(m_Streamer->Find(path, priority)))
+			return MeshHandle(request);
+
+		auto request = std::make_shared<MeshLoadRequest>(path);
+		m_Streamer->Submit(request, priority);
+		return MeshHandle(request);
+	}
+
+	MaterialHandle ResourceManager::LoadMaterialAsync(const Path& path, ELoadPriority priority)
+	{
+		auto it = m_Materials.find(path);
+
+		if (it != m_Materials.end())
+			return MaterialHandle(it->second);
+
+		if (auto request = std::dynamic_pointer_cast<MaterialLoadRequest>(m_Streamer->Find(path, priority)))
+			return MaterialHandle(request);
+
+		auto request = std::make_shared<MaterialLoadRequest>(path);
+		m_Streamer->Submit(request, priority);
+		return MaterialHandle(request);
+	}
+
+	uint32_t ResourceManager::ProcessUploads(size_t byteBudget)
+	{
+		return m_Streamer->ProcessUploads(byteBudget);
+	}
+
+	const Texture_ptr& ResourceManager::GetPlaceholderTexture(bool normalMap)
+	{
+		Texture_ptr& placeholder = normalMap ? m_PlaceholderNormalTexture : m_PlaceholderTexture;
+
+		if (placeholder || !m_RenderDevice)
+			return placeholder;
+
+		// Flat normal pointing up, grey for everything else
+		const uint8_t pixel[4] = {128, 128, normalMap ? (uint8_t)255 : (uint8_t)128, 255};
+
+		TextureDesc textureDesc;
+		textureDesc.Width = 1;
+		textureDesc.Height = 1;
+		textureDesc.MipLevels = 1;
+		textureDesc.ImageFormat = GraphicsFormat::RGBA8_UNORM;
+		textureDesc.Name = normalMap ? "Placeholder Normal" : "Placeholder";
+		textureDesc.UseAsBindless = false;
+		placeholder = m_RenderDevice->CreateTexture(textureDesc, nullptr);
+		m_RenderDevice->WriteTexture(placeholder, 0, 0, pixel);
+
+		return placeholder;
+	}
+
 	nlohmann::json ResourceManager::GetOrCreateMetaForPath(const Path& originalFilePath, const nlohmann::json &defaults)
 	{
 		Path metaPath = originalFilePath.string() + ".meta";
@@ -800,7 +1232,8 @@ namespace Aurora
 				return;
 			}
 
-			// TODO: Create meta file
+			// Creates the meta file as well
+			CookTexture(destPath);
 			return;
 		}
 
@@ -813,9 +1246,10 @@ namespace Aurora
 			meshImportOptions.KeepCPUData = true;
 			meshImportOptions.PreTransform = false;
 			meshImportOptions.SplitMeshes = true;
+			meshImportOptions.Optimize.GeneratedLODCount = 3;
 
 			AssimpModelLoader modelLoader;
-			MeshImportedData importedData = modelLoader.ImportModel("Test", data, meshImportOptions);
+			MeshImportedData importedData = modelLoader.ImportModel("Test", data, meshImportOptions, m_JobSystem);
 
 			if(!importedData)
 			{
@@ -1037,7 +1471,8 @@ namespace Aurora
 	}
 
 	static const char* IgnoredFileExtensions[] = {
-		".meta"
+		".meta",
+		".atex"
 	};
 
 	bool ResourceManager::IsIgnoredFileType(const Path &path)
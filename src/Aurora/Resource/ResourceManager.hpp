@@ -9,6 +9,9 @@
 #include "Aurora/Graphics/Material/MaterialDefinition.hpp"
 #include "Aurora/Framework/Mesh/Mesh.hpp"
 #include "AssetBank.hpp"
+#include "ResourceStreamer.hpp"
+#include "CookedTexture.hpp"
+#include "DerivedDataCache.hpp"
 #include "FileTree.hpp"
 #include "ResourceName.hpp"
 
@@ -16,13 +19,6 @@
 
 namespace Aurora
 {
-	struct path_hash
-	{
-		std::size_t operator()(const Path& path) const {
-			return hash_value(path);
-		}
-	};
-
 	enum FileType : uint32_t
 	{
 		FT_IMAGE = BITF(0),
@@ -45,6 +41,8 @@ namespace Aurora
 		bool GenerateMetaFile = true;
 		bool ForceSRGB = false;
 		bool DoNotCache = false;
+		// Cooked data is only used when the texture is not resized
+		bool UseCookedData = true;
 	};
 
 	struct FileTreeContainer
@@ -62,22 +60,58 @@ namespace Aurora
 		void OnTreeChanged(EFileAction action, const Path& path, const Path& prevPath);
 	};
 
+	using TextureHandle = ResourceHandle<Texture_ptr>;
+	using MeshHandle = ResourceHandle<Mesh_ptr>;
+	using MaterialHandle = ResourceHandle<Material_ptr>;
+
 	class AU_API ResourceManager
 	{
+	public:
+		// Pixels of every mip level, produced on any thread and uploaded on the main thread
+		struct DecodedTexture
+		{
+			// Owns the pixels, unless they are viewed straight from a mapped package
+			DataBlob Storage;
+			std::span<const uint8_t> Pixels;
+			// Offsets are relative to the pixels
+			std::vector<ATexMip> Mips;
+			GraphicsFormat Format = GraphicsFormat::RGBA8_UNORM;
+			bool FromAssetPackage = false;
+			// Cooked textures carry the sRGB flag and ID, their meta file is not read
+			bool Cooked = false;
+			bool SRGB = false;
+			AUID ID;
+
+			DecodedTexture() = default;
+			DecodedTexture(DecodedTexture&&) = default;
+			DecodedTexture& operator=(DecodedTexture&&) = default;
+			// Pixels point into the storage
+			DecodedTexture(const DecodedTexture&) = delete;
+			DecodedTexture& operator=(const DecodedTexture&) = delete;
+		};
 	private:
-		static const int MESH_VERSION = 1;
+		// 2 is the chunked format, meshes of version 1 are still read
+		static const int MESH_VERSION = 2;
 
 		IRenderDevice* m_RenderDevice;
+		JobSystem* m_JobSystem;
 		std::vector<Path> m_FileSearchPaths;
 		std::unordered_map<Path, FileTreeContainer*, path_hash> m_FileTrees;
-		std::unordered_map<Path, std::pair<Path, ABankHeader>, path_hash> m_AssetPackageFiles;
+		std::vector<std::unique_ptr<AssetPackage>> m_AssetPackages;
+		std::unordered_map<Path, std::pair<const AssetPackage*, const ABankEntry*>, path_hash> m_AssetPackageFiles;
 		std::unordered_map<Path, std::vector<Path>, path_hash> m_AssetPackageFolders;
 		std::unordered_map<Path, Shader_ptr, path_hash> m_ShaderPrograms;
 		std::unordered_map<Path, Texture_ptr, path_hash> m_LoadedTextures;
 		std::unordered_map<Path, MaterialDefinition_ptr, path_hash> m_MaterialDefinitions;
 		std::unordered_map<Path, Material_ptr, path_hash> m_Materials;
+
+		DerivedDataCache m_DerivedDataCache;
+		std::unique_ptr<ResourceStreamer> m_Streamer;
+		Texture_ptr m_PlaceholderTexture;
+		Texture_ptr m_PlaceholderNormalTexture;
 	public:
-		explicit ResourceManager(IRenderDevice* renderDevice);
+		// Render device can be null for tools and benchmarks that only decode resources
+		explicit ResourceManager(IRenderDevice* renderDevice, JobSystem* jobSystem = nullptr);
 		~ResourceManager();
 
 		void Update();
@@ -90,6 +124,9 @@ namespace Aurora
 		void LoadPackageFile(const Path& path);
 
 		DataBlob LoadFile(const Path& path, bool* isFromAssetPackage = nullptr) const;
+		// View of a file stored in a loaded package, without reading or copying it. Empty when the file is not in any package or is compressed.
+		// The view stays valid as long as the resource manager is alive.
+		[[nodiscard]] std::span<const uint8_t> GetPackageFileView(const Path& path) const;
 		[[nodiscard]] bool FileExists(const Path& path, bool* isFromAssetPackage = nullptr) const;
 		[[nodiscard]] bool GetRealPath(const Path& path, Path& path_out) const;
 		String LoadFileToString(const Path& path, bool* isFromAssetPackage = nullptr) const;
@@ -110,17 +147,48 @@ namespace Aurora
 		}
 		Shader_ptr LoadComputeShader(const Path& path, const ShaderMacros& macros = {});
 
-		bool LoadJson(const Path &path, nlohmann::json &json);
+		bool LoadJson(const Path &path, nlohmann::json &json) const;
 
 		Texture_ptr LoadTexture(const Path& path, const TextureLoadDesc& loadDesc = TextureLoadDesc());
 		Texture_ptr LoadTexture(const ResourceName& resourceName, const TextureLoadDesc& loadDesc = TextureLoadDesc());
 		Texture_ptr LoadResourceIcon(const Path& path, int size = 0);
 		Texture_ptr LoadLutTexture(const Path& path);
 
+		// CPU part of LoadTexture, safe to call from worker threads. Reads the cooked texture when there is one.
+		bool DecodeTexture(const Path& path, const TextureLoadDesc& loadDesc, DecodedTexture& decodedTexture) const;
+		Texture_ptr CreateTextureFromDecoded(const Path& path, const TextureLoadDesc& loadDesc, const DecodedTexture& decodedTexture);
+		static bool DecodeImage(std::span<const uint8_t> fileData, const TextureLoadDesc& loadDesc, DecodedTexture& decodedTexture);
+
+		// Writes the cooked texture next to a source file on disk, results are reused from the derived data cache.
+		// Returns false when the source could not be decoded.
+		bool CookTexture(const Path& sourcePath);
+		[[nodiscard]] static Path GetCookedTexturePath(const Path& path) { return path.string() + ".atex"; }
+		// Only in the editor, packaged and loose game files are used as they are
+		[[nodiscard]] bool IsCookedTextureOutdated(const Path& path) const;
+
+		[[nodiscard]] DerivedDataCache& GetDerivedDataCache() { return m_DerivedDataCache; }
+
 		Mesh_ptr LoadMesh(const Path& path);
+		// Reads the mesh without uploading it, safe to call from worker threads
+		Mesh_ptr ReadMesh(const Path& path) const;
 
 		const MaterialDefinition_ptr& GetOrLoadMaterialDefinition(const Path& path);
 		std::shared_ptr<Material> LoadMaterial(const Path& path);
+		Material_ptr CreateMaterialFromJson(const Path& path, const nlohmann::json& json);
+
+		// Asynchronous loads, files are read and decoded on the job system and uploaded in ProcessUploads.
+		// Loads of the same path are merged while they are in flight. Textures return a placeholder until they are ready.
+		// Search paths and packages must not change while loads are in flight.
+		TextureHandle LoadTextureAsync(const Path& path, const TextureLoadDesc& loadDesc = TextureLoadDesc(), ELoadPriority priority = ELoadPriority::Normal);
+		MeshHandle LoadMeshAsync(const Path& path, ELoadPriority priority = ELoadPriority::Normal);
+		MaterialHandle LoadMaterialAsync(const Path& path, ELoadPriority priority = ELoadPriority::Normal);
+
+		// Creates the GPU resources of the finished loads, called once per frame by the engine
+		uint32_t ProcessUploads(size_t byteBudget = ResourceStreamer::DefaultUploadBudget);
+		[[nodiscard]] ResourceStreamer& GetStreamer() { return *m_Streamer; }
+
+		// 1x1 texture, null without a render device
+		const Texture_ptr& GetPlaceholderTexture(bool normalMap = false);
 
 		nlohmann::json GetOrCreateMetaForPath(const Path& path, const nlohmann::json& defaults);
 
@@ -137,6 +205,12 @@ namespace Aurora
 		[[nodiscard]] inline const std::unordered_map<Path, MaterialDefinition_ptr, path_hash>& GetMaterialDefs() const { return m_MaterialDefinitions; }
 
 		static bool IsFileType(const Path& path, FileType types);
+		// Textures with "normal" in their name are treated as normal maps
+		static bool IsNormalMapPath(const Path& path);
 		static bool IsIgnoredFileType(const Path& path);
+	private:
+		bool ReadCookedTexture(const Path& path, const TextureLoadDesc& loadDesc, DecodedTexture& decodedTexture) const;
+		// Creates the meta file when there is none
+		void ReadTextureMeta(const Path& realPath, bool& srgb, AUID& id);
 	};
 }
@@ -0,0 +1,285 @@
+#include "ResourceStreamer.hpp"
+
+#include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Logger/Logger.hpp"
+
+namespace Aurora
+{
+	ResourceStreamer::ResourceStreamer(ResourceManager* resourceManager, JobSystem* jobSystem, uint32_t maxConcurrentLoads)
+		: m_ResourceManager(resourceManager), m_JobSystem(jobSystem), m_MaxConcurrentLoads(maxConcurrentLoads), m_ActiveLoaders(0)
+	{
+
+	}
+
+	ResourceStreamer::~ResourceStreamer()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			for (auto& queue : m_PendingQueues)
+				queue.clear();
+		}
+
+		// Loaders that already started reference this object
+		if (m_JobSystem)
+			m_JobSystem->Wait(m_LoaderCounter);
+	}
+
+	void ResourceStreamer::SetMaxConcurrentLoads(uint32_t maxConcurrentLoads)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_MaxConcurrentLoads = maxConcurrentLoads;
+		ScheduleLoaders();
+	}
+
+	std::shared_ptr<ResourceRequest> ResourceStreamer::Find(const Path& path, ELoadPriority priority)
+	{
+		auto it = m_InFlightRequests.find(path);
+
+		if (it == m_InFlightRequests.end())
+			return nullptr;
+
+		const std::shared_ptr<ResourceRequest>& request = it->second;
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (priority > request->m_Priority)
+		{
+			request->m_Priority = priority;
+
+			// The entry in the lower queue stays there and is skipped by the state checks
+			switch (request->GetState())
+			{
+				case ELoadState::Queued:
+					m_PendingQueues[(uint32_t)priority].push_back(request);
+					break;
+				case ELoadState::Decoded:
+				case ELoadState::Failed:
+					m_DecodedQueues[(uint32_t)priority].push_back(request);
+					break;
+				default: break;
+			}
+		}
+
+		return request;
+	}
+
+	void ResourceStreamer::Submit(const std::shared_ptr<ResourceRequest>& request, ELoadPriority priority)
+	{
+		au_assert(request->GetState() == ELoadState::Queued);
+
+		m_InFlightRequests.try_emplace(request->GetPath(), request);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		request->m_Priority = priority;
+		m_PendingQueues[(uint32_t)priority].push_back(request);
+		ScheduleLoaders();
+	}
+
+	uint32_t ResourceStreamer::ProcessUploads(size_t byteBudget)
+	{
+		CPU_DEBUG_SCOPE("ResourceStreamer::ProcessUploads");
+
+		uint32_t finishedCount = 0;
+		size_t uploadedBytes = 0;
+
+		while (true)
+		{
+			std::shared_ptr<ResourceRequest> request;
+			bool budgetExceeded = false;
+			bool decodeInline = false;
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+
+				for (int32_t priority = LoadPriorityCount - 1; priority >= 0 && !request && !budgetExceeded; --priority)
+				{
+					auto& queue = m_DecodedQueues[priority];
+
+					while (!queue.empty() && queue.front()->m_Finished)
+						queue.pop_front();
+
+					if (queue.empty())
+						continue;
+
+					// Failed requests upload nothing, they are only removed
+					size_t uploadSize = queue.front()->GetState() == ELoadState::Decoded ? queue.front()->GetUploadSize() : 0;
+
+					// Lower priorities wait too, so they cannot overtake the request that did not fit
+					if (finishedCount > 0 && uploadedBytes + uploadSize > byteBudget)
+					{
+						budgetExceeded = true;
+						break;
+					}
+
+					request = std::move(queue.front());
+					queue.pop_front();
+					uploadedBytes += uploadSize;
+				}
+
+				if (!request && !budgetExceeded && !HasWorkers())
+				{
+					request = PopPending();
+					decodeInline = request != nullptr;
+				}
+			}
+
+			if (!request)
+				break;
+
+			// Decoded requests go through the queue, so the budget check above applies to them as well
+			if (decodeInline)
+			{
+				DecodeRequest(request);
+				continue;
+			}
+
+			FinalizeRequest(*request);
+			finishedCount++;
+		}
+
+		return finishedCount;
+	}
+
+	void ResourceStreamer::WaitForDecodes()
+	{
+		if (HasWorkers())
+		{
+			m_JobSystem->Wait(m_LoaderCounter);
+			return;
+		}
+
+		while (true)
+		{
+			std::shared_ptr<ResourceRequest> request;
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				request = PopPending();
+			}
+
+			if (!request)
+				break;
+
+			DecodeRequest(request);
+		}
+	}
+
+	void ResourceStreamer::Flush()
+	{
+		// Finalize can submit further requests
+		do
+		{
+			WaitForDecodes();
+		}
+		while (ProcessUploads(SIZE_MAX) > 0);
+	}
+
+	std::shared_ptr<ResourceRequest> ResourceStreamer::PopPending()
+	{
+		for (int32_t priority = LoadPriorityCount - 1; priority >= 0; --priority)
+		{
+			auto& queue = m_PendingQueues[priority];
+
+			while (!queue.empty())
+			{
+				std::shared_ptr<ResourceRequest> request = std::move(queue.front());
+				queue.pop_front();
+
+				// Requests that were raised to a higher priority are queued twice
+				if (request->GetState() != ELoadState::Queued)
+					continue;
+
+				request->m_State.store(ELoadState::Loading, std::memory_order_release);
+				return request;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void ResourceStreamer::ScheduleLoaders()
+	{
+		if (!HasWorkers())
+			return;
+
+		uint32_t maxLoaders = m_MaxConcurrentLoads > 0 ? m_MaxConcurrentLoads : m_JobSystem->GetWorkerCount();
+
+		size_t pendingCount = 0;
+		for (const auto& queue : m_PendingQueues)
+			pendingCount += queue.size();
+
+		while (m_ActiveLoaders < maxLoaders && m_ActiveLoaders < pendingCount)
+		{
+			m_ActiveLoaders++;
+			m_JobSystem->Schedule([this]() { RunLoader(); }, &m_LoaderCounter);
+		}
+	}
+
+	void ResourceStreamer::RunLoader()
+	{
+		std::shared_ptr<ResourceRequest> request;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			request = PopPending();
+
+			if (!request)
+			{
+				m_ActiveLoaders--;
+				return;
+			}
+		}
+
+		DecodeRequest(request);
+
+		// Every job decodes a single request and schedules the next one. A thread that picks up a loader
+		// while waiting for its own jobs is then blocked for one decode at most.
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_ActiveLoaders--;
+		ScheduleLoaders();
+	}
+
+	void ResourceStreamer::DecodeRequest(const std::shared_ptr<ResourceRequest>& request)
+	{
+		bool decoded = false;
+
+		try
+		{
+			decoded = request->Decode(*m_ResourceManager);
+		}
+		catch (const std::exception& exception)
+		{
+			AU_LOG_ERROR("Could not load ", request->GetPath().string(), ": ", exception.what());
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		request->m_State.store(decoded ? ELoadState::Decoded : ELoadState::Failed, std::memory_order_release);
+		// Failed requests go through the queue as well, the main thread removes them from the in flight requests
+		m_DecodedQueues[(uint32_t)request->m_Priority].push_back(request);
+	}
+
+	void ResourceStreamer::FinalizeRequest(ResourceRequest& request)
+	{
+		request.m_Finished = true;
+
+		if (request.GetState() == ELoadState::Decoded)
+		{
+			bool finalized = false;
+
+			try
+			{
+				finalized = request.Finalize(*m_ResourceManager);
+			}
+			catch (const std::exception& exception)
+			{
+				AU_LOG_ERROR("Could not finish loading ", request.GetPath().string(), ": ", exception.what());
+			}
+
+			request.m_State.store(finalized ? ELoadState::Ready : ELoadState::Failed, std::memory_order_release);
+		}
+
+		auto it = m_InFlightRequests.find(request.GetPath());
+
+		if (it != m_InFlightRequests.end() && it->second.get() == &request)
+			m_InFlightRequests.erase(it);
+	}
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include "Aurora/Core/Types.hpp"
+#include "Aurora/Core/JobSystem.hpp"
+
+namespace Aurora
+{
+	class ResourceManager;
+
+	enum class ELoadPriority : uint8_t
+	{
+		Low = 0,
+		Normal,
+		High
+	};
+
+	static constexpr uint32_t LoadPriorityCount = 3;
+
+	enum class ELoadState : uint8_t
+	{
+		// Waiting for a loader
+		Queued = 0,
+		// File read and decode running on a worker
+		Loading,
+		// Waiting for the main thread upload
+		Decoded,
+		Ready,
+		Failed
+	};
+
+	// One asynchronous load. Decode runs on a worker and must not touch the render device,
+	// Finalize runs on the main thread and creates the GPU resources from the decoded data.
+	class AU_API ResourceRequest
+	{
+		friend class ResourceStreamer;
+	private:
+		Path m_Path;
+		std::atomic<ELoadState> m_State;
+		// Guarded by the streamer mutex
+		ELoadPriority m_Priority;
+		// Main thread only, set once the request left the streamer
+		bool m_Finished;
+	public:
+		explicit ResourceRequest(Path path) : m_Path(std::move(path)), m_State(ELoadState::Queued), m_Priority(ELoadPriority::Normal), m_Finished(false) {}
+		virtual ~ResourceRequest() = default;
+
+		ResourceRequest(const ResourceRequest&) = delete;
+		ResourceRequest& operator=(const ResourceRequest&) = delete;
+
+		[[nodiscard]] const Path& GetPath() const { return m_Path; }
+		[[nodiscard]] ELoadState GetState() const { return m_State.load(std::memory_order_acquire); }
+	protected:
+		virtual bool Decode(const ResourceManager& resourceManager) = 0;
+		virtual bool Finalize(ResourceManager& resourceManager) = 0;
+		// Bytes uploaded by Finalize, counted against the per-frame upload budget
+		[[nodiscard]] virtual size_t GetUploadSize() const { return 0; }
+	};
+
+	template<typename T>
+	class TResourceRequest : public ResourceRequest
+	{
+	public:
+		// Written by Finalize
+		T Resource;
+		// Returned by the handles until the resource is ready
+		T Placeholder;
+
+		explicit TResourceRequest(Path path) : ResourceRequest(std::move(path)), Resource(), Placeholder() {}
+	};
+
+	// Result of an asynchronous load, cheap to copy. Handles are meant to be used on the main thread,
+	// the resource is only written there.
+	template<typename T>
+	class ResourceHandle
+	{
+	private:
+		std::shared_ptr<TResourceRequest<T>> m_Request;
+		// Resources that were already loaded do not need a request
+		T m_Resource;
+	public:
+		ResourceHandle() : m_Request(), m_Resource() {}
+		explicit ResourceHandle(T resource) : m_Request(), m_Resource(std::move(resource)) {}
+		explicit ResourceHandle(std::shared_ptr<TResourceRequest<T>> request) : m_Request(std::move(request)), m_Resource() {}
+
+		[[nodiscard]] bool IsValid() const { return m_Request != nullptr || m_Resource != nullptr; }
+
+		[[nodiscard]] ELoadState GetState() const
+		{
+			if (m_Request)
+				return m_Request->GetState();
+
+			return m_Resource ? ELoadState::Ready : ELoadState::Failed;
+		}
+
+		[[nodiscard]] bool IsReady() const { return GetState() == ELoadState::Ready; }
+		[[nodiscard]] bool IsFailed() const { return GetState() == ELoadState::Failed; }
+		[[nodiscard]] bool IsPending() const { return !IsReady() && !IsFailed(); }
+
+		// Loaded resource, or the placeholder while it is loading or when the load failed
+		[[nodiscard]] const T& Get() const
+		{
+			if (!m_Request)
+				return m_Resource;
+
+			return m_Request->GetState() == ELoadState::Ready ? m_Request->Resource : m_Request->Placeholder;
+		}
+	};
+
+	// Schedules resource loads on the job system. Loads of the same path are merged while in flight, higher priorities
+	// are decoded and uploaded first. Uploads are drained from the main thread with a byte budget per call,
+	// so a scene full of textures is spread over several frames instead of stalling one.
+	// Without worker threads the loads are decoded on the main thread in ProcessUploads.
+	class AU_API ResourceStreamer
+	{
+	public:
+		static constexpr size_t DefaultUploadBudget = 32 * 1024 * 1024;
+	private:
+		ResourceManager* m_ResourceManager;
+		JobSystem* m_JobSystem;
+		uint32_t m_MaxConcurrentLoads;
+
+		std::mutex m_Mutex;
+		std::deque<std::shared_ptr<ResourceRequest>> m_PendingQueues[LoadPriorityCount];
+		std::deque<std::shared_ptr<ResourceRequest>> m_DecodedQueues[LoadPriorityCount];
+		uint32_t m_ActiveLoaders;
+		JobCounter m_LoaderCounter;
+
+		// Main thread only
+		std::unordered_map<Path, std::shared_ptr<ResourceRequest>, path_hash> m_InFlightRequests;
+	public:
+		// Max concurrent loads of zero uses all workers of the job system
+		ResourceStreamer(ResourceManager* resourceManager, JobSystem* jobSystem, uint32_t maxConcurrentLoads = 0);
+		~ResourceStreamer();
+
+		ResourceStreamer(const ResourceStreamer&) = delete;
+		ResourceStreamer& operator=(const ResourceStreamer&) = delete;
+
+		void SetMaxConcurrentLoads(uint32_t maxConcurrentLoads);
+		[[nodiscard]] uint32_t GetMaxConcurrentLoads() const { return m_MaxConcurrentLoads; }
+
+		// Unfinished request of the path, raised to the priority when it is higher than the requested one
+		std::shared_ptr<ResourceRequest> Find(const Path& path, ELoadPriority priority);
+		// Queues the request. Requests of a path that is already in flight are loaded, but are not returned by Find.
+		void Submit(const std::shared_ptr<ResourceRequest>& request, ELoadPriority priority = ELoadPriority::Normal);
+
+		// Finalizes decoded requests on the main thread until the upload budget is used up, returns the number of finished requests.
+		// At least one request is finalized per call, so resources larger than the budget still get uploaded.
+		uint32_t ProcessUploads(size_t byteBudget = DefaultUploadBudget);
+		// Blocks until every queued request is decoded, the calling thread helps with the decoding
+		void WaitForDecodes();
+		// Finishes every request, including the uploads
+		void Flush();
+
+		[[nodiscard]] size_t GetInFlightCount() const { return m_InFlightRequests.size(); }
+	private:
+		[[nodiscard]] bool HasWorkers() const { return m_JobSystem != nullptr && m_JobSystem->GetWorkerCount() > 0; }
+
+		// Caller holds the mutex
+		std::shared_ptr<ResourceRequest> PopPending();
+		void ScheduleLoaders();
+
+		void RunLoader();
+		void DecodeRequest(const std::shared_ptr<ResourceRequest>& request);
+		void FinalizeRequest(ResourceRequest& request);
+	};
+}
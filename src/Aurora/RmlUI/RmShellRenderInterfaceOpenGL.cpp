@@ -68,8 +68,8 @@ namespace Aurora
 
 		if(texture) {
 			auto* texture_handle = (TexHandle*)texture;
-			m_CurrentState.BindTexture("Texture", texture_handle->Texture);
-			m_CurrentState.BindSampler("Texture", Samplers::WrapWrapNearNearestFarLinear);
+			m_CurrentState.BindTexture("Texture"_HASH, texture_handle->Texture);
+			m_CurrentState.BindSampler("Texture"_HASH, Samplers::WrapWrapNearNearestFarLinear);
 		}
 
 		m_CurrentState.DepthStencilState.DepthEnable = false;
@@ -90,11 +90,11 @@ namespace Aurora
 			{
 				desc->ModelMat = glm::translate(Vector3(translation.x, translation.y, 0));
 			}
-		END_UBW(m_CurrentState, m_VertexUniformBuffer, "VertexUniform");
+		END_UBW(m_CurrentState, m_VertexUniformBuffer, "VertexUniform"_HASH);
 
 		BEGIN_UBW(Scissors, desc);
 			*desc = m_Scissors;
-		END_UBW(m_CurrentState, m_ScissorBuffer, "Scissors");
+		END_UBW(m_CurrentState, m_ScissorBuffer, "Scissors"_HASH);
 
 		GEngine->GetRenderDevice()->SetShader(m_CurrentState.Shader);
 		GEngine->GetRenderDevice()->BindShaderInputs(m_CurrentState, m_NeedsForceInputLayout);
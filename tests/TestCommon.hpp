@@ -0,0 +1,47 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <filesystem>
+#include <Aurora/Core/Types.hpp>
+
+// Shared by the test executables, each one is a single translation unit
+
+static int s_Failures = 0;
+
+#define TEST_CHECK(cond) do { if(!(cond)) { std::cout << "FAILED: " << #cond << " (" << __LINE__ << ")\n"; s_Failures++; } } while(false)
+
+// Prints the summary and returns the exit code of the test executable
+static int TestResult(const char* suiteName)
+{
+	if (s_Failures == 0)
+	{
+		std::cout << "All " << suiteName << " tests passed\n";
+	}
+
+	return s_Failures == 0 ? 0 : 1;
+}
+
+// Creates the parent directories and replaces the file
+[[maybe_unused]] static void WriteFile(const Path& path, std::span<const uint8_t> data)
+{
+	if (path.has_parent_path())
+		std::filesystem::create_directories(path.parent_path());
+
+	std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	stream.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)data.size());
+}
+
+[[maybe_unused]] static void WriteFile(const Path& path, std::string_view text)
+{
+	WriteFile(path, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+}
+
+[[maybe_unused]] static DataBlob ReadFile(const Path& path)
+{
+	std::ifstream stream(path, std::ios::in | std::ios::binary);
+	return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
\ No newline at end of file
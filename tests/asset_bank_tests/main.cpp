@@ -0,0 +1,230 @@
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <cstring>
+#include <filesystem>
+#include <Aurora/Core/Hash.hpp>
+#include <Aurora/Core/JobSystem.hpp>
+#include <Aurora/Resource/AssetBank.hpp>
+#include "../TestCommon.hpp"
+
+using namespace Aurora;
+
+static DataBlob RandomBlob(std::mt19937& rng, size_t size)
+{
+	DataBlob data(size);
+	for (uint8_t& byte : data)
+		byte = (uint8_t)rng();
+	return data;
+}
+
+// Repeating records with small changes, compresses like mesh data
+static DataBlob PatternBlob(std::mt19937& rng, size_t size)
+{
+	DataBlob data(size);
+	for (size_t i = 0; i < size; ++i)
+		data[i] = (uint8_t)((i % 32) * 7 + (rng() % 4 == 0 ? 1 : 0));
+	return data;
+}
+
+static DataBlob TextBlob(size_t lines)
+{
+	String text;
+	for (size_t i = 0; i < lines; ++i)
+		text += "vec4 color" + std::to_string(i) + " = texture(u_Texture, v_TexCoord * " + std::to_string(i % 7) + ".0);\n";
+	return {text.begin(), text.end()};
+}
+
+static bool SpanEquals(std::span<const uint8_t> span, const DataBlob& data)
+{
+	return span.size() == data.size() && (data.empty() || std::memcmp(span.data(), data.data(), data.size()) == 0);
+}
+
+static std::map<Path, DataBlob> CreateTestFiles()
+{
+	std::mt19937 rng(42);
+	std::map<Path, DataBlob> files;
+
+	files["Assets/empty.txt"] = {};
+	files["Assets/small.txt"] = RandomBlob(rng, 13);
+	files["Assets/Textures/page.bin"] = RandomBlob(rng, ABANK_PAGE_SIZE);
+	files["Assets/Textures/large.bin"] = RandomBlob(rng, ABANK_PAGE_SIZE * 3 + 7);
+
+	files["Assets/Shaders/test.glsl"] = TextBlob(500);
+	files["Assets/Meshes/test.amesh"] = PatternBlob(rng, 300000);
+	// Compressible, but png files are stored as they are
+	files["Assets/Textures/image.png"] = PatternBlob(rng, 10000);
+
+	for (int i = 0; i < 100; ++i)
+		files["Assets/Many/file" + std::to_string(i) + ".dat"] = RandomBlob(rng, rng() % 2000);
+
+	for (auto& [path, data] : files)
+		WriteFile(path, data);
+
+	return files;
+}
+
+static void TestPackageRoundTrip(const std::map<Path, DataBlob>& files)
+{
+	TEST_CHECK(AssetBank::CreatePackage("Assets", "test.abank"));
+
+	AssetPackage package;
+	TEST_CHECK(package.Open("test.abank"));
+	TEST_CHECK(package.GetVersion() == ABANK_VERSION);
+	TEST_CHECK(package.GetEntries().size() == files.size());
+
+	for (auto& [path, data] : files)
+	{
+		const ABankEntry* entry = package.Find(path.generic_string());
+		TEST_CHECK(entry != nullptr);
+
+		if (!entry)
+			continue;
+
+		TEST_CHECK(package.GetName(*entry) == path.generic_string());
+		TEST_CHECK(entry->Offset % ABANK_PAGE_SIZE == 0);
+		TEST_CHECK(entry->Size == data.size());
+
+		DataBlob readData;
+		TEST_CHECK(package.ReadFile(*entry, readData));
+		TEST_CHECK(readData == data);
+
+		if (entry->Compression == ECompressionCodec::None)
+			TEST_CHECK(SpanEquals(package.GetData(*entry), data));
+		else
+			TEST_CHECK(entry->CompressedSize > 0 && entry->CompressedSize < entry->Size);
+	}
+
+	TEST_CHECK(package.Find("Assets/Shaders/test.glsl")->Compression == ECompressionCodec::Zstd);
+	TEST_CHECK(package.Find("Assets/Meshes/test.amesh")->Compression == ECompressionCodec::LZ4);
+	TEST_CHECK(package.Find("Assets/Textures/image.png")->Compression == ECompressionCodec::None);
+	// Random data does not compress and is stored raw
+	TEST_CHECK(package.Find("Assets/Textures/large.bin")->Compression == ECompressionCodec::None);
+
+	TEST_CHECK(package.Find("Assets/missing.txt") == nullptr);
+	TEST_CHECK(package.Find("Assets/Many") == nullptr);
+
+	// Output does not depend on the thread count
+	JobSystem jobSystem(3);
+	TEST_CHECK(AssetBank::CreatePackage("Assets", "test_parallel.abank", &jobSystem));
+	TEST_CHECK(ReadFile("test.abank") == ReadFile("test_parallel.abank"));
+
+	TEST_CHECK(AssetBank::ReadAllFilesFromPackage("test.abank") == files);
+	TEST_CHECK(AssetBank::ReadAllFilesFromPackage("test.abank", &jobSystem) == files);
+}
+
+static void TestVersion2Package()
+{
+	String name = "Assets/old.txt";
+	DataBlob data = TextBlob(10);
+
+	ABankPackageHeader header = {};
+	header.Magic = ABANK_MAGIC;
+	header.Version = 2;
+	header.EntryCount = 1;
+	header.PageSize = ABANK_PAGE_SIZE;
+	header.EntriesOffset = sizeof(ABankPackageHeader);
+	header.StringPoolOffset = header.EntriesOffset + ABANK_V2_ENTRY_SIZE;
+	header.StringPoolSize = name.size();
+
+	ABankEntry entry = {};
+	entry.NameHash = Hash_FNV1a64(name);
+	entry.NameLength = (uint32_t)name.size();
+	entry.Offset = ABANK_PAGE_SIZE;
+	entry.Size = data.size();
+
+	DataBlob package(ABANK_PAGE_SIZE + data.size(), 0);
+	std::memcpy(package.data(), &header, sizeof(header));
+	std::memcpy(package.data() + header.EntriesOffset, &entry, ABANK_V2_ENTRY_SIZE);
+	std::memcpy(package.data() + header.StringPoolOffset, name.data(), name.size());
+	std::memcpy(package.data() + ABANK_PAGE_SIZE, data.data(), data.size());
+	WriteFile("test_v2.abank", package);
+
+	AssetPackage v2Package;
+	TEST_CHECK(v2Package.Open("test_v2.abank"));
+	TEST_CHECK(v2Package.GetVersion() == 2);
+
+	const ABankEntry* found = v2Package.Find(name);
+	DataBlob readData;
+	TEST_CHECK(found != nullptr && found->Compression == ECompressionCodec::None);
+	TEST_CHECK(found != nullptr && v2Package.ReadFile(*found, readData) && readData == data);
+}
+
+static void TestVersion1Package(const std::map<Path, DataBlob>& files)
+{
+	{ // Writer of the previous format
+		std::ofstream stream("test_v1.abank", std::ios::out | std::ios::binary);
+
+		auto fileCount = (int32_t)files.size();
+		stream.write(reinterpret_cast<const char*>(&fileCount), sizeof(fileCount));
+
+		uint32_t offset = sizeof(int32_t) + sizeof(ABankHeader) * fileCount;
+
+		for (auto& [path, data] : files)
+		{
+			ABankHeader header = {};
+			std::strcpy(header.Filename, path.string().c_str());
+			header.Offset = offset;
+			header.Size = (uint32_t)data.size();
+			header.CompressedSize = 0;
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			offset += (uint32_t)data.size();
+		}
+
+		for (auto& [path, data] : files)
+			stream.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)data.size());
+	}
+
+	AssetPackage package;
+	TEST_CHECK(package.Open("test_v1.abank"));
+	TEST_CHECK(package.GetVersion() == 1);
+	TEST_CHECK(package.GetEntries().size() == files.size());
+
+	for (auto& [path, data] : files)
+	{
+		const ABankEntry* entry = package.Find(path.generic_string());
+		DataBlob readData;
+		TEST_CHECK(entry != nullptr && package.ReadFile(*entry, readData) && readData == data);
+	}
+
+	TEST_CHECK(AssetBank::ReadAllFilesFromPackage("test_v1.abank") == files);
+}
+
+static void TestCorruptedPackage()
+{
+	DataBlob data(sizeof(ABankPackageHeader) + 16, 0);
+
+	ABankPackageHeader header = {};
+	header.Magic = ABANK_MAGIC;
+	header.Version = ABANK_VERSION;
+	header.EntryCount = 1000;
+	header.EntriesOffset = sizeof(ABankPackageHeader);
+	std::memcpy(data.data(), &header, sizeof(header));
+	WriteFile("corrupted.abank", data);
+
+	AssetPackage package;
+	TEST_CHECK(!package.Open("corrupted.abank"));
+	TEST_CHECK(package.GetEntries().empty());
+	TEST_CHECK(!package.Open("does_not_exist.abank"));
+}
+
+int main()
+{
+	Path testDirectory = std::filesystem::temp_directory_path() / "aurora_asset_bank_tests";
+	std::filesystem::remove_all(testDirectory);
+	std::filesystem::create_directories(testDirectory);
+	std::filesystem::current_path(testDirectory);
+
+	std::map<Path, DataBlob> files = CreateTestFiles();
+
+	TestPackageRoundTrip(files);
+	TestVersion2Package();
+	TestVersion1Package(files);
+	TestCorruptedPackage();
+
+	std::filesystem::current_path(testDirectory.parent_path());
+	std::filesystem::remove_all(testDirectory);
+
+	return TestResult("asset bank");
+}
@@ -0,0 +1,177 @@
+#include <iostream>
+#include <cstring>
+#include <Aurora/Graphics/StreamingRingAllocator.hpp>
+#include <Aurora/Graphics/BufferCache.hpp>
+#include <Aurora/Graphics/Null/NullRenderDevice.hpp>
+#include "../TestCommon.hpp"
+
+using namespace Aurora;
+
+static void TestAllocation()
+{
+	StreamingRingAllocator allocator(1024, 3);
+	TEST_CHECK(allocator.GetTotalSize() == 3072);
+	TEST_CHECK(allocator.GetCurrentRegion() == 0);
+
+	StreamingAllocation first = {};
+	TEST_CHECK(allocator.Allocate(100, 256, first));
+	TEST_CHECK(first.Offset == 0);
+	TEST_CHECK(first.Size == 100);
+
+	// Next one starts at the alignment
+	StreamingAllocation second = {};
+	TEST_CHECK(allocator.Allocate(16, 256, second));
+	TEST_CHECK(second.Offset == 256);
+	TEST_CHECK(allocator.GetUsedBytes() == 272);
+	TEST_CHECK(allocator.GetAllocatedBytes() == 116);
+
+	// Alignment that is not a power of two, like a vertex stride
+	StreamingAllocation vertices = {};
+	TEST_CHECK(allocator.Allocate(48, 24, vertices));
+	TEST_CHECK(vertices.Offset == 288);
+	TEST_CHECK(vertices.Offset % 24 == 0);
+
+	// Zero alignment packs
+	StreamingAllocation packed = {};
+	TEST_CHECK(allocator.Allocate(4, 0, packed));
+	TEST_CHECK(packed.Offset == 336);
+}
+
+static void TestRegionOverflow()
+{
+	StreamingRingAllocator allocator(1024, 3);
+
+	StreamingAllocation allocation = {};
+	TEST_CHECK(allocator.Allocate(768, 256, allocation));
+	TEST_CHECK(allocator.Allocate(256, 256, allocation));
+	TEST_CHECK(allocation.Offset + allocation.Size == 1024);
+
+	// A full region never spills into the next one, the GPU may still read it
+	TEST_CHECK(!allocator.Allocate(1, 1, allocation));
+	TEST_CHECK(allocator.GetFailedAllocations() == 1);
+	TEST_CHECK(allocation.Offset == 768);
+
+	// Padding counts against the region too
+	StreamingRingAllocator padded(1024, 2);
+	TEST_CHECK(padded.Allocate(1000, 256, allocation));
+	TEST_CHECK(!padded.Allocate(8, 256, allocation));
+
+	// Larger than a whole region
+	StreamingRingAllocator small(64, 3);
+	TEST_CHECK(!small.Allocate(65, 1, allocation));
+}
+
+static void TestRegionCycle()
+{
+	StreamingRingAllocator allocator(1000, 3);
+
+	StreamingAllocation allocation = {};
+	TEST_CHECK(allocator.Allocate(500, 256, allocation));
+	TEST_CHECK(!allocator.Allocate(600, 256, allocation));
+
+	TEST_CHECK(allocator.NextRegion() == 1);
+	TEST_CHECK(allocator.GetUsedBytes() == 0);
+	TEST_CHECK(allocator.GetAllocatedBytes() == 0);
+	TEST_CHECK(allocator.GetFailedAllocations() == 0);
+
+	// Region starts at 1000, the first aligned offset in it is 1024
+	TEST_CHECK(allocator.Allocate(100, 256, allocation));
+	TEST_CHECK(allocation.Offset == 1024);
+	TEST_CHECK(allocation.Offset >= allocator.GetRegionStart(1));
+
+	TEST_CHECK(allocator.NextRegion() == 2);
+	TEST_CHECK(allocator.Allocate(100, 1, allocation));
+	TEST_CHECK(allocation.Offset == 2000);
+
+	// Back at the start after the last region
+	TEST_CHECK(allocator.NextRegion() == 0);
+	TEST_CHECK(allocator.Allocate(100, 256, allocation));
+	TEST_CHECK(allocation.Offset == 0);
+}
+
+static void TestBufferCache()
+{
+	NullRenderDevice device;
+	RenderCommandRecorder recorder;
+	device.SetRecorder(&recorder);
+
+	BufferCache cache(&device, "Stream", EBufferType::UniformBuffer, 4096, 3);
+	TEST_CHECK(cache.GetBuffer() != nullptr);
+	TEST_CHECK(cache.GetBuffer()->GetDesc().ByteSize == 4096 * 3);
+	TEST_CHECK(cache.GetBuffer()->GetDesc().IsDMA);
+
+	// Uniform blocks use the offset alignment of the device
+	VBufferCacheIndex first;
+	uint8* firstData = cache.GetOrMap(16, first);
+	TEST_CHECK(firstData != nullptr);
+	std::memset(firstData, 0xAB, 16);
+	cache.Unmap(first);
+
+	VBufferCacheIndex second;
+	uint8* secondData = cache.GetOrMap(16, second);
+	TEST_CHECK(secondData != nullptr);
+	TEST_CHECK(second.Offset % device.GetUniformBufferOffsetAlignment() == 0);
+	TEST_CHECK(second.Offset == device.GetUniformBufferOffsetAlignment());
+	TEST_CHECK(second.Buffer == cache.GetBuffer());
+	TEST_CHECK(secondData - firstData == second.Offset - first.Offset);
+	TEST_CHECK(cache.GetNumBytesPerFrame() == 32);
+
+	// Writes land in the buffer memory directly
+	auto* nullBuffer = static_cast<NullBuffer*>(cache.GetBuffer().get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+	TEST_CHECK(nullBuffer->Data()[first.Offset] == 0xAB);
+	TEST_CHECK(recorder.GetCount(ERenderCommand::WriteBuffer) == 0);
+
+	// Too much for one frame
+	VBufferCacheIndex overflow;
+	TEST_CHECK(cache.GetOrMap(4096, overflow) == nullptr);
+	TEST_CHECK(overflow.Buffer == nullptr);
+
+	// The frame locks its region and waits for the next one
+	recorder.Clear();
+	cache.OnFrameEnd();
+	TEST_CHECK(recorder.GetCount(ERenderCommand::LockBufferRange) == 1);
+	TEST_CHECK(recorder.GetCount(ERenderCommand::WaitForBufferRange) == 1);
+	TEST_CHECK(recorder.GetCommands().size() == 2);
+
+	const RenderCommand& lock = recorder.GetCommands()[0];
+	const RenderCommand& wait = recorder.GetCommands()[1];
+	TEST_CHECK(lock.Type == ERenderCommand::LockBufferRange);
+	TEST_CHECK(lock.Args[0] == 0 && lock.Args[1] == 4096);
+	TEST_CHECK(wait.Type == ERenderCommand::WaitForBufferRange);
+	TEST_CHECK(wait.Args[0] == 4096 && wait.Args[1] == 4096);
+	TEST_CHECK(cache.GetNumBytesPerFrame() == 0);
+
+	// Next frame writes after the region the GPU may still read
+	VBufferCacheIndex nextFrame;
+	TEST_CHECK(cache.GetOrMap(16, nextFrame) != nullptr);
+	TEST_CHECK(nextFrame.Offset == 4096);
+
+	// Vertex data aligned to its stride
+	VBufferCacheIndex vertices;
+	TEST_CHECK(cache.GetOrMap(72, 24, vertices) != nullptr);
+	TEST_CHECK(vertices.Offset % 24 == 0);
+
+	// After all regions the first one is reused, once its fence was waited on
+	cache.OnFrameEnd();
+	recorder.Clear();
+	cache.OnFrameEnd();
+	TEST_CHECK(recorder.GetCommands().size() == 2);
+	TEST_CHECK(recorder.GetCommands()[0].Args[0] == 8192);
+	TEST_CHECK(recorder.GetCommands()[1].Args[0] == 0);
+
+	VBufferCacheIndex wrapped;
+	TEST_CHECK(cache.GetOrMap(16, wrapped) != nullptr);
+	TEST_CHECK(wrapped.Offset == 0);
+
+	device.SetRecorder(nullptr);
+}
+
+int main()
+{
+	TestAllocation();
+	TestRegionOverflow();
+	TestRegionCycle();
+	TestBufferCache();
+
+	return TestResult("buffer cache");
+}
\ No newline at end of file
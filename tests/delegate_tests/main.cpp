@@ -0,0 +1,182 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <Aurora/Core/Delegate.hpp>
+#include "../TestCommon.hpp"
+
+using namespace Aurora;
+
+static int s_FunctionCalls = 0;
+
+static void CountCall(int value)
+{
+	s_FunctionCalls += value;
+}
+
+struct Counter
+{
+	int Total = 0;
+
+	void Add(int value) { Total += value; }
+	[[nodiscard]] int Get(int offset) const { return Total + offset; }
+};
+
+// Counts live copies, to check the delegate destroys what it stores
+struct Tracked
+{
+	static inline int Alive = 0;
+	int* Target;
+	char Padding[128];
+
+	explicit Tracked(int* target) : Target(target), Padding() { Alive++; }
+	Tracked(const Tracked& other) : Target(other.Target), Padding() { Alive++; }
+	Tracked(Tracked&& other) noexcept : Target(other.Target), Padding() { Alive++; }
+	~Tracked() { Alive--; }
+
+	void operator()(int value) const { *Target += value; }
+};
+
+static void TestDelegate()
+{
+	s_FunctionCalls = 0;
+	Delegate<void, int> function(&CountCall);
+	function.Invoke(2);
+	TEST_CHECK(s_FunctionCalls == 2);
+
+	Counter counter;
+	Delegate<void, int> method(&counter, &Counter::Add);
+	method.Invoke(3);
+	TEST_CHECK(counter.Total == 3);
+
+	Delegate<int, int> constMethod(static_cast<const Counter*>(&counter), &Counter::Get);
+	TEST_CHECK(constMethod.Invoke(1) == 4);
+
+	int captured = 10;
+	Delegate<int, int> lambda([captured](int value) { return captured + value; });
+	TEST_CHECK(lambda.Invoke(5) == 15);
+
+	Delegate<void, int> empty;
+	TEST_CHECK(!empty && !empty.IsBound());
+
+	// Does not fit inline
+	int target = 0;
+	{
+		Delegate<void, int> large(Tracked{&target});
+		TEST_CHECK(Tracked::Alive == 1);
+
+		Delegate<void, int> moved(std::move(large));
+		TEST_CHECK(!large && moved);
+		moved.InvokeCopy(7);
+		TEST_CHECK(target == 7);
+		TEST_CHECK(Tracked::Alive == 1);
+	}
+	TEST_CHECK(Tracked::Alive == 0);
+
+	// Fits inline but is not trivially copyable
+	{
+		std::string text = "abc";
+		Delegate<size_t> stringLambda([text]() { return text.size(); });
+		Delegate<size_t> moved;
+		moved = std::move(stringLambda);
+		TEST_CHECK(moved.Invoke() == 3);
+	}
+}
+
+static void TestEmitter()
+{
+	EventEmitter<int> emitter;
+	std::vector<int> order;
+
+	EventID first = emitter.Bind([&order](int value) { order.push_back(value); });
+	EventID second = emitter.Bind([&order](int value) { order.push_back(value * 10); });
+	Counter counter;
+	emitter.Bind(&counter, &Counter::Add);
+
+	TEST_CHECK(first != 0 && second > first);
+	TEST_CHECK(emitter.GetListenerCount() == 3);
+
+	emitter.Invoke(1);
+	TEST_CHECK(order.size() == 2 && order[0] == 1 && order[1] == 10);
+	TEST_CHECK(counter.Total == 1);
+
+	TEST_CHECK(emitter.Unbind(first));
+	TEST_CHECK(!emitter.Unbind(first));
+	TEST_CHECK(!emitter.Unbind(0));
+
+	order.clear();
+	emitter.Invoke(2);
+	TEST_CHECK(order.size() == 1 && order[0] == 20);
+	TEST_CHECK(emitter.GetListenerCount() == 2);
+
+	{
+		UniqueEvent unique = emitter.BindUnique(&CountCall);
+		TEST_CHECK(emitter.GetListenerCount() == 3);
+	}
+	TEST_CHECK(emitter.GetListenerCount() == 2);
+}
+
+static void TestUnbindDuringInvoke()
+{
+	EventEmitter<int> emitter;
+	std::vector<int> calls;
+
+	// Unbinds itself, its captures stay alive until the dispatch ends
+	EventID self = 0;
+	std::string name = "self";
+	self = emitter.Bind([&emitter, &self, &calls, name](int)
+	{
+		emitter.Unbind(self);
+		calls.push_back((int)name.size());
+	});
+
+	// Unbinds the next listener before it runs
+	EventID next = 0;
+	emitter.Bind([&emitter, &next, &calls](int)
+	{
+		emitter.Unbind(next);
+		calls.push_back(1);
+	});
+	next = emitter.Bind([&calls](int) { calls.push_back(2); });
+
+	// Bound listeners only run from the next Invoke
+	EventID added = 0;
+	emitter.Bind([&emitter, &added, &calls](int)
+	{
+		if (added == 0)
+			added = emitter.Bind([&calls](int) { calls.push_back(3); });
+	});
+
+	emitter.Invoke(0);
+	TEST_CHECK(calls.size() == 2 && calls[0] == 4 && calls[1] == 1);
+	TEST_CHECK(emitter.GetListenerCount() == 3);
+
+	calls.clear();
+	emitter.Invoke(0);
+	TEST_CHECK(calls.size() == 2 && calls[0] == 1 && calls[1] == 3);
+
+	// The newest listener keeps the highest id, unbinding by id still works after the merge
+	TEST_CHECK(emitter.Unbind(added));
+	TEST_CHECK(emitter.GetListenerCount() == 2);
+
+	// Bound and unbound in the same Invoke
+	EventEmitter<> nested;
+	int nestedCalls = 0;
+	nested.Bind([&nested, &nestedCalls]()
+	{
+		EventID temporary = nested.Bind([&nestedCalls]() { nestedCalls++; });
+		nested.Unbind(temporary);
+	});
+	nested.Invoke();
+	nested.Invoke();
+	TEST_CHECK(nestedCalls == 0);
+	TEST_CHECK(nested.GetListenerCount() == 1);
+}
+
+int main()
+{
+	TestDelegate();
+	TestEmitter();
+	TestUnbindDuringInvoke();
+
+	return TestResult("delegate");
+}
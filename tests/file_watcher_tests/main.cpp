@@ -0,0 +1,254 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Aurora/Core/FileWatcher.hpp>
+#include <Aurora/Resource/FileTree.hpp>
+#include "../TestCommon.hpp"
+
+using namespace Aurora;
+
+struct RecordedEvent
+{
+	EFileAction Action;
+	Path FilePath;
+	Path PrevPath;
+};
+
+// Applies the events to a tree the same way the resource manager does
+struct WatchedTree
+{
+	FileWatcher Watcher;
+	FileTree Tree;
+	std::vector<RecordedEvent> Events;
+
+	explicit WatchedTree(const Path& root) : Watcher(root, 20), Tree(root)
+	{
+		Watcher.GetEmitter().Bind(this, &WatchedTree::OnChanged);
+	}
+
+	void OnChanged(EFileAction action, const Path& path, const Path& prevPath)
+	{
+		Events.push_back({action, path, prevPath});
+
+		switch (action)
+		{
+			case EFileAction::Added:
+				Tree.AddFile(path);
+				break;
+			case EFileAction::Renamed:
+				Tree.RenameFile(path, prevPath);
+				break;
+			case EFileAction::Removed:
+				Tree.RemoveFile(path);
+				break;
+			case EFileAction::Overflow:
+				Tree.Rescan();
+				break;
+			default: break;
+		}
+	}
+
+	// Waits for the expected events, then a bit longer to catch events that should not be there
+	std::vector<RecordedEvent> Wait(size_t expectedCount)
+	{
+		Events.clear();
+
+		auto begin = std::chrono::steady_clock::now();
+		while (Events.size() < expectedCount && std::chrono::steady_clock::now() - begin < std::chrono::seconds(5))
+		{
+			Watcher.Update();
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+
+		for (int i = 0; i < 20; ++i)
+		{
+			Watcher.Update();
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+
+		return Events;
+	}
+};
+
+static void CollectPaths(const PathNode& node, std::vector<std::string>& paths)
+{
+	for (const PathNode& child : node)
+	{
+		paths.push_back(child.Path.string() + (child.IsDirectory ? "/" : ""));
+		TEST_CHECK(child.ParentNode == &node);
+		CollectPaths(child, paths);
+	}
+}
+
+static bool MatchesDisk(const FileTree& tree, const Path& root)
+{
+	std::vector<std::string> treePaths;
+	std::vector<std::string> diskPaths;
+	CollectPaths(tree, treePaths);
+	CollectPaths(FileTree(root), diskPaths);
+
+	std::sort(treePaths.begin(), treePaths.end());
+	std::sort(diskPaths.begin(), diskPaths.end());
+	return treePaths == diskPaths;
+}
+
+static bool IsEvent(const RecordedEvent& event, EFileAction action, const Path& path, const Path& prevPath = {})
+{
+	return event.Action == action && event.FilePath == path && event.PrevPath == prevPath;
+}
+
+static void TestWatcher(const Path& root)
+{
+	WatchedTree watched(root);
+
+	// A new file is added and written, listeners only hear it was added
+	WriteFile(root / "a.txt", "a");
+	std::vector<RecordedEvent> events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Added, root / "a.txt"));
+
+	// A burst of saves is one modification
+	for (int i = 0; i < 5; ++i)
+		WriteFile(root / "a.txt", std::to_string(i));
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Modified, root / "a.txt"));
+
+	// Saved through a temporary file moved over the original
+	WriteFile(root / "a.txt.tmp", "saved");
+	std::filesystem::rename(root / "a.txt.tmp", root / "a.txt");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Modified, root / "a.txt"));
+
+	// A file listeners know moved over another one
+	WriteFile(root / "d.txt", "d");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Added, root / "d.txt"));
+
+	std::filesystem::rename(root / "d.txt", root / "a.txt");
+	events = watched.Wait(2);
+	TEST_CHECK(events.size() == 2 && IsEvent(events[0], EFileAction::Removed, root / "d.txt") && IsEvent(events[1], EFileAction::Modified, root / "a.txt"));
+
+	// Removed files are new again when they come back later
+	std::filesystem::remove(root / "a.txt");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Removed, root / "a.txt"));
+
+	WriteFile(root / "a.txt", "a");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Added, root / "a.txt"));
+
+	// Files that come and go within a burst are never reported
+	WriteFile(root / "lock", "");
+	std::filesystem::remove(root / "lock");
+	events = watched.Wait(0);
+	TEST_CHECK(events.empty());
+
+	std::filesystem::rename(root / "a.txt", root / "b.txt");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Renamed, root / "b.txt", root / "a.txt"));
+
+	// New directories are watched as well
+	std::filesystem::create_directory(root / "sub");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Added, root / "sub"));
+
+	WriteFile(root / "sub" / "c.txt", "c");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Added, root / "sub" / "c.txt"));
+
+	// Files of a renamed directory are reported under the new name
+	std::filesystem::rename(root / "sub", root / "moved");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Renamed, root / "moved", root / "sub"));
+
+	WriteFile(root / "moved" / "c.txt", "changed");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Modified, root / "moved" / "c.txt"));
+
+	// A file moved to another directory of the tree
+	std::filesystem::rename(root / "b.txt", root / "moved" / "b.txt");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Renamed, root / "moved" / "b.txt", root / "b.txt"));
+
+	// Moved out of the watched directory
+	Path outside = root.parent_path() / "aurora_file_watcher_outside";
+	std::filesystem::remove_all(outside);
+	std::filesystem::rename(root / "moved", outside);
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Removed, root / "moved"));
+
+	// Its watches are gone with it
+	WriteFile(outside / "c.txt", "outside");
+	events = watched.Wait(0);
+	TEST_CHECK(events.empty());
+
+	// Moved in, the files inside come with the directory
+	std::filesystem::rename(outside, root / "back");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Added, root / "back"));
+
+	// Files of a directory moved in are known as well
+	WriteFile(root / "back" / "c.txt.tmp", "saved");
+	std::filesystem::rename(root / "back" / "c.txt.tmp", root / "back" / "c.txt");
+	events = watched.Wait(1);
+	TEST_CHECK(events.size() == 1 && IsEvent(events[0], EFileAction::Modified, root / "back" / "c.txt"));
+
+	std::filesystem::remove_all(root / "back");
+	events = watched.Wait(3);
+	TEST_CHECK(!events.empty() && events.back().Action == EFileAction::Removed && events.back().FilePath == root / "back");
+
+	TEST_CHECK(MatchesDisk(watched.Tree, root));
+}
+
+static void TestTree(const Path& root)
+{
+	std::filesystem::create_directories(root / "x" / "y");
+	WriteFile(root / "x" / "y" / "z.txt", "z");
+	for (int i = 0; i < 32; ++i)
+		WriteFile(root / ("file" + std::to_string(i)), "");
+
+	FileTree tree(root);
+	TEST_CHECK(MatchesDisk(tree, root));
+	TEST_CHECK(tree.Find(root / "x" / "y" / "z.txt") != nullptr);
+	TEST_CHECK(tree.Find(root / "x" / "missing") == nullptr);
+	TEST_CHECK(tree.Find(root.parent_path()) == nullptr);
+
+	// Directories created together with their files are added whole
+	std::filesystem::create_directories(root / "new" / "deep");
+	WriteFile(root / "new" / "deep" / "file.txt", "");
+	TEST_CHECK(tree.AddFile(root / "new" / "deep" / "file.txt"));
+	TEST_CHECK(!tree.AddFile(root / "new"));
+	TEST_CHECK(MatchesDisk(tree, root));
+
+	std::filesystem::rename(root / "x", root / "new" / "x");
+	TEST_CHECK(tree.RenameFile(root / "new" / "x", root / "x"));
+	TEST_CHECK(tree.Find(root / "new" / "x" / "y" / "z.txt") != nullptr);
+	TEST_CHECK(MatchesDisk(tree, root));
+
+	std::filesystem::remove_all(root / "new");
+	TEST_CHECK(tree.RemoveFile(root / "new"));
+	TEST_CHECK(!tree.RemoveFile(root / "new"));
+	TEST_CHECK(!tree.RemoveFile(root));
+	TEST_CHECK(MatchesDisk(tree, root));
+}
+
+int main()
+{
+	Path root = std::filesystem::temp_directory_path() / "aurora_file_watcher_tests";
+	std::filesystem::remove_all(root);
+	std::filesystem::create_directories(root / "watched");
+	std::filesystem::create_directories(root / "tree");
+
+	TestTree(root / "tree");
+#if defined(__linux__)
+	TestWatcher(root / "watched");
+#endif
+
+	std::filesystem::remove_all(root);
+
+	return TestResult("file watcher");
+}
@@ -0,0 +1,235 @@
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <Aurora/HeadlessEngine.hpp>
+#include <Aurora/Graphics/Null/NullRenderDevice.hpp>
+#include <Aurora/Graphics/Material/MaterialDefinition.hpp>
+#include <Aurora/Resource/ResourceManager.hpp>
+#include <Aurora/Framework/Mesh/Mesh.hpp>
+#include <Aurora/Render/GeometryPool.hpp>
+#include <Aurora/Render/IndirectDrawBuilder.hpp>
+#include <Aurora/Render/SceneRenderer.hpp>
+#include "../TestCommon.hpp"
+
+using namespace Aurora;
+
+// Flat grid with size * size quads, one section per row of quads
+static StaticMesh_ptr CreateGridMesh(uint32_t size, EPrimitiveType primitiveType = EPrimitiveType::TriangleList)
+{
+	StaticMesh_ptr mesh = std::make_shared<StaticMesh>();
+
+	MeshLodResource* lodResource;
+	VertexBuffer<StaticMesh::Vertex>* vertexBuffer = mesh->CreateVertexBuffer<StaticMesh::Vertex>(0, &lodResource);
+	vertexBuffer->Inflate((size + 1) * (size + 1));
+
+	for (uint32_t y = 0; y <= size; ++y)
+	{
+		for (uint32_t x = 0; x <= size; ++x)
+		{
+			StaticMesh::Vertex vertex = {};
+			vertex.Position = Vector3((float)x, 0.0f, (float)y);
+			vertexBuffer->Add(vertex);
+		}
+	}
+
+	for (uint32_t y = 0; y < size; ++y)
+	{
+		FMeshSection section;
+		section.FirstIndex = (Index_t)lodResource->Indices.size();
+		section.PrimitiveType = primitiveType;
+
+		for (uint32_t x = 0; x < size; ++x)
+		{
+			Index_t i = y * (size + 1) + x;
+			lodResource->Indices.insert(lodResource->Indices.end(), {i, i + size + 1, i + 1, i + 1, i + size + 1, i + size + 2});
+		}
+
+		section.NumTriangles = (Index_t)lodResource->Indices.size() - section.FirstIndex;
+		lodResource->Sections.push_back(section);
+	}
+
+	mesh->UploadToGPU(true);
+	return mesh;
+}
+
+static ModelContext CreateContext(const std::shared_ptr<Material>& material, const StaticMesh_ptr& mesh, uint32_t section, std::span<const Matrix4> instances)
+{
+	MeshLodResource* lodResource = &mesh->LODResources[0];
+	return {material.get(), mesh.get(), lodResource, &lodResource->Sections[section], nullptr, instances};
+}
+
+static void TestGeometryPool(HeadlessEngine& engine)
+{
+	NullRenderDevice* renderDevice = engine.GetRenderDevice();
+
+	StaticMesh_ptr quad = CreateGridMesh(1); // 4 vertices, 6 indices
+	StaticMesh_ptr grid = CreateGridMesh(2); // 9 vertices, 24 indices
+	StaticMesh_ptr large = CreateGridMesh(4); // 25 vertices, 96 indices
+
+	GeometryPool pool(renderDevice, "Test", quad->GetVertexLayoutDesc(), 64, 64);
+	TEST_CHECK(pool.GetVertexStride() == sizeof(StaticMesh::Vertex));
+
+	MeshLodResource& quadLod = quad->LODResources[0];
+	const GeometryPoolEntry* quadEntry = pool.GetOrAdd(&quadLod);
+	TEST_CHECK(quadEntry != nullptr);
+	TEST_CHECK(quadEntry->BaseVertex == 0 && quadEntry->FirstIndex == 0);
+	TEST_CHECK(quadEntry->VertexCount == 4 && quadEntry->IndexCount == 6);
+
+	const GeometryPoolEntry* gridEntry = pool.GetOrAdd(&grid->LODResources[0]);
+	TEST_CHECK(gridEntry != nullptr);
+	TEST_CHECK(gridEntry->BaseVertex == 4 && gridEntry->FirstIndex == 6);
+	TEST_CHECK(gridEntry->VertexCount == 9 && gridEntry->IndexCount == 24);
+
+	// Second lookup does not copy again
+	TEST_CHECK(pool.GetOrAdd(&quadLod) == quadEntry);
+	TEST_CHECK(pool.GetVertexCount() == 13 && pool.GetIndexCount() == 30);
+	TEST_CHECK(pool.GetEntryCount() == 2);
+
+	// Indices are copied as they are, the draw commands add the base vertex
+	auto* indices = renderDevice->MapBuffer<Index_t>(pool.GetIndexBuffer(), EBufferAccess::ReadOnly);
+	TEST_CHECK(std::memcmp(indices + gridEntry->FirstIndex, grid->LODResources[0].Indices.data(), 24 * sizeof(Index_t)) == 0);
+	renderDevice->UnmapBuffer(pool.GetIndexBuffer());
+
+	// Does not fit, nothing is taken
+	TEST_CHECK(pool.GetOrAdd(&large->LODResources[0]) == nullptr);
+	TEST_CHECK(pool.GetVertexCount() == 13 && pool.GetIndexCount() == 30);
+	TEST_CHECK(pool.GetEntryCount() == 2);
+
+	// Only 32 bit indices
+	StaticMesh_ptr shortIndices = CreateGridMesh(1);
+	shortIndices->LODResources[0].IndexFormat = EIndexBufferFormat::Uint16;
+	TEST_CHECK(pool.GetOrAdd(&shortIndices->LODResources[0]) == nullptr);
+
+	// One more vertex recreates the vertex buffer, the entry moves to the end of the pool
+	UniqueIdentifier oldVertexBufferID = quadLod.VertexBuffer->GetUniqueID();
+	static_cast<VertexBuffer<StaticMesh::Vertex>*>(quadLod.Vertices.get())->Add(StaticMesh::Vertex());
+	quad->UploadToGPU(true);
+	TEST_CHECK(quadLod.VertexBuffer->GetUniqueID() != oldVertexBufferID);
+
+	const GeometryPoolEntry* movedEntry = pool.GetOrAdd(&quadLod);
+	TEST_CHECK(movedEntry != nullptr);
+	TEST_CHECK(movedEntry->VertexBufferID == quadLod.VertexBuffer->GetUniqueID());
+	TEST_CHECK(movedEntry->BaseVertex == 13 && movedEntry->VertexCount == 5);
+	TEST_CHECK(movedEntry->FirstIndex == 30 && movedEntry->IndexCount == 6);
+	TEST_CHECK(pool.GetVertexCount() == 18 && pool.GetIndexCount() == 36);
+	TEST_CHECK(pool.GetEntryCount() == 2);
+}
+
+static void TestBuild(HeadlessEngine& engine)
+{
+	auto matDef = engine.GetResourceManager()->GetOrLoadMaterialDefinition("Assets/Materials/Base/Textured.matd");
+	TEST_CHECK(matDef != nullptr);
+
+	if (matDef == nullptr)
+		return;
+
+	std::shared_ptr<Material> first = matDef->CreateInstance();
+	std::shared_ptr<Material> second = matDef->CreateInstance();
+
+	StaticMesh_ptr quad = CreateGridMesh(1); // 4 vertices, 6 indices, one section
+	StaticMesh_ptr grid = CreateGridMesh(2); // 9 vertices, 24 indices, two sections of 12
+	StaticMesh_ptr lines = CreateGridMesh(1, EPrimitiveType::LineList);
+	StaticMesh_ptr large = CreateGridMesh(4); // Does not fit the pool
+
+	std::vector<Matrix4> transforms;
+	for (int i = 0; i < 8; ++i)
+	{
+		transforms.push_back(glm::translate(Vector3((float)i, 0, 0)));
+	}
+
+	std::span<const Matrix4> instances(transforms);
+
+	RenderSet renderSet;
+	renderSet.push_back(CreateContext(first, quad, 0, instances.subspan(0, 2)));
+	renderSet.push_back(CreateContext(first, grid, 1, instances.subspan(2, 1)));
+	renderSet.push_back(CreateContext(second, quad, 0, instances.subspan(3, 3)));
+	renderSet.push_back(CreateContext(second, lines, 0, instances.subspan(6, 1)));
+	renderSet.push_back(CreateContext(first, lines, 0, instances.subspan(6, 1)));
+	renderSet.push_back(CreateContext(second, grid, 0, instances.subspan(7, 1)));
+	renderSet.push_back(CreateContext(first, large, 0, instances.subspan(0, 1)));
+
+	IndirectDrawBuilder builder(engine.GetRenderDevice(), 64, 64);
+
+	RenderSet fallbackSet;
+	builder.Build(renderSet, fallbackSet);
+
+	// Quad at vertex 0 and index 0, grid at vertex 4 and index 6
+	const std::vector<DrawElementsIndirectCommand>& commands = builder.GetCommands();
+	TEST_CHECK(commands.size() == 4);
+
+	if (commands.size() == 4)
+	{
+		TEST_CHECK(commands[0].count == 6 && commands[0].instanceCount == 2);
+		TEST_CHECK(commands[0].firstIndex == 0 && commands[0].baseVertex == 0 && commands[0].baseInstance == 0);
+
+		TEST_CHECK(commands[1].count == 12 && commands[1].instanceCount == 1);
+		TEST_CHECK(commands[1].firstIndex == 6 + 12 && commands[1].baseVertex == 4 && commands[1].baseInstance == 2);
+
+		TEST_CHECK(commands[2].count == 6 && commands[2].instanceCount == 3);
+		TEST_CHECK(commands[2].firstIndex == 0 && commands[2].baseVertex == 0 && commands[2].baseInstance == 3);
+
+		TEST_CHECK(commands[3].count == 12 && commands[3].instanceCount == 1);
+		TEST_CHECK(commands[3].firstIndex == 6 && commands[3].baseVertex == 4 && commands[3].baseInstance == 6);
+	}
+
+	// Instances follow the commands, materials are numbered in order of appearance
+	const std::vector<IndirectInstance>& builtInstances = builder.GetInstances();
+	TEST_CHECK(builtInstances.size() == 7);
+	TEST_CHECK(builder.GetMaterials().size() == 2);
+	TEST_CHECK(builder.GetMaterials().size() == 2 && builder.GetMaterials()[0] == first.get() && builder.GetMaterials()[1] == second.get());
+
+	if (builtInstances.size() == 7)
+	{
+		TEST_CHECK(builtInstances[1].Transform == transforms[1] && builtInstances[1].MaterialIndex == 0);
+		TEST_CHECK(builtInstances[2].Transform == transforms[2] && builtInstances[2].MaterialIndex == 0);
+		TEST_CHECK(builtInstances[5].Transform == transforms[5] && builtInstances[5].MaterialIndex == 1);
+		TEST_CHECK(builtInstances[6].Transform == transforms[7] && builtInstances[6].MaterialIndex == 1);
+	}
+
+	// Fallback contexts keep their order, one run covers both materials
+	TEST_CHECK(fallbackSet.size() == 3);
+
+	if (fallbackSet.size() == 3)
+	{
+		TEST_CHECK(fallbackSet[0].Mesh == lines.get() && fallbackSet[0].Material == second.get());
+		TEST_CHECK(fallbackSet[1].Mesh == lines.get() && fallbackSet[1].Material == first.get());
+		TEST_CHECK(fallbackSet[2].Mesh == large.get());
+	}
+
+	GeometryPool* pool = builder.GetPool(quad.get());
+	const std::vector<IndirectDrawBatch>& batches = builder.GetBatches();
+	TEST_CHECK(batches.size() == 5);
+
+	if (batches.size() == 5)
+	{
+		TEST_CHECK(batches[0].Material == first.get() && batches[0].Pool == pool && batches[0].First == 0 && batches[0].Count == 2);
+		TEST_CHECK(batches[1].Material == second.get() && batches[1].Pool == pool && batches[1].First == 2 && batches[1].Count == 1);
+		TEST_CHECK(batches[2].Pool == nullptr && batches[2].First == 0 && batches[2].Count == 2);
+		// Same material as the second batch, but the fallback run is drawn in between
+		TEST_CHECK(batches[3].Material == second.get() && batches[3].Pool == pool && batches[3].First == 3 && batches[3].Count == 1);
+		TEST_CHECK(batches[4].Material == first.get() && batches[4].Pool == nullptr && batches[4].First == 2 && batches[4].Count == 1);
+	}
+
+	// Next pass reuses the entries
+	uint32_t vertexCount = pool->GetVertexCount();
+
+	RenderSet nextFallbackSet;
+	builder.Build(std::span<const ModelContext>(renderSet).first(2), nextFallbackSet);
+	TEST_CHECK(builder.GetCommands().size() == 2);
+	TEST_CHECK(builder.GetBatches().size() == 1);
+	TEST_CHECK(nextFallbackSet.empty());
+	TEST_CHECK(pool->GetVertexCount() == vertexCount);
+	TEST_CHECK(pool->GetEntryCount() == 2);
+}
+
+int main()
+{
+	HeadlessEngine engine;
+
+	engine.BeginFrame();
+	TestGeometryPool(engine);
+	TestBuild(engine);
+	engine.EndFrame();
+
+	return TestResult("indirect draw");
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+// Info messages are compiled out in this test, whatever the build sets
+#undef AU_LOG_MIN_SEVERITY
+#define AU_LOG_MIN_SEVERITY 1
+
+#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Aurora/Logger/Logger.hpp>
+#include "../TestCommon.hpp"
+
+using namespace Aurora;
+
+class CaptureSink : public Logger::Sink
+{
+public:
+	std::mutex Mutex;
+	std::vector<std::string> Messages;
+	std::vector<std::string> Files;
+	uint32_t FlushCount = 0;
+
+	void Log(const Logger::Severity& severity, const std::string& severityStr, const std::string& file, const std::string& function, int line, const std::string& message) override
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		Messages.push_back(message);
+		Files.push_back(file);
+	}
+
+	void Flush() override
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		FlushCount++;
+	}
+
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		Messages.clear();
+		Files.clear();
+		FlushCount = 0;
+	}
+};
+
+static void TestCompileTimeFilter(CaptureSink& sink)
+{
+	int evaluated = 0;
+	AU_LOG_INFO("Not compiled ", ++evaluated);
+	AU_LOG_WARNING("Compiled ", ++evaluated);
+	Logger::Flush();
+
+	TEST_CHECK(evaluated == 1);
+	TEST_CHECK(sink.Messages.size() == 1 && sink.Messages[0] == "Compiled 1");
+	TEST_CHECK(sink.Files.size() == 1 && sink.Files[0] == "main.cpp");
+	TEST_CHECK(sink.FlushCount > 0);
+}
+
+// Errors are never dropped, and messages of one thread keep their order
+static void TestThreads(CaptureSink& sink)
+{
+	static const uint32_t threadCount = 4;
+	static const uint32_t messageCount = 5000;
+
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([t]()
+		{
+			for (uint32_t i = 0; i < messageCount; ++i)
+				AU_LOG_ERROR(t, " ", i);
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	Logger::Flush();
+
+	TEST_CHECK(sink.Messages.size() == threadCount * messageCount);
+
+	std::vector<int64_t> last(threadCount, -1);
+	bool ordered = true;
+	for (const std::string& message : sink.Messages)
+	{
+		size_t space = message.find(' ');
+		uint32_t thread = (uint32_t)std::stoul(message.substr(0, space));
+		int64_t index = std::stoll(message.substr(space + 1));
+
+		ordered &= thread < threadCount && index == last[thread] + 1;
+		if (thread < threadCount)
+			last[thread] = index;
+	}
+	TEST_CHECK(ordered);
+}
+
+// One call site for the whole test
+static void LogFlood(uint32_t count)
+{
+	for (uint32_t i = 0; i < count; ++i)
+		AU_LOG_WARNING("Flood");
+}
+
+static void TestRateLimit(CaptureSink& sink)
+{
+	Logger::SetRateLimit(10);
+	LogFlood(100);
+
+	Logger::Flush();
+
+	// The loop may span two windows
+	TEST_CHECK(sink.Messages.size() >= 10 && sink.Messages.size() <= 20);
+
+	sink.Clear();
+	std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+
+	// The count of suppressed messages goes with the next message of the call site
+	LogFlood(2);
+
+	Logger::Flush();
+
+	TEST_CHECK(sink.Messages.size() == 2);
+	TEST_CHECK(!sink.Messages.empty() && sink.Messages[0].find("similar messages suppressed") != std::string::npos);
+
+	Logger::SetRateLimit(0);
+}
+
+static void TestSynchronous(CaptureSink& sink)
+{
+	Logger::SetAsynchronous(false);
+	TEST_CHECK(!Logger::IsAsynchronous());
+
+	AU_LOG_WARNING("Synchronous");
+	TEST_CHECK(sink.Messages.size() == 1 && sink.Messages[0] == "Synchronous");
+
+	Logger::SetAsynchronous(true);
+	TEST_CHECK(Logger::IsAsynchronous());
+}
+
+static void TestFormatting(CaptureSink& sink)
+{
+	AU_LOG_WARNING(std::hex, 255, " ", 1.5f);
+	AU_LOG_WARNING(255);
+
+	std::string longMessage(1000, 'a');
+	AU_LOG_WARNING(longMessage);
+
+	Logger::Flush();
+
+	TEST_CHECK(sink.Messages.size() == 3);
+	TEST_CHECK(sink.Messages.size() > 0 && sink.Messages[0] == "ff 1.5");
+	TEST_CHECK(sink.Messages.size() > 1 && sink.Messages[1] == "255");
+	TEST_CHECK(sink.Messages.size() > 2 && sink.Messages[2] == longMessage);
+}
+
+int main()
+{
+	std::shared_ptr<CaptureSink> sink = Logger::AddSink<CaptureSink>();
+	Logger::SetRateLimit(0);
+
+	TestCompileTimeFilter(*sink);
+	sink->Clear();
+	TestThreads(*sink);
+	sink->Clear();
+	TestRateLimit(*sink);
+	sink->Clear();
+	TestSynchronous(*sink);
+	sink->Clear();
+	TestFormatting(*sink);
+
+	TEST_CHECK(Logger::RemoveSink(sink));
+	TEST_CHECK(!Logger::RemoveSink(sink));
+
+	return TestResult("logger");
+}
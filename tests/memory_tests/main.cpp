@@ -1,12 +1,351 @@
 #include <iostream>
+#include <random>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <new>
 #include <Aurora/Memory/Aum.hpp>
+#include <Aurora/Memory/FrameAllocator.hpp>
+#include <Aurora/Memory/ThreadArena.hpp>
+#include "../TestCommon.hpp"
 
 using namespace Aurora;
 
+// Count every global heap allocation of this process
+static std::atomic<size_t> s_HeapAllocations = 0;
+
+void* operator new(std::size_t size)
+{
+	s_HeapAllocations++;
+	if (void* ptr = std::malloc(size == 0 ? 1 : size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	s_HeapAllocations++;
+	if (void* ptr = std::malloc(size == 0 ? 1 : size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
 // *
 
+static void TestSizeClassChurn()
+{
+	Aum allocator(1024 * 1024, Aum::EMode::SizeClass);
+
+	std::mt19937 rng(42);
+	std::vector<std::pair<MemPtr, MemSize>> live;
+
+	for (int i = 0; i < 100000; ++i)
+	{
+		if (live.empty() || rng() % 2)
+		{
+			MemSize size = 1 + rng() % 4096;
+			MemPtr ptr = allocator.Alloc(size);
+
+			TEST_CHECK(IsAligned((uintptr_t)ptr, 16));
+			TEST_CHECK(allocator.CheckMemory(ptr));
+
+			std::memset(ptr, (int)(size & 0xFF), size);
+			live.emplace_back(ptr, size);
+		}
+		else
+		{
+			size_t index = rng() % live.size();
+			auto [ptr, size] = live[index];
+
+			// Neighbour writes must not overlap this allocation
+			TEST_CHECK(ptr[0] == (uint8_t)(size & 0xFF) && ptr[size - 1] == (uint8_t)(size & 0xFF));
+
+			allocator.DeAlloc(ptr);
+			live[index] = live.back();
+			live.pop_back();
+		}
+	}
+
+	TEST_CHECK(allocator.GetStats().AllocationCount == live.size());
+	TEST_CHECK(allocator.GetAllocationCount() == live.size());
+	TEST_CHECK(allocator.GetUsedBytes() == allocator.GetStats().UsedBytes);
+
+	for (auto& [ptr, size] : live)
+	{
+		allocator.DeAlloc(ptr);
+	}
+
+	// Everything freed has to coalesce back into one fragment per block
+	Aum::Stats stats = allocator.GetStats();
+	TEST_CHECK(stats.AllocationCount == 0);
+	TEST_CHECK(stats.FreeFragmentCount == stats.BlockCount);
+	TEST_CHECK(stats.UsedBytes == stats.BlockCount * 16); // Only block sentinels are left
+	TEST_CHECK(allocator.GetUsedBytes() == stats.UsedBytes);
+	TEST_CHECK(stats.GetFragmentation() < 1.0);
+}
+
+static void TestSizeClassCoalescing()
+{
+	Aum allocator(64 * 1024, Aum::EMode::SizeClass);
+
+	MemPtr a = allocator.Alloc(100);
+	MemPtr b = allocator.Alloc(100);
+	MemPtr c = allocator.Alloc(100);
+
+	allocator.DeAlloc(a);
+	allocator.DeAlloc(c);
+	TEST_CHECK(!allocator.CheckMemory(a));
+	TEST_CHECK(allocator.CheckMemory(b));
+	TEST_CHECK(allocator.GetStats().FreeFragmentCount == 2);
+
+	allocator.DeAlloc(b);
+	TEST_CHECK(allocator.GetStats().FreeFragmentCount == 1);
+
+	// Freed range must be reusable as one big allocation
+	MemPtr big = allocator.Alloc(48 * 1024);
+	TEST_CHECK(allocator.GetStats().BlockCount == 1);
+	allocator.DeAlloc(big);
+}
+
+static void TestSizeClassLargeAllocation()
+{
+	Aum allocator(64 * 1024, Aum::EMode::SizeClass);
+
+	// Rounded up to the next size class these do not fit any free block, even of a new memory block
+	MemPtr almostBlock = allocator.Alloc(64 * 1024 - 64);
+	TEST_CHECK(almostBlock != nullptr);
+	TEST_CHECK(allocator.GetStats().BlockCount == 1);
+	allocator.DeAlloc(almostBlock);
+
+	// Largest size a block can serve, only its own header and the sentinel are left
+	MemPtr wholeBlock = allocator.Alloc(64 * 1024 - 32);
+	TEST_CHECK(wholeBlock != nullptr);
+	TEST_CHECK(allocator.CheckMemory(wholeBlock));
+	TEST_CHECK(allocator.GetStats().BlockCount == 1);
+	std::memset(wholeBlock, 0xAB, 64 * 1024 - 32);
+
+	// Next one needs a new block
+	MemPtr second = allocator.Alloc(64 * 1024 - 64);
+	TEST_CHECK(second != nullptr);
+	TEST_CHECK(allocator.GetStats().BlockCount == 2);
+	TEST_CHECK(allocator.GetUsedBytes() == allocator.GetStats().UsedBytes);
+
+	allocator.DeAlloc(wholeBlock);
+	allocator.DeAlloc(second);
+	TEST_CHECK(!allocator.CheckMemory(wholeBlock));
+	TEST_CHECK(allocator.GetStats().AllocationCount == 0);
+	TEST_CHECK(allocator.GetStats().FreeFragmentCount == 2);
+}
+
+struct TestVisibleEntity
+{
+	void* Material;
+	void* Mesh;
+	float Transform[16];
+};
+
+struct TestModelContext
+{
+	void* Material;
+	FrameVector<float> Instances;
+};
+
+static void SimulateFrame(FrameAllocator& frameAllocator, ThreadArenas& arenas, int entityCount)
+{
+	frameAllocator.BeginFrame();
+
+	FrameVector<TestVisibleEntity> visibleEntities{FrameStlAllocator<TestVisibleEntity>(frameAllocator)};
+	for (int i = 0; i < entityCount; ++i)
+	{
+		visibleEntities.push_back({nullptr, nullptr, {}});
+	}
+
+	FrameVector<TestModelContext> renderSet{FrameStlAllocator<TestModelContext>(frameAllocator)};
+	for (int i = 0; i < entityCount / 10; ++i)
+	{
+		TestModelContext& context = renderSet.emplace_back(TestModelContext{nullptr, FrameVector<float>(FrameStlAllocator<float>(frameAllocator))});
+		context.Instances.resize(160);
+	}
+
+	// Per-frame spawn/destroy churn through the arenas
+	std::vector<void*, ArenaStlAllocator<void*>> spawned{ArenaStlAllocator<void*>(arenas)};
+	spawned.reserve(64);
+	for (int i = 0; i < 64; ++i)
+	{
+		spawned.push_back(arenas.Alloc(128 + i * 8));
+	}
+	for (void* ptr : spawned)
+	{
+		arenas.DeAlloc(ptr);
+	}
+}
+
+static void TestSteadyStateFrameAllocations()
+{
+	FrameAllocator frameAllocator(64 * 1024);
+	ThreadArenas arenas("TestArenas");
+
+	// Warm up both frame buffers and the arena
+	for (int i = 0; i < 4; ++i)
+	{
+		SimulateFrame(frameAllocator, arenas, 5000);
+	}
+
+	size_t backingAllocations = frameAllocator.GetStats().BackingAllocations;
+	size_t heapAllocations = s_HeapAllocations.load();
+
+	for (int i = 0; i < 100; ++i)
+	{
+		SimulateFrame(frameAllocator, arenas, 5000);
+	}
+
+	TEST_CHECK(s_HeapAllocations.load() == heapAllocations);
+	TEST_CHECK(frameAllocator.GetStats().BackingAllocations == backingAllocations);
+	TEST_CHECK(frameAllocator.GetStats().FrameAllocations > 0);
+	TEST_CHECK(arenas.GetAllocationCount() == 0);
+}
+
+static void TestFrameAllocatorThreads()
+{
+	FrameAllocator frameAllocator(4096);
+	frameAllocator.BeginFrame();
+
+	constexpr int threadCount = 8;
+	constexpr int allocationsPerThread = 10000;
+
+	std::vector<std::vector<uint32_t*>> results(threadCount);
+	std::vector<std::thread> threads;
+
+	for (int t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&frameAllocator, &results, t]()
+		{
+			for (int i = 0; i < allocationsPerThread; ++i)
+			{
+				auto* value = frameAllocator.Alloc<uint32_t>(1 + i % 13);
+				*value = t * allocationsPerThread + i;
+				results[t].push_back(value);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (int t = 0; t < threadCount; ++t)
+	{
+		for (int i = 0; i < allocationsPerThread; ++i)
+		{
+			TEST_CHECK(*results[t][i] == (uint32_t)(t * allocationsPerThread + i));
+			TEST_CHECK(IsAligned((uintptr_t)results[t][i], 16));
+		}
+	}
+}
+
+static void TestThreadArenasCrossThreadFree()
+{
+	ThreadArenas arenas("CrossThreadArenas", 256 * 1024);
+
+	constexpr int threadCount = 4;
+	constexpr int allocationCount = 20000;
+
+	std::vector<std::vector<MemPtr>> allocations(threadCount);
+	std::vector<std::thread> threads;
+
+	for (int t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&arenas, &allocations, t]()
+		{
+			for (int i = 0; i < allocationCount; ++i)
+			{
+				MemPtr ptr = arenas.Alloc(32 + (i % 64));
+				std::memset(ptr, t, 32);
+				allocations[t].push_back(ptr);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	TEST_CHECK(arenas.GetArenaCount() == threadCount);
+	TEST_CHECK(arenas.GetAllocationCount() == threadCount * allocationCount);
+
+	// Free everything from other threads than the ones that allocated
+	threads.clear();
+	for (int t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&arenas, &allocations, t]()
+		{
+			for (MemPtr ptr : allocations[(t + 1) % threadCount])
+			{
+				arenas.DeAlloc(ptr);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	TEST_CHECK(arenas.GetAllocationCount() == 0);
+	TEST_CHECK(arenas.GetStats().AllocationCount == 0);
+}
+
+static size_t CountRegisteredAllocators(const Aum* allocator)
+{
+	size_t count = 0;
+	Aum::ForEachAllocator([&](Aum* registered) { count += registered == allocator; });
+	return count;
+}
+
+static void TestAllocatorRegistry()
+{
+	std::atomic<bool> stop = false;
+
+	// Allocators come and go on another thread while the registry is walked
+	std::thread churn([&stop]()
+	{
+		while (!stop)
+		{
+			Aum allocator(4096, Aum::EMode::SizeClass);
+		}
+	});
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		size_t usedBytes = 0;
+		Aum::ForEachAllocator([&usedBytes](Aum* allocator) { usedBytes += allocator->GetStats().UsedBytes; });
+	}
+
+	stop = true;
+	churn.join();
+
+	auto* allocator = new Aum(4096, Aum::EMode::SizeClass);
+	TEST_CHECK(CountRegisteredAllocators(allocator) == 1);
+	delete allocator;
+	TEST_CHECK(CountRegisteredAllocators(allocator) == 0);
+}
+
 int main()
 {
+	TestSizeClassChurn();
+	TestSizeClassCoalescing();
+	TestSizeClassLargeAllocation();
+	TestSteadyStateFrameAllocations();
+	TestFrameAllocatorThreads();
+	TestThreadArenasCrossThreadFree();
+	TestAllocatorRegistry();
 
-	return 0;
-}
\ No newline at end of file
+	return TestResult("memory");
+}
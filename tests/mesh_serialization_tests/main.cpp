@@ -0,0 +1,268 @@
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <filesystem>
+#include <Aurora/Framework/Mesh/Mesh.hpp>
+#include <Aurora/Resource/ResourceManager.hpp>
+#include "../TestCommon.hpp"
+
+using namespace Aurora;
+
+static void WriteArchive(const Path& path, Archive& archive)
+{
+	std::ofstream stream(path, std::ios::out | std::ios::binary);
+	stream << archive;
+}
+
+template<typename Vertex, typename MeshType>
+static void FillLOD(MeshType& mesh, LOD lod, uint32_t vertexCount)
+{
+	MeshLodResource* lodResource;
+	VertexBuffer<Vertex>* vertexBuffer = mesh.template CreateVertexBuffer<Vertex>(lod, &lodResource);
+
+	for (uint32_t i = 0; i < vertexCount; ++i)
+	{
+		Vertex vertex = {};
+		vertex.Position = Vector3((float)i, (float)lod, 1.0f);
+		vertex.TexCoord = Vector2(0.5f, (float)i);
+		vertexBuffer->Add(vertex);
+		lodResource->Indices.push_back(i);
+	}
+
+	FMeshSection section;
+	section.MaterialIndex = 1;
+	section.NumTriangles = vertexCount;
+	lodResource->Sections.push_back(section);
+	lodResource->IndexFormat = EIndexBufferFormat::Uint32;
+}
+
+template<typename Vertex, typename MeshType>
+static bool SameLOD(MeshType& a, MeshType& b, LOD lod)
+{
+	VertexBuffer<Vertex>* verticesA = a.template GetVertexBuffer<Vertex>(lod);
+	VertexBuffer<Vertex>* verticesB = b.template GetVertexBuffer<Vertex>(lod);
+
+	if (!verticesA || !verticesB || verticesA->GetSize() != verticesB->GetSize())
+		return false;
+
+	const MeshLodResource& resourceA = a.LODResources[lod];
+	const MeshLodResource& resourceB = b.LODResources[lod];
+
+	return std::memcmp(verticesA->GetData(), verticesB->GetData(), verticesA->GetSize()) == 0
+		&& resourceA.Indices == resourceB.Indices
+		&& resourceA.Sections.size() == resourceB.Sections.size()
+		&& resourceA.Sections[0].MaterialIndex == resourceB.Sections[0].MaterialIndex
+		&& resourceA.Sections[0].NumTriangles == resourceB.Sections[0].NumTriangles;
+}
+
+static void TestStaticMesh()
+{
+	StaticMesh mesh;
+	mesh.Name = "Box";
+	FillLOD<StaticMesh::Vertex>(mesh, 0, 300);
+	FillLOD<StaticMesh::Vertex>(mesh, 1, 30);
+	mesh.MaterialSlots[0] = MaterialSlot(nullptr, "Body");
+	mesh.ComputeAABB();
+
+	Archive archive;
+	archive << 2;
+	mesh.WriteMeshType(archive);
+	mesh.Serialize(archive);
+	WriteArchive("box.amesh", archive);
+
+	ResourceManager resourceManager(nullptr);
+	Mesh_ptr loadedMesh = resourceManager.ReadMesh("box.amesh");
+	TEST_CHECK(loadedMesh && loadedMesh->GetTypeID() == StaticMesh::TypeID());
+
+	if (!loadedMesh)
+		return;
+
+	auto& staticMesh = static_cast<StaticMesh&>(*loadedMesh);
+	TEST_CHECK(staticMesh.Name == "Box");
+	TEST_CHECK(staticMesh.LODResources.size() == 2);
+	TEST_CHECK((SameLOD<StaticMesh::Vertex>(mesh, staticMesh, 0)));
+	TEST_CHECK((SameLOD<StaticMesh::Vertex>(mesh, staticMesh, 1)));
+	TEST_CHECK(staticMesh.MaterialSlots.size() == 1 && staticMesh.MaterialSlots[0].MaterialSlotName == "Body");
+	TEST_CHECK(staticMesh.m_Bounds.GetMax() == mesh.m_Bounds.GetMax() && staticMesh.m_Bounds.GetMin() == mesh.m_Bounds.GetMin());
+
+	// Truncated files are rejected instead of read past the end
+	Archive truncated(std::vector<uint8_t>(archive.GetData(), archive.GetData() + archive.GetSize() / 2));
+	WriteArchive("truncated.amesh", truncated);
+	TEST_CHECK(resourceManager.ReadMesh("truncated.amesh") == nullptr);
+}
+
+static void TestUnknownChunk()
+{
+	StaticMesh mesh;
+	mesh.Name = "Future";
+	FillLOD<StaticMesh::Vertex>(mesh, 0, 3);
+
+	Archive archive;
+	archive << 2;
+	mesh.WriteMeshType(archive);
+
+	size_t chunk = archive.BeginChunk(Archive::MakeChunkTag("TEST"));
+	archive << String("skipped");
+	archive << 42;
+	archive.EndChunk(chunk);
+
+	mesh.Serialize(archive);
+	WriteArchive("future.amesh", archive);
+
+	ResourceManager resourceManager(nullptr);
+	Mesh_ptr loadedMesh = resourceManager.ReadMesh("future.amesh");
+	TEST_CHECK(loadedMesh && loadedMesh->Name == "Future");
+	TEST_CHECK(loadedMesh && (SameLOD<StaticMesh::Vertex>(mesh, static_cast<StaticMesh&>(*loadedMesh), 0)));
+}
+
+static void TestVersion1()
+{
+	// Layout written before the chunked format
+	Archive archive;
+	archive << 1;
+	archive << StaticMesh::TypeID();
+	archive << String("Old");
+	archive << (uint32_t)1;
+	archive << (LOD)0;
+	archive << (uint32_t)3;
+
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		StaticMesh::Vertex vertex = {};
+		vertex.Position = Vector3((float)i, 2.0f, 3.0f);
+		archive.Write(vertex);
+	}
+
+	archive << (uint8_t)EIndexBufferFormat::Uint32;
+	archive << std::vector<Index_t>{0, 1, 2};
+	archive << std::vector<FMeshSection>(1);
+	archive << (uint32_t)1;
+	archive << (int32_t)0;
+	archive << String("Slot");
+	archive << String("none");
+	archive << Vector3(0.0f);
+	archive << Vector3(2.0f, 2.0f, 3.0f);
+	WriteArchive("old.amesh", archive);
+
+	ResourceManager resourceManager(nullptr);
+	Mesh_ptr loadedMesh = resourceManager.ReadMesh("old.amesh");
+	TEST_CHECK(loadedMesh && loadedMesh->Name == "Old");
+
+	if (!loadedMesh)
+		return;
+
+	auto& staticMesh = static_cast<StaticMesh&>(*loadedMesh);
+	VertexBuffer<StaticMesh::Vertex>* vertexBuffer = staticMesh.GetVertexBuffer<StaticMesh::Vertex>(0);
+	TEST_CHECK(vertexBuffer && vertexBuffer->GetCount() == 3 && vertexBuffer->Get(2).Position.x == 2.0f);
+	TEST_CHECK(staticMesh.LODResources[0].Indices.size() == 3);
+	TEST_CHECK(staticMesh.MaterialSlots[0].MaterialSlotName == "Slot");
+	TEST_CHECK(staticMesh.m_Bounds.GetMax().x == 2.0f);
+}
+
+static void TestSkeletalMesh()
+{
+	SkeletalMesh mesh;
+	mesh.Name = "Character";
+	FillLOD<SkeletalMesh::Vertex>(mesh, 0, 60);
+
+	Animation::Armature& armature = mesh.Armature;
+	armature.Bones.emplace_back(0, -1, "Hips", Matrix4(1.0f));
+	armature.Bones.emplace_back(1, 0, "Spine", Matrix4(2.0f));
+	armature.Bones.emplace_back(2, 1, "Head", Matrix4(3.0f));
+	armature.Bones.emplace_back(3, 0, "Leg", Matrix4(4.0f));
+	armature.RootBones.push_back(&armature.Bones[0]);
+	armature.Bones[0].Children = {&armature.Bones[3], &armature.Bones[1]};
+	armature.Bones[1].Children = {&armature.Bones[2]};
+	armature.GlobalInverseTransform = Matrix4(0.5f);
+
+	for (const Animation::Bone& bone : armature.Bones)
+		armature.BoneMapping[bone.Name] = bone.Index;
+
+	Animation::FAnimation& animation = mesh.Animations.emplace_back("Walk", 2.0, 30.0);
+	Animation::AnimationChannel& channel = animation.Channels.emplace_back(1, "Spine");
+	channel.PositionKeys.push_back({0.0, Vector3(1.0f, 2.0f, 3.0f)});
+	channel.PositionKeys.push_back({1.5, Vector3(4.0f, 5.0f, 6.0f)});
+	channel.RotationKeys.push_back({0.5, Quaternion(0.0f, 1.0f, 0.0f, 0.0f)});
+	channel.ScaleKeys.push_back({0.0, Vector3(1.0f)});
+	mesh.Animations.emplace_back("Idle", 1.0, 24.0).Channels.emplace_back(0, "Hips");
+
+	Archive archive;
+	archive << 2;
+	mesh.WriteMeshType(archive);
+	mesh.Serialize(archive);
+	WriteArchive("character.amesh", archive);
+
+	ResourceManager resourceManager(nullptr);
+	Mesh_ptr loadedMesh = resourceManager.ReadMesh("character.amesh");
+	TEST_CHECK(loadedMesh && loadedMesh->GetTypeID() == SkeletalMesh::TypeID());
+
+	if (!loadedMesh)
+		return;
+
+	auto& skeletalMesh = static_cast<SkeletalMesh&>(*loadedMesh);
+	TEST_CHECK((SameLOD<SkeletalMesh::Vertex>(mesh, skeletalMesh, 0)));
+
+	const Animation::Armature& loadedArmature = skeletalMesh.Armature;
+	TEST_CHECK(loadedArmature.Bones.size() == 4);
+	TEST_CHECK(loadedArmature.Bones[2].Name == "Head" && loadedArmature.Bones[2].Parent == 1);
+	TEST_CHECK(loadedArmature.Bones[3].OffsetMatrix == Matrix4(4.0f));
+	TEST_CHECK(loadedArmature.GlobalInverseTransform == Matrix4(0.5f));
+	TEST_CHECK(loadedArmature.RootBones.size() == 1 && loadedArmature.RootBones[0] == &loadedArmature.Bones[0]);
+	TEST_CHECK(loadedArmature.Bones[0].Children.size() == 2);
+	TEST_CHECK(loadedArmature.Bones[0].Children.size() == 2 && loadedArmature.Bones[0].Children[0] == &loadedArmature.Bones[3]);
+	TEST_CHECK(loadedArmature.BoneMapping.size() == 4 && loadedArmature.BoneMapping.at("Leg") == 3);
+
+	TEST_CHECK(skeletalMesh.Animations.size() == 2);
+
+	if (skeletalMesh.Animations.size() == 2)
+	{
+		const Animation::FAnimation& loadedAnimation = skeletalMesh.Animations[0];
+		TEST_CHECK(loadedAnimation.Name == "Walk" && loadedAnimation.Duration == 2.0 && loadedAnimation.TicksPerSecond == 30.0);
+		TEST_CHECK(loadedAnimation.Channels.size() == 1 && loadedAnimation.Channels[0].Index == 1 && loadedAnimation.Channels[0].Name == "Spine");
+		TEST_CHECK(loadedAnimation.Channels[0].PositionKeys.size() == 2 && loadedAnimation.Channels[0].PositionKeys[1].Time == 1.5);
+		TEST_CHECK(loadedAnimation.Channels[0].PositionKeys[1].Value == Vector3(4.0f, 5.0f, 6.0f));
+		TEST_CHECK(loadedAnimation.Channels[0].RotationKeys.size() == 1 && loadedAnimation.Channels[0].RotationKeys[0].Value == Quaternion(0.0f, 1.0f, 0.0f, 0.0f));
+		TEST_CHECK(skeletalMesh.Animations[1].Name == "Idle" && skeletalMesh.Animations[1].Channels.size() == 1);
+	}
+
+	// Compiled from the loaded data
+	skeletalMesh.EnsureCompiledAnimations();
+	TEST_CHECK(skeletalMesh.CompiledAnimations.size() == 2);
+
+	// A static mesh file is not read as skeletal
+	SkeletalMesh wrongType;
+	Archive staticArchive;
+	StaticMesh staticMesh;
+	FillLOD<StaticMesh::Vertex>(staticMesh, 0, 3);
+	staticMesh.Serialize(staticArchive);
+
+	bool threw = false;
+	try
+	{
+		Archive view(std::span<const uint8_t>(staticArchive.GetData(), staticArchive.GetSize()));
+		wrongType.Deserialize(view);
+	}
+	catch (const std::runtime_error&)
+	{
+		threw = true;
+	}
+	TEST_CHECK(threw);
+}
+
+int main()
+{
+	Path testDirectory = std::filesystem::temp_directory_path() / "aurora_mesh_serialization_tests";
+	std::filesystem::remove_all(testDirectory);
+	std::filesystem::create_directories(testDirectory);
+	std::filesystem::current_path(testDirectory);
+
+	TestStaticMesh();
+	TestUnknownChunk();
+	TestVersion1();
+	TestSkeletalMesh();
+
+	std::filesystem::current_path(testDirectory.parent_path());
+	std::filesystem::remove_all(testDirectory);
+
+	return TestResult("mesh serialization");
+}
@@ -0,0 +1,396 @@
+#include <iostream>
+#include <cstring>
+#include <new>
+#include <Aurora/HeadlessEngine.hpp>
+#include <Aurora/Graphics/Null/NullRenderDevice.hpp>
+#include <Aurora/Graphics/RenderManager.hpp>
+#include <Aurora/Graphics/Material/MaterialDefinition.hpp>
+#include <Aurora/Resource/ResourceManager.hpp>
+#include "../TestCommon.hpp"
+
+using namespace Aurora;
+
+static const char* s_VertexSource = R"(
+#if !defined(SHADER_ENGINE_SIDE)
+#define uniformbuffer layout(std140) uniform
+#endif
+#define MAX_LIGHTS 4
+
+layout(location = 0) in vec3 POSITION;
+layout(location = 1) in vec2 TEXCOORD; // uniform sampler2D Commented;
+layout(location = 4) in mat4 TRANSFORM_INSTANCED;
+
+uniformbuffer BaseVSData
+{
+	mat4 ProjectionViewMatrix;
+	vec3 CameraPos; float Time;
+	vec4 Lights[MAX_LIGHTS];
+	float A, B;
+};
+
+/* uniform sampler2D
+   BlockCommented; */
+#if defined(USE_SKIN) || MAX_LIGHTS > 8
+uniform sampler2D SkinTexture;
+#elif MAX_LIGHTS == 4
+uniform sampler2D Texture;
+#endif
+
+out vec2 UV;
+
+void main()
+{
+	if (true) { UV = TEXCOORD; }
+	gl_Position = vec4(POSITION, 1.0);
+}
+)";
+
+static const char* s_PixelSource = R"(
+layout(early_fragment_tests) in;
+
+uniform sampler2D Texture;
+uniform sampler2DArray ShadowMaps[2];
+
+layout(std430, binding = 0) buffer Instances { vec4 Data[]; } instances;
+
+#ifdef SHADER_PIXEL
+layout(std140) uniform Material { vec4 Color; };
+#endif
+
+in vec2 UV;
+out vec4 FragColor;
+
+void main() {}
+)";
+
+static Shader_ptr CreateTestShader(IRenderDevice& device)
+{
+	ShaderProgramDesc desc("Test");
+	desc.AddShader(EShaderType::Vertex, s_VertexSource);
+	desc.AddShader(EShaderType::Pixel, s_PixelSource);
+	return device.CreateShaderProgram(desc);
+}
+
+static void TestPreprocessor()
+{
+	std::string source = "#ifdef A\nint a = VALUE;\n#else\nint b;\n#endif\n#if VALUE >= 2 && !defined(B)\nint c;\n#endif\n";
+
+	std::string withA = PreprocessGlsl(source, {{"A", ""}, {"VALUE", "3"}});
+	TEST_CHECK(withA.find("int a = 3;") != std::string::npos);
+	TEST_CHECK(withA.find("int b") == std::string::npos);
+	TEST_CHECK(withA.find("int c") != std::string::npos);
+
+	std::string withoutA = PreprocessGlsl(source, {{"B", ""}});
+	TEST_CHECK(withoutA.find("int a") == std::string::npos);
+	TEST_CHECK(withoutA.find("int b") != std::string::npos);
+	TEST_CHECK(withoutA.find("int c") == std::string::npos);
+}
+
+static void TestReflection()
+{
+	NullRenderDevice device;
+	auto shader = std::static_pointer_cast<NullShaderProgram>(CreateTestShader(device));
+
+	const auto& uniformBlocks = shader->GetUniformBlocks();
+	TEST_CHECK(uniformBlocks.size() == 2);
+
+	if (uniformBlocks.size() == 2)
+	{
+		const ShaderResourceDesc& baseData = uniformBlocks[0];
+		TEST_CHECK(baseData.Name == "BaseVSData");
+		TEST_CHECK(baseData.NameID == "BaseVSData"_HASH);
+		TEST_CHECK(baseData.Size == 160);
+		TEST_CHECK(baseData.Variables.size() == 6);
+
+		if (baseData.Variables.size() == 6)
+		{
+			// std140: vec3 packs with the following float, arrays have a 16 byte stride
+			TEST_CHECK(baseData.Variables[1].Offset == 64 && baseData.Variables[2].Offset == 76);
+			TEST_CHECK(baseData.Variables[3].Offset == 80 && baseData.Variables[3].ArrayStride == 16);
+			TEST_CHECK(baseData.Variables[5].Offset == 148);
+		}
+
+		TEST_CHECK(uniformBlocks[1].Name == "Material" && uniformBlocks[1].Size == 16);
+	}
+
+	const auto& samplers = shader->GetSamplers();
+	TEST_CHECK(samplers.size() == 2);
+	TEST_CHECK(samplers.size() == 2 && samplers[0].Name == "Texture" && samplers[1].Name == "ShadowMaps" && samplers[1].ArraySize == 2);
+
+	TEST_CHECK(shader->GetStorageBlocks().size() == 1);
+
+	const ShaderInputVariables_t& inputs = shader->GetInputVariables();
+	TEST_CHECK(inputs.size() == 6);
+	TEST_CHECK(inputs.contains(1) && inputs.at(1).Format == GraphicsFormat::RG32_FLOAT);
+	TEST_CHECK(inputs.contains(7) && inputs.at(7).Instanced);
+}
+
+static void TestResources()
+{
+	NullRenderDevice device;
+
+	uint32_t values[4] = {1, 2, 3, 4};
+	Buffer_ptr buffer = device.CreateBuffer(BufferDesc("Buffer", sizeof(values), EBufferType::UniformBuffer), values);
+	Buffer_ptr copy = device.CreateBuffer(BufferDesc("Copy", sizeof(values), EBufferType::UniformBuffer));
+	TEST_CHECK(device.GetUsedGPUMemory() >= 2 * sizeof(values));
+
+	uint32_t value = 7;
+	device.WriteBuffer(buffer, &value, sizeof(value), 4);
+	device.CopyToBuffer(copy, 0, buffer, 0, sizeof(values));
+
+	auto* mapped = device.MapBuffer<uint32_t>(copy, EBufferAccess::ReadOnly);
+	TEST_CHECK(mapped[0] == 1 && mapped[1] == 7 && mapped[3] == 4);
+	device.UnmapBuffer(copy);
+
+	TEST_CHECK(device.GetFrameRenderStatistics().BufferWrites == 1);
+	TEST_CHECK(device.GetFrameRenderStatistics().BufferMaps == 1);
+	TEST_CHECK(device.GetDeviceStatistics().BytesUploaded == sizeof(values) + sizeof(value));
+
+	TextureDesc textureDesc;
+	textureDesc.Width = 4;
+	textureDesc.Height = 4;
+	textureDesc.MipLevels = 3;
+	textureDesc.ImageFormat = GraphicsFormat::RGBA8_UNORM;
+	Texture_ptr texture = device.CreateTexture(textureDesc);
+
+	auto* nullTexture = static_cast<NullTexture*>(texture.get());
+	TEST_CHECK(!nullTexture->HasData());
+	TEST_CHECK(nullTexture->GetByteSize() == (16 + 4 + 1) * 4);
+
+	std::vector<uint8_t> pixels(16 * 4, 0xAB);
+	device.WriteTexture(texture, 0, 0, pixels.data());
+
+	std::vector<uint8> readBack(pixels.size(), 0);
+	TEST_CHECK(device.ReadTexture(texture, readBack));
+	TEST_CHECK(readBack == pixels);
+}
+
+static void TestRedundantState()
+{
+	NullRenderDevice device;
+	RenderCommandRecorder recorder;
+	device.SetRecorder(&recorder);
+	device.Init();
+
+	uint32_t indices[3] = {0, 1, 2};
+
+	DrawCallState state;
+	state.Shader = CreateTestShader(device);
+	state.SetIndexBuffer(device.CreateBuffer(BufferDesc("Indices", sizeof(indices), EBufferType::IndexBuffer), indices));
+	state.BindUniformBuffer("BaseVSData"_HASH, device.CreateBuffer(BufferDesc("BaseVSData", 160, EBufferType::UniformBuffer)));
+	state.BindUniformBuffer("Material"_HASH, device.CreateBuffer(BufferDesc("Material", 16, EBufferType::UniformBuffer)));
+
+	TextureDesc textureDesc;
+	textureDesc.Width = 1;
+	textureDesc.Height = 1;
+	textureDesc.MipLevels = 1;
+	textureDesc.ImageFormat = GraphicsFormat::RGBA8_UNORM;
+	state.BindTexture("Texture"_HASH, device.CreateTexture(textureDesc));
+	state.ClearColorTarget = false;
+	state.ClearDepthTarget = false;
+
+	device.DrawIndexed(state, {DrawArguments(3)}, true);
+	NullDeviceStatistics first = device.GetDeviceStatistics();
+	TEST_CHECK(first.ShaderChanges == 1);
+	TEST_CHECK(first.BindingChanges == 3); // Two uniform blocks and the texture
+	TEST_CHECK(first.BindCalls == 5); // Two samplers, two uniform blocks and the storage block
+
+	// Same state again, only the lookups are paid
+	device.ResetDeviceStatistics();
+	device.DrawIndexed(state, {DrawArguments(3)}, true);
+	TEST_CHECK(device.GetDeviceStatistics().StateChanges == 0);
+	TEST_CHECK(device.GetDeviceStatistics().BindingChanges == 0);
+	TEST_CHECK(device.GetDeviceStatistics().BindCalls == 5);
+
+	TEST_CHECK(recorder.GetCount(ERenderCommand::DrawIndexed) == 2);
+	TEST_CHECK(recorder.GetCount(ERenderCommand::SetShader) == 1);
+	TEST_CHECK(recorder.GetCount(ERenderCommand::BindUniformBuffer) == 2);
+	TEST_CHECK(device.GetFrameRenderStatistics().DrawCalls == 2);
+
+	device.InvalidateState();
+	device.DrawIndexed(state, {DrawArguments(3)}, true);
+	TEST_CHECK(recorder.GetCount(ERenderCommand::SetShader) == 2);
+}
+
+// Placement new over a filled buffer, the padding bytes keep the fill
+template<typename T>
+struct FilledState
+{
+	alignas(T) uint8_t Storage[sizeof(T)];
+	T* State;
+
+	explicit FilledState(uint8_t fill)
+	{
+		std::memset(Storage, fill, sizeof(Storage));
+		State = new (Storage) T();
+	}
+};
+
+static void TestFixedFunctionStates()
+{
+	NullRenderDevice device;
+
+	FilledState<FBlendState> blendA(0x00), blendB(0xCD);
+	FilledState<FRasterState> rasterA(0x00), rasterB(0xCD);
+	FilledState<FDepthStencilState> depthA(0x00), depthB(0xCD);
+
+	// Equal states with different padding are not a change
+	device.SetBlendState(*blendA.State);
+	device.SetBlendState(*blendB.State);
+	device.SetRasterState(*rasterA.State);
+	device.SetRasterState(*rasterB.State);
+	device.SetDepthStencilState(*depthA.State);
+	device.SetDepthStencilState(*depthB.State);
+	TEST_CHECK(device.GetDeviceStatistics().StateChanges == 3);
+
+	blendB.State->Enabled = true;
+	rasterB.State->DepthBias = 2;
+	depthB.State->BackFace.StencilFunc = EComparisonFunc::Never;
+	device.SetBlendState(*blendB.State);
+	device.SetRasterState(*rasterB.State);
+	device.SetDepthStencilState(*depthB.State);
+	TEST_CHECK(device.GetDeviceStatistics().StateChanges == 6);
+}
+
+static void TestBindingSlots()
+{
+	NullRenderDevice device;
+
+	Buffer_ptr first = device.CreateBuffer(BufferDesc("First", 16, EBufferType::UniformBuffer));
+	Buffer_ptr second = device.CreateBuffer(BufferDesc("Second", 16, EBufferType::UniformBuffer));
+
+	DrawCallState state;
+	state.BindUniformBuffer("First"_HASH, first);
+	state.BindUniformBuffer("Second"_HASH, second, 0, 8);
+	state.BindUniformBuffer("First"_HASH, second, 4); // Rebinding a name reuses its slot
+	TEST_CHECK(state.BoundUniformBuffers.Size() == 2);
+	TEST_CHECK(state.BoundUniformBuffers.Find("First"_HASH)->Buffer == second);
+	TEST_CHECK(state.BoundUniformBuffers.Find("First"_HASH)->Offset == 4);
+	TEST_CHECK(state.BoundUniformBuffers.Find("Second"_HASH)->Size == 8);
+	TEST_CHECK(state.BoundUniformBuffers.Find("Third"_HASH) == nullptr);
+
+	// Names hashed at runtime match the literals
+	std::string name = "Second";
+	TEST_CHECK(state.BoundUniformBuffers.Find(Hash_djb2(name.c_str())) != nullptr);
+
+	// A full table keeps what it has
+	for (uint32_t i = 0; i < StateResources::MaxBoundSSBOBuffers + 2; ++i)
+	{
+		state.BindSSBOBuffer(i + 1, first);
+	}
+	TEST_CHECK(state.SSBOBuffers.Size() == StateResources::MaxBoundSSBOBuffers);
+	TEST_CHECK(state.SSBOBuffers.Find(StateResources::MaxBoundSSBOBuffers + 1) == nullptr);
+
+	// Reset drops the references
+	long useCount = first.use_count();
+	state.ResetResources();
+	TEST_CHECK(state.BoundUniformBuffers.Empty());
+	TEST_CHECK(first.use_count() == useCount - StateResources::MaxBoundSSBOBuffers);
+}
+
+static void TestDrawIndirect()
+{
+	NullRenderDevice device;
+	RenderCommandRecorder recorder;
+	device.SetRecorder(&recorder);
+
+	uint32_t indices[6] = {0, 1, 2, 2, 1, 3};
+	DrawElementsIndirectCommand commands[3] = {
+		{6, 2, 0, 0, 0},
+		{3, 4, 3, 4, 2},
+		{6, 1, 0, 8, 6}
+	};
+
+	Buffer_ptr commandBuffer = device.CreateBuffer(BufferDesc("Commands", sizeof(commands), EBufferType::ShaderStorageBuffer), commands);
+
+	DrawCallState state;
+	state.SetIndexBuffer(device.CreateBuffer(BufferDesc("Indices", sizeof(indices), EBufferType::IndexBuffer), indices));
+
+	// Last two commands in one call
+	device.DrawIndirect(state, commandBuffer, sizeof(DrawElementsIndirectCommand), 2);
+	TEST_CHECK(device.GetFrameRenderStatistics().DrawCalls == 1);
+	TEST_CHECK(device.GetFrameRenderStatistics().VertexCount == (3 * 4 + 6 * 1) * 3);
+	TEST_CHECK(recorder.GetCount(ERenderCommand::DrawIndirect) == 1);
+	TEST_CHECK(recorder.GetCount(ERenderCommand::BindIndexBuffer) == 1);
+
+	const RenderCommand& draw = recorder.GetCommands().back();
+	TEST_CHECK(draw.Args[0] == sizeof(DrawElementsIndirectCommand) && draw.Args[1] == 2);
+
+	// Past the end of the buffer
+	device.DrawIndirect(state, commandBuffer, sizeof(DrawElementsIndirectCommand) * 2, 2);
+	TEST_CHECK(recorder.GetCount(ERenderCommand::DrawIndirect) == 1);
+
+	// Same index buffer is not bound again
+	device.DrawIndirect(state, commandBuffer, 0, 3);
+	TEST_CHECK(recorder.GetCount(ERenderCommand::DrawIndirect) == 2);
+	TEST_CHECK(recorder.GetCount(ERenderCommand::BindIndexBuffer) == 1);
+	TEST_CHECK(device.GetFrameRenderStatistics().DrawCalls == 2);
+
+	device.SetRecorder(nullptr);
+}
+
+static void TestMaterialUniformOverflow()
+{
+	HeadlessEngine engine;
+
+	auto matDef = engine.GetResourceManager()->GetOrLoadMaterialDefinition("Assets/Materials/Base/Textured.matd");
+	TEST_CHECK(matDef != nullptr);
+
+	if (matDef == nullptr)
+		return;
+
+	std::shared_ptr<Material> material = matDef->CreateInstance();
+	BufferCache& uniformBufferCache = engine.GetRenderManager()->GetUniformBufferCache();
+
+	engine.BeginFrame();
+	{
+		DrawCallState state;
+		TEST_CHECK(material->BeginPass(Pass::Ambient, state));
+		TEST_CHECK(state.BoundUniformBuffers.Find("Color"_HASH) != nullptr);
+		material->EndPass(Pass::Ambient, state);
+	}
+	engine.EndFrame();
+
+	// Whole region taken, the material block has nowhere to go
+	engine.BeginFrame();
+	{
+		VBufferCacheIndex cacheIndex;
+		const StreamingRingAllocator& allocator = uniformBufferCache.GetAllocator();
+		TEST_CHECK(uniformBufferCache.GetOrMap(allocator.GetRegionSize() - allocator.GetUsedBytes(), 0, cacheIndex) != nullptr);
+
+		DrawCallState state;
+		TEST_CHECK(!material->BeginPass(Pass::Ambient, state));
+		TEST_CHECK(state.BoundUniformBuffers.Find("Color"_HASH) == nullptr);
+		TEST_CHECK(allocator.GetFailedAllocations() == 1);
+		material->EndPass(Pass::Ambient, state);
+
+		// Still begins and ends in pairs
+		TEST_CHECK(!material->BeginPass(Pass::Ambient, state));
+		material->EndPass(Pass::Ambient, state);
+	}
+	engine.EndFrame();
+
+	// Next region is empty again
+	engine.BeginFrame();
+	{
+		DrawCallState state;
+		TEST_CHECK(material->BeginPass(Pass::Ambient, state));
+		TEST_CHECK(state.BoundUniformBuffers.Find("Color"_HASH) != nullptr);
+		material->EndPass(Pass::Ambient, state);
+	}
+	engine.EndFrame();
+}
+
+int main()
+{
+	TestPreprocessor();
+	TestReflection();
+	TestResources();
+	TestRedundantState();
+	TestFixedFunctionStates();
+	TestBindingSlots();
+	TestDrawIndirect();
+	TestMaterialUniformOverflow();
+
+	return TestResult("null render device");
+}
\ No newline at end of file
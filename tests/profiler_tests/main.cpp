@@ -0,0 +1,297 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <Aurora/Core/Profiler.hpp>
+#include "../TestCommon.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define AU_TEST_TSC 1
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+#else
+	#define AU_TEST_TSC 0
+#endif
+
+using namespace Aurora;
+
+static size_t CountOccurrences(const std::string& text, const std::string& pattern)
+{
+	size_t count = 0;
+	for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + pattern.size()))
+		count++;
+	return count;
+}
+
+static void RecordNested(uint32_t depth)
+{
+	AU_CPU_DEBUG_SCOPE("Nested");
+
+	if (depth > 0)
+		RecordNested(depth - 1);
+}
+
+static void TestEvents()
+{
+	uint64_t frameIndex = Profiler::GetFrameIndex();
+	Profiler::BeginFrame();
+	TEST_CHECK(Profiler::GetFrameIndex() == frameIndex + 1);
+
+	{
+		AU_CPU_DEBUG_SCOPE("Outer \"quoted\"");
+		RecordNested(3);
+		Profiler::SetCounter("Draw calls", 42);
+	}
+
+	std::thread worker([]()
+	{
+		Profiler::SetThreadName("Worker");
+		AU_CPU_DEBUG_SCOPE("Worker scope");
+		RecordNested(1);
+	});
+	worker.join();
+
+	// Disabled scopes record nothing
+	Profiler::SetEnabled(false);
+	{
+		AU_CPU_DEBUG_SCOPE("Disabled scope");
+		Profiler::SetCounter("Disabled counter", 1);
+	}
+	Profiler::SetEnabled(true);
+
+	std::vector<std::pair<uint32_t, ProfileEvent>> events;
+	Profiler::CollectEvents(events);
+
+	size_t begins = 0;
+	size_t ends = 0;
+	bool counterFound = false;
+	bool disabledFound = false;
+	uint32_t mainThread = UINT32_MAX;
+	uint32_t workerThread = UINT32_MAX;
+
+	for (const auto& [thread, event] : events)
+	{
+		std::string name = event.Name;
+
+		if (event.Type == EProfileEvent::Begin)
+			begins++;
+		else if (event.Type == EProfileEvent::End)
+			ends++;
+
+		if (event.Type == EProfileEvent::Counter && name == "Draw calls")
+			counterFound = event.Value == 42;
+
+		if (name.rfind("Disabled", 0) == 0)
+			disabledFound = true;
+
+		if (name == "Outer \"quoted\"")
+			mainThread = thread;
+		if (name == "Worker scope")
+			workerThread = thread;
+	}
+
+	TEST_CHECK(begins == 8 && ends == 8);
+	TEST_CHECK(counterFound);
+	TEST_CHECK(!disabledFound);
+	TEST_CHECK(mainThread != UINT32_MAX && workerThread != UINT32_MAX && mainThread != workerThread);
+
+	// Events of one thread keep their order
+	uint64_t lastTime = 0;
+	bool ordered = true;
+	for (const auto& [thread, event] : events)
+	{
+		if (thread != mainThread)
+			continue;
+
+		ordered &= event.Time >= lastTime;
+		lastTime = event.Time;
+	}
+	TEST_CHECK(ordered);
+
+	std::filesystem::path tracePath = std::filesystem::temp_directory_path() / "aurora_profiler_tests.json";
+	TEST_CHECK(Profiler::ExportChromeTrace(tracePath));
+
+	std::ifstream file(tracePath);
+	std::stringstream stream;
+	stream << file.rdbuf();
+	file.close();
+	std::string trace = stream.str();
+
+	TEST_CHECK(trace.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+	TEST_CHECK(CountOccurrences(trace, "\"ph\":\"B\"") == 8);
+	TEST_CHECK(CountOccurrences(trace, "\"ph\":\"E\"") == 8);
+	TEST_CHECK(CountOccurrences(trace, "\"ph\":\"C\"") == 1);
+	TEST_CHECK(CountOccurrences(trace, "\"ph\":\"i\"") == 1);
+	TEST_CHECK(trace.find("\"name\":\"Outer \\\"quoted\\\"\"") != std::string::npos);
+	TEST_CHECK(trace.find("\"args\":{\"name\":\"Worker\"}") != std::string::npos);
+	TEST_CHECK(trace.find("\"args\":{\"value\":42}") != std::string::npos);
+
+	std::filesystem::remove(tracePath);
+}
+
+static void TestRingWrap()
+{
+	// Only the newest events of a thread are kept, the scope left open at the start of the ring is not exported
+	std::thread worker([]()
+	{
+		AU_CPU_DEBUG_SCOPE("Long scope");
+
+		for (uint32_t i = 0; i < Profiler::EventsPerThread; ++i)
+		{
+			AU_CPU_DEBUG_SCOPE("Short scope");
+		}
+	});
+	worker.join();
+
+	std::vector<std::pair<uint32_t, ProfileEvent>> events;
+	Profiler::CollectEvents(events);
+
+	uint32_t workerThread = UINT32_MAX;
+	for (const auto& [thread, event] : events)
+	{
+		if (std::string(event.Name) == "Short scope")
+			workerThread = thread;
+	}
+
+	size_t workerEvents = 0;
+	bool longScopeBegin = false;
+	for (const auto& [thread, event] : events)
+	{
+		if (thread != workerThread)
+			continue;
+
+		workerEvents++;
+		longScopeBegin |= event.Type == EProfileEvent::Begin && std::string(event.Name) == "Long scope";
+	}
+
+	// The oldest slot may be in the middle of being overwritten while collecting, it is always skipped on a full ring
+	TEST_CHECK(workerEvents == Profiler::EventsPerThread - 1);
+	TEST_CHECK(!longScopeBegin);
+}
+
+static void TestCollectWhileRecording()
+{
+	// The worker keeps wrapping its ring while it is collected, every copied counter has to be one the worker
+	// wrote at that position, an overwritten slot would break the sequence
+	std::atomic<bool> started = false;
+	std::atomic<bool> stop = false;
+
+	std::thread worker([&started, &stop]()
+	{
+		// Bursts shorter than the ring, so a slow copy still finds events that were not overwritten
+		for (int64_t value = 0; !stop; ++value)
+		{
+			Profiler::SetCounter("Sequence", value);
+			started = true;
+
+			if (value % 1024 == 1023)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+
+	while (!started)
+		std::this_thread::yield();
+
+	bool consecutive = true;
+	size_t collected = 0;
+
+	for (uint32_t collect = 0; collect < 50; ++collect)
+	{
+		std::vector<std::pair<uint32_t, ProfileEvent>> events;
+		Profiler::CollectEvents(events);
+
+		int64_t lastValue = -1;
+		for (const auto& [thread, event] : events)
+		{
+			if (event.Type != EProfileEvent::Counter || std::string(event.Name) != "Sequence")
+				continue;
+
+			consecutive &= lastValue == -1 || event.Value == lastValue + 1;
+			lastValue = event.Value;
+			collected++;
+		}
+	}
+
+	stop = true;
+	worker.join();
+
+	TEST_CHECK(consecutive);
+	TEST_CHECK(collected > 0);
+}
+
+// Same counter the profiler reads
+static inline uint64_t ReadCounter()
+{
+#if AU_TEST_TSC
+	return __rdtsc();
+#else
+	return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+static double MeasureCounterRead()
+{
+	constexpr uint32_t readCount = 1000000;
+	uint64_t sum = 0;
+
+	auto begin = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < readCount; ++i)
+		sum += ReadCounter();
+	double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+	return sum != 0 ? elapsed / readCount : 0.0;
+}
+
+static void TestOverhead()
+{
+	constexpr uint32_t scopeCount = 1000000;
+	double bestNanoseconds = 1e9;
+
+	// Best of a few runs, the first one also pays for page faults of the ring
+	for (uint32_t run = 0; run < 5; ++run)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < scopeCount; ++i)
+		{
+			AU_CPU_DEBUG_SCOPE("Overhead");
+		}
+		double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+		bestNanoseconds = std::min(bestNanoseconds, elapsed / scopeCount);
+	}
+
+	// A scope gets 20 ns: two counter reads of at most 5 ns each and 10 ns to record both events.
+	// Virtual machines may trap the counter, there the reads are measured and only the recording is held to its part.
+	double counterRead = MeasureCounterRead();
+	double recording = bestNanoseconds - 2.0 * counterRead;
+
+	std::cout << "Profile scope overhead " << bestNanoseconds << "ns, counter read " << counterRead << "ns\n";
+
+#ifdef NDEBUG
+	TEST_CHECK(recording < 10.0);
+	if (counterRead <= 5.0)
+		TEST_CHECK(bestNanoseconds < 20.0);
+#else
+	TEST_CHECK(recording < 500.0);
+#endif
+}
+
+int main()
+{
+	Profiler::SetThreadName("Main");
+
+	TestEvents();
+	TestRingWrap();
+	TestCollectWhileRecording();
+	TestOverhead();
+
+	return TestResult("profiler");
+}
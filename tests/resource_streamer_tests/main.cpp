@@ -0,0 +1,40 @@
+#include <iostream>
+#include <Aurora/HeadlessEngine.hpp>
+#include <Aurora/Resource/ResourceManager.hpp>
+#include "../TestCommon.hpp"
+
+using namespace Aurora;
+
+static void TestMissingFiles(HeadlessEngine& engine)
+{
+	ResourceManager* resourceManager = engine.GetResourceManager();
+
+	MeshHandle firstMesh = resourceManager->LoadMeshAsync("Assets/DoesNotExist/First.amesh");
+	MeshHandle secondMesh = resourceManager->LoadMeshAsync("Assets/DoesNotExist/Second.amesh", ELoadPriority::High);
+	TextureHandle texture = resourceManager->LoadTextureAsync("Assets/DoesNotExist/Texture.png");
+	TEST_CHECK(firstMesh.IsPending() && secondMesh.IsPending() && texture.IsPending());
+
+	resourceManager->GetStreamer().WaitForDecodes();
+	TEST_CHECK(firstMesh.IsFailed() && secondMesh.IsFailed() && texture.IsFailed());
+
+	// Failed requests upload nothing, all of them leave the streamer within a zero budget
+	TEST_CHECK(resourceManager->ProcessUploads(0) == 3);
+	TEST_CHECK(resourceManager->GetStreamer().GetInFlightCount() == 0);
+
+	TEST_CHECK(firstMesh.Get() == nullptr && secondMesh.Get() == nullptr);
+
+	// Loaded again instead of returning the failed request
+	MeshHandle retry = resourceManager->LoadMeshAsync("Assets/DoesNotExist/First.amesh");
+	resourceManager->GetStreamer().Flush();
+	TEST_CHECK(retry.IsFailed());
+	TEST_CHECK(resourceManager->GetStreamer().GetInFlightCount() == 0);
+}
+
+int main()
+{
+	HeadlessEngine engine;
+
+	TestMissingFiles(engine);
+
+	return TestResult("resource streamer");
+}
\ No newline at end of file
@@ -0,0 +1,277 @@
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <filesystem>
+#include <Aurora/Resource/ResourceManager.hpp>
+#include <Aurora/Resource/AssetBank.hpp>
+#include <Aurora/Graphics/Null/NullRenderDevice.hpp>
+#include "../TestCommon.hpp"
+
+using namespace Aurora;
+
+// 24 bit uncompressed bitmap, the simplest format the image decoder reads
+static void WriteBitmap(const Path& path, uint32_t width, uint32_t height, uint8_t seed)
+{
+	uint32_t rowSize = (width * 3 + 3) & ~3u;
+	uint32_t pixelsOffset = 54;
+
+	DataBlob data(pixelsOffset + rowSize * height, 0);
+
+	auto write32 = [&data](size_t offset, uint32_t value) { std::memcpy(data.data() + offset, &value, 4); };
+	auto write16 = [&data](size_t offset, uint16_t value) { std::memcpy(data.data() + offset, &value, 2); };
+
+	data[0] = 'B';
+	data[1] = 'M';
+	write32(2, (uint32_t)data.size());
+	write32(10, pixelsOffset);
+	write32(14, 40);
+	write32(18, width);
+	write32(22, height);
+	write16(26, 1);
+	write16(28, 24);
+
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			uint8_t* pixel = data.data() + pixelsOffset + y * rowSize + x * 3;
+			pixel[0] = (uint8_t)(x * 4 + seed);
+			pixel[1] = (uint8_t)(y * 8);
+			pixel[2] = (uint8_t)(x ^ y);
+		}
+	}
+
+	WriteFile(path, data);
+}
+
+static size_t CountFiles(const Path& directory)
+{
+	if (!std::filesystem::exists(directory))
+		return 0;
+
+	return (size_t)std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator());
+}
+
+static bool SameMips(const ResourceManager::DecodedTexture& a, const ResourceManager::DecodedTexture& b)
+{
+	if (a.Mips.size() != b.Mips.size())
+		return false;
+
+	for (size_t i = 0; i < a.Mips.size(); ++i)
+	{
+		const ATexMip& mipA = a.Mips[i];
+		const ATexMip& mipB = b.Mips[i];
+
+		if (mipA.Width != mipB.Width || mipA.Height != mipB.Height || mipA.Size != mipB.Size)
+			return false;
+
+		if (std::memcmp(a.Pixels.data() + mipA.Offset, b.Pixels.data() + mipB.Offset, mipA.Size) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+static void TestCook()
+{
+	ResourceManager resourceManager(nullptr);
+	resourceManager.GetDerivedDataCache().SetDirectory("DDC");
+
+	Path albedoPath = "Assets/Textures/albedo.bmp";
+	Path normalPath = "Assets/Textures/normal_map.bmp";
+	WriteBitmap(albedoPath, 64, 32, 0);
+	WriteBitmap(normalPath, 16, 16, 100);
+
+	TEST_CHECK(resourceManager.CookTexture(albedoPath));
+	TEST_CHECK(resourceManager.CookTexture(normalPath));
+	TEST_CHECK(std::filesystem::exists("Assets/Textures/albedo.bmp.atex"));
+	TEST_CHECK(std::filesystem::exists("Assets/Textures/albedo.bmp.meta"));
+	TEST_CHECK(CountFiles("DDC") == 2);
+
+	DataBlob cookedData = ReadFile(ResourceManager::GetCookedTexturePath(albedoPath));
+	CookedTexture cookedTexture;
+	TEST_CHECK(cookedTexture.Read(cookedData));
+
+	if (cookedTexture.IsValid())
+	{
+		TEST_CHECK(cookedTexture.GetHeader().Width == 64);
+		TEST_CHECK(cookedTexture.GetHeader().Height == 32);
+		TEST_CHECK(cookedTexture.GetMips().size() == 6);
+		TEST_CHECK(cookedTexture.GetMips().back().Width == 2 && cookedTexture.GetMips().back().Height == 1);
+		TEST_CHECK(cookedTexture.IsSRGB());
+
+		nlohmann::json meta;
+		TEST_CHECK(resourceManager.LoadJson("Assets/Textures/albedo.bmp.meta", meta));
+		TEST_CHECK(cookedTexture.GetID() == AUID::FromString<String>(meta["uuid"].get<String>()).value());
+
+		for (const ATexMip& mip : cookedTexture.GetMips())
+			TEST_CHECK(mip.Offset % ATEX_DATA_ALIGNMENT == 0 && mip.Size == mip.Width * mip.Height * 4);
+	}
+
+	CookedTexture cookedNormal;
+	DataBlob cookedNormalData = ReadFile(ResourceManager::GetCookedTexturePath(normalPath));
+	TEST_CHECK(cookedNormal.Read(cookedNormalData));
+	TEST_CHECK(cookedNormal.IsValid() && !cookedNormal.IsSRGB() && (cookedNormal.GetHeader().Flags & ATEX_FLAG_NORMAL_MAP));
+
+	// Cooked mips are the same as the ones decoded at runtime
+	TextureLoadDesc sourceDesc;
+	sourceDesc.UseCookedData = false;
+
+	ResourceManager::DecodedTexture fromSource;
+	ResourceManager::DecodedTexture fromCooked;
+	TEST_CHECK(resourceManager.DecodeTexture(albedoPath, sourceDesc, fromSource) && !fromSource.Cooked);
+	TEST_CHECK(resourceManager.DecodeTexture(albedoPath, TextureLoadDesc(), fromCooked) && fromCooked.Cooked);
+	TEST_CHECK(fromCooked.SRGB && fromCooked.ID == cookedTexture.GetID());
+	TEST_CHECK(SameMips(fromSource, fromCooked));
+
+	// Mips and resizing are still honored
+	TextureLoadDesc noMipsDesc;
+	noMipsDesc.GenerateMips = false;
+	ResourceManager::DecodedTexture noMips;
+	TEST_CHECK(resourceManager.DecodeTexture(albedoPath, noMipsDesc, noMips) && noMips.Cooked && noMips.Mips.size() == 1);
+
+	TextureLoadDesc resizedDesc;
+	resizedDesc.Width = 16;
+	resizedDesc.Height = 16;
+	ResourceManager::DecodedTexture resized;
+	TEST_CHECK(resourceManager.DecodeTexture(albedoPath, resizedDesc, resized) && !resized.Cooked && resized.Mips[0].Width == 16);
+}
+
+static void TestDerivedDataCache()
+{
+	ResourceManager resourceManager(nullptr);
+	resourceManager.GetDerivedDataCache().SetDirectory("DDC");
+
+	Path albedoPath = "Assets/Textures/albedo.bmp";
+	Path cookedPath = ResourceManager::GetCookedTexturePath(albedoPath);
+	DataBlob cookedData = ReadFile(cookedPath);
+
+	// Unchanged source, the cooked file is taken from the cache instead of being cooked again
+	CookedTexture cookedTexture;
+	TEST_CHECK(cookedTexture.Read(cookedData));
+	Path entryPath = resourceManager.GetDerivedDataCache().GetEntryPath(cookedTexture.GetHeader().CacheKey);
+	TEST_CHECK(std::filesystem::exists(entryPath));
+
+	DataBlob markedData = cookedData;
+	markedData.back() ^= 0xFF;
+	WriteFile(entryPath, markedData);
+
+	std::filesystem::remove(cookedPath);
+	TEST_CHECK(resourceManager.CookTexture(albedoPath));
+	TEST_CHECK(ReadFile(cookedPath) == markedData);
+	TEST_CHECK(CountFiles("DDC") == 2);
+
+	// Changed source gets a new key
+	WriteBitmap(albedoPath, 64, 32, 1);
+	TEST_CHECK(resourceManager.CookTexture(albedoPath));
+	TEST_CHECK(CountFiles("DDC") == 3);
+
+	DataBlob changedData = ReadFile(cookedPath);
+	CookedTexture changedTexture;
+	TEST_CHECK(changedTexture.Read(changedData));
+	TEST_CHECK(changedTexture.IsValid() && changedTexture.GetHeader().CacheKey != cookedTexture.GetHeader().CacheKey);
+	TEST_CHECK(changedTexture.IsValid() && changedTexture.GetID() == cookedTexture.GetID());
+}
+
+static void TestCorruptedCookedTexture()
+{
+	ResourceManager resourceManager(nullptr);
+
+	Path albedoPath = "Assets/Textures/albedo.bmp";
+	Path cookedPath = ResourceManager::GetCookedTexturePath(albedoPath);
+	DataBlob cookedData = ReadFile(cookedPath);
+
+	CookedTexture cookedTexture;
+	TEST_CHECK(!cookedTexture.Read(std::span<const uint8_t>(cookedData).first(cookedData.size() / 2)));
+	TEST_CHECK(!cookedTexture.Read({}));
+
+	// Mips that do not match their level in the format, still inside of the data
+	{
+		DataBlob corrupted = cookedData;
+		auto* header = reinterpret_cast<ATexHeader*>(corrupted.data());
+		auto* mips = reinterpret_cast<ATexMip*>(corrupted.data() + sizeof(ATexHeader));
+		TEST_CHECK(header->MipCount > 1);
+
+		mips[1].Size -= 4;
+		TEST_CHECK(!cookedTexture.Read(corrupted));
+		mips[1].Size += 4;
+
+		mips[1].Width += 1;
+		TEST_CHECK(!cookedTexture.Read(corrupted));
+		mips[1].Width -= 1;
+
+		header->Format = (uint32_t)GraphicsFormat::RGBA16_FLOAT;
+		TEST_CHECK(!cookedTexture.Read(corrupted));
+		header->Format = (uint32_t)GraphicsFormat::Unknown;
+		TEST_CHECK(!cookedTexture.Read(corrupted));
+		header->Format = (uint32_t)GraphicsFormat::RGBA8_UNORM;
+
+		TEST_CHECK(cookedTexture.Read(corrupted));
+	}
+
+	// Falls back to the source
+	DataBlob truncated(cookedData.begin(), cookedData.begin() + sizeof(ATexHeader) + 8);
+	WriteFile(cookedPath, truncated);
+
+	ResourceManager::DecodedTexture decodedTexture;
+	TEST_CHECK(resourceManager.DecodeTexture(albedoPath, TextureLoadDesc(), decodedTexture) && !decodedTexture.Cooked);
+	TEST_CHECK(decodedTexture.Mips.size() == 6);
+
+	WriteFile(cookedPath, cookedData);
+}
+
+static void TestCookedTextureFormat()
+{
+	NullRenderDevice renderDevice;
+	ResourceManager resourceManager(&renderDevice);
+
+	// The sRGB flag of the cooked textures decides the format
+	Texture_ptr albedo = resourceManager.LoadTexture("Assets/Textures/albedo.bmp");
+	Texture_ptr normal = resourceManager.LoadTexture("Assets/Textures/normal_map.bmp");
+	TEST_CHECK(albedo && albedo->GetDesc().ImageFormat == GraphicsFormat::SRGBA8_UNORM);
+	TEST_CHECK(normal && normal->GetDesc().ImageFormat == GraphicsFormat::RGBA8_UNORM);
+	TEST_CHECK(albedo && albedo->GetDesc().MipLevels == 6);
+
+	TextureLoadDesc forceSRGBDesc;
+	forceSRGBDesc.ForceSRGB = true;
+	forceSRGBDesc.DoNotCache = true;
+	Texture_ptr forcedNormal = resourceManager.LoadTexture("Assets/Textures/normal_map.bmp", forceSRGBDesc);
+	TEST_CHECK(forcedNormal && forcedNormal->GetDesc().ImageFormat == GraphicsFormat::SRGBA8_UNORM);
+}
+
+static void TestPackagedCookedTexture()
+{
+	TEST_CHECK(AssetBank::CreatePackage("Assets", "textures.abank"));
+
+	ResourceManager resourceManager(nullptr);
+	resourceManager.LoadPackageFile("textures.abank");
+
+	Path albedoPath = "Assets/Textures/albedo.bmp";
+	TEST_CHECK(!resourceManager.GetPackageFileView(ResourceManager::GetCookedTexturePath(albedoPath)).empty());
+
+	// Uploaded straight from the mapped package
+	ResourceManager::DecodedTexture decodedTexture;
+	TEST_CHECK(resourceManager.DecodeTexture(albedoPath, TextureLoadDesc(), decodedTexture));
+	TEST_CHECK(decodedTexture.Cooked && decodedTexture.FromAssetPackage && decodedTexture.Storage.empty());
+	TEST_CHECK(decodedTexture.Mips.size() == 6);
+}
+
+int main()
+{
+	Path testDirectory = std::filesystem::temp_directory_path() / "aurora_texture_cooker_tests";
+	std::filesystem::remove_all(testDirectory);
+	std::filesystem::create_directories(testDirectory);
+	std::filesystem::current_path(testDirectory);
+
+	TestCook();
+	TestDerivedDataCache();
+	TestCorruptedCookedTexture();
+	TestCookedTextureFormat();
+	TestPackagedCookedTexture();
+
+	std::filesystem::current_path(testDirectory.parent_path());
+	std::filesystem::remove_all(testDirectory);
+
+	return TestResult("texture cooker");
+}